@@ -79,7 +79,7 @@ int dirfd(DIR *dirp);
 
 /**
  * @brief Open a directory stream for a directory identified by a file descriptor.
- * @ingroup posix_option_group_file_system
+ * @ingroup posix_option_group_file_system_fd
  * @param fd File descriptor for the directory.
  * @return Directory stream on success, or NULL on failure.
  * @see https://pubs.opengroup.org/onlinepubs/9699919799/functions/fdopendir.html
@@ -0,0 +1,100 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief POSIX pathname pattern-matching types (<glob.h>)
+ *
+ * @see <a href="https://pubs.opengroup.org/onlinepubs/9699919799/basedefs/glob.h.html">
+ *      POSIX.1-2017 &lt;glob.h&gt;</a>
+ *
+ * @ingroup posix_option_group_file_system_glob
+ */
+
+#ifndef ZEPHYR_INCLUDE_POSIX_GLOB_H_
+#define ZEPHYR_INCLUDE_POSIX_GLOB_H_
+
+#include <stddef.h>
+
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Pathnames found by glob().  @ingroup posix_option_group_file_system_glob*/
+typedef struct {
+	size_t gl_pathc; /**< Count of paths matched by the pattern. */
+	char **gl_pathv; /**< Pointer to a list of matched pathnames. */
+	size_t gl_offs;  /**< Slots to reserve at the beginning of gl_pathv. */
+} glob_t;
+
+/** @brief Flag: return on the first directory that cannot be read.  @ingroup posix_option_group_file_system_glob*/
+#undef GLOB_ERR
+#define GLOB_ERR      0x0001
+/** @brief Flag: append a slash to each pathname that is a directory.  @ingroup posix_option_group_file_system_glob*/
+#undef GLOB_MARK
+#define GLOB_MARK     0x0002
+/** @brief Flag: do not sort the pathnames.  @ingroup posix_option_group_file_system_glob*/
+#undef GLOB_NOSORT
+#define GLOB_NOSORT   0x0004
+/** @brief Flag: reserve gl_offs null pointers at the beginning of gl_pathv.  @ingroup posix_option_group_file_system_glob*/
+#undef GLOB_DOOFFS
+#define GLOB_DOOFFS   0x0008
+/** @brief Flag: return the pattern itself if it matches no pathname.  @ingroup posix_option_group_file_system_glob*/
+#undef GLOB_NOCHECK
+#define GLOB_NOCHECK  0x0010
+/** @brief Flag: append to the pathnames of a previous call.  @ingroup posix_option_group_file_system_glob*/
+#undef GLOB_APPEND
+#define GLOB_APPEND   0x0020
+/** @brief Flag: treat backslash as an ordinary character.  @ingroup posix_option_group_file_system_glob*/
+#undef GLOB_NOESCAPE
+#define GLOB_NOESCAPE 0x0040
+#if defined(_GNU_SOURCE) || defined(__DOXYGEN__)
+/** @brief GNU extension: expand "{a,b}" alternatives.  @ingroup posix_option_group_file_system_glob*/
+#undef GLOB_BRACE
+#define GLOB_BRACE    0x0400
+/** @brief GNU extension: expand a leading "~" to the home directory.  @ingroup posix_option_group_file_system_glob*/
+#undef GLOB_TILDE
+#define GLOB_TILDE    0x1000
+#endif
+
+/** @brief Error: out of memory.  @ingroup posix_option_group_file_system_glob*/
+#undef GLOB_NOSPACE
+#define GLOB_NOSPACE 1
+/** @brief Error: a directory could not be read.  @ingroup posix_option_group_file_system_glob*/
+#undef GLOB_ABORTED
+#define GLOB_ABORTED 2
+/** @brief Error: the pattern matched no pathname.  @ingroup posix_option_group_file_system_glob*/
+#undef GLOB_NOMATCH
+#define GLOB_NOMATCH 3
+
+/**
+ * @brief Find the pathnames matching a pattern.
+ * @ingroup posix_option_group_file_system_glob
+ * @param pattern Pattern to expand, using the notation of fnmatch() in each path component.
+ * @param flags   Combination of GLOB_* flags.
+ * @param errfunc Optional function called with the path and errno of a directory that cannot be
+ *                read. glob() stops if it returns non-zero.
+ * @param pglob   Pathnames found, to be released with globfree().
+ * @return 0 on success, @c GLOB_NOMATCH, @c GLOB_ABORTED, or @c GLOB_NOSPACE.
+ * @see https://pubs.opengroup.org/onlinepubs/9699919799/functions/glob.html
+ */
+int glob(const char *ZRESTRICT pattern, int flags, int (*errfunc)(const char *epath, int eerrno),
+	 glob_t *ZRESTRICT pglob);
+
+/**
+ * @brief Release the pathnames found by glob().
+ * @ingroup posix_option_group_file_system_glob
+ * @param pglob Pathnames found by glob().
+ * @see https://pubs.opengroup.org/onlinepubs/9699919799/functions/globfree.html
+ */
+void globfree(glob_t *pglob);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_POSIX_GLOB_H_ */
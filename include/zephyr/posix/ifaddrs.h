@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief BSD-compatible interface address list and interface change notifications (<ifaddrs.h>)
+ *
+ * getifaddrs() takes a snapshot of the network interfaces and of their addresses. if_notify()
+ * opens a file descriptor that reports changes to them as they happen, so that a daemon can
+ * block in poll() or select() rather than take a new snapshot periodically.
+ *
+ * @note getifaddrs() is a BSD extension, also available on Linux, and not part of POSIX.1-2017.
+ *       if_notify() is a Zephyr extension that plays the role of a Linux @c NETLINK_ROUTE socket.
+ */
+
+#ifndef ZEPHYR_INCLUDE_POSIX_IFADDRS_H_
+#define ZEPHYR_INCLUDE_POSIX_IFADDRS_H_
+
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Entry in the list returned by getifaddrs(). */
+struct ifaddrs {
+	struct ifaddrs *ifa_next;     /**< Next entry, or @c NULL. */
+	char *ifa_name;               /**< Interface name. */
+	unsigned int ifa_flags;       /**< Interface flags (@c IFF_*, see <net/if.h>). */
+	struct sockaddr *ifa_addr;    /**< Interface address. */
+	struct sockaddr *ifa_netmask; /**< Netmask of @c ifa_addr, or @c NULL. */
+	union {
+		struct sockaddr *ifu_broadaddr; /**< Broadcast address. */
+		struct sockaddr *ifu_dstaddr;   /**< Point-to-point destination address. */
+	} ifa_ifu;                    /**< Broadcast or destination address, or @c NULL. */
+	void *ifa_data;               /**< Address family specific data, or @c NULL. */
+};
+
+/** @brief Broadcast address of an entry. */
+#define ifa_broadaddr ifa_ifu.ifu_broadaddr
+/** @brief Point-to-point destination address of an entry. */
+#define ifa_dstaddr   ifa_ifu.ifu_dstaddr
+
+/**
+ * @brief Get the addresses of the network interfaces.
+ *
+ * One entry is returned for each interface, with an @c AF_PACKET (@c NET_AF_PACKET) link-layer
+ * address in a Zephyr @c net_sockaddr_ll, followed by one entry for each of its IPv4 and IPv6
+ * unicast addresses. The whole list is a single allocation.
+ *
+ * @param[out] ifap Set to the first entry of the list.
+ * @return 0 on success, or -1 with errno set on failure.
+ * @see https://man.freebsd.org/cgi/man.cgi?query=getifaddrs
+ */
+int getifaddrs(struct ifaddrs **ifap);
+
+/**
+ * @brief Free a list returned by getifaddrs().
+ *
+ * @param ifa First entry of the list.
+ * @see https://man.freebsd.org/cgi/man.cgi?query=freeifaddrs
+ */
+void freeifaddrs(struct ifaddrs *ifa);
+
+/** @brief Group of link state notifications (@ref IFN_LINK_UP and @ref IFN_LINK_DOWN). */
+#define IFN_LINK 0x1
+/** @brief Group of address notifications (@ref IFN_ADDR_ADD and @ref IFN_ADDR_DEL). */
+#define IFN_ADDR 0x2
+
+/** @brief Non-blocking flag: read() fails with EAGAIN instead of blocking. */
+#define IFN_NONBLOCK O_NONBLOCK
+
+/** @brief An interface became operationally up. */
+#define IFN_LINK_UP   1
+/** @brief An interface became operationally down. */
+#define IFN_LINK_DOWN 2
+/** @brief An address was added to an interface. */
+#define IFN_ADDR_ADD  3
+/** @brief An address was removed from an interface. */
+#define IFN_ADDR_DEL  4
+/**
+ * @brief Notifications were lost because the queue of the descriptor was full.
+ *
+ * Take a new snapshot with getifaddrs() to resynchronise.
+ */
+#define IFN_OVERFLOW  5
+
+/** @brief Notification record read from a descriptor opened with if_notify(). */
+struct if_notification {
+	unsigned short ifn_type;  /**< Record type (@c IFN_LINK_UP ... @c IFN_OVERFLOW). */
+	unsigned short ifn_flags; /**< Interface flags (@c IFF_*) when the event was reported. */
+	unsigned int ifn_index;   /**< Interface index, or 0 for @ref IFN_OVERFLOW. */
+	union {
+		struct sockaddr sa;       /**< Address family. */
+		struct sockaddr_in sin;   /**< IPv4 address. */
+		struct sockaddr_in6 sin6; /**< IPv6 address. */
+	} ifn_addr;               /**< Address of @c IFN_ADDR_* records. */
+};
+
+/**
+ * @brief Open a descriptor that reports interface and address changes.
+ *
+ * Each read() returns as many whole @ref if_notification records as fit in the buffer, and
+ * fails with EINVAL if not even one fits. The descriptor is readable in poll() and select()
+ * while records are queued. If the queue overflows, later changes are dropped until an
+ * @ref IFN_OVERFLOW record has been read.
+ *
+ * @param groups Notifications to report: @ref IFN_LINK, @ref IFN_ADDR, or both.
+ * @param flags  0 or @ref IFN_NONBLOCK.
+ * @return New file descriptor on success, or -1 with errno set on failure.
+ */
+int if_notify(int groups, int flags);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_POSIX_IFADDRS_H_ */
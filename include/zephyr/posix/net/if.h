@@ -26,6 +26,13 @@ extern "C" {
 /** @brief Maximum length of a network interface name including the NUL terminator. */
 #define IF_NAMESIZE NET_IFNAMSIZ
 
+/** @brief Interface is administratively up (extension, see getifaddrs()). */
+#define IFF_UP       0x1
+/** @brief Interface is a loopback interface (extension, see getifaddrs()). */
+#define IFF_LOOPBACK 0x8
+/** @brief Interface is operationally up (extension, see getifaddrs()). */
+#define IFF_RUNNING  0x40
+
 #if !(defined(_IF_NAMEINDEX_DECLARED) || defined(__if_nameindex_defined)) || defined(__DOXYGEN__)
 /** @brief Network interface name-to-index mapping. */
 struct if_nameindex {
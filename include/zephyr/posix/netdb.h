@@ -355,6 +355,18 @@ struct servent *getservbyport(int port, const char *proto);
  */
 struct servent *getservent(void);
 
+/**
+ * @brief Discard cached host name resolutions.
+ *
+ * Empties the cache of DNS answers used by @ref getaddrinfo and @ref getnameinfo, and causes
+ * @c /etc/hosts to be read again on the next lookup.
+ *
+ * @note This is a Zephyr extension, available with CONFIG_POSIX_RESOLVER_CACHE. It is similar
+ *       to @c res_init() on other systems.
+ * @ingroup posix_option_group_networking
+ */
+void res_flush(void);
+
 /**
  * @brief Open the hosts database.
  * @param stayopen Non-zero to keep the database connection open.
@@ -79,6 +79,30 @@ BUILD_ASSERT(POLLWRNORM == POLLOUT, "POLLWRNORM must be equal to POLLOUT");
  */
 int poll(struct pollfd *fds, nfds_t nfds, int timeout);
 
+#if (_POSIX_C_SOURCE >= 202405L) || defined(__DOXYGEN__)
+#include <signal.h>
+#include <time.h>
+
+/**
+ * @brief Wait for events on a set of file descriptors with a signal mask and nanosecond timeout.
+ * @ingroup posix_option_group_device_io
+ *
+ * Like poll(), except that the signal mask of the calling thread is replaced by @p sigmask for
+ * the duration of the wait, if @p sigmask is not NULL. A signal that is pending when the mask is
+ * installed, or that is delivered during the wait, interrupts the call.
+ *
+ * @param fds     Array of @c struct pollfd descriptors to monitor.
+ * @param nfds    Number of entries in @p fds.
+ * @param timeout Maximum wait time, or NULL to block indefinitely.
+ * @param sigmask Signal mask to apply during the wait, or NULL.
+ * @return Number of file descriptors with non-zero @c revents on success,
+ *         0 on timeout, or -1 with errno set on failure.
+ * @see https://pubs.opengroup.org/onlinepubs/9799919799/functions/poll.html
+ */
+int ppoll(struct pollfd *fds, nfds_t nfds, const struct timespec *ZRESTRICT timeout,
+	  const sigset_t *ZRESTRICT sigmask);
+#endif
+
 
 #endif /* _POSIX_C_SOURCE || __DOXYGEN__ */
 
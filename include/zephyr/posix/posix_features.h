@@ -60,7 +60,10 @@
 #undef _POSIX_NO_TRUNC
 #define _POSIX_NO_TRUNC (0)
 
-/* #define _POSIX_ADVISORY_INFO (-1L) */
+#undef _POSIX_ADVISORY_INFO
+#ifdef CONFIG_POSIX_ADVISORY_INFO
+#define _POSIX_ADVISORY_INFO _POSIX_VERSION
+#endif
 
 #undef _POSIX_ASYNCHRONOUS_IO
 #ifdef CONFIG_POSIX_ASYNCHRONOUS_IO
@@ -145,7 +148,11 @@
 #define _POSIX_REALTIME_SIGNALS _POSIX_VERSION
 #endif
 
-/* #define _POSIX_REGEXP (-1L) */
+#undef _POSIX_REGEXP
+#ifdef CONFIG_POSIX_REGEXP
+#define _POSIX_REGEXP _POSIX_VERSION
+#endif
+
 /* #define _POSIX_SAVED_IDS (-1L) */
 
 #undef _POSIX_SEMAPHORES
@@ -223,7 +230,10 @@
 #define _POSIX_THREAD_SAFE_FUNCTIONS _POSIX_VERSION
 #endif
 
-/* #define _POSIX_THREAD_SPORADIC_SERVER (-1L) */
+#undef _POSIX_THREAD_SPORADIC_SERVER
+#ifdef CONFIG_POSIX_THREAD_SPORADIC_SERVER
+#define _POSIX_THREAD_SPORADIC_SERVER _POSIX_VERSION
+#endif
 
 #undef _POSIX_THREADS
 #undef _POSIX_THREAD_PROCESS_SHARED
@@ -337,7 +337,7 @@ int putchar_unlocked(int c);
 #if (_POSIX_C_SOURCE >= 200809L) || (_XOPEN_SOURCE >= 700) || defined(__DOXYGEN__)
 /**
  * @brief Rename a file relative to directory file descriptors.
- * @ingroup posix_option_group_fd_mgmt
+ * @ingroup posix_option_group_file_system_fd
  * @param olddirfd File descriptor for the directory containing @p oldpath.
  * @param oldpath Existing pathname.
  * @param newdirfd File descriptor for the directory containing @p newpath.
@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Tracing events of the POSIX layer
+ *
+ * With @kconfig{CONFIG_POSIX_TRACING}, blocking calls of the POSIX layer and the creation and
+ * destruction of its objects are recorded by the tracing backend. The CTF backend writes them as
+ * the @c posix_enter, @c posix_blocking and @c posix_exit events of
+ * @c scripts/tracing/posix.tsdl; with @kconfig{CONFIG_TRACING_USER}, they are passed to the
+ * functions below, which the application may define.
+ *
+ * Each event names the object of the call by the address of the kernel object that implements
+ * it (e.g. the @c k_mutex of a mutex or the @c k_msgq of a message queue), so that it can be
+ * matched with the events of the kernel. Read-write locks and barriers are named by their own
+ * address, and signal calls by the thread that waits or is signalled.
+ *
+ * @note This is a Zephyr extension. It is unrelated to the obsolescent POSIX Trace option.
+ */
+
+#ifndef ZEPHYR_INCLUDE_POSIX_POSIX_TRACING_H_
+#define ZEPHYR_INCLUDE_POSIX_POSIX_TRACING_H_
+
+#include <stdint.h>
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Traced calls, grouped by object in blocks of 16.
+ *
+ * The values are part of the trace format and never change.
+ */
+enum sys_trace_posix_call {
+	SYS_TRACE_POSIX_PTHREAD_CREATE = 0x00,         /**< pthread_create() */
+	SYS_TRACE_POSIX_PTHREAD_JOIN,                  /**< pthread_join() and variants */
+	SYS_TRACE_POSIX_PTHREAD_DETACH,                /**< pthread_detach() */
+	SYS_TRACE_POSIX_PTHREAD_CANCEL,                /**< pthread_cancel() */
+	SYS_TRACE_POSIX_PTHREAD_EXIT,                  /**< pthread_exit() */
+
+	SYS_TRACE_POSIX_PTHREAD_MUTEX_INIT = 0x10,     /**< pthread_mutex_init() */
+	SYS_TRACE_POSIX_PTHREAD_MUTEX_DESTROY,         /**< pthread_mutex_destroy() */
+	SYS_TRACE_POSIX_PTHREAD_MUTEX_LOCK,            /**< pthread_mutex_lock() and variants */
+	SYS_TRACE_POSIX_PTHREAD_MUTEX_UNLOCK,          /**< pthread_mutex_unlock() */
+
+	SYS_TRACE_POSIX_PTHREAD_COND_INIT = 0x20,      /**< pthread_cond_init() */
+	SYS_TRACE_POSIX_PTHREAD_COND_DESTROY,          /**< pthread_cond_destroy() */
+	SYS_TRACE_POSIX_PTHREAD_COND_WAIT,             /**< pthread_cond_wait() and variants */
+	SYS_TRACE_POSIX_PTHREAD_COND_SIGNAL,           /**< pthread_cond_signal() */
+	SYS_TRACE_POSIX_PTHREAD_COND_BROADCAST,        /**< pthread_cond_broadcast() */
+
+	SYS_TRACE_POSIX_PTHREAD_RWLOCK_INIT = 0x30,    /**< pthread_rwlock_init() */
+	SYS_TRACE_POSIX_PTHREAD_RWLOCK_DESTROY,        /**< pthread_rwlock_destroy() */
+	SYS_TRACE_POSIX_PTHREAD_RWLOCK_RDLOCK,         /**< pthread_rwlock_rdlock() and variants */
+	SYS_TRACE_POSIX_PTHREAD_RWLOCK_WRLOCK,         /**< pthread_rwlock_wrlock() and variants */
+	SYS_TRACE_POSIX_PTHREAD_RWLOCK_UNLOCK,         /**< pthread_rwlock_unlock() */
+
+	SYS_TRACE_POSIX_PTHREAD_BARRIER_INIT = 0x40,   /**< pthread_barrier_init() */
+	SYS_TRACE_POSIX_PTHREAD_BARRIER_DESTROY,       /**< pthread_barrier_destroy() */
+	SYS_TRACE_POSIX_PTHREAD_BARRIER_WAIT,          /**< pthread_barrier_wait() */
+
+	SYS_TRACE_POSIX_SEM_INIT = 0x50,               /**< sem_init() */
+	SYS_TRACE_POSIX_SEM_DESTROY,                   /**< sem_destroy() */
+	SYS_TRACE_POSIX_SEM_OPEN,                      /**< sem_open() */
+	SYS_TRACE_POSIX_SEM_CLOSE,                     /**< sem_close() */
+	SYS_TRACE_POSIX_SEM_WAIT,                      /**< sem_wait() and variants */
+	SYS_TRACE_POSIX_SEM_POST,                      /**< sem_post() */
+
+	SYS_TRACE_POSIX_MQ_OPEN = 0x60,                /**< mq_open() */
+	SYS_TRACE_POSIX_MQ_CLOSE,                      /**< mq_close() */
+	SYS_TRACE_POSIX_MQ_SEND,                       /**< mq_send() and mq_timedsend() */
+	SYS_TRACE_POSIX_MQ_RECEIVE,                    /**< mq_receive() and mq_timedreceive() */
+
+	SYS_TRACE_POSIX_TIMER_CREATE = 0x70,           /**< timer_create() */
+	SYS_TRACE_POSIX_TIMER_DELETE,                  /**< timer_delete() */
+	SYS_TRACE_POSIX_TIMER_SETTIME,                 /**< timer_settime() */
+
+	SYS_TRACE_POSIX_KILL = 0x80,                   /**< kill() and pthread_kill() */
+	SYS_TRACE_POSIX_SIGQUEUE,                      /**< sigqueue() */
+	SYS_TRACE_POSIX_SIGWAIT,                       /**< sigwait() and variants */
+	SYS_TRACE_POSIX_SIGSUSPEND,                    /**< sigsuspend() */
+	SYS_TRACE_POSIX_PAUSE,                         /**< pause() */
+};
+
+/**
+ * @brief A call that may block was entered.
+ *
+ * @param call    Traced call.
+ * @param obj     Object of the call.
+ * @param timeout Time the call may block for, from now.
+ */
+void sys_trace_posix_enter_user(enum sys_trace_posix_call call, uintptr_t obj,
+				k_timeout_t timeout);
+
+/**
+ * @brief A call found its object unavailable, and may block.
+ *
+ * @param call Traced call.
+ * @param obj  Object of the call.
+ */
+void sys_trace_posix_blocking_user(enum sys_trace_posix_call call, uintptr_t obj);
+
+/**
+ * @brief A call returned.
+ *
+ * Calls that never block are only reported here.
+ *
+ * @param call Traced call.
+ * @param obj  Object of the call.
+ * @param err  0 on success, or an error number.
+ */
+void sys_trace_posix_exit_user(enum sys_trace_posix_call call, uintptr_t obj, int err);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_POSIX_POSIX_TRACING_H_ */
@@ -746,6 +746,20 @@ int pthread_mutex_timedlock(pthread_mutex_t *ZRESTRICT mutex,
 			    const struct timespec *ZRESTRICT abstime);
 #endif
 
+#if (_POSIX_C_SOURCE >= 202405L) || defined(__DOXYGEN__)
+/**
+ * @brief Lock a mutex with an absolute timeout of a specific clock.
+ * @ingroup posix_option_group_clock_selection
+ * @param mutex    Mutex to lock.
+ * @param clock_id Clock used to interpret @p abstime (CLOCK_REALTIME or CLOCK_MONOTONIC).
+ * @param abstime  Absolute timeout.
+ * @return 0 on success, @c ETIMEDOUT on timeout, or a positive error number on failure.
+ * @see https://pubs.opengroup.org/onlinepubs/9799919799/functions/pthread_mutex_clocklock.html
+ */
+int pthread_mutex_clocklock(pthread_mutex_t *ZRESTRICT mutex, clockid_t clock_id,
+			    const struct timespec *ZRESTRICT abstime);
+#endif
+
 /**
  * @brief Try to lock a mutex without blocking.
  * @ingroup posix_option_group_threads_base
@@ -970,6 +984,32 @@ int pthread_rwlock_timedwrlock(pthread_rwlock_t *ZRESTRICT rwlock,
 			       const struct timespec *ZRESTRICT abstime);
 #endif
 
+#if (_POSIX_C_SOURCE >= 202405L) || defined(__DOXYGEN__)
+/**
+ * @brief Acquire a read lock with an absolute timeout of a specific clock.
+ * @ingroup posix_option_group_clock_selection
+ * @param rwlock   Reader-writer lock.
+ * @param clock_id Clock used to interpret @p abstime (CLOCK_REALTIME or CLOCK_MONOTONIC).
+ * @param abstime  Absolute timeout.
+ * @return 0 on success, @c ETIMEDOUT on timeout, or a positive error number on failure.
+ * @see https://pubs.opengroup.org/onlinepubs/9799919799/functions/pthread_rwlock_clockrdlock.html
+ */
+int pthread_rwlock_clockrdlock(pthread_rwlock_t *ZRESTRICT rwlock, clockid_t clock_id,
+			       const struct timespec *ZRESTRICT abstime);
+
+/**
+ * @brief Acquire a write lock with an absolute timeout of a specific clock.
+ * @ingroup posix_option_group_clock_selection
+ * @param rwlock   Reader-writer lock.
+ * @param clock_id Clock used to interpret @p abstime (CLOCK_REALTIME or CLOCK_MONOTONIC).
+ * @param abstime  Absolute timeout.
+ * @return 0 on success, @c ETIMEDOUT on timeout, or a positive error number on failure.
+ * @see https://pubs.opengroup.org/onlinepubs/9799919799/functions/pthread_rwlock_clockwrlock.html
+ */
+int pthread_rwlock_clockwrlock(pthread_rwlock_t *ZRESTRICT rwlock, clockid_t clock_id,
+			       const struct timespec *ZRESTRICT abstime);
+#endif
+
 /**
  * @brief Try to acquire a read lock without blocking.
  * @ingroup posix_option_group_rw_locks
@@ -1258,6 +1298,26 @@ int pthread_timedjoin_np(pthread_t thread, void **status, const struct timespec
  */
 int pthread_tryjoin_np(pthread_t thread, void **status);
 
+/**
+ * @brief Create a thread in a new process domain (non-portable).
+ * @ingroup posix_option_group_non_portable
+ *
+ * The new domain gets its own process ID, a copy of the environment of the calling thread, and
+ * the signal dispositions of the calling thread, with caught signals reset to @c SIG_DFL. Threads
+ * that the new thread creates belong to the same domain. The domain goes away once all of its
+ * threads have exited.
+ *
+ * @param pid           Output: process ID of the new domain.
+ * @param thread        Output: the new thread.
+ * @param attr          Thread attributes, or NULL for the defaults.
+ * @param start_routine Entry point of the new thread.
+ * @param arg           Argument passed to @p start_routine.
+ * @return 0 on success, @c EAGAIN if there are no free domains or threads, @c ENOMEM if the
+ *         environment could not be copied, or another positive error number on failure.
+ */
+int pthread_spawn_np(pid_t *pid, pthread_t *thread, const pthread_attr_t *attr,
+		     void *(*start_routine)(void *), void *arg);
+
 #endif /* _GNU_SOURCE || __DOXYGEN__ */
 
 
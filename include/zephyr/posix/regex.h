@@ -0,0 +1,153 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief POSIX regular expression matching types (<regex.h>)
+ *
+ * @see <a href="https://pubs.opengroup.org/onlinepubs/9699919799/basedefs/regex.h.html">
+ *      POSIX.1-2017 &lt;regex.h&gt;</a>
+ *
+ * @ingroup posix_option_regexp
+ */
+
+#ifndef ZEPHYR_INCLUDE_POSIX_REGEX_H_
+#define ZEPHYR_INCLUDE_POSIX_REGEX_H_
+
+#include <stddef.h>
+#include <sys/types.h>
+
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Offset of a match within the string passed to regexec().  @ingroup posix_option_regexp*/
+typedef ssize_t regoff_t;
+
+/** @brief Compiled regular expression.  @ingroup posix_option_regexp*/
+typedef struct {
+	size_t re_nsub; /**< Number of parenthesized subexpressions. */
+	void *re_impl;  /**< Private: the compiled program. */
+} regex_t;
+
+/** @brief Bounds of a match, or -1 for a subexpression that did not participate.  @ingroup posix_option_regexp*/
+typedef struct {
+	regoff_t rm_so; /**< Offset of the start of the match. */
+	regoff_t rm_eo; /**< Offset of the first character after the match. */
+} regmatch_t;
+
+/** @brief regcomp() flag: use Extended Regular Expressions.  @ingroup posix_option_regexp*/
+#undef REG_EXTENDED
+#define REG_EXTENDED 0x1
+/** @brief regcomp() flag: ignore case.  @ingroup posix_option_regexp*/
+#undef REG_ICASE
+#define REG_ICASE    0x2
+/** @brief regcomp() flag: report only success or failure in regexec().  @ingroup posix_option_regexp*/
+#undef REG_NOSUB
+#define REG_NOSUB    0x4
+/** @brief regcomp() flag: treat newline as a line separator.  @ingroup posix_option_regexp*/
+#undef REG_NEWLINE
+#define REG_NEWLINE  0x8
+
+/** @brief regexec() flag: the start of the string is not the beginning of a line.  @ingroup posix_option_regexp*/
+#undef REG_NOTBOL
+#define REG_NOTBOL 0x1
+/** @brief regexec() flag: the end of the string is not the end of a line.  @ingroup posix_option_regexp*/
+#undef REG_NOTEOL
+#define REG_NOTEOL 0x2
+
+/** @brief Error: regexec() failed to match.  @ingroup posix_option_regexp*/
+#undef REG_NOMATCH
+#define REG_NOMATCH  1
+/** @brief Error: invalid regular expression.  @ingroup posix_option_regexp*/
+#undef REG_BADPAT
+#define REG_BADPAT   2
+/** @brief Error: invalid collating element.  @ingroup posix_option_regexp*/
+#undef REG_ECOLLATE
+#define REG_ECOLLATE 3
+/** @brief Error: invalid character class.  @ingroup posix_option_regexp*/
+#undef REG_ECTYPE
+#define REG_ECTYPE   4
+/** @brief Error: trailing backslash.  @ingroup posix_option_regexp*/
+#undef REG_EESCAPE
+#define REG_EESCAPE  5
+/** @brief Error: invalid or unsupported back-reference.  @ingroup posix_option_regexp*/
+#undef REG_ESUBREG
+#define REG_ESUBREG  6
+/** @brief Error: brackets "[]" imbalance.  @ingroup posix_option_regexp*/
+#undef REG_EBRACK
+#define REG_EBRACK   7
+/** @brief Error: parentheses imbalance.  @ingroup posix_option_regexp*/
+#undef REG_EPAREN
+#define REG_EPAREN   8
+/** @brief Error: braces "{}" imbalance.  @ingroup posix_option_regexp*/
+#undef REG_EBRACE
+#define REG_EBRACE   9
+/** @brief Error: invalid content of "{}".  @ingroup posix_option_regexp*/
+#undef REG_BADBR
+#define REG_BADBR    10
+/** @brief Error: invalid endpoint in range expression.  @ingroup posix_option_regexp*/
+#undef REG_ERANGE
+#define REG_ERANGE   11
+/** @brief Error: out of memory.  @ingroup posix_option_regexp*/
+#undef REG_ESPACE
+#define REG_ESPACE   12
+/** @brief Error: '?', '*' or '+' not preceded by a valid regular expression.  @ingroup posix_option_regexp*/
+#undef REG_BADRPT
+#define REG_BADRPT   13
+
+/**
+ * @brief Compile a regular expression.
+ * @ingroup posix_option_regexp
+ * @param preg    Compiled regular expression, to be released with regfree().
+ * @param pattern Basic, or with @c REG_EXTENDED Extended, Regular Expression.
+ * @param cflags  Combination of @c REG_EXTENDED, @c REG_ICASE, @c REG_NOSUB and @c REG_NEWLINE.
+ * @return 0 on success, or one of the @c REG_* errors.
+ * @see https://pubs.opengroup.org/onlinepubs/9699919799/functions/regcomp.html
+ */
+int regcomp(regex_t *ZRESTRICT preg, const char *ZRESTRICT pattern, int cflags);
+
+/**
+ * @brief Report an error of regcomp() or regexec() as a string.
+ * @ingroup posix_option_regexp
+ * @param errcode     Error returned by regcomp() or regexec().
+ * @param preg        Regular expression that caused the error.
+ * @param errbuf      Buffer for the message, which is truncated to fit.
+ * @param errbuf_size Size of @p errbuf in bytes.
+ * @return Size of the buffer needed for the complete message.
+ * @see https://pubs.opengroup.org/onlinepubs/9699919799/functions/regerror.html
+ */
+size_t regerror(int errcode, const regex_t *ZRESTRICT preg, char *ZRESTRICT errbuf,
+		size_t errbuf_size);
+
+/**
+ * @brief Match a string against a compiled regular expression.
+ * @ingroup posix_option_regexp
+ * @param preg   Regular expression compiled by regcomp().
+ * @param string String to match.
+ * @param nmatch Number of elements of @p pmatch.
+ * @param pmatch Bounds of the leftmost-longest match and of its subexpressions.
+ * @param eflags Combination of @c REG_NOTBOL and @c REG_NOTEOL.
+ * @return 0 on a match, @c REG_NOMATCH, or @c REG_ESPACE.
+ * @see https://pubs.opengroup.org/onlinepubs/9699919799/functions/regexec.html
+ */
+int regexec(const regex_t *ZRESTRICT preg, const char *ZRESTRICT string, size_t nmatch,
+	    regmatch_t pmatch[ZRESTRICT], int eflags);
+
+/**
+ * @brief Release a compiled regular expression.
+ * @ingroup posix_option_regexp
+ * @param preg Regular expression compiled by regcomp().
+ * @see https://pubs.opengroup.org/onlinepubs/9699919799/functions/regfree.html
+ */
+void regfree(regex_t *preg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_POSIX_REGEX_H_ */
@@ -38,12 +38,28 @@ extern "C" {
 /** @brief Round-robin (preemptive, priority-based) scheduling policy. @ingroup posix_option_priority_scheduling */
 #define SCHED_RR 2
 
+/**
+ * @brief Sporadic server scheduling policy.
+ * @ingroup posix_option_priority_scheduling
+ *
+ * A thread runs at its priority until it has used its execution budget, and then at
+ * @c sched_ss_low_priority until the budget is replenished.
+ */
+#define SCHED_SPORADIC 3
+
 #if (defined(CONFIG_MINIMAL_LIBC) || defined(CONFIG_PICOLIBC) || defined(CONFIG_ARMCLANG_STD_LIBC) \
 	|| defined(CONFIG_ARCMWDT_LIBC)) && !defined(_SCHED_PARAM_DEFINED) && \
 	!defined(__sched_param_defined)
 /** @brief Scheduling parameters used with sched_setparam() / pthread_attr_setschedparam(). */
 struct sched_param {
 	int sched_priority; /**< Scheduling priority. */
+#if defined(_POSIX_SPORADIC_SERVER) || defined(_POSIX_THREAD_SPORADIC_SERVER) ||                   \
+	defined(__DOXYGEN__)
+	int sched_ss_low_priority;           /**< Low scheduling priority for sporadic server. */
+	struct timespec sched_ss_repl_period; /**< Replenishment period for sporadic server. */
+	struct timespec sched_ss_init_budget; /**< Initial budget for sporadic server. */
+	int sched_ss_max_repl;               /**< Maximum pending replenishments for sporadic server. */
+#endif
 };
 #define _SCHED_PARAM_DEFINED
 #define __sched_param_defined
@@ -129,6 +145,44 @@ int sched_setscheduler(pid_t pid, int policy, const struct sched_param *param);
  */
 int sched_rr_get_interval(pid_t pid, struct timespec *interval);
 
+#if defined(_GNU_SOURCE) || defined(__DOXYGEN__)
+
+/**
+ * @brief Get the CPU that runs the calling thread (non-portable extension).
+ * @ingroup posix_option_group_threads_base
+ *
+ * Unless the thread is pinned to a CPU, it may migrate to another one as soon as this returns.
+ *
+ * @return the CPU number, from 0, or -1 with errno set to @c ENOSYS when called from user mode.
+ */
+int sched_getcpu(void);
+
+/**
+ * @brief Get the round-robin time quantum of a @c SCHED_RR priority (non-portable extension).
+ * @ingroup posix_option_priority_scheduling
+ * @param priority @c SCHED_RR priority.
+ * @param interval Output: round-robin interval, or zero if threads at @p priority are not time
+ *                 sliced.
+ * @return 0 on success, or -1 with errno set on failure.
+ */
+int sched_rr_get_interval_np(int priority, struct timespec *interval);
+
+/**
+ * @brief Set the round-robin time quantum of a @c SCHED_RR priority (non-portable extension).
+ * @ingroup posix_option_priority_scheduling
+ *
+ * The interval applies to POSIX threads that run at @p priority now or later. An interval of zero
+ * restores the system default, @c CONFIG_TIMESLICE_SIZE. Requires
+ * @c CONFIG_TIMESLICE_PER_THREAD.
+ *
+ * @param priority @c SCHED_RR priority.
+ * @param interval New round-robin interval, rounded up to system ticks.
+ * @return 0 on success, or -1 with errno set on failure.
+ */
+int sched_rr_set_interval_np(int priority, const struct timespec *interval);
+
+#endif /* _GNU_SOURCE || __DOXYGEN__ */
+
 #ifdef __cplusplus
 }
 #endif
@@ -88,6 +88,21 @@ int sem_post(sem_t *semaphore);
 int sem_timedwait(sem_t *ZRESTRICT semaphore, struct timespec *ZRESTRICT abstime);
 #endif
 
+#if (_POSIX_C_SOURCE >= 202405L) || defined(__DOXYGEN__)
+/**
+ * @brief Lock a semaphore with an absolute timeout of a specific clock.
+ * @ingroup posix_option_group_clock_selection
+ * @param semaphore Semaphore to wait on.
+ * @param clock_id  Clock used to interpret @p abstime (CLOCK_REALTIME or CLOCK_MONOTONIC).
+ * @param abstime   Absolute timeout.
+ * @return 0 on success, -1 with @c errno = @c ETIMEDOUT on timeout,
+ *         or -1 with errno set on another failure.
+ * @see https://pubs.opengroup.org/onlinepubs/9799919799/functions/sem_clockwait.html
+ */
+int sem_clockwait(sem_t *ZRESTRICT semaphore, clockid_t clock_id,
+		  const struct timespec *ZRESTRICT abstime);
+#endif
+
 /**
  * @brief Try to lock a semaphore without blocking.
  * @ingroup posix_option_group_semaphores
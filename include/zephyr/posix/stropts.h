@@ -27,10 +27,66 @@
 /** @brief Flag: message carries high-priority data.  @ingroup posix_option_xopen_streams*/
 #define RS_HIPRI BIT(0)
 
+/** @brief getpmsg() / putpmsg() flag: high-priority message.  @ingroup posix_option_xopen_streams*/
+#define MSG_HIPRI 0x01
+/** @brief getpmsg() flag: message of any priority.  @ingroup posix_option_xopen_streams*/
+#define MSG_ANY   0x02
+/** @brief getpmsg() / putpmsg() flag: message in a priority band.  @ingroup posix_option_xopen_streams*/
+#define MSG_BAND  0x04
+
+/** @brief getmsg() result: more control information is waiting.  @ingroup posix_option_xopen_streams*/
+#define MORECTL  1
+/** @brief getmsg() result: more data is waiting.  @ingroup posix_option_xopen_streams*/
+#define MOREDATA 2
+
+/** @cond INTERNAL_HIDDEN */
+#define __SID ('S' << 8)
+/** @endcond */
+
+/** @brief Count the messages on the read queue.  @ingroup posix_option_xopen_streams*/
+#define I_NREAD   (__SID | 1)
+/** @brief Flush the read and/or write queue.  @ingroup posix_option_xopen_streams*/
+#define I_FLUSH   (__SID | 5)
+/** @brief Request SIGPOLL for stream events.  @ingroup posix_option_xopen_streams*/
+#define I_SETSIG  (__SID | 9)
+/** @brief Get the events that SIGPOLL was requested for.  @ingroup posix_option_xopen_streams*/
+#define I_GETSIG  (__SID | 10)
+/** @brief Look at the first message on the read queue.  @ingroup posix_option_xopen_streams*/
+#define I_PEEK    (__SID | 15)
+/** @brief Check whether a priority band is writable.  @ingroup posix_option_xopen_streams*/
+#define I_CANPUT  (__SID | 34)
+
+/** @brief I_FLUSH: flush the read queue.  @ingroup posix_option_xopen_streams*/
+#define FLUSHR  0x01
+/** @brief I_FLUSH: flush the write queue.  @ingroup posix_option_xopen_streams*/
+#define FLUSHW  0x02
+/** @brief I_FLUSH: flush the read and write queues.  @ingroup posix_option_xopen_streams*/
+#define FLUSHRW 0x03
+
+/** @brief I_SETSIG: a message other than a high-priority one arrived.  @ingroup posix_option_xopen_streams*/
+#define S_INPUT   0x0001
+/** @brief I_SETSIG: a high-priority message arrived.  @ingroup posix_option_xopen_streams*/
+#define S_HIPRI   0x0002
+/** @brief I_SETSIG: band 0 of the write queue is no longer full.  @ingroup posix_option_xopen_streams*/
+#define S_OUTPUT  0x0004
+/** @brief I_SETSIG: the other end of the stream was closed.  @ingroup posix_option_xopen_streams*/
+#define S_HANGUP  0x0020
+/** @brief I_SETSIG: a band 0 message arrived.  @ingroup posix_option_xopen_streams*/
+#define S_RDNORM  0x0040
+/** @brief I_SETSIG: a message in a band above 0 arrived.  @ingroup posix_option_xopen_streams*/
+#define S_RDBAND  0x0080
+/** @brief I_SETSIG: alias of S_OUTPUT.  @ingroup posix_option_xopen_streams*/
+#define S_WRNORM  S_OUTPUT
+/** @brief I_SETSIG: a band above 0 of the write queue is no longer full.  @ingroup posix_option_xopen_streams*/
+#define S_WRBAND  0x0100
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/** @brief Unsigned integer type used by STREAMS structures. */
+typedef unsigned int t_uscalar_t;
+
 /** @brief Buffer descriptor for STREAMS getmsg() / putmsg() control and data parts. */
 struct strbuf {
 	int maxlen;  /**< Maximum buffer length. */
@@ -38,6 +94,13 @@ struct strbuf {
 	char *buf;   /**< Pointer to data buffer. */
 };
 
+/** @brief Argument of the I_PEEK ioctl. */
+struct strpeek {
+	struct strbuf ctlbuf;  /**< Control part of the message. */
+	struct strbuf databuf; /**< Data part of the message. */
+	t_uscalar_t flags;     /**< 0 or RS_HIPRI to only look at high-priority messages. */
+};
+
 /**
  * @brief Send a STREAMS message downstream.
  * @ingroup posix_option_xopen_streams
@@ -94,6 +157,20 @@ int getmsg(int fildes, struct strbuf *ctlptr, struct strbuf *dataptr, int *flags
  */
 int getpmsg(int fildes, struct strbuf *ctlptr, struct strbuf *dataptr, int *bandp, int *flagsp);
 
+/**
+ * @brief Send a STREAMS message in a priority band.
+ * @ingroup posix_option_xopen_streams
+ * @param fildes  STREAMS file descriptor.
+ * @param ctlptr  Control part of the message, or NULL.
+ * @param dataptr Data part of the message, or NULL.
+ * @param band    Priority band, which must be 0 for MSG_HIPRI.
+ * @param flags   MSG_HIPRI or MSG_BAND.
+ * @return 0 on success, or -1 with errno set on failure.
+ * @see https://pubs.opengroup.org/onlinepubs/9699919799/functions/putpmsg.html
+ */
+int putpmsg(int fildes, const struct strbuf *ctlptr, const struct strbuf *dataptr, int band,
+	    int flags);
+
 /**
  * @brief Test whether a file descriptor refers to a STREAMS file.
  * @ingroup posix_option_xopen_streams
@@ -103,6 +180,32 @@ int getpmsg(int fildes, struct strbuf *ctlptr, struct strbuf *dataptr, int *band
  */
 int isastream(int fildes);
 
+#if defined(_GNU_SOURCE) || defined(__DOXYGEN__)
+
+/**
+ * @brief Create a unidirectional STREAMS pipe.
+ * @ingroup posix_option_xopen_streams
+ *
+ * Messages written to @p fildes[1] are read from @p fildes[0], with their boundaries and
+ * priority bands preserved.
+ *
+ * @param fildes Output: the read end and the write end of the pipe.
+ * @return 0 on success, or -1 with errno set on failure.
+ */
+int stream_pipe_np(int fildes[2]);
+
+/**
+ * @brief Create a pair of connected STREAMS file descriptors.
+ * @ingroup posix_option_xopen_streams
+ *
+ * Like socketpair(), messages written to either descriptor are read from the other.
+ *
+ * @param fildes Output: the two ends of the stream.
+ * @return 0 on success, or -1 with errno set on failure.
+ */
+int stream_socketpair_np(int fildes[2]);
+
+#endif /* defined(_GNU_SOURCE) || defined(__DOXYGEN__) */
 
 #ifdef __cplusplus
 }
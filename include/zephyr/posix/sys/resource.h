@@ -0,0 +1,85 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief POSIX resource usage (<sys/resource.h>)
+ *
+ * @see <a href="https://pubs.opengroup.org/onlinepubs/9699919799/basedefs/sys_resource.h.html">
+ *      POSIX.1-2017 &lt;sys/resource.h&gt;</a>
+ *
+ * @ingroup posix_option_group_xsi_multi_process
+ */
+
+#ifndef ZEPHYR_INCLUDE_POSIX_SYS_RESOURCE_H_
+#define ZEPHYR_INCLUDE_POSIX_SYS_RESOURCE_H_
+
+#include <sys/time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_XOPEN_SOURCE) || defined(__DOXYGEN__)
+
+/** @brief Report the resource usage of the calling process.  @ingroup posix_option_group_xsi_multi_process */
+#undef RUSAGE_SELF
+#define RUSAGE_SELF 0
+/** @brief Report the resource usage of terminated children.  @ingroup posix_option_group_xsi_multi_process */
+#undef RUSAGE_CHILDREN
+#define RUSAGE_CHILDREN (-1)
+
+#if defined(_GNU_SOURCE) || defined(__DOXYGEN__)
+/** @brief GNU extension: report the resource usage of the calling thread.  @ingroup posix_option_group_xsi_multi_process */
+#undef RUSAGE_THREAD
+#define RUSAGE_THREAD 1
+#endif
+
+#if !defined(_RUSAGE_DECLARED) && !defined(__rusage_defined)
+/**
+ * @brief Resource usage filled in by getrusage().
+ *
+ * Only @c ru_utime and @c ru_stime are required by POSIX. The other members follow the layout
+ * used by Linux and the BSDs, and those that do not apply are zero.
+ */
+struct rusage {
+	struct timeval ru_utime; /**< User CPU time. */
+	struct timeval ru_stime; /**< System CPU time, always zero. */
+	long ru_maxrss;          /**< Peak stack and heap use, in kilobytes. */
+	long ru_ixrss;           /**< Unused. */
+	long ru_idrss;           /**< Unused. */
+	long ru_isrss;           /**< Unused. */
+	long ru_minflt;          /**< Page faults without I/O, always zero. */
+	long ru_majflt;          /**< Page faults that paged memory in. */
+	long ru_nswap;           /**< Unused. */
+	long ru_inblock;         /**< Unused. */
+	long ru_oublock;         /**< Unused. */
+	long ru_msgsnd;          /**< Unused. */
+	long ru_msgrcv;          /**< Unused. */
+	long ru_nsignals;        /**< Unused. */
+	long ru_nvcsw;           /**< Context switches while blocked. */
+	long ru_nivcsw;          /**< Context switches while still ready to run. */
+};
+#define _RUSAGE_DECLARED
+#define __rusage_defined
+#endif
+
+/**
+ * @brief Get information about resource usage.
+ * @ingroup posix_option_group_xsi_multi_process
+ * @param who @c RUSAGE_SELF, @c RUSAGE_CHILDREN, or @c RUSAGE_THREAD.
+ * @param r_usage Output: resource usage of @p who.
+ * @return 0 on success, or -1 with errno set on failure.
+ * @see https://pubs.opengroup.org/onlinepubs/9699919799/functions/getrusage.html
+ */
+int getrusage(int who, struct rusage *r_usage);
+
+#endif /* defined(_XOPEN_SOURCE) || defined(__DOXYGEN__) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_POSIX_SYS_RESOURCE_H_ */
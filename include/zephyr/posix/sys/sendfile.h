@@ -0,0 +1,89 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Linux-compatible in-kernel data transfer between file descriptors (<sys/sendfile.h>)
+ *
+ * sendfile() and splice() move data from one file descriptor to another without passing it
+ * through a buffer owned by the caller, e.g. to serve a file over a socket.
+ *
+ * @note sendfile() and splice() are Linux extensions, not part of POSIX.1-2017, but are widely
+ *       available on Linux and implemented here for compatibility. On Linux, splice() and its
+ *       flags are declared in <fcntl.h>.
+ */
+
+#ifndef ZEPHYR_INCLUDE_POSIX_SYS_SENDFILE_H_
+#define ZEPHYR_INCLUDE_POSIX_SYS_SENDFILE_H_
+
+#include <stddef.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Hint to move pages rather than copy them (accepted and ignored). */
+#define SPLICE_F_MOVE     0x01
+/** @brief Hint not to block on I/O (accepted and ignored). */
+#define SPLICE_F_NONBLOCK 0x02
+/** @brief Hint that more data will be spliced in a subsequent call (accepted and ignored). */
+#define SPLICE_F_MORE     0x04
+/** @brief Unused for splice() (accepted and ignored). */
+#define SPLICE_F_GIFT     0x08
+
+/**
+ * @brief Transfer data from a file to another file descriptor.
+ *
+ * Copies up to @p count bytes from @p in_fd to @p out_fd, typically a socket. If @p in_fd
+ * can be memory-mapped (e.g. a shared memory object), data is sent directly from the mapping.
+ * Otherwise it is staged through an internal bounce buffer.
+ *
+ * If @p offset is not NULL, data is read starting at @p *offset, @p *offset is set to the
+ * offset following the last byte sent, and the file offset of @p in_fd is not modified.
+ * Otherwise, data is read from the file offset of @p in_fd, which is advanced by the number of
+ * bytes sent.
+ *
+ * @param out_fd File descriptor open for writing.
+ * @param in_fd  Seekable file descriptor open for reading.
+ * @param offset Optional pointer to the offset to read from.
+ * @param count  Maximum number of bytes to transfer.
+ * @return Number of bytes sent on success, which may be less than @p count, or -1 with errno
+ *         set on failure.
+ * @see https://man7.org/linux/man-pages/man2/sendfile.2.html
+ */
+ssize_t sendfile(int out_fd, int in_fd, off_t *offset, size_t count);
+
+/**
+ * @brief Transfer data between two file descriptors.
+ *
+ * Copies up to @p len bytes from @p fd_in to @p fd_out through an internal bounce buffer.
+ * Either descriptor may be a pipe-like object, such as a socket or an eventfd, that does not
+ * support seeking.
+ *
+ * If @p off_in (resp. @p off_out) is not NULL, the corresponding descriptor must be seekable.
+ * Data is then transferred at that offset, which is advanced by the number of bytes
+ * transferred, and the file offset of the descriptor is not modified.
+ *
+ * @note Unlike Linux, neither descriptor is required to refer to a pipe.
+ *
+ * @param fd_in   File descriptor open for reading.
+ * @param off_in  Optional pointer to the offset to read from.
+ * @param fd_out  File descriptor open for writing.
+ * @param off_out Optional pointer to the offset to write to.
+ * @param len     Maximum number of bytes to transfer.
+ * @param flags   0, or a combination of the SPLICE_F_* hints.
+ * @return Number of bytes transferred on success, 0 at end of input, or -1 with errno set on
+ *         failure.
+ * @see https://man7.org/linux/man-pages/man2/splice.2.html
+ */
+ssize_t splice(int fd_in, off_t *off_in, int fd_out, off_t *off_out, size_t len,
+	       unsigned int flags);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_POSIX_SYS_SENDFILE_H_ */
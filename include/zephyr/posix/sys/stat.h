@@ -223,11 +223,11 @@ struct stat {
 int chmod(const char *path, mode_t mode);
 /** @brief Change the mode of an open file.  @ingroup posix_option_group_file_system*/
 int fchmod(int fildes, mode_t mode);
-/** @brief Change the mode of a file relative to a directory descriptor.  @ingroup posix_option_group_file_system*/
+/** @brief Change the mode of a file relative to a directory descriptor.  @ingroup posix_option_group_file_system_fd*/
 int fchmodat(int fd, const char *path, mode_t mode, int flag);
 /** @brief Get status of an open file.  @ingroup posix_option_group_file_system*/
 int fstat(int fildes, struct stat *buf);
-/** @brief Get status of a file relative to a directory descriptor.  @ingroup posix_option_group_file_system*/
+/** @brief Get status of a file relative to a directory descriptor.  @ingroup posix_option_group_file_system_fd*/
 int fstatat(int fd, const char *ZRESTRICT path, struct stat *ZRESTRICT buf, int flag);
 /** @brief Set file access and modification times of an open file (nanosecond resolution).  @ingroup posix_option_group_file_system*/
 int futimens(int fildes, const struct timespec times[2]);
@@ -235,11 +235,11 @@ int futimens(int fildes, const struct timespec times[2]);
 int lstat(const char *ZRESTRICT path, struct stat *ZRESTRICT buf);
 /** @brief Create a directory.  @ingroup posix_option_group_file_system*/
 int mkdir(const char *path, mode_t mode);
-/** @brief Create a directory relative to a directory descriptor.  @ingroup posix_option_group_file_system*/
+/** @brief Create a directory relative to a directory descriptor.  @ingroup posix_option_group_file_system_fd*/
 int mkdirat(int fd, const char *path, mode_t mode);
 /** @brief Create a FIFO special file.  @ingroup posix_option_group_file_system*/
 int mkfifo(const char *path, mode_t mode);
-/** @brief Create a FIFO special file relative to a directory descriptor.  @ingroup posix_option_group_file_system*/
+/** @brief Create a FIFO special file relative to a directory descriptor.  @ingroup posix_option_group_file_system_fd*/
 int mkfifoat(int fd, const char *path, mode_t mode);
 #if defined(_XOPEN_SOURCE) || defined(__DOXYGEN__)
 /** @brief Create a special or regular file (XSI extension). @ingroup posix_option_group_xsi_file_system */
@@ -167,7 +167,8 @@ enum {
 
 /* clang-format off */
 
-#define __z_posix_sysconf_SC_ADVISORY_INFO (-1L)
+#define __z_posix_sysconf_SC_ADVISORY_INFO                                                         \
+	COND_CODE_1(CONFIG_POSIX_ADVISORY_INFO, (_POSIX_ADVISORY_INFO), (-1L))
 #define __z_posix_sysconf_SC_ASYNCHRONOUS_IO                                                       \
 	COND_CODE_1(CONFIG_POSIX_ASYNCHRONOUS_IO, (_POSIX_ASYNCHRONOUS_IO), (-1L))
 #define __z_posix_sysconf_SC_BARRIERS COND_CODE_1(CONFIG_POSIX_BARRIERS, (_POSIX_BARRIERS), (-1L))
@@ -200,7 +201,8 @@ enum {
 #define __z_posix_sysconf_SC_READER_WRITER_LOCKS                                                   \
 	COND_CODE_1(CONFIG_POSIX_RW_LOCKS, (_POSIX_READER_WRITER_LOCKS), (-1L))
 #define __z_posix_sysconf_SC_REALTIME_SIGNALS      (-1L)
-#define __z_posix_sysconf_SC_REGEXP                (-1L)
+#define __z_posix_sysconf_SC_REGEXP                                                                \
+	COND_CODE_1(CONFIG_POSIX_REGEXP, (_POSIX_REGEXP), (-1L))
 #define __z_posix_sysconf_SC_SAVED_IDS             (-1L)
 #define __z_posix_sysconf_SC_SEMAPHORES                                                            \
 	COND_CODE_1(CONFIG_POSIX_SEMAPHORES, (_POSIX_SEMAPHORES), (-1L))
@@ -212,7 +214,8 @@ enum {
 	COND_CODE_1(CONFIG_POSIX_SPIN_LOCKS, (_POSIX_SPIN_LOCKS), (-1L))
 #define __z_posix_sysconf_SC_SPORADIC_SERVER (-1L)
 #define __z_posix_sysconf_SC_SS_REPL_MAX     _POSIX_SS_REPL_MAX
-#define __z_posix_sysconf_SC_SYNCHRONIZED_IO (-1L)
+#define __z_posix_sysconf_SC_SYNCHRONIZED_IO                                                       \
+	COND_CODE_1(CONFIG_POSIX_SYNCHRONIZED_IO, (_POSIX_SYNCHRONIZED_IO), (-1L))
 #define __z_posix_sysconf_SC_THREAD_ATTR_STACKADDR                                                 \
 	COND_CODE_1(CONFIG_POSIX_THREAD_ATTR_STACKADDR, (_POSIX_THREAD_ATTR_STACKADDR), (-1))
 #define __z_posix_sysconf_SC_THREAD_ATTR_STACKSIZE                                                 \
@@ -231,7 +234,8 @@ enum {
 	COND_CODE_1(IS_ENABLED(CONFIG_POSIX_FILE_SYSTEM_R) &&                                        \
 			    IS_ENABLED(CONFIG_POSIX_C_LANG_SUPPORT_R),                               \
 		    (_POSIX_THREAD_SAFE_FUNCTIONS), (-1L))
-#define __z_posix_sysconf_SC_THREAD_SPORADIC_SERVER       (-1L)
+#define __z_posix_sysconf_SC_THREAD_SPORADIC_SERVER                                                \
+	COND_CODE_1(CONFIG_POSIX_THREAD_SPORADIC_SERVER, (_POSIX_THREAD_SPORADIC_SERVER), (-1L))
 #define __z_posix_sysconf_SC_THREADS                                                               \
 	COND_CODE_1(CONFIG_POSIX_THREADS, (_POSIX_THREADS), (-1L))
 #define __z_posix_sysconf_SC_TIMEOUTS                                                              \
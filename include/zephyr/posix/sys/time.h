@@ -52,6 +52,55 @@ extern "C" {
  */
 int gettimeofday(struct timeval *tv, void *tz);
 
+#if defined(_XOPEN_SOURCE) || defined(__DOXYGEN__)
+
+/** @brief Interval timer that counts wall time and generates SIGALRM.  @ingroup posix_option_group_xsi_timers */
+#undef ITIMER_REAL
+#define ITIMER_REAL 0
+/** @brief Interval timer that counts CPU time and generates SIGVTALRM.  @ingroup posix_option_group_xsi_timers */
+#undef ITIMER_VIRTUAL
+#define ITIMER_VIRTUAL 1
+/** @brief Interval timer that counts CPU time and generates SIGPROF.  @ingroup posix_option_group_xsi_timers */
+#undef ITIMER_PROF
+#define ITIMER_PROF 2
+
+#if !defined(_ITIMERVAL_DECLARED) && !defined(__itimerval_defined)
+/**
+ * @brief Value of an interval timer.
+ * @ingroup posix_option_group_xsi_timers
+ */
+struct itimerval {
+	struct timeval it_interval; /**< Timer interval, or zero for a one-shot timer. */
+	struct timeval it_value;    /**< Time until the next expiration, or zero if disarmed. */
+};
+#define _ITIMERVAL_DECLARED
+#define __itimerval_defined
+#endif
+
+/**
+ * @brief Get the value of an interval timer.
+ * @ingroup posix_option_group_xsi_timers
+ *
+ * @param which @c ITIMER_REAL or @c ITIMER_PROF. @c ITIMER_VIRTUAL fails with @c ENOTSUP.
+ * @param value Output: time until the timer expires, and its interval.
+ * @return 0 on success, or -1 with errno set on failure.
+ * @see https://pubs.opengroup.org/onlinepubs/9699919799/functions/getitimer.html
+ */
+int getitimer(int which, struct itimerval *value);
+
+/**
+ * @brief Arm or disarm an interval timer.
+ * @ingroup posix_option_group_xsi_timers
+ *
+ * @param which @c ITIMER_REAL or @c ITIMER_PROF. @c ITIMER_VIRTUAL fails with @c ENOTSUP.
+ * @param value Time until the timer expires, or zero to disarm it, and its interval.
+ * @param ovalue Output: the previous value of the timer, if not NULL.
+ * @return 0 on success, or -1 with errno set on failure.
+ * @see https://pubs.opengroup.org/onlinepubs/9699919799/functions/setitimer.html
+ */
+int setitimer(int which, const struct itimerval *value, struct itimerval *ovalue);
+
+#endif /* defined(_XOPEN_SOURCE) || defined(__DOXYGEN__) */
 
 #ifdef __cplusplus
 }
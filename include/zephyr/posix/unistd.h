@@ -274,7 +274,7 @@ int execve(const char *path, char *const argv[], char *const envp[]);
 int execvp(const char *file, char *const argv[]);
 /**
  * @brief Determine accessibility of a file relative to a directory descriptor.
- * @ingroup posix_option_group_file_system
+ * @ingroup posix_option_group_file_system_fd
  * @see https://pubs.opengroup.org/onlinepubs/9699919799/functions/faccessat.html
  */
 int faccessat(int fd, const char *path, int amode, int flag);
@@ -292,7 +292,7 @@ int fchdir(int fildes);
 int fchown(int fildes, uid_t owner, gid_t group);
 /**
  * @brief Change owner and group of a file relative to a directory descriptor.
- * @ingroup posix_option_group_file_system
+ * @ingroup posix_option_group_file_system_fd
  * @see https://pubs.opengroup.org/onlinepubs/9699919799/functions/fchownat.html
  */
 int fchownat(int fd, const char *path, uid_t owner, gid_t group, int flag);
@@ -462,7 +462,7 @@ int lchown(const char *path, uid_t owner, gid_t group);
 int link(const char *path1, const char *path2);
 /**
  * @brief Create a hard link relative to directory file descriptors.
- * @ingroup posix_option_group_file_system
+ * @ingroup posix_option_group_file_system_fd
  * @see https://pubs.opengroup.org/onlinepubs/9699919799/functions/linkat.html
  */
 int linkat(int fd1, const char *path1, int fd2, const char *path2, int flag);
@@ -532,7 +532,7 @@ ssize_t read(int fildes, void *buf, size_t nbyte);
 ssize_t readlink(const char *restrict path, char *restrict buf, size_t bufsize);
 /**
  * @brief Read the value of a symbolic link relative to a directory descriptor.
- * @ingroup posix_option_group_file_system
+ * @ingroup posix_option_group_file_system_fd
  * @see https://pubs.opengroup.org/onlinepubs/9699919799/functions/readlinkat.html
  */
 ssize_t readlinkat(int fd, const char *restrict path, char *restrict buf, size_t bufsize);
@@ -622,7 +622,7 @@ void swab(const void *ZRESTRICT src, void *ZRESTRICT dest, ssize_t nbytes);
 int symlink(const char *path1, const char *path2);
 /**
  * @brief Create a symbolic link relative to a directory file descriptor.
- * @ingroup posix_option_group_file_system
+ * @ingroup posix_option_group_file_system_fd
  * @see https://pubs.opengroup.org/onlinepubs/9699919799/functions/symlinkat.html
  */
 int symlinkat(const char *path1, int fd, const char *path2);
@@ -686,7 +686,7 @@ int ttyname_r(int fildes, char *name, size_t namesize);
 int unlink(const char *path);
 /**
  * @brief Remove a directory entry relative to a directory file descriptor.
- * @ingroup posix_option_group_file_system
+ * @ingroup posix_option_group_file_system_fd
  * @see https://pubs.opengroup.org/onlinepubs/9699919799/functions/unlinkat.html
  */
 int unlinkat(int fd, const char *path, int flag);
@@ -53,10 +53,6 @@
 
 #define EOS '\0'
 
-#ifndef FNM_NORES
-#define FNM_NORES 3
-#endif
-
 #ifndef FNM_LEADING_DIR
 #define FNM_LEADING_DIR 0x08
 #endif
@@ -249,15 +245,23 @@ static int rangematch(const char **pattern, char test, int flags)
 	return RANGE_NOMATCH;
 }
 
-static int fnmatchx(const char *pattern, const char *string, const char *stringstart, int flags,
-		    size_t recursion)
+/*
+ * Iterative matcher with single star backtracking.
+ *
+ * Every pattern element other than '*' matches exactly one character, so after a mismatch only
+ * the most recent '*' needs to be retried, consuming one more character of the string. Earlier
+ * stars never need to be revisited, which bounds the work to O(strlen(pattern) * strlen(string))
+ * and the stack usage to a constant. With FNM_PATHNAME, a '*' cannot consume a '/', so a '/'
+ * matched after it ends its scope.
+ */
+static int fnmatchx(const char *pattern, const char *string, int flags)
 {
 	char c;
 	char pc, sc;
-
-	if (recursion-- == 0) {
-		return FNM_NORES;
-	}
+	const char *const stringstart = string;
+	/* pattern following, and string position to retry, the most recent '*' */
+	const char *star_pattern = NULL;
+	const char *star_string = NULL;
 
 	while (true) {
 		pc = FOLDCASE(*pattern++, flags);
@@ -270,18 +274,18 @@ static int fnmatchx(const char *pattern, const char *string, const char *strings
 			if (sc == EOS) {
 				return 0;
 			}
-			return FNM_NOMATCH;
+			goto backtrack;
 		case '?':
 			if (sc == EOS) {
 				return FNM_NOMATCH;
 			}
 			if ((sc == '/') && ((flags & FNM_PATHNAME) != 0)) {
-				return FNM_NOMATCH;
+				goto backtrack;
 			}
 			if ((sc == '.') && ((flags & FNM_PERIOD) != 0) &&
 			    ((string == stringstart) ||
 			     (((flags & FNM_PATHNAME) != 0) && (*(string - 1) == '/')))) {
-				return FNM_NOMATCH;
+				goto backtrack;
 			}
 			++string;
 			break;
@@ -295,7 +299,7 @@ static int fnmatchx(const char *pattern, const char *string, const char *strings
 			if ((sc == '.') && ((flags & FNM_PERIOD) != 0) &&
 			    ((string == stringstart) ||
 			     (((flags & FNM_PATHNAME) != 0) && (*(string - 1) == '/')))) {
-				return FNM_NOMATCH;
+				goto backtrack;
 			}
 
 			/* Optimize for pattern with * at end or before /. */
@@ -309,38 +313,32 @@ static int fnmatchx(const char *pattern, const char *string, const char *strings
 					return 0;
 				}
 
-				return FNM_NOMATCH;
+				goto backtrack;
 			} else if ((c == '/') && ((flags & FNM_PATHNAME) != 0)) {
 				string = strchr(string, '/');
 				if (string == NULL) {
 					return FNM_NOMATCH;
 				}
+				/* the '/' that follows is the only one this star may end at */
+				star_pattern = NULL;
 				break;
 			}
 
-			/* General case, use recursion. */
-			while (sc != EOS) {
-				if (fnmatchx(pattern, string, stringstart, flags, recursion) == 0) {
-					return 0;
-				}
-				sc = FOLDCASE(*string, flags);
-				if ((sc == '/') && ((flags & FNM_PATHNAME) != 0)) {
-					break;
-				}
-				++string;
-			}
-			return FNM_NOMATCH;
+			/* match nothing at first, and one more character on every retry */
+			star_pattern = pattern;
+			star_string = string;
+			break;
 		case '[':
 			if (sc == EOS) {
 				return FNM_NOMATCH;
 			}
 			if ((sc == '/') && ((flags & FNM_PATHNAME) != 0)) {
-				return FNM_NOMATCH;
+				goto backtrack;
 			}
 			if ((sc == '.') && ((flags & FNM_PERIOD) != 0) &&
 			    ((string == stringstart) ||
 			     (((flags & FNM_PATHNAME) != 0) && (*(string - 1) == '/')))) {
-				return FNM_NOMATCH;
+				goto backtrack;
 			}
 
 			switch (rangematch(&pattern, sc, flags)) {
@@ -349,28 +347,51 @@ static int fnmatchx(const char *pattern, const char *string, const char *strings
 			case RANGE_MATCH:
 				break;
 			case RANGE_NOMATCH:
-				return FNM_NOMATCH;
+				goto backtrack;
 			}
 			++string;
 			break;
 		case '\\':
 			if ((flags & FNM_NOESCAPE) == 0) {
+				if (*pattern == EOS) {
+					/* a trailing escape is ignored, without reading past it */
+					continue;
+				}
 				pc = FOLDCASE(*pattern++, flags);
 			}
 			__fallthrough;
 		default:
 norm:
 			if (pc != sc) {
-				return FNM_NOMATCH;
+				goto backtrack;
+			}
+			if ((sc == '/') && ((flags & FNM_PATHNAME) != 0)) {
+				/* no earlier star can extend past a matched '/' */
+				star_pattern = NULL;
 			}
 			++string;
 			break;
 		}
+
+		continue;
+
+backtrack:
+		if (star_pattern == NULL) {
+			return FNM_NOMATCH;
+		}
+
+		sc = *star_string;
+		if ((sc == EOS) || ((sc == '/') && ((flags & FNM_PATHNAME) != 0))) {
+			return FNM_NOMATCH;
+		}
+
+		pattern = star_pattern;
+		string = ++star_string;
 	}
 	CODE_UNREACHABLE;
 }
 
 int fnmatch(const char *pattern, const char *string, int flags)
 {
-	return fnmatchx(pattern, string, string, flags, 64);
+	return fnmatchx(pattern, string, flags);
 }
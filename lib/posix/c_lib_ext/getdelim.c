@@ -0,0 +1,223 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+
+#include <zephyr/sys/util.h>
+#include <zephyr/toolchain.h>
+
+#if defined(CONFIG_MINIMAL_LIBC) && defined(CONFIG_ZVFS)
+#include <zephyr/sys/zvfs.h>
+#include <zephyr/sys/zvfs_libc.h>
+#endif
+
+/* smallest buffer allocated by getdelim() */
+#define GETDELIM_MIN_SIZE 128
+
+#define ONES  ((uintptr_t)-1 / 0xff)
+#define HIGHS (ONES << 7)
+
+/* non-zero if any byte of x is zero */
+#define HAS_ZERO(x) (((x) - ONES) & ~(x) & HIGHS)
+
+/* memchr(), but comparing a machine word at a time */
+static char *find_delim(const char *s, unsigned char c, size_t n)
+{
+	uintptr_t word;
+	const uintptr_t mask = ONES * c;
+
+	for (; (n > 0) && (((uintptr_t)s % sizeof(uintptr_t)) != 0); ++s, --n) {
+		if ((unsigned char)*s == c) {
+			return (char *)s;
+		}
+	}
+
+	for (; n >= sizeof(uintptr_t); s += sizeof(uintptr_t), n -= sizeof(uintptr_t)) {
+		memcpy(&word, s, sizeof(word));
+		if (HAS_ZERO(word ^ mask) != 0) {
+			break;
+		}
+	}
+
+	for (; n > 0; ++s, --n) {
+		if ((unsigned char)*s == c) {
+			return (char *)s;
+		}
+	}
+
+	return NULL;
+}
+
+/* ensure that at least @p need bytes are available in *lineptr, growing it geometrically */
+static int reserve(char **lineptr, size_t *n, size_t need)
+{
+	char *p;
+	size_t size = MAX(*n, GETDELIM_MIN_SIZE);
+
+	if ((*lineptr != NULL) && (need <= *n)) {
+		return 0;
+	}
+
+	while (size < need) {
+		if (size > SIZE_MAX / 2) {
+			size = need;
+			break;
+		}
+		size *= 2;
+	}
+
+	p = realloc(*lineptr, size);
+	if (p == NULL) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	*lineptr = p;
+	*n = size;
+
+	return 0;
+}
+
+/* NUL-terminate the record of @p len bytes stored in @p line */
+static ssize_t terminate(char *line, size_t len)
+{
+	if (len == 0) {
+		/* end-of-file, or an error reported by the stream */
+		return -1;
+	}
+
+	if (len > SSIZE_MAX) {
+		errno = EOVERFLOW;
+		return -1;
+	}
+
+	line[len] = '\0';
+
+	return (ssize_t)len;
+}
+
+#if defined(CONFIG_MINIMAL_LIBC) && defined(CONFIG_ZVFS)
+/*
+ * The minimal libc FILE is unbuffered and every fgetc() is a 1-byte read of the underlying file
+ * descriptor. For seekable files, read directly into the line buffer in chunks as large as the
+ * buffer allows, scan them for the delimiter, and give back whatever was read past it by seeking.
+ *
+ * Returns false, without consuming any input, if the stream is not seekable.
+ */
+static bool getdelim_fd(char **lineptr, size_t *n, int delimiter, FILE *stream, ssize_t *ret)
+{
+	int fd;
+	off_t pos;
+	ssize_t rc;
+	char *found;
+	size_t len = 0;
+
+	fd = zvfs_libc_fileno(stream);
+	if (fd < 3) {
+		return false;
+	}
+
+	pos = zvfs_lseek(fd, 0, SEEK_CUR);
+	if (pos < 0) {
+		return false;
+	}
+
+	*ret = -1;
+
+	for (;;) {
+		if (reserve(lineptr, n, len + 2) < 0) {
+			return true;
+		}
+
+		rc = zvfs_read(fd, *lineptr + len, *n - len - 1);
+		if (rc < 0) {
+			return true;
+		}
+
+		if (rc == 0) {
+			break;
+		}
+
+		found = find_delim(*lineptr + len, (unsigned char)delimiter, rc);
+		if (found != NULL) {
+			len = found - *lineptr + 1;
+			if (zvfs_lseek(fd, pos + len, SEEK_SET) < 0) {
+				return true;
+			}
+			break;
+		}
+
+		len += rc;
+	}
+
+	*ret = terminate(*lineptr, len);
+
+	return true;
+}
+#endif
+
+/**
+ * @brief Read a delimited record from a stream.
+ *
+ * See IEEE 1003.1
+ */
+ssize_t getdelim(char **ZRESTRICT lineptr, size_t *ZRESTRICT n, int delimiter,
+		 FILE *ZRESTRICT stream)
+{
+	int c;
+	size_t len = 0;
+
+	if ((lineptr == NULL) || (n == NULL) || (stream == NULL)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (*lineptr == NULL) {
+		*n = 0;
+	}
+
+#if defined(CONFIG_MINIMAL_LIBC) && defined(CONFIG_ZVFS)
+	ssize_t ret;
+
+	if (getdelim_fd(lineptr, n, delimiter, stream, &ret)) {
+		return ret;
+	}
+#endif
+
+	for (;;) {
+		c = getc(stream);
+		if (c == EOF) {
+			break;
+		}
+
+		if (reserve(lineptr, n, len + 2) < 0) {
+			return -1;
+		}
+
+		(*lineptr)[len++] = (char)c;
+		if (c == delimiter) {
+			break;
+		}
+	}
+
+	return terminate(*lineptr, len);
+}
+
+/**
+ * @brief Read a line from a stream.
+ *
+ * See IEEE 1003.1
+ */
+ssize_t getline(char **ZRESTRICT lineptr, size_t *ZRESTRICT n, FILE *ZRESTRICT stream)
+{
+	return getdelim(lineptr, n, '\n', stream);
+}
@@ -0,0 +1,560 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "fadvise_priv.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/hash_function.h>
+#include <zephyr/sys/internal/fdtable_priv.h>
+#include <zephyr/sys/util.h>
+
+LOG_MODULE_REGISTER(posix_fadvise, CONFIG_POSIX_ADVISORY_INFO_LOG_LEVEL);
+
+/*
+ * Descriptors advised with posix_fadvise() read regular files through a small block cache that is
+ * shared by all descriptors. Blocks are tagged with the open file description (fd_entry->obj)
+ * that they were read through and are kept on an LRU list, with the most recently used block at
+ * the head.
+ *
+ * Blocks belonging to an open file description only exist while at least one descriptor
+ * referring to it is advised, so the fast paths below only need to check whether any descriptor
+ * is advised at all.
+ *
+ * Separate open()s of a file have separate open file descriptions, so blocks are also tagged with
+ * a hash of the path that their file was opened with, and a write through any of them drops the
+ * blocks of all of them. A hash collision only drops more than needed.
+ *
+ * Lock ordering is fd_entry->lock, then fadv_lock.
+ */
+
+#define BLOCK_SIZE CONFIG_POSIX_FADVISE_BLOCK_SIZE
+#define CACHE_SIZE (CONFIG_POSIX_FADVISE_CACHE_BLOCKS * BLOCK_SIZE)
+#define RA_MIN     CONFIG_POSIX_FADVISE_READAHEAD_MIN
+#define RA_MAX     CONFIG_POSIX_FADVISE_READAHEAD_MAX
+
+struct fadv_block {
+	sys_dnode_t node;
+	const void *obj;
+	/* hash of the path of the file, or 0 if unknown */
+	uint32_t file;
+	off_t blkno;
+	uint8_t data[BLOCK_SIZE] __aligned(sizeof(void *));
+};
+
+struct fadv_state {
+	const void *obj;
+	uint32_t file;
+	struct k_work work;
+	/* offset following the previous read, or -1 */
+	off_t next;
+	/* end of the region already queued for readahead */
+	off_t ra_end;
+	/* region pending prefetch */
+	off_t pf_start;
+	off_t pf_end;
+	uint8_t advice;
+	/* readahead window, in blocks */
+	uint16_t window;
+};
+
+static struct fadv_block fadv_blocks[CONFIG_POSIX_FADVISE_CACHE_BLOCKS];
+static sys_dlist_t fadv_lru = SYS_DLIST_STATIC_INIT(&fadv_lru);
+static struct fadv_state fadv_states[ZVFS_OPEN_SIZE];
+/* the open file description that each descriptor was opened as, and the hash of its path */
+static struct {
+	const void *obj;
+	uint32_t file;
+} fadv_files[ZVFS_OPEN_SIZE];
+static atomic_t fadv_attached;
+static K_MUTEX_DEFINE(fadv_lock);
+
+static K_THREAD_STACK_DEFINE(fadv_stack, CONFIG_POSIX_FADVISE_PREFETCH_STACK_SIZE);
+static struct k_work_q fadv_workq;
+
+static inline bool fadv_overlaps(off_t blkno, off_t offset, off_t len)
+{
+	off_t start = blkno * BLOCK_SIZE;
+
+	return (start + BLOCK_SIZE > offset) && ((len == 0) || (start < offset + len));
+}
+
+static struct fadv_block *fadv_find(const void *obj, off_t blkno)
+{
+	ARRAY_FOR_EACH_PTR(fadv_blocks, blk) {
+		if ((blk->obj == obj) && (blk->blkno == blkno)) {
+			return blk;
+		}
+	}
+
+	return NULL;
+}
+
+static void fadv_touch(struct fadv_block *blk, bool cold)
+{
+	sys_dlist_remove(&blk->node);
+	if (cold) {
+		sys_dlist_append(&fadv_lru, &blk->node);
+	} else {
+		sys_dlist_prepend(&fadv_lru, &blk->node);
+	}
+}
+
+static uint32_t fadv_file(const void *obj)
+{
+	ARRAY_FOR_EACH_PTR(fadv_files, f) {
+		if (f->obj == obj) {
+			return f->file;
+		}
+	}
+
+	return 0;
+}
+
+/* drop the blocks of @p obj, and of other open file descriptions of @p file if it is not 0 */
+static void fadv_drop(const void *obj, uint32_t file, off_t offset, off_t len)
+{
+	ARRAY_FOR_EACH_PTR(fadv_blocks, blk) {
+		bool same = (blk->obj == obj) || ((file != 0) && (blk->file == file));
+
+		if ((blk->obj != NULL) && same && fadv_overlaps(blk->blkno, offset, len)) {
+			blk->obj = NULL;
+			fadv_touch(blk, true);
+		}
+	}
+}
+
+/*
+ * Read block @p blkno through @p entry into the least recently used block. Only complete blocks
+ * are retained; a short block (at end of file) is returned untagged so that its contents may be
+ * copied out before the cache lock is released.
+ */
+static ssize_t fadv_fill(struct fd_entry *entry, struct fadv_state *st, off_t blkno,
+			 struct fadv_block **out)
+{
+	ssize_t rc;
+	struct fadv_block *blk = CONTAINER_OF(sys_dlist_peek_tail(&fadv_lru), struct fadv_block,
+					      node);
+
+	blk->obj = NULL;
+	rc = entry->vtable->read_offs(entry->obj, blk->data, BLOCK_SIZE, blkno * BLOCK_SIZE);
+	if (rc == BLOCK_SIZE) {
+		blk->obj = st->obj;
+		blk->file = st->file;
+		blk->blkno = blkno;
+		fadv_touch(blk, st->advice == POSIX_FADV_NOREUSE);
+	}
+
+	*out = blk;
+	return rc;
+}
+
+static ssize_t fadv_copy(struct fd_entry *entry, struct fadv_state *st, uint8_t *dst, size_t sz,
+			 off_t pos)
+{
+	size_t done = 0;
+
+	while (done < sz) {
+		ssize_t rc;
+		size_t len;
+		size_t avail;
+		off_t off = pos + done;
+		off_t blkno = off / BLOCK_SIZE;
+		size_t skip = off % BLOCK_SIZE;
+		struct fadv_block *blk = fadv_find(st->obj, blkno);
+
+		if (blk != NULL) {
+			fadv_touch(blk, st->advice == POSIX_FADV_NOREUSE);
+			avail = BLOCK_SIZE;
+		} else if ((skip == 0) && (sz - done >= BLOCK_SIZE)) {
+			/* large aligned reads bypass the cache rather than being split into blocks */
+			len = ROUND_DOWN(sz - done, BLOCK_SIZE);
+			rc = entry->vtable->read_offs(entry->obj, &dst[done], len, off);
+			if (rc < 0) {
+				return (done > 0) ? done : rc;
+			}
+
+			done += rc;
+			if ((size_t)rc < len) {
+				break;
+			}
+
+			continue;
+		} else {
+			rc = fadv_fill(entry, st, blkno, &blk);
+			if (rc < 0) {
+				return (done > 0) ? done : rc;
+			}
+
+			avail = rc;
+		}
+
+		if (avail <= skip) {
+			break;
+		}
+
+		len = MIN(sz - done, avail - skip);
+		memcpy(&dst[done], &blk->data[skip], len);
+		done += len;
+
+		if (avail < BLOCK_SIZE) {
+			break;
+		}
+	}
+
+	return done;
+}
+
+static void fadv_queue(struct fadv_state *st, off_t start, off_t end)
+{
+	start = ROUND_DOWN(start, BLOCK_SIZE);
+	end = MIN(end, start + CACHE_SIZE);
+
+	if (k_work_is_pending(&st->work) && (st->pf_start < st->pf_end)) {
+		st->pf_start = MIN(st->pf_start, start);
+		st->pf_end = MAX(st->pf_end, end);
+	} else {
+		st->pf_start = start;
+		st->pf_end = end;
+	}
+
+	(void)k_work_submit_to_queue(&fadv_workq, &st->work);
+}
+
+static void fadv_readahead(struct fadv_state *st, off_t pos, size_t n)
+{
+	off_t start;
+	off_t end = pos + n;
+	bool sequential = (pos == st->next);
+
+	st->next = end;
+
+	switch (st->advice) {
+	case POSIX_FADV_SEQUENTIAL:
+		st->window = sequential ? MIN(st->window * 2, RA_MAX) : RA_MIN;
+		break;
+	case POSIX_FADV_NORMAL:
+	case POSIX_FADV_NOREUSE:
+		if (!sequential) {
+			st->ra_end = 0;
+			return;
+		}
+		st->window = RA_MIN;
+		break;
+	default:
+		return;
+	}
+
+	if (!sequential) {
+		st->ra_end = 0;
+	}
+
+	if (n == 0) {
+		/* end of file */
+		return;
+	}
+
+	start = MAX(ROUND_UP(end, BLOCK_SIZE), st->ra_end);
+	end = ROUND_UP(end, BLOCK_SIZE) + st->window * BLOCK_SIZE;
+	if (start < end) {
+		fadv_queue(st, start, end);
+		st->ra_end = end;
+	}
+}
+
+static void fadv_prefetch_work(struct k_work *work)
+{
+	off_t end;
+	off_t blkno;
+	struct fd_entry *entry;
+	struct fadv_block *blk;
+	struct fadv_state *st = CONTAINER_OF(work, struct fadv_state, work);
+	int fd = st - fadv_states;
+
+	entry = zvfs_fd_entry_get(fd);
+	if (entry == NULL) {
+		return;
+	}
+
+	/* one block at a time, so that readers are not held off for the whole region */
+	for (;;) {
+		(void)k_mutex_lock(&entry->lock, K_FOREVER);
+		(void)k_mutex_lock(&fadv_lock, K_FOREVER);
+
+		if ((st->obj == NULL) || (st->obj != entry->obj) || (st->pf_start >= st->pf_end)) {
+			st->pf_start = st->pf_end;
+			k_mutex_unlock(&fadv_lock);
+			k_mutex_unlock(&entry->lock);
+			return;
+		}
+
+		blkno = st->pf_start / BLOCK_SIZE;
+		st->pf_start += BLOCK_SIZE;
+		end = st->pf_end;
+
+		if ((fadv_find(st->obj, blkno) == NULL) &&
+		    (fadv_fill(entry, st, blkno, &blk) < BLOCK_SIZE)) {
+			/* end of file or error, abandon the rest of the region */
+			st->pf_start = end;
+		}
+
+		k_mutex_unlock(&fadv_lock);
+		k_mutex_unlock(&entry->lock);
+	}
+}
+
+bool posix_fadv_read(int fd, void *buf, size_t sz, const size_t *from_offset, ssize_t *ret)
+{
+	off_t pos;
+	ssize_t n;
+	struct fadv_state *st;
+	struct fd_entry *entry;
+
+	if (atomic_get(&fadv_attached) == 0) {
+		return false;
+	}
+
+	entry = zvfs_fd_entry_get(fd);
+	if (entry == NULL) {
+		return false;
+	}
+
+	st = &fadv_states[fd];
+	if ((st->obj == NULL) || (st->obj != entry->obj)) {
+		return false;
+	}
+
+	if ((st->advice == POSIX_FADV_RANDOM) && (sz >= BLOCK_SIZE)) {
+		return false;
+	}
+
+	(void)k_mutex_lock(&entry->lock, K_FOREVER);
+	(void)k_mutex_lock(&fadv_lock, K_FOREVER);
+
+	pos = (from_offset == NULL) ? entry->offset : *from_offset;
+	n = fadv_copy(entry, st, buf, sz, pos);
+	if (n >= 0) {
+		fadv_readahead(st, pos, n);
+	}
+
+	k_mutex_unlock(&fadv_lock);
+
+	if ((n > 0) && (from_offset == NULL)) {
+		entry->offset += n;
+	}
+
+	k_mutex_unlock(&entry->lock);
+
+	if (n < 0) {
+		errno = -n;
+		n = -1;
+	}
+
+	*ret = n;
+	return true;
+}
+
+void posix_fadv_invalidate(int fd, off_t offset, off_t len)
+{
+	struct fd_entry *entry;
+
+	if (atomic_get(&fadv_attached) == 0) {
+		return;
+	}
+
+	entry = zvfs_fd_entry_get(fd);
+	if (entry == NULL) {
+		return;
+	}
+
+	(void)k_mutex_lock(&fadv_lock, K_FOREVER);
+	fadv_drop(entry->obj, fadv_file(entry->obj), offset, len);
+	k_mutex_unlock(&fadv_lock);
+}
+
+void posix_fadv_open(int fd, const char *path)
+{
+	struct fd_entry *entry;
+
+	entry = zvfs_fd_entry_get(fd);
+	if (entry == NULL) {
+		return;
+	}
+
+	(void)k_mutex_lock(&fadv_lock, K_FOREVER);
+	/* a descriptor that was not closed with close() may have left its entry */
+	ARRAY_FOR_EACH_PTR(fadv_files, f) {
+		if (f->obj == entry->obj) {
+			f->obj = NULL;
+		}
+	}
+	fadv_files[fd].obj = entry->obj;
+	/* 0 is reserved for files whose path is not known */
+	fadv_files[fd].file = MAX(sys_hash32_djb2(path, strlen(path)), 1U);
+	k_mutex_unlock(&fadv_lock);
+}
+
+void posix_fadv_close(int fd)
+{
+	bool shared = false;
+	struct fadv_state *st;
+	struct fd_entry *entry;
+	struct k_work_sync sync;
+
+	if ((fd >= 0) && ((size_t)fd < ARRAY_SIZE(fadv_files)) && (fadv_files[fd].obj != NULL)) {
+		(void)k_mutex_lock(&fadv_lock, K_FOREVER);
+		fadv_files[fd].obj = NULL;
+		k_mutex_unlock(&fadv_lock);
+	}
+
+	if (atomic_get(&fadv_attached) == 0) {
+		return;
+	}
+
+	entry = zvfs_fd_entry_get(fd);
+	if (entry == NULL) {
+		return;
+	}
+
+	st = &fadv_states[fd];
+	if (st->obj == NULL) {
+		return;
+	}
+
+	(void)k_work_cancel_sync(&st->work, &sync);
+
+	(void)k_mutex_lock(&fadv_lock, K_FOREVER);
+
+	ARRAY_FOR_EACH_PTR(fadv_states, other) {
+		if ((other != st) && (other->obj == st->obj)) {
+			shared = true;
+			break;
+		}
+	}
+
+	if (!shared) {
+		fadv_drop(st->obj, 0, 0, 0);
+	}
+
+	st->obj = NULL;
+	(void)atomic_dec(&fadv_attached);
+
+	k_mutex_unlock(&fadv_lock);
+}
+
+/**
+ * @brief File advisory information.
+ *
+ * See IEEE 1003.1
+ */
+int posix_fadvise(int fd, off_t offset, off_t len, int advice)
+{
+	struct fadv_state *st;
+	struct fd_entry *entry;
+
+	entry = zvfs_fd_entry_get(fd);
+	if (entry == NULL) {
+		return EBADF;
+	}
+
+	switch (entry->mode & ZVFS_MODE_IFMT) {
+	case ZVFS_MODE_IFREG:
+		break;
+	case ZVFS_MODE_IFIFO:
+	case ZVFS_MODE_IFSOCK:
+		return ESPIPE;
+	default:
+		/* nothing to cache, so the advice has no effect */
+		return 0;
+	}
+
+	if ((offset < 0) || (len < 0)) {
+		return EINVAL;
+	}
+
+	switch (advice) {
+	case POSIX_FADV_NORMAL:
+	case POSIX_FADV_SEQUENTIAL:
+	case POSIX_FADV_RANDOM:
+	case POSIX_FADV_NOREUSE:
+	case POSIX_FADV_WILLNEED:
+	case POSIX_FADV_DONTNEED:
+		break;
+	default:
+		return EINVAL;
+	}
+
+	st = &fadv_states[fd];
+
+	(void)k_mutex_lock(&fadv_lock, K_FOREVER);
+
+	if (st->obj != entry->obj) {
+		if (st->obj == NULL) {
+			(void)atomic_inc(&fadv_attached);
+		}
+
+		st->obj = entry->obj;
+		st->file = fadv_file(entry->obj);
+		st->advice = POSIX_FADV_NORMAL;
+		st->window = RA_MIN;
+		st->next = -1;
+		st->ra_end = 0;
+		st->pf_start = 0;
+		st->pf_end = 0;
+	}
+
+	switch (advice) {
+	case POSIX_FADV_WILLNEED:
+		fadv_queue(st, offset, (len == 0) ? offset + CACHE_SIZE : offset + len);
+		break;
+	case POSIX_FADV_DONTNEED:
+		/* cancel any overlapping prefetch and forget the region */
+		if ((st->pf_end > offset) && ((len == 0) || (st->pf_start < offset + len))) {
+			st->pf_end = st->pf_start;
+		}
+		fadv_drop(st->obj, 0, offset, len);
+		break;
+	default:
+		st->advice = advice;
+		st->window = RA_MIN;
+		st->ra_end = 0;
+		break;
+	}
+
+	k_mutex_unlock(&fadv_lock);
+
+	LOG_DBG("fd %d advice %d [%ld, +%ld)", fd, advice, (long)offset, (long)len);
+
+	return 0;
+}
+
+static int fadv_init(void)
+{
+	static const struct k_work_queue_config cfg = {
+		.name = "posix_fadvise",
+	};
+
+	ARRAY_FOR_EACH_PTR(fadv_blocks, blk) {
+		sys_dlist_append(&fadv_lru, &blk->node);
+	}
+
+	ARRAY_FOR_EACH_PTR(fadv_states, st) {
+		k_work_init(&st->work, fadv_prefetch_work);
+	}
+
+	k_work_queue_start(&fadv_workq, fadv_stack, K_THREAD_STACK_SIZEOF(fadv_stack),
+			   K_LOWEST_APPLICATION_THREAD_PRIO, &cfg);
+
+	return 0;
+}
+SYS_INIT(fadv_init, POST_KERNEL, CONFIG_APPLICATION_INIT_PRIORITY);
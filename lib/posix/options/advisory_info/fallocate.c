@@ -0,0 +1,64 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/types.h>
+
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/zvfs.h>
+
+#include "posix_internal.h"
+
+/**
+ * @brief Ensure that storage is allocated for a file region.
+ *
+ * See IEEE 1003.1
+ */
+int posix_fallocate(int fd, off_t offset, off_t len)
+{
+	int ret = 0;
+	off_t end;
+	struct zvfs_stat zs;
+	int saved_errno = errno;
+
+	if ((offset < 0) || (len <= 0)) {
+		return EINVAL;
+	}
+
+	if (__builtin_add_overflow(offset, len, &end)) {
+		return EFBIG;
+	}
+
+	if (zvfs_fstat(fd, &zs) < 0) {
+		ret = errno;
+		goto out;
+	}
+
+	switch (zs.mode & ZVFS_MODE_IFMT) {
+	case ZVFS_MODE_IFREG:
+		break;
+	case ZVFS_MODE_IFIFO:
+	case ZVFS_MODE_IFSOCK:
+		ret = ESPIPE;
+		goto out;
+	default:
+		ret = ENODEV;
+		goto out;
+	}
+
+	/*
+	 * Supported file systems do not create sparse files, so storage is already allocated for
+	 * the region that lies within the file.
+	 */
+	if ((end > (off_t)zs.size) && (posix_fd_resize(fd, end) < 0)) {
+		ret = errno;
+	}
+
+out:
+	errno = saved_errno;
+
+	return ret;
+}
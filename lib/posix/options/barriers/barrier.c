@@ -7,6 +7,7 @@
  */
 
 #include "posix_internal.h"
+#include "trace_priv.h"
 
 #include <pthread.h>
 
@@ -26,10 +27,7 @@ struct posix_barrierattr {
 	uint32_t pshared;
 };
 
-static SYS_SEM_DEFINE(posix_barrier_lock, 1, 1);
-SYS_ELASTIPOOL_DEFINE_STATIC(posix_barrier_pool, sizeof(struct posix_barrier),
-			     __alignof(struct posix_barrier), CONFIG_MAX_PTHREAD_BARRIER_COUNT,
-			     CONFIG_MAX_PTHREAD_BARRIER_COUNT);
+POSIX_POOL_DEFINE(posix_barrier_pool, struct posix_barrier, CONFIG_MAX_PTHREAD_BARRIER_COUNT);
 
 int pthread_barrier_wait(pthread_barrier_t *b)
 {
@@ -37,11 +35,13 @@ int pthread_barrier_wait(pthread_barrier_t *b)
 	int err;
 	struct posix_barrier *bar;
 
-	bar = posix_get_pool_obj(&posix_barrier_pool, &posix_barrier_lock, *b);
+	bar = posix_pool_get(&posix_barrier_pool, *b);
 	if (bar == NULL) {
 		return EINVAL;
 	}
 
+	sys_port_trace_posix_enter(PTHREAD_BARRIER_WAIT, bar, K_FOREVER);
+
 	err = k_mutex_lock(&bar->mutex, K_FOREVER);
 	__ASSERT_NO_MSG(err == 0);
 
@@ -54,6 +54,9 @@ int pthread_barrier_wait(pthread_barrier_t *b)
 		goto unlock;
 	}
 
+	/* every thread but the last one to arrive blocks */
+	sys_port_trace_posix_blocking(PTHREAD_BARRIER_WAIT, bar, true);
+
 	while (bar->count != 0) {
 		err = k_condvar_wait(&bar->cond, &bar->mutex, K_FOREVER);
 		__ASSERT_NO_MSG(err == 0);
@@ -68,51 +71,50 @@ unlock:
 	err = k_mutex_unlock(&bar->mutex);
 	__ASSERT_NO_MSG(err == 0);
 
+	sys_port_trace_posix_exit(PTHREAD_BARRIER_WAIT, bar, 0);
+
 	return ret;
 }
 
 int pthread_barrier_init(pthread_barrier_t *b, const pthread_barrierattr_t *attr,
 			 unsigned int count)
 {
+	uint32_t handle;
 	struct posix_barrier *bar;
 
 	if (count == 0) {
 		return EINVAL;
 	}
 
-	if (sys_elastipool_alloc(&posix_barrier_pool, (void **)&bar) < 0) {
+	bar = posix_pool_alloc(&posix_barrier_pool, &handle);
+	if (bar == NULL) {
+		sys_port_trace_posix_call(PTHREAD_BARRIER_INIT, NULL, ENOMEM);
 		return ENOMEM;
 	}
 
 	bar->max = count;
 	bar->count = 0;
 
-	*b = (pthread_barrier_t)(uintptr_t)bar;
+	*b = (pthread_barrier_t)handle;
+	sys_port_trace_posix_call(PTHREAD_BARRIER_INIT, bar, 0);
 
 	return 0;
 }
 
 int pthread_barrier_destroy(pthread_barrier_t *b)
 {
-	int ret = EINVAL;
-	struct posix_barrier *bar;
-
-	bar = posix_get_pool_obj(&posix_barrier_pool, &posix_barrier_lock, *b);
-	if (bar == NULL) {
-		return EINVAL;
-	}
-
-	SYS_SEM_LOCK(&posix_barrier_lock) {
-		ret = sys_elastipool_free(&posix_barrier_pool, (void *)bar);
-		if (ret < 0) {
-			ret = -ret;
-		}
-	}
+	int ret;
+	/* looked up before it is freed, only to be traced */
+	struct posix_barrier *const bar __maybe_unused =
+		IS_ENABLED(CONFIG_POSIX_TRACING) ? posix_pool_get(&posix_barrier_pool, *b) : NULL;
 
+	ret = posix_pool_free(&posix_barrier_pool, *b, NULL);
 	if (ret == 0) {
 		*b = -1;
 	}
 
+	sys_port_trace_posix_call(PTHREAD_BARRIER_DESTROY, bar, ret);
+
 	return ret;
 }
 
@@ -169,7 +171,7 @@ static int pthread_barrier_pool_init(void)
 
 	for (i = 0; i < CONFIG_MAX_PTHREAD_BARRIER_COUNT; ++i) {
 		struct posix_barrier *bar =
-			&((struct posix_barrier *)posix_barrier_pool.config->storage)[i];
+			&((struct posix_barrier *)posix_barrier_pool.pool->config->storage)[i];
 
 		err = k_mutex_init(&bar->mutex);
 		__ASSERT_NO_MSG(err == 0);
@@ -25,7 +25,11 @@ int clock_nanosleep(clockid_t clock_id, int flags, const struct timespec *rqtp,
 		return -1;
 	}
 
+#ifdef CONFIG_POSIX_PRECISE_SLEEP
+	ret = posix_precise_nanosleep(sys_clock_from_clockid((int)clock_id), flags, rqtp, rmtp);
+#else
 	ret = sys_clock_nanosleep(sys_clock_from_clockid((int)clock_id), flags, rqtp, rmtp);
+#endif
 	if (ret < 0) {
 		errno = -ret;
 		return -1;
@@ -7,8 +7,14 @@
 
 #include <zephyr/sys/zvfs.h>
 
+#include "fadvise_priv.h"
+#include "sync_io_priv.h"
+
 int close(int fd)
 {
+	posix_fadv_close(fd);
+	posix_sync_close(fd);
+
 	return zvfs_close(fd);
 }
 #ifdef CONFIG_POSIX_DEVICE_IO_ALIAS_CLOSE
@@ -8,7 +8,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 
-#include <zephyr/sys/zvfs_fs.h>
+#include "fs_path_priv.h"
 
 int open(const char *name, int flags, ...)
 {
@@ -21,7 +21,7 @@ int open(const char *name, int flags, ...)
 		va_end(args);
 	}
 
-	return zvfs_open(name, flags, mode);
+	return posix_open_at(AT_FDCWD, name, flags, mode);
 }
 #ifdef CONFIG_POSIX_DEVICE_IO_ALIAS_OPEN
 FUNC_ALIAS(open, _open, int);
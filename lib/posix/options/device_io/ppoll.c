@@ -0,0 +1,84 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 202405L
+
+#include "sig_wait.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+/* up to this many file descriptors are copied to the stack to add the wake file descriptor */
+#define PPOLL_STACK_FDS 8
+
+int ppoll(struct pollfd *fds, nfds_t nfds, const struct timespec *ZRESTRICT timeout,
+	  const sigset_t *ZRESTRICT sigmask)
+{
+	int ret;
+	int wake;
+	bool woken;
+	nfds_t n = nfds;
+	struct pollfd *pfds = fds;
+	struct posix_sig_wait w;
+	struct pollfd stack_fds[PPOLL_STACK_FDS + 1];
+
+	if (posix_sig_wait_begin(&w, sigmask, timeout) < 0) {
+		return -1;
+	}
+
+	/* the wake file descriptor is waited for after the caller's, but not reported */
+	wake = posix_sig_wait_fd(&w);
+	if (wake >= 0) {
+		if (nfds < ARRAY_SIZE(stack_fds)) {
+			pfds = stack_fds;
+		} else if (nfds < SIZE_MAX / sizeof(*pfds)) {
+			pfds = k_malloc((nfds + 1) * sizeof(*pfds));
+		} else {
+			pfds = NULL;
+		}
+
+		if (pfds == NULL) {
+			posix_sig_wait_end(&w);
+			errno = EAGAIN;
+			return -1;
+		}
+
+		memcpy(pfds, fds, nfds * sizeof(*pfds));
+		pfds[nfds] = (struct pollfd){.fd = wake, .events = POLLIN};
+		++n;
+	}
+
+	do {
+		ret = poll(pfds, n, posix_sig_wait_timeout_ms(&w));
+
+		woken = (ret > 0) && (wake >= 0) && (pfds[nfds].revents != 0);
+		if (woken) {
+			--ret;
+		}
+	} while (!posix_sig_wait_done(&w, woken, &ret));
+
+	posix_sig_wait_end(&w);
+
+	if (pfds != fds) {
+		for (nfds_t i = 0; i < nfds; ++i) {
+			fds[i].revents = pfds[i].revents;
+		}
+
+		if (pfds != stack_fds) {
+			k_free(pfds);
+		}
+	}
+
+	return ret;
+}
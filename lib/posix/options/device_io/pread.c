@@ -10,8 +10,12 @@
 
 #include <zephyr/sys/zvfs.h>
 
+#include "fadvise_priv.h"
+#include "sync_io_priv.h"
+
 ssize_t pread(int fd, void *buf, size_t count, off_t offset)
 {
+	ssize_t ret;
 	size_t off = (size_t)offset;
 
 	if (offset < 0) {
@@ -19,5 +23,11 @@ ssize_t pread(int fd, void *buf, size_t count, off_t offset)
 		return -1;
 	}
 
+	posix_sync_read(fd);
+
+	if (posix_fadv_read(fd, buf, count, &off, &ret)) {
+		return ret;
+	}
+
 	return zvfs_read_offset(fd, buf, count, &off);
 }
@@ -3,16 +3,101 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "sig_wait.h"
+
+#include <errno.h>
 #include <signal.h>
+#include <stdbool.h>
+#include <string.h>
 #include <sys/select.h>
 #include <time.h>
 
 #include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/util.h>
 #include <zephyr/sys/zvfs.h>
 
 int pselect(int nfds, fd_set *readfds, fd_set *writefds, fd_set *exceptfds,
 	    const struct timespec *timeout, const sigset_t *sigmask)
 {
-	return zvfs_select(nfds, (struct zvfs_fd_set *)readfds, (struct zvfs_fd_set *)writefds,
-			   (struct zvfs_fd_set *)exceptfds, timeout, sigmask);
+	int ms;
+	int ret;
+	int wake;
+	bool woken;
+	fd_set wake_set;
+	struct timespec left;
+	struct posix_sig_wait w;
+	fd_set *const sets[] = {readfds, writefds, exceptfds};
+	fd_set saved[ARRAY_SIZE(sets)];
+
+	if ((nfds < 0) || (nfds > FD_SETSIZE)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (posix_sig_wait_begin(&w, sigmask, timeout) < 0) {
+		return -1;
+	}
+
+	/* each wait overwrites the sets, so start each one from the original */
+	ARRAY_FOR_EACH(sets, i) {
+		if (sets[i] != NULL) {
+			saved[i] = *sets[i];
+		}
+	}
+
+	/* the wake file descriptor is waited for with the caller's, but not reported */
+	wake = posix_sig_wait_fd(&w);
+	if (wake >= 0) {
+		if (readfds == NULL) {
+			FD_ZERO(&wake_set);
+			readfds = &wake_set;
+			saved[0] = wake_set;
+		}
+
+		/* only the caller's descriptors below nfds are waited for */
+		for (int fd = nfds; fd <= wake; ++fd) {
+			ARRAY_FOR_EACH(sets, i) {
+				if (sets[i] != NULL) {
+					FD_CLR(fd, &saved[i]);
+				}
+			}
+		}
+
+		FD_SET(wake, &saved[0]);
+		nfds = MAX(nfds, wake + 1);
+	}
+
+	do {
+		if (readfds != NULL) {
+			*readfds = saved[0];
+		}
+
+		if (writefds != NULL) {
+			*writefds = saved[1];
+		}
+
+		if (exceptfds != NULL) {
+			*exceptfds = saved[2];
+		}
+
+		ms = posix_sig_wait_timeout_ms(&w);
+		left = (struct timespec){
+			.tv_sec = ms / MSEC_PER_SEC,
+			.tv_nsec = (ms % MSEC_PER_SEC) * NSEC_PER_MSEC,
+		};
+
+		ret = zvfs_select(nfds, (struct zvfs_fd_set *)readfds,
+				  (struct zvfs_fd_set *)writefds, (struct zvfs_fd_set *)exceptfds,
+				  (ms < 0) ? NULL : &left, NULL);
+
+		woken = (ret > 0) && (wake >= 0) && FD_ISSET(wake, readfds);
+		if (woken) {
+			FD_CLR(wake, readfds);
+			--ret;
+		}
+	} while (!posix_sig_wait_done(&w, woken, &ret));
+
+	posix_sig_wait_end(&w);
+
+	return ret;
 }
@@ -10,8 +10,12 @@
 
 #include <zephyr/sys/zvfs.h>
 
+#include "fadvise_priv.h"
+#include "sync_io_priv.h"
+
 ssize_t pwrite(int fd, const void *buf, size_t count, off_t offset)
 {
+	ssize_t ret;
 	size_t off = (size_t)offset;
 
 	if (offset < 0) {
@@ -19,5 +23,14 @@ ssize_t pwrite(int fd, const void *buf, size_t count, off_t offset)
 		return -1;
 	}
 
-	return zvfs_write_offset(fd, buf, count, &off);
+	ret = zvfs_write_offset(fd, buf, count, &off);
+	if (ret > 0) {
+		posix_fadv_invalidate(fd, offset, ret);
+
+		if (posix_sync_write(fd) < 0) {
+			return -1;
+		}
+	}
+
+	return ret;
 }
@@ -9,8 +9,19 @@
 
 #include <zephyr/sys/zvfs.h>
 
+#include "fadvise_priv.h"
+#include "sync_io_priv.h"
+
 ssize_t read(int fd, void *buf, size_t sz)
 {
+	ssize_t ret;
+
+	posix_sync_read(fd);
+
+	if (posix_fadv_read(fd, buf, sz, NULL, &ret)) {
+		return ret;
+	}
+
 	return zvfs_read(fd, buf, sz);
 }
 #ifdef CONFIG_POSIX_DEVICE_IO_ALIAS_READ
@@ -0,0 +1,297 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "posix_internal.h"
+#include "sig_wait.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/clock.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/timeutil.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/sys/zvfs.h>
+
+#ifdef CONFIG_SIGNAL
+/*
+ * One file descriptor is shared by all waits. It is ready for the calling thread when a signal has
+ * been generated for it since its wait began, and for no other thread.
+ */
+static atomic_t sig_wake_fd = ATOMIC_INIT(-1);
+static K_MUTEX_DEFINE(sig_wake_fd_lock);
+
+static ssize_t sig_wake_read(void *obj, void *buf, size_t sz)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(sz);
+
+	errno = EBADF;
+	return -1;
+}
+
+static ssize_t sig_wake_write(void *obj, const void *buf, size_t sz)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(sz);
+
+	errno = EBADF;
+	return -1;
+}
+
+static int sig_wake_close(void *obj)
+{
+	ARG_UNUSED(obj);
+
+	/* the next wait opens another one */
+	atomic_set(&sig_wake_fd, -1);
+
+	return 0;
+}
+
+static int sig_wake_poll_prepare(struct zvfs_pollfd *pfd, struct k_poll_event **pev,
+				 struct k_poll_event *pev_end)
+{
+	struct posix_sig_waiter *w = posix_sig_waiter_current();
+
+	ARG_UNUSED(pfd);
+
+	if (w == NULL) {
+		/* polled by a thread that is not waiting for signals */
+		return 0;
+	}
+
+	if (*pev == pev_end) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	k_poll_event_init(*pev, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &w->wake);
+	++*pev;
+
+	return 0;
+}
+
+static int sig_wake_poll_update(struct zvfs_pollfd *pfd, struct k_poll_event **pev)
+{
+	int result;
+	unsigned int signaled;
+	struct posix_sig_waiter *w = posix_sig_waiter_current();
+
+	if (w == NULL) {
+		return 0;
+	}
+
+	k_poll_signal_check(&w->wake, &signaled, &result);
+	if (signaled != 0U) {
+		pfd->revents |= ZVFS_POLLIN & pfd->events;
+	}
+
+	++*pev;
+
+	return 0;
+}
+
+static int sig_wake_ioctl(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(obj);
+
+	switch (request) {
+	case ZFD_IOCTL_POLL_PREPARE: {
+		struct zvfs_pollfd *pfd = va_arg(args, struct zvfs_pollfd *);
+		struct k_poll_event **pev = va_arg(args, struct k_poll_event **);
+		struct k_poll_event *pev_end = va_arg(args, struct k_poll_event *);
+
+		return sig_wake_poll_prepare(pfd, pev, pev_end);
+	}
+	case ZFD_IOCTL_POLL_UPDATE: {
+		struct zvfs_pollfd *pfd = va_arg(args, struct zvfs_pollfd *);
+		struct k_poll_event **pev = va_arg(args, struct k_poll_event **);
+
+		return sig_wake_poll_update(pfd, pev);
+	}
+	case ZFD_IOCTL_STAT: {
+		struct zvfs_stat *st = va_arg(args, struct zvfs_stat *);
+
+		*st = (struct zvfs_stat){0};
+		st->mode = ZVFS_MODE_IFIFO;
+
+		return 0;
+	}
+	default:
+		errno = EINVAL;
+		return -1;
+	}
+}
+
+static const struct fd_op_vtable sig_wake_vtable = {
+	.read = sig_wake_read,
+	.write = sig_wake_write,
+	.close = sig_wake_close,
+	.ioctl = sig_wake_ioctl,
+};
+
+/* the shared file descriptor, or -1 if there is no room for it */
+static int sig_wake_fd_get(void)
+{
+	int fd = (int)atomic_get(&sig_wake_fd);
+	int err;
+
+	if (fd >= 0) {
+		return fd;
+	}
+
+	k_mutex_lock(&sig_wake_fd_lock, K_FOREVER);
+	fd = (int)atomic_get(&sig_wake_fd);
+	if (fd < 0) {
+		/* the wait goes on without it, so the error is not the caller's */
+		err = errno;
+		fd = zvfs_reserve_fd();
+		if (fd >= 0) {
+			zvfs_finalize_typed_fd(fd, &sig_wake_fd, &sig_wake_vtable, ZVFS_MODE_IFIFO);
+			atomic_set(&sig_wake_fd, fd);
+		}
+		errno = err;
+	}
+	k_mutex_unlock(&sig_wake_fd_lock);
+
+	return fd;
+}
+#endif /* CONFIG_SIGNAL */
+
+int posix_sig_wait_begin(struct posix_sig_wait *w, const sigset_t *sigmask,
+			 const struct timespec *timeout)
+{
+	k_timeout_t to = K_FOREVER;
+
+	if (timeout != NULL) {
+		if (!timespec_is_valid(timeout)) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		to = timespec_to_timeout(timeout, NULL);
+	}
+
+	*w = (struct posix_sig_wait){0};
+
+#ifdef CONFIG_SIGNAL
+	int ret;
+	struct k_sig_set kmask;
+
+	w->wake_fd = -1;
+
+	/* without a mask, the wait is interrupted by signals no more than poll() or select() */
+	if ((sigmask != NULL) && !k_is_user_context()) {
+		w->wake_fd = sig_wake_fd_get();
+		if (w->wake_fd >= 0) {
+			/* registered first, so that no signal generated from now on is missed */
+			posix_sig_waiter_add(&w->waiter);
+		}
+	}
+
+	/* sample first, so that a signal delivered when the mask is installed is not missed */
+	w->delivered = k_sig_delivered();
+
+	if (sigmask != NULL) {
+		ret = k_sig_mask(K_SIG_SETMASK, z_sig_set_from_posix(sigmask, &kmask), &w->restore);
+		if (ret < 0) {
+			posix_sig_wait_end(w);
+			errno = -ret;
+			return -1;
+		}
+
+		w->restore_mask = true;
+	}
+
+	if (k_sig_delivered() != w->delivered) {
+		posix_sig_wait_end(w);
+		errno = EINTR;
+		return -1;
+	}
+#else
+	ARG_UNUSED(sigmask);
+#endif
+
+	w->end = sys_timepoint_calc(to);
+
+	return 0;
+}
+
+int posix_sig_wait_fd(const struct posix_sig_wait *w)
+{
+#ifdef CONFIG_SIGNAL
+	return w->wake_fd;
+#else
+	ARG_UNUSED(w);
+
+	return -1;
+#endif
+}
+
+int posix_sig_wait_timeout_ms(const struct posix_sig_wait *w)
+{
+	k_timeout_t left = sys_timepoint_timeout(w->end);
+
+	if (K_TIMEOUT_EQ(left, K_FOREVER)) {
+		return -1;
+	}
+
+	return (int)MIN(k_ticks_to_ms_ceil64(left.ticks), INT_MAX);
+}
+
+bool posix_sig_wait_done(struct posix_sig_wait *w, bool woken, int *ret)
+{
+	if (*ret != 0) {
+		/* a file descriptor is ready, or the wait failed */
+		return true;
+	}
+
+#ifdef CONFIG_SIGNAL
+	if (woken) {
+		/* reset first, so that a signal generated from now on wakes the next wait */
+		k_poll_signal_reset(&w->waiter.wake);
+
+		/* a signal is delivered on return from this call, and counted by the next */
+		(void)k_sig_delivered();
+	}
+
+	if (k_sig_delivered() != w->delivered) {
+		errno = EINTR;
+		*ret = -1;
+		return true;
+	}
+#else
+	ARG_UNUSED(w);
+	ARG_UNUSED(woken);
+#endif
+
+	return sys_timepoint_expired(w->end);
+}
+
+void posix_sig_wait_end(struct posix_sig_wait *w)
+{
+#ifdef CONFIG_SIGNAL
+	if (w->wake_fd >= 0) {
+		posix_sig_waiter_remove(&w->waiter);
+		w->wake_fd = -1;
+	}
+
+	if (w->restore_mask) {
+		(void)k_sig_mask(K_SIG_SETMASK, &w->restore, NULL);
+		w->restore_mask = false;
+	}
+#else
+	ARG_UNUSED(w);
+#endif
+}
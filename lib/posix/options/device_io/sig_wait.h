@@ -0,0 +1,70 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_POSIX_OPTIONS_DEVICE_IO_SIG_WAIT_H_
+#define ZEPHYR_LIB_POSIX_OPTIONS_DEVICE_IO_SIG_WAIT_H_
+
+#include "sig_wake_priv.h"
+
+#include <signal.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/clock.h>
+
+/*
+ * State of a pselect() or ppoll() call.
+ *
+ * Signals are only delivered when a system call returns, and a thread that is blocked on file
+ * descriptors is not woken by the kernel when a signal is generated for it. When a signal mask is
+ * installed for the wait, the thread therefore also waits on a file descriptor that is ready when
+ * the POSIX layer generates a signal for it, and checks whether a signal has been delivered to it
+ * each time that the wait returns. Threads in user mode can not register for that, so signals
+ * that are generated for them are only delivered when the wait returns.
+ */
+struct posix_sig_wait {
+	k_timepoint_t end;
+#ifdef CONFIG_SIGNAL
+	unsigned long delivered;
+	struct k_sig_set restore;
+	bool restore_mask;
+	/* file descriptor that is ready when the wait should be woken, or -1 */
+	int wake_fd;
+	struct posix_sig_waiter waiter;
+#endif
+};
+
+/*
+ * Install @p sigmask, if it is not NULL, for a wait that times out after @p timeout, or never if
+ * @p timeout is NULL.
+ *
+ * Returns 0 on success, or -1 with errno set. In particular, if a signal that was pending is
+ * delivered as soon as @p sigmask unblocks it, the original mask is restored and -1 is returned
+ * with errno set to EINTR.
+ */
+int posix_sig_wait_begin(struct posix_sig_wait *w, const sigset_t *sigmask,
+			 const struct timespec *timeout);
+
+/*
+ * File descriptor to wait for readability of, along with those of the caller, or -1 if there is
+ * none. When it is ready, the wait was woken by a signal and it is not counted as ready itself.
+ */
+int posix_sig_wait_fd(const struct posix_sig_wait *w);
+
+/* Time left to wait in ms, or -1 to wait forever */
+int posix_sig_wait_timeout_ms(const struct posix_sig_wait *w);
+
+/*
+ * Check whether the wait is over, after it has returned @p ret, not counting the file descriptor
+ * of posix_sig_wait_fd(). @p woken tells whether that file descriptor was ready. If a signal has
+ * been delivered and no file descriptor is ready, errno is set to EINTR and @p ret to -1.
+ */
+bool posix_sig_wait_done(struct posix_sig_wait *w, bool woken, int *ret);
+
+/* Restore the signal mask that was in force before posix_sig_wait_begin() */
+void posix_sig_wait_end(struct posix_sig_wait *w);
+
+#endif /* ZEPHYR_LIB_POSIX_OPTIONS_DEVICE_IO_SIG_WAIT_H_ */
@@ -9,9 +9,23 @@
 
 #include <zephyr/sys/zvfs.h>
 
+#include "fadvise_priv.h"
+#include "sync_io_priv.h"
+
 ssize_t write(int fd, const void *buf, size_t sz)
 {
-	return zvfs_write(fd, buf, sz);
+	ssize_t ret = zvfs_write(fd, buf, sz);
+
+	if (ret > 0) {
+		/* the file position is not known here, so drop everything cached for fd */
+		posix_fadv_invalidate(fd, 0, 0);
+
+		if (posix_sync_write(fd) < 0) {
+			return -1;
+		}
+	}
+
+	return ret;
 }
 #ifdef CONFIG_POSIX_DEVICE_IO_ALIAS_WRITE
 FUNC_ALIAS(write, _write, ssize_t);
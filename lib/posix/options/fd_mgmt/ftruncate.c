@@ -7,9 +7,18 @@
 
 #include <zephyr/sys/zvfs.h>
 
+#include "fadvise_priv.h"
+#include "posix_internal.h"
+
 int ftruncate(int fd, off_t length)
 {
-	return zvfs_ftruncate(fd, length);
+	int ret = posix_fd_resize(fd, length);
+
+	if (ret == 0) {
+		posix_fadv_invalidate(fd, length, 0);
+	}
+
+	return ret;
 }
 #ifdef CONFIG_POSIX_FD_MGMT_ALIAS_FTRUNCATE
 FUNC_ALIAS(ftruncate, _ftruncate, int);
@@ -17,6 +17,8 @@
 #include <fcntl.h>
 #include <zephyr/fs/fs.h>
 
+#include "fs_path_priv.h"
+
 BUILD_ASSERT(PATH_MAX >= MAX_FILE_NAME, "PATH_MAX is less than MAX_FILE_NAME");
 
 static struct fs_dirent fdirent;
@@ -30,8 +32,14 @@ static struct dirent pdirent;
 DIR *opendir(const char *dirname)
 {
 	int rc;
+	char pathbuf[PATH_MAX];
 	struct zvfs_fs_desc *ptr;
 
+	dirname = posix_path_at(AT_FDCWD, dirname, pathbuf);
+	if (dirname == NULL) {
+		return NULL;
+	}
+
 	ptr = zvfs_fs_desc_alloc(true);
 	if (ptr == NULL) {
 		errno = EMFILE;
@@ -120,6 +128,14 @@ struct dirent *readdir(DIR *dirp)
 int rename(const char *old, const char *new)
 {
 	int rc;
+	char oldbuf[PATH_MAX];
+	char newbuf[PATH_MAX];
+
+	old = posix_path_at(AT_FDCWD, old, oldbuf);
+	new = posix_path_at(AT_FDCWD, new, newbuf);
+	if ((old == NULL) || (new == NULL)) {
+		return -1;
+	}
 
 	rc = fs_rename(old, new);
 	if (rc < 0) {
@@ -138,6 +154,12 @@ int rename(const char *old, const char *new)
 int unlink(const char *path)
 {
 	int rc;
+	char pathbuf[PATH_MAX];
+
+	path = posix_path_at(AT_FDCWD, path, pathbuf);
+	if (path == NULL) {
+		return -1;
+	}
 
 	rc = fs_unlink(path);
 	if (rc < 0) {
@@ -155,6 +177,7 @@ int unlink(const char *path)
 int stat(const char *path, struct stat *buf)
 {
 	int rc;
+	char pathbuf[PATH_MAX];
 	struct fs_statvfs stat_vfs;
 	struct fs_dirent stat_file;
 
@@ -163,6 +186,11 @@ int stat(const char *path, struct stat *buf)
 		return -1;
 	}
 
+	path = posix_path_at(AT_FDCWD, path, pathbuf);
+	if (path == NULL) {
+		return -1;
+	}
+
 	rc = fs_statvfs(path, &stat_vfs);
 	if (rc < 0) {
 		errno = -rc;
@@ -213,9 +241,15 @@ int stat(const char *path, struct stat *buf)
 int mkdir(const char *path, mode_t mode)
 {
 	int rc;
+	char pathbuf[PATH_MAX];
 
 	ARG_UNUSED(mode);
 
+	path = posix_path_at(AT_FDCWD, path, pathbuf);
+	if (path == NULL) {
+		return -1;
+	}
+
 	rc = fs_mkdir(path);
 	if (rc < 0) {
 		errno = -rc;
@@ -258,3 +292,35 @@ int rmdir(const char *path)
 {
 	return unlink(path);
 }
+
+/**
+ * @brief Determine accessibility of a file.
+ *
+ * Zephyr file systems do not record permissions, so any file that exists is accessible.
+ *
+ * See IEEE 1003.1
+ */
+int access(const char *path, int amode)
+{
+	int rc;
+	char pathbuf[PATH_MAX];
+	struct fs_dirent entry;
+
+	if ((amode & ~(R_OK | W_OK | X_OK)) != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	path = posix_path_at(AT_FDCWD, path, pathbuf);
+	if (path == NULL) {
+		return -1;
+	}
+
+	rc = fs_stat(path, &entry);
+	if (rc < 0) {
+		errno = -rc;
+		return -1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,391 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "fadvise_priv.h"
+#include "fs_path_priv.h"
+#include "sync_io_priv.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/internal/fdtable_priv.h>
+#include <zephyr/sys/zvfs_fs.h>
+
+/*
+ * A directory file descriptor caches the canonical absolute path of the directory, so that
+ * *at() calls only need to append the (usually short) relative path rather than having the
+ * caller rebuild the full path for every operation. The current working directory is kept in
+ * the same form.
+ */
+struct posix_dir {
+	char path[PATH_MAX];
+	uint16_t len;
+	bool used;
+};
+
+static const struct fd_op_vtable posix_dir_vtable;
+
+static struct posix_dir posix_dirs[CONFIG_POSIX_OPEN_DIRS_MAX];
+static char cwd[PATH_MAX] = "/";
+static uint16_t cwd_len = 1;
+static K_MUTEX_DEFINE(path_lock);
+
+/* absolute, without empty, "." or ".." components, and without a trailing '/' */
+static bool path_is_canonical(const char *path)
+{
+	const char *p;
+
+	if (path[0] != '/') {
+		return false;
+	}
+
+	for (p = path; *p != '\0'; ++p) {
+		if (*p != '/') {
+			continue;
+		}
+
+		if ((p[1] == '/') || ((p[1] == '\0') && (p != path))) {
+			return false;
+		}
+
+		if ((p[1] == '.') &&
+		    ((p[2] == '/') || (p[2] == '\0') ||
+		     ((p[2] == '.') && ((p[3] == '/') || (p[3] == '\0'))))) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* append the components of @p path to the canonical path @p base of length @p len */
+static int path_join(char *buf, const char *base, size_t len, const char *path)
+{
+	memcpy(buf, base, len);
+	if (len == 1) {
+		/* root */
+		len = 0;
+	}
+
+	while (*path != '\0') {
+		size_t n;
+
+		while (*path == '/') {
+			++path;
+		}
+
+		for (n = 0; (path[n] != '\0') && (path[n] != '/'); ++n) {
+		}
+
+		if ((n == 0) || ((n == 1) && (path[0] == '.'))) {
+			/* nothing to do */
+		} else if ((n == 2) && (path[0] == '.') && (path[1] == '.')) {
+			while ((len > 0) && (buf[len - 1] != '/')) {
+				--len;
+			}
+			len = (len > 0) ? (len - 1) : 0;
+		} else {
+			if (len + 1 + n >= PATH_MAX) {
+				errno = ENAMETOOLONG;
+				return -1;
+			}
+
+			buf[len++] = '/';
+			memcpy(&buf[len], path, n);
+			len += n;
+		}
+
+		path += n;
+	}
+
+	if (len == 0) {
+		buf[len++] = '/';
+	}
+
+	buf[len] = '\0';
+
+	return len;
+}
+
+static struct posix_dir *to_posix_dir(int fd)
+{
+	struct fd_entry *entry = zvfs_fd_entry_get(fd);
+
+	if (entry == NULL) {
+		return NULL;
+	}
+
+	if (entry->vtable != &posix_dir_vtable) {
+		errno = ENOTDIR;
+		return NULL;
+	}
+
+	return entry->obj;
+}
+
+const char *posix_path_at(int fd, const char *path, char *buf)
+{
+	int ret;
+	struct posix_dir *dir;
+
+	if (path == NULL) {
+		errno = EFAULT;
+		return NULL;
+	}
+
+	if (path[0] == '\0') {
+		errno = ENOENT;
+		return NULL;
+	}
+
+	if (path[0] == '/') {
+		if (path_is_canonical(path)) {
+			return path;
+		}
+
+		ret = path_join(buf, "/", 1, path);
+	} else if (fd == AT_FDCWD) {
+		(void)k_mutex_lock(&path_lock, K_FOREVER);
+		ret = path_join(buf, cwd, cwd_len, path);
+		k_mutex_unlock(&path_lock);
+	} else {
+		dir = to_posix_dir(fd);
+		if (dir == NULL) {
+			return NULL;
+		}
+
+		ret = path_join(buf, dir->path, dir->len, path);
+	}
+
+	return (ret < 0) ? NULL : buf;
+}
+
+/* check that the absolute path @p path names a directory */
+static int path_check_dir(const char *path)
+{
+	int rc;
+	struct fs_dir_t zdir;
+	struct fs_dirent entry;
+
+	fs_dir_t_init(&zdir);
+	rc = fs_opendir(&zdir, path);
+	if (rc == 0) {
+		(void)fs_closedir(&zdir);
+		return 0;
+	}
+
+	if ((fs_stat(path, &entry) == 0) && (entry.type != FS_DIR_ENTRY_DIR)) {
+		rc = -ENOTDIR;
+	}
+
+	errno = -rc;
+	return -1;
+}
+
+static ssize_t posix_dir_read(void *obj, void *buf, size_t sz, size_t offset)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(sz);
+	ARG_UNUSED(offset);
+
+	errno = EISDIR;
+	return -1;
+}
+
+static ssize_t posix_dir_write(void *obj, const void *buf, size_t sz, size_t offset)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(sz);
+	ARG_UNUSED(offset);
+
+	errno = EISDIR;
+	return -1;
+}
+
+static int posix_dir_close(void *obj)
+{
+	struct posix_dir *dir = obj;
+
+	(void)k_mutex_lock(&path_lock, K_FOREVER);
+	dir->used = false;
+	k_mutex_unlock(&path_lock);
+
+	return 0;
+}
+
+static int posix_dir_ioctl(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(obj);
+
+	switch (request) {
+	case ZFD_IOCTL_STAT: {
+		struct zvfs_stat *st = va_arg(args, struct zvfs_stat *);
+
+		memset(st, 0, sizeof(*st));
+		st->mode = ZVFS_MODE_IFDIR;
+	} break;
+	default:
+		errno = ENOTSUP;
+		return -1;
+	}
+
+	return 0;
+}
+
+static const struct fd_op_vtable posix_dir_vtable = {
+	.read_offs = posix_dir_read,
+	.write_offs = posix_dir_write,
+	.close = posix_dir_close,
+	.ioctl = posix_dir_ioctl,
+};
+
+static int posix_dir_open(const char *path, int flags)
+{
+	int fd;
+	size_t len = strlen(path);
+	struct posix_dir *dir = NULL;
+
+	if (((flags & O_ACCMODE) != O_RDONLY) || ((flags & O_CREAT) != 0)) {
+		errno = EISDIR;
+		return -1;
+	}
+
+	if (path_check_dir(path) < 0) {
+		return -1;
+	}
+
+	fd = zvfs_reserve_fd();
+	if (fd < 0) {
+		errno = EMFILE;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&path_lock, K_FOREVER);
+	ARRAY_FOR_EACH_PTR(posix_dirs, it) {
+		if (!it->used) {
+			dir = it;
+			dir->used = true;
+			break;
+		}
+	}
+	k_mutex_unlock(&path_lock);
+
+	if (dir == NULL) {
+		zvfs_free_fd(fd);
+		errno = ENFILE;
+		return -1;
+	}
+
+	memcpy(dir->path, path, len + 1);
+	dir->len = len;
+
+	zvfs_finalize_typed_fd(fd, dir, &posix_dir_vtable, ZVFS_MODE_IFDIR);
+
+	return fd;
+}
+
+int posix_open_at(int fd, const char *path, int flags, int mode)
+{
+	int ret;
+	char buf[PATH_MAX];
+
+	path = posix_path_at(fd, path, buf);
+	if (path == NULL) {
+		return -1;
+	}
+
+	if ((flags & (O_DIRECTORY | O_SEARCH)) != 0) {
+		return posix_dir_open(path, flags & ~O_SEARCH);
+	}
+
+	ret = zvfs_open(path, flags, mode);
+	if (ret >= 0) {
+		posix_sync_open(ret, flags);
+		posix_fadv_open(ret, path);
+	}
+
+	return ret;
+}
+
+/**
+ * @brief Change the current working directory.
+ *
+ * See IEEE 1003.1
+ */
+int chdir(const char *path)
+{
+	int len;
+	char buf[PATH_MAX];
+	const char *abs = posix_path_at(AT_FDCWD, path, buf);
+
+	if ((abs == NULL) || (path_check_dir(abs) < 0)) {
+		return -1;
+	}
+
+	len = strlen(abs);
+
+	(void)k_mutex_lock(&path_lock, K_FOREVER);
+	memcpy(cwd, abs, len + 1);
+	cwd_len = len;
+	k_mutex_unlock(&path_lock);
+
+	return 0;
+}
+
+/**
+ * @brief Change the current working directory to that of a directory file descriptor.
+ *
+ * See IEEE 1003.1
+ */
+int fchdir(int fildes)
+{
+	struct posix_dir *dir = to_posix_dir(fildes);
+
+	if (dir == NULL) {
+		return -1;
+	}
+
+	(void)k_mutex_lock(&path_lock, K_FOREVER);
+	memcpy(cwd, dir->path, dir->len + 1);
+	cwd_len = dir->len;
+	k_mutex_unlock(&path_lock);
+
+	return 0;
+}
+
+/**
+ * @brief Get the pathname of the current working directory.
+ *
+ * See IEEE 1003.1
+ */
+char *getcwd(char *buf, size_t size)
+{
+	char *ret = buf;
+
+	if ((buf == NULL) || (size == 0)) {
+		errno = EINVAL;
+		return NULL;
+	}
+
+	(void)k_mutex_lock(&path_lock, K_FOREVER);
+	if (cwd_len + 1 > size) {
+		errno = ERANGE;
+		ret = NULL;
+	} else {
+		memcpy(buf, cwd, cwd_len + 1);
+	}
+	k_mutex_unlock(&path_lock);
+
+	return ret;
+}
@@ -0,0 +1,274 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "fs_path_priv.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/toolchain.h>
+
+/* resolve @p path relative to @p fd and look it up */
+static const char *lookup_at(int fd, const char *path, char *buf, struct fs_dirent *entry)
+{
+	int rc;
+
+	path = posix_path_at(fd, path, buf);
+	if (path == NULL) {
+		return NULL;
+	}
+
+	rc = fs_stat(path, entry);
+	if (rc < 0) {
+		errno = -rc;
+		return NULL;
+	}
+
+	return path;
+}
+
+/**
+ * @brief Open a file relative to a directory file descriptor.
+ *
+ * See IEEE 1003.1
+ */
+int openat(int fd, const char *path, int oflag, ...)
+{
+	int mode = 0;
+	va_list args;
+
+	if ((oflag & O_CREAT) != 0) {
+		va_start(args, oflag);
+		mode = va_arg(args, int);
+		va_end(args);
+	}
+
+	return posix_open_at(fd, path, oflag, mode);
+}
+
+/**
+ * @brief Get file status relative to a directory file descriptor.
+ *
+ * See IEEE 1003.1
+ */
+int fstatat(int fd, const char *ZRESTRICT path, struct stat *ZRESTRICT buf, int flag)
+{
+	char pathbuf[PATH_MAX];
+
+	if ((flag & ~AT_SYMLINK_NOFOLLOW) != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	path = posix_path_at(fd, path, pathbuf);
+	if (path == NULL) {
+		return -1;
+	}
+
+	return stat(path, buf);
+}
+
+/**
+ * @brief Make a directory relative to a directory file descriptor.
+ *
+ * See IEEE 1003.1
+ */
+int mkdirat(int fd, const char *path, mode_t mode)
+{
+	char pathbuf[PATH_MAX];
+
+	path = posix_path_at(fd, path, pathbuf);
+	if (path == NULL) {
+		return -1;
+	}
+
+	return mkdir(path, mode);
+}
+
+/**
+ * @brief Rename a file relative to directory file descriptors.
+ *
+ * See IEEE 1003.1
+ */
+int renameat(int oldfd, const char *old, int newfd, const char *new)
+{
+	char oldbuf[PATH_MAX];
+	char newbuf[PATH_MAX];
+
+	old = posix_path_at(oldfd, old, oldbuf);
+	new = posix_path_at(newfd, new, newbuf);
+	if ((old == NULL) || (new == NULL)) {
+		return -1;
+	}
+
+	return rename(old, new);
+}
+
+/**
+ * @brief Remove a directory entry relative to a directory file descriptor.
+ *
+ * See IEEE 1003.1
+ */
+int unlinkat(int fd, const char *path, int flag)
+{
+	char pathbuf[PATH_MAX];
+	struct fs_dirent entry;
+
+	if ((flag & ~AT_REMOVEDIR) != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	path = lookup_at(fd, path, pathbuf, &entry);
+	if (path == NULL) {
+		return -1;
+	}
+
+	if ((flag & AT_REMOVEDIR) != 0) {
+		if (entry.type != FS_DIR_ENTRY_DIR) {
+			errno = ENOTDIR;
+			return -1;
+		}
+
+		return rmdir(path);
+	}
+
+	if (entry.type == FS_DIR_ENTRY_DIR) {
+		errno = EPERM;
+		return -1;
+	}
+
+	return unlink(path);
+}
+
+/**
+ * @brief Determine accessibility of a file relative to a directory file descriptor.
+ *
+ * See IEEE 1003.1
+ */
+int faccessat(int fd, const char *path, int amode, int flag)
+{
+	char pathbuf[PATH_MAX];
+
+	if ((flag & ~AT_EACCESS) != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	path = posix_path_at(fd, path, pathbuf);
+	if (path == NULL) {
+		return -1;
+	}
+
+	return access(path, amode);
+}
+
+/**
+ * @brief Change the owner and group of a file relative to a directory file descriptor.
+ *
+ * Zephyr file systems do not record ownership, so only a request that changes nothing succeeds.
+ *
+ * See IEEE 1003.1
+ */
+int fchownat(int fd, const char *path, uid_t owner, gid_t group, int flag)
+{
+	char pathbuf[PATH_MAX];
+	struct fs_dirent entry;
+
+	if ((flag & ~AT_SYMLINK_NOFOLLOW) != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (lookup_at(fd, path, pathbuf, &entry) == NULL) {
+		return -1;
+	}
+
+	if ((owner != (uid_t)-1) || (group != (gid_t)-1)) {
+		errno = EPERM;
+		return -1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Create a link to a file relative to directory file descriptors.
+ *
+ * Zephyr file systems do not support hard links.
+ *
+ * See IEEE 1003.1
+ */
+int linkat(int fd1, const char *path1, int fd2, const char *path2, int flag)
+{
+	char pathbuf[PATH_MAX];
+	struct fs_dirent entry;
+
+	if ((flag & ~AT_SYMLINK_FOLLOW) != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if ((lookup_at(fd1, path1, pathbuf, &entry) == NULL) ||
+	    (posix_path_at(fd2, path2, pathbuf) == NULL)) {
+		return -1;
+	}
+
+	errno = EPERM;
+	return -1;
+}
+
+/**
+ * @brief Create a symbolic link relative to a directory file descriptor.
+ *
+ * Zephyr file systems do not support symbolic links.
+ *
+ * See IEEE 1003.1
+ */
+int symlinkat(const char *path1, int fd, const char *path2)
+{
+	char pathbuf[PATH_MAX];
+
+	if (path1 == NULL) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	if (posix_path_at(fd, path2, pathbuf) == NULL) {
+		return -1;
+	}
+
+	errno = EPERM;
+	return -1;
+}
+
+/**
+ * @brief Read the contents of a symbolic link relative to a directory file descriptor.
+ *
+ * Zephyr file systems do not support symbolic links, so no file is ever a symbolic link.
+ *
+ * See IEEE 1003.1
+ */
+ssize_t readlinkat(int fd, const char *restrict path, char *restrict buf, size_t bufsize)
+{
+	char pathbuf[PATH_MAX];
+	struct fs_dirent entry;
+
+	ARG_UNUSED(buf);
+	ARG_UNUSED(bufsize);
+
+	if (lookup_at(fd, path, pathbuf, &entry) == NULL) {
+		return -1;
+	}
+
+	errno = EINVAL;
+	return -1;
+}
@@ -0,0 +1,442 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "fs_path_priv.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <glob.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/sys/util.h>
+
+#ifndef GLOB_BRACE
+#define GLOB_BRACE 0x0400
+#endif
+
+#ifndef GLOB_TILDE
+#define GLOB_TILDE 0x1000
+#endif
+
+#define EOS '\0'
+
+struct glob_ctx {
+	glob_t *pglob;
+	int (*errfunc)(const char *epath, int eerrno);
+	int flags;
+	/* number of pathnames gl_pathv has room for, including the terminating NULL */
+	size_t cap;
+	/* number of pathnames found by this call */
+	size_t found;
+	struct fs_dirent entry;
+	char path[PATH_MAX];
+	char abspath[PATH_MAX];
+};
+
+static int glob_add(struct glob_ctx *ctx, const char *path, size_t len, bool mark)
+{
+	char *str;
+	char **pathv;
+	glob_t *const g = ctx->pglob;
+	const size_t n = g->gl_offs + g->gl_pathc;
+
+	if (n + 2 > ctx->cap) {
+		size_t cap = MAX(n + 2, 2 * ctx->cap);
+
+		pathv = realloc(g->gl_pathv, cap * sizeof(*pathv));
+		if (pathv == NULL) {
+			return GLOB_NOSPACE;
+		}
+
+		if (g->gl_pathv == NULL) {
+			for (size_t i = 0; i < g->gl_offs; ++i) {
+				pathv[i] = NULL;
+			}
+		}
+
+		g->gl_pathv = pathv;
+		g->gl_pathv[n] = NULL;
+		ctx->cap = cap;
+	}
+
+	str = malloc(len + (mark ? 2 : 1));
+	if (str == NULL) {
+		return GLOB_NOSPACE;
+	}
+
+	memcpy(str, path, len);
+	if (mark) {
+		str[len++] = '/';
+	}
+	str[len] = EOS;
+
+	g->gl_pathv[n] = str;
+	g->gl_pathv[n + 1] = NULL;
+	++g->gl_pathc;
+	++ctx->found;
+
+	return 0;
+}
+
+static int glob_error(struct glob_ctx *ctx, const char *path, int err)
+{
+	if (((ctx->errfunc != NULL) && (ctx->errfunc(path, err) != 0)) ||
+	    ((ctx->flags & GLOB_ERR) != 0)) {
+		return GLOB_ABORTED;
+	}
+
+	return 0;
+}
+
+static bool glob_is_magic(const char *pattern, size_t len, int flags)
+{
+	for (size_t i = 0; i < len; ++i) {
+		switch (pattern[i]) {
+		case '\\':
+			if ((flags & GLOB_NOESCAPE) == 0) {
+				++i;
+			}
+			break;
+		case '*':
+		case '?':
+		case '[':
+			return true;
+		default:
+			break;
+		}
+	}
+
+	return false;
+}
+
+/* The pattern named an existing path without matching a directory, so check that it exists */
+static int glob_found(struct glob_ctx *ctx, size_t len)
+{
+	const char *abspath;
+
+	if (len == 0) {
+		return 0;
+	}
+
+	ctx->path[len] = EOS;
+	abspath = posix_path_at(AT_FDCWD, ctx->path, ctx->abspath);
+	if ((abspath == NULL) || (fs_stat(abspath, &ctx->entry) < 0)) {
+		return 0;
+	}
+
+	return glob_add(ctx, ctx->path, len,
+			((ctx->flags & GLOB_MARK) != 0) && (ctx->entry.type == FS_DIR_ENTRY_DIR) &&
+				(ctx->path[len - 1] != '/'));
+}
+
+static int glob_walk(struct glob_ctx *ctx, size_t len, const char *pattern);
+
+/* Match the path component [pattern, next) against the entries of the directory ctx->path */
+static int glob_dir(struct glob_ctx *ctx, size_t len, const char *pattern, const char *next)
+{
+	int rc;
+	int ret = 0;
+	char *comp;
+	size_t dlen = len;
+	size_t nlen;
+	bool isdir;
+	struct fs_dir_t dir;
+	const char *abspath;
+	const char *dirpath = (len == 0) ? "." : ctx->path;
+	const int fnflags = FNM_PERIOD | (((ctx->flags & GLOB_NOESCAPE) != 0) ? FNM_NOESCAPE : 0);
+
+	comp = malloc(next - pattern + 1);
+	if (comp == NULL) {
+		return GLOB_NOSPACE;
+	}
+
+	memcpy(comp, pattern, next - pattern);
+	comp[next - pattern] = EOS;
+
+	/* open "a/b" rather than "a/b/" */
+	while ((dlen > 1) && (ctx->path[dlen - 1] == '/')) {
+		--dlen;
+	}
+	ctx->path[dlen] = EOS;
+
+	abspath = posix_path_at(AT_FDCWD, dirpath, ctx->abspath);
+	if (abspath == NULL) {
+		ret = glob_error(ctx, dirpath, errno);
+		goto out;
+	}
+
+	fs_dir_t_init(&dir);
+	rc = fs_opendir(&dir, abspath);
+	if (rc < 0) {
+		ret = glob_error(ctx, dirpath, -rc);
+		goto out;
+	}
+
+	if (dlen < len) {
+		ctx->path[dlen] = '/';
+	}
+
+	while (ret == 0) {
+		rc = fs_readdir(&dir, &ctx->entry);
+		if (rc < 0) {
+			ctx->path[dlen] = EOS;
+			ret = glob_error(ctx, dirpath, -rc);
+			break;
+		}
+
+		if (ctx->entry.name[0] == EOS) {
+			/* end of directory */
+			break;
+		}
+
+		if (fnmatch(comp, ctx->entry.name, fnflags) != 0) {
+			continue;
+		}
+
+		nlen = strlen(ctx->entry.name);
+		if (len + nlen >= sizeof(ctx->path)) {
+			continue;
+		}
+
+		memcpy(&ctx->path[len], ctx->entry.name, nlen);
+		isdir = (ctx->entry.type == FS_DIR_ENTRY_DIR);
+
+		if (*next == EOS) {
+			ret = glob_add(ctx, ctx->path, len + nlen,
+				       isdir && ((ctx->flags & GLOB_MARK) != 0));
+		} else if (isdir) {
+			ret = glob_walk(ctx, len + nlen, next);
+		}
+	}
+
+	(void)fs_closedir(&dir);
+
+out:
+	free(comp);
+
+	return ret;
+}
+
+/* Match pattern, the path components left, below the first len characters of ctx->path */
+static int glob_walk(struct glob_ctx *ctx, size_t len, const char *pattern)
+{
+	const char *next;
+
+	for (; *pattern == '/'; ++pattern) {
+		if (len + 1 >= sizeof(ctx->path)) {
+			return 0;
+		}
+		ctx->path[len++] = '/';
+	}
+
+	if (*pattern == EOS) {
+		return glob_found(ctx, len);
+	}
+
+	next = strchr(pattern, '/');
+	if (next == NULL) {
+		next = pattern + strlen(pattern);
+	}
+
+	if (glob_is_magic(pattern, next - pattern, ctx->flags)) {
+		return glob_dir(ctx, len, pattern, next);
+	}
+
+	/* a literal component is not looked up in its directory, only the complete path is */
+	for (; pattern < next; ++pattern) {
+		if ((*pattern == '\\') && ((ctx->flags & GLOB_NOESCAPE) == 0) &&
+		    (pattern + 1 < next)) {
+			++pattern;
+		}
+
+		if (len + 1 >= sizeof(ctx->path)) {
+			return 0;
+		}
+		ctx->path[len++] = *pattern;
+	}
+
+	return glob_walk(ctx, len, next);
+}
+
+static int glob_cmp(const void *a, const void *b)
+{
+	return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+static int glob_pattern(struct glob_ctx *ctx, const char *pattern)
+{
+	int ret;
+	glob_t *const g = ctx->pglob;
+	const size_t first = g->gl_offs + g->gl_pathc;
+
+	ret = glob_walk(ctx, 0, pattern);
+
+	if (((ctx->flags & GLOB_NOSORT) == 0) && (g->gl_offs + g->gl_pathc > first)) {
+		qsort(&g->gl_pathv[first], g->gl_offs + g->gl_pathc - first, sizeof(char *),
+		      glob_cmp);
+	}
+
+	return ret;
+}
+
+/* Find the '}' closing the '{' at brace, or NULL */
+static const char *glob_brace_end(const char *brace, int flags)
+{
+	int depth = 0;
+
+	for (const char *p = brace; *p != EOS; ++p) {
+		if ((*p == '\\') && ((flags & GLOB_NOESCAPE) == 0) && (p[1] != EOS)) {
+			++p;
+		} else if (*p == '{') {
+			++depth;
+		} else if ((*p == '}') && (--depth == 0)) {
+			return p;
+		}
+	}
+
+	return NULL;
+}
+
+/* Expand the first "{a,b,...}" of pattern, and glob each alternative in order */
+static int glob_brace(struct glob_ctx *ctx, const char *pattern)
+{
+	int ret = 0;
+	int depth;
+	char *buf;
+	size_t plen;
+	const char *alt;
+	const char *brace = NULL;
+	const char *end = NULL;
+
+	for (const char *p = pattern; *p != EOS; ++p) {
+		if ((*p == '\\') && ((ctx->flags & GLOB_NOESCAPE) == 0) && (p[1] != EOS)) {
+			++p;
+		} else if ((*p == '{') && (p[1] != '}')) {
+			/* "{}" is not expanded */
+			end = glob_brace_end(p, ctx->flags);
+			if (end != NULL) {
+				brace = p;
+				break;
+			}
+		}
+	}
+
+	if (brace == NULL) {
+		return glob_pattern(ctx, pattern);
+	}
+
+	plen = strlen(pattern);
+	buf = malloc(plen + 1);
+	if (buf == NULL) {
+		return GLOB_NOSPACE;
+	}
+
+	memcpy(buf, pattern, brace - pattern);
+
+	depth = 0;
+	alt = brace + 1;
+	for (const char *p = alt; (ret == 0) && (p <= end); ++p) {
+		if ((*p == '\\') && ((ctx->flags & GLOB_NOESCAPE) == 0)) {
+			++p;
+		} else if (*p == '{') {
+			++depth;
+		} else if ((*p == '}') && (depth > 0)) {
+			--depth;
+		} else if (((*p == ',') && (depth == 0)) || (p == end)) {
+			char *const s = buf + (brace - pattern);
+
+			memcpy(s, alt, p - alt);
+			strcpy(s + (p - alt), end + 1);
+			ret = glob_brace(ctx, buf);
+			alt = p + 1;
+		}
+	}
+
+	free(buf);
+
+	return ret;
+}
+
+int glob(const char *ZRESTRICT pattern, int flags, int (*errfunc)(const char *epath, int eerrno),
+	 glob_t *ZRESTRICT pglob)
+{
+	int ret;
+	char *home_pattern = NULL;
+	struct glob_ctx *ctx;
+
+	if ((flags & GLOB_APPEND) == 0) {
+		pglob->gl_pathc = 0;
+		pglob->gl_pathv = NULL;
+		if ((flags & GLOB_DOOFFS) == 0) {
+			pglob->gl_offs = 0;
+		}
+	}
+
+	ctx = malloc(sizeof(*ctx));
+	if (ctx == NULL) {
+		return GLOB_NOSPACE;
+	}
+
+	*ctx = (struct glob_ctx){
+		.pglob = pglob,
+		.errfunc = errfunc,
+		.flags = flags,
+		.cap = (pglob->gl_pathv == NULL) ? 0 : (pglob->gl_offs + pglob->gl_pathc + 1),
+	};
+
+	if (((flags & GLOB_TILDE) != 0) && (pattern[0] == '~') &&
+	    ((pattern[1] == '/') || (pattern[1] == EOS))) {
+		const char *home = getenv("HOME");
+
+		if (home != NULL) {
+			home_pattern = malloc(strlen(home) + strlen(pattern));
+			if (home_pattern == NULL) {
+				free(ctx);
+				return GLOB_NOSPACE;
+			}
+
+			strcpy(home_pattern, home);
+			strcat(home_pattern, &pattern[1]);
+		}
+	}
+
+	if ((flags & GLOB_BRACE) != 0) {
+		ret = glob_brace(ctx, (home_pattern != NULL) ? home_pattern : pattern);
+	} else {
+		ret = glob_pattern(ctx, (home_pattern != NULL) ? home_pattern : pattern);
+	}
+
+	if ((ret == 0) && (ctx->found == 0)) {
+		if ((flags & GLOB_NOCHECK) != 0) {
+			ret = glob_add(ctx, pattern, strlen(pattern), false);
+		} else {
+			ret = GLOB_NOMATCH;
+		}
+	}
+
+	free(home_pattern);
+	free(ctx);
+
+	return ret;
+}
+
+void globfree(glob_t *pglob)
+{
+	if (pglob->gl_pathv != NULL) {
+		for (size_t i = 0; i < pglob->gl_pathc; ++i) {
+			free(pglob->gl_pathv[pglob->gl_offs + i]);
+		}
+
+		free(pglob->gl_pathv);
+	}
+
+	pglob->gl_pathc = 0;
+	pglob->gl_pathv = NULL;
+}
@@ -7,9 +7,11 @@
 #include <unistd.h>
 #include <zephyr/sys/zvfs.h>
 
+#include "sync_io_priv.h"
+
 int fsync(int fd)
 {
-	return zvfs_fsync(fd);
+	return posix_sync_fd(fd);
 }
 #ifdef CONFIG_POSIX_FILE_SYSTEM_ALIAS_FSYNC
 FUNC_ALIAS(fsync, _fsync, int);
@@ -6,6 +6,7 @@
  */
 
 #include "posix_clock.h"
+#include "trace_priv.h"
 
 #include <errno.h>
 #include <fcntl.h>
@@ -45,9 +46,9 @@ sys_slist_t mq_list = SYS_SLIST_STATIC_INIT(&mq_list);
 
 static mqueue_object *find_in_list(const char *name);
 static int32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_len,
-			  k_timeout_t timeout);
+			  const struct timespec *abstime);
 static int32_t receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
-			   k_timeout_t timeout);
+			   const struct timespec *abstime);
 static void remove_notification(mqueue_object *msg_queue);
 static void remove_mq(mqueue_object *msg_queue);
 static void *mq_notify_thread(void *arg);
@@ -178,6 +179,7 @@ mqd_t mq_open(const char *name, int oflags, ...)
 
 	msg_queue_desc->mqueue = msg_queue;
 	msg_queue_desc->flags = (oflags & O_NONBLOCK) != 0 ? O_NONBLOCK : 0;
+	sys_port_trace_posix_call(MQ_OPEN, &msg_queue->queue, 0);
 	return (mqd_t)msg_queue_desc;
 
 free_mq_buffer:
@@ -187,6 +189,7 @@ free_mq_name:
 free_mq_object:
 	k_free(mq_desc_ptr);
 free_mq_desc:
+	sys_port_trace_posix_call(MQ_OPEN, NULL, ENOSPC);
 	errno = ENOSPC;
 	return (mqd_t)mqd;
 }
@@ -206,6 +209,7 @@ int mq_close(mqd_t mqdes)
 	}
 
 	atomic_dec(&mqd->mqueue->ref_count);
+	sys_port_trace_posix_call(MQ_CLOSE, &mqd->mqueue->queue, 0);
 
 	/* remove mq if marked for unlink */
 	if (mqd->mqueue->name == NULL) {
@@ -253,7 +257,7 @@ int mq_send(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
 {
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
 
-	return send_message(mqd, msg_ptr, msg_len, K_FOREVER);
+	return send_message(mqd, msg_ptr, msg_len, NULL);
 }
 
 /**
@@ -273,8 +277,7 @@ int mq_timedsend(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
 		return -1;
 	}
 
-	return send_message(mqd, msg_ptr, msg_len,
-			    K_MSEC(timespec_to_timeoutms(CLOCK_REALTIME, abstime)));
+	return send_message(mqd, msg_ptr, msg_len, abstime);
 }
 
 /**
@@ -289,7 +292,7 @@ int mq_receive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 {
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
 
-	return receive_message(mqd, msg_ptr, msg_len, K_FOREVER);
+	return receive_message(mqd, msg_ptr, msg_len, NULL);
 }
 
 /**
@@ -309,8 +312,7 @@ int mq_timedreceive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 		return -1;
 	}
 
-	return receive_message(mqd, msg_ptr, msg_len,
-			       K_MSEC(timespec_to_timeoutms(CLOCK_REALTIME, abstime)));
+	return receive_message(mqd, msg_ptr, msg_len, abstime);
 }
 
 /**
@@ -456,20 +458,47 @@ static mqueue_object *find_in_list(const char *name)
 	return NULL;
 }
 
+/* Get the next timeout of a wait until abstime (forever if NULL), see timespec_to_clock_timeout() */
+static int message_timeout(mqueue_desc *mqd, const struct timespec *abstime, k_timeout_t *timeout)
+{
+	if ((mqd->flags & O_NONBLOCK) != 0U) {
+		*timeout = K_NO_WAIT;
+		return 0;
+	}
+
+	if (abstime == NULL) {
+		*timeout = K_FOREVER;
+		return 0;
+	}
+
+	return timespec_to_clock_timeout(CLOCK_REALTIME, abstime, timeout);
+}
+
+#ifdef CONFIG_POSIX_TRACING
+/* Get the whole time a wait until abstime may last, unlike message_timeout() */
+static k_timeout_t mq_trace_timeout(mqueue_desc *mqd, const struct timespec *abstime)
+{
+	if ((mqd->flags & O_NONBLOCK) != 0U) {
+		return K_NO_WAIT;
+	}
+
+	return sys_trace_posix_abstime(CLOCK_REALTIME, abstime);
+}
+#endif
+
 static int32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_len,
-			  k_timeout_t timeout)
+			  const struct timespec *abstime)
 {
 	int32_t ret = -1;
+	int rc;
+	int more;
+	k_timeout_t timeout;
 
 	if (mqd == NULL) {
 		errno = EBADF;
 		return ret;
 	}
 
-	if ((mqd->flags & O_NONBLOCK) != 0U) {
-		timeout = K_NO_WAIT;
-	}
-
 	if (msg_len >  mqd->mqueue->queue.msg_size) {
 		errno = EMSGSIZE;
 		return ret;
@@ -477,11 +506,23 @@ static int32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_le
 
 	uint32_t msgq_num = k_msgq_num_used_get(&mqd->mqueue->queue);
 
-	if (k_msgq_put(&mqd->mqueue->queue, (void *)msg_ptr, timeout) != 0) {
-		errno = K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? EAGAIN : ETIMEDOUT;
+	sys_port_trace_posix_enter(MQ_SEND, &mqd->mqueue->queue, mq_trace_timeout(mqd, abstime));
+	sys_port_trace_posix_blocking(MQ_SEND, &mqd->mqueue->queue,
+				      k_msgq_num_free_get(&mqd->mqueue->queue) == 0);
+
+	do {
+		more = message_timeout(mqd, abstime, &timeout);
+		rc = k_msgq_put(&mqd->mqueue->queue, (void *)msg_ptr, timeout);
+	} while ((rc == -EAGAIN) && (more > 0));
+
+	if (rc != 0) {
+		errno = ((mqd->flags & O_NONBLOCK) != 0U) ? EAGAIN : ETIMEDOUT;
+		sys_port_trace_posix_exit(MQ_SEND, &mqd->mqueue->queue, errno);
 		return ret;
 	}
 
+	sys_port_trace_posix_exit(MQ_SEND, &mqd->mqueue->queue, 0);
+
 	if (k_msgq_num_used_get(&mqd->mqueue->queue) - msgq_num > 0) {
 		struct sigevent *sevp = &mqd->mqueue->not;
 
@@ -505,9 +546,13 @@ static int32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_le
 }
 
 static int32_t receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
-			     k_timeout_t timeout)
+			     const struct timespec *abstime)
 {
 	int ret = -1;
+	int rc;
+	int more;
+	k_timeout_t timeout;
+	struct posix_clock_wait wait;
 
 	if (mqd == NULL) {
 		errno = EBADF;
@@ -519,14 +564,23 @@ static int32_t receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
 		return ret;
 	}
 
-	if ((mqd->flags & O_NONBLOCK) != 0U) {
-		timeout = K_NO_WAIT;
-	}
+	sys_port_trace_posix_enter(MQ_RECEIVE, &mqd->mqueue->queue, mq_trace_timeout(mqd, abstime));
+	sys_port_trace_posix_blocking(MQ_RECEIVE, &mqd->mqueue->queue,
+				      k_msgq_num_used_get(&mqd->mqueue->queue) == 0);
+
+	posix_clock_wait_begin(&wait, (abstime == NULL) ? -1 : (int)CLOCK_REALTIME);
+	do {
+		more = message_timeout(mqd, abstime, &timeout);
+		rc = posix_clock_msgq_get(&wait, &mqd->mqueue->queue, (void *)msg_ptr, timeout);
+	} while ((rc == -EAGAIN) && (more > 0));
+	posix_clock_wait_end(&wait);
 
-	if (k_msgq_get(&mqd->mqueue->queue, (void *)msg_ptr, timeout) != 0) {
-		errno = K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? EAGAIN : ETIMEDOUT;
+	if (rc != 0) {
+		errno = ((mqd->flags & O_NONBLOCK) != 0U) ? EAGAIN : ETIMEDOUT;
+		sys_port_trace_posix_exit(MQ_RECEIVE, &mqd->mqueue->queue, errno);
 	} else {
 		ret = mqd->mqueue->queue.msg_size;
+		sys_port_trace_posix_exit(MQ_RECEIVE, &mqd->mqueue->queue, 0);
 	}
 
 	return ret;
@@ -0,0 +1,496 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "domain_priv.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/types.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+/*
+ * A process domain is a group of pthreads that share a process ID, an environment, and signal
+ * dispositions. Threads belong to the domain of the thread that created them, and to the initial
+ * domain if they were not created by pthread_create(). pthread_spawn_np() creates a thread in a
+ * new domain.
+ *
+ * Only threads outside of the initial domain are recorded. Each has an entry in members[], so that
+ * the threads of a domain can be found. The table is hashed by thread, with linear probing, so that
+ * the domain of a thread is found without a search of the whole table, and without the custom data
+ * of the thread, which belongs to the application. The usage of the initial domain is what remains
+ * of the usage of all threads once that of the other domains is taken away.
+ */
+
+struct posix_domain {
+	pid_t pid;
+	pid_t ppid;
+	/* threads of the domain, and threads about to be created in it */
+	uint16_t nthreads;
+	bool used;
+	char **environ;
+	/* usage of threads of the domain that have exited */
+	struct posix_usage exited;
+	/* usage of child domains that have gone away */
+	struct posix_usage children;
+};
+
+struct posix_domain_member {
+	struct k_thread *thread;
+	struct posix_domain *domain;
+};
+
+extern struct k_thread z_main_thread;
+
+static struct k_spinlock domain_lock;
+static struct posix_domain domains[1 + CONFIG_POSIX_PROCESS_DOMAINS_MAX] = {
+	[0] = {
+		.pid = POSIX_DOMAIN_INIT_PID,
+		.used = true,
+	},
+};
+static struct posix_domain_member members[CONFIG_POSIX_THREAD_THREADS_MAX];
+static pid_t next_pid = POSIX_DOMAIN_INIT_PID + 1;
+/* usage of domains that have gone away */
+static struct posix_usage gone;
+
+/* pthread_spawn_np() hands its domain to pthread_create() through these */
+static K_MUTEX_DEFINE(spawn_lock);
+static struct k_thread *spawner;
+static struct posix_domain *spawned;
+
+static inline size_t domain_hash(const struct k_thread *thread)
+{
+	return ((uintptr_t)thread / sizeof(struct k_thread)) % ARRAY_SIZE(members);
+}
+
+static inline size_t domain_next(size_t i)
+{
+	return (i + 1) % ARRAY_SIZE(members);
+}
+
+/* entries are removed with domain_member_drop(), so the probe of a thread ends at a free entry */
+static struct posix_domain_member *domain_member(const struct k_thread *thread)
+{
+	size_t i = domain_hash(thread);
+
+	for (size_t n = 0; n < ARRAY_SIZE(members); ++n) {
+		if (members[i].thread == thread) {
+			return &members[i];
+		}
+
+		if (members[i].thread == NULL) {
+			break;
+		}
+
+		i = domain_next(i);
+	}
+
+	return NULL;
+}
+
+static struct posix_domain_member *domain_member_claim(struct k_thread *thread)
+{
+	size_t i = domain_hash(thread);
+
+	for (size_t n = 0; n < ARRAY_SIZE(members); ++n) {
+		if (members[i].thread == NULL) {
+			members[i].thread = thread;
+			return &members[i];
+		}
+
+		i = domain_next(i);
+	}
+
+	return NULL;
+}
+
+/* free @p m, and move back the entries after it that would no longer be found */
+static void domain_member_drop(struct posix_domain_member *m)
+{
+	size_t home;
+	size_t i = m - members;
+	size_t j = i;
+
+	members[i] = (struct posix_domain_member){0};
+
+	for (size_t n = 1; n < ARRAY_SIZE(members); ++n) {
+		j = domain_next(j);
+		if (members[j].thread == NULL) {
+			break;
+		}
+
+		/* an entry stays where it is if its probe starts after the free entry */
+		home = domain_hash(members[j].thread);
+		if ((i < j) ? ((i < home) && (home <= j)) : ((i < home) || (home <= j))) {
+			continue;
+		}
+
+		members[i] = members[j];
+		members[j] = (struct posix_domain_member){0};
+		i = j;
+	}
+}
+
+static struct posix_domain *domain_of(const struct k_thread *thread)
+{
+	struct posix_domain_member *m = domain_member(thread);
+
+	return (m == NULL) ? &domains[0] : m->domain;
+}
+
+static struct posix_domain *domain_by_pid(pid_t pid)
+{
+	ARRAY_FOR_EACH_PTR(domains, d) {
+		if (d->used && (d->pid == pid)) {
+			return d;
+		}
+	}
+
+	return NULL;
+}
+
+static pid_t domain_alloc_pid(void)
+{
+	pid_t pid;
+
+	do {
+		pid = next_pid;
+		next_pid = (next_pid == INT32_MAX) ? (POSIX_DOMAIN_INIT_PID + 1) : (next_pid + 1);
+	} while (domain_by_pid(pid) != NULL);
+
+	return pid;
+}
+
+/* account for @p domain going away, and hand its environment back to be freed */
+static char **domain_destroy(struct posix_domain *domain)
+{
+	char **env = domain->environ;
+	struct posix_domain *parent = domain_by_pid(domain->ppid);
+
+	if (parent != NULL) {
+		posix_usage_add(&parent->children, &domain->exited);
+		posix_usage_add(&parent->children, &domain->children);
+	}
+	posix_usage_add(&gone, &domain->exited);
+
+	/* orphans are adopted by the initial domain */
+	ARRAY_FOR_EACH_PTR(domains, d) {
+		if (d->used && (d->ppid == domain->pid)) {
+			d->ppid = POSIX_DOMAIN_INIT_PID;
+		}
+	}
+
+	*domain = (struct posix_domain){0};
+
+	return env;
+}
+
+/* drop a thread from @p domain, returning true if the domain went away */
+static bool domain_put(struct posix_domain *domain, char ***env)
+{
+	__ASSERT_NO_MSG(domain->nthreads > 0);
+
+	if (--domain->nthreads > 0) {
+		return false;
+	}
+
+	*env = domain_destroy(domain);
+
+	return true;
+}
+
+static void domain_gone(int index, char **env)
+{
+	posix_sig_domain_init(index, -1);
+	z_env_free(&env);
+}
+
+struct posix_domain *posix_domain_hold(void)
+{
+	struct posix_domain *domain;
+
+	K_SPINLOCK(&domain_lock) {
+		if ((spawner == k_current_get()) && (spawned != NULL)) {
+			domain = spawned;
+			spawned = NULL;
+		} else {
+			domain = domain_of(k_current_get());
+		}
+
+		if (domain != &domains[0]) {
+			++domain->nthreads;
+		}
+	}
+
+	return domain;
+}
+
+void posix_domain_release(struct posix_domain *domain)
+{
+	bool gone_away = false;
+	char **env = NULL;
+
+	if ((domain == NULL) || (domain == &domains[0])) {
+		return;
+	}
+
+	K_SPINLOCK(&domain_lock) {
+		gone_away = domain_put(domain, &env);
+	}
+
+	if (gone_away) {
+		domain_gone(domain - domains, env);
+	}
+}
+
+void posix_domain_enter(struct posix_domain *domain)
+{
+	struct posix_domain_member *m;
+
+	if (domain == NULL) {
+		return;
+	}
+
+	K_SPINLOCK(&domain_lock) {
+		/* a thread that did not exit through pthread_exit() may have left its entry */
+		m = domain_member(k_current_get());
+		if (m != NULL) {
+			domain_member_drop(m);
+		}
+
+		if (domain == &domains[0]) {
+			K_SPINLOCK_BREAK;
+		}
+
+		m = domain_member_claim(k_current_get());
+		__ASSERT(m != NULL, "no room to record thread %p", k_current_get());
+		if (m != NULL) {
+			m->domain = domain;
+		}
+	}
+}
+
+void posix_domain_exit(void)
+{
+	bool gone_away = false;
+	char **env = NULL;
+	struct posix_domain *domain = NULL;
+	struct posix_domain_member *m;
+
+	K_SPINLOCK(&domain_lock) {
+		m = domain_member(k_current_get());
+		if (m == NULL) {
+			K_SPINLOCK_BREAK;
+		}
+
+		domain = m->domain;
+		domain_member_drop(m);
+		posix_usage_thread(k_current_get(), &domain->exited);
+		gone_away = domain_put(domain, &env);
+	}
+
+	if (gone_away) {
+		domain_gone(domain - domains, env);
+	}
+}
+
+int posix_domain_index(const struct k_thread *thread)
+{
+	int index = 0;
+
+	K_SPINLOCK(&domain_lock) {
+		index = domain_of(thread) - domains;
+	}
+
+	return index;
+}
+
+pid_t posix_domain_getpid(void)
+{
+	pid_t pid = POSIX_DOMAIN_INIT_PID;
+
+	K_SPINLOCK(&domain_lock) {
+		pid = domain_of(k_current_get())->pid;
+	}
+
+	return pid;
+}
+
+pid_t posix_domain_getppid(void)
+{
+	pid_t ppid = 0;
+
+	K_SPINLOCK(&domain_lock) {
+		ppid = domain_of(k_current_get())->ppid;
+	}
+
+	return ppid;
+}
+
+struct k_thread *posix_domain_thread(pid_t pid)
+{
+	struct posix_domain *domain;
+	struct k_thread *thread = NULL;
+
+	K_SPINLOCK(&domain_lock) {
+		domain = domain_by_pid(pid);
+		if (domain == NULL) {
+			K_SPINLOCK_BREAK;
+		}
+
+		if (domain == &domains[0]) {
+			thread = &z_main_thread;
+			K_SPINLOCK_BREAK;
+		}
+
+		ARRAY_FOR_EACH_PTR(members, m) {
+			if (m->domain == domain) {
+				thread = m->thread;
+				break;
+			}
+		}
+	}
+
+	return thread;
+}
+
+char ***posix_domain_environ(void)
+{
+	char ***env = NULL;
+	struct posix_domain *domain;
+
+	K_SPINLOCK(&domain_lock) {
+		domain = domain_of(k_current_get());
+		if (domain != &domains[0]) {
+			env = &domain->environ;
+		}
+	}
+
+	return env;
+}
+
+int posix_domain_usage(struct posix_usage *self, struct posix_usage *children)
+{
+	int ret = 0;
+	struct posix_usage others;
+	struct posix_domain *domain;
+
+	*self = (struct posix_usage){0};
+
+	K_SPINLOCK(&domain_lock) {
+		domain = domain_of(k_current_get());
+		*children = domain->children;
+
+		if (domain != &domains[0]) {
+			*self = domain->exited;
+			ARRAY_FOR_EACH_PTR(members, m) {
+				if (m->domain == domain) {
+					posix_usage_thread(m->thread, self);
+				}
+			}
+			K_SPINLOCK_BREAK;
+		}
+
+		ret = posix_usage_all(self);
+		others = gone;
+		for (size_t i = 1; i < ARRAY_SIZE(domains); ++i) {
+			posix_usage_add(&others, &domains[i].exited);
+		}
+		ARRAY_FOR_EACH_PTR(members, m) {
+			if (m->thread != NULL) {
+				posix_usage_thread(m->thread, &others);
+			}
+		}
+		posix_usage_sub(self, &others);
+	}
+
+	return ret;
+}
+
+int pthread_spawn_np(pid_t *pid, pthread_t *thread, const pthread_attr_t *attr,
+		     void *(*start_routine)(void *), void *arg)
+{
+	int ret;
+	int parent = 0;
+	pid_t new_pid = 0;
+	char **env = NULL;
+	bool gone_away = false;
+	struct posix_domain *domain = NULL;
+
+	if ((pid == NULL) || (thread == NULL) || (start_routine == NULL)) {
+		return EINVAL;
+	}
+
+	ret = z_env_dup(&env);
+	if (ret < 0) {
+		return -ret;
+	}
+
+	K_SPINLOCK(&domain_lock) {
+		parent = domain_of(k_current_get()) - domains;
+		for (size_t i = 1; i < ARRAY_SIZE(domains); ++i) {
+			if (!domains[i].used) {
+				domain = &domains[i];
+				break;
+			}
+		}
+
+		if (domain == NULL) {
+			K_SPINLOCK_BREAK;
+		}
+
+		new_pid = domain_alloc_pid();
+		*domain = (struct posix_domain){
+			.pid = new_pid,
+			.ppid = domains[parent].pid,
+			.used = true,
+			.environ = env,
+		};
+	}
+
+	if (domain == NULL) {
+		z_env_free(&env);
+		return EAGAIN;
+	}
+
+	posix_sig_domain_init(domain - domains, parent);
+
+	/* spawns are serialized, so that pthread_create() can tell which thread spawns */
+	(void)k_mutex_lock(&spawn_lock, K_FOREVER);
+	K_SPINLOCK(&domain_lock) {
+		spawner = k_current_get();
+		spawned = domain;
+	}
+
+	ret = pthread_create(thread, attr, start_routine, arg);
+
+	K_SPINLOCK(&domain_lock) {
+		/* pthread_create() may have failed before it took the domain */
+		if ((ret != 0) && (spawned == domain)) {
+			env = domain_destroy(domain);
+			gone_away = true;
+		}
+		spawner = NULL;
+		spawned = NULL;
+	}
+	(void)k_mutex_unlock(&spawn_lock);
+
+	if (gone_away) {
+		domain_gone(domain - domains, env);
+	}
+
+	if (ret == 0) {
+		*pid = new_pid;
+	}
+
+	return ret;
+}
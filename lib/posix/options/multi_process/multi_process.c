@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "domain_priv.h"
+
 #include <errno.h>
 #include <sys/times.h>
 #include <time.h>
@@ -25,35 +27,48 @@ pid_t getpid(void)
 	 * Also note, that negative PIDs may be used by kill()
 	 * to send signals to process groups in some implementations.
 	 *
-	 * At the moment, getpid just returns an arbitrary number >= 2
+	 * The initial process domain has an arbitrary PID >= 2, and other process domains, if
+	 * enabled, have PIDs above it.
 	 */
 
-	return 42;
+	return posix_domain_getpid();
 }
 #ifdef CONFIG_POSIX_MULTI_PROCESS_ALIAS_GETPID
 FUNC_ALIAS(getpid, _getpid, pid_t);
 #endif /* CONFIG_POSIX_MULTI_PROCESS_ALIAS_GETPID */
 
+pid_t getppid(void)
+{
+	return posix_domain_getppid();
+}
+
+static clock_t cycles_to_clock(uint64_t cycles)
+{
+	return z_tmcvt(cycles, sys_clock_hw_cycles_per_sec(), USEC_PER_SEC,
+		       IS_ENABLED(CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME) ? false : true,
+		       sizeof(clock_t) == sizeof(uint32_t), false, false);
+}
+
 clock_t times(struct tms *buffer)
 {
 	int ret;
 	clock_t utime; /* user time */
-	k_thread_runtime_stats_t stats;
+	struct posix_usage self;
+	struct posix_usage children;
 
-	ret = k_thread_runtime_stats_all_get(&stats);
+	/* only the threads of the process domain of the caller, if domains are enabled */
+	ret = posix_domain_usage(&self, &children);
 	if (ret < 0) {
 		errno = -ret;
 		return (clock_t)-1;
 	}
 
-	utime = z_tmcvt(stats.total_cycles, sys_clock_hw_cycles_per_sec(), USEC_PER_SEC,
-			IS_ENABLED(CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME) ? false : true,
-			sizeof(clock_t) == sizeof(uint32_t), false, false);
+	utime = cycles_to_clock(self.cycles);
 
 	*buffer = (struct tms){
 		.tms_utime = utime,
 		.tms_stime = 0,
-		.tms_cutime = 0,
+		.tms_cutime = cycles_to_clock(children.cycles),
 		.tms_cstime = 0,
 	};
 
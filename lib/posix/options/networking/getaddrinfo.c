@@ -10,11 +10,18 @@
 
 #include <zephyr/posix/net/conversion.h>
 
+#include "resolver_priv.h"
+
 int getaddrinfo(const char *host, const char *service, const struct addrinfo *hints,
 		struct addrinfo **res)
 {
+	int ret;
 	struct zsock_addrinfo zhints;
 
+	if (posix_res_getaddrinfo(host, service, hints, res, &ret)) {
+		return ret;
+	}
+
 	return zsock_getaddrinfo(host, service, posix_addrinfo_hints_to_zephyr(hints, &zhints),
 				 (struct zsock_addrinfo **)res);
 }
@@ -0,0 +1,271 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ifaddrs_priv.h"
+
+#include <errno.h>
+#include <ifaddrs.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <net/if.h>
+
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/sys/util.h>
+
+union ifa_sockaddr {
+	struct sockaddr sa;
+	struct sockaddr_in sin;
+	struct sockaddr_in6 sin6;
+	struct net_sockaddr_ll sll;
+};
+
+/* the list is an array of these, followed by the interface names */
+struct ifa_entry {
+	struct ifaddrs ifa;
+	union ifa_sockaddr addr;
+	union ifa_sockaddr netmask;
+};
+
+struct ifa_walk {
+	/* NULL while counting the entries */
+	struct ifa_entry *ent;
+	size_t n;
+	size_t max;
+	char *names;
+	/* name, flags and index of the interface being walked */
+	char *name;
+	unsigned int flags;
+	int index;
+};
+
+static bool ifa_is_loopback(struct net_if *iface)
+{
+#ifdef CONFIG_NET_IPV4
+	struct net_in_addr lo4 = {{{127, 0, 0, 1}}};
+
+	if (net_if_ipv4_addr_lookup_by_iface(iface, &lo4) != NULL) {
+		return true;
+	}
+#endif
+#ifdef CONFIG_NET_IPV6
+	struct net_in6_addr lo6 = net_in6addr_loopback;
+
+	if (net_if_ipv6_addr_lookup_by_iface(iface, &lo6) != NULL) {
+		return true;
+	}
+#endif
+	ARG_UNUSED(iface);
+
+	return false;
+}
+
+unsigned int posix_if_flags(struct net_if *iface)
+{
+	unsigned int flags = 0;
+
+	if (net_if_is_admin_up(iface)) {
+		flags |= IFF_UP;
+	}
+	if (net_if_is_up(iface)) {
+		flags |= IFF_RUNNING;
+	}
+	if (IS_ENABLED(CONFIG_NET_LOOPBACK) && ifa_is_loopback(iface)) {
+		flags |= IFF_LOOPBACK;
+	}
+
+	return flags;
+}
+
+/* count an entry, and return it if there is room for it */
+static struct ifa_entry *ifa_next_entry(struct ifa_walk *w)
+{
+	struct ifa_entry *e = NULL;
+
+	if (w->n < w->max) {
+		e = &w->ent[w->n];
+		*e = (struct ifa_entry){0};
+		e->ifa.ifa_name = w->name;
+		e->ifa.ifa_flags = w->flags;
+	}
+	++w->n;
+
+	return e;
+}
+
+#ifdef CONFIG_NET_IPV4
+static void ifa_walk_ipv4(struct net_if *iface, struct net_if_addr *addr, void *user_data)
+{
+	struct ifa_entry *e;
+	struct net_in_addr mask;
+	struct ifa_walk *w = user_data;
+
+	if (!addr->is_used) {
+		return;
+	}
+
+	e = ifa_next_entry(w);
+	if (e == NULL) {
+		return;
+	}
+
+	mask = net_if_ipv4_get_netmask_by_addr(iface, &addr->address.in_addr);
+
+	e->addr.sin.sin_family = AF_INET;
+	memcpy(&e->addr.sin.sin_addr, &addr->address.in_addr, sizeof(e->addr.sin.sin_addr));
+	e->netmask.sin.sin_family = AF_INET;
+	memcpy(&e->netmask.sin.sin_addr, &mask, sizeof(e->netmask.sin.sin_addr));
+
+	e->ifa.ifa_addr = &e->addr.sa;
+	e->ifa.ifa_netmask = &e->netmask.sa;
+}
+#endif
+
+#ifdef CONFIG_NET_IPV6
+static void ifa_walk_ipv6(struct net_if *iface, struct net_if_addr *addr, void *user_data)
+{
+	uint8_t len = 128;
+	struct ifa_entry *e;
+	struct ifa_walk *w = user_data;
+	struct net_if_ipv6_prefix *prefix;
+
+	if (!addr->is_used) {
+		return;
+	}
+
+	e = ifa_next_entry(w);
+	if (e == NULL) {
+		return;
+	}
+
+	prefix = net_if_ipv6_prefix_get(iface, &addr->address.in6_addr);
+	if (prefix != NULL) {
+		len = prefix->len;
+	} else if (net_ipv6_is_ll_addr(&addr->address.in6_addr)) {
+		len = 64;
+	}
+
+	e->addr.sin6.sin6_family = AF_INET6;
+	memcpy(&e->addr.sin6.sin6_addr, &addr->address.in6_addr,
+	       sizeof(e->addr.sin6.sin6_addr));
+	if (net_ipv6_is_ll_addr(&addr->address.in6_addr)) {
+		e->addr.sin6.sin6_scope_id = w->index;
+	}
+
+	e->netmask.sin6.sin6_family = AF_INET6;
+	for (int i = 0; i < len / 8; ++i) {
+		e->netmask.sin6.sin6_addr.s6_addr[i] = 0xff;
+	}
+	if ((len % 8) != 0) {
+		e->netmask.sin6.sin6_addr.s6_addr[len / 8] = (uint8_t)(0xff00 >> (len % 8));
+	}
+
+	e->ifa.ifa_addr = &e->addr.sa;
+	e->ifa.ifa_netmask = &e->netmask.sa;
+}
+#endif
+
+static void ifa_walk_iface(struct ifa_walk *w, int index)
+{
+	int ret;
+	struct ifa_entry *e;
+	struct net_linkaddr *ll;
+	struct net_if *iface = net_if_get_by_index(index);
+
+	w->index = index;
+	w->flags = posix_if_flags(iface);
+	if (w->names != NULL) {
+		/* names are packed, each taking only its length plus the NUL terminator */
+		ret = net_if_get_name(iface, w->names, IF_NAMESIZE);
+		if (ret < 0) {
+			w->names[0] = '\0';
+			ret = 0;
+		}
+
+		w->name = w->names;
+		w->names += ret + 1;
+	}
+
+	/* the first entry of each interface holds its link-layer address, as on Linux */
+	e = ifa_next_entry(w);
+	if (e != NULL) {
+		ll = net_if_get_link_addr(iface);
+
+		e->addr.sll.sll_family = NET_AF_PACKET;
+		e->addr.sll.sll_ifindex = index;
+		e->addr.sll.sll_halen = MIN(ll->len, sizeof(e->addr.sll.sll_addr));
+		memcpy(e->addr.sll.sll_addr, ll->addr, e->addr.sll.sll_halen);
+
+		e->ifa.ifa_addr = &e->addr.sa;
+	}
+
+#ifdef CONFIG_NET_IPV4
+	net_if_ipv4_addr_foreach(iface, ifa_walk_ipv4, w);
+#endif
+#ifdef CONFIG_NET_IPV6
+	net_if_ipv6_addr_foreach(iface, ifa_walk_ipv6, w);
+#endif
+}
+
+static void ifa_walk(struct ifa_walk *w, size_t n_if)
+{
+	for (size_t i = 0; i < n_if; ++i) {
+		ifa_walk_iface(w, i + 1);
+	}
+}
+
+int getifaddrs(struct ifaddrs **ifap)
+{
+	size_t n_if;
+	struct ifa_walk w;
+	struct ifa_entry *ent;
+
+	if (ifap == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	NET_IFACE_COUNT(&n_if);
+	if (n_if == 0) {
+		*ifap = NULL;
+		return 0;
+	}
+
+	/* count the entries, then fill them in, again if addresses were added in between */
+	w = (struct ifa_walk){0};
+	ifa_walk(&w, n_if);
+	do {
+		ent = malloc(w.n * sizeof(*ent) + n_if * IF_NAMESIZE);
+		if (ent == NULL) {
+			errno = ENOMEM;
+			return -1;
+		}
+
+		w = (struct ifa_walk){
+			.ent = ent,
+			.max = w.n,
+			.names = (char *)&ent[w.n],
+		};
+		ifa_walk(&w, n_if);
+		if (w.n > w.max) {
+			free(ent);
+		}
+	} while (w.n > w.max);
+
+	for (size_t i = 1; i < w.n; ++i) {
+		ent[i - 1].ifa.ifa_next = &ent[i].ifa;
+	}
+
+	*ifap = &ent[0].ifa;
+
+	return 0;
+}
+
+void freeifaddrs(struct ifaddrs *ifa)
+{
+	/* every entry, address and name is in the allocation that starts with the first entry */
+	free(ifa);
+}
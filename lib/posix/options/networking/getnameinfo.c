@@ -13,9 +13,12 @@
 
 #include <zephyr/posix/net/conversion.h>
 
+#include "resolver_priv.h"
+
 int getnameinfo(const struct sockaddr *addr, socklen_t addrlen, char *host, socklen_t hostlen,
 		char *serv, socklen_t servlen, int flags)
 {
+	int ret;
 	struct sockaddr_storage zbuf;
 	size_t zaddrlen = sizeof(zbuf);
 
@@ -26,6 +29,10 @@ int getnameinfo(const struct sockaddr *addr, socklen_t addrlen, char *host, sock
 	struct net_sockaddr *zaddr =
 		posix_sockaddr_to_zephyr(addr, addrlen, (struct net_sockaddr *)&zbuf, &zaddrlen);
 
-	return zsock_getnameinfo(zaddr, (socklen_t)zaddrlen, host, hostlen, serv, servlen, flags);
-}
+	ret = zsock_getnameinfo(zaddr, (socklen_t)zaddrlen, host, hostlen, serv, servlen, flags);
+	if (ret != 0) {
+		return ret;
+	}
 
+	return posix_res_getnameinfo(addr, host, hostlen, flags);
+}
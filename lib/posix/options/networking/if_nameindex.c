@@ -13,55 +13,42 @@
 
 void if_freenameindex(struct if_nameindex *ptr)
 {
-	size_t n;
-
-	if (ptr == NULL) {
-		return;
-	}
-
-	NET_IFACE_COUNT(&n);
-
-	for (size_t i = 0; i < n; ++i) {
-		if (ptr[i].if_name != NULL) {
-			free(ptr[i].if_name);
-		}
-	}
-
+	/* the names are stored in the same allocation, after the terminating entry */
 	free(ptr);
 }
 
 struct if_nameindex *if_nameindex(void)
 {
+	int ret;
 	size_t n;
 	char *name;
 	struct if_nameindex *ni;
 
 	NET_IFACE_COUNT(&n);
-	ni = malloc((n + 1) * sizeof(*ni));
+	ni = malloc((n + 1) * sizeof(*ni) + n * IF_NAMESIZE);
 	if (ni == NULL) {
-		goto return_err;
+		errno = ENOBUFS;
+		return NULL;
 	}
 
+	name = (char *)&ni[n + 1];
 	for (size_t i = 0; i < n; ++i) {
 		ni[i].if_index = i + 1;
-
-		ni[i].if_name = malloc(IF_NAMESIZE);
-		if (ni[i].if_name == NULL) {
-			goto return_err;
+		ni[i].if_name = name;
+
+		/* names are packed, each taking only its length plus the NUL terminator */
+		ret = net_if_get_name(net_if_get_by_index(i + 1), name, IF_NAMESIZE);
+		__ASSERT_NO_MSG(ret >= 0);
+		if (ret < 0) {
+			name[0] = '\0';
+			ret = 0;
 		}
 
-		name = if_indextoname(i + 1, ni[i].if_name);
-		__ASSERT_NO_MSG(name != NULL);
+		name += ret + 1;
 	}
 
 	ni[n].if_index = 0;
 	ni[n].if_name = NULL;
 
 	return ni;
-
-return_err:
-	if_freenameindex(ni);
-	errno = ENOBUFS;
-
-	return NULL;
 }
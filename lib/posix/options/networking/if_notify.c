@@ -0,0 +1,342 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "ifaddrs_priv.h"
+
+#include <errno.h>
+#include <ifaddrs.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_event.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/sys/zvfs.h>
+
+#define IFN_GROUPS (IFN_LINK | IFN_ADDR)
+
+struct ifn_desc {
+	sys_snode_t node;
+	struct k_poll_signal sig;
+	struct if_notification q[CONFIG_POSIX_IF_NOTIFY_QUEUE_SIZE];
+	/* index of the oldest record, and number of records queued */
+	uint16_t head;
+	uint16_t count;
+	/* records were dropped, and IFN_OVERFLOW has not been read yet */
+	bool overflow;
+	int groups;
+	int flags;
+};
+
+static K_MUTEX_DEFINE(ifn_lock);
+static K_CONDVAR_DEFINE(ifn_cond);
+static sys_slist_t ifn_list = SYS_SLIST_STATIC_INIT(&ifn_list);
+static bool ifn_registered;
+
+static struct net_mgmt_event_callback ifn_if_cb;
+#ifdef CONFIG_NET_IPV4
+static struct net_mgmt_event_callback ifn_ipv4_cb;
+#endif
+#ifdef CONFIG_NET_IPV6
+static struct net_mgmt_event_callback ifn_ipv6_cb;
+#endif
+
+static int ifn_poll_events(const struct ifn_desc *d)
+{
+	return ((d->count > 0) || d->overflow) ? ZVFS_POLLIN : 0;
+}
+
+static void ifn_post(const struct if_notification *rec, int group)
+{
+	struct ifn_desc *d;
+
+	k_mutex_lock(&ifn_lock, K_FOREVER);
+	SYS_SLIST_FOR_EACH_CONTAINER(&ifn_list, d, node) {
+		if (((d->groups & group) == 0) || d->overflow) {
+			continue;
+		}
+
+		if (d->count == ARRAY_SIZE(d->q)) {
+			d->overflow = true;
+		} else {
+			d->q[(d->head + d->count) % ARRAY_SIZE(d->q)] = *rec;
+			++d->count;
+		}
+		k_poll_signal_raise(&d->sig, ZVFS_POLLIN);
+	}
+	k_condvar_broadcast(&ifn_cond);
+	k_mutex_unlock(&ifn_lock);
+}
+
+static void ifn_if_handler(struct net_mgmt_event_callback *cb, uint64_t mgmt_event,
+			   struct net_if *iface)
+{
+	struct if_notification rec = {
+		.ifn_type = (mgmt_event == NET_EVENT_IF_UP) ? IFN_LINK_UP : IFN_LINK_DOWN,
+		.ifn_flags = posix_if_flags(iface),
+		.ifn_index = net_if_get_by_iface(iface),
+	};
+
+	ARG_UNUSED(cb);
+
+	ifn_post(&rec, IFN_LINK);
+}
+
+#ifdef CONFIG_NET_IPV4
+static void ifn_ipv4_handler(struct net_mgmt_event_callback *cb, uint64_t mgmt_event,
+			     struct net_if *iface)
+{
+	struct if_notification rec = {
+		.ifn_type = (mgmt_event == NET_EVENT_IPV4_ADDR_ADD) ? IFN_ADDR_ADD : IFN_ADDR_DEL,
+		.ifn_flags = posix_if_flags(iface),
+		.ifn_index = net_if_get_by_iface(iface),
+	};
+
+	rec.ifn_addr.sin.sin_family = AF_INET;
+	if ((cb->info != NULL) && (cb->info_length >= sizeof(rec.ifn_addr.sin.sin_addr))) {
+		memcpy(&rec.ifn_addr.sin.sin_addr, cb->info, sizeof(rec.ifn_addr.sin.sin_addr));
+	}
+
+	ifn_post(&rec, IFN_ADDR);
+}
+#endif
+
+#ifdef CONFIG_NET_IPV6
+static void ifn_ipv6_handler(struct net_mgmt_event_callback *cb, uint64_t mgmt_event,
+			     struct net_if *iface)
+{
+	struct if_notification rec = {
+		.ifn_type = (mgmt_event == NET_EVENT_IPV6_ADDR_ADD) ? IFN_ADDR_ADD : IFN_ADDR_DEL,
+		.ifn_flags = posix_if_flags(iface),
+		.ifn_index = net_if_get_by_iface(iface),
+	};
+
+	rec.ifn_addr.sin6.sin6_family = AF_INET6;
+	if ((cb->info != NULL) && (cb->info_length >= sizeof(rec.ifn_addr.sin6.sin6_addr))) {
+		memcpy(&rec.ifn_addr.sin6.sin6_addr, cb->info, sizeof(rec.ifn_addr.sin6.sin6_addr));
+		if (net_ipv6_is_ll_addr((const struct net_in6_addr *)cb->info)) {
+			rec.ifn_addr.sin6.sin6_scope_id = rec.ifn_index;
+		}
+	}
+
+	ifn_post(&rec, IFN_ADDR);
+}
+#endif
+
+/* the callbacks are added when the first descriptor is opened, and never removed */
+static void ifn_register(void)
+{
+	if (ifn_registered) {
+		return;
+	}
+
+	net_mgmt_init_event_callback(&ifn_if_cb, ifn_if_handler,
+				     NET_EVENT_IF_UP | NET_EVENT_IF_DOWN);
+	net_mgmt_add_event_callback(&ifn_if_cb);
+#ifdef CONFIG_NET_IPV4
+	net_mgmt_init_event_callback(&ifn_ipv4_cb, ifn_ipv4_handler,
+				     NET_EVENT_IPV4_ADDR_ADD | NET_EVENT_IPV4_ADDR_DEL);
+	net_mgmt_add_event_callback(&ifn_ipv4_cb);
+#endif
+#ifdef CONFIG_NET_IPV6
+	net_mgmt_init_event_callback(&ifn_ipv6_cb, ifn_ipv6_handler,
+				     NET_EVENT_IPV6_ADDR_ADD | NET_EVENT_IPV6_ADDR_DEL);
+	net_mgmt_add_event_callback(&ifn_ipv6_cb);
+#endif
+
+	ifn_registered = true;
+}
+
+static ssize_t ifn_read(void *obj, void *buf, size_t sz)
+{
+	size_t n = 0;
+	ssize_t ret = 0;
+	struct ifn_desc *d = obj;
+	struct if_notification *rec = buf;
+	size_t max = sz / sizeof(*rec);
+
+	if (max == 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	k_mutex_lock(&ifn_lock, K_FOREVER);
+	while (ifn_poll_events(d) == 0) {
+		if ((d->flags & ZVFS_O_NONBLOCK) != 0) {
+			errno = EAGAIN;
+			ret = -1;
+			break;
+		}
+
+		(void)k_condvar_wait(&ifn_cond, &ifn_lock, K_FOREVER);
+	}
+
+	if (ret == 0) {
+		for (; (n < max) && (d->count > 0); ++n) {
+			rec[n] = d->q[d->head];
+			d->head = (d->head + 1) % ARRAY_SIZE(d->q);
+			--d->count;
+		}
+
+		/* the overflow record is read after the records queued before it */
+		if ((n < max) && (d->count == 0) && d->overflow) {
+			rec[n++] = (struct if_notification){.ifn_type = IFN_OVERFLOW};
+			d->overflow = false;
+		}
+
+		ret = n * sizeof(*rec);
+	}
+	k_mutex_unlock(&ifn_lock);
+
+	return ret;
+}
+
+static ssize_t ifn_write(void *obj, const void *buf, size_t sz)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(sz);
+
+	errno = EBADF;
+	return -1;
+}
+
+static int ifn_close(void *obj)
+{
+	struct ifn_desc *d = obj;
+
+	k_mutex_lock(&ifn_lock, K_FOREVER);
+	(void)sys_slist_find_and_remove(&ifn_list, &d->node);
+	k_mutex_unlock(&ifn_lock);
+
+	k_free(d);
+
+	return 0;
+}
+
+static int ifn_poll_prepare(struct ifn_desc *d, struct zvfs_pollfd *pfd,
+			    struct k_poll_event **pev, struct k_poll_event *pev_end)
+{
+	int events;
+
+	if (*pev == pev_end) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	k_mutex_lock(&ifn_lock, K_FOREVER);
+	events = ifn_poll_events(d) & pfd->events;
+	if (events == 0) {
+		k_poll_signal_reset(&d->sig);
+	} else {
+		k_poll_signal_raise(&d->sig, events);
+	}
+	k_mutex_unlock(&ifn_lock);
+
+	k_poll_event_init(*pev, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &d->sig);
+	++*pev;
+
+	return 0;
+}
+
+static int ifn_poll_update(struct ifn_desc *d, struct zvfs_pollfd *pfd,
+			   struct k_poll_event **pev)
+{
+	k_mutex_lock(&ifn_lock, K_FOREVER);
+	pfd->revents |= ifn_poll_events(d) & pfd->events;
+	k_mutex_unlock(&ifn_lock);
+
+	++*pev;
+
+	return 0;
+}
+
+static int ifn_ioctl(void *obj, unsigned int request, va_list args)
+{
+	struct ifn_desc *d = obj;
+
+	switch (request) {
+	case ZFD_IOCTL_POLL_PREPARE: {
+		struct zvfs_pollfd *pfd = va_arg(args, struct zvfs_pollfd *);
+		struct k_poll_event **pev = va_arg(args, struct k_poll_event **);
+		struct k_poll_event *pev_end = va_arg(args, struct k_poll_event *);
+
+		return ifn_poll_prepare(d, pfd, pev, pev_end);
+	}
+	case ZFD_IOCTL_POLL_UPDATE: {
+		struct zvfs_pollfd *pfd = va_arg(args, struct zvfs_pollfd *);
+		struct k_poll_event **pev = va_arg(args, struct k_poll_event **);
+
+		return ifn_poll_update(d, pfd, pev);
+	}
+	case ZFD_IOCTL_STAT: {
+		struct zvfs_stat *st = va_arg(args, struct zvfs_stat *);
+
+		*st = (struct zvfs_stat){0};
+		st->mode = ZVFS_MODE_IFIFO;
+
+		return 0;
+	}
+	case ZVFS_F_GETFL:
+		return d->flags;
+	case ZVFS_F_SETFL:
+		k_mutex_lock(&ifn_lock, K_FOREVER);
+		d->flags = va_arg(args, int) & ZVFS_O_NONBLOCK;
+		k_mutex_unlock(&ifn_lock);
+		return 0;
+	default:
+		errno = EINVAL;
+		return -1;
+	}
+}
+
+static const struct fd_op_vtable ifn_vtable = {
+	.read = ifn_read,
+	.write = ifn_write,
+	.close = ifn_close,
+	.ioctl = ifn_ioctl,
+};
+
+int if_notify(int groups, int flags)
+{
+	int fd;
+	struct ifn_desc *d;
+
+	if ((groups == 0) || ((groups & ~IFN_GROUPS) != 0) || ((flags & ~IFN_NONBLOCK) != 0)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	d = k_calloc(1, sizeof(*d));
+	if (d == NULL) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	fd = zvfs_reserve_fd();
+	if (fd < 0) {
+		k_free(d);
+		errno = EMFILE;
+		return -1;
+	}
+
+	d->groups = groups;
+	d->flags = flags & ZVFS_O_NONBLOCK;
+	k_poll_signal_init(&d->sig);
+
+	k_mutex_lock(&ifn_lock, K_FOREVER);
+	ifn_register();
+	sys_slist_append(&ifn_list, &d->node);
+	k_mutex_unlock(&ifn_lock);
+
+	zvfs_finalize_typed_fd(fd, d, &ifn_vtable, ZVFS_MODE_IFIFO);
+
+	return fd;
+}
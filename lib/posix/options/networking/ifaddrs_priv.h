@@ -0,0 +1,14 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_POSIX_OPTIONS_NETWORKING_IFADDRS_PRIV_H_
+#define ZEPHYR_LIB_POSIX_OPTIONS_NETWORKING_IFADDRS_PRIV_H_
+
+#include <zephyr/net/net_if.h>
+
+/* Return the IFF_* flags of @p iface, as reported by getifaddrs() and if_notify(). */
+unsigned int posix_if_flags(struct net_if *iface);
+
+#endif /* ZEPHYR_LIB_POSIX_OPTIONS_NETWORKING_IFADDRS_PRIV_H_ */
@@ -10,16 +10,17 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/socket.h>
+#include <sys/types.h>
 
 #include <zephyr/sys/util.h>
 
-#define NETDB_LINE_MAX 256
-
 struct netdb_file {
 	const char *path;
 	FILE *fp;
 	bool stayopen;
-	char line[NETDB_LINE_MAX];
+	/* grown by getline() as needed, freed by the corresponding end*ent() function */
+	char *line;
+	size_t line_size;
 };
 
 static struct netdb_file hosts_db = {.path = "/etc/hosts"};
@@ -102,6 +103,16 @@ static void netdb_close(struct netdb_file *db)
 	}
 }
 
+static void netdb_end(struct netdb_file *db)
+{
+	netdb_release(db);
+	db->stayopen = false;
+
+	free(db->line);
+	db->line = NULL;
+	db->line_size = 0;
+}
+
 static void netdb_rewind(struct netdb_file *db)
 {
 	if (netdb_open(db) == NULL) {
@@ -120,13 +131,20 @@ static char *skip_ws(char *p)
 	return p;
 }
 
-static void trim_newline(char *p)
+/* read the next line of @p db, without its trailing newline */
+static bool netdb_read_line(struct netdb_file *db)
 {
-	char *nl = strchr(p, '\n');
+	ssize_t len = getline(&db->line, &db->line_size, db->fp);
 
-	if (nl != NULL) {
-		*nl = '\0';
+	if (len < 0) {
+		return false;
+	}
+
+	if ((len > 0) && (db->line[len - 1] == '\n')) {
+		db->line[len - 1] = '\0';
 	}
+
+	return true;
 }
 
 static bool parse_hosts_line(char *line, struct hostent *he)
@@ -210,8 +228,7 @@ struct hostent *gethostent(void)
 		return NULL;
 	}
 
-	while (fgets(db->line, sizeof(db->line), db->fp) != NULL) {
-		trim_newline(db->line);
+	while (netdb_read_line(db)) {
 		if (is_comment_or_blank(db->line)) {
 			continue;
 		}
@@ -237,8 +254,7 @@ void sethostent(int stayopen)
 
 void endhostent(void)
 {
-	netdb_release(&hosts_db);
-	hosts_db.stayopen = false;
+	netdb_end(&hosts_db);
 }
 
 static bool parse_networks_line(char *line, struct netent *ne)
@@ -343,8 +359,7 @@ static struct netent *scan_networks(const char *name, uint32_t net, bool match_n
 
 	netdb_rewind(db);
 	if (db->fp != NULL) {
-		while (fgets(db->line, sizeof(db->line), db->fp) != NULL) {
-			trim_newline(db->line);
+		while (netdb_read_line(db)) {
 			if (is_comment_or_blank(db->line)) {
 				continue;
 			}
@@ -404,8 +419,7 @@ struct netent *getnetent(void)
 		return NULL;
 	}
 
-	while (fgets(db->line, sizeof(db->line), db->fp) != NULL) {
-		trim_newline(db->line);
+	while (netdb_read_line(db)) {
 		if (is_comment_or_blank(db->line)) {
 			continue;
 		}
@@ -431,8 +445,7 @@ void setnetent(int stayopen)
 
 void endnetent(void)
 {
-	netdb_release(&networks_db);
-	networks_db.stayopen = false;
+	netdb_end(&networks_db);
 }
 
 static bool parse_protocols_line(char *line, struct protoent *pe)
@@ -510,8 +523,7 @@ static struct protoent *scan_protocols(const char *name, int proto, bool match_p
 		return NULL;
 	}
 
-	while (fgets(db->line, sizeof(db->line), db->fp) != NULL) {
-		trim_newline(db->line);
+	while (netdb_read_line(db)) {
 		if (is_comment_or_blank(db->line)) {
 			continue;
 		}
@@ -562,8 +574,7 @@ struct protoent *getprotoent(void)
 		return NULL;
 	}
 
-	while (fgets(db->line, sizeof(db->line), db->fp) != NULL) {
-		trim_newline(db->line);
+	while (netdb_read_line(db)) {
 		if (is_comment_or_blank(db->line)) {
 			continue;
 		}
@@ -589,8 +600,7 @@ void setprotoent(int stayopen)
 
 void endprotoent(void)
 {
-	netdb_release(&protocols_db);
-	protocols_db.stayopen = false;
+	netdb_end(&protocols_db);
 }
 
 static bool parse_services_line(char *line, struct servent *se)
@@ -678,8 +688,7 @@ static struct servent *scan_services(const char *name, int port, const char *pro
 		return NULL;
 	}
 
-	while (fgets(db->line, sizeof(db->line), db->fp) != NULL) {
-		trim_newline(db->line);
+	while (netdb_read_line(db)) {
 		if (is_comment_or_blank(db->line)) {
 			continue;
 		}
@@ -734,8 +743,7 @@ struct servent *getservent(void)
 		return NULL;
 	}
 
-	while (fgets(db->line, sizeof(db->line), db->fp) != NULL) {
-		trim_newline(db->line);
+	while (netdb_read_line(db)) {
 		if (is_comment_or_blank(db->line)) {
 			continue;
 		}
@@ -761,6 +769,5 @@ void setservent(int stayopen)
 
 void endservent(void)
 {
-	netdb_release(&services_db);
-	services_db.stayopen = false;
+	netdb_end(&services_db);
 }
@@ -0,0 +1,832 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <arpa/inet.h>
+#include <ctype.h>
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/dns_resolve.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/hash_function.h>
+#include <zephyr/sys/util.h>
+
+#include "resolver_priv.h"
+
+#define HOSTS_FILE "/etc/hosts"
+
+#define NAME_MAX_LEN CONFIG_POSIX_RESOLVER_NAME_MAX
+#define ADDRS_MAX    CONFIG_POSIX_RESOLVER_CACHE_ADDRS
+
+/* a DNS query is abandoned if the resolver has not completed it within its own timeout */
+#define QUERY_TIMEOUT_MS CONFIG_NET_SOCKETS_DNS_TIMEOUT
+#define QUERY_MARGIN_MS  100
+
+/* index of the A and AAAA answers in struct res_entry */
+enum {
+	RR_A,
+	RR_AAAA,
+	RR_NUM,
+};
+
+union res_addr {
+	struct net_in_addr in;
+	struct net_in6_addr in6;
+};
+
+/* addresses of one family for a host name, and how long they may be used for */
+struct res_rrset {
+	k_timepoint_t expiry;
+	/* generation of the cache in which the answer was stored */
+	uint32_t gen;
+	/* 0, or EAI_NONAME for a negative answer */
+	int status;
+	uint8_t count;
+	bool valid;
+	union res_addr addrs[ADDRS_MAX];
+};
+
+struct res_entry {
+	/* held while the answers of this entry are read or refreshed */
+	struct k_mutex lock;
+	/* the fields below are protected by cache_lock */
+	uint32_t hash;
+	uint16_t refs;
+	int64_t last_used;
+	char name[NAME_MAX_LEN];
+	/* the fields below are protected by lock */
+	struct res_rrset rrset[RR_NUM];
+};
+
+struct hosts_entry {
+	uint32_t hash;
+	uint16_t seq;
+	bool alias;
+	int family;
+	union res_addr addr;
+	char name[NAME_MAX_LEN];
+};
+
+/* addresses collected for a single getaddrinfo() call */
+struct res_answer {
+	size_t count;
+	struct {
+		int family;
+		union res_addr addr;
+	} ai[RR_NUM * ADDRS_MAX];
+};
+
+struct res_refresh;
+
+/* a query and the addresses it was answered with, owned by its res_refresh */
+struct res_query {
+	struct res_refresh *refresh;
+	int family;
+	int status;
+	uint16_t id;
+	bool started;
+	/* set once the resolver is done with the query, after its answer is complete */
+	atomic_t completed;
+	uint8_t count;
+	union res_addr addrs[ADDRS_MAX];
+};
+
+/*
+ * The queries of one cache_refresh(). They are allocated because the resolver may still call back
+ * after the refresh gave up waiting, and freed by whichever of them drops the last reference.
+ */
+struct res_refresh {
+	atomic_t refs;
+	struct k_sem done;
+	struct res_query q[RR_NUM];
+};
+
+static struct res_entry cache[CONFIG_POSIX_RESOLVER_CACHE_ENTRIES];
+static K_MUTEX_DEFINE(cache_lock);
+static atomic_t cache_gen;
+
+#ifdef CONFIG_POSIX_RESOLVER_HOSTS
+static struct hosts_entry hosts[CONFIG_POSIX_RESOLVER_HOSTS_MAX];
+static size_t hosts_count;
+static bool hosts_loaded;
+static K_MUTEX_DEFINE(hosts_lock);
+#endif
+
+static const int rr_family[RR_NUM] = {NET_AF_INET, NET_AF_INET6};
+static const enum dns_query_type rr_type[RR_NUM] = {DNS_QUERY_TYPE_A, DNS_QUERY_TYPE_AAAA};
+
+static inline size_t family_addr_len(int family)
+{
+	return (family == NET_AF_INET) ? sizeof(struct net_in_addr) : sizeof(struct net_in6_addr);
+}
+
+/* copy @p name to @p buf in lower case and hash it, failing if it does not fit */
+static bool normalize(const char *name, char *buf, uint32_t *hash)
+{
+	size_t len;
+
+	for (len = 0; name[len] != '\0'; ++len) {
+		if (len >= NAME_MAX_LEN - 1) {
+			return false;
+		}
+
+		buf[len] = tolower((unsigned char)name[len]);
+	}
+
+	if (len == 0) {
+		return false;
+	}
+
+	buf[len] = '\0';
+	*hash = sys_hash32_djb2(buf, len);
+
+	return true;
+}
+
+#ifdef CONFIG_POSIX_RESOLVER_HOSTS
+static int hosts_cmp(const void *a, const void *b)
+{
+	const struct hosts_entry *ea = a;
+	const struct hosts_entry *eb = b;
+
+	if (ea->hash != eb->hash) {
+		return (ea->hash < eb->hash) ? -1 : 1;
+	}
+
+	/* keep addresses in the order of the file */
+	return (int)ea->seq - (int)eb->seq;
+}
+
+static void hosts_add(const char *name, int family, const union res_addr *addr, bool alias)
+{
+	struct hosts_entry *e;
+
+	if (hosts_count >= ARRAY_SIZE(hosts)) {
+		return;
+	}
+
+	e = &hosts[hosts_count];
+	if (!normalize(name, e->name, &e->hash)) {
+		return;
+	}
+
+	e->seq = hosts_count++;
+	e->alias = alias;
+	e->family = family;
+	e->addr = *addr;
+}
+
+/* read /etc/hosts into an index sorted by the hash of each name */
+static void hosts_load(void)
+{
+	FILE *fp;
+	int family;
+	char *tok;
+	char *save;
+	char *line = NULL;
+	size_t size = 0;
+	union res_addr addr;
+
+	hosts_count = 0;
+	hosts_loaded = true;
+
+	fp = fopen(HOSTS_FILE, "r");
+	if (fp == NULL) {
+		return;
+	}
+
+	while (getline(&line, &size, fp) >= 0) {
+		tok = strchr(line, '#');
+		if (tok != NULL) {
+			*tok = '\0';
+		}
+
+		tok = strtok_r(line, " \t\r\n", &save);
+		if (tok == NULL) {
+			continue;
+		}
+
+		if (inet_pton(AF_INET, tok, &addr.in) == 1) {
+			family = NET_AF_INET;
+		} else if (inet_pton(AF_INET6, tok, &addr.in6) == 1) {
+			family = NET_AF_INET6;
+		} else {
+			continue;
+		}
+
+		for (bool alias = false; (tok = strtok_r(NULL, " \t\r\n", &save)) != NULL;
+		     alias = true) {
+			hosts_add(tok, family, &addr, alias);
+		}
+	}
+
+	free(line);
+	(void)fclose(fp);
+
+	qsort(hosts, hosts_count, sizeof(hosts[0]), hosts_cmp);
+}
+
+/* add the addresses of @p name in /etc/hosts that match @p want to @p ans */
+static void hosts_lookup(const char *name, uint32_t hash, const bool want[RR_NUM],
+			 struct res_answer *ans)
+{
+	size_t lo = 0;
+	size_t hi;
+	size_t mid;
+
+	k_mutex_lock(&hosts_lock, K_FOREVER);
+
+	if (!hosts_loaded) {
+		hosts_load();
+	}
+
+	/* find the first entry with a matching hash */
+	for (hi = hosts_count; lo < hi;) {
+		mid = lo + (hi - lo) / 2;
+		if (hosts[mid].hash < hash) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	for (; (lo < hosts_count) && (hosts[lo].hash == hash); ++lo) {
+		const struct hosts_entry *e = &hosts[lo];
+		int rr = (e->family == NET_AF_INET) ? RR_A : RR_AAAA;
+
+		if (!want[rr] || (strcmp(e->name, name) != 0) ||
+		    (ans->count >= ARRAY_SIZE(ans->ai))) {
+			continue;
+		}
+
+		ans->ai[ans->count].family = e->family;
+		ans->ai[ans->count].addr = e->addr;
+		++ans->count;
+	}
+
+	k_mutex_unlock(&hosts_lock);
+}
+
+/* copy the canonical name of @p addr in /etc/hosts to @p host */
+static int hosts_reverse(int family, const union res_addr *addr, char *host, socklen_t hostlen)
+{
+	int ret = EAI_NONAME;
+	const struct hosts_entry *best = NULL;
+
+	k_mutex_lock(&hosts_lock, K_FOREVER);
+
+	if (!hosts_loaded) {
+		hosts_load();
+	}
+
+	for (size_t i = 0; i < hosts_count; ++i) {
+		const struct hosts_entry *e = &hosts[i];
+
+		if ((e->family != family) || e->alias ||
+		    (memcmp(&e->addr, addr, family_addr_len(family)) != 0)) {
+			continue;
+		}
+
+		if ((best == NULL) || (e->seq < best->seq)) {
+			best = e;
+		}
+	}
+
+	if (best != NULL) {
+		ret = (strlen(best->name) < hostlen) ? 0 : EAI_OVERFLOW;
+		if (ret == 0) {
+			strcpy(host, best->name);
+		}
+	}
+
+	k_mutex_unlock(&hosts_lock);
+
+	return ret;
+}
+
+#else /* CONFIG_POSIX_RESOLVER_HOSTS */
+
+static inline void hosts_lookup(const char *name, uint32_t hash, const bool want[RR_NUM],
+				struct res_answer *ans)
+{
+}
+
+static inline int hosts_reverse(int family, const union res_addr *addr, char *host,
+				socklen_t hostlen)
+{
+	return EAI_NONAME;
+}
+
+#endif /* CONFIG_POSIX_RESOLVER_HOSTS */
+
+/* find the cache entry for @p name, or recycle the least recently used one, and reference it */
+static struct res_entry *cache_get(const char *name, uint32_t hash)
+{
+	struct res_entry *e;
+	struct res_entry *victim = NULL;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	for (e = cache; e < &cache[ARRAY_SIZE(cache)]; ++e) {
+		if ((e->name[0] != '\0') && (e->hash == hash) && (strcmp(e->name, name) == 0)) {
+			break;
+		}
+
+		if ((e->refs == 0) &&
+		    ((victim == NULL) || (e->name[0] == '\0') ||
+		     ((victim->name[0] != '\0') && (e->last_used < victim->last_used)))) {
+			victim = e;
+		}
+	}
+
+	if (e == &cache[ARRAY_SIZE(cache)]) {
+		e = victim;
+		if (e != NULL) {
+			/* nobody holds the lock of an unreferenced entry */
+			if (e->name[0] == '\0') {
+				k_mutex_init(&e->lock);
+			}
+			strcpy(e->name, name);
+			e->hash = hash;
+			memset(e->rrset, 0, sizeof(e->rrset));
+		}
+	}
+
+	if (e != NULL) {
+		++e->refs;
+		e->last_used = k_uptime_get();
+	}
+
+	k_mutex_unlock(&cache_lock);
+
+	return e;
+}
+
+static void cache_put(struct res_entry *e)
+{
+	k_mutex_lock(&cache_lock, K_FOREVER);
+	--e->refs;
+	k_mutex_unlock(&cache_lock);
+}
+
+static bool rrset_fresh(const struct res_rrset *rr)
+{
+	return rr->valid && (rr->gen == (uint32_t)atomic_get(&cache_gen)) &&
+	       !sys_timepoint_expired(rr->expiry);
+}
+
+static void refresh_put(struct res_refresh *r)
+{
+	if (atomic_dec(&r->refs) == 1) {
+		free(r);
+	}
+}
+
+static void query_cb(enum dns_resolve_status status, struct dns_addrinfo *info, void *user_data)
+{
+	struct res_query *q = user_data;
+	struct res_refresh *r = q->refresh;
+
+	if (status == DNS_EAI_INPROGRESS) {
+		if ((info == NULL) || (info->ai_family != q->family) ||
+		    (q->count >= ARRAY_SIZE(q->addrs))) {
+			return;
+		}
+
+		if (q->family == NET_AF_INET) {
+			q->addrs[q->count].in = net_sin(&info->ai_addr)->sin_addr;
+		} else {
+			q->addrs[q->count].in6 = net_sin6(&info->ai_addr)->sin6_addr;
+		}
+		++q->count;
+
+		return;
+	}
+
+	q->status = status;
+	atomic_set(&q->completed, true);
+	k_sem_give(&r->done);
+	refresh_put(r);
+}
+
+/* store the outcome of @p q in @p rr, caching it if it is authoritative */
+static int query_store(const struct res_query *q, struct res_rrset *rr, uint32_t gen)
+{
+	int ttl = CONFIG_POSIX_RESOLVER_CACHE_TTL;
+
+	rr->valid = false;
+	rr->count = 0;
+
+	/* a query given up on may still be written to by the resolver */
+	if (!atomic_get(&q->completed)) {
+		return EAI_AGAIN;
+	}
+
+	switch (q->status) {
+	case DNS_EAI_ALLDONE:
+		if (q->count > 0) {
+			rr->count = q->count;
+			memcpy(rr->addrs, q->addrs, q->count * sizeof(q->addrs[0]));
+			rr->status = 0;
+			break;
+		}
+		__fallthrough;
+	case DNS_EAI_NONAME:
+	case DNS_EAI_NODATA:
+		/* RFC 2308: NXDOMAIN and NODATA answers may be cached */
+		rr->status = EAI_NONAME;
+		ttl = CONFIG_POSIX_RESOLVER_CACHE_NEGATIVE_TTL;
+		break;
+	default:
+		/* timeouts and server failures are not cached */
+		return EAI_AGAIN;
+	}
+
+	if (ttl > 0) {
+		rr->expiry = sys_timepoint_calc(K_SECONDS(ttl));
+		rr->gen = gen;
+		rr->valid = true;
+	}
+
+	return rr->status;
+}
+
+static int query_start(struct res_query *q, const char *name, int rr)
+{
+	int ret;
+
+	/* the reference of the callback, taken first as it may run before this returns */
+	atomic_inc(&q->refresh->refs);
+
+	ret = dns_get_addr_info(name, rr_type[rr], &q->id, query_cb, q, QUERY_TIMEOUT_MS);
+	q->started = (ret == 0);
+	if (!q->started) {
+		atomic_dec(&q->refresh->refs);
+	}
+
+	return ret;
+}
+
+/* wait for one of the started queries of @p r to complete, false if it was given up on */
+static bool query_wait(struct res_refresh *r)
+{
+	bool cancelled = false;
+
+	if (k_sem_take(&r->done, K_MSEC(QUERY_TIMEOUT_MS + QUERY_MARGIN_MS)) == 0) {
+		return true;
+	}
+
+	/*
+	 * A cancelled query is reported by its callback before dns_cancel_addr_info() returns.
+	 * If none could be cancelled (e.g. as the resolver context is being closed), the resolver
+	 * still owns the queries, so they are only waited for a little longer and then left to it.
+	 */
+	for (int i = 0; i < RR_NUM; ++i) {
+		if (r->q[i].started && !atomic_get(&r->q[i].completed)) {
+			cancelled |= (dns_cancel_addr_info(r->q[i].id) == 0);
+		}
+	}
+
+	return k_sem_take(&r->done, cancelled ? K_FOREVER : K_MSEC(QUERY_MARGIN_MS)) == 0;
+}
+
+/* query the answer sets of @p e selected by @p need in parallel, with e->lock held */
+static int cache_refresh(struct res_entry *e, const bool need[RR_NUM])
+{
+	int ret;
+	int err = 0;
+	int pending = 0;
+	bool waiting = true;
+	struct res_refresh *r;
+	uint32_t gen = (uint32_t)atomic_get(&cache_gen);
+
+	r = calloc(1, sizeof(*r));
+	if (r == NULL) {
+		return EAI_MEMORY;
+	}
+
+	atomic_set(&r->refs, 1);
+	k_sem_init(&r->done, 0, RR_NUM);
+
+	for (int i = 0; (i < RR_NUM) && waiting; ++i) {
+		if (!need[i]) {
+			continue;
+		}
+
+		r->q[i].refresh = r;
+		r->q[i].family = rr_family[i];
+		r->q[i].status = DNS_EAI_FAIL;
+
+		ret = query_start(&r->q[i], e->name, i);
+		if ((ret < 0) && (pending > 0)) {
+			/* no free query slot (CONFIG_DNS_NUM_CONCUR_QUERIES), so query in sequence */
+			waiting = query_wait(r);
+			--pending;
+			if (waiting) {
+				ret = query_start(&r->q[i], e->name, i);
+			}
+		}
+
+		pending += r->q[i].started;
+	}
+
+	for (; waiting && (pending > 0); --pending) {
+		waiting = query_wait(r);
+	}
+
+	for (int i = 0; i < RR_NUM; ++i) {
+		if (!need[i]) {
+			continue;
+		}
+
+		ret = query_store(&r->q[i], &e->rrset[i], gen);
+		if ((ret != 0) && (err != EAI_AGAIN)) {
+			err = ret;
+		}
+	}
+
+	refresh_put(r);
+
+	return err;
+}
+
+/* add the cached (or freshly resolved) addresses of @p name that match @p want to @p ans */
+static int cache_lookup(const char *name, uint32_t hash, const bool want[RR_NUM],
+			struct res_answer *ans)
+{
+	int ret = 0;
+	bool stale = false;
+	bool need[RR_NUM] = {0};
+	struct res_entry *e;
+
+	e = cache_get(name, hash);
+	if (e == NULL) {
+		/* every entry is being refreshed by another thread */
+		return EAI_AGAIN;
+	}
+
+	k_mutex_lock(&e->lock, K_FOREVER);
+
+	for (int i = 0; i < RR_NUM; ++i) {
+		need[i] = want[i] && !rrset_fresh(&e->rrset[i]);
+		stale |= need[i];
+	}
+
+	if (stale) {
+		ret = cache_refresh(e, need);
+	}
+
+	for (int i = 0; i < RR_NUM; ++i) {
+		const struct res_rrset *rr = &e->rrset[i];
+
+		if (!want[i]) {
+			continue;
+		}
+
+		for (size_t j = 0; j < rr->count; ++j) {
+			ans->ai[ans->count].family = rr_family[i];
+			ans->ai[ans->count].addr = rr->addrs[j];
+			++ans->count;
+		}
+	}
+
+	k_mutex_unlock(&e->lock);
+	cache_put(e);
+
+	if (ans->count > 0) {
+		/* e.g. an AF_UNSPEC lookup of a host that only has IPv4 addresses */
+		return 0;
+	}
+
+	return (ret != 0) ? ret : EAI_NONAME;
+}
+
+/* copy the name of the cache entry that holds @p addr to @p host */
+static int cache_reverse(int family, const union res_addr *addr, char *host, socklen_t hostlen)
+{
+	int ret = EAI_NONAME;
+	int rr_idx = (family == NET_AF_INET) ? RR_A : RR_AAAA;
+
+	for (size_t i = 0; (i < ARRAY_SIZE(cache)) && (ret == EAI_NONAME); ++i) {
+		struct res_entry *e = &cache[i];
+
+		k_mutex_lock(&cache_lock, K_FOREVER);
+		if (e->name[0] == '\0') {
+			k_mutex_unlock(&cache_lock);
+			continue;
+		}
+		++e->refs;
+		k_mutex_unlock(&cache_lock);
+
+		k_mutex_lock(&e->lock, K_FOREVER);
+		if (rrset_fresh(&e->rrset[rr_idx])) {
+			for (size_t j = 0; j < e->rrset[rr_idx].count; ++j) {
+				if (memcmp(&e->rrset[rr_idx].addrs[j], addr,
+					   family_addr_len(family)) != 0) {
+					continue;
+				}
+
+				ret = (strlen(e->name) < hostlen) ? 0 : EAI_OVERFLOW;
+				if (ret == 0) {
+					strcpy(host, e->name);
+				}
+				break;
+			}
+		}
+		k_mutex_unlock(&e->lock);
+
+		cache_put(e);
+	}
+
+	return ret;
+}
+
+/*
+ * Convert @p ans to a list of addrinfo structures. Like the results of zsock_getaddrinfo(), the
+ * list is a single allocation with each address stored in its own node, so that freeaddrinfo()
+ * releases either.
+ */
+static int res_build(const struct res_answer *ans, uint16_t port, const struct addrinfo *hints,
+		     struct addrinfo **res)
+{
+	struct addrinfo *ai;
+	int flags = (hints == NULL) ? 0 : hints->ai_flags;
+	int socktype = (hints == NULL) ? 0 : hints->ai_socktype;
+	int protocol = (hints == NULL) ? 0 : hints->ai_protocol;
+
+	if (socktype == 0) {
+		socktype = SOCK_STREAM;
+	}
+
+	if (protocol == 0) {
+		protocol = (socktype == SOCK_DGRAM) ? IPPROTO_UDP : IPPROTO_TCP;
+	}
+
+	ai = calloc(ans->count, sizeof(*ai));
+	if (ai == NULL) {
+		return EAI_MEMORY;
+	}
+
+	for (size_t i = 0; i < ans->count; ++i) {
+		struct net_sockaddr *sa = (struct net_sockaddr *)&ai[i]._ai_addr;
+
+		if (ans->ai[i].family == NET_AF_INET) {
+			net_sin(sa)->sin_family = NET_AF_INET;
+			net_sin(sa)->sin_port = htons(port);
+			net_sin(sa)->sin_addr = ans->ai[i].addr.in;
+			ai[i].ai_addrlen = sizeof(struct net_sockaddr_in);
+		} else {
+			net_sin6(sa)->sin6_family = NET_AF_INET6;
+			net_sin6(sa)->sin6_port = htons(port);
+			net_sin6(sa)->sin6_addr = ans->ai[i].addr.in6;
+			ai[i].ai_addrlen = sizeof(struct net_sockaddr_in6);
+		}
+
+		ai[i].ai_flags = flags;
+		ai[i].ai_family = ans->ai[i].family;
+		ai[i].ai_socktype = socktype;
+		ai[i].ai_protocol = protocol;
+		ai[i].ai_addr = (struct sockaddr *)sa;
+		ai[i].ai_next = (i + 1 < ans->count) ? &ai[i + 1] : NULL;
+	}
+
+	*res = ai;
+
+	return 0;
+}
+
+/* parse a numeric service, returning false for anything else */
+static bool parse_port(const char *service, uint16_t *port)
+{
+	char *end;
+	unsigned long val;
+
+	if (service == NULL) {
+		*port = 0;
+		return true;
+	}
+
+	if (!isdigit((unsigned char)service[0])) {
+		return false;
+	}
+
+	errno = 0;
+	val = strtoul(service, &end, 10);
+	if ((errno != 0) || (*end != '\0') || (val > UINT16_MAX)) {
+		return false;
+	}
+
+	*port = (uint16_t)val;
+
+	return true;
+}
+
+static bool is_numeric_host(const char *host)
+{
+	union res_addr addr;
+
+	return (inet_pton(AF_INET, host, &addr.in) == 1) ||
+	       (inet_pton(AF_INET6, host, &addr.in6) == 1);
+}
+
+bool posix_res_getaddrinfo(const char *host, const char *service, const struct addrinfo *hints,
+			   struct addrinfo **res, int *ret)
+{
+	int err = errno;
+	uint32_t hash;
+	uint16_t port;
+	char name[NAME_MAX_LEN];
+	struct res_answer ans;
+	bool want[RR_NUM];
+	int family = (hints == NULL) ? AF_UNSPEC : hints->ai_family;
+	int flags = (hints == NULL) ? 0 : hints->ai_flags;
+
+	if ((host == NULL) || (res == NULL) || ((flags & (AI_CANONNAME | AI_NUMERICHOST)) != 0) ||
+	    ((family != AF_UNSPEC) && (family != AF_INET) && (family != AF_INET6)) ||
+	    !parse_port(service, &port) || !normalize(host, name, &hash) ||
+	    is_numeric_host(host)) {
+		errno = err;
+		return false;
+	}
+
+	want[RR_A] = (family == AF_INET) || ((family == AF_UNSPEC) && IS_ENABLED(CONFIG_NET_IPV4));
+	want[RR_AAAA] =
+		(family == AF_INET6) || ((family == AF_UNSPEC) && IS_ENABLED(CONFIG_NET_IPV6));
+
+	ans.count = 0;
+	hosts_lookup(name, hash, want, &ans);
+	if (ans.count == 0) {
+		*ret = cache_lookup(name, hash, want, &ans);
+		if (*ret != 0) {
+			return true;
+		}
+	}
+
+	*ret = res_build(&ans, port, hints, res);
+
+	return true;
+}
+
+int posix_res_getnameinfo(const struct sockaddr *addr, char *host, socklen_t hostlen, int flags)
+{
+	int ret;
+	int family;
+	union res_addr ra;
+
+	if ((host == NULL) || (hostlen == 0) || ((flags & NI_NUMERICHOST) != 0)) {
+		return 0;
+	}
+
+	if (addr->sa_family == AF_INET) {
+		family = NET_AF_INET;
+		memcpy(&ra.in, &((const struct sockaddr_in *)addr)->sin_addr, sizeof(ra.in));
+	} else if (addr->sa_family == AF_INET6) {
+		family = NET_AF_INET6;
+		memcpy(&ra.in6, &((const struct sockaddr_in6 *)addr)->sin6_addr, sizeof(ra.in6));
+	} else {
+		return 0;
+	}
+
+	ret = hosts_reverse(family, &ra, host, hostlen);
+	if (ret == EAI_NONAME) {
+		ret = cache_reverse(family, &ra, host, hostlen);
+	}
+
+	if (ret == EAI_NONAME) {
+		/* keep the numeric host, unless a name is required */
+		return ((flags & NI_NAMEREQD) != 0) ? EAI_NONAME : 0;
+	}
+
+	return ret;
+}
+
+void res_flush(void)
+{
+	/* answers being refreshed by other threads are stored under the previous generation */
+	atomic_inc(&cache_gen);
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+	for (size_t i = 0; i < ARRAY_SIZE(cache); ++i) {
+		if (cache[i].refs == 0) {
+			cache[i].name[0] = '\0';
+		}
+	}
+	k_mutex_unlock(&cache_lock);
+
+#ifdef CONFIG_POSIX_RESOLVER_HOSTS
+	k_mutex_lock(&hosts_lock, K_FOREVER);
+	hosts_loaded = false;
+	k_mutex_unlock(&hosts_lock);
+#endif
+}
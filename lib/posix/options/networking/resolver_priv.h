@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_POSIX_OPTIONS_NETWORKING_RESOLVER_PRIV_H_
+#define ZEPHYR_LIB_POSIX_OPTIONS_NETWORKING_RESOLVER_PRIV_H_
+
+#include <stdbool.h>
+
+#include <netdb.h>
+#include <sys/socket.h>
+
+#include <zephyr/toolchain.h>
+
+#ifdef CONFIG_POSIX_RESOLVER_CACHE
+
+/*
+ * Resolve @p host through /etc/hosts and the resolver cache.
+ *
+ * Returns false if the lookup cannot be served by the cache (e.g. numeric hosts, or flags that
+ * the cache does not implement), in which case the caller resolves it. Otherwise, the result of
+ * getaddrinfo() is stored in @p ret.
+ */
+bool posix_res_getaddrinfo(const char *host, const char *service, const struct addrinfo *hints,
+			   struct addrinfo **res, int *ret);
+
+/*
+ * Replace the numeric host in @p host with the name of @p addr, if one is known.
+ *
+ * Returns the result of getnameinfo().
+ */
+int posix_res_getnameinfo(const struct sockaddr *addr, char *host, socklen_t hostlen, int flags);
+
+#else
+
+static inline bool posix_res_getaddrinfo(const char *host, const char *service,
+					 const struct addrinfo *hints, struct addrinfo **res,
+					 int *ret)
+{
+	ARG_UNUSED(host);
+	ARG_UNUSED(service);
+	ARG_UNUSED(hints);
+	ARG_UNUSED(res);
+	ARG_UNUSED(ret);
+
+	return false;
+}
+
+static inline int posix_res_getnameinfo(const struct sockaddr *addr, char *host,
+					socklen_t hostlen, int flags)
+{
+	ARG_UNUSED(addr);
+	ARG_UNUSED(host);
+	ARG_UNUSED(hostlen);
+	ARG_UNUSED(flags);
+
+	return 0;
+}
+
+#endif
+
+#endif /* ZEPHYR_LIB_POSIX_OPTIONS_NETWORKING_RESOLVER_PRIV_H_ */
@@ -8,6 +8,7 @@
 
 #include "posix_clock.h"
 #include "posix_internal.h"
+#include "trace_priv.h"
 
 #include <pthread.h>
 #include <string.h>
@@ -19,25 +20,45 @@ LOG_MODULE_REGISTER(posix_non_portable, CONFIG_POSIX_NON_PORTABLE_LOG_LEVEL);
 
 int pthread_timedjoin_np(pthread_t pthread, void **status, const struct timespec *abstime)
 {
-	if (!timespec_is_valid(abstime)) {
+	int ret;
+	int more = 0;
+	k_timeout_t timeout = K_FOREVER;
+	struct k_thread *const k_thread = to_k_thread(&pthread);
+
+	if ((abstime != NULL) && !timespec_is_valid(abstime)) {
 		return EINVAL;
 	}
 
-	int ret = -k_thread_rejoin(
-		to_k_thread(&pthread), status,
-		(abstime == NULL) ? K_FOREVER
-				  : sys_timepoint_timeout(timespec_abs_rt_to_timepoint(abstime)));
+	sys_port_trace_posix_enter(PTHREAD_JOIN, k_thread,
+				   sys_trace_posix_abstime((int)CLOCK_REALTIME, abstime));
+
+	do {
+		if (abstime != NULL) {
+			more = timespec_to_clock_timeout((int)CLOCK_REALTIME, abstime, &timeout);
+		}
+
+		ret = -k_thread_rejoin(k_thread, status, timeout);
+	} while ((ret == EAGAIN) && (more > 0));
 
 	if ((ret == EAGAIN) || (ret == EBUSY)) {
 		ret = ETIMEDOUT;
 	}
 
+	sys_port_trace_posix_exit(PTHREAD_JOIN, k_thread, ret);
+
 	return ret;
 }
 
 int pthread_tryjoin_np(pthread_t pthread, void **status)
 {
-	return -k_thread_rejoin(to_k_thread(&pthread), status, K_NO_WAIT);
+	int ret;
+	struct k_thread *const k_thread = to_k_thread(&pthread);
+
+	sys_port_trace_posix_enter(PTHREAD_JOIN, k_thread, K_NO_WAIT);
+	ret = -k_thread_rejoin(k_thread, status, K_NO_WAIT);
+	sys_port_trace_posix_exit(PTHREAD_JOIN, k_thread, ret);
+
+	return ret;
 }
 
 int pthread_setname_np(pthread_t thread, const char *name)
@@ -5,9 +5,116 @@
  */
 
 #include "posix_internal.h"
+#include "sched_priv.h"
+#include "sporadic_priv.h"
 
-#include <zephyr/kernel.h>
+#include <errno.h>
 #include <sched.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/timeutil.h>
+#include <zephyr/sys/util.h>
+
+/*
+ * The application is the only process, so the scheduling policy and parameters of the process are
+ * those of its threads. Setting them applies them to every POSIX thread and to the calling thread,
+ * and threads created afterwards inherit them from their creator, unless created with
+ * PTHREAD_EXPLICIT_SCHED.
+ *
+ * SCHED_SPORADIC is only supported per thread, since the budget of a sporadic server is that of
+ * a single thread, so it can not be set for the process.
+ */
+
+static struct k_spinlock sched_lock;
+/* policy set with sched_setscheduler(), or -1 */
+static int sched_policy = -1;
+
+#ifdef CONFIG_TIMESLICE_PER_THREAD
+/* round-robin interval of each preemptible priority in ticks, or 0 for the system default */
+static int32_t rr_ticks[CONFIG_NUM_PREEMPT_PRIORITIES];
+#endif
+
+static bool is_this_process(pid_t pid)
+{
+#ifdef CONFIG_POSIX_MULTI_PROCESS
+	return (pid == 0) || (pid == getpid());
+#else
+	return pid == 0;
+#endif
+}
+
+/* round-robin interval of threads with Zephyr priority @p prio, in ticks */
+static int32_t rr_interval_ticks(int prio)
+{
+	int32_t ticks = 0;
+
+	if ((prio < 0) || (prio >= CONFIG_NUM_PREEMPT_PRIORITIES)) {
+		/* cooperative threads are never time sliced */
+		return 0;
+	}
+
+#ifdef CONFIG_TIMESLICE_PER_THREAD
+	K_SPINLOCK(&sched_lock) {
+		ticks = rr_ticks[prio];
+	}
+#endif
+
+#ifdef CONFIG_TIMESLICING
+	if ((ticks == 0) && (prio >= CONFIG_TIMESLICE_PRIORITY)) {
+		ticks = k_ms_to_ticks_ceil32(CONFIG_TIMESLICE_SIZE);
+	}
+#endif
+
+	return ticks;
+}
+
+void posix_sched_thread_update(struct k_thread *thread)
+{
+#ifdef CONFIG_TIMESLICE_PER_THREAD
+	int prio = k_thread_priority_get(thread);
+	int32_t ticks = 0;
+
+	if ((prio >= 0) && (prio < CONFIG_NUM_PREEMPT_PRIORITIES)) {
+		K_SPINLOCK(&sched_lock) {
+			ticks = rr_ticks[prio];
+		}
+	}
+
+	k_thread_time_slice_set(thread, ticks, NULL, NULL);
+#else
+	ARG_UNUSED(thread);
+#endif
+}
+
+static void sched_set_prio(const struct k_thread *cthread, void *arg)
+{
+	struct k_thread *thread = (struct k_thread *)cthread;
+
+	if (!IS_ENABLED(CONFIG_POSIX_THREADS) || !posix_is_pthread(thread)) {
+		return;
+	}
+
+	posix_sporadic_exit(thread);
+	k_thread_priority_set(thread, POINTER_TO_INT(arg));
+	posix_sched_thread_update(thread);
+}
+
+static void sched_set_interval(const struct k_thread *cthread, void *arg)
+{
+	struct sched_param param;
+	struct k_thread *thread = (struct k_thread *)cthread;
+
+	/* the time slice of a sporadic server is its remaining budget */
+	if (!IS_ENABLED(CONFIG_POSIX_THREADS) || !posix_is_pthread(thread) ||
+	    (k_thread_priority_get(thread) != POINTER_TO_INT(arg)) ||
+	    posix_sporadic_get(thread, &param)) {
+		return;
+	}
+
+	posix_sched_thread_update(thread);
+}
 
 int sched_get_priority_min(int policy)
 {
@@ -21,50 +128,155 @@ int sched_get_priority_max(int policy)
 
 int sched_getparam(pid_t pid, struct sched_param *param)
 {
-	ARG_UNUSED(pid);
-	ARG_UNUSED(param);
+	int policy;
 
-	errno = ENOSYS;
+	if (!is_this_process(pid)) {
+		errno = ESRCH;
+		return -1;
+	}
 
-	return -1;
+	if (param == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	*param = (struct sched_param){
+		.sched_priority =
+			zephyr_to_posix_priority(k_thread_priority_get(k_current_get()), &policy),
+	};
+
+	return 0;
 }
 
 int sched_getscheduler(pid_t pid)
 {
-	ARG_UNUSED(pid);
+	int policy = -1;
 
-	errno = ENOSYS;
+	if (!is_this_process(pid)) {
+		errno = ESRCH;
+		return -1;
+	}
 
-	return -1;
+	K_SPINLOCK(&sched_lock) {
+		policy = sched_policy;
+	}
+
+	if (policy < 0) {
+		(void)zephyr_to_posix_priority(k_thread_priority_get(k_current_get()), &policy);
+	}
+
+	return policy;
 }
 
 int sched_setparam(pid_t pid, const struct sched_param *param)
 {
-	ARG_UNUSED(pid);
-	ARG_UNUSED(param);
+	int policy;
 
-	errno = ENOSYS;
+	policy = sched_getscheduler(pid);
+	if (policy < 0) {
+		return -1;
+	}
 
-	return -1;
+	if (sched_setscheduler(pid, policy, param) < 0) {
+		return -1;
+	}
+
+	return 0;
 }
 
 int sched_setscheduler(pid_t pid, int policy, const struct sched_param *param)
 {
-	ARG_UNUSED(pid);
-	ARG_UNUSED(policy);
-	ARG_UNUSED(param);
+	int prio;
+	int old_policy;
+	struct k_thread *self = k_current_get();
 
-	errno = ENOSYS;
+	old_policy = sched_getscheduler(pid);
+	if (old_policy < 0) {
+		return -1;
+	}
 
-	return -1;
+	if ((param == NULL) || !valid_posix_policy(policy) || (policy == SCHED_SPORADIC) ||
+	    !is_posix_policy_prio_valid(param->sched_priority, policy)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	prio = posix_to_zephyr_priority(param->sched_priority, policy);
+
+	/* apply the change to all threads before any of them runs at its new priority */
+	k_sched_lock();
+	k_thread_foreach_unlocked(sched_set_prio, INT_TO_POINTER(prio));
+	if (!IS_ENABLED(CONFIG_POSIX_THREADS) || !posix_is_pthread(self)) {
+		k_thread_priority_set(self, prio);
+		posix_sched_thread_update(self);
+	}
+	K_SPINLOCK(&sched_lock) {
+		sched_policy = policy;
+	}
+	k_sched_unlock();
+
+	return old_policy;
 }
 
 int sched_rr_get_interval(pid_t pid, struct timespec *interval)
 {
-	ARG_UNUSED(pid);
+	if (!is_this_process(pid)) {
+		errno = ESRCH;
+		return -1;
+	}
+
+	if (interval == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	timespec_from_timeout(K_TICKS(rr_interval_ticks(k_thread_priority_get(k_current_get()))),
+			      interval);
+
+	return 0;
+}
+
+int sched_rr_get_interval_np(int priority, struct timespec *interval)
+{
+	if ((interval == NULL) || !is_posix_policy_prio_valid(priority, SCHED_RR)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	timespec_from_timeout(K_TICKS(rr_interval_ticks(posix_to_zephyr_priority(priority, SCHED_RR))),
+			      interval);
+
+	return 0;
+}
+
+int sched_rr_set_interval_np(int priority, const struct timespec *interval)
+{
+#ifdef CONFIG_TIMESLICE_PER_THREAD
+	int prio;
+	k_ticks_t ticks;
+
+	if ((interval == NULL) || !timespec_is_valid(interval) ||
+	    !is_posix_policy_prio_valid(priority, SCHED_RR)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	ticks = timespec_to_timeout(interval, NULL).ticks;
+	prio = posix_to_zephyr_priority(priority, SCHED_RR);
+
+	K_SPINLOCK(&sched_lock) {
+		rr_ticks[prio] = (int32_t)CLAMP(ticks, 0, INT32_MAX);
+	}
+
+	k_thread_foreach_unlocked(sched_set_interval, INT_TO_POINTER(prio));
+
+	return 0;
+#else
+	ARG_UNUSED(priority);
 	ARG_UNUSED(interval);
 
-	errno = ENOSYS;
+	errno = ENOTSUP;
 
 	return -1;
+#endif
 }
@@ -4,7 +4,10 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "percpu_priv.h"
 #include "posix_internal.h"
+#include "sig_wake_priv.h"
+#include "trace_priv.h"
 
 #include <errno.h>
 #include <signal.h>
@@ -30,7 +33,8 @@ static void kinfo_to_siginfo(siginfo_t *dst, const struct k_sig_info *src)
 	*dst = (siginfo_t){0};
 	dst->si_signo = ksigno_to_posix(src->signo);
 	dst->si_code = src->code;
-	dst->si_value.sival_int = src->value.sival_int;
+	/* the pointer is the larger member, so this also copies an integer value */
+	dst->si_value.sival_ptr = src->value.sival_ptr;
 }
 
 int sigqueue(pid_t pid, int signo, union sigval value)
@@ -38,7 +42,7 @@ int sigqueue(pid_t pid, int signo, union sigval value)
 	pthread_t th = (pthread_t)(uintptr_t)pid;
 	struct k_thread *tid = to_k_thread(&th);
 	union k_sig_val val = {
-		.sival_int = value.sival_int,
+		.sival_ptr = value.sival_ptr,
 	};
 	int ret;
 
@@ -64,12 +68,15 @@ int sigqueue(pid_t pid, int signo, union sigval value)
 		return -1;
 	}
 
-	ret = k_sig_queue((k_pid_t)tid, signo, val);
+	ret = posix_sig_queue(tid, signo, val);
+	sys_port_trace_posix_call(SIGQUEUE, tid, -ret);
 	if (ret < 0) {
 		errno = -ret;
 		return -1;
 	}
 
+	posix_stat_inc(POSIX_STAT_SIG_SENT);
+
 	return 0;
 }
 
@@ -113,7 +120,9 @@ int sigtimedwait(const sigset_t *ZRESTRICT set, siginfo_t *ZRESTRICT info,
 	}
 
 	kset = z_sig_set_from_posix(set, &kset_buf);
+	sys_port_trace_posix_enter(SIGWAIT, k_current_get(), to);
 	ret = sigwait_poll(kset, info != NULL ? &kinfo : NULL, to);
+	sys_port_trace_posix_exit(SIGWAIT, k_current_get(), (ret < 0) ? -ret : 0);
 	if (ret < 0) {
 		errno = -ret;
 		return -1;
@@ -139,7 +148,9 @@ int sigwaitinfo(const sigset_t *ZRESTRICT set, siginfo_t *ZRESTRICT info)
 	}
 
 	kset = z_sig_set_from_posix(set, &kset_buf);
+	sys_port_trace_posix_enter(SIGWAIT, k_current_get(), K_FOREVER);
 	ret = sigwait_poll(kset, info != NULL ? &kinfo : NULL, K_FOREVER);
+	sys_port_trace_posix_exit(SIGWAIT, k_current_get(), (ret < 0) ? -ret : 0);
 	if (ret < 0) {
 		errno = -ret;
 		return -1;
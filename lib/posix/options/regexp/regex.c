@@ -0,0 +1,1705 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * POSIX Basic and Extended Regular Expressions.
+ *
+ * regcomp() parses the pattern into a syntax tree and compiles it into a Thompson NFA, once in
+ * the forward direction and once reversed. regexec() never backtracks. It simulates the NFA with
+ * DFAs built lazily, one state per set of NFA instructions, and cached in a buffer of fixed size
+ * that is flushed when full. Every character of the string then costs one table lookup when the
+ * transition is cached, and at most O(NFA size) when it is not, so matching is linear in the
+ * length of the string and its memory is bounded when the regular expression is compiled.
+ *
+ * The leftmost-longest match is found with up to three passes over the string:
+ * - the forward DFA, unanchored, only tells whether the string matches (for REG_NOSUB),
+ * - the reversed DFA, unanchored, scans from the end and finds the leftmost start of a match,
+ * - the forward DFA, anchored at that start, finds the longest match.
+ * Subexpressions are then located within that match with a Pike VM over the forward NFA, which
+ * prefers the first alternative and the longest repetition.
+ *
+ * Back-references cannot be matched by a finite automaton, so regcomp() rejects them.
+ */
+
+#include <ctype.h>
+#include <limits.h>
+#include <regex.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#define EOS '\0'
+
+/* height of the syntax tree, which bounds the recursion of regcomp() */
+#define RE_DEPTH_MAX 64
+
+#define RE_DUP_MAX_ _POSIX_RE_DUP_MAX
+
+#define RE_INST_MAX    CONFIG_POSIX_REGEXP_INST_MAX
+#define RE_CACHE_SIZE  ROUND_DOWN(CONFIG_POSIX_REGEXP_DFA_CACHE_SIZE, sizeof(uint32_t))
+#define RE_NO_PC       UINT16_MAX
+#define RE_NO_SLOT     UINT16_MAX
+#define RE_DS_NONE     (-1)
+
+#define RE_MATCH_NOW    BIT(0)
+#define RE_MATCH_AT_END BIT(1)
+
+enum re_op {
+	RE_CHAR,  /* consume c */
+	RE_SET,   /* consume a character of sets[x] */
+	RE_SPLIT, /* continue at x, then at y */
+	RE_JMP,   /* continue at x */
+	RE_SAVE,  /* record the position in capture slot x */
+	RE_BEGIN, /* the previous character, in the direction of the scan, ends a line */
+	RE_END,   /* the next character, in the direction of the scan, ends a line */
+	RE_MATCH,
+};
+
+struct re_inst {
+	uint8_t op;
+	uint8_t c;
+	uint16_t x;
+	uint16_t y;
+};
+
+enum re_type {
+	RE_N_CHAR,
+	RE_N_SET,
+	RE_N_BOL,
+	RE_N_EOL,
+	RE_N_CAT,
+	RE_N_ALT,
+	RE_N_REPEAT,
+	RE_N_GROUP,
+};
+
+struct re_node {
+	struct re_node *child;
+	/* last child of RE_N_CAT and RE_N_ALT */
+	struct re_node *last;
+	struct re_node *next;
+	struct re_node *prev;
+	uint8_t type;
+	uint8_t c;
+	uint8_t height;
+	/* set of RE_N_SET, or subexpression of RE_N_GROUP */
+	uint16_t n;
+	int16_t min;
+	/* -1 for a repetition without an upper bound */
+	int16_t max;
+};
+
+/* position of an atom in its concatenation */
+enum re_pos {
+	RE_POS_START,
+	RE_POS_AFTER_BOL,
+	RE_POS_INNER,
+};
+
+typedef uint32_t re_set_t[(UINT8_MAX + 1) / 32];
+
+struct re_parser {
+	const char *p;
+	int cflags;
+	int err;
+	int depth;
+	size_t nsub;
+	struct re_node *nodes;
+	size_t nnodes;
+	size_t maxnodes;
+	re_set_t *sets;
+	size_t nsets;
+};
+
+/* A DFA state, followed in the cache by its transitions and its sorted NFA instructions */
+struct re_dstate {
+	uint32_t hash;
+	uint16_t npc;
+	/* whether the state was entered at the start of a line */
+	uint8_t begin;
+	uint8_t match;
+	/* offset of the next state in the cache, for each character class */
+	int32_t next[];
+};
+
+struct re_dfa {
+	const struct re_inst *prog;
+	bool unanchored;
+	size_t used;
+	int32_t start[2];
+	uint8_t *cache;
+	uint32_t *visited;
+	uint16_t *stack;
+	uint16_t *list;
+};
+
+enum {
+	RE_DFA_SEARCH,
+	RE_DFA_REVERSE,
+	RE_DFA_LONGEST,
+	RE_DFA_COUNT,
+};
+
+struct re_prog {
+	struct k_mutex lock;
+	int cflags;
+	uint16_t ninst;
+	uint16_t nconsume;
+	uint16_t nclasses;
+	uint8_t classes[UINT8_MAX + 1];
+	struct re_inst *fwd;
+	struct re_inst *rev;
+	re_set_t *sets;
+	struct re_dfa *dfa[RE_DFA_COUNT];
+};
+
+struct re_pike_entry {
+	uint16_t pc;
+	uint16_t slot;
+	regoff_t val;
+};
+
+struct re_pike_list {
+	size_t n;
+	uint16_t *pc;
+	regoff_t *caps;
+};
+
+struct re_pike {
+	const struct re_prog *re;
+	const char *s;
+	size_t len;
+	int eflags;
+	size_t ncap;
+	uint32_t *visited;
+	struct re_pike_entry *stack;
+	regoff_t *work;
+	struct re_pike_list list[2];
+};
+
+static inline void re_set_add(uint32_t *set, uint8_t c)
+{
+	set[c / 32] |= BIT(c % 32);
+}
+
+static inline bool re_set_has(const uint32_t *set, uint8_t c)
+{
+	return (set[c / 32] & BIT(c % 32)) != 0;
+}
+
+static inline bool re_ere(const struct re_parser *ps)
+{
+	return (ps->cflags & REG_EXTENDED) != 0;
+}
+
+/*
+ * Syntax tree
+ */
+
+static struct re_node *re_node_new(struct re_parser *ps, uint8_t type)
+{
+	struct re_node *node;
+
+	if (ps->nnodes == ps->maxnodes) {
+		ps->err = REG_ESPACE;
+		return NULL;
+	}
+
+	node = &ps->nodes[ps->nnodes++];
+	*node = (struct re_node){
+		.type = type,
+		.height = 1,
+	};
+
+	return node;
+}
+
+static void re_node_append(struct re_node *parent, struct re_node *child)
+{
+	child->prev = parent->last;
+	if (parent->last == NULL) {
+		parent->child = child;
+	} else {
+		parent->last->next = child;
+	}
+	parent->last = child;
+}
+
+/* Compute the height of a node from that of its children */
+static struct re_node *re_node_done(struct re_parser *ps, struct re_node *node)
+{
+	uint8_t height = 0;
+
+	for (struct re_node *child = node->child; child != NULL; child = child->next) {
+		height = MAX(height, child->height);
+	}
+
+	if (height >= RE_DEPTH_MAX) {
+		ps->err = REG_ESPACE;
+		return NULL;
+	}
+
+	node->height = height + 1;
+
+	return node;
+}
+
+static struct re_node *re_node_set(struct re_parser *ps, uint32_t **set)
+{
+	re_set_t *sets;
+	struct re_node *node;
+
+	if (ps->nsets == UINT16_MAX) {
+		ps->err = REG_ESPACE;
+		return NULL;
+	}
+
+	node = re_node_new(ps, RE_N_SET);
+	if (node == NULL) {
+		return NULL;
+	}
+
+	sets = realloc(ps->sets, (ps->nsets + 1) * sizeof(*sets));
+	if (sets == NULL) {
+		ps->err = REG_ESPACE;
+		return NULL;
+	}
+
+	ps->sets = sets;
+	node->n = ps->nsets++;
+	*set = sets[node->n];
+	memset(*set, 0, sizeof(re_set_t));
+
+	return node;
+}
+
+static struct re_node *re_node_char(struct re_parser *ps, char c)
+{
+	uint32_t *set;
+	struct re_node *node;
+	const unsigned char uc = c;
+
+	if (((ps->cflags & REG_ICASE) != 0) && isalpha(uc)) {
+		node = re_node_set(ps, &set);
+		if (node != NULL) {
+			re_set_add(set, tolower(uc));
+			re_set_add(set, toupper(uc));
+		}
+		return node;
+	}
+
+	node = re_node_new(ps, RE_N_CHAR);
+	if (node != NULL) {
+		node->c = uc;
+	}
+
+	return node;
+}
+
+/*
+ * Parser
+ */
+
+static const char *const re_ctype_names[] = {
+	"alnum", "alpha", "blank", "cntrl", "digit", "graph",
+	"lower", "print", "punct", "space", "upper", "xdigit",
+};
+
+static bool re_ctype(size_t i, int c)
+{
+	switch (i) {
+	case 0:
+		return isalnum(c) != 0;
+	case 1:
+		return isalpha(c) != 0;
+	case 2:
+		return isblank(c) != 0;
+	case 3:
+		return iscntrl(c) != 0;
+	case 4:
+		return isdigit(c) != 0;
+	case 5:
+		return isgraph(c) != 0;
+	case 6:
+		return islower(c) != 0;
+	case 7:
+		return isprint(c) != 0;
+	case 8:
+		return ispunct(c) != 0;
+	case 9:
+		return isspace(c) != 0;
+	case 10:
+		return isupper(c) != 0;
+	case 11:
+		return isxdigit(c) != 0;
+	default:
+		return false;
+	}
+}
+
+/* Parse a character, collating symbol "[.c.]" or equivalence class "[=c=]" of a bracket */
+static int re_parse_bracket_char(const char **pp, int *c)
+{
+	const char *end;
+	const char *p = *pp;
+
+	if ((p[0] == '[') && ((p[1] == '.') || (p[1] == '='))) {
+		const char term[] = {p[1], ']', EOS};
+
+		end = strstr(&p[2], term);
+		if (end == NULL) {
+			return REG_EBRACK;
+		}
+
+		/* only single characters are collating elements in the POSIX locale */
+		if (end != &p[3]) {
+			return REG_ECOLLATE;
+		}
+
+		*c = (unsigned char)p[2];
+		*pp = end + 2;
+		return 0;
+	}
+
+	*c = (unsigned char)p[0];
+	*pp = p + 1;
+
+	return 0;
+}
+
+/* Parse a bracket expression, after its '[' */
+static int re_parse_bracket(struct re_parser *ps, uint32_t *set)
+{
+	int rc;
+	int lo;
+	int hi;
+	size_t i;
+	const char *end;
+	bool negate = false;
+	const char *p = ps->p;
+	const char *const first = (*p == '^') ? (p + 1) : p;
+
+	if (*p == '^') {
+		negate = true;
+		++p;
+	}
+
+	while (true) {
+		if (*p == EOS) {
+			return REG_EBRACK;
+		}
+
+		/* a ']' first in the list is an ordinary character */
+		if ((*p == ']') && (p != first)) {
+			++p;
+			break;
+		}
+
+		if ((p[0] == '[') && (p[1] == ':')) {
+			end = strstr(&p[2], ":]");
+			if (end == NULL) {
+				return REG_EBRACK;
+			}
+
+			for (i = 0; i < ARRAY_SIZE(re_ctype_names); ++i) {
+				if ((strlen(re_ctype_names[i]) == (size_t)(end - &p[2])) &&
+				    (strncmp(re_ctype_names[i], &p[2], end - &p[2]) == 0)) {
+					break;
+				}
+			}
+
+			if (i == ARRAY_SIZE(re_ctype_names)) {
+				return REG_ECTYPE;
+			}
+
+			for (int c = 1; c <= UINT8_MAX; ++c) {
+				if (re_ctype(i, c)) {
+					re_set_add(set, c);
+				}
+			}
+
+			p = end + 2;
+			if ((p[0] == '-') && (p[1] != ']')) {
+				/* a character class cannot start a range */
+				return REG_ERANGE;
+			}
+			continue;
+		}
+
+		rc = re_parse_bracket_char(&p, &lo);
+		if (rc != 0) {
+			return rc;
+		}
+
+		hi = lo;
+		if ((p[0] == '-') && (p[1] != ']') && (p[1] != EOS)) {
+			++p;
+			if ((p[0] == '[') && (p[1] == ':')) {
+				return REG_ERANGE;
+			}
+
+			rc = re_parse_bracket_char(&p, &hi);
+			if (rc != 0) {
+				return rc;
+			}
+
+			if (hi < lo) {
+				return REG_ERANGE;
+			}
+		}
+
+		for (int c = lo; c <= hi; ++c) {
+			re_set_add(set, c);
+		}
+	}
+
+	ps->p = p;
+
+	if ((ps->cflags & REG_ICASE) != 0) {
+		for (int c = 1; c <= UINT8_MAX; ++c) {
+			if (re_set_has(set, c) && isalpha(c)) {
+				re_set_add(set, tolower(c));
+				re_set_add(set, toupper(c));
+			}
+		}
+	}
+
+	if (negate) {
+		for (i = 0; i < ARRAY_SIZE((re_set_t){0}); ++i) {
+			set[i] = ~set[i];
+		}
+
+		/* a newline only matches a non-matching list without REG_NEWLINE */
+		if ((ps->cflags & REG_NEWLINE) != 0) {
+			set['\n' / 32] &= ~BIT('\n' % 32);
+		}
+	}
+
+	/* the end of the string is never matched */
+	set[0] &= ~BIT(0);
+
+	return 0;
+}
+
+static int re_parse_int(struct re_parser *ps)
+{
+	int n = 0;
+
+	while (isdigit((unsigned char)*ps->p)) {
+		n = MIN(10 * n + (*ps->p - '0'), RE_DUP_MAX_ + 1);
+		++ps->p;
+	}
+
+	return n;
+}
+
+/* Parse an interval expression "{m}", "{m,}" or "{m,n}", after its opening brace */
+static int re_parse_interval(struct re_parser *ps, int16_t *min, int16_t *max)
+{
+	int n;
+
+	if (!isdigit((unsigned char)*ps->p)) {
+		return (*ps->p == EOS) ? REG_EBRACE : REG_BADBR;
+	}
+
+	n = re_parse_int(ps);
+	*min = n;
+	*max = n;
+
+	if (*ps->p == ',') {
+		++ps->p;
+		*max = isdigit((unsigned char)*ps->p) ? re_parse_int(ps) : -1;
+	}
+
+	if (re_ere(ps) && (ps->p[0] == '}')) {
+		ps->p += 1;
+	} else if (!re_ere(ps) && (ps->p[0] == '\\') && (ps->p[1] == '}')) {
+		ps->p += 2;
+	} else if ((ps->p[0] == EOS) || ((ps->p[0] == '\\') && (ps->p[1] == EOS))) {
+		return REG_EBRACE;
+	} else {
+		return REG_BADBR;
+	}
+
+	if ((*min > RE_DUP_MAX_) || (*max > RE_DUP_MAX_) || ((*max >= 0) && (*max < *min))) {
+		return REG_BADBR;
+	}
+
+	return 0;
+}
+
+static struct re_node *re_parse_alt(struct re_parser *ps);
+
+static struct re_node *re_parse_group(struct re_parser *ps)
+{
+	struct re_node *node;
+
+	if ((++ps->depth > RE_DEPTH_MAX / 4) || (ps->nsub == UINT16_MAX / 2 - 1)) {
+		ps->err = REG_ESPACE;
+		return NULL;
+	}
+
+	node = re_node_new(ps, RE_N_GROUP);
+	if (node == NULL) {
+		return NULL;
+	}
+
+	/* subexpressions are numbered by the position of their opening parenthesis */
+	node->n = ++ps->nsub;
+	node->child = re_parse_alt(ps);
+	if (node->child == NULL) {
+		return NULL;
+	}
+
+	if (re_ere(ps) && (ps->p[0] == ')')) {
+		ps->p += 1;
+	} else if (!re_ere(ps) && (ps->p[0] == '\\') && (ps->p[1] == ')')) {
+		ps->p += 2;
+	} else {
+		ps->err = REG_EPAREN;
+		return NULL;
+	}
+
+	--ps->depth;
+
+	return re_node_done(ps, node);
+}
+
+/*
+ * Parse an atom at position pos of its concatenation. In a BRE, '^' is an anchor only at the
+ * start, and '*' is an ordinary character at the start or after that anchor.
+ */
+static struct re_node *re_parse_atom(struct re_parser *ps, enum re_pos pos)
+{
+	uint32_t *set;
+	struct re_node *node;
+	const char c = *ps->p;
+	const bool ere = re_ere(ps);
+
+	switch (c) {
+	case '.':
+		++ps->p;
+		node = re_node_set(ps, &set);
+		if (node != NULL) {
+			memset(set, 0xff, sizeof(re_set_t));
+			set[0] &= ~BIT(0);
+			if ((ps->cflags & REG_NEWLINE) != 0) {
+				set['\n' / 32] &= ~BIT('\n' % 32);
+			}
+		}
+		return node;
+	case '[':
+		++ps->p;
+		node = re_node_set(ps, &set);
+		if (node != NULL) {
+			ps->err = re_parse_bracket(ps, set);
+		}
+		return (ps->err == 0) ? node : NULL;
+	case '^':
+		if (ere || (pos == RE_POS_START)) {
+			++ps->p;
+			return re_node_new(ps, RE_N_BOL);
+		}
+		break;
+	case '$':
+		/* in a BRE, '$' is an anchor at the end of the RE or of a subexpression */
+		if (ere || (ps->p[1] == EOS) ||
+		    ((ps->depth > 0) && (ps->p[1] == '\\') && (ps->p[2] == ')'))) {
+			++ps->p;
+			return re_node_new(ps, RE_N_EOL);
+		}
+		break;
+	case '*':
+	case '+':
+	case '?':
+	case '{':
+		if (ere) {
+			ps->err = REG_BADRPT;
+			return NULL;
+		}
+		break;
+	case '(':
+		if (ere) {
+			++ps->p;
+			return re_parse_group(ps);
+		}
+		break;
+	case '\\':
+		switch (ps->p[1]) {
+		case EOS:
+			ps->err = REG_EESCAPE;
+			return NULL;
+		case '(':
+			if (!ere) {
+				ps->p += 2;
+				return re_parse_group(ps);
+			}
+			break;
+		case ')':
+			if (!ere) {
+				ps->err = REG_EPAREN;
+				return NULL;
+			}
+			break;
+		case '{':
+			if (!ere) {
+				ps->err = REG_BADRPT;
+				return NULL;
+			}
+			break;
+		case '1' ... '9':
+			/* back-references cannot be matched by a finite automaton */
+			ps->err = REG_ESUBREG;
+			return NULL;
+		default:
+			break;
+		}
+
+		ps->p += 2;
+		return re_node_char(ps, ps->p[-1]);
+	default:
+		break;
+	}
+
+	++ps->p;
+	return re_node_char(ps, c);
+}
+
+static struct re_node *re_parse_repeat(struct re_parser *ps, enum re_pos pos)
+{
+	int16_t min;
+	int16_t max;
+	const char *start;
+	struct re_node *rep;
+	struct re_node *node = re_parse_atom(ps, pos);
+
+	while (node != NULL) {
+		start = ps->p;
+		if (ps->p[0] == '*') {
+			ps->p += 1;
+			min = 0;
+			max = -1;
+		} else if (re_ere(ps) && (ps->p[0] == '+')) {
+			ps->p += 1;
+			min = 1;
+			max = -1;
+		} else if (re_ere(ps) && (ps->p[0] == '?')) {
+			ps->p += 1;
+			min = 0;
+			max = 1;
+		} else if ((re_ere(ps) && (ps->p[0] == '{')) ||
+			   (!re_ere(ps) && (ps->p[0] == '\\') && (ps->p[1] == '{'))) {
+			ps->p += re_ere(ps) ? 1 : 2;
+			ps->err = re_parse_interval(ps, &min, &max);
+			if (ps->err != 0) {
+				return NULL;
+			}
+		} else {
+			break;
+		}
+
+		if (node->type == RE_N_BOL) {
+			/* in a BRE, the '*' is an ordinary character after a leading '^' */
+			ps->err = re_ere(ps) ? REG_BADRPT : 0;
+			ps->p = start;
+			return re_ere(ps) ? NULL : node;
+		}
+
+		rep = re_node_new(ps, RE_N_REPEAT);
+		if (rep == NULL) {
+			return NULL;
+		}
+
+		rep->child = node;
+		rep->min = min;
+		rep->max = max;
+		node = re_node_done(ps, rep);
+	}
+
+	return node;
+}
+
+static struct re_node *re_parse_cat(struct re_parser *ps)
+{
+	char c;
+	enum re_pos pos = RE_POS_START;
+	struct re_node *node;
+	struct re_node *cat = re_node_new(ps, RE_N_CAT);
+
+	while ((cat != NULL) && (ps->err == 0)) {
+		c = ps->p[0];
+		if ((c == EOS) ||
+		    (re_ere(ps) && ((c == '|') || ((c == ')') && (ps->depth > 0)))) ||
+		    (!re_ere(ps) && (c == '\\') && (ps->p[1] == ')') && (ps->depth > 0))) {
+			break;
+		}
+
+		node = re_parse_repeat(ps, pos);
+		if (node == NULL) {
+			return NULL;
+		}
+
+		pos = ((pos == RE_POS_START) && (node->type == RE_N_BOL)) ? RE_POS_AFTER_BOL
+									    : RE_POS_INNER;
+		re_node_append(cat, node);
+	}
+
+	return (ps->err == 0) ? re_node_done(ps, cat) : NULL;
+}
+
+static struct re_node *re_parse_alt(struct re_parser *ps)
+{
+	struct re_node *alt;
+	struct re_node *node = re_parse_cat(ps);
+
+	if ((node == NULL) || (ps->p[0] != '|') || !re_ere(ps)) {
+		return node;
+	}
+
+	alt = re_node_new(ps, RE_N_ALT);
+	if (alt == NULL) {
+		return NULL;
+	}
+
+	re_node_append(alt, node);
+	while (ps->p[0] == '|') {
+		++ps->p;
+		node = re_parse_cat(ps);
+		if (node == NULL) {
+			return NULL;
+		}
+		re_node_append(alt, node);
+	}
+
+	return re_node_done(ps, alt);
+}
+
+/*
+ * Compiler
+ */
+
+/* Number of instructions of a node, or RE_INST_MAX + 1 if that is too many */
+static size_t re_size(const struct re_node *node)
+{
+	size_t sub;
+	size_t size = 0;
+	const size_t over = RE_INST_MAX + 1;
+
+	switch (node->type) {
+	case RE_N_CAT:
+		for (struct re_node *child = node->child; child != NULL; child = child->next) {
+			size = MIN(size + re_size(child), over);
+		}
+		break;
+	case RE_N_ALT:
+		/* a split and a jump for every alternative but the last */
+		for (struct re_node *child = node->child; child != NULL; child = child->next) {
+			size = MIN(size + re_size(child) + 2, over);
+		}
+		size -= 2;
+		break;
+	case RE_N_GROUP:
+		size = re_size(node->child) + 2;
+		break;
+	case RE_N_REPEAT:
+		sub = re_size(node->child);
+		if ((node->max < 0) && (node->min == 0)) {
+			size = sub + 2;
+		} else if (node->max < 0) {
+			size = node->min * sub + 1;
+		} else {
+			size = node->min * sub + (node->max - node->min) * (sub + 1);
+		}
+		break;
+	default:
+		size = 1;
+		break;
+	}
+
+	return MIN(size, over);
+}
+
+struct re_emitter {
+	struct re_inst *prog;
+	uint16_t pc;
+	bool reverse;
+};
+
+static uint16_t re_put(struct re_emitter *em, uint8_t op, uint8_t c, uint16_t x, uint16_t y)
+{
+	em->prog[em->pc] = (struct re_inst){
+		.op = op,
+		.c = c,
+		.x = x,
+		.y = y,
+	};
+
+	return em->pc++;
+}
+
+/* Point the chain of instructions linked through their y (or x) at the current instruction */
+static void re_patch(struct re_emitter *em, uint16_t chain, bool x)
+{
+	uint16_t next;
+
+	while (chain != RE_NO_PC) {
+		if (x) {
+			next = em->prog[chain].x;
+			em->prog[chain].x = em->pc;
+		} else {
+			next = em->prog[chain].y;
+			em->prog[chain].y = em->pc;
+		}
+		chain = next;
+	}
+}
+
+static void re_emit(struct re_emitter *em, const struct re_node *node)
+{
+	uint16_t pc;
+	uint16_t chain = RE_NO_PC;
+
+	switch (node->type) {
+	case RE_N_CHAR:
+		(void)re_put(em, RE_CHAR, node->c, 0, 0);
+		break;
+	case RE_N_SET:
+		(void)re_put(em, RE_SET, 0, node->n, 0);
+		break;
+	case RE_N_BOL:
+		(void)re_put(em, em->reverse ? RE_END : RE_BEGIN, 0, 0, 0);
+		break;
+	case RE_N_EOL:
+		(void)re_put(em, em->reverse ? RE_BEGIN : RE_END, 0, 0, 0);
+		break;
+	case RE_N_CAT:
+		if (em->reverse) {
+			for (struct re_node *child = node->last; child != NULL;
+			     child = child->prev) {
+				re_emit(em, child);
+			}
+		} else {
+			for (struct re_node *child = node->child; child != NULL;
+			     child = child->next) {
+				re_emit(em, child);
+			}
+		}
+		break;
+	case RE_N_ALT:
+		/* split to each alternative in order, and jump from each to the end */
+		for (struct re_node *child = node->child; child != NULL; child = child->next) {
+			if (child->next == NULL) {
+				re_emit(em, child);
+				break;
+			}
+
+			pc = re_put(em, RE_SPLIT, 0, em->pc + 1, 0);
+			re_emit(em, child);
+			chain = re_put(em, RE_JMP, 0, chain, 0);
+			em->prog[pc].y = em->pc;
+		}
+		re_patch(em, chain, true);
+		break;
+	case RE_N_GROUP:
+		(void)re_put(em, RE_SAVE, 0, 2 * node->n + (em->reverse ? 1 : 0), 0);
+		re_emit(em, node->child);
+		(void)re_put(em, RE_SAVE, 0, 2 * node->n + (em->reverse ? 0 : 1), 0);
+		break;
+	case RE_N_REPEAT:
+		if ((node->max < 0) && (node->min == 0)) {
+			pc = re_put(em, RE_SPLIT, 0, em->pc + 1, 0);
+			re_emit(em, node->child);
+			(void)re_put(em, RE_JMP, 0, pc, 0);
+			em->prog[pc].y = em->pc;
+			break;
+		}
+
+		pc = em->pc;
+		for (int i = 0; i < node->min; ++i) {
+			pc = em->pc;
+			re_emit(em, node->child);
+		}
+
+		if (node->max < 0) {
+			/* repeat the last copy */
+			(void)re_put(em, RE_SPLIT, 0, pc, em->pc + 1);
+			break;
+		}
+
+		/* each optional copy skips all the following ones */
+		for (int i = node->min; i < node->max; ++i) {
+			chain = re_put(em, RE_SPLIT, 0, em->pc + 1, chain);
+			re_emit(em, node->child);
+		}
+		re_patch(em, chain, false);
+		break;
+	default:
+		break;
+	}
+}
+
+/* Split the characters into classes that every instruction matches alike */
+static void re_classes(struct re_prog *re)
+{
+	uint8_t class = 0;
+	re_set_t bounds = {0};
+
+	re_set_add(bounds, 1);
+	re_set_add(bounds, '\n');
+	re_set_add(bounds, '\n' + 1);
+
+	for (uint16_t pc = 0; pc < re->ninst; ++pc) {
+		const struct re_inst *inst = &re->fwd[pc];
+
+		if (inst->op == RE_CHAR) {
+			re_set_add(bounds, inst->c);
+			if (inst->c < UINT8_MAX) {
+				re_set_add(bounds, inst->c + 1);
+			}
+		} else if (inst->op == RE_SET) {
+			for (int c = 1; c <= UINT8_MAX; ++c) {
+				if (re_set_has(re->sets[inst->x], c) !=
+				    re_set_has(re->sets[inst->x], c - 1)) {
+					re_set_add(bounds, c);
+				}
+			}
+		}
+	}
+
+	re->classes[0] = 0;
+	for (int c = 1; c <= UINT8_MAX; ++c) {
+		if (re_set_has(bounds, c)) {
+			++class;
+		}
+		re->classes[c] = class;
+	}
+	re->nclasses = class + 1;
+}
+
+static inline bool re_consumes(const struct re_prog *re, const struct re_inst *inst, uint8_t c)
+{
+	switch (inst->op) {
+	case RE_CHAR:
+		return inst->c == c;
+	case RE_SET:
+		return re_set_has(re->sets[inst->x], c);
+	default:
+		return false;
+	}
+}
+
+/*
+ * Lazy DFA
+ */
+
+static inline size_t re_dstate_size(const struct re_prog *re, size_t npc)
+{
+	return ROUND_UP(sizeof(struct re_dstate) + re->nclasses * sizeof(int32_t) +
+				npc * sizeof(uint16_t),
+			sizeof(uint32_t));
+}
+
+static inline struct re_dstate *re_dstate(const struct re_dfa *d, int32_t off)
+{
+	return (struct re_dstate *)&d->cache[off];
+}
+
+static inline uint16_t *re_dstate_pcs(const struct re_prog *re, struct re_dstate *ds)
+{
+	return (uint16_t *)&ds->next[re->nclasses];
+}
+
+static inline bool re_visit(uint32_t *visited, uint16_t pc)
+{
+	if ((visited[pc / 32] & BIT(pc % 32)) != 0) {
+		return false;
+	}
+
+	visited[pc / 32] |= BIT(pc % 32);
+
+	return true;
+}
+
+/* Mark the instructions reachable from pc without consuming a character */
+static void re_dfa_closure(struct re_dfa *d, uint16_t pc, bool begin, bool end)
+{
+	size_t sp = 0;
+	const struct re_inst *inst;
+
+	if (re_visit(d->visited, pc)) {
+		d->stack[sp++] = pc;
+	}
+
+	while (sp > 0) {
+		pc = d->stack[--sp];
+		inst = &d->prog[pc];
+
+		switch (inst->op) {
+		case RE_SPLIT:
+			if (re_visit(d->visited, inst->y)) {
+				d->stack[sp++] = inst->y;
+			}
+			__fallthrough;
+		case RE_JMP:
+			if (re_visit(d->visited, inst->x)) {
+				d->stack[sp++] = inst->x;
+			}
+			break;
+		case RE_BEGIN:
+			if (!begin) {
+				break;
+			}
+			__fallthrough;
+		case RE_SAVE:
+			if (re_visit(d->visited, pc + 1)) {
+				d->stack[sp++] = pc + 1;
+			}
+			break;
+		case RE_END:
+			/* kept in the state until the next character is known */
+			if (end && re_visit(d->visited, pc + 1)) {
+				d->stack[sp++] = pc + 1;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+/* Move the marked instructions that make up a state to d->list, in order */
+static uint16_t re_dfa_collect(const struct re_prog *re, struct re_dfa *d)
+{
+	uint16_t pc;
+	uint32_t bits;
+	uint16_t n = 0;
+
+	for (size_t w = 0; w < DIV_ROUND_UP((size_t)re->ninst, 32); ++w) {
+		bits = d->visited[w];
+		d->visited[w] = 0;
+
+		while (bits != 0) {
+			pc = 32 * w + find_lsb_set(bits) - 1;
+			bits &= bits - 1;
+
+			switch (d->prog[pc].op) {
+			case RE_CHAR:
+			case RE_SET:
+			case RE_END:
+			case RE_MATCH:
+				d->list[n++] = pc;
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	return n;
+}
+
+/* Find or add the state of the n instructions of d->list */
+static int32_t re_dfa_state(const struct re_prog *re, struct re_dfa *d, uint16_t n, bool begin,
+			    bool *flushed)
+{
+	int32_t off;
+	size_t size;
+	uint32_t hash = 2166136261U ^ begin;
+	struct re_dstate *ds;
+	const uint16_t match = re->ninst - 1;
+
+	for (uint16_t i = 0; i < n; ++i) {
+		hash = (hash ^ d->list[i]) * 16777619U;
+	}
+
+	for (off = 0; (size_t)off < d->used; off += re_dstate_size(re, ds->npc)) {
+		ds = re_dstate(d, off);
+		if ((ds->hash == hash) && (ds->npc == n) && (ds->begin == begin) &&
+		    (memcmp(re_dstate_pcs(re, ds), d->list, n * sizeof(uint16_t)) == 0)) {
+			return off;
+		}
+	}
+
+	size = re_dstate_size(re, n);
+	if (d->used + size > RE_CACHE_SIZE) {
+		d->used = 0;
+		d->start[0] = RE_DS_NONE;
+		d->start[1] = RE_DS_NONE;
+		*flushed = true;
+	}
+
+	off = d->used;
+	d->used += size;
+
+	ds = re_dstate(d, off);
+	ds->hash = hash;
+	ds->npc = n;
+	ds->begin = begin;
+	ds->match = 0;
+	for (uint16_t k = 0; k < re->nclasses; ++k) {
+		ds->next[k] = RE_DS_NONE;
+	}
+	memcpy(re_dstate_pcs(re, ds), d->list, n * sizeof(uint16_t));
+
+	/* RE_MATCH is the last instruction */
+	if ((n > 0) && (d->list[n - 1] == match)) {
+		ds->match |= RE_MATCH_NOW;
+	}
+
+	for (uint16_t i = 0; i < n; ++i) {
+		if (d->prog[d->list[i]].op == RE_END) {
+			re_dfa_closure(d, d->list[i], begin, true);
+		}
+	}
+
+	if ((d->visited[match / 32] & BIT(match % 32)) != 0) {
+		ds->match |= RE_MATCH_AT_END;
+	}
+	memset(d->visited, 0, DIV_ROUND_UP(re->ninst, 32) * sizeof(uint32_t));
+
+	return off;
+}
+
+static int32_t re_dfa_start(const struct re_prog *re, struct re_dfa *d, bool begin)
+{
+	bool flushed = false;
+
+	if (d->start[begin] == RE_DS_NONE) {
+		re_dfa_closure(d, 0, begin, false);
+		d->start[begin] = re_dfa_state(re, d, re_dfa_collect(re, d), begin, &flushed);
+	}
+
+	return d->start[begin];
+}
+
+static int32_t re_dfa_next(const struct re_prog *re, struct re_dfa *d, int32_t off, uint8_t c)
+{
+	uint16_t pc;
+	uint16_t npc;
+	int32_t next;
+	const uint16_t *pcs;
+	bool flushed = false;
+	struct re_dstate *ds = re_dstate(d, off);
+	const uint8_t k = re->classes[c];
+	const bool newline = ((re->cflags & REG_NEWLINE) != 0) && (c == '\n');
+
+	if (ds->next[k] != RE_DS_NONE) {
+		return ds->next[k];
+	}
+
+	pcs = re_dstate_pcs(re, ds);
+	npc = ds->npc;
+
+	if (newline) {
+		/* a newline ends the line of the pending RE_END instructions */
+		for (uint16_t i = 0; i < npc; ++i) {
+			re_dfa_closure(d, pcs[i], ds->begin, true);
+		}
+		npc = re_dfa_collect(re, d);
+		pcs = d->list;
+	}
+
+	for (uint16_t i = 0; i < npc; ++i) {
+		pc = pcs[i];
+		if (re_consumes(re, &d->prog[pc], c)) {
+			re_dfa_closure(d, pc + 1, newline, false);
+		}
+	}
+
+	if (d->unanchored) {
+		re_dfa_closure(d, 0, newline, false);
+	}
+
+	next = re_dfa_state(re, d, re_dfa_collect(re, d), newline, &flushed);
+	if (!flushed) {
+		re_dstate(d, off)->next[k] = next;
+	}
+
+	return next;
+}
+
+static struct re_dfa *re_dfa_get(struct re_prog *re, int which)
+{
+	struct re_dfa *d = re->dfa[which];
+	const size_t words = DIV_ROUND_UP(re->ninst, 32);
+
+	if (d != NULL) {
+		return d;
+	}
+
+	d = malloc(sizeof(*d) + RE_CACHE_SIZE + words * sizeof(uint32_t) +
+		   2 * re->ninst * sizeof(uint16_t));
+	if (d == NULL) {
+		return NULL;
+	}
+
+	*d = (struct re_dfa){
+		.prog = (which == RE_DFA_REVERSE) ? re->rev : re->fwd,
+		.unanchored = (which != RE_DFA_LONGEST),
+		.start = {RE_DS_NONE, RE_DS_NONE},
+		.cache = (uint8_t *)(d + 1),
+	};
+	d->visited = (uint32_t *)&d->cache[RE_CACHE_SIZE];
+	d->stack = (uint16_t *)&d->visited[words];
+	d->list = &d->stack[re->ninst];
+	memset(d->visited, 0, words * sizeof(uint32_t));
+
+	re->dfa[which] = d;
+
+	return d;
+}
+
+static inline bool re_matched(const struct re_dstate *ds, bool end)
+{
+	return ((ds->match & RE_MATCH_NOW) != 0) || (end && ((ds->match & RE_MATCH_AT_END) != 0));
+}
+
+/* Whether position i of the string is at the beginning of a line */
+static inline bool re_at_bol(const struct re_prog *re, const char *s, size_t i, int eflags)
+{
+	if (i == 0) {
+		return (eflags & REG_NOTBOL) == 0;
+	}
+
+	return ((re->cflags & REG_NEWLINE) != 0) && (s[i - 1] == '\n');
+}
+
+/* Whether position i of the string is at the end of a line */
+static inline bool re_at_eol(const struct re_prog *re, const char *s, size_t len, size_t i,
+			     int eflags)
+{
+	if (i == len) {
+		return (eflags & REG_NOTEOL) == 0;
+	}
+
+	return ((re->cflags & REG_NEWLINE) != 0) && (s[i] == '\n');
+}
+
+static bool re_search(const struct re_prog *re, struct re_dfa *d, const char *s, size_t len,
+		      int eflags)
+{
+	int32_t off = re_dfa_start(re, d, re_at_bol(re, s, 0, eflags));
+
+	for (size_t i = 0;; ++i) {
+		if (re_matched(re_dstate(d, off), re_at_eol(re, s, len, i, eflags))) {
+			return true;
+		}
+
+		if (i == len) {
+			return false;
+		}
+
+		off = re_dfa_next(re, d, off, s[i]);
+	}
+}
+
+/* Scan backwards with the reversed DFA for the start of the leftmost match, or -1 */
+static regoff_t re_leftmost(const struct re_prog *re, struct re_dfa *d, const char *s, size_t len,
+			    int eflags)
+{
+	regoff_t so = -1;
+	int32_t off = re_dfa_start(re, d, re_at_eol(re, s, len, len, eflags));
+
+	for (size_t i = len;; --i) {
+		if (re_matched(re_dstate(d, off), re_at_bol(re, s, i, eflags))) {
+			so = i;
+		}
+
+		if (i == 0) {
+			return so;
+		}
+
+		off = re_dfa_next(re, d, off, s[i - 1]);
+	}
+}
+
+/* Find the end of the longest match starting at so */
+static regoff_t re_longest(const struct re_prog *re, struct re_dfa *d, const char *s, size_t len,
+			   regoff_t so, int eflags)
+{
+	struct re_dstate *ds;
+	regoff_t eo = -1;
+	int32_t off = re_dfa_start(re, d, re_at_bol(re, s, so, eflags));
+
+	for (size_t i = so;; ++i) {
+		ds = re_dstate(d, off);
+		if (re_matched(ds, re_at_eol(re, s, len, i, eflags))) {
+			eo = i;
+		}
+
+		if ((i == len) || (ds->npc == 0)) {
+			return eo;
+		}
+
+		off = re_dfa_next(re, d, off, s[i]);
+	}
+}
+
+/*
+ * Pike VM
+ */
+
+static void re_pike_add(struct re_pike *vm, struct re_pike_list *l, uint16_t pc, size_t i)
+{
+	size_t sp = 0;
+	struct re_pike_entry e;
+	const struct re_inst *inst;
+	const struct re_prog *re = vm->re;
+
+	vm->stack[sp++] = (struct re_pike_entry){.pc = pc, .slot = RE_NO_SLOT};
+
+	while (sp > 0) {
+		e = vm->stack[--sp];
+		if (e.slot != RE_NO_SLOT) {
+			vm->work[e.slot] = e.val;
+			continue;
+		}
+
+		/* threads are added in order of priority, so the first to get somewhere wins */
+		if (!re_visit(vm->visited, e.pc)) {
+			continue;
+		}
+
+		inst = &re->fwd[e.pc];
+		switch (inst->op) {
+		case RE_SPLIT:
+			vm->stack[sp++] = (struct re_pike_entry){.pc = inst->y, .slot = RE_NO_SLOT};
+			vm->stack[sp++] = (struct re_pike_entry){.pc = inst->x, .slot = RE_NO_SLOT};
+			break;
+		case RE_JMP:
+			vm->stack[sp++] = (struct re_pike_entry){.pc = inst->x, .slot = RE_NO_SLOT};
+			break;
+		case RE_SAVE:
+			if (inst->x < vm->ncap) {
+				vm->stack[sp++] = (struct re_pike_entry){
+					.slot = inst->x,
+					.val = vm->work[inst->x],
+				};
+				vm->work[inst->x] = i;
+			}
+			vm->stack[sp++] = (struct re_pike_entry){.pc = e.pc + 1, .slot = RE_NO_SLOT};
+			break;
+		case RE_BEGIN:
+			if (re_at_bol(re, vm->s, i, vm->eflags)) {
+				vm->stack[sp++] =
+					(struct re_pike_entry){.pc = e.pc + 1, .slot = RE_NO_SLOT};
+			}
+			break;
+		case RE_END:
+			if (re_at_eol(re, vm->s, vm->len, i, vm->eflags)) {
+				vm->stack[sp++] =
+					(struct re_pike_entry){.pc = e.pc + 1, .slot = RE_NO_SLOT};
+			}
+			break;
+		default:
+			l->pc[l->n] = e.pc;
+			memcpy(&l->caps[l->n * vm->ncap], vm->work, vm->ncap * sizeof(regoff_t));
+			++l->n;
+			break;
+		}
+	}
+}
+
+/* Locate the subexpressions of the match [so, eo) */
+static int re_pike(const struct re_prog *re, const char *s, size_t len, regoff_t so, regoff_t eo,
+		   size_t nmatch, regmatch_t *pmatch, int eflags)
+{
+	void *mem;
+	uint8_t *p;
+	const regoff_t *caps;
+	struct re_pike_list *cur;
+	struct re_pike_list *nxt;
+	const struct re_inst *inst;
+	const size_t ncap = 2 * nmatch;
+	const size_t nthread = re->nconsume + 1;
+	const size_t words = DIV_ROUND_UP(re->ninst, 32);
+	struct re_pike vm = {
+		.re = re,
+		.s = s,
+		.len = len,
+		.eflags = eflags,
+		.ncap = ncap,
+	};
+
+	mem = malloc((2 * re->ninst + 1) * sizeof(struct re_pike_entry) +
+		     (2 * nthread + 1) * ncap * sizeof(regoff_t) + words * sizeof(uint32_t) +
+		     2 * nthread * sizeof(uint16_t));
+	if (mem == NULL) {
+		return REG_ESPACE;
+	}
+
+	p = mem;
+	vm.stack = (struct re_pike_entry *)p;
+	p += (2 * re->ninst + 1) * sizeof(struct re_pike_entry);
+	vm.work = (regoff_t *)p;
+	p += ncap * sizeof(regoff_t);
+	for (int i = 0; i < 2; ++i) {
+		vm.list[i].caps = (regoff_t *)p;
+		p += nthread * ncap * sizeof(regoff_t);
+	}
+	vm.visited = (uint32_t *)p;
+	p += words * sizeof(uint32_t);
+	for (int i = 0; i < 2; ++i) {
+		vm.list[i].pc = (uint16_t *)p;
+		p += nthread * sizeof(uint16_t);
+	}
+
+	for (size_t k = 0; k < ncap; ++k) {
+		vm.work[k] = -1;
+	}
+
+	cur = &vm.list[0];
+	nxt = &vm.list[1];
+	memset(vm.visited, 0, words * sizeof(uint32_t));
+	re_pike_add(&vm, cur, 0, so);
+
+	for (size_t i = so;; ++i) {
+		memset(vm.visited, 0, words * sizeof(uint32_t));
+		nxt->n = 0;
+
+		for (size_t t = 0; t < cur->n; ++t) {
+			inst = &re->fwd[cur->pc[t]];
+			caps = &cur->caps[t * ncap];
+
+			if (inst->op == RE_MATCH) {
+				if (i != (size_t)eo) {
+					continue;
+				}
+
+				for (size_t n = 1; n < nmatch; ++n) {
+					pmatch[n].rm_so = caps[2 * n];
+					pmatch[n].rm_eo = caps[2 * n + 1];
+				}
+				free(mem);
+				return 0;
+			}
+
+			if ((i < (size_t)eo) && re_consumes(re, inst, s[i])) {
+				memcpy(vm.work, caps, ncap * sizeof(regoff_t));
+				re_pike_add(&vm, nxt, cur->pc[t] + 1, i + 1);
+			}
+		}
+
+		if (i == (size_t)eo) {
+			break;
+		}
+
+		SWAP(cur, nxt);
+	}
+
+	/* the DFA found a match, so this is not reached */
+	free(mem);
+
+	return REG_NOMATCH;
+}
+
+/*
+ * API
+ */
+
+int regcomp(regex_t *ZRESTRICT preg, const char *ZRESTRICT pattern, int cflags)
+{
+	size_t ninst;
+	struct re_node *root;
+	struct re_prog *re = NULL;
+	struct re_emitter em;
+	struct re_parser ps = {
+		.p = pattern,
+		.cflags = cflags,
+	};
+
+	/* every character of the pattern makes at most two nodes */
+	ps.maxnodes = 2 * strlen(pattern) + 2;
+	ps.nodes = malloc(ps.maxnodes * sizeof(*ps.nodes));
+	if (ps.nodes == NULL) {
+		return REG_ESPACE;
+	}
+
+	root = re_parse_alt(&ps);
+	if ((ps.err == 0) && (*ps.p != EOS)) {
+		/* an unmatched "\)" */
+		ps.err = REG_EPAREN;
+	}
+
+	if (ps.err != 0) {
+		goto out;
+	}
+
+	ninst = re_size(root) + 1;
+	if (ninst > RE_INST_MAX) {
+		ps.err = REG_ESPACE;
+		goto out;
+	}
+
+	re = malloc(sizeof(*re) + 2 * ninst * sizeof(struct re_inst));
+	if (re == NULL) {
+		ps.err = REG_ESPACE;
+		goto out;
+	}
+
+	*re = (struct re_prog){
+		.cflags = cflags,
+		.ninst = ninst,
+		.fwd = (struct re_inst *)(re + 1),
+		.sets = ps.sets,
+	};
+	re->rev = &re->fwd[ninst];
+	ps.sets = NULL;
+
+	em = (struct re_emitter){.prog = re->fwd};
+	re_emit(&em, root);
+	(void)re_put(&em, RE_MATCH, 0, 0, 0);
+
+	em = (struct re_emitter){.prog = re->rev, .reverse = true};
+	re_emit(&em, root);
+	(void)re_put(&em, RE_MATCH, 0, 0, 0);
+
+	for (uint16_t pc = 0; pc < ninst; ++pc) {
+		if ((re->fwd[pc].op == RE_CHAR) || (re->fwd[pc].op == RE_SET)) {
+			++re->nconsume;
+		}
+	}
+
+	re_classes(re);
+
+	/* the largest state must fit in the DFA cache */
+	if (re_dstate_size(re, ninst) > RE_CACHE_SIZE) {
+		free(re->sets);
+		free(re);
+		re = NULL;
+		ps.err = REG_ESPACE;
+		goto out;
+	}
+
+	(void)k_mutex_init(&re->lock);
+
+	preg->re_nsub = ps.nsub;
+	preg->re_impl = re;
+
+out:
+	free(ps.sets);
+	free(ps.nodes);
+
+	return ps.err;
+}
+
+int regexec(const regex_t *ZRESTRICT preg, const char *ZRESTRICT string, size_t nmatch,
+	    regmatch_t pmatch[ZRESTRICT], int eflags)
+{
+	int ret = 0;
+	regoff_t so = -1;
+	regoff_t eo = -1;
+	struct re_dfa *d;
+	struct re_dfa *dl;
+	struct re_prog *re = preg->re_impl;
+	const size_t len = strlen(string);
+
+	if ((re->cflags & REG_NOSUB) != 0) {
+		nmatch = 0;
+	}
+
+	(void)k_mutex_lock(&re->lock, K_FOREVER);
+
+	if (nmatch == 0) {
+		d = re_dfa_get(re, RE_DFA_SEARCH);
+		if (d == NULL) {
+			ret = REG_ESPACE;
+		} else if (!re_search(re, d, string, len, eflags)) {
+			ret = REG_NOMATCH;
+		}
+	} else {
+		d = re_dfa_get(re, RE_DFA_REVERSE);
+		dl = re_dfa_get(re, RE_DFA_LONGEST);
+		if ((d == NULL) || (dl == NULL)) {
+			ret = REG_ESPACE;
+		} else {
+			so = re_leftmost(re, d, string, len, eflags);
+			if (so < 0) {
+				ret = REG_NOMATCH;
+			} else {
+				eo = re_longest(re, dl, string, len, so, eflags);
+			}
+		}
+	}
+
+	k_mutex_unlock(&re->lock);
+
+	if ((ret != 0) || (nmatch == 0)) {
+		return ret;
+	}
+
+	pmatch[0].rm_so = so;
+	pmatch[0].rm_eo = eo;
+	for (size_t n = 1; n < nmatch; ++n) {
+		pmatch[n].rm_so = -1;
+		pmatch[n].rm_eo = -1;
+	}
+
+	if ((nmatch > 1) && (preg->re_nsub > 0)) {
+		ret = re_pike(re, string, len, so, eo, MIN(nmatch, preg->re_nsub + 1), pmatch,
+			      eflags);
+	}
+
+	return ret;
+}
+
+static const char *const re_errors[] = {
+	[0] = "Success",
+	[REG_NOMATCH] = "No match",
+	[REG_BADPAT] = "Invalid regular expression",
+	[REG_ECOLLATE] = "Invalid collation character",
+	[REG_ECTYPE] = "Invalid character class name",
+	[REG_EESCAPE] = "Trailing backslash",
+	[REG_ESUBREG] = "Invalid or unsupported back reference",
+	[REG_EBRACK] = "Unmatched [ or [^",
+	[REG_EPAREN] = "Unmatched ( or \\(",
+	[REG_EBRACE] = "Unmatched \\{",
+	[REG_BADBR] = "Invalid content of \\{\\}",
+	[REG_ERANGE] = "Invalid range end",
+	[REG_ESPACE] = "Memory exhausted",
+	[REG_BADRPT] = "Invalid preceding regular expression",
+};
+
+size_t regerror(int errcode, const regex_t *ZRESTRICT preg, char *ZRESTRICT errbuf,
+		size_t errbuf_size)
+{
+	const char *msg = "Unknown error";
+	size_t len;
+
+	ARG_UNUSED(preg);
+
+	if ((errcode >= 0) && ((size_t)errcode < ARRAY_SIZE(re_errors))) {
+		msg = re_errors[errcode];
+	}
+
+	len = strlen(msg) + 1;
+	if (errbuf_size > 0) {
+		strncpy(errbuf, msg, errbuf_size - 1);
+		errbuf[MIN(len, errbuf_size) - 1] = EOS;
+	}
+
+	return len;
+}
+
+void regfree(regex_t *preg)
+{
+	struct re_prog *re = preg->re_impl;
+
+	if (re == NULL) {
+		return;
+	}
+
+	ARRAY_FOR_EACH(re->dfa, i) {
+		free(re->dfa[i]);
+	}
+
+	free(re->sets);
+	free(re);
+	preg->re_impl = NULL;
+}
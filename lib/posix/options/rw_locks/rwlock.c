@@ -7,6 +7,7 @@
 
 #include "posix_clock.h"
 #include "posix_internal.h"
+#include "trace_priv.h"
 
 #include <pthread.h>
 
@@ -30,15 +31,17 @@ struct posix_rwlockattr {
 	bool pshared: 1;
 };
 
-static uint32_t read_lock_acquire(struct posix_rwlock *rwl, uint32_t timeout);
-static uint32_t write_lock_acquire(struct posix_rwlock *rwl, uint32_t timeout);
+static uint32_t read_lock_acquire(struct posix_rwlock *rwl, int clock_id,
+				  const struct timespec *abstime);
+static uint32_t write_lock_acquire(struct posix_rwlock *rwl, int clock_id,
+				   const struct timespec *abstime);
+
+/* An absolute time that has always passed, to acquire the lock without waiting */
+static const struct timespec rwlock_no_wait;
 
 LOG_MODULE_REGISTER(pthread_rwlock, CONFIG_PTHREAD_RWLOCK_LOG_LEVEL);
 
-static SYS_SEM_DEFINE(posix_rwlock_lock, 1, 1);
-SYS_ELASTIPOOL_DEFINE_STATIC(posix_rwlock_pool, sizeof(struct posix_rwlock),
-			     __alignof(struct posix_rwlock), CONFIG_MAX_PTHREAD_RWLOCK_COUNT,
-			     CONFIG_MAX_PTHREAD_RWLOCK_COUNT);
+POSIX_POOL_DEFINE(posix_rwlock_pool, struct posix_rwlock, CONFIG_MAX_PTHREAD_RWLOCK_COUNT);
 
 /**
  * @brief Initialize read-write lock object.
@@ -48,13 +51,15 @@ SYS_ELASTIPOOL_DEFINE_STATIC(posix_rwlock_pool, sizeof(struct posix_rwlock),
 int pthread_rwlock_init(pthread_rwlock_t *rwlock,
 			const pthread_rwlockattr_t *attr)
 {
+	uint32_t handle;
 	struct posix_rwlock *rwl;
 
 	ARG_UNUSED(attr);
 	*rwlock = PTHREAD_RWLOCK_INITIALIZER;
 
-	rwl = posix_init_pool_obj(&posix_rwlock_pool, &posix_rwlock_lock, *rwlock, NULL);
+	rwl = posix_pool_alloc(&posix_rwlock_pool, &handle);
 	if (rwl == NULL) {
+		sys_port_trace_posix_call(PTHREAD_RWLOCK_INIT, NULL, ENOMEM);
 		return ENOMEM;
 	}
 
@@ -63,7 +68,8 @@ int pthread_rwlock_init(pthread_rwlock_t *rwlock,
 	sys_sem_init(&rwl->reader_active, 1, 1);
 	rwl->wr_owner = NULL;
 
-	*rwlock = (pthread_rwlock_t)(uintptr_t)rwl;
+	*rwlock = (pthread_rwlock_t)handle;
+	sys_port_trace_posix_call(PTHREAD_RWLOCK_INIT, rwl, 0);
 
 	LOG_DBG("Initialized rwlock %p", rwl);
 
@@ -75,30 +81,56 @@ int pthread_rwlock_init(pthread_rwlock_t *rwlock,
  *
  * See IEEE 1003.1
  */
+static int rwlock_check_destroy(void *obj)
+{
+	struct posix_rwlock *rwl = obj;
+
+	return (rwl->wr_owner != NULL) ? EBUSY : 0;
+}
+
 int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
 {
-	int err;
-	int ret = EINVAL;
+	int ret;
+	/* looked up before it is freed, only to be traced */
+	struct posix_rwlock *const rwl __maybe_unused =
+		IS_ENABLED(CONFIG_POSIX_TRACING) ? posix_pool_get(&posix_rwlock_pool, *rwlock)
+						 : NULL;
+
+	ret = posix_pool_free(&posix_rwlock_pool, *rwlock, rwlock_check_destroy);
+	sys_port_trace_posix_call(PTHREAD_RWLOCK_DESTROY, rwl, ret);
+
+	return ret;
+}
+
+/* Lock for reading or writing until abstime of clock_id */
+static int rwlock_clock_lock(pthread_rwlock_t *rwlock, clockid_t clock_id,
+			     const struct timespec *abstime, bool write)
+{
+	uint32_t ret;
 	struct posix_rwlock *rwl;
 
-	SYS_SEM_LOCK(&posix_rwlock_lock) {
-		rwl = posix_get_pool_obj_unlocked(&posix_rwlock_pool, *rwlock);
-		if (rwl == NULL) {
-			ret = EINVAL;
-			SYS_SEM_LOCK_BREAK;
-		}
+	if ((abstime == NULL) || !timespec_is_valid(abstime)) {
+		LOG_DBG("%s is invalid", "abstime");
+		return EINVAL;
+	}
 
-		if (rwl->wr_owner != NULL) {
-			ret = EBUSY;
-			SYS_SEM_LOCK_BREAK;
-		}
+	if ((clock_id != CLOCK_REALTIME) && (clock_id != CLOCK_MONOTONIC)) {
+		LOG_DBG("%s is invalid", "clock_id");
+		return EINVAL;
+	}
 
-		ret = 0;
-		err = sys_elastipool_free(&posix_rwlock_pool, (void *)rwl);
-		__ASSERT_NO_MSG(err == 0);
+	rwl = posix_pool_get(&posix_rwlock_pool, *rwlock);
+	if (rwl == NULL) {
+		return EINVAL;
 	}
 
-	return ret;
+	if (write) {
+		ret = write_lock_acquire(rwl, (int)clock_id, abstime);
+	} else {
+		ret = read_lock_acquire(rwl, (int)clock_id, abstime);
+	}
+
+	return (ret != 0U) ? ETIMEDOUT : 0;
 }
 
 /**
@@ -113,12 +145,12 @@ int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
 {
 	struct posix_rwlock *rwl;
 
-	rwl = posix_get_pool_obj(&posix_rwlock_pool, &posix_rwlock_lock, *rwlock);
+	rwl = posix_pool_get(&posix_rwlock_pool, *rwlock);
 	if (rwl == NULL) {
 		return EINVAL;
 	}
 
-	return read_lock_acquire(rwl, SYS_FOREVER_MS);
+	return read_lock_acquire(rwl, CLOCK_MONOTONIC, NULL);
 }
 
 /**
@@ -132,24 +164,7 @@ int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
 int pthread_rwlock_timedrdlock(pthread_rwlock_t *rwlock,
 			       const struct timespec *abstime)
 {
-	uint32_t ret = 0U;
-	struct posix_rwlock *rwl;
-
-	if ((abstime == NULL) || !timespec_is_valid(abstime)) {
-		LOG_DBG("%s is invalid", "abstime");
-		return EINVAL;
-	}
-
-	rwl = posix_get_pool_obj(&posix_rwlock_pool, &posix_rwlock_lock, *rwlock);
-	if (rwl == NULL) {
-		return EINVAL;
-	}
-
-	if (read_lock_acquire(rwl, timespec_to_timeoutms(CLOCK_REALTIME, abstime)) != 0U) {
-		ret = ETIMEDOUT;
-	}
-
-	return ret;
+	return rwlock_clock_lock(rwlock, CLOCK_REALTIME, abstime, false);
 }
 
 /**
@@ -164,12 +179,12 @@ int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
 {
 	struct posix_rwlock *rwl;
 
-	rwl = posix_get_pool_obj(&posix_rwlock_pool, &posix_rwlock_lock, *rwlock);
+	rwl = posix_pool_get(&posix_rwlock_pool, *rwlock);
 	if (rwl == NULL) {
 		return EINVAL;
 	}
 
-	return read_lock_acquire(rwl, 0);
+	return read_lock_acquire(rwl, CLOCK_MONOTONIC, &rwlock_no_wait);
 }
 
 /**
@@ -184,12 +199,12 @@ int pthread_rwlock_wrlock(pthread_rwlock_t *rwlock)
 {
 	struct posix_rwlock *rwl;
 
-	rwl = posix_get_pool_obj(&posix_rwlock_pool, &posix_rwlock_lock, *rwlock);
+	rwl = posix_pool_get(&posix_rwlock_pool, *rwlock);
 	if (rwl == NULL) {
 		return EINVAL;
 	}
 
-	return write_lock_acquire(rwl, SYS_FOREVER_MS);
+	return write_lock_acquire(rwl, CLOCK_MONOTONIC, NULL);
 }
 
 /**
@@ -203,24 +218,7 @@ int pthread_rwlock_wrlock(pthread_rwlock_t *rwlock)
 int pthread_rwlock_timedwrlock(pthread_rwlock_t *rwlock,
 			       const struct timespec *abstime)
 {
-	uint32_t ret = 0U;
-	struct posix_rwlock *rwl;
-
-	if ((abstime == NULL) || !timespec_is_valid(abstime)) {
-		LOG_DBG("%s is invalid", "abstime");
-		return EINVAL;
-	}
-
-	rwl = posix_get_pool_obj(&posix_rwlock_pool, &posix_rwlock_lock, *rwlock);
-	if (rwl == NULL) {
-		return EINVAL;
-	}
-
-	if (write_lock_acquire(rwl, timespec_to_timeoutms(CLOCK_REALTIME, abstime)) != 0U) {
-		ret = ETIMEDOUT;
-	}
-
-	return ret;
+	return rwlock_clock_lock(rwlock, CLOCK_REALTIME, abstime, true);
 }
 
 /**
@@ -235,12 +233,34 @@ int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
 {
 	struct posix_rwlock *rwl;
 
-	rwl = posix_get_pool_obj(&posix_rwlock_pool, &posix_rwlock_lock, *rwlock);
+	rwl = posix_pool_get(&posix_rwlock_pool, *rwlock);
 	if (rwl == NULL) {
 		return EINVAL;
 	}
 
-	return write_lock_acquire(rwl, 0);
+	return write_lock_acquire(rwl, CLOCK_MONOTONIC, &rwlock_no_wait);
+}
+
+/**
+ * @brief Lock a read-write lock object for reading until a time of a specific clock.
+ *
+ * See IEEE 1003.1
+ */
+int pthread_rwlock_clockrdlock(pthread_rwlock_t *rwlock, clockid_t clock_id,
+			       const struct timespec *abstime)
+{
+	return rwlock_clock_lock(rwlock, clock_id, abstime, false);
+}
+
+/**
+ * @brief Lock a read-write lock object for writing until a time of a specific clock.
+ *
+ * See IEEE 1003.1
+ */
+int pthread_rwlock_clockwrlock(pthread_rwlock_t *rwlock, clockid_t clock_id,
+			       const struct timespec *abstime)
+{
+	return rwlock_clock_lock(rwlock, clock_id, abstime, true);
 }
 
 /**
@@ -253,7 +273,7 @@ int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
 {
 	struct posix_rwlock *rwl;
 
-	rwl = posix_get_pool_obj(&posix_rwlock_pool, &posix_rwlock_lock, *rwlock);
+	rwl = posix_pool_get(&posix_rwlock_pool, *rwlock);
 	if (rwl == NULL) {
 		return EINVAL;
 	}
@@ -272,14 +292,55 @@ int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
 			(void)sys_sem_give(&rwl->reader_active);
 		}
 	}
+
+	sys_port_trace_posix_call(PTHREAD_RWLOCK_UNLOCK, rwl, 0);
+
 	return 0;
 }
 
-static uint32_t read_lock_acquire(struct posix_rwlock *rwl, uint32_t timeout)
+/* Take sem until abstime of clock_id, or forever if abstime is NULL */
+static int rwlock_sem_take(struct sys_sem *sem, int clock_id, const struct timespec *abstime)
+{
+	int ret;
+	int more;
+	k_timeout_t timeout;
+
+	if (abstime == NULL) {
+		return sys_sem_take(sem, K_FOREVER);
+	}
+
+	if (abstime == &rwlock_no_wait) {
+		return sys_sem_take(sem, K_NO_WAIT);
+	}
+
+	do {
+		more = timespec_to_clock_timeout(clock_id, abstime, &timeout);
+		if (more < 0) {
+			ret = more;
+			break;
+		}
+
+		ret = sys_sem_take(sem, timeout);
+	} while ((ret != 0) && (more > 0));
+
+	return ret;
+}
+
+/* the result of a lock that failed with EBUSY, as reported by the caller */
+#define RWLOCK_TRACE_ERR(ret, abstime)                                                             \
+	((((ret) == 0U) || ((abstime) == &rwlock_no_wait)) ? (int)(ret) : ETIMEDOUT)
+
+static uint32_t read_lock_acquire(struct posix_rwlock *rwl, int clock_id,
+				  const struct timespec *abstime)
 {
 	uint32_t ret = 0U;
 
-	if (sys_sem_take(&rwl->wr_sem, SYS_TIMEOUT_MS(timeout)) == 0) {
+	sys_port_trace_posix_enter(PTHREAD_RWLOCK_RDLOCK, rwl,
+				   sys_trace_posix_abstime(clock_id, abstime));
+	sys_port_trace_posix_blocking(PTHREAD_RWLOCK_RDLOCK, rwl,
+				      sys_sem_count_get(&rwl->wr_sem) == 0);
+
+	if (rwlock_sem_take(&rwl->wr_sem, clock_id, abstime) == 0) {
 		(void)sys_sem_take(&rwl->reader_active, K_NO_WAIT);
 		(void)sys_sem_take(&rwl->rd_sem, K_NO_WAIT);
 		(void)sys_sem_give(&rwl->wr_sem);
@@ -287,30 +348,26 @@ static uint32_t read_lock_acquire(struct posix_rwlock *rwl, uint32_t timeout)
 		ret = EBUSY;
 	}
 
+	sys_port_trace_posix_exit(PTHREAD_RWLOCK_RDLOCK, rwl, RWLOCK_TRACE_ERR(ret, abstime));
+
 	return ret;
 }
 
-static uint32_t write_lock_acquire(struct posix_rwlock *rwl, uint32_t timeout)
+static uint32_t write_lock_acquire(struct posix_rwlock *rwl, int clock_id,
+				   const struct timespec *abstime)
 {
 	uint32_t ret = 0U;
-	int64_t elapsed_time, st_time = k_uptime_get();
-	k_timeout_t k_timeout;
 
-	k_timeout = SYS_TIMEOUT_MS(timeout);
+	sys_port_trace_posix_enter(PTHREAD_RWLOCK_WRLOCK, rwl,
+				   sys_trace_posix_abstime(clock_id, abstime));
+	sys_port_trace_posix_blocking(PTHREAD_RWLOCK_WRLOCK, rwl,
+				      (sys_sem_count_get(&rwl->wr_sem) == 0) ||
+					      (sys_sem_count_get(&rwl->reader_active) == 0));
 
 	/* waiting for release of write lock */
-	if (sys_sem_take(&rwl->wr_sem, k_timeout) == 0) {
-		/* update remaining timeout time for 2nd sem */
-		if (timeout != SYS_FOREVER_MS) {
-			elapsed_time = k_uptime_get() - st_time;
-			timeout = timeout <= elapsed_time ? 0 :
-				  timeout - elapsed_time;
-		}
-
-		k_timeout = SYS_TIMEOUT_MS(timeout);
-
-		/* waiting for reader to complete operation */
-		if (sys_sem_take(&rwl->reader_active, k_timeout) == 0) {
+	if (rwlock_sem_take(&rwl->wr_sem, clock_id, abstime) == 0) {
+		/* waiting for reader to complete operation, until the same absolute time */
+		if (rwlock_sem_take(&rwl->reader_active, clock_id, abstime) == 0) {
 			rwl->wr_owner = k_current_get();
 		} else {
 			(void)sys_sem_give(&rwl->wr_sem);
@@ -320,6 +377,9 @@ static uint32_t write_lock_acquire(struct posix_rwlock *rwl, uint32_t timeout)
 	} else {
 		ret = EBUSY;
 	}
+
+	sys_port_trace_posix_exit(PTHREAD_RWLOCK_WRLOCK, rwl, RWLOCK_TRACE_ERR(ret, abstime));
+
 	return ret;
 }
 
@@ -6,6 +6,7 @@
  */
 
 #include "posix_clock.h"
+#include "trace_priv.h"
 
 #include <errno.h>
 #include <zephyr/kernel.h>
@@ -92,11 +93,13 @@ int sem_destroy(sem_t *semaphore)
 	}
 
 	if (z_waitq_head(&((struct k_sem *)semaphore)->wait_q) != NULL) {
+		sys_port_trace_posix_call(SEM_DESTROY, semaphore, EBUSY);
 		errno = EBUSY;
 		return -1;
 	}
 
 	k_sem_reset((struct k_sem *)semaphore);
+	sys_port_trace_posix_call(SEM_DESTROY, semaphore, 0);
 	return 0;
 }
 
@@ -135,6 +138,7 @@ int sem_init(sem_t *semaphore, int pshared, unsigned int value)
 	__ASSERT(pshared == 0, "pshared should be 0");
 
 	k_sem_init(semaphore, value, CONFIG_POSIX_SEM_VALUE_MAX);
+	sys_port_trace_posix_call(SEM_INIT, semaphore, 0);
 
 	return 0;
 }
@@ -152,31 +156,76 @@ int sem_post(sem_t *semaphore)
 	}
 
 	k_sem_give((struct k_sem *)semaphore);
+	sys_port_trace_posix_call(SEM_POST, semaphore, 0);
 	return 0;
 }
 
-/**
- * @brief Try time limited locking a semaphore.
- *
- * See IEEE 1003.1
- */
-int sem_timedwait(sem_t *semaphore, struct timespec *abstime)
+static int sem_clock_wait(sem_t *semaphore, clockid_t clock_id, const struct timespec *abstime)
 {
-	if ((abstime == NULL) || !timespec_is_valid(abstime)) {
+	int ret;
+	int more;
+	k_timeout_t timeout;
+	struct posix_clock_wait wait;
+
+	if ((semaphore == NULL) || (abstime == NULL) ||
+	    ((clock_id != CLOCK_REALTIME) && (clock_id != CLOCK_MONOTONIC))) {
 		errno = EINVAL;
 		return -1;
 	}
 
-	k_timeout_t to = K_MSEC(timespec_to_timeoutms(CLOCK_REALTIME, abstime));
+	sys_port_trace_posix_enter(SEM_WAIT, semaphore,
+				   sys_trace_posix_abstime((int)clock_id, abstime));
+	sys_port_trace_posix_blocking(SEM_WAIT, semaphore,
+				      k_sem_count_get((struct k_sem *)semaphore) == 0);
+
+	posix_clock_wait_begin(&wait, (int)clock_id);
+	do {
+		more = timespec_to_clock_timeout((int)clock_id, abstime, &timeout);
+		if (more < 0) {
+			break;
+		}
 
-	if (k_sem_take((struct k_sem *)semaphore, to)) {
+		ret = posix_clock_sem_take(&wait, (struct k_sem *)semaphore, timeout);
+	} while ((ret == -EAGAIN) && (more > 0));
+	posix_clock_wait_end(&wait);
+
+	if (more < 0) {
+		sys_port_trace_posix_exit(SEM_WAIT, semaphore, EINVAL);
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (ret < 0) {
+		sys_port_trace_posix_exit(SEM_WAIT, semaphore, ETIMEDOUT);
 		errno = ETIMEDOUT;
 		return -1;
 	}
 
+	sys_port_trace_posix_exit(SEM_WAIT, semaphore, 0);
+
 	return 0;
 }
 
+/**
+ * @brief Try time limited locking a semaphore.
+ *
+ * See IEEE 1003.1
+ */
+int sem_timedwait(sem_t *semaphore, struct timespec *abstime)
+{
+	return sem_clock_wait(semaphore, CLOCK_REALTIME, abstime);
+}
+
+/**
+ * @brief Try time limited locking a semaphore, measuring time with a specific clock.
+ *
+ * See IEEE 1003.1
+ */
+int sem_clockwait(sem_t *semaphore, clockid_t clock_id, const struct timespec *abstime)
+{
+	return sem_clock_wait(semaphore, clock_id, abstime);
+}
+
 /**
  * @brief Lock a semaphore if not taken.
  *
@@ -184,10 +233,16 @@ int sem_timedwait(sem_t *semaphore, struct timespec *abstime)
  */
 int sem_trywait(sem_t *semaphore)
 {
+	sys_port_trace_posix_enter(SEM_WAIT, semaphore, K_NO_WAIT);
+	sys_port_trace_posix_blocking(SEM_WAIT, semaphore,
+				      k_sem_count_get((struct k_sem *)semaphore) == 0);
+
 	if (k_sem_take((struct k_sem *)semaphore, K_NO_WAIT) == -EBUSY) {
+		sys_port_trace_posix_exit(SEM_WAIT, semaphore, EAGAIN);
 		errno = EAGAIN;
 		return -1;
 	} else {
+		sys_port_trace_posix_exit(SEM_WAIT, semaphore, 0);
 		return 0;
 	}
 }
@@ -199,8 +254,14 @@ int sem_trywait(sem_t *semaphore)
  */
 int sem_wait(sem_t *semaphore)
 {
+	sys_port_trace_posix_enter(SEM_WAIT, semaphore, K_FOREVER);
+	sys_port_trace_posix_blocking(SEM_WAIT, semaphore,
+				      k_sem_count_get((struct k_sem *)semaphore) == 0);
+
 	/* With K_FOREVER, may return only success. */
 	(void)k_sem_take((struct k_sem *)semaphore, K_FOREVER);
+
+	sys_port_trace_posix_exit(SEM_WAIT, semaphore, 0);
 	return 0;
 }
 
@@ -291,6 +352,8 @@ error_unlock:
 
 unlock:
 	nsem_list_unlock();
+	sys_port_trace_posix_call(SEM_OPEN, (nsem == NULL) ? NULL : &nsem->sem,
+				  (nsem == NULL) ? errno : 0);
 	return nsem == NULL ? SEM_FAILED : &nsem->sem;
 }
 
@@ -340,6 +403,7 @@ int sem_close(sem_t *sem)
 	nsem_list_lock();
 	nsem_unref(nsem);
 	nsem_list_unlock();
+	sys_port_trace_posix_call(SEM_CLOSE, sem, 0);
 	return 0;
 }
 
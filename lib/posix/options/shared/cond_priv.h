@@ -0,0 +1,29 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_POSIX_OPTIONS_SHARED_COND_PRIV_H_
+#define ZEPHYR_LIB_POSIX_OPTIONS_SHARED_COND_PRIV_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/toolchain.h>
+
+#if defined(CONFIG_POSIX_COND_WAIT_MORPHING) && !defined(CONFIG_TC_PROVIDES_POSIX_THREADS)
+
+/*
+ * Wake the first thread that pthread_cond_broadcast() moved to @p mu, after @p mu has been
+ * unlocked by the calling thread.
+ */
+void posix_cond_mutex_unlocked(struct k_mutex *mu);
+
+#else
+
+static inline void posix_cond_mutex_unlocked(struct k_mutex *mu)
+{
+	ARG_UNUSED(mu);
+}
+
+#endif
+
+#endif /* ZEPHYR_LIB_POSIX_OPTIONS_SHARED_COND_PRIV_H_ */
@@ -0,0 +1,149 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_POSIX_OPTIONS_SHARED_DOMAIN_PRIV_H_
+#define ZEPHYR_LIB_POSIX_OPTIONS_SHARED_DOMAIN_PRIV_H_
+
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/toolchain.h>
+
+#include "usage_priv.h"
+
+/* the process ID of the initial process domain, which every thread belongs to by default */
+#define POSIX_DOMAIN_INIT_PID 42
+
+struct posix_domain;
+
+#if defined(CONFIG_POSIX_PROCESS_DOMAINS) && !defined(CONFIG_TC_PROVIDES_POSIX_MULTI_PROCESS)
+
+/*
+ * Take a reference to the domain that a thread about to be created by the calling thread will
+ * belong to, so that the domain outlives the creation of the thread.
+ */
+struct posix_domain *posix_domain_hold(void);
+
+/* Release a reference taken by posix_domain_hold(), when the thread could not be created */
+void posix_domain_release(struct posix_domain *domain);
+
+/* Make the calling thread, which was just created, a member of @p domain */
+void posix_domain_enter(struct posix_domain *domain);
+
+/* Remove the calling thread from its domain, before it exits */
+void posix_domain_exit(void);
+
+/* Index of the domain of @p thread, where 0 is the initial domain */
+int posix_domain_index(const struct k_thread *thread);
+
+/* Process ID of the domain of the calling thread */
+pid_t posix_domain_getpid(void);
+
+/* Process ID of the parent of the domain of the calling thread */
+pid_t posix_domain_getppid(void);
+
+/* Get a thread of the domain with process ID @p pid, or NULL if there is no such domain */
+struct k_thread *posix_domain_thread(pid_t pid);
+
+/*
+ * Get the environment of the domain of the calling thread, or NULL if it is the initial domain,
+ * which uses environ.
+ */
+char ***posix_domain_environ(void);
+
+/* Usage of the threads of the domain of the calling thread, and of its children that went away */
+int posix_domain_usage(struct posix_usage *self, struct posix_usage *children);
+
+/* Provided by env_common.c: copy the environment of the calling thread into @p env */
+int z_env_dup(char ***env);
+
+/* Provided by env_common.c: free the environment @p env */
+void z_env_free(char ***env);
+
+#else
+
+static inline struct posix_domain *posix_domain_hold(void)
+{
+	return NULL;
+}
+
+static inline void posix_domain_release(struct posix_domain *domain)
+{
+	ARG_UNUSED(domain);
+}
+
+static inline void posix_domain_enter(struct posix_domain *domain)
+{
+	ARG_UNUSED(domain);
+}
+
+static inline void posix_domain_exit(void)
+{
+}
+
+static inline int posix_domain_index(const struct k_thread *thread)
+{
+	ARG_UNUSED(thread);
+
+	return 0;
+}
+
+static inline pid_t posix_domain_getpid(void)
+{
+	return POSIX_DOMAIN_INIT_PID;
+}
+
+static inline pid_t posix_domain_getppid(void)
+{
+	/* the initial domain has no parent in this namespace */
+	return 0;
+}
+
+static inline struct k_thread *posix_domain_thread(pid_t pid)
+{
+	ARG_UNUSED(pid);
+
+	return NULL;
+}
+
+static inline char ***posix_domain_environ(void)
+{
+	return NULL;
+}
+
+static inline int posix_domain_usage(struct posix_usage *self, struct posix_usage *children)
+{
+	*self = (struct posix_usage){0};
+	*children = (struct posix_usage){0};
+
+	return posix_usage_all(self);
+}
+
+#endif
+
+#if defined(CONFIG_POSIX_PROCESS_DOMAINS) && defined(CONFIG_POSIX_SIGNALS) &&                      \
+	!defined(CONFIG_TC_PROVIDES_POSIX_SIGNALS)
+
+/*
+ * Provided by signal.c: set up the signal dispositions of the domain at @p index, created by a
+ * thread of the domain at @p parent. Signals caught by the parent are reset to SIG_DFL, as they
+ * would be by posix_spawn(). All signals are reset to SIG_DFL if @p parent is -1.
+ */
+void posix_sig_domain_init(int index, int parent);
+
+#else
+
+static inline void posix_sig_domain_init(int index, int parent)
+{
+	ARG_UNUSED(index);
+	ARG_UNUSED(parent);
+}
+
+#endif
+
+#endif /* ZEPHYR_LIB_POSIX_OPTIONS_SHARED_DOMAIN_PRIV_H_ */
@@ -5,6 +5,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "domain_priv.h"
+
 #include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -21,6 +23,14 @@ static SYS_SEM_DEFINE(environ_lock, 1, 1);
 static size_t allocated;
 char **environ;
 
+/* the environment of the process domain of the calling thread */
+static char ***environ_get(void)
+{
+	char ***env = posix_domain_environ();
+
+	return (env == NULL) ? &environ : env;
+}
+
 #ifdef CONFIG_ZTEST
 size_t posix_env_get_allocated_space(void)
 {
@@ -28,21 +38,21 @@ size_t posix_env_get_allocated_space(void)
 }
 #endif
 
-static size_t environ_size(void)
+static size_t environ_size(char **vars)
 {
 	size_t ret;
 
-	if (environ == NULL) {
+	if (vars == NULL) {
 		return 0;
 	}
 
-	for (ret = 0; environ[ret] != NULL; ++ret) {
+	for (ret = 0; vars[ret] != NULL; ++ret) {
 	}
 
 	return ret;
 }
 
-static int findenv(const char *name, size_t namelen)
+static int findenv(char **vars, const char *name, size_t namelen)
 {
 	const char *env;
 
@@ -51,14 +61,14 @@ static int findenv(const char *name, size_t namelen)
 		return -EINVAL;
 	}
 
-	if (environ == NULL) {
+	if (vars == NULL) {
 		return -ENOENT;
 	}
 
-	for (char **envp = &environ[0]; *envp != NULL; ++envp) {
+	for (char **envp = &vars[0]; *envp != NULL; ++envp) {
 		env = *envp;
 		if (strncmp(env, name, namelen) == 0 && env[namelen] == '=') {
-			return envp - environ;
+			return envp - vars;
 		}
 	}
 
@@ -70,15 +80,17 @@ char *z_getenv(const char *name)
 	int ret;
 	size_t nsize;
 	char *val = NULL;
+	char **vars;
 
 	nsize = (name == NULL) ? 0 : strlen(name);
 	SYS_SEM_LOCK(&environ_lock) {
-		ret = findenv(name, nsize);
+		vars = *environ_get();
+		ret = findenv(vars, name, nsize);
 		if (ret < 0) {
 			SYS_SEM_LOCK_BREAK;
 		}
 
-		val = environ[ret] + nsize + 1;
+		val = vars[ret] + nsize + 1;
 	}
 
 	return val;
@@ -90,23 +102,25 @@ int z_getenv_r(const char *name, char *buf, size_t len)
 	size_t vsize;
 	size_t nsize;
 	char *val = NULL;
+	char **vars;
 
 	nsize = (name == NULL) ? 0 : strlen(name);
 	SYS_SEM_LOCK(&environ_lock) {
-		ret = findenv(name, nsize);
+		vars = *environ_get();
+		ret = findenv(vars, name, nsize);
 		if (ret < 0) {
 			LOG_DBG("No entry for name '%s'", name);
 			SYS_SEM_LOCK_BREAK;
 		}
 
-		val = environ[ret] + nsize + 1;
+		val = vars[ret] + nsize + 1;
 		vsize = strlen(val) + 1;
 		if (vsize > len) {
 			ret = -ERANGE;
 			SYS_SEM_LOCK_BREAK;
 		}
 		strcpy(buf, val);
-		LOG_DBG("Found entry %s", environ[ret]);
+		LOG_DBG("Found entry %s", vars[ret]);
 	}
 
 	if (ret < 0) {
@@ -122,6 +136,7 @@ int z_setenv(const char *name, const char *val, int overwrite)
 	int ret = 0;
 	char *env;
 	char **envp;
+	char ***environp;
 	size_t esize;
 	const size_t vsize = (val == NULL) ? 0 : strlen(val);
 	const size_t nsize = (name == NULL) ? 0 : strlen(name);
@@ -135,23 +150,24 @@ int z_setenv(const char *name, const char *val, int overwrite)
 	}
 
 	SYS_SEM_LOCK(&environ_lock) {
-		ret = findenv(name, nsize);
+		environp = environ_get();
+		ret = findenv(*environp, name, nsize);
 		if (ret == -EINVAL) {
 			LOG_DBG("Invalid name '%s'", name);
 			SYS_SEM_LOCK_BREAK;
 		}
 		if (ret >= 0) {
 			/* name was found in environ */
-			esize = strlen(environ[ret]) + 1;
+			esize = strlen((*environp)[ret]) + 1;
 			if (overwrite == 0) {
-				LOG_DBG("Found entry %s", environ[ret]);
+				LOG_DBG("Found entry %s", (*environp)[ret]);
 				ret = 0;
 				SYS_SEM_LOCK_BREAK;
 			}
 		} else {
 			/* name was not found in environ -> add new entry */
-			esize = environ_size();
-			envp = realloc(environ,
+			esize = environ_size(*environp);
+			envp = realloc(*environp,
 				       sizeof(void *) * (esize + 1 /* new entry */ + 1 /* NULL */));
 			if (envp == NULL) {
 				ret = -ENOMEM;
@@ -164,16 +180,16 @@ int z_setenv(const char *name, const char *val, int overwrite)
 					sizeof(void *) * (esize + 2), allocated);
 			}
 
-			environ = envp;
+			*environp = envp;
 			ret = esize;
-			environ[ret] = NULL;
-			environ[ret + 1] = NULL;
+			(*environp)[ret] = NULL;
+			(*environp)[ret + 1] = NULL;
 			esize = 0;
 		}
 
 		if (esize < tsize) {
 			/* need to malloc or realloc space for new environ entry */
-			env = realloc(environ[ret], tsize);
+			env = realloc((*environp)[ret], tsize);
 			if (env == NULL) {
 				ret = -ENOMEM;
 				SYS_SEM_LOCK_BREAK;
@@ -183,13 +199,13 @@ int z_setenv(const char *name, const char *val, int overwrite)
 				LOG_DBG("realloc %zu bytes (allocated: %zu)", tsize - esize,
 					allocated);
 			}
-			environ[ret] = env;
+			(*environp)[ret] = env;
 		}
 
-		strcpy(environ[ret], name);
-		environ[ret][nsize] = '=';
-		strncpy(environ[ret] + nsize + 1, val, vsize + 1);
-		LOG_DBG("Added entry %s", environ[ret]);
+		strcpy((*environp)[ret], name);
+		(*environp)[ret][nsize] = '=';
+		strncpy((*environp)[ret] + nsize + 1, val, vsize + 1);
+		LOG_DBG("Added entry %s", (*environp)[ret]);
 
 		ret = 0;
 	}
@@ -206,44 +222,46 @@ int z_unsetenv(const char *name)
 {
 	int ret = 0;
 	char **envp;
+	char ***environp;
 	size_t esize;
 	size_t nsize;
 
 	nsize = (name == NULL) ? 0 : strlen(name);
 	SYS_SEM_LOCK(&environ_lock) {
-		ret = findenv(name, nsize);
+		environp = environ_get();
+		ret = findenv(*environp, name, nsize);
 		if (ret < 0) {
 			ret = (ret == -EINVAL) ? -EINVAL : 0;
 			SYS_SEM_LOCK_BREAK;
 		}
 
-		esize = environ_size();
+		esize = environ_size(*environp);
 		if (TRACK_ALLOC) {
-			allocated -= strlen(environ[ret]) + 1;
-			LOG_DBG("free %zu bytes (allocated: %zu)", strlen(environ[ret]) + 1,
+			allocated -= strlen((*environp)[ret]) + 1;
+			LOG_DBG("free %zu bytes (allocated: %zu)", strlen((*environp)[ret]) + 1,
 				allocated);
 		}
-		free(environ[ret]);
+		free((*environp)[ret]);
 
 		/* shuffle remaining environment variable pointers forward */
 		for (; ret < esize; ++ret) {
-			environ[ret] = environ[ret + 1];
+			(*environp)[ret] = (*environp)[ret + 1];
 		}
 		/* environ must be terminated with a NULL pointer */
-		environ[ret] = NULL;
+		(*environp)[ret] = NULL;
 
 		/* reduce environ size and update allocation */
 		--esize;
 		if (esize == 0) {
-			free(environ);
-			environ = NULL;
+			free(*environp);
+			*environp = NULL;
 		} else {
-			envp = realloc(environ, (esize + 1 /* NULL */) * sizeof(void *));
+			envp = realloc(*environp, (esize + 1 /* NULL */) * sizeof(void *));
 			if (envp != NULL) {
-				environ = envp;
+				*environp = envp;
 			}
 		}
-		__ASSERT_NO_MSG((esize >= 1 && environ != NULL) || environ == NULL);
+		__ASSERT_NO_MSG((esize >= 1 && *environp != NULL) || *environp == NULL);
 
 		if (TRACK_ALLOC) {
 			/* recycle nsize here */
@@ -262,3 +280,84 @@ int z_unsetenv(const char *name)
 
 	return ret;
 }
+
+#ifdef CONFIG_POSIX_PROCESS_DOMAINS
+int z_env_dup(char ***env)
+{
+	int ret = 0;
+	size_t esize;
+	size_t tsize;
+	char **vars;
+	char **copy = NULL;
+
+	SYS_SEM_LOCK(&environ_lock) {
+		vars = *environ_get();
+		esize = environ_size(vars);
+		if (esize == 0) {
+			SYS_SEM_LOCK_BREAK;
+		}
+
+		copy = calloc(esize + 1 /* NULL */, sizeof(void *));
+		if (copy == NULL) {
+			ret = -ENOMEM;
+			SYS_SEM_LOCK_BREAK;
+		}
+
+		if (TRACK_ALLOC) {
+			allocated += (esize + 1) * sizeof(void *);
+		}
+
+		for (size_t i = 0; i < esize; ++i) {
+			tsize = strlen(vars[i]) + 1;
+			copy[i] = malloc(tsize);
+			if (copy[i] == NULL) {
+				if (TRACK_ALLOC) {
+					/* z_env_free() only sees the entries before this one */
+					allocated -= (esize - i) * sizeof(void *);
+				}
+				ret = -ENOMEM;
+				break;
+			}
+
+			if (TRACK_ALLOC) {
+				allocated += tsize;
+			}
+			strcpy(copy[i], vars[i]);
+		}
+	}
+
+	if (ret < 0) {
+		z_env_free(&copy);
+		return ret;
+	}
+
+	*env = copy;
+
+	return 0;
+}
+
+void z_env_free(char ***env)
+{
+	char **vars = *env;
+
+	if (vars == NULL) {
+		return;
+	}
+
+	SYS_SEM_LOCK(&environ_lock) {
+		if (TRACK_ALLOC) {
+			allocated -= (environ_size(vars) + 1 /* NULL */) * sizeof(void *);
+		}
+
+		for (char **envp = vars; *envp != NULL; ++envp) {
+			if (TRACK_ALLOC) {
+				allocated -= strlen(*envp) + 1;
+			}
+			free(*envp);
+		}
+		free(vars);
+	}
+
+	*env = NULL;
+}
+#endif /* CONFIG_POSIX_PROCESS_DOMAINS */
@@ -0,0 +1,71 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_POSIX_OPTIONS_SHARED_FADVISE_PRIV_H_
+#define ZEPHYR_LIB_POSIX_OPTIONS_SHARED_FADVISE_PRIV_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+#include <zephyr/toolchain.h>
+
+#if defined(CONFIG_POSIX_ADVISORY_INFO) && !defined(CONFIG_TC_PROVIDES_POSIX_ADVISORY_INFO)
+
+/*
+ * Serve a read through the readahead cache.
+ *
+ * Returns false if @p fd has no advice attached, in which case the caller performs the read
+ * itself. Otherwise, the result of the read is stored in @p ret.
+ */
+bool posix_fadv_read(int fd, void *buf, size_t sz, const size_t *from_offset, ssize_t *ret);
+
+/* Drop cached data for @p fd after it has been modified (@p len of 0 means to end of file) */
+void posix_fadv_invalidate(int fd, off_t offset, off_t len);
+
+/*
+ * Record that @p fd was just opened as @p path, so that writes to the file through other
+ * descriptors drop what was cached through it.
+ */
+void posix_fadv_open(int fd, const char *path);
+
+/* Forget any advice attached to @p fd before it is closed */
+void posix_fadv_close(int fd);
+
+#else
+
+static inline bool posix_fadv_read(int fd, void *buf, size_t sz, const size_t *from_offset,
+				   ssize_t *ret)
+{
+	ARG_UNUSED(fd);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(sz);
+	ARG_UNUSED(from_offset);
+	ARG_UNUSED(ret);
+
+	return false;
+}
+
+static inline void posix_fadv_invalidate(int fd, off_t offset, off_t len)
+{
+	ARG_UNUSED(fd);
+	ARG_UNUSED(offset);
+	ARG_UNUSED(len);
+}
+
+static inline void posix_fadv_open(int fd, const char *path)
+{
+	ARG_UNUSED(fd);
+	ARG_UNUSED(path);
+}
+
+static inline void posix_fadv_close(int fd)
+{
+	ARG_UNUSED(fd);
+}
+
+#endif
+
+#endif /* ZEPHYR_LIB_POSIX_OPTIONS_SHARED_FADVISE_PRIV_H_ */
@@ -0,0 +1,72 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/sys/zvfs.h>
+
+#include "posix_internal.h"
+
+static int posix_fd_zero_fill(int fd, off_t length)
+{
+	size_t off;
+	size_t len;
+	ssize_t ret;
+	struct zvfs_stat zs;
+	static const uint8_t zeros[CONFIG_POSIX_FD_ZERO_FILL_SIZE];
+
+	if (zvfs_fstat(fd, &zs) < 0) {
+		return -1;
+	}
+
+	if (((zs.mode & ZVFS_MODE_IFMT) != ZVFS_MODE_IFREG) || (length < (off_t)zs.size)) {
+		/* only growth of regular files can be emulated */
+		errno = ENOTSUP;
+		return -1;
+	}
+
+	for (off = zs.size; off < (size_t)length;) {
+		/* the first write completes the last block, so that the others each write a block */
+		len = MIN(sizeof(zeros) - off % sizeof(zeros), length - off);
+		ret = zvfs_write_offset(fd, zeros, len, &off);
+		if (ret < 0) {
+			return -1;
+		}
+
+		if (ret == 0) {
+			errno = ENOSPC;
+			return -1;
+		}
+
+		off += ret;
+	}
+
+	return 0;
+}
+
+/*
+ * Resize the file referred to by @p fd to @p length bytes.
+ *
+ * Backends that support it grow the file natively with a single truncate operation, which lets
+ * e.g. FAT and littlefs allocate the new region in one pass rather than on every append. If the
+ * backend does not support truncation, growth of a regular file falls back to writing zeros.
+ * The file position is unchanged in either case.
+ */
+int posix_fd_resize(int fd, off_t length)
+{
+	if (zvfs_ftruncate(fd, length) == 0) {
+		return 0;
+	}
+
+	if ((errno != ENOTSUP) && (errno != ENOSYS)) {
+		return -1;
+	}
+
+	return posix_fd_zero_fill(fd, length);
+}
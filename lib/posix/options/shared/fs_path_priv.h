@@ -0,0 +1,52 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_POSIX_OPTIONS_SHARED_FS_PATH_PRIV_H_
+#define ZEPHYR_LIB_POSIX_OPTIONS_SHARED_FS_PATH_PRIV_H_
+
+#include <errno.h>
+#include <fcntl.h>
+
+#include <zephyr/sys/zvfs_fs.h>
+#include <zephyr/toolchain.h>
+
+#if defined(CONFIG_POSIX_FILE_SYSTEM) && !defined(CONFIG_TC_PROVIDES_POSIX_FILE_SYSTEM)
+
+/*
+ * Resolve @p path relative to the directory file descriptor @p fd, or to the current working
+ * directory if @p fd is AT_FDCWD.
+ *
+ * Returns the absolute path to pass to the Zephyr file system API, which is either @p path
+ * itself (if it is already absolute and canonical) or @p buf (of at least PATH_MAX bytes). On
+ * failure, NULL is returned and errno is set.
+ */
+const char *posix_path_at(int fd, const char *path, char *buf);
+
+/* Open @p path relative to @p fd, as for openat() */
+int posix_open_at(int fd, const char *path, int flags, int mode);
+
+#else
+
+static inline const char *posix_path_at(int fd, const char *path, char *buf)
+{
+	ARG_UNUSED(fd);
+	ARG_UNUSED(buf);
+
+	return path;
+}
+
+static inline int posix_open_at(int fd, const char *path, int flags, int mode)
+{
+	if (fd != AT_FDCWD) {
+		errno = ENOTSUP;
+		return -1;
+	}
+
+	return zvfs_open(path, flags, mode);
+}
+
+#endif
+
+#endif /* ZEPHYR_LIB_POSIX_OPTIONS_SHARED_FS_PATH_PRIV_H_ */
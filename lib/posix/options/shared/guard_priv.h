@@ -0,0 +1,64 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_POSIX_OPTIONS_SHARED_GUARD_PRIV_H_
+#define ZEPHYR_LIB_POSIX_OPTIONS_SHARED_GUARD_PRIV_H_
+
+#include "posix_internal.h"
+
+#include <stddef.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/toolchain.h>
+
+#if defined(CONFIG_POSIX_THREAD_GUARD) && !defined(CONFIG_TC_PROVIDES_POSIX_THREADS_EXT)
+
+/*
+ * Get the size of the stack to allocate for a thread created with @p attr, which includes its
+ * guard area unless the stack is provided by the application.
+ */
+size_t posix_thread_guard_stack_size(const struct posix_thread_attr *attr);
+
+/* Start checking the guard area of the new @p thread, if @p attr asked for one */
+void posix_thread_guard_arm(struct k_thread *thread, const struct posix_thread_attr *attr);
+
+/* Check the guard area of @p thread a last time and stop checking it, as the thread exits */
+void posix_thread_guard_exit(struct k_thread *thread);
+
+#else
+
+static inline size_t posix_thread_guard_stack_size(const struct posix_thread_attr *attr)
+{
+	return attr->stacksize;
+}
+
+static inline void posix_thread_guard_arm(struct k_thread *thread,
+					  const struct posix_thread_attr *attr)
+{
+	ARG_UNUSED(thread);
+	ARG_UNUSED(attr);
+}
+
+static inline void posix_thread_guard_exit(struct k_thread *thread)
+{
+	ARG_UNUSED(thread);
+}
+
+#endif
+
+#if defined(CONFIG_POSIX_THREAD_GUARD_SWITCH_OUT) && !defined(CONFIG_TC_PROVIDES_POSIX_THREADS_EXT)
+
+/* Check the guard area of the thread that is being switched out, with the scheduler locked */
+void posix_thread_guard_switched_out(void);
+
+#else
+
+static inline void posix_thread_guard_switched_out(void)
+{
+}
+
+#endif
+
+#endif /* ZEPHYR_LIB_POSIX_OPTIONS_SHARED_GUARD_PRIV_H_ */
@@ -0,0 +1,66 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_POSIX_OPTIONS_SHARED_ITIMER_PRIV_H_
+#define ZEPHYR_LIB_POSIX_OPTIONS_SHARED_ITIMER_PRIV_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/toolchain.h>
+
+#if defined(CONFIG_XSI_TIMERS) && !defined(CONFIG_TC_PROVIDES_XSI_TIMERS)
+
+/*
+ * Disarm ITIMER_REAL, which shares SIGALRM with alarm(), and return the number of ticks that
+ * remained until it expired, or 0 if it was not armed or if called from user mode.
+ */
+k_ticks_t posix_itimer_real_cancel(void);
+
+#else
+
+static inline k_ticks_t posix_itimer_real_cancel(void)
+{
+	return 0;
+}
+
+#endif
+
+#if defined(CONFIG_XSI_TIMERS) && defined(CONFIG_POSIX_THREADS) &&                                 \
+	!defined(CONFIG_TC_PROVIDES_XSI_TIMERS)
+
+/* Called by a pthread when it starts to run */
+void posix_itimer_thread_start(void);
+
+/*
+ * Called by a pthread when it exits, so that the CPU time it used still counts towards ITIMER_PROF
+ * once it is gone.
+ */
+void posix_itimer_thread_exit(void);
+
+#else
+
+static inline void posix_itimer_thread_start(void)
+{
+}
+
+static inline void posix_itimer_thread_exit(void)
+{
+}
+
+#endif
+
+#if defined(CONFIG_XSI_TIMERS_SWITCH_OUT) && !defined(CONFIG_TC_PROVIDES_XSI_TIMERS)
+
+/* Start the CPU timers again that were stopped while no thread of their process could run */
+void posix_itimer_switched_out(void);
+
+#else
+
+static inline void posix_itimer_switched_out(void)
+{
+}
+
+#endif
+
+#endif /* ZEPHYR_LIB_POSIX_OPTIONS_SHARED_ITIMER_PRIV_H_ */
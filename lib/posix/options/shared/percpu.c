@@ -0,0 +1,97 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "percpu_priv.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+static struct k_spinlock percpu_lock;
+static size_t percpu_used;
+static uint8_t percpu_area[CONFIG_MP_MAX_NUM_CPUS][POSIX_PERCPU_STRIDE] __aligned(
+	POSIX_PERCPU_ALIGN);
+
+void *posix_percpu_alloc(size_t size, size_t align)
+{
+	size_t offset;
+	void *ptr = NULL;
+
+	if ((align == 0) || !IS_POWER_OF_TWO(align) || (align > POSIX_PERCPU_ALIGN)) {
+		return NULL;
+	}
+
+	K_SPINLOCK(&percpu_lock) {
+		offset = ROUND_UP(percpu_used, align);
+		if ((offset > sizeof(percpu_area[0])) || (size > sizeof(percpu_area[0]) - offset)) {
+			K_SPINLOCK_BREAK;
+		}
+
+		percpu_used = offset + size;
+		ptr = &percpu_area[0][offset];
+	}
+
+	return ptr;
+}
+
+void posix_percpu_foreach(void *ptr, void (*fn)(unsigned int cpu, void *data, void *user_data),
+			  void *user_data)
+{
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); ++cpu) {
+		fn(cpu, posix_percpu_get(ptr, cpu), user_data);
+	}
+}
+
+#ifdef CONFIG_POSIX_STATS
+
+static atomic_t *posix_stats;
+
+static const char *const posix_stat_names[] = {
+	[POSIX_STAT_POOL_ALLOC] = "pool_alloc",
+	[POSIX_STAT_POOL_FAIL] = "pool_fail",
+	[POSIX_STAT_POOL_FREE] = "pool_free",
+	[POSIX_STAT_SIG_SENT] = "sig_sent",
+	[POSIX_STAT_SIG_CAUGHT] = "sig_caught",
+};
+BUILD_ASSERT(ARRAY_SIZE(posix_stat_names) == POSIX_STAT_NUM);
+
+void posix_stat_inc(enum posix_stat stat)
+{
+	/* the per-CPU areas are not accessible from user mode */
+	if ((posix_stats == NULL) || k_is_user_context()) {
+		return;
+	}
+
+	posix_percpu_add(&posix_stats[stat], 1);
+}
+
+atomic_val_t posix_stat_get(enum posix_stat stat, unsigned int cpu)
+{
+	if ((posix_stats == NULL) || (cpu >= arch_num_cpus())) {
+		return 0;
+	}
+
+	return atomic_get(posix_percpu_get(&posix_stats[stat], cpu));
+}
+
+const char *posix_stat_name(enum posix_stat stat)
+{
+	return posix_stat_names[stat];
+}
+
+static int posix_stats_init(void)
+{
+	posix_stats = posix_percpu_alloc(POSIX_STAT_NUM * sizeof(atomic_t), __alignof__(atomic_t));
+	__ASSERT(posix_stats != NULL, "CONFIG_POSIX_PERCPU_SIZE is too small for the statistics");
+
+	return 0;
+}
+SYS_INIT(posix_stats_init, PRE_KERNEL_1, 0);
+
+#endif /* CONFIG_POSIX_STATS */
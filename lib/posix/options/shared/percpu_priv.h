@@ -0,0 +1,148 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_POSIX_OPTIONS_SHARED_PERCPU_PRIV_H_
+#define ZEPHYR_LIB_POSIX_OPTIONS_SHARED_PERCPU_PRIV_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/toolchain.h>
+
+/*
+ * Per-CPU data is allocated at the same offset in the area of every CPU, and is referred to by a
+ * pointer to the copy of CPU 0. The areas are placed in different data cache lines, so that CPUs
+ * updating their own copy do not contend.
+ *
+ * The CPU of a thread that can migrate may change as soon as it has been read, so per-CPU data is
+ * either updated atomically, which is cheap without contention and correct on any CPU, or with the
+ * thread pinned to its CPU by posix_percpu_pin().
+ */
+
+#if defined(CONFIG_DCACHE_LINE_SIZE) && (CONFIG_DCACHE_LINE_SIZE > 0)
+#define POSIX_PERCPU_ALIGN CONFIG_DCACHE_LINE_SIZE
+#else
+#define POSIX_PERCPU_ALIGN 64
+#endif
+
+enum posix_stat {
+	POSIX_STAT_POOL_ALLOC,
+	POSIX_STAT_POOL_FAIL,
+	POSIX_STAT_POOL_FREE,
+	POSIX_STAT_SIG_SENT,
+	POSIX_STAT_SIG_CAUGHT,
+	POSIX_STAT_NUM,
+};
+
+#ifdef CONFIG_POSIX_PERCPU
+
+#define POSIX_PERCPU_STRIDE ROUND_UP(CONFIG_POSIX_PERCPU_SIZE, POSIX_PERCPU_ALIGN)
+
+/*
+ * Allocate @p size bytes aligned to @p align in the area of every CPU. The copies are zeroed, and
+ * are never freed. Returns the copy of CPU 0, or NULL if the areas are full.
+ */
+void *posix_percpu_alloc(size_t size, size_t align);
+
+/* Call @p fn with the copy of every CPU of the per-CPU data @p ptr */
+void posix_percpu_foreach(void *ptr, void (*fn)(unsigned int cpu, void *data, void *user_data),
+			  void *user_data);
+
+/* Get the copy of @p cpu of the per-CPU data @p ptr */
+static inline void *posix_percpu_get(void *ptr, unsigned int cpu)
+{
+	return (uint8_t *)ptr + cpu * POSIX_PERCPU_STRIDE;
+}
+
+#endif /* CONFIG_POSIX_PERCPU */
+
+/*
+ * Get the CPU that runs the caller, which is 0 for threads in user mode, since they can not read
+ * it. The result is only stable while the caller is pinned.
+ */
+static inline unsigned int posix_percpu_cpu(void)
+{
+#ifdef CONFIG_SMP
+	if (k_is_user_context()) {
+		return 0;
+	}
+
+	return arch_curr_cpu()->id;
+#else
+	return 0;
+#endif
+}
+
+#ifdef CONFIG_POSIX_PERCPU
+
+/*
+ * Pin the calling thread to its CPU by locking interrupts, and get the copy of that CPU of the
+ * per-CPU data @p ptr. Not for threads in user mode.
+ */
+static inline void *posix_percpu_pin(void *ptr, unsigned int *key)
+{
+	*key = arch_irq_lock();
+
+	return posix_percpu_get(ptr, posix_percpu_cpu());
+}
+
+/* Undo posix_percpu_pin() */
+static inline void posix_percpu_unpin(unsigned int key)
+{
+	arch_irq_unlock(key);
+}
+
+/* Add @p value to the copy of the calling CPU of the per-CPU counter @p counter */
+static inline void posix_percpu_add(atomic_t *counter, atomic_val_t value)
+{
+	(void)atomic_add(posix_percpu_get(counter, posix_percpu_cpu()), value);
+}
+
+/* Get the sum of the copies of every CPU of the per-CPU counter @p counter */
+static inline atomic_val_t posix_percpu_sum(atomic_t *counter)
+{
+	atomic_val_t sum = 0;
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); ++cpu) {
+		sum += atomic_get(posix_percpu_get(counter, cpu));
+	}
+
+	return sum;
+}
+
+#endif /* CONFIG_POSIX_PERCPU */
+
+#ifdef CONFIG_POSIX_STATS
+
+/* Count an event of the POSIX layer */
+void posix_stat_inc(enum posix_stat stat);
+
+/* Get the count of @p stat on @p cpu */
+atomic_val_t posix_stat_get(enum posix_stat stat, unsigned int cpu);
+
+/* Get the name of @p stat */
+const char *posix_stat_name(enum posix_stat stat);
+
+#else
+
+static inline void posix_stat_inc(enum posix_stat stat)
+{
+	ARG_UNUSED(stat);
+}
+
+static inline atomic_val_t posix_stat_get(enum posix_stat stat, unsigned int cpu)
+{
+	ARG_UNUSED(stat);
+	ARG_UNUSED(cpu);
+
+	return 0;
+}
+
+#endif /* CONFIG_POSIX_STATS */
+
+#endif /* ZEPHYR_LIB_POSIX_OPTIONS_SHARED_PERCPU_PRIV_H_ */
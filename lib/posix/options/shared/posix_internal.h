@@ -16,11 +16,13 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <signal.h>
+#include <sys/types.h>
 
 #include <zephyr/kernel.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/toolchain.h>
 #include <pthread.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/sys/dlist.h>
 #include <zephyr/sys/elastipool.h>
 #include <zephyr/sys/slist.h>
@@ -49,7 +51,7 @@ struct posix_thread_attr {
 	size_t stacksize;
 	size_t guardsize;
 	union {
-		uint16_t: 16;
+		uint32_t: 32;
 		struct {
 			int8_t priority;
 			uint8_t schedpolicy: 2;
@@ -59,6 +61,8 @@ struct posix_thread_attr {
 			bool detachstate: 1;
 			bool inheritsched: 1;
 			bool initialized: 1;
+			/* 1 + index of the sporadic server parameters, or 0 */
+			uint8_t ss_params;
 		};
 	};
 };
@@ -75,6 +79,12 @@ BUILD_ASSERT(sizeof(pthread_mutexattr_t) >= sizeof(struct pthread_mutexattr));
 
 static inline bool valid_posix_policy(int policy)
 {
+#ifdef CONFIG_POSIX_THREAD_SPORADIC_SERVER
+	if (policy == SCHED_SPORADIC) {
+		return true;
+	}
+#endif
+
 	return policy == SCHED_FIFO || policy == SCHED_RR || policy == SCHED_OTHER;
 }
 
@@ -97,6 +107,12 @@ static inline int posix_sched_priority_max(int policy)
 		return CONFIG_NUM_PREEMPT_PRIORITIES - 1;
 	}
 
+#ifdef CONFIG_POSIX_THREAD_SPORADIC_SERVER
+	if (policy == SCHED_SPORADIC) {
+		return CONFIG_NUM_PREEMPT_PRIORITIES - 1;
+	}
+#endif
+
 	errno = EINVAL;
 	return -1;
 }
@@ -120,38 +136,51 @@ static inline bool posix_thread_attr_is_valid(const struct posix_thread_attr *at
 	return true;
 }
 
-/* get a pointer to a pool object that has already been allocated using handle */
-void *posix_get_pool_obj_unlocked(const struct sys_elastipool *pool, uint32_t handle);
-/* get a pointer to a pool object if already initialized, otherwise, initialize a new one */
-void *posix_init_pool_obj_unlocked(const struct sys_elastipool *pool, uint32_t handle,
-				   void (*cb)(void *obj));
-
-static inline void *posix_get_pool_obj(const struct sys_elastipool *pool, struct sys_sem *lock,
-				       uint32_t handle)
-{
-	void *ret = NULL;
-
-	SYS_SEM_LOCK(lock) {
-		ret = posix_get_pool_obj_unlocked(pool, handle);
-	}
-
-	return (void *)ret;
-}
-
-static inline void *posix_init_pool_obj(const struct sys_elastipool *pool, struct sys_sem *lock,
-					uint32_t handle, void (*cb)(void *obj))
-{
-	void *ret = NULL;
+/*
+ * Pool-backed objects (barriers, read-write locks and spin locks) are referred to by handles that
+ * combine the index of the slot of an object with the generation of that slot, which advances
+ * whenever an object is allocated in or freed from the slot. Looking up a handle is wait-free and
+ * fails for the handle of an object that has been destroyed, even once its slot has been reused.
+ * The lock of a pool is only taken to allocate and free objects.
+ */
+struct posix_pool {
+	const struct sys_elastipool *pool;
+	struct sys_sem *lock;
+	/* generation of each slot, odd while an object is allocated in it */
+	atomic_t *gen;
+};
 
-	SYS_SEM_LOCK(lock) {
-		ret = posix_init_pool_obj_unlocked(pool, handle, cb);
+#define POSIX_POOL_INDEX_BITS 16
+#define POSIX_POOL_INDEX_MASK BIT_MASK(POSIX_POOL_INDEX_BITS)
+
+/* define a pool of @p count objects of type @p type */
+#define POSIX_POOL_DEFINE(name, type, count)                                                       \
+	BUILD_ASSERT((count) < POSIX_POOL_INDEX_MASK, "too many objects for a posix_pool");        \
+	static SYS_SEM_DEFINE(_posix_pool_lock_##name, 1, 1);                                      \
+	SYS_ELASTIPOOL_DEFINE_STATIC(_posix_pool_storage_##name, sizeof(type), __alignof(type),    \
+				     (count), (count));                                             \
+	static atomic_t _posix_pool_gen_##name[(count)];                                           \
+	static const struct posix_pool name = {                                                    \
+		.pool = &_posix_pool_storage_##name,                                               \
+		.lock = &_posix_pool_lock_##name,                                                  \
+		.gen = _posix_pool_gen_##name,                                                     \
 	}
 
-	return (void *)ret;
-}
+/* allocate an object and its handle, returning NULL if the pool is exhausted */
+void *posix_pool_alloc(const struct posix_pool *pool, uint32_t *handle);
+/* get the object referred to by @p handle, or NULL if it has not been allocated */
+void *posix_pool_get(const struct posix_pool *pool, uint32_t handle);
+/*
+ * Free the object referred to by @p handle, if @p check (optional) does not return an error
+ * number for it. Returns EINVAL if @p handle does not refer to an allocated object.
+ */
+int posix_pool_free(const struct posix_pool *pool, uint32_t handle, int (*check)(void *obj));
 
 struct posix_thread *to_posix_thread(pthread_t pth);
 
+/* true if @p thread was created by pthread_create(); only known with CONFIG_THREAD_MONITOR */
+bool posix_is_pthread(const struct k_thread *thread);
+
 /* get and possibly initialize a posix_mutex */
 struct k_mutex *to_posix_mutex(pthread_mutex_t *mu);
 
@@ -292,4 +321,6 @@ struct timeval;
 struct timespec;
 bool timeval_to_timespec(const struct timeval *tv, struct timespec *ts);
 
+int posix_fd_resize(int fd, off_t length);
+
 #endif
@@ -4,56 +4,97 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "percpu_priv.h"
 #include "posix_internal.h"
 
+#include <errno.h>
 #include <stddef.h>
 #include <stdint.h>
 
+#include <zephyr/sys/atomic.h>
 #include <zephyr/sys/elastipool.h>
+#include <zephyr/sys/sem.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/toolchain.h>
 
-void *posix_get_pool_obj_unlocked(const struct sys_elastipool *pool, uint32_t handle)
+/*
+ * A handle holds the index of a slot in its low POSIX_POOL_INDEX_BITS and the low bits of the
+ * (odd) generation of the slot above them. Since the number of slots is less than
+ * POSIX_POOL_INDEX_MASK, no handle is equal to POSIX_OBJ_INITIALIZER, and since the generation is
+ * odd, no handle is zero.
+ */
+
+static inline size_t posix_pool_stride(const struct posix_pool *pool)
 {
-	uintptr_t ret;
-
-	if (sizeof(ret) == sizeof(handle)) {
-		ret = handle;
-	} else if (sizeof(ret) == 2 * sizeof(handle)) {
-		/* assumption is that the heap lies in the same 32-bit address range */
-		ret = (uintptr_t)pool->config->storage;
-		ret &= 0xffffffff00000000ULL;
-		ret |= handle;
-	} else {
-		/* unsupported size */
-		return NULL;
-	}
+	return ROUND_UP(pool->pool->config->obj_size, pool->pool->config->obj_align);
+}
+
+static inline uint32_t posix_pool_handle(size_t idx, atomic_val_t gen)
+{
+	return ((uint32_t)gen << POSIX_POOL_INDEX_BITS) | idx;
+}
+
+void *posix_pool_alloc(const struct posix_pool *pool, uint32_t *handle)
+{
+	size_t idx;
+	void *obj = NULL;
 
-	if (sys_elastipool_check(pool, (void *)ret) < 0) {
-		/* object is uninitialized */
-		ret = 0; /* NULL */
+	SYS_SEM_LOCK(pool->lock) {
+		if (sys_elastipool_alloc(pool->pool, &obj) < 0) {
+			obj = NULL;
+			SYS_SEM_LOCK_BREAK;
+		}
+
+		idx = ((uint8_t *)obj - pool->pool->config->storage) / posix_pool_stride(pool);
+		*handle = posix_pool_handle(idx, atomic_inc(&pool->gen[idx]) + 1);
 	}
 
-	return (void *)ret;
+	posix_stat_inc((obj == NULL) ? POSIX_STAT_POOL_FAIL : POSIX_STAT_POOL_ALLOC);
+
+	return obj;
 }
 
-void *posix_init_pool_obj_unlocked(const struct sys_elastipool *pool, uint32_t handle,
-				   void (*cb)(void *obj))
+void *posix_pool_get(const struct posix_pool *pool, uint32_t handle)
 {
-	if (handle != POSIX_OBJ_INITIALIZER) {
-		return posix_get_pool_obj_unlocked(pool, handle);
-	}
+	atomic_val_t gen;
+	size_t idx = handle & POSIX_POOL_INDEX_MASK;
 
-	uintptr_t obj = 0;
+	if (idx >= pool->pool->config->min_obj) {
+		return NULL;
+	}
 
-	if (sys_elastipool_alloc(pool, (void **)&obj) < 0) {
-		/* no objects left to allocate */
+	gen = atomic_get(&pool->gen[idx]);
+	if (((gen & 1) == 0) || (posix_pool_handle(idx, gen) != handle)) {
 		return NULL;
 	}
 
-	if ((obj != 0) && (cb != NULL)) {
-		cb((void *)obj);
+	return pool->pool->config->storage + idx * posix_pool_stride(pool);
+}
+
+int posix_pool_free(const struct posix_pool *pool, uint32_t handle, int (*check)(void *obj))
+{
+	int err;
+	void *obj;
+	int ret = EINVAL;
+
+	SYS_SEM_LOCK(pool->lock) {
+		obj = posix_pool_get(pool, handle);
+		if (obj == NULL) {
+			SYS_SEM_LOCK_BREAK;
+		}
+
+		ret = (check == NULL) ? 0 : check(obj);
+		if (ret != 0) {
+			SYS_SEM_LOCK_BREAK;
+		}
+
+		/* invalidate outstanding handles before the slot can be reused */
+		(void)atomic_inc(&pool->gen[handle & POSIX_POOL_INDEX_MASK]);
+		err = sys_elastipool_free(pool->pool, obj);
+		__ASSERT_NO_MSG(err == 0);
+		ARG_UNUSED(err);
+		posix_stat_inc(POSIX_STAT_POOL_FREE);
 	}
 
-	return (void *)obj;
+	return ret;
 }
@@ -0,0 +1,29 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_POSIX_OPTIONS_SHARED_SCHED_PRIV_H_
+#define ZEPHYR_LIB_POSIX_OPTIONS_SHARED_SCHED_PRIV_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/toolchain.h>
+
+#if defined(CONFIG_POSIX_PRIORITY_SCHEDULING) && !defined(CONFIG_TC_PROVIDES_POSIX_PRIORITY_SCHEDULING)
+
+/*
+ * Apply the round-robin interval configured for the current priority of @p thread to it. Called
+ * whenever a POSIX thread is created or its priority is changed.
+ */
+void posix_sched_thread_update(struct k_thread *thread);
+
+#else
+
+static inline void posix_sched_thread_update(struct k_thread *thread)
+{
+	ARG_UNUSED(thread);
+}
+
+#endif
+
+#endif /* ZEPHYR_LIB_POSIX_OPTIONS_SHARED_SCHED_PRIV_H_ */
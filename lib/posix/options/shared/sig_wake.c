@@ -0,0 +1,113 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sig_wake_priv.h"
+
+#include <stdbool.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/signal.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/util.h>
+
+static struct k_spinlock sig_wake_lock;
+static sys_dlist_t sig_waiters = SYS_DLIST_STATIC_INIT(&sig_waiters);
+
+/* the thread that armed the alarm, which k_sig_alarm() signals */
+static struct k_thread *sig_alarm_target;
+
+static void sig_wake(struct k_thread *thread, int signo)
+{
+	struct posix_sig_waiter *w;
+	const bool isr = k_is_in_isr();
+
+	/* a waiter that is woken from a thread runs as soon as the scheduler is unlocked */
+	if (!isr) {
+		k_sched_lock();
+	}
+
+	K_SPINLOCK(&sig_wake_lock) {
+		SYS_DLIST_FOR_EACH_CONTAINER(&sig_waiters, w, node) {
+			if (w->thread == thread) {
+				(void)k_poll_signal_raise(&w->wake, signo);
+			}
+		}
+	}
+
+	if (!isr) {
+		k_sched_unlock();
+	}
+}
+
+static void sig_alarm_expiry(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	sig_wake(sig_alarm_target, K_SIG_ALRM);
+}
+
+/* started after the alarm of the kernel, so that it expires after it */
+static K_TIMER_DEFINE(sig_alarm_timer, sig_alarm_expiry, NULL);
+
+void posix_sig_waiter_add(struct posix_sig_waiter *w)
+{
+	w->thread = k_current_get();
+	k_poll_signal_init(&w->wake);
+	sys_dnode_init(&w->node);
+
+	/* a waiter registered from a signal handler takes precedence */
+	K_SPINLOCK(&sig_wake_lock) {
+		sys_dlist_prepend(&sig_waiters, &w->node);
+	}
+}
+
+void posix_sig_waiter_remove(struct posix_sig_waiter *w)
+{
+	K_SPINLOCK(&sig_wake_lock) {
+		sys_dlist_remove(&w->node);
+	}
+}
+
+struct posix_sig_waiter *posix_sig_waiter_current(void)
+{
+	struct posix_sig_waiter *w;
+	struct posix_sig_waiter *found = NULL;
+	struct k_thread *thread = k_current_get();
+
+	K_SPINLOCK(&sig_wake_lock) {
+		SYS_DLIST_FOR_EACH_CONTAINER(&sig_waiters, w, node) {
+			if (w->thread == thread) {
+				found = w;
+				break;
+			}
+		}
+	}
+
+	return found;
+}
+
+int posix_sig_queue(struct k_thread *thread, int signo, union k_sig_val val)
+{
+	int ret = k_sig_queue((k_pid_t)thread, signo, val);
+
+	if (ret == 0) {
+		sig_wake(thread, signo);
+	}
+
+	return ret;
+}
+
+k_ticks_t posix_sig_alarm(k_timeout_t timeout)
+{
+	k_ticks_t remaining = k_sig_alarm(timeout);
+
+	k_timer_stop(&sig_alarm_timer);
+	if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		sig_alarm_target = k_current_get();
+		k_timer_start(&sig_alarm_timer, timeout, K_NO_WAIT);
+	}
+
+	return remaining;
+}
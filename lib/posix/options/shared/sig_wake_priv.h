@@ -0,0 +1,56 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_POSIX_OPTIONS_SHARED_SIG_WAKE_PRIV_H_
+#define ZEPHYR_LIB_POSIX_OPTIONS_SHARED_SIG_WAKE_PRIV_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/dlist.h>
+
+#ifdef CONFIG_SIGNAL
+
+#include <zephyr/kernel/signal.h>
+
+/*
+ * A thread that is blocked in a wait that a signal should interrupt, such as pselect() or ppoll().
+ *
+ * Signals are only delivered to a thread when it returns from a system call, so a thread that is
+ * blocked is not woken by the kernel when a signal is generated for it. Instead, each signal that
+ * the POSIX layer generates for a thread raises @p wake for each waiter of that thread, which the
+ * thread includes in the events that it waits for.
+ */
+struct posix_sig_waiter {
+	sys_dnode_t node;
+	struct k_thread *thread;
+	struct k_poll_signal wake;
+};
+
+/*
+ * Register @p w for the calling thread, until posix_sig_waiter_remove(). @p w must stay valid
+ * until then, and is usually on the stack of the thread.
+ */
+void posix_sig_waiter_add(struct posix_sig_waiter *w);
+
+/* Stop raising the wake signal of @p w */
+void posix_sig_waiter_remove(struct posix_sig_waiter *w);
+
+/* The waiter most recently registered by the calling thread, or NULL if there is none */
+struct posix_sig_waiter *posix_sig_waiter_current(void);
+
+/*
+ * Queue signal @p signo with value @p val for @p thread, as k_sig_queue() does, and wake @p thread
+ * if it is waiting. Returns 0 or a negative errno value, as k_sig_queue().
+ */
+int posix_sig_queue(struct k_thread *thread, int signo, union k_sig_val val);
+
+/*
+ * Arm the alarm of the calling thread, as k_sig_alarm() does, and wake the thread when the alarm
+ * signal is generated. Returns the number of ticks that remained on the previous alarm.
+ */
+k_ticks_t posix_sig_alarm(k_timeout_t timeout);
+
+#endif /* CONFIG_SIGNAL */
+
+#endif /* ZEPHYR_LIB_POSIX_OPTIONS_SHARED_SIG_WAKE_PRIV_H_ */
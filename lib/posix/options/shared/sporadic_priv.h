@@ -0,0 +1,117 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_POSIX_OPTIONS_SHARED_SPORADIC_PRIV_H_
+#define ZEPHYR_LIB_POSIX_OPTIONS_SHARED_SPORADIC_PRIV_H_
+
+#include "posix_internal.h"
+
+#include <sched.h>
+#include <stdbool.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/toolchain.h>
+
+struct posix_sporadic;
+
+#if defined(CONFIG_POSIX_THREAD_SPORADIC_SERVER) &&                                                \
+	!defined(CONFIG_TC_PROVIDES_POSIX_THREAD_SPORADIC_SERVER)
+
+/* Store the sporadic server parameters of @p param in @p attr. Returns 0 or an error number. */
+int posix_sporadic_attr_set(struct posix_thread_attr *attr, const struct sched_param *param);
+
+/* Get the sporadic server parameters stored in @p attr, if any */
+void posix_sporadic_attr_get(const struct posix_thread_attr *attr, struct sched_param *param);
+
+/* Release the sporadic server parameters stored in @p attr */
+void posix_sporadic_attr_destroy(struct posix_thread_attr *attr);
+
+/*
+ * Reserve a server for a thread that is about to be created with @p attr, so that creating the
+ * thread does not fail once it has started. @p ss is set to NULL if @p attr does not ask for
+ * SCHED_SPORADIC. Returns 0 or an error number.
+ */
+int posix_sporadic_reserve(const struct posix_thread_attr *attr, struct posix_sporadic **ss);
+
+/* Start the reserved server @p ss for the new @p thread, or release it if @p thread is NULL */
+void posix_sporadic_start(struct posix_sporadic *ss, struct k_thread *thread);
+
+/*
+ * Apply @p policy and @p param to @p thread, starting, updating, or stopping its server as needed.
+ * Returns 0 or an error number.
+ */
+int posix_sporadic_set(struct k_thread *thread, int policy, const struct sched_param *param);
+
+/* If @p thread is a sporadic server, get its parameters and return true */
+bool posix_sporadic_get(struct k_thread *thread, struct sched_param *param);
+
+/* Stop the server of @p thread, if any, before it exits */
+void posix_sporadic_exit(struct k_thread *thread);
+
+#else
+
+static inline int posix_sporadic_attr_set(struct posix_thread_attr *attr,
+					  const struct sched_param *param)
+{
+	ARG_UNUSED(attr);
+	ARG_UNUSED(param);
+
+	return EINVAL;
+}
+
+static inline void posix_sporadic_attr_get(const struct posix_thread_attr *attr,
+					   struct sched_param *param)
+{
+	ARG_UNUSED(attr);
+	ARG_UNUSED(param);
+}
+
+static inline void posix_sporadic_attr_destroy(struct posix_thread_attr *attr)
+{
+	ARG_UNUSED(attr);
+}
+
+static inline int posix_sporadic_reserve(const struct posix_thread_attr *attr,
+					 struct posix_sporadic **ss)
+{
+	ARG_UNUSED(attr);
+
+	*ss = NULL;
+
+	return 0;
+}
+
+static inline void posix_sporadic_start(struct posix_sporadic *ss, struct k_thread *thread)
+{
+	ARG_UNUSED(ss);
+	ARG_UNUSED(thread);
+}
+
+static inline int posix_sporadic_set(struct k_thread *thread, int policy,
+				     const struct sched_param *param)
+{
+	ARG_UNUSED(thread);
+	ARG_UNUSED(policy);
+	ARG_UNUSED(param);
+
+	return 0;
+}
+
+static inline bool posix_sporadic_get(struct k_thread *thread, struct sched_param *param)
+{
+	ARG_UNUSED(thread);
+	ARG_UNUSED(param);
+
+	return false;
+}
+
+static inline void posix_sporadic_exit(struct k_thread *thread)
+{
+	ARG_UNUSED(thread);
+}
+
+#endif
+
+#endif /* ZEPHYR_LIB_POSIX_OPTIONS_SHARED_SPORADIC_PRIV_H_ */
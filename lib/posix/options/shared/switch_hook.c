@@ -0,0 +1,21 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "guard_priv.h"
+#include "itimer_priv.h"
+#include "usage_priv.h"
+
+#include <zephyr/kernel.h>
+
+/*
+ * The user tracing hook can only be defined once, so the options that need it are called from
+ * here, each one a no-op unless it is enabled.
+ */
+void sys_trace_thread_switched_out_user(void)
+{
+	posix_csw_switched_out();
+	posix_thread_guard_switched_out();
+	posix_itimer_switched_out();
+}
@@ -0,0 +1,66 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_POSIX_OPTIONS_SHARED_SYNC_IO_PRIV_H_
+#define ZEPHYR_LIB_POSIX_OPTIONS_SHARED_SYNC_IO_PRIV_H_
+
+#include <zephyr/sys/zvfs.h>
+#include <zephyr/toolchain.h>
+
+#if defined(CONFIG_POSIX_SYNCHRONIZED_IO) && !defined(CONFIG_TC_PROVIDES_POSIX_SYNCHRONIZED_IO)
+
+/*
+ * Synchronize @p fd to its backing store. Concurrent requests for the same descriptor are served
+ * by as few flushes of the file system as possible.
+ *
+ * Returns 0 on success, or -1 with errno set.
+ */
+int posix_sync_fd(int fd);
+
+/* Remember the O_DSYNC, O_RSYNC, and O_SYNC flags that @p fd was opened with */
+void posix_sync_open(int fd, int flags);
+
+/* Wait for writes to @p fd that are being synchronized before reading, as required by O_RSYNC */
+void posix_sync_read(int fd);
+
+/* Complete a write to @p fd, as required by O_DSYNC or O_SYNC. Returns 0, or -1 with errno set. */
+int posix_sync_write(int fd);
+
+/* Forget the flags that @p fd was opened with before it is closed */
+void posix_sync_close(int fd);
+
+#else
+
+static inline int posix_sync_fd(int fd)
+{
+	return zvfs_fsync(fd);
+}
+
+static inline void posix_sync_open(int fd, int flags)
+{
+	ARG_UNUSED(fd);
+	ARG_UNUSED(flags);
+}
+
+static inline void posix_sync_read(int fd)
+{
+	ARG_UNUSED(fd);
+}
+
+static inline int posix_sync_write(int fd)
+{
+	ARG_UNUSED(fd);
+
+	return 0;
+}
+
+static inline void posix_sync_close(int fd)
+{
+	ARG_UNUSED(fd);
+}
+
+#endif
+
+#endif /* ZEPHYR_LIB_POSIX_OPTIONS_SHARED_SYNC_IO_PRIV_H_ */
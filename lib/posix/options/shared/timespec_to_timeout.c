@@ -6,20 +6,187 @@
 
 #include "posix_clock.h"
 
-#include <limits.h>
+#include <errno.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <time.h>
 
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
 #include <zephyr/sys/clock.h>
+#include <zephyr/sys/dlist.h>
 #include <zephyr/sys/util.h>
 
-uint32_t timespec_to_timeoutms(int clock_id, const struct timespec *abstime)
+#ifdef CONFIG_POSIX_TIMEOUTS_REALTIME_RECHECK_MS
+#define REALTIME_RECHECK_MS CONFIG_POSIX_TIMEOUTS_REALTIME_RECHECK_MS
+#else
+#define REALTIME_RECHECK_MS 0
+#endif
+
+int timespec_to_clock_timeout(int clock_id, const struct timespec *abstime, k_timeout_t *timeout)
 {
-	struct timespec curtime;
+	int64_t left;
+	struct timespec now;
+
+	if (!timespec_is_valid(abstime) ||
+	    (sys_clock_gettime(sys_clock_from_clockid(clock_id), &now) < 0)) {
+		return -EINVAL;
+	}
+
+	left = tp_diff(abstime, &now);
+	if (left <= 0) {
+		*timeout = K_NO_WAIT;
+		return 0;
+	}
 
-	if (sys_clock_gettime(sys_clock_from_clockid(clock_id), &curtime) < 0) {
+	if (clock_id != (int)CLOCK_REALTIME) {
+		/* rounded up to ticks, so that the wait never ends early */
+		*timeout = K_NSEC(left);
 		return 0;
 	}
 
-	return clamp(tp_diff(abstime, &curtime) / NSEC_PER_MSEC, 0, UINT32_MAX);
+	/* clock_settime() ends the wait early, so that the time left is computed again */
+	if ((REALTIME_RECHECK_MS > 0) && (left > (int64_t)REALTIME_RECHECK_MS * NSEC_PER_MSEC)) {
+		*timeout = K_MSEC(REALTIME_RECHECK_MS);
+	} else {
+		*timeout = K_NSEC(left);
+	}
+
+	return 1;
+}
+
+#ifdef CONFIG_POLL
+static struct k_spinlock clock_wait_lock;
+static sys_dlist_t clock_waits = SYS_DLIST_STATIC_INIT(&clock_waits);
+
+/*
+ * Wait until @p end for @p event, or until clock_settime() if @p wait is registered. Returns 0
+ * when @p event is ready, and -EAGAIN otherwise.
+ */
+static int clock_wait_poll(struct posix_clock_wait *wait, struct k_poll_event *event,
+			   k_timepoint_t end)
+{
+	struct k_poll_event events[] = {
+		*event,
+		K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &wait->set),
+	};
+
+	if (k_poll(events, ARRAY_SIZE(events), sys_timepoint_timeout(end)) < 0) {
+		return -EAGAIN;
+	}
+
+	if (events[1].state != K_POLL_STATE_NOT_READY) {
+		k_poll_signal_reset(&wait->set);
+		return -EAGAIN;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_POLL */
+
+void posix_clock_wait_begin(struct posix_clock_wait *wait, int clock_id)
+{
+	wait->registered = false;
+
+#ifdef CONFIG_POLL
+	if (clock_id != (int)CLOCK_REALTIME) {
+		return;
+	}
+
+	/* registered before the time left is computed, so that no clock_settime() is missed */
+	k_poll_signal_init(&wait->set);
+	wait->registered = true;
+	K_SPINLOCK(&clock_wait_lock) {
+		sys_dlist_append(&clock_waits, &wait->node);
+	}
+#else
+	ARG_UNUSED(clock_id);
+#endif
+}
+
+void posix_clock_wait_end(struct posix_clock_wait *wait)
+{
+	if (!wait->registered) {
+		return;
+	}
+
+#ifdef CONFIG_POLL
+	K_SPINLOCK(&clock_wait_lock) {
+		sys_dlist_remove(&wait->node);
+	}
+#endif
+	wait->registered = false;
+}
+
+int posix_clock_sem_take(struct posix_clock_wait *wait, struct k_sem *sem, k_timeout_t timeout)
+{
+#ifdef CONFIG_POLL
+	k_timepoint_t end;
+	struct k_poll_event event;
+
+	if (wait->registered && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		end = sys_timepoint_calc(timeout);
+		k_poll_event_init(&event, K_POLL_TYPE_SEM_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY, sem);
+
+		/* another thread may take the count that the event announced */
+		while (k_sem_take(sem, K_NO_WAIT) != 0) {
+			if (clock_wait_poll(wait, &event, end) < 0) {
+				return -EAGAIN;
+			}
+		}
+
+		return 0;
+	}
+#endif
+
+	return k_sem_take(sem, timeout);
+}
+
+int posix_clock_msgq_get(struct posix_clock_wait *wait, struct k_msgq *msgq, void *data,
+			 k_timeout_t timeout)
+{
+#ifdef CONFIG_POLL
+	k_timepoint_t end;
+	struct k_poll_event event;
+
+	if (wait->registered && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		end = sys_timepoint_calc(timeout);
+		k_poll_event_init(&event, K_POLL_TYPE_MSGQ_DATA_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY,
+				  msgq);
+
+		/* another thread may get the message that the event announced */
+		while (k_msgq_get(msgq, data, K_NO_WAIT) != 0) {
+			if (clock_wait_poll(wait, &event, end) < 0) {
+				return -EAGAIN;
+			}
+		}
+
+		return 0;
+	}
+#endif
+
+	return k_msgq_get(msgq, data, timeout);
+}
+
+void posix_clock_realtime_set(void)
+{
+#ifdef CONFIG_POLL
+	struct posix_clock_wait *wait;
+	const bool isr = k_is_in_isr();
+
+	/* a waiter that is woken from a thread runs as soon as the scheduler is unlocked */
+	if (!isr) {
+		k_sched_lock();
+	}
+
+	K_SPINLOCK(&clock_wait_lock) {
+		SYS_DLIST_FOR_EACH_CONTAINER(&clock_waits, wait, node) {
+			(void)k_poll_signal_raise(&wait->set, 0);
+		}
+	}
+
+	if (!isr) {
+		k_sched_unlock();
+	}
+#endif
 }
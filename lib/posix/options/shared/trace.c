@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "posix_clock.h"
+#include "trace_priv.h"
+
+#include <stdint.h>
+#include <time.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/clock.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/toolchain.h>
+
+#ifdef CONFIG_TRACING_CTF
+#include <ctf_top.h>
+
+/* after the ids of the kernel events in ctf_top.h, see scripts/tracing/posix.tsdl */
+#define POSIX_CTF_ENTER    0xE0
+#define POSIX_CTF_BLOCKING 0xE1
+#define POSIX_CTF_EXIT     0xE2
+
+/* the timeout in microseconds, rounded up, or UINT32_MAX for K_FOREVER */
+static uint32_t posix_ctf_timeout(k_timeout_t timeout)
+{
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		return UINT32_MAX;
+	}
+
+	return (uint32_t)MIN(k_ticks_to_us_ceil64(timeout.ticks), UINT32_MAX - 1);
+}
+
+static inline uint32_t posix_ctf_thread(void)
+{
+	return (uint32_t)(uintptr_t)k_current_get();
+}
+#endif /* CONFIG_TRACING_CTF */
+
+#ifdef CONFIG_TRACING_USER
+void __weak sys_trace_posix_enter_user(enum sys_trace_posix_call call, uintptr_t obj,
+				       k_timeout_t timeout)
+{
+}
+
+void __weak sys_trace_posix_blocking_user(enum sys_trace_posix_call call, uintptr_t obj)
+{
+}
+
+void __weak sys_trace_posix_exit_user(enum sys_trace_posix_call call, uintptr_t obj, int err)
+{
+}
+#endif /* CONFIG_TRACING_USER */
+
+void sys_trace_posix_enter(enum sys_trace_posix_call call, uintptr_t obj, k_timeout_t timeout)
+{
+#ifdef CONFIG_TRACING_CTF
+	CTF_EVENT(CTF_LITERAL(uint8_t, POSIX_CTF_ENTER), (uint16_t)call, posix_ctf_thread(),
+		  (uint32_t)obj, posix_ctf_timeout(timeout));
+#endif
+#ifdef CONFIG_TRACING_USER
+	sys_trace_posix_enter_user(call, obj, timeout);
+#endif
+}
+
+void sys_trace_posix_blocking(enum sys_trace_posix_call call, uintptr_t obj)
+{
+#ifdef CONFIG_TRACING_CTF
+	CTF_EVENT(CTF_LITERAL(uint8_t, POSIX_CTF_BLOCKING), (uint16_t)call, posix_ctf_thread(),
+		  (uint32_t)obj);
+#endif
+#ifdef CONFIG_TRACING_USER
+	sys_trace_posix_blocking_user(call, obj);
+#endif
+}
+
+void sys_trace_posix_exit(enum sys_trace_posix_call call, uintptr_t obj, int err)
+{
+#ifdef CONFIG_TRACING_CTF
+	CTF_EVENT(CTF_LITERAL(uint8_t, POSIX_CTF_EXIT), (uint16_t)call, posix_ctf_thread(),
+		  (uint32_t)obj, (int32_t)err);
+#endif
+#ifdef CONFIG_TRACING_USER
+	sys_trace_posix_exit_user(call, obj, err);
+#endif
+}
+
+k_timeout_t sys_trace_posix_abstime(int clock_id, const struct timespec *abstime)
+{
+	int64_t left;
+	struct timespec now;
+
+	if (abstime == NULL) {
+		return K_FOREVER;
+	}
+
+	/* unlike timespec_to_clock_timeout(), the whole time left, which is only reported */
+	if (!timespec_is_valid(abstime) ||
+	    (sys_clock_gettime(sys_clock_from_clockid(clock_id), &now) < 0)) {
+		return K_NO_WAIT;
+	}
+
+	left = tp_diff(abstime, &now);
+
+	return (left <= 0) ? K_NO_WAIT : K_NSEC(left);
+}
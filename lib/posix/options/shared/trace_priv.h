@@ -0,0 +1,70 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_POSIX_OPTIONS_SHARED_TRACE_PRIV_H_
+#define ZEPHYR_LIB_POSIX_OPTIONS_SHARED_TRACE_PRIV_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/posix/posix_tracing.h>
+
+/*
+ * Tracing hooks of the POSIX layer.
+ *
+ * @p call is a sys_trace_posix_call without its SYS_TRACE_POSIX_ prefix, and @p obj the object
+ * of the call, as described in <zephyr/posix/posix_tracing.h>. A call that may block is recorded
+ * by sys_port_trace_posix_enter() with its timeout, by sys_port_trace_posix_blocking() if @p busy,
+ * i.e. its object is not available, and by sys_port_trace_posix_exit() with 0 or an error number.
+ * Any other call is only recorded by sys_port_trace_posix_call() when it returns.
+ *
+ * Without CONFIG_POSIX_TRACING, the hooks expand to nothing and their arguments are not
+ * evaluated, so they cost nothing.
+ */
+#ifdef CONFIG_POSIX_TRACING
+
+void sys_trace_posix_enter(enum sys_trace_posix_call call, uintptr_t obj, k_timeout_t timeout);
+void sys_trace_posix_blocking(enum sys_trace_posix_call call, uintptr_t obj);
+void sys_trace_posix_exit(enum sys_trace_posix_call call, uintptr_t obj, int err);
+
+/* Get the time left until @p abstime of the POSIX clock @p clock_id, or K_FOREVER if NULL */
+k_timeout_t sys_trace_posix_abstime(int clock_id, const struct timespec *abstime);
+
+#define sys_port_trace_posix_enter(call, obj, timeout)                                             \
+	sys_trace_posix_enter(SYS_TRACE_POSIX_##call, (uintptr_t)(obj), (timeout))
+
+#define sys_port_trace_posix_blocking(call, obj, busy)                                             \
+	do {                                                                                       \
+		if (busy) {                                                                        \
+			sys_trace_posix_blocking(SYS_TRACE_POSIX_##call, (uintptr_t)(obj));        \
+		}                                                                                  \
+	} while (false)
+
+#define sys_port_trace_posix_exit(call, obj, err)                                                  \
+	sys_trace_posix_exit(SYS_TRACE_POSIX_##call, (uintptr_t)(obj), (err))
+
+#define sys_port_trace_posix_call(call, obj, err)                                                  \
+	sys_trace_posix_exit(SYS_TRACE_POSIX_##call, (uintptr_t)(obj), (err))
+
+#else
+
+#define sys_port_trace_posix_enter(call, obj, timeout)                                             \
+	do {                                                                                       \
+	} while (false)
+#define sys_port_trace_posix_blocking(call, obj, busy)                                             \
+	do {                                                                                       \
+	} while (false)
+#define sys_port_trace_posix_exit(call, obj, err)                                                  \
+	do {                                                                                       \
+	} while (false)
+#define sys_port_trace_posix_call(call, obj, err)                                                  \
+	do {                                                                                       \
+	} while (false)
+
+#endif /* CONFIG_POSIX_TRACING */
+
+#endif /* ZEPHYR_LIB_POSIX_OPTIONS_SHARED_TRACE_PRIV_H_ */
@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_POSIX_OPTIONS_SHARED_USAGE_PRIV_H_
+#define ZEPHYR_LIB_POSIX_OPTIONS_SHARED_USAGE_PRIV_H_
+
+#include <stdint.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/toolchain.h>
+
+#ifdef CONFIG_DEMAND_PAGING_STATS
+#include <zephyr/kernel/mm/demand_paging.h>
+#endif
+
+/* resource usage that adds up over the lifetime of threads, as reported by times() and getrusage() */
+struct posix_usage {
+	/* execution cycles */
+	uint64_t cycles;
+	/* context switches while blocked, and while still ready to run */
+	uint64_t nvcsw;
+	uint64_t nivcsw;
+	/* page faults */
+	uint64_t majflt;
+};
+
+#if defined(CONFIG_XSI_RUSAGE_CSW) && !defined(CONFIG_TC_PROVIDES_XSI_MULTI_PROCESS)
+
+/* Provided by csw.c: add the context switches of @p thread to @p usage */
+void posix_csw_thread(const struct k_thread *thread, struct posix_usage *usage);
+
+/* Provided by csw.c: add the context switches of every thread, including those that exited */
+void posix_csw_all(struct posix_usage *usage);
+
+/* Provided by csw.c: count the context switch of the thread that is being switched out */
+void posix_csw_switched_out(void);
+
+#else
+
+static inline void posix_csw_thread(const struct k_thread *thread, struct posix_usage *usage)
+{
+	ARG_UNUSED(thread);
+	ARG_UNUSED(usage);
+}
+
+static inline void posix_csw_all(struct posix_usage *usage)
+{
+	ARG_UNUSED(usage);
+}
+
+static inline void posix_csw_switched_out(void)
+{
+}
+
+#endif
+
+/* add the usage of @p thread to @p usage */
+static inline void posix_usage_thread(struct k_thread *thread, struct posix_usage *usage)
+{
+	k_thread_runtime_stats_t stats = {0};
+
+	(void)k_thread_runtime_stats_get(thread, &stats);
+	usage->cycles += stats.execution_cycles;
+	posix_csw_thread(thread, usage);
+
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+	struct k_mem_paging_stats_t paging = {0};
+
+	k_mem_paging_thread_stats_get(thread, &paging);
+	usage->majflt += paging.pagefaults.cnt;
+#endif
+}
+
+/* add the usage of every thread, including those that exited, to @p usage */
+static inline int posix_usage_all(struct posix_usage *usage)
+{
+	int ret;
+	k_thread_runtime_stats_t stats = {0};
+
+	ret = k_thread_runtime_stats_all_get(&stats);
+	usage->cycles += stats.total_cycles;
+	posix_csw_all(usage);
+
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	struct k_mem_paging_stats_t paging = {0};
+
+	k_mem_paging_stats_get(&paging);
+	usage->majflt += paging.pagefaults.cnt;
+#endif
+
+	return ret;
+}
+
+static inline void posix_usage_add(struct posix_usage *usage, const struct posix_usage *other)
+{
+	usage->cycles += other->cycles;
+	usage->nvcsw += other->nvcsw;
+	usage->nivcsw += other->nivcsw;
+	usage->majflt += other->majflt;
+}
+
+/* take @p other away from @p usage, which is expected to include it */
+static inline void posix_usage_sub(struct posix_usage *usage, const struct posix_usage *other)
+{
+	usage->cycles -= MIN(usage->cycles, other->cycles);
+	usage->nvcsw -= MIN(usage->nvcsw, other->nvcsw);
+	usage->nivcsw -= MIN(usage->nivcsw, other->nivcsw);
+	usage->majflt -= MIN(usage->majflt, other->majflt);
+}
+
+#endif /* ZEPHYR_LIB_POSIX_OPTIONS_SHARED_USAGE_PRIV_H_ */
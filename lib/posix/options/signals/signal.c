@@ -4,7 +4,12 @@
  * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
  * SPDX-License-Identifier: Apache-2.0
  */
+#include "domain_priv.h"
+#include "itimer_priv.h"
+#include "percpu_priv.h"
 #include "posix_internal.h"
+#include "sig_wake_priv.h"
+#include "trace_priv.h"
 
 #include <errno.h>
 #include <pthread.h>
@@ -152,9 +157,148 @@ static void kinfo_to_siginfo(siginfo_t *dst, const struct k_sig_info *src, int s
 	*dst = (siginfo_t){0};
 	dst->si_signo = signo;
 	dst->si_code = src->code;
-	dst->si_value.sival_int = src->value.sival_int;
+	/* the pointer is the larger member, so this also copies an integer value */
+	dst->si_value.sival_ptr = src->value.sival_ptr;
 }
 
+#ifdef CONFIG_POSIX_PROCESS_DOMAINS
+/*
+ * Each process domain has its own dispositions. The kernel only has one action per signal, which
+ * is z_sig_shim() whenever any domain catches or ignores the signal, and the shim then applies the
+ * disposition of the domain of the thread that the signal is delivered to. A domain that leaves
+ * such a signal at SIG_DFL ignores it.
+ */
+void z_sig_shim(int ksigno, struct k_sig_info *kinfo, void *context);
+
+static K_MUTEX_DEFINE(domain_sig_update);
+static struct k_spinlock domain_sig_lock;
+static struct sigaction domain_actions[1 + CONFIG_POSIX_PROCESS_DOMAINS_MAX][SIGRTMAX];
+
+static bool domain_sig_is_caught(void (*handler)(int))
+{
+	/* a zeroed entry, which no one has set yet, is SIG_DFL too */
+	return (handler != NULL) && (handler != SIG_DFL) && (handler != SIG_IGN);
+}
+
+void posix_sig_domain_init(int index, int parent)
+{
+	struct sigaction *act;
+
+	K_SPINLOCK(&domain_sig_lock) {
+		for (int i = 0; i < SIGRTMAX; ++i) {
+			act = &domain_actions[index][i];
+			*act = (struct sigaction){0};
+			act->sa_handler = SIG_DFL;
+			if ((parent >= 0) && (domain_actions[parent][i].sa_handler == SIG_IGN)) {
+				act->sa_handler = SIG_IGN;
+			}
+		}
+	}
+}
+
+static int domain_sigaction(int sig, int ksigno, const struct sigaction *act,
+			    struct sigaction *oact)
+{
+	int ret;
+	bool caught = false;
+	bool ignored = false;
+	bool defaulted = false;
+	void (*handler)(int);
+	struct k_sig_action kact = {0};
+	const int index = posix_domain_index(k_current_get());
+
+	if ((act != NULL) && ((sig == SIGKILL) || (sig == SIGSTOP))) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&domain_sig_update, K_FOREVER);
+	K_SPINLOCK(&domain_sig_lock) {
+		if (oact != NULL) {
+			*oact = domain_actions[index][sig - 1];
+			if (oact->sa_handler == NULL) {
+				oact->sa_handler = SIG_DFL;
+			}
+		}
+
+		if (act == NULL) {
+			K_SPINLOCK_BREAK;
+		}
+
+		domain_actions[index][sig - 1] = *act;
+		for (size_t i = 0; i < ARRAY_SIZE(domain_actions); ++i) {
+			handler = domain_actions[i][sig - 1].sa_handler;
+			caught = caught || domain_sig_is_caught(handler);
+			ignored = ignored || (handler == SIG_IGN);
+			defaulted = defaulted ||
+				    (!domain_sig_is_caught(handler) && (handler != SIG_IGN));
+		}
+	}
+
+	ret = 0;
+	if (act != NULL) {
+		if (caught || (ignored && defaulted)) {
+			/* the shim decides whether the handler wants the siginfo_t */
+			kact.handler = z_sig_shim;
+			kact.flags = K_SIG_SA_SIGINFO;
+		} else {
+			kact.handler = ignored ? K_SIG_IGN : K_SIG_DFL;
+		}
+
+		ret = k_sig_action(ksigno, &kact, NULL);
+	}
+	(void)k_mutex_unlock(&domain_sig_update);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+static void domain_sig_shim(int signo, struct k_sig_info *kinfo, void *context)
+{
+	sigset_t mask;
+	struct sigaction act;
+	struct k_sig_set kold;
+	struct k_sig_set kmask_buf;
+	struct sigaction *entry;
+	const int index = posix_domain_index(k_current_get());
+
+	K_SPINLOCK(&domain_sig_lock) {
+		entry = &domain_actions[index][signo - 1];
+		act = *entry;
+		if (domain_sig_is_caught(act.sa_handler) && ((act.sa_flags & SA_RESETHAND) != 0)) {
+			*entry = (struct sigaction){0};
+			entry->sa_handler = SIG_DFL;
+		}
+	}
+
+	if (!domain_sig_is_caught(act.sa_handler)) {
+		return;
+	}
+
+	(void)k_sig_mask(K_SIG_BLOCK, z_sig_set_from_posix(&act.sa_mask, &kmask_buf), &kold);
+	if ((act.sa_flags & SA_NODEFER) != 0) {
+		(void)sigemptyset(&mask);
+		(void)sigaddset(&mask, signo);
+		(void)k_sig_mask(K_SIG_UNBLOCK, z_sig_set_from_posix(&mask, &kmask_buf), NULL);
+	}
+
+	if ((act.sa_flags & SA_SIGINFO) != 0) {
+		siginfo_t info;
+
+		kinfo_to_siginfo(&info, kinfo, signo);
+		((void (*)(int, siginfo_t *, void *))act.sa_handler)(signo, &info, context);
+	} else {
+		act.sa_handler(signo);
+	}
+
+	(void)k_sig_mask(K_SIG_SETMASK, &kold, NULL);
+}
+#endif /* CONFIG_POSIX_PROCESS_DOMAINS */
+
 /* handle a POSIX sigaction from a kernel signal handler */
 void z_sig_shim(int ksigno, struct k_sig_info *kinfo, void *context)
 {
@@ -165,6 +309,13 @@ void z_sig_shim(int ksigno, struct k_sig_info *kinfo, void *context)
 
 	ARG_UNUSED(kinfo);
 
+	posix_stat_inc(POSIX_STAT_SIG_CAUGHT);
+
+#ifdef CONFIG_POSIX_PROCESS_DOMAINS
+	domain_sig_shim(signo, kinfo, context);
+	return;
+#endif
+
 	k_sig_current(&kinfo_unused, &action, &unused);
 
 	if (action.user_data == NULL) {
@@ -226,6 +377,10 @@ int sigaction(int sig, const struct sigaction *ZRESTRICT act, struct sigaction *
 		return -1;
 	}
 
+#ifdef CONFIG_POSIX_PROCESS_DOMAINS
+	return domain_sigaction(sig, ksigno, act, oact);
+#endif
+
 	if (act != NULL) {
 		kact = (struct k_sig_action){0};
 		if ((act->sa_handler == SIG_DFL) || (act->sa_handler == SIG_IGN)) {
@@ -309,8 +464,12 @@ static void posix_sig_wait_delivered(unsigned long start)
 
 int pause(void)
 {
+	sys_port_trace_posix_enter(PAUSE, k_current_get(), K_FOREVER);
+	sys_port_trace_posix_blocking(PAUSE, k_current_get(), true);
+
 	posix_sig_wait_delivered(k_sig_delivered());
 
+	sys_port_trace_posix_exit(PAUSE, k_current_get(), EINTR);
 	errno = EINTR;
 
 	return -1;
@@ -340,11 +499,15 @@ int sigsuspend(const sigset_t *sigmask)
 		return -1;
 	}
 
+	sys_port_trace_posix_enter(SIGSUSPEND, k_current_get(), K_FOREVER);
+	sys_port_trace_posix_blocking(SIGSUSPEND, k_current_get(), true);
+
 	posix_sig_wait_delivered(start);
 
 	/* the mask in force before the call is always restored */
 	(void)k_sig_mask(K_SIG_SETMASK, &kold, NULL);
 
+	sys_port_trace_posix_exit(SIGSUSPEND, k_current_get(), EINTR);
 	errno = EINTR;
 
 	return -1;
@@ -363,10 +526,14 @@ int sigwait(const sigset_t *ZRESTRICT set, int *ZRESTRICT sig)
 
 	kset = z_sig_set_from_posix(set, &kset_buf);
 
+	sys_port_trace_posix_enter(SIGWAIT, k_current_get(), K_FOREVER);
+
 	do {
 		ret = k_sig_timedwait(kset, &kinfo, K_MSEC(100));
 	} while (ret == -EAGAIN);
 
+	sys_port_trace_posix_exit(SIGWAIT, k_current_get(), (ret < 0) ? -ret : 0);
+
 	if (ret < 0) {
 		return -ret;
 	}
@@ -401,19 +568,26 @@ int kill(pid_t pid, int sig)
 	if (pid == getpid()) {
 		tid = k_current_get();
 	} else if (pid > 0) {
-		tid = to_k_thread(&th);
+		/* a thread of another process domain, or else a specific thread */
+		tid = posix_domain_thread(pid);
+		if (tid == NULL) {
+			tid = to_k_thread(&th);
+		}
 	} else {
 		/* Zephyr does not yet support process groups (pid <= 0) */
 		errno = ESRCH;
 		return -1;
 	}
 
-	ret = k_sig_queue(tid, ksigno, (union k_sig_val){0});
+	ret = posix_sig_queue(tid, ksigno, (union k_sig_val){0});
+	sys_port_trace_posix_call(KILL, tid, -ret);
 	if (ret < 0) {
 		errno = -ret;
 		return -1;
 	}
 
+	posix_stat_inc(POSIX_STAT_SIG_SENT);
+
 	return 0;
 }
 #ifdef CONFIG_POSIX_SIGNALS_ALIAS_KILL
@@ -423,7 +597,10 @@ FUNC_ALIAS(kill, _kill, int);
 unsigned int alarm(unsigned int seconds)
 {
 	k_ticks_t remaining =
-		k_sig_alarm((seconds == 0) ? K_FOREVER : K_SECONDS(seconds));
+		posix_sig_alarm((seconds == 0) ? K_FOREVER : K_SECONDS(seconds));
+
+	/* alarm() and ITIMER_REAL share SIGALRM, so setting one disarms the other */
+	remaining = MAX(remaining, posix_itimer_real_cancel());
 
 	return (unsigned int)DIV_ROUND_UP(k_ticks_to_ms_ceil64((uint64_t)remaining),
 					  MSEC_PER_SEC);
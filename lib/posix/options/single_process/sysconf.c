@@ -16,7 +16,7 @@ long sysconf(int name)
 {
 	switch (name) {
 	case _SC_ADVISORY_INFO:
-		return -1L;
+		return COND_CODE_1(CONFIG_POSIX_ADVISORY_INFO, (_POSIX_VERSION), (-1L));
 	case _SC_ASYNCHRONOUS_IO:
 		return COND_CODE_1(CONFIG_POSIX_ASYNCHRONOUS_IO, (_POSIX_VERSION), (-1L));
 	case _SC_BARRIERS:
@@ -56,7 +56,7 @@ long sysconf(int name)
 	case _SC_REALTIME_SIGNALS:
 		return -1L;
 	case _SC_REGEXP:
-		return -1L;
+		return COND_CODE_1(CONFIG_POSIX_REGEXP, (_POSIX_VERSION), (-1L));
 	case _SC_SAVED_IDS:
 		return -1L;
 	case _SC_SEMAPHORES:
@@ -74,7 +74,7 @@ long sysconf(int name)
 	case _SC_SS_REPL_MAX:
 		return _POSIX_SS_REPL_MAX;
 	case _SC_SYNCHRONIZED_IO:
-		return -1L;
+		return COND_CODE_1(CONFIG_POSIX_SYNCHRONIZED_IO, (_POSIX_VERSION), (-1L));
 	case _SC_THREAD_ATTR_STACKADDR:
 		return COND_CODE_1(CONFIG_POSIX_THREAD_ATTR_STACKADDR, (_POSIX_VERSION), (-1L));
 	case _SC_THREAD_ATTR_STACKSIZE:
@@ -102,7 +102,7 @@ long sysconf(int name)
 		return -1L;
 #endif
 	case _SC_THREAD_SPORADIC_SERVER:
-		return -1L;
+		return COND_CODE_1(CONFIG_POSIX_THREAD_SPORADIC_SERVER, (_POSIX_VERSION), (-1L));
 	case _SC_THREADS:
 		return COND_CODE_1(CONFIG_POSIX_THREADS, (_POSIX_VERSION), (-1L));
 	case _SC_TIMEOUTS:
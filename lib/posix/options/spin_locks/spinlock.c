@@ -15,13 +15,12 @@
 #include <zephyr/sys/elastipool.h>
 #include <zephyr/sys/sem.h>
 
-static SYS_SEM_DEFINE(posix_spin_lock, 1, 1);
-SYS_ELASTIPOOL_DEFINE_STATIC(posix_spin_pool, sizeof(atomic_t), __alignof(atomic_t),
-			     CONFIG_MAX_PTHREAD_SPINLOCK_COUNT, CONFIG_MAX_PTHREAD_SPINLOCK_COUNT);
+POSIX_POOL_DEFINE(posix_spin_pool, atomic_t, CONFIG_MAX_PTHREAD_SPINLOCK_COUNT);
 
 int pthread_spin_init(pthread_spinlock_t *lock, int pshared)
 {
-	int ret = EINVAL;
+	atomic_t *l;
+	uint32_t handle;
 
 	if (lock == NULL ||
 	    !(pshared == PTHREAD_PROCESS_PRIVATE || pshared == PTHREAD_PROCESS_SHARED)) {
@@ -29,67 +28,39 @@ int pthread_spin_init(pthread_spinlock_t *lock, int pshared)
 		return EINVAL;
 	}
 
-	SYS_SEM_LOCK(&posix_spin_lock) {
-		uintptr_t l = 0;
-
-		ret = sys_elastipool_alloc(&posix_spin_pool, (void **)&l);
-		if (ret < 0) {
-			ret = ENOMEM;
-		} else {
-			atomic_set((atomic_t *)l, 0);
-			*lock = (pthread_spinlock_t)(uintptr_t)l;
-		}
+	l = posix_pool_alloc(&posix_spin_pool, &handle);
+	if (l == NULL) {
+		return ENOMEM;
 	}
 
-	return ret;
+	atomic_set(l, 0);
+	*lock = (pthread_spinlock_t)handle;
+
+	return 0;
 }
 
 int pthread_spin_destroy(pthread_spinlock_t *lock)
 {
-	atomic_t *l;
-	int ret = EINVAL;
-
 	if (lock == NULL) {
 		return EINVAL;
 	}
 
-	SYS_SEM_LOCK(&posix_spin_lock) {
-		l = posix_get_pool_obj_unlocked(&posix_spin_pool, *lock);
-		if (l == NULL) {
-			/* not specified as part of POSIX but this is the Linux behavior */
-			ret = EINVAL;
-			SYS_SEM_LOCK_BREAK;
-		}
-
-		ret = sys_elastipool_free(&posix_spin_pool, (void *)l);
-		__ASSERT_NO_MSG(ret == 0);
-	}
-
-	return ret;
+	/* not specified as part of POSIX but this is the Linux behavior */
+	return posix_pool_free(&posix_spin_pool, *lock, NULL);
 }
 
 static int pthread_spin_lock_common(pthread_spinlock_t *lock, bool wait)
 {
-	atomic_t *l = NULL;
-	int ret = EINVAL;
+	atomic_t *l;
 
 	if (lock == NULL) {
 		return EINVAL;
 	}
 
-	SYS_SEM_LOCK(&posix_spin_lock) {
-		l = posix_get_pool_obj_unlocked(&posix_spin_pool, *lock);
-		if (l == NULL) {
-			/* not specified as part of POSIX but this is the Linux behavior */
-			ret = EINVAL;
-			SYS_SEM_LOCK_BREAK;
-		}
-
-		ret = 0;
-	}
-
-	if (ret != 0) {
-		return ret;
+	l = posix_pool_get(&posix_spin_pool, *lock);
+	if (l == NULL) {
+		/* not specified as part of POSIX but this is the Linux behavior */
+		return EINVAL;
 	}
 
 	while (!atomic_cas(l, 0, 1)) {
@@ -115,27 +86,19 @@ int pthread_spin_trylock(pthread_spinlock_t *lock)
 
 int pthread_spin_unlock(pthread_spinlock_t *lock)
 {
-	atomic_t *l = NULL;
-	int ret = EINVAL;
+	atomic_t *l;
 
 	if (lock == NULL) {
 		return EINVAL;
 	}
 
-	SYS_SEM_LOCK(&posix_spin_lock) {
-		l = posix_get_pool_obj_unlocked(&posix_spin_pool, *lock);
-		if (l == NULL) {
-			/* not specified as part of POSIX but this is the Linux behavior */
-			ret = EINVAL;
-			SYS_SEM_LOCK_BREAK;
-		}
-
-		ret = 0;
+	l = posix_pool_get(&posix_spin_pool, *lock);
+	if (l == NULL) {
+		/* not specified as part of POSIX but this is the Linux behavior */
+		return EINVAL;
 	}
 
-	if (ret == 0) {
-		atomic_cas(l, 1, 0);
-	}
+	atomic_cas(l, 1, 0);
 
-	return ret;
+	return 0;
 }
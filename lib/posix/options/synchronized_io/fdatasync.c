@@ -7,7 +7,10 @@
 #include <unistd.h>
 #include <zephyr/sys/zvfs.h>
 
+#include "sync_io_priv.h"
+
 int fdatasync(int fd)
 {
-	return zvfs_fsync(fd);
+	/* file systems only provide a full flush, which also synchronizes file data */
+	return posix_sync_fd(fd);
 }
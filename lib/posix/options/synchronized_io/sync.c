@@ -0,0 +1,194 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sync_io_priv.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/internal/fdtable_priv.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/sys/zvfs.h>
+
+/*
+ * Group commit: each request to synchronize a descriptor takes a ticket. A thread that finds no
+ * flush in progress leads one on behalf of every ticket issued so far, while threads arriving
+ * during the flush wait for it to finish and then for the next one, which covers them all. A
+ * request is complete once a flush that started after it was made has completed, so N concurrent
+ * writers cost at most two flushes of the file system rather than N.
+ */
+
+#define SYNC_WRITE BIT(0)
+#define SYNC_READ  BIT(1)
+
+struct sync_state {
+	/* open file description that flags apply to */
+	const void *obj;
+	uint8_t flags;
+	bool flushing;
+	uint32_t requested;
+	uint32_t completed;
+	/* errno of the last completed flush, or 0 */
+	int err;
+};
+
+static struct sync_state sync_states[ZVFS_OPEN_SIZE];
+static atomic_t sync_attached;
+static K_MUTEX_DEFINE(sync_lock);
+static K_CONDVAR_DEFINE(sync_cond);
+
+static inline bool sync_done(const struct sync_state *st, uint32_t ticket)
+{
+	return (int32_t)(st->completed - ticket) >= 0;
+}
+
+static uint8_t sync_flags(int fd)
+{
+	uint8_t flags = 0;
+	struct fd_entry *entry;
+
+	if ((atomic_get(&sync_attached) == 0) || (fd < 0) || (fd >= ARRAY_SIZE(sync_states))) {
+		return 0;
+	}
+
+	entry = zvfs_fd_entry_get(fd);
+	if (entry == NULL) {
+		return 0;
+	}
+
+	(void)k_mutex_lock(&sync_lock, K_FOREVER);
+	if (sync_states[fd].obj == entry->obj) {
+		flags = sync_states[fd].flags;
+	}
+	k_mutex_unlock(&sync_lock);
+
+	return flags;
+}
+
+int posix_sync_fd(int fd)
+{
+	int err;
+	uint32_t ticket;
+	uint32_t target;
+	struct sync_state *st;
+
+	if (!IS_ENABLED(CONFIG_POSIX_SYNCHRONIZED_IO_GROUP_COMMIT) || (fd < 0) ||
+	    (fd >= ARRAY_SIZE(sync_states))) {
+		return zvfs_fsync(fd);
+	}
+
+	st = &sync_states[fd];
+
+	(void)k_mutex_lock(&sync_lock, K_FOREVER);
+	ticket = ++st->requested;
+	while (!sync_done(st, ticket)) {
+		if (st->flushing) {
+			(void)k_condvar_wait(&sync_cond, &sync_lock, K_FOREVER);
+			continue;
+		}
+
+		st->flushing = true;
+		target = st->requested;
+		k_mutex_unlock(&sync_lock);
+
+		err = (zvfs_fsync(fd) < 0) ? errno : 0;
+
+		(void)k_mutex_lock(&sync_lock, K_FOREVER);
+		st->flushing = false;
+		st->completed = target;
+		st->err = err;
+		(void)k_condvar_broadcast(&sync_cond);
+	}
+	err = st->err;
+	k_mutex_unlock(&sync_lock);
+
+	if (err != 0) {
+		errno = err;
+		return -1;
+	}
+
+	return 0;
+}
+
+void posix_sync_open(int fd, int flags)
+{
+	uint8_t sync = 0;
+	struct fd_entry *entry;
+
+	if (((flags & O_DSYNC) == O_DSYNC) || ((flags & O_SYNC) == O_SYNC)) {
+		sync |= SYNC_WRITE;
+	}
+
+	/* O_RSYNC only has an effect together with O_DSYNC or O_SYNC */
+	if (((flags & O_RSYNC) == O_RSYNC) && (sync != 0)) {
+		sync |= SYNC_READ;
+	}
+
+	if ((sync == 0) || (fd < 0) || (fd >= ARRAY_SIZE(sync_states))) {
+		return;
+	}
+
+	entry = zvfs_fd_entry_get(fd);
+	if (entry == NULL) {
+		return;
+	}
+
+	(void)k_mutex_lock(&sync_lock, K_FOREVER);
+	if (sync_states[fd].flags == 0) {
+		(void)atomic_inc(&sync_attached);
+	}
+	sync_states[fd].obj = entry->obj;
+	sync_states[fd].flags = sync;
+	k_mutex_unlock(&sync_lock);
+}
+
+void posix_sync_read(int fd)
+{
+	uint32_t ticket;
+	struct sync_state *st;
+
+	if ((sync_flags(fd) & SYNC_READ) == 0) {
+		return;
+	}
+
+	st = &sync_states[fd];
+
+	/* a read only needs to wait for writes that have already been made */
+	(void)k_mutex_lock(&sync_lock, K_FOREVER);
+	ticket = st->requested;
+	while (!sync_done(st, ticket)) {
+		(void)k_condvar_wait(&sync_cond, &sync_lock, K_FOREVER);
+	}
+	k_mutex_unlock(&sync_lock);
+}
+
+int posix_sync_write(int fd)
+{
+	if ((sync_flags(fd) & SYNC_WRITE) == 0) {
+		return 0;
+	}
+
+	return posix_sync_fd(fd);
+}
+
+void posix_sync_close(int fd)
+{
+	if ((fd < 0) || (fd >= ARRAY_SIZE(sync_states))) {
+		return;
+	}
+
+	(void)k_mutex_lock(&sync_lock, K_FOREVER);
+	if (sync_states[fd].flags != 0) {
+		sync_states[fd].obj = NULL;
+		sync_states[fd].flags = 0;
+		(void)atomic_dec(&sync_attached);
+	}
+	k_mutex_unlock(&sync_lock);
+}
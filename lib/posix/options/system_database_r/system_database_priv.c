@@ -5,6 +5,7 @@
  */
 
 #include <errno.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -24,135 +25,173 @@ static int count(const char *s, char c)
 	return count;
 }
 
-int z_getgr_r(const char *name, gid_t gid, struct group *grp, char *buffer, size_t bufsize,
-	      struct group **result)
+/* check whether the ':'-separated entry @p line has the name @p name, or the id @p id */
+static bool entry_matches(const char *line, const char *name, unsigned int id)
 {
-	int ret;
-	int nmemb;
-	FILE *file;
+	size_t len;
 
-	if (((name == NULL) && (gid == (gid_t)-1)) || (grp == NULL) || (buffer == NULL) ||
-	    (result == NULL)) {
-		if (result != NULL) {
-			*result = NULL;
-		}
-		return EINVAL;
+	if (name != NULL) {
+		len = strlen(name);
+		return (strncmp(line, name, len) == 0) && (line[len] == ':');
 	}
 
-	/*
-	 * Originally, this checked for a bufsize of 0, but newlib will return NULL from fgets when
-	 * bufsize is < 2
-	 */
-	if (bufsize < 2) {
-		return ERANGE;
+	/* the id is the third field in both /etc/group and /etc/passwd */
+	for (int i = 0; i < 2; ++i) {
+		line = strchr(line, ':');
+		if (line == NULL) {
+			return false;
+		}
+		++line;
 	}
 
-	file = fopen("/etc/group", "r");
-	if (file == NULL) {
-		return EIO;
-	}
+	return (*line != ':') && ((unsigned int)atoi(line) == id);
+}
 
-	while (fgets(buffer, (int)bufsize, file) != NULL) {
-		char *p = buffer;
-		char *q;
+/*
+ * Copy the entry of @p path that matches @p name or @p id into @p buffer, without its trailing
+ * newline. Lines are read with getline(), so entries that do not match may be of any length.
+ *
+ * Returns 0 and sets @p found if the entry was found, or an error number.
+ */
+static int find_entry(const char *path, const char *name, unsigned int id, char *buffer,
+		      size_t bufsize, bool *found)
+{
+	int ret = 0;
+	FILE *file;
+	ssize_t len;
+	size_t size = 0;
+	char *line = NULL;
 
-		if (*p == '\0') {
-			goto close_erange;
-		}
+	*found = false;
 
-		if (*p == '\n') {
-			continue;
-		}
+	file = fopen(path, "r");
+	if (file == NULL) {
+		return EIO;
+	}
 
-		/* name */
-		q = strchr(p, ':');
-		if (q == NULL) {
-			goto close_erange;
-		}
-		*q = '\0';
-		if ((name != NULL) && (strcmp(p, name) != 0)) {
+	while ((len = getline(&line, &size, file)) >= 0) {
+		if (!entry_matches(line, name, id)) {
 			continue;
 		}
-		grp->gr_name = p;
-		p = q + 1;
 
-		/* password */
-		q = strchr(p, ':');
-		if (q == NULL) {
-			goto close_erange;
-		}
-		*q = '\0';
-		grp->gr_passwd = p;
-		p = q + 1;
-
-		/* gid */
-		q = strchr(p, ':');
-		if (q == NULL) {
-			goto close_erange;
+		if (line[len - 1] == '\n') {
+			line[--len] = '\0';
 		}
-		*q = '\0';
-		if ((name == NULL) && (atoi(p) != gid)) {
-			continue;
-		}
-		grp->gr_gid = atoi(p);
-		p = q + 1;
 
-		/* members */
-		q = strchr(p, '\n');
-		if (q == NULL) {
-			goto close_erange;
+		if ((size_t)len >= bufsize) {
+			ret = ERANGE;
+			break;
 		}
-		*q = '\0';
 
-		/* count members */
-		int min_size;
+		memcpy(buffer, line, len + 1);
+		*found = true;
+		break;
+	}
 
-		nmemb = (p == q) ? 0 : 1 + count(p, ',');
-		min_size = (q - buffer + 1 + nmemb * sizeof(char *)) + 32;
-		if (bufsize < min_size) {
-			goto close_erange;
-		}
+	free(line);
+	fclose(file);
 
-		/* set up member array inside of buffer */
-		grp->gr_mem = (char **)(q + 1);
-		grp->gr_mem = (char **)ROUND_UP((uintptr_t)grp->gr_mem, 16);
-		grp->gr_mem[nmemb] = NULL;
+	return ret;
+}
 
-		for (int i = 0; i < nmemb; ++i) {
-			char *x = strchr(p, ',');
+int z_getgr_r(const char *name, gid_t gid, struct group *grp, char *buffer, size_t bufsize,
+	      struct group **result)
+{
+	int ret;
+	int nmemb;
+	int min_size;
+	bool found;
+	char *q;
+	char *p = buffer;
 
-			grp->gr_mem[i] = p;
-			if (x == NULL) {
-				break;
-			}
-			*x = '\0';
-			p = x + 1;
+	if (((name == NULL) && (gid == (gid_t)-1)) || (grp == NULL) || (buffer == NULL) ||
+	    (result == NULL)) {
+		if (result != NULL) {
+			*result = NULL;
 		}
+		return EINVAL;
+	}
 
-		/* group found \o/ */
-		*result = grp;
-		ret = 0;
-		goto close_ret;
+	/* an entry holds at least a name and a ':' */
+	if (bufsize < 2) {
+		return ERANGE;
 	}
 
-	/* group not found :( )*/
-	ret = 0;
-	*result = NULL;
-	goto close_ret;
+	ret = find_entry("/etc/group", name, gid, buffer, bufsize, &found);
+	if ((ret != 0) || !found) {
+		*result = NULL;
+		return ret;
+	}
 
-close_erange:
-	ret = ERANGE;
+	/* name */
+	q = strchr(p, ':');
+	if (q == NULL) {
+		goto erange;
+	}
+	*q = '\0';
+	grp->gr_name = p;
+	p = q + 1;
+
+	/* password */
+	q = strchr(p, ':');
+	if (q == NULL) {
+		goto erange;
+	}
+	*q = '\0';
+	grp->gr_passwd = p;
+	p = q + 1;
+
+	/* gid */
+	q = strchr(p, ':');
+	if (q == NULL) {
+		goto erange;
+	}
+	*q = '\0';
+	grp->gr_gid = atoi(p);
+	p = q + 1;
+
+	/* members */
+	q = p + strlen(p);
+
+	/* count members */
+	nmemb = (p == q) ? 0 : 1 + count(p, ',');
+	min_size = (q - buffer + 1 + nmemb * sizeof(char *)) + 32;
+	if (bufsize < min_size) {
+		goto erange;
+	}
 
-close_ret:
-	fclose(file);
-	return ret;
+	/* set up member array inside of buffer */
+	grp->gr_mem = (char **)(q + 1);
+	grp->gr_mem = (char **)ROUND_UP((uintptr_t)grp->gr_mem, 16);
+	grp->gr_mem[nmemb] = NULL;
+
+	for (int i = 0; i < nmemb; ++i) {
+		char *x = strchr(p, ',');
+
+		grp->gr_mem[i] = p;
+		if (x == NULL) {
+			break;
+		}
+		*x = '\0';
+		p = x + 1;
+	}
+
+	/* group found \o/ */
+	*result = grp;
+	return 0;
+
+erange:
+	*result = NULL;
+	return ERANGE;
 }
 
 int z_getpw_r(const char *name, uid_t uid, struct passwd *pwd, char *buffer, size_t bufsize,
 	      struct passwd **result)
 {
 	int ret;
-	FILE *file;
+	bool found;
+	char *q;
+	char *p = buffer;
 
 	if (((name == NULL) && (uid == (uid_t)-1)) || (pwd == NULL) || (buffer == NULL) ||
 	    (result == NULL)) {
@@ -162,115 +201,80 @@ int z_getpw_r(const char *name, uid_t uid, struct passwd *pwd, char *buffer, siz
 		return EINVAL;
 	}
 
-	/*
-	 * Originally, this checked for a bufsize of 0, but newlib will return NULL from fgets when
-	 * bufsize is < 2
-	 */
+	/* an entry holds at least a name and a ':' */
 	if (bufsize < 2) {
 		return ERANGE;
 	}
 
-	file = fopen("/etc/passwd", "r");
-	if (file == NULL) {
-		return EIO;
+	ret = find_entry("/etc/passwd", name, uid, buffer, bufsize, &found);
+	if ((ret != 0) || !found) {
+		*result = NULL;
+		return ret;
 	}
 
-	while (fgets(buffer, (int)bufsize, file) != NULL) {
-		char *p = buffer;
-		char *q;
-
-		if (*p == '\0') {
-			goto close_erange;
-		}
-
-		if (*p == '\n') {
-			continue;
-		}
-
-		/* name */
-		q = strchr(p, ':');
-		if (q == NULL) {
-			goto close_erange;
-		}
-		*q = '\0';
-		if ((name != NULL) && (strcmp(p, name) != 0)) {
-			continue;
-		}
-		pwd->pw_name = p;
-		p = q + 1;
-
-		/* password */
-		q = strchr(p, ':');
-		if (q == NULL) {
-			goto close_erange;
-		}
-		*q = '\0';
-		pwd->pw_passwd = p;
-		p = q + 1;
-
-		/* uid */
-		q = strchr(p, ':');
-		if (q == NULL) {
-			goto close_erange;
-		}
-		*q = '\0';
-		if ((name == NULL) && (atoi(p) != uid)) {
-			continue;
-		}
-		pwd->pw_uid = atoi(p);
-		p = q + 1;
-
-		/* gid */
-		q = strchr(p, ':');
-		if (q == NULL) {
-			goto close_erange;
-		}
-		*q = '\0';
-		pwd->pw_gid = atoi(p);
-		p = q + 1;
-
-		/* gecos */
-		q = strchr(p, ':');
-		if (q == NULL) {
-			goto close_erange;
-		}
-		*q = '\0';
-		pwd->pw_gecos = p;
-		pwd->pw_comment = NULL;
-		p = q + 1;
-
-		/* dir */
-		q = strchr(p, ':');
-		if (q == NULL) {
-			goto close_erange;
-		}
-		*q = '\0';
-		pwd->pw_dir = p;
-		p = q + 1;
-
-		/* shell */
-		q = strchr(p, '\n');
-		if (q == NULL) {
-			goto close_erange;
-		}
-		*q = '\0';
-		pwd->pw_shell = p;
-
-		/* user found \o/ */
-		*result = pwd;
-		ret = 0;
-		goto close_ret;
+	/* name */
+	q = strchr(p, ':');
+	if (q == NULL) {
+		goto erange;
+	}
+	*q = '\0';
+	pwd->pw_name = p;
+	p = q + 1;
+
+	/* password */
+	q = strchr(p, ':');
+	if (q == NULL) {
+		goto erange;
+	}
+	*q = '\0';
+	pwd->pw_passwd = p;
+	p = q + 1;
+
+	/* uid */
+	q = strchr(p, ':');
+	if (q == NULL) {
+		goto erange;
+	}
+	*q = '\0';
+	pwd->pw_uid = atoi(p);
+	p = q + 1;
+
+	/* gid */
+	q = strchr(p, ':');
+	if (q == NULL) {
+		goto erange;
 	}
+	*q = '\0';
+	pwd->pw_gid = atoi(p);
+	p = q + 1;
+
+	/* gecos */
+	q = strchr(p, ':');
+	if (q == NULL) {
+		goto erange;
+	}
+	*q = '\0';
+	pwd->pw_gecos = p;
+	pwd->pw_comment = NULL;
+	p = q + 1;
+
+	/* dir */
+	q = strchr(p, ':');
+	if (q == NULL) {
+		goto erange;
+	}
+	*q = '\0';
+	pwd->pw_dir = p;
+	p = q + 1;
 
-	/* user not found :( )*/
-	ret = 0;
-	*result = NULL;
-	goto close_ret;
+	/* shell */
+	pwd->pw_shell = p;
 
-close_erange:
-	ret = ERANGE;
+	/* user found \o/ */
+	*result = pwd;
+	return 0;
 
-close_ret:
-	fclose(file);
-	return ret;
+erange:
+	*result = NULL;
+	return ERANGE;
 }
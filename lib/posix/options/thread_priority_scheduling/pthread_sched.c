@@ -5,6 +5,8 @@
  */
 
 #include "posix_internal.h"
+#include "sched_priv.h"
+#include "sporadic_priv.h"
 
 #include <pthread.h>
 #include <sched.h>
@@ -74,13 +76,22 @@ int pthread_attr_setinheritsched(pthread_attr_t *_attr, int inheritsched)
 
 int pthread_setschedparam(pthread_t pthread, int policy, const struct sched_param *param)
 {
+	int ret;
+
 	if (param == NULL || !valid_posix_policy(policy) ||
 	    !is_posix_policy_prio_valid(param->sched_priority, policy)) {
 		return EINVAL;
 	}
 
+	/* a sporadic server sets the priority of its thread itself */
+	ret = posix_sporadic_set(to_k_thread(&pthread), policy, param);
+	if ((ret != 0) || (policy == SCHED_SPORADIC)) {
+		return ret;
+	}
+
 	k_thread_priority_set(to_k_thread(&pthread),
 			      posix_to_zephyr_priority(param->sched_priority, policy));
+	posix_sched_thread_update(to_k_thread(&pthread));
 
 	return 0;
 }
@@ -106,6 +117,11 @@ int pthread_getschedparam(pthread_t pthread, int *policy, struct sched_param *pa
 		return EINVAL;
 	}
 
+	if (posix_sporadic_get(to_k_thread(&pthread), param)) {
+		*policy = SCHED_SPORADIC;
+		return 0;
+	}
+
 	*param = (struct sched_param){
 		.sched_priority = zephyr_to_posix_priority(
 			k_thread_priority_get(to_k_thread(&pthread)), policy),
@@ -0,0 +1,499 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "posix_internal.h"
+#include "sporadic_priv.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/timeutil.h>
+#include <zephyr/sys/util.h>
+
+#include <ksched.h>
+
+/*
+ * A sporadic server runs its thread at sched_priority while it has execution budget left, and at
+ * sched_ss_low_priority once the budget is used up. Budget that is used is given back one
+ * replenishment period after the thread started using it.
+ *
+ * Budget is charged from the runtime statistics of the thread. A thread that runs without
+ * blocking is charged when its time slice, which is set to its remaining budget, expires. A
+ * thread that runs in shorter bursts is charged by the replenishment timer of its server, which
+ * fires when a replenishment is due and, while the thread can run, whenever the remaining budget
+ * could have run out. The timer is stopped once the thread is blocked and nothing is due, and is
+ * armed again when the thread is switched in (see CONFIG_POSIX_THREAD_SPORADIC_SERVER_SWITCH_IN).
+ */
+
+BUILD_ASSERT(SCHED_SPORADIC < BIT(2), "only 2 bits in struct posix_thread_attr for schedpolicy");
+BUILD_ASSERT(CONFIG_POSIX_THREAD_SPORADIC_SERVER_MAX < UINT8_MAX,
+	     "only 8 bits in struct posix_thread_attr for ss_params");
+
+struct ss_repl {
+	/* uptime in ticks */
+	int64_t at;
+	/* cycles of budget */
+	uint64_t amount;
+};
+
+struct posix_sporadic {
+	struct k_thread *thread;
+	struct k_timer timer;
+	struct sched_param param;
+	/* Zephyr priorities */
+	int high;
+	int low;
+	k_ticks_t period;
+	/* budget in cycles */
+	int64_t init_budget;
+	int64_t budget;
+	/* execution cycles of the thread when it was last charged */
+	uint64_t used;
+	/* uptime in ticks when the thread was last charged */
+	int64_t activation;
+	uint8_t head;
+	uint8_t nrepl;
+	bool reserved;
+	bool exhausted;
+	/* whether the timer is running */
+	bool armed;
+	struct ss_repl repl[_POSIX_SS_REPL_MAX];
+};
+
+static struct k_spinlock ss_lock;
+static struct posix_sporadic servers[CONFIG_POSIX_THREAD_SPORADIC_SERVER_MAX];
+static struct sched_param attr_params[CONFIG_POSIX_THREAD_SPORADIC_SERVER_MAX];
+static bool attr_params_used[CONFIG_POSIX_THREAD_SPORADIC_SERVER_MAX];
+
+static void ss_check(struct posix_sporadic *ss);
+
+static bool ss_param_is_valid(const struct sched_param *param)
+{
+	if (!is_posix_policy_prio_valid(param->sched_priority, SCHED_SPORADIC) ||
+	    !is_posix_policy_prio_valid(param->sched_ss_low_priority, SCHED_SPORADIC) ||
+	    (param->sched_ss_low_priority > param->sched_priority)) {
+		return false;
+	}
+
+	if (!timespec_is_valid(&param->sched_ss_repl_period) ||
+	    !timespec_is_valid(&param->sched_ss_init_budget) ||
+	    (timespec_compare(&param->sched_ss_init_budget, &(struct timespec){0}) <= 0) ||
+	    (timespec_compare(&param->sched_ss_init_budget, &param->sched_ss_repl_period) > 0)) {
+		return false;
+	}
+
+	return (param->sched_ss_max_repl > 0) && (param->sched_ss_max_repl <= _POSIX_SS_REPL_MAX);
+}
+
+static uint64_t ss_used(struct k_thread *thread)
+{
+	k_thread_runtime_stats_t stats = {0};
+
+	(void)k_thread_runtime_stats_get(thread, &stats);
+
+	return stats.execution_cycles;
+}
+
+static int32_t ss_slice(const struct posix_sporadic *ss)
+{
+	if (ss->exhausted) {
+		return 0;
+	}
+
+	return (int32_t)CLAMP(k_cyc_to_ticks_ceil64(ss->budget), 1, INT32_MAX);
+}
+
+/* whether @p thread ran since it was last charged, or may run before it is next woken up */
+static bool ss_runnable(struct k_thread *thread, uint64_t delta)
+{
+	return (delta != 0) || (thread == k_current_get()) || z_is_thread_ready(thread);
+}
+
+static void ss_expired(struct k_thread *thread, void *data)
+{
+	ARG_UNUSED(thread);
+
+	ss_check(data);
+}
+
+static void ss_timer_expiry(struct k_timer *timer)
+{
+	ss_check(CONTAINER_OF(timer, struct posix_sporadic, timer));
+}
+
+/* charge the thread for what it has run, apply replenishments that are due, and rearm the timer */
+static bool ss_update(struct posix_sporadic *ss)
+{
+	int64_t next = INT64_MAX;
+	int64_t now = k_uptime_ticks();
+	uint64_t used = ss_used(ss->thread);
+	uint64_t delta = used - ss->used;
+	bool exhausted = ss->exhausted;
+	uint8_t tail;
+
+	ss->used = used;
+
+	/* only running at the high priority uses budget */
+	if (!ss->exhausted && (delta != 0)) {
+		ss->budget -= (int64_t)delta;
+		if (ss->nrepl < ss->param.sched_ss_max_repl) {
+			tail = (ss->head + ss->nrepl) % ARRAY_SIZE(ss->repl);
+			ss->repl[tail] = (struct ss_repl){
+				.at = ss->activation + ss->period,
+				.amount = delta,
+			};
+			++ss->nrepl;
+		} else {
+			/* out of replenishments, so defer this one until the latest */
+			tail = (ss->head + ss->nrepl - 1) % ARRAY_SIZE(ss->repl);
+			ss->repl[tail].amount += delta;
+		}
+	}
+	ss->activation = now;
+
+	while ((ss->nrepl > 0) && (ss->repl[ss->head].at <= now)) {
+		ss->budget = MIN(ss->budget + (int64_t)ss->repl[ss->head].amount, ss->init_budget);
+		ss->head = (ss->head + 1) % ARRAY_SIZE(ss->repl);
+		--ss->nrepl;
+	}
+
+	ss->exhausted = ss->budget <= 0;
+
+	if (ss->nrepl > 0) {
+		next = ss->repl[ss->head].at;
+	}
+
+	if (!ss->exhausted && ss_runnable(ss->thread, delta)) {
+		/* the earliest that the remaining budget could run out */
+		next = MIN(next, now + ss_slice(ss));
+	} else if (!ss->exhausted && !IS_ENABLED(CONFIG_POSIX_THREAD_SPORADIC_SERVER_SWITCH_IN)) {
+		/* nothing tells when a blocked thread runs again, so look once per period */
+		next = MIN(next, now + ss->period);
+	}
+
+	ss->armed = (next != INT64_MAX);
+	if (!ss->armed) {
+		k_timer_stop(&ss->timer);
+	} else {
+		k_timer_start(&ss->timer, K_TIMEOUT_ABS_TICKS(next), K_NO_WAIT);
+	}
+
+	return exhausted != ss->exhausted;
+}
+
+static void ss_apply(struct posix_sporadic *ss, struct k_thread *thread, bool changed, int prio,
+		     int32_t slice)
+{
+	if (changed) {
+		k_thread_priority_set(thread, prio);
+	}
+
+	/* the slice of a thread that is not running only takes effect when it next runs */
+	if (changed || (thread == k_current_get())) {
+		k_thread_time_slice_set(thread, slice, (slice == 0) ? NULL : ss_expired, ss);
+	}
+}
+
+static void ss_release_locked(struct posix_sporadic *ss)
+{
+	k_timer_stop(&ss->timer);
+	ss->armed = false;
+	ss->thread = NULL;
+	ss->reserved = false;
+}
+
+static void ss_check(struct posix_sporadic *ss)
+{
+	int prio = 0;
+	int32_t slice = 0;
+	bool changed = false;
+	struct k_thread *thread = NULL;
+
+	K_SPINLOCK(&ss_lock) {
+		if (ss->thread == NULL) {
+			K_SPINLOCK_BREAK;
+		}
+
+		if ((ss->thread->base.thread_state & _THREAD_DEAD) != 0) {
+			ss_release_locked(ss);
+			K_SPINLOCK_BREAK;
+		}
+
+		changed = ss_update(ss);
+		thread = ss->thread;
+		prio = ss->exhausted ? ss->low : ss->high;
+		slice = ss_slice(ss);
+	}
+
+	if (thread != NULL) {
+		ss_apply(ss, thread, changed, prio, slice);
+	}
+}
+
+static struct posix_sporadic *ss_find_locked(const struct k_thread *thread)
+{
+	ARRAY_FOR_EACH_PTR(servers, ss) {
+		if (ss->reserved && (ss->thread == thread)) {
+			return ss;
+		}
+	}
+
+	return NULL;
+}
+
+static struct posix_sporadic *ss_alloc_locked(void)
+{
+	ARRAY_FOR_EACH_PTR(servers, ss) {
+		if (!ss->reserved) {
+			ss->reserved = true;
+			ss->thread = NULL;
+			k_timer_init(&ss->timer, ss_timer_expiry, NULL);
+			return ss;
+		}
+	}
+
+	return NULL;
+}
+
+static void ss_init_locked(struct posix_sporadic *ss, struct k_thread *thread,
+			   const struct sched_param *param)
+{
+	k_timer_stop(&ss->timer);
+
+	ss->thread = thread;
+	ss->param = *param;
+	ss->high = posix_to_zephyr_priority(param->sched_priority, SCHED_SPORADIC);
+	ss->low = posix_to_zephyr_priority(param->sched_ss_low_priority, SCHED_SPORADIC);
+	ss->period = timespec_to_timeout(&param->sched_ss_repl_period, NULL).ticks;
+	ss->init_budget = (int64_t)k_ns_to_cyc_ceil64(
+		(uint64_t)param->sched_ss_init_budget.tv_sec * NSEC_PER_SEC +
+		param->sched_ss_init_budget.tv_nsec);
+	ss->budget = ss->init_budget;
+	ss->used = ss_used(thread);
+	ss->activation = k_uptime_ticks();
+	ss->head = 0;
+	ss->nrepl = 0;
+	ss->exhausted = false;
+	ss->armed = true;
+
+	k_timer_start(&ss->timer, K_TICKS(ss_slice(ss)), K_NO_WAIT);
+}
+
+int posix_sporadic_attr_set(struct posix_thread_attr *attr, const struct sched_param *param)
+{
+	int ret = 0;
+
+	if (!ss_param_is_valid(param)) {
+		return EINVAL;
+	}
+
+	K_SPINLOCK(&ss_lock) {
+		if (attr->ss_params == 0) {
+			for (size_t i = 0; i < ARRAY_SIZE(attr_params_used); ++i) {
+				if (!attr_params_used[i]) {
+					attr_params_used[i] = true;
+					attr->ss_params = i + 1;
+					break;
+				}
+			}
+		}
+
+		if (attr->ss_params == 0) {
+			ret = EAGAIN;
+			K_SPINLOCK_BREAK;
+		}
+
+		attr_params[attr->ss_params - 1] = *param;
+	}
+
+	return ret;
+}
+
+void posix_sporadic_attr_get(const struct posix_thread_attr *attr, struct sched_param *param)
+{
+	int priority = param->sched_priority;
+
+	if (attr->ss_params == 0) {
+		return;
+	}
+
+	K_SPINLOCK(&ss_lock) {
+		*param = attr_params[attr->ss_params - 1];
+	}
+	param->sched_priority = priority;
+}
+
+void posix_sporadic_attr_destroy(struct posix_thread_attr *attr)
+{
+	if (attr->ss_params == 0) {
+		return;
+	}
+
+	K_SPINLOCK(&ss_lock) {
+		attr_params_used[attr->ss_params - 1] = false;
+	}
+	attr->ss_params = 0;
+}
+
+int posix_sporadic_reserve(const struct posix_thread_attr *attr, struct posix_sporadic **ss)
+{
+	int ret = 0;
+
+	*ss = NULL;
+
+	if ((attr->schedpolicy != SCHED_SPORADIC) ||
+	    (attr->inheritsched != PTHREAD_EXPLICIT_SCHED)) {
+		return 0;
+	}
+
+	if (attr->ss_params == 0) {
+		/* pthread_attr_setschedparam() was not called after pthread_attr_setschedpolicy() */
+		return EINVAL;
+	}
+
+	K_SPINLOCK(&ss_lock) {
+		*ss = ss_alloc_locked();
+		if (*ss == NULL) {
+			ret = EAGAIN;
+			K_SPINLOCK_BREAK;
+		}
+
+		(*ss)->param = attr_params[attr->ss_params - 1];
+		(*ss)->param.sched_priority = attr->priority;
+	}
+
+	return ret;
+}
+
+void posix_sporadic_start(struct posix_sporadic *ss, struct k_thread *thread)
+{
+	int32_t slice = 0;
+
+	if (ss == NULL) {
+		return;
+	}
+
+	K_SPINLOCK(&ss_lock) {
+		if (thread == NULL) {
+			ss_release_locked(ss);
+			K_SPINLOCK_BREAK;
+		}
+
+		ss_init_locked(ss, thread, &ss->param);
+		slice = ss_slice(ss);
+	}
+
+	if (thread != NULL) {
+		k_thread_time_slice_set(thread, slice, ss_expired, ss);
+	}
+}
+
+int posix_sporadic_set(struct k_thread *thread, int policy, const struct sched_param *param)
+{
+	int ret = 0;
+	int prio = 0;
+	int32_t slice = 0;
+	bool started = false;
+	bool stopped = false;
+	struct posix_sporadic *ss;
+
+	if ((policy == SCHED_SPORADIC) && !ss_param_is_valid(param)) {
+		return EINVAL;
+	}
+
+	K_SPINLOCK(&ss_lock) {
+		ss = ss_find_locked(thread);
+
+		if (policy != SCHED_SPORADIC) {
+			if (ss != NULL) {
+				ss_release_locked(ss);
+				stopped = true;
+			}
+			K_SPINLOCK_BREAK;
+		}
+
+		if (ss == NULL) {
+			ss = ss_alloc_locked();
+			if (ss == NULL) {
+				ret = EAGAIN;
+				K_SPINLOCK_BREAK;
+			}
+		}
+
+		ss_init_locked(ss, thread, param);
+		prio = ss->high;
+		slice = ss_slice(ss);
+		started = true;
+	}
+
+	if (started) {
+		k_thread_priority_set(thread, prio);
+		k_thread_time_slice_set(thread, slice, ss_expired, ss);
+	} else if (stopped) {
+		/* the caller sets the new priority, and any time slice for it */
+		k_thread_time_slice_set(thread, 0, NULL, NULL);
+	}
+
+	return ret;
+}
+
+bool posix_sporadic_get(struct k_thread *thread, struct sched_param *param)
+{
+	bool found = false;
+	struct posix_sporadic *ss;
+
+	K_SPINLOCK(&ss_lock) {
+		ss = ss_find_locked(thread);
+		if (ss != NULL) {
+			*param = ss->param;
+			found = true;
+		}
+	}
+
+	return found;
+}
+
+void posix_sporadic_exit(struct k_thread *thread)
+{
+	struct posix_sporadic *ss;
+
+	K_SPINLOCK(&ss_lock) {
+		ss = ss_find_locked(thread);
+		if (ss != NULL) {
+			ss_release_locked(ss);
+		}
+	}
+}
+
+#ifdef CONFIG_POSIX_THREAD_SPORADIC_SERVER_SWITCH_IN
+void sys_trace_thread_switched_in_user(void)
+{
+	struct k_thread *thread = k_current_get();
+
+	ARRAY_FOR_EACH_PTR(servers, ss) {
+		/* only a server that was idle is locked, and checked again under the lock */
+		if ((ss->thread != thread) || ss->armed) {
+			continue;
+		}
+
+		K_SPINLOCK(&ss_lock) {
+			if ((ss->thread != thread) || ss->armed || ss->exhausted) {
+				K_SPINLOCK_BREAK;
+			}
+
+			/* the thread has not used budget since it was charged, so start afresh */
+			ss->activation = k_uptime_ticks();
+			ss->armed = true;
+			k_timer_start(&ss->timer, K_TICKS(ss_slice(ss)), K_NO_WAIT);
+		}
+		break;
+	}
+}
+#endif /* CONFIG_POSIX_THREAD_SPORADIC_SERVER_SWITCH_IN */
@@ -4,14 +4,298 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "cond_priv.h"
 #include "posix_clock.h"
 #include "posix_internal.h"
+#include "trace_priv.h"
 
 #include <pthread.h>
 
 #include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/sys/clock.h>
+#include <zephyr/sys/dlist.h>
 #include <zephyr/sys/thread.h>
+#include <zephyr/sys/timeutil.h>
+#include <zephyr/sys/util.h>
+
+#ifdef CONFIG_POSIX_COND_WAIT_MORPHING
+/*
+ * Wait morphing.
+ *
+ * Waiters block on a semaphore of their own rather than on the wait queue of the k_condvar, which
+ * then only provides the clock of the condition variable. pthread_cond_broadcast() wakes the first
+ * waiter and moves all others to the queue of their mutex, where they wait for it to be unlocked.
+ * Each unlock of a mutex then wakes the next of its waiters, so that every waiter is woken once,
+ * when it can acquire the mutex, instead of all of them waking only to block on the mutex again.
+ *
+ * Kernel objects have no room for the queues, so they are kept in two tables indexed by the
+ * address of the condition variable or mutex. Objects of the static pools map to distinct queues
+ * as long as the tables are at least as large as the pools, other objects may share a queue.
+ * The queue of a mutex is always locked after that of a condition variable, never before.
+ *
+ * A waiter that has been unlinked from either queue has been or is about to be woken, so it must
+ * consume its wakeup before its semaphore goes out of scope.
+ */
+
+#define COND_QUEUES CONFIG_POSIX_COND_WAIT_MORPHING_QUEUES
+
+struct cond_waiter {
+	sys_dnode_t node;
+	struct k_condvar *cv;
+	struct k_mutex *mu;
+	struct k_sem wake;
+	struct posix_clock_wait clock;
+	int prio;
+	/* moved to the queue of mu by pthread_cond_broadcast() */
+	bool morphed;
+};
+
+struct cond_queue {
+	struct k_spinlock lock;
+	/* waiters, in order of priority */
+	sys_dlist_t list;
+	atomic_t count;
+};
+
+#define COND_QUEUE_INIT(i, table) {.list = SYS_DLIST_STATIC_INIT(&table[i].list)}
+
+/* threads waiting on a condition variable */
+static struct cond_queue cond_waiters[COND_QUEUES] = {
+	LISTIFY(COND_QUEUES, COND_QUEUE_INIT, (,), cond_waiters)
+};
+/* threads waiting for a mutex to be unlocked */
+static struct cond_queue cond_morphed[COND_QUEUES] = {
+	LISTIFY(COND_QUEUES, COND_QUEUE_INIT, (,), cond_morphed)
+};
+
+static inline struct cond_queue *cond_queue_at(struct cond_queue *table, const void *obj,
+					       size_t size)
+{
+	return &table[((uintptr_t)obj / size) % COND_QUEUES];
+}
+
+static inline struct cond_queue *cond_waiters_of(const struct k_condvar *cv)
+{
+	return cond_queue_at(cond_waiters, cv, sizeof(*cv));
+}
+
+static inline struct cond_queue *cond_morphed_of(const struct k_mutex *mu)
+{
+	return cond_queue_at(cond_morphed, mu, sizeof(*mu));
+}
+
+/* with the lock of @p q held */
+static void cond_enqueue(struct cond_queue *q, struct cond_waiter *w)
+{
+	struct cond_waiter *it;
+
+	(void)atomic_inc(&q->count);
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&q->list, it, node) {
+		if (w->prio < it->prio) {
+			sys_dlist_insert(&it->node, &w->node);
+			return;
+		}
+	}
+
+	sys_dlist_append(&q->list, &w->node);
+}
+
+/* with the lock of @p q held */
+static void cond_dequeue(struct cond_queue *q, struct cond_waiter *w)
+{
+	sys_dlist_remove(&w->node);
+	(void)atomic_dec(&q->count);
+}
+
+static void cond_wake(struct k_condvar *cv, bool broadcast)
+{
+	struct cond_waiter *w;
+	struct cond_waiter *next;
+	struct cond_waiter *woken = NULL;
+	struct cond_queue *const q = cond_waiters_of(cv);
+	k_spinlock_key_t key = k_spin_lock(&q->lock);
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&q->list, w, next, node) {
+		if (w->cv != cv) {
+			continue;
+		}
+
+		cond_dequeue(q, w);
+
+		if (woken == NULL) {
+			woken = w;
+			if (!broadcast) {
+				break;
+			}
+			continue;
+		}
+
+		K_SPINLOCK(&cond_morphed_of(w->mu)->lock) {
+			w->morphed = true;
+			cond_enqueue(cond_morphed_of(w->mu), w);
+		}
+	}
+
+	k_spin_unlock(&q->lock, key);
+
+	if (woken != NULL) {
+		k_sem_give(&woken->wake);
+	}
+}
+
+void posix_cond_mutex_unlocked(struct k_mutex *mu)
+{
+	k_spinlock_key_t key;
+	struct cond_waiter *w;
+	struct cond_waiter *woken = NULL;
+	struct cond_queue *const q = cond_morphed_of(mu);
+
+	/* still held recursively, or already handed to a thread blocked in k_mutex_lock() */
+	if ((atomic_get(&q->count) == 0) || (mu->owner != NULL)) {
+		return;
+	}
+
+	key = k_spin_lock(&q->lock);
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&q->list, w, node) {
+		if (w->mu == mu) {
+			cond_dequeue(q, w);
+			woken = w;
+			break;
+		}
+	}
+
+	k_spin_unlock(&q->lock, key);
+
+	if (woken != NULL) {
+		k_sem_give(&woken->wake);
+	}
+}
+
+/* unlink @p w, returning false if it has been woken instead */
+static bool cond_wait_abandon(struct cond_waiter *w)
+{
+	bool linked;
+	struct cond_queue *const cq = cond_waiters_of(w->cv);
+	struct cond_queue *const mq = cond_morphed_of(w->mu);
+	k_spinlock_key_t ckey = k_spin_lock(&cq->lock);
+	k_spinlock_key_t mkey = k_spin_lock(&mq->lock);
+
+	linked = sys_dnode_is_linked(&w->node);
+	if (linked) {
+		cond_dequeue(w->morphed ? mq : cq, w);
+	}
+
+	k_spin_unlock(&mq->lock, mkey);
+	k_spin_unlock(&cq->lock, ckey);
+
+	if (!linked) {
+		(void)k_sem_take(&w->wake, K_FOREVER);
+	}
+
+	return linked;
+}
+
+static void cond_wait_cleanup(void *arg)
+{
+	struct cond_waiter *w = arg;
+
+	posix_clock_wait_end(&w->clock);
+	if (!cond_wait_abandon(w) && !w->morphed) {
+		/* pass a wakeup that was not consumed on to another waiter */
+		cond_wake(w->cv, false);
+	}
+
+	/* the mutex is held again when the cleanup handlers of the caller run */
+	(void)k_mutex_lock(w->mu, K_FOREVER);
+}
+
+static int cond_wait_morph(struct k_condvar *cv, struct k_mutex *mu, clockid_t clock_id,
+			   const struct timespec *abstime)
+{
+	int ret;
+	int more = 0;
+	k_timeout_t timeout = K_FOREVER;
+	struct cond_waiter w = {
+		.cv = cv,
+		.mu = mu,
+		.prio = k_thread_priority_get(k_current_get()),
+	};
+
+	if (mu->owner != k_current_get()) {
+		return EPERM;
+	}
+
+	if (abstime != NULL) {
+		if (clock_id == -1) {
+			clock_id = SYS_CLOCK_MASK & cv->options;
+		}
+
+		switch (clock_id) {
+		case SYS_CLOCK_REALTIME:
+		case SYS_CLOCK_MONOTONIC:
+			break;
+		default:
+			return EINVAL;
+		}
+
+		more = timespec_to_clock_timeout(clock_id, abstime, &timeout);
+		if (more < 0) {
+			return EINVAL;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return ETIMEDOUT;
+		}
+	}
+
+	k_sem_init(&w.wake, 0, 1);
+
+	K_SPINLOCK(&cond_waiters_of(cv)->lock) {
+		cond_enqueue(cond_waiters_of(cv), &w);
+	}
+
+	(void)k_mutex_unlock(mu);
+	posix_cond_mutex_unlocked(mu);
+
+	K_THREAD_CLEANUP_PUSH(cond_wait_cleanup, &w);
+	posix_clock_wait_begin(&w.clock, (abstime == NULL) ? -1 : (int)clock_id);
+	ret = posix_clock_sem_take(&w.clock, &w.wake, timeout);
+	while ((ret != 0) && (more > 0)) {
+		/* still queued, so a wakeup in between is not lost */
+		more = timespec_to_clock_timeout(clock_id, abstime, &timeout);
+		ret = posix_clock_sem_take(&w.clock, &w.wake, timeout);
+	}
+	posix_clock_wait_end(&w.clock);
+	K_THREAD_CLEANUP_POP(0);
+
+	/* a timeout after pthread_cond_broadcast() only spares the wait for the mutex */
+	if ((ret != 0) && cond_wait_abandon(&w) && !w.morphed) {
+		ret = ETIMEDOUT;
+	} else {
+		ret = 0;
+	}
+
+	(void)k_mutex_lock(mu, K_FOREVER);
+
+	return ret;
+}
+#endif /* CONFIG_POSIX_COND_WAIT_MORPHING */
+
+#ifdef CONFIG_POSIX_TRACING
+/* the time left until abstime of clock_id, or of the clock of cv if -1 */
+static k_timeout_t cond_trace_timeout(const struct k_condvar *cv, clockid_t clock_id,
+				      const struct timespec *abstime)
+{
+	if (clock_id == -1) {
+		clock_id = SYS_CLOCK_MASK & cv->options;
+	}
+
+	return sys_trace_posix_abstime((int)clock_id, abstime);
+}
+#endif
 
 static int cond_wait(pthread_cond_t *cvar, pthread_mutex_t *mu, clockid_t clock_id, const struct timespec *abstime)
 {
@@ -31,15 +315,26 @@ static int cond_wait(pthread_cond_t *cvar, pthread_mutex_t *mu, clockid_t clock_
 		}
 	}
 
+	sys_port_trace_posix_enter(PTHREAD_COND_WAIT, to_k_condvar(cvar),
+				   cond_trace_timeout(to_k_condvar(cvar), clock_id, abstime));
+	/* a wait on a condition variable always blocks */
+	sys_port_trace_posix_blocking(PTHREAD_COND_WAIT, to_k_condvar(cvar), true);
+
+#ifdef CONFIG_POSIX_COND_WAIT_MORPHING
+	ret = cond_wait_morph(to_k_condvar(cvar), to_k_mutex(mu), clock_id, abstime);
+#else
 	if (abstime == NULL) {
-		return -k_condvar_wait(to_k_condvar(cvar), to_k_mutex(mu), K_FOREVER);
+		ret = -k_condvar_wait(to_k_condvar(cvar), to_k_mutex(mu), K_FOREVER);
+	} else if (clock_id == -1) {
+		ret = -k_condvar_timedwait(to_k_condvar(cvar), to_k_mutex(mu), abstime);
+	} else {
+		ret = -k_condvar_clockwait(to_k_condvar(cvar), to_k_mutex(mu), clock_id, abstime);
 	}
+#endif
 
-	if (clock_id == -1) {
-		return -k_condvar_timedwait(to_k_condvar(cvar), to_k_mutex(mu), abstime);
-	}
+	sys_port_trace_posix_exit(PTHREAD_COND_WAIT, to_k_condvar(cvar), ret);
 
-	return -k_condvar_clockwait(to_k_condvar(cvar), to_k_mutex(mu), clock_id, abstime);
+	return ret;
 }
 
 int pthread_cond_signal(pthread_cond_t *cvar)
@@ -53,7 +348,16 @@ int pthread_cond_signal(pthread_cond_t *cvar)
 		}
 	}
 
-	return -k_condvar_signal(to_k_condvar(cvar));
+#ifdef CONFIG_POSIX_COND_WAIT_MORPHING
+	cond_wake(to_k_condvar(cvar), false);
+	ret = 0;
+#else
+	ret = -k_condvar_signal(to_k_condvar(cvar));
+#endif
+
+	sys_port_trace_posix_call(PTHREAD_COND_SIGNAL, to_k_condvar(cvar), ret);
+
+	return ret;
 }
 
 int pthread_cond_broadcast(pthread_cond_t *cvar)
@@ -67,7 +371,16 @@ int pthread_cond_broadcast(pthread_cond_t *cvar)
 		}
 	}
 
-	return -k_condvar_broadcast(to_k_condvar(cvar));
+#ifdef CONFIG_POSIX_COND_WAIT_MORPHING
+	cond_wake(to_k_condvar(cvar), true);
+	ret = 0;
+#else
+	ret = -k_condvar_broadcast(to_k_condvar(cvar));
+#endif
+
+	sys_port_trace_posix_call(PTHREAD_COND_BROADCAST, to_k_condvar(cvar), ret);
+
+	return ret;
 }
 
 int pthread_cond_wait(pthread_cond_t *cv, pthread_mutex_t *mut)
@@ -119,17 +432,25 @@ int pthread_cond_init(pthread_cond_t *cvar, const pthread_condattr_t *att)
 
 	ret = sys_condvar_alloc(&cond, sys_clock_id);
 	if (ret < 0) {
+		sys_port_trace_posix_call(PTHREAD_COND_INIT, NULL, -ret);
 		return -ret;
 	}
 
 	*cvar = (pthread_cond_t)(uintptr_t)cond;
+	sys_port_trace_posix_call(PTHREAD_COND_INIT, cond, 0);
 
 	return 0;
 }
 
 int pthread_cond_destroy(pthread_cond_t *cvar)
 {
-	return -sys_condvar_destroy(to_k_condvar(cvar));
+	int ret;
+	struct k_condvar *const cond = to_k_condvar(cvar);
+
+	ret = -sys_condvar_destroy(cond);
+	sys_port_trace_posix_call(PTHREAD_COND_DESTROY, cond, ret);
+
+	return ret;
 }
 
 int pthread_condattr_init(pthread_condattr_t *att)
@@ -4,8 +4,10 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "cond_priv.h"
 #include "posix_internal.h"
 #include "posix_clock.h"
+#include "trace_priv.h"
 
 #include <pthread.h>
 
@@ -15,7 +17,13 @@
 
 int pthread_mutex_destroy(pthread_mutex_t *mu)
 {
-	return -sys_mutex_destroy(to_k_mutex(mu));
+	int ret;
+	struct k_mutex *const mutex = to_k_mutex(mu);
+
+	ret = -sys_mutex_destroy(mutex);
+	sys_port_trace_posix_call(PTHREAD_MUTEX_DESTROY, mutex, ret);
+
+	return ret;
 }
 
 static int pthread_mutexattr_to_flags(const pthread_mutexattr_t *attr, int *flags)
@@ -67,17 +75,22 @@ int pthread_mutex_init(pthread_mutex_t *mu, const pthread_mutexattr_t *attr)
 
 	ret = sys_mutex_alloc(&mutex, flags);
 	if (ret < 0) {
+		sys_port_trace_posix_call(PTHREAD_MUTEX_INIT, NULL, -ret);
 		return -ret;
 	}
 
 	*mu = (pthread_mutex_t)(uintptr_t)mutex;
+	sys_port_trace_posix_call(PTHREAD_MUTEX_INIT, mutex, 0);
 
 	return 0;
 }
 
-static int pthread_mutex_lock_common(pthread_mutex_t *m, k_timeout_t timeout)
+static int pthread_mutex_lock_common(pthread_mutex_t *m, clockid_t clock_id,
+				     const struct timespec *abstime, k_timeout_t timeout)
 {
 	int ret;
+	int more = 0;
+	struct k_mutex *mutex;
 
 	if (*m == PTHREAD_MUTEX_INITIALIZER) {
 		ret = pthread_mutex_init(m, NULL);
@@ -87,35 +100,80 @@ static int pthread_mutex_lock_common(pthread_mutex_t *m, k_timeout_t timeout)
 		}
 	}
 
-	ret = -k_mutex_lock(to_k_mutex(m), timeout);
+	mutex = to_k_mutex(m);
+	sys_port_trace_posix_enter(PTHREAD_MUTEX_LOCK, mutex,
+				   (abstime == NULL) ? timeout
+						     : sys_trace_posix_abstime(clock_id, abstime));
+	sys_port_trace_posix_blocking(PTHREAD_MUTEX_LOCK, mutex,
+				      (mutex->owner != NULL) && (mutex->owner != k_current_get()));
+
+	do {
+		if (abstime != NULL) {
+			more = timespec_to_clock_timeout((int)clock_id, abstime, &timeout);
+			if (more < 0) {
+				/* an invalid abstime is only an error if the lock is held */
+				timeout = K_NO_WAIT;
+			}
+		}
+
+		ret = -k_mutex_lock(mutex, timeout);
+	} while ((ret == EAGAIN) && (more > 0));
 
-	if ((ret == EAGAIN) || (ret == EBUSY)) {
+	if ((ret == EBUSY) && (more < 0)) {
+		ret = EINVAL;
+	} else if ((ret == EAGAIN) || (ret == EBUSY)) {
 		/* POSIX requires ETIMEDOUT. Maybe adjust k_mutex_lock()? */
 		ret = ETIMEDOUT;
 	}
 
+	sys_port_trace_posix_exit(PTHREAD_MUTEX_LOCK, mutex, ret);
+
 	return ret;
 }
 
 int pthread_mutex_lock(pthread_mutex_t *m)
 {
-	return pthread_mutex_lock_common(m, K_FOREVER);
+	return pthread_mutex_lock_common(m, CLOCK_REALTIME, NULL, K_FOREVER);
 }
 
 int pthread_mutex_timedlock(pthread_mutex_t *m,
 			    const struct timespec *abstime)
 {
-	return pthread_mutex_lock_common(m, sys_timepoint_timeout(timespec_abs_rt_to_timepoint(abstime)));
+	if (abstime == NULL) {
+		return EINVAL;
+	}
+
+	return pthread_mutex_lock_common(m, CLOCK_REALTIME, abstime, K_NO_WAIT);
+}
+
+int pthread_mutex_clocklock(pthread_mutex_t *m, clockid_t clock_id,
+			    const struct timespec *abstime)
+{
+	if ((abstime == NULL) || ((clock_id != CLOCK_REALTIME) && (clock_id != CLOCK_MONOTONIC))) {
+		return EINVAL;
+	}
+
+	return pthread_mutex_lock_common(m, clock_id, abstime, K_NO_WAIT);
 }
 
 int pthread_mutex_trylock(pthread_mutex_t *m)
 {
-	return pthread_mutex_lock_common(m, K_NO_WAIT);
+	return pthread_mutex_lock_common(m, CLOCK_REALTIME, NULL, K_NO_WAIT);
 }
 
 int pthread_mutex_unlock(pthread_mutex_t *mu)
 {
-	return -k_mutex_unlock(to_k_mutex(mu));
+	int ret;
+	struct k_mutex *const mutex = to_k_mutex(mu);
+
+	ret = k_mutex_unlock(mutex);
+	if (ret == 0) {
+		posix_cond_mutex_unlocked(mutex);
+	}
+
+	sys_port_trace_posix_call(PTHREAD_MUTEX_UNLOCK, mutex, -ret);
+
+	return -ret;
 }
 
 int pthread_mutexattr_init(pthread_mutexattr_t *attr)
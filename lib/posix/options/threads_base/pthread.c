@@ -6,8 +6,16 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "domain_priv.h"
+#include "guard_priv.h"
+#include "itimer_priv.h"
+#include "percpu_priv.h"
 #include "posix_clock.h"
 #include "posix_internal.h"
+#include "sched_priv.h"
+#include "sig_wake_priv.h"
+#include "sporadic_priv.h"
+#include "trace_priv.h"
 
 #include <limits.h>
 #include <pthread.h>
@@ -74,6 +82,14 @@ int pthread_attr_setschedparam(pthread_attr_t *_attr, const struct sched_param *
 		return EINVAL;
 	}
 
+	if (attr->schedpolicy == SCHED_SPORADIC) {
+		int ret = posix_sporadic_attr_set(attr, schedparam);
+
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
 	attr->priority = schedparam->sched_priority;
 	return 0;
 }
@@ -82,11 +98,31 @@ FUNC_NORETURN
 static void zephyr_thread_wrapper(void *arg1, void *arg2, void *arg3)
 {
 	void *(*fun_ptr)(void *arg) = arg2;
+	void *retval;
+
+	posix_domain_enter(arg3);
+	posix_itimer_thread_start();
+	retval = fun_ptr(arg1);
 
-	k_thread_exit(fun_ptr(arg1));
+	posix_sporadic_exit(k_current_get());
+	posix_thread_guard_exit(k_current_get());
+	posix_itimer_thread_exit();
+	posix_domain_exit();
+	k_thread_exit(retval);
 	CODE_UNREACHABLE;
 }
 
+bool posix_is_pthread(const struct k_thread *thread)
+{
+#ifdef CONFIG_THREAD_MONITOR
+	return thread->entry.pthread_entry == zephyr_thread_wrapper;
+#else
+	ARG_UNUSED(thread);
+
+	return false;
+#endif
+}
+
 int pthread_create(pthread_t *ZRESTRICT thread, const pthread_attr_t *ZRESTRICT attr,
 		   void *(*start_routine)(void *), void *ZRESTRICT arg)
 {
@@ -94,6 +130,8 @@ int pthread_create(pthread_t *ZRESTRICT thread, const pthread_attr_t *ZRESTRICT
 	int prio;
 	uint32_t options = 0;
 	struct k_thread *k_thread;
+	struct posix_sporadic *ss;
+	struct posix_domain *domain;
 	struct posix_thread_attr *attrp;
 	struct posix_thread_attr default_attr __aligned(alignof(pthread_attr_t));
 
@@ -121,13 +159,39 @@ int pthread_create(pthread_t *ZRESTRICT thread, const pthread_attr_t *ZRESTRICT
 		prio = posix_to_zephyr_priority(attrp->priority, attrp->schedpolicy);
 	}
 
-	ret = -sys_thread_create(&k_thread, attrp->stack, attrp->stacksize, attrp->guardsize,
-				 zephyr_thread_wrapper, arg, start_routine, NULL, prio, options);
+	ret = posix_sporadic_reserve(attrp, &ss);
+	if (ret != 0) {
+		return ret;
+	}
+
+	/* the new thread joins the domain when it starts */
+	domain = posix_domain_hold();
+
+	/* a sporadic server must not run before its budget is set up */
+	if (ss != NULL) {
+		k_sched_lock();
+	}
+
+	ret = -sys_thread_create(&k_thread, attrp->stack, posix_thread_guard_stack_size(attrp),
+				 attrp->guardsize, zephyr_thread_wrapper, arg, start_routine, domain,
+				 prio, options);
 
 	if (ret == 0) {
+		posix_thread_guard_arm(k_thread, attrp);
+		posix_sched_thread_update(k_thread);
+		posix_sporadic_start(ss, k_thread);
 		*thread = to_pthread_thread(k_thread);
+	} else {
+		posix_sporadic_start(ss, NULL);
+		posix_domain_release(domain);
+	}
+
+	if (ss != NULL) {
+		k_sched_unlock();
 	}
 
+	sys_port_trace_posix_call(PTHREAD_CREATE, (ret == 0) ? k_thread : NULL, ret);
+
 	return ret;
 }
 
@@ -190,7 +254,13 @@ void pthread_testcancel(void)
 
 int pthread_cancel(pthread_t pthread)
 {
-	return -k_thread_cancel(to_k_thread(&pthread));
+	int ret;
+	struct k_thread *const k_thread = to_k_thread(&pthread);
+
+	ret = -k_thread_cancel(k_thread);
+	sys_port_trace_posix_call(PTHREAD_CANCEL, k_thread, ret);
+
+	return ret;
 }
 
 int pthread_attr_init(pthread_attr_t *attr)
@@ -209,18 +279,36 @@ int pthread_once(pthread_once_t *once, void (*init_func)(void))
 FUNC_NORETURN
 void pthread_exit(void *retval)
 {
+	sys_port_trace_posix_call(PTHREAD_EXIT, k_current_get(), 0);
+	posix_sporadic_exit(k_current_get());
+	posix_thread_guard_exit(k_current_get());
+	posix_itimer_thread_exit();
+	posix_domain_exit();
 	k_thread_exit(retval);
 	CODE_UNREACHABLE;
 }
 
 int pthread_join(pthread_t pthread, void **status)
 {
-	return -k_thread_rejoin(to_k_thread(&pthread), status, K_FOREVER);
+	int ret;
+	struct k_thread *const k_thread = to_k_thread(&pthread);
+
+	sys_port_trace_posix_enter(PTHREAD_JOIN, k_thread, K_FOREVER);
+	ret = -k_thread_rejoin(k_thread, status, K_FOREVER);
+	sys_port_trace_posix_exit(PTHREAD_JOIN, k_thread, ret);
+
+	return ret;
 }
 
 int pthread_detach(pthread_t pthread)
 {
-	return -k_thread_detach(to_k_thread(&pthread));
+	int ret;
+	struct k_thread *const k_thread = to_k_thread(&pthread);
+
+	ret = -k_thread_detach(k_thread);
+	sys_port_trace_posix_call(PTHREAD_DETACH, k_thread, ret);
+
+	return ret;
 }
 
 int pthread_attr_getdetachstate(const pthread_attr_t *_attr, int *detachstate)
@@ -257,6 +345,7 @@ int pthread_attr_getschedparam(const pthread_attr_t *_attr, struct sched_param *
 	}
 
 	schedparam->sched_priority = attr->priority;
+	posix_sporadic_attr_get(attr, schedparam);
 	return 0;
 }
 
@@ -273,6 +362,7 @@ int pthread_attr_destroy(pthread_attr_t *_attr)
 		return EINVAL;
 	}
 
+	posix_sporadic_attr_destroy(attr);
 	*attr = (struct posix_thread_attr){0};
 	LOG_DBG("Destroyed attr %p", _attr);
 
@@ -340,7 +430,11 @@ int pthread_kill(pthread_t thread, int sig)
 		}
 	}
 
-	ret = k_sig_queue(to_k_thread(&thread), ksigno, (union k_sig_val){0});
+	ret = posix_sig_queue(to_k_thread(&thread), ksigno, (union k_sig_val){0});
+	sys_port_trace_posix_call(KILL, to_k_thread(&thread), -ret);
+	if ((ret == 0) && (ksigno != 0)) {
+		posix_stat_inc(POSIX_STAT_SIG_SENT);
+	}
 
 	return -ret;
 }
@@ -350,3 +444,14 @@ int sched_yield(void)
 	k_yield();
 	return 0;
 }
+
+int sched_getcpu(void)
+{
+	/* the CPU of the caller can not be read from user mode */
+	if (k_is_user_context()) {
+		errno = ENOSYS;
+		return -1;
+	}
+
+	return (int)posix_percpu_cpu();
+}
@@ -0,0 +1,427 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "guard_priv.h"
+#include "posix_internal.h"
+#include "sig_wake_priv.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/signal.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+LOG_MODULE_REGISTER(pthread_guard, CONFIG_PTHREAD_LOG_LEVEL);
+
+/*
+ * The guard area of a thread is the bottom of a stack that was allocated that much larger than
+ * asked for. It keeps the pattern of CONFIG_INIT_STACKS that it was filled with when the thread
+ * was created, so a thread that has written into its guard area has overflowed the stack it asked
+ * for. Checking a guard area scans all of its words, from the bottom up, so that an overflow that
+ * skips over its top is found as well.
+ *
+ * Guarded threads are kept in a table indexed by the address of the thread, as in csw.c, rather
+ * than in the guard area itself, which an overflow would overwrite first.
+ *
+ * With CONFIG_POSIX_THREAD_GUARD_SWITCH_OUT, each guarded thread that is switched out is checked
+ * by its stack pointer and by the top and bottom words of its guard area. The scheduler is locked
+ * there, so a hit only starts a timer, which hands the full check and the signal to the system
+ * workqueue. Otherwise, the system workqueue checks every guard area each
+ * CONFIG_POSIX_THREAD_GUARD_CHECK_MS milliseconds. Either way, a thread is checked once more when
+ * it exits.
+ */
+#define GUARD_FILL      0xaaU
+#define GUARD_FILL_WORD (GUARD_FILL * 0x01010101U)
+#define GUARD_MIN       (2 * sizeof(uint32_t))
+
+/* states of a guard entry */
+#define GUARD_FREE     0
+#define GUARD_OK       1
+#define GUARD_HIT      2
+#define GUARD_REPORTED 3
+
+/* at most this many overflows are signalled per check, the others are found by the next one */
+#define GUARD_BATCH 4
+
+struct guard_entry {
+	atomic_ptr_t thread;
+	atomic_t state;
+	/* changes each time the entry is claimed */
+	uint32_t gen;
+	uint8_t *base;
+	size_t size;
+};
+
+/* a copy of an entry to check, so that its guard area is scanned without guard_lock held */
+struct guard_check {
+	struct guard_entry *e;
+	struct k_thread *thread;
+	uint32_t gen;
+	uint8_t *base;
+	size_t size;
+};
+
+struct guard_overflow {
+	struct k_thread *thread;
+	uint8_t *lowest;
+	size_t depth;
+	size_t size;
+};
+
+static struct k_spinlock guard_lock;
+static struct guard_entry guard_table[CONFIG_POSIX_THREAD_GUARD_MAX];
+static atomic_t guard_count;
+
+static void guard_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(guard_work, guard_work_handler);
+
+#ifdef CONFIG_POSIX_THREAD_GUARD_SWITCH_OUT
+static void guard_timer_expiry(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	(void)k_work_reschedule(&guard_work, K_NO_WAIT);
+}
+
+static K_TIMER_DEFINE(guard_timer, guard_timer_expiry, NULL);
+#endif
+
+static size_t guard_round(size_t guardsize)
+{
+	return ROUND_UP(MAX(guardsize, GUARD_MIN), ARCH_STACK_PTR_ALIGN);
+}
+
+static inline size_t guard_hash(const struct k_thread *thread)
+{
+	return ((uintptr_t)thread / sizeof(struct k_thread)) % ARRAY_SIZE(guard_table);
+}
+
+static struct guard_entry *guard_find(const struct k_thread *thread)
+{
+	size_t i = guard_hash(thread);
+
+	for (size_t n = 0; n < ARRAY_SIZE(guard_table); ++n) {
+		if (atomic_ptr_get(&guard_table[i].thread) == thread) {
+			return &guard_table[i];
+		}
+
+		i = (i + 1) % ARRAY_SIZE(guard_table);
+	}
+
+	return NULL;
+}
+
+/* with guard_lock held */
+static void guard_release_locked(struct guard_entry *e)
+{
+	atomic_set(&e->state, GUARD_FREE);
+	atomic_ptr_clear(&e->thread);
+	(void)atomic_dec(&guard_count);
+}
+
+/* with guard_lock held */
+static struct guard_entry *guard_claim_locked(struct k_thread *thread)
+{
+	size_t i = guard_hash(thread);
+	struct guard_entry *e;
+	struct k_thread *owner;
+
+	for (size_t n = 0; n < ARRAY_SIZE(guard_table); ++n) {
+		e = &guard_table[i];
+		owner = atomic_ptr_get(&e->thread);
+
+		/* a thread that was aborted rather than exiting leaves its entry behind */
+		if ((owner != NULL) && ((owner->base.thread_state & _THREAD_DEAD) != 0U)) {
+			guard_release_locked(e);
+			owner = NULL;
+		}
+
+		if (owner == NULL) {
+			atomic_ptr_set(&e->thread, thread);
+			++e->gen;
+			(void)atomic_inc(&guard_count);
+			return e;
+		}
+
+		i = (i + 1) % ARRAY_SIZE(guard_table);
+	}
+
+	return NULL;
+}
+
+/* the lowest address written in the guard area at @p base, or NULL if there is none */
+static uint8_t *guard_scan(uint8_t *base, size_t size)
+{
+	uint8_t *lowest;
+	const uint32_t *word = (const uint32_t *)base;
+	const uint32_t *const end = (const uint32_t *)&base[size];
+
+	for (; word < end; ++word) {
+		if (*word != GUARD_FILL_WORD) {
+			for (lowest = (uint8_t *)word; *lowest == GUARD_FILL; ++lowest) {
+			}
+
+			return lowest;
+		}
+	}
+
+	return NULL;
+}
+
+size_t posix_thread_guard_stack_size(const struct posix_thread_attr *attr)
+{
+	size_t stack_size;
+
+	/* POSIX ignores the guard size of stacks that are provided by the application */
+	if ((attr->stack != NULL) || (attr->guardsize == 0)) {
+		return attr->stacksize;
+	}
+
+	stack_size = MAX(attr->stacksize, CONFIG_SYS_THREAD_STACK_SIZE);
+	if (attr->guardsize > UINT32_MAX - stack_size - GUARD_MIN - ARCH_STACK_PTR_ALIGN) {
+		/* too large to be allocated */
+		return UINT32_MAX;
+	}
+
+	return stack_size + guard_round(attr->guardsize);
+}
+
+void posix_thread_guard_arm(struct k_thread *thread, const struct posix_thread_attr *attr)
+{
+	struct guard_entry *e;
+	bool armed = false;
+	bool full = false;
+
+	/* user mode can not write the table, so the guard area is not checked */
+	if (k_is_user_context()) {
+		return;
+	}
+
+	K_SPINLOCK(&guard_lock) {
+		/* a thread that was aborted may have left its entry behind */
+		e = guard_find(thread);
+		if (e != NULL) {
+			guard_release_locked(e);
+		}
+
+		/* the thread may have exited already */
+		if ((attr->stack != NULL) || (attr->guardsize == 0) ||
+		    ((thread->base.thread_state & _THREAD_DEAD) != 0U)) {
+			K_SPINLOCK_BREAK;
+		}
+
+		e = guard_claim_locked(thread);
+		if (e == NULL) {
+			full = true;
+			K_SPINLOCK_BREAK;
+		}
+
+		/* the thread may be running already, but only uses the top of its stack */
+		e->base = (uint8_t *)thread->stack_info.start;
+		e->size = guard_round(attr->guardsize);
+		atomic_set(&e->state, GUARD_OK);
+		armed = true;
+	}
+
+	if (full) {
+		LOG_WRN("no room to check the guard area of pthread %p", (void *)thread);
+	}
+
+	if (armed && !IS_ENABLED(CONFIG_POSIX_THREAD_GUARD_SWITCH_OUT)) {
+		(void)k_work_schedule(&guard_work, K_MSEC(CONFIG_POSIX_THREAD_GUARD_CHECK_MS));
+	}
+}
+
+void posix_thread_guard_exit(struct k_thread *thread)
+{
+	size_t size = 0;
+	uint8_t *base = NULL;
+	uint8_t *lowest = NULL;
+	struct guard_entry *e = guard_find(thread);
+
+	if (e == NULL) {
+		return;
+	}
+
+	K_SPINLOCK(&guard_lock) {
+		if (atomic_ptr_get(&e->thread) != thread) {
+			K_SPINLOCK_BREAK;
+		}
+
+		if (atomic_get(&e->state) != GUARD_REPORTED) {
+			base = e->base;
+			size = e->size;
+		}
+
+		guard_release_locked(e);
+	}
+
+	/* the stack of the thread stays allocated until it has exited */
+	if (base != NULL) {
+		lowest = guard_scan(base, size);
+	}
+
+	if (lowest != NULL) {
+		LOG_ERR("pthread %p overflowed its stack down to %p before it exited",
+			(void *)thread, (void *)lowest);
+	}
+}
+
+#ifdef CONFIG_POSIX_THREAD_GUARD_SWITCH_OUT
+void posix_thread_guard_switched_out(void)
+{
+	struct guard_entry *e;
+	const uint32_t *guard;
+	/* close enough to the stack pointer of the thread being switched out */
+	const uint8_t *sp = (const uint8_t *)&e;
+
+	if (atomic_get(&guard_count) == 0) {
+		return;
+	}
+
+	e = guard_find(k_current_get());
+	if ((e == NULL) || (atomic_get(&e->state) != GUARD_OK)) {
+		return;
+	}
+
+	/*
+	 * the thread is in its guard area now, or has been through the top of it, or all the way
+	 * through to its bottom
+	 */
+	guard = (const uint32_t *)e->base;
+	if ((sp >= &e->base[e->size]) && (guard[0] == GUARD_FILL_WORD) &&
+	    (guard[e->size / sizeof(uint32_t) - 1] == GUARD_FILL_WORD)) {
+		return;
+	}
+
+	if (atomic_cas(&e->state, GUARD_OK, GUARD_HIT)) {
+		k_timer_start(&guard_timer, K_NO_WAIT, K_NO_WAIT);
+	}
+}
+#endif /* CONFIG_POSIX_THREAD_GUARD_SWITCH_OUT */
+
+/*
+ * Copy up to @p max entries to check into @p checks, from the entry at @p *next on, and advance
+ * @p *next past them. With guard_lock held.
+ */
+static size_t guard_collect_locked(size_t *next, struct guard_check *checks, size_t max)
+{
+	size_t n = 0;
+	struct guard_entry *e;
+	struct k_thread *thread;
+	atomic_val_t state;
+
+	for (; (*next < ARRAY_SIZE(guard_table)) && (n < max); ++*next) {
+		e = &guard_table[*next];
+		thread = atomic_ptr_get(&e->thread);
+		state = atomic_get(&e->state);
+
+		if ((thread == NULL) || (state == GUARD_FREE) || (state == GUARD_REPORTED)) {
+			continue;
+		}
+
+		if ((thread->base.thread_state & _THREAD_DEAD) != 0U) {
+			guard_release_locked(e);
+			continue;
+		}
+
+		/* only threads that were hit when switched out are checked */
+		if (IS_ENABLED(CONFIG_POSIX_THREAD_GUARD_SWITCH_OUT) && (state != GUARD_HIT)) {
+			continue;
+		}
+
+		checks[n++] = (struct guard_check){
+			.e = e,
+			.thread = thread,
+			.gen = e->gen,
+			.base = e->base,
+			.size = e->size,
+		};
+	}
+
+	return n;
+}
+
+/* Record the result of scanning @p c, and return whether it is an overflow to report */
+static bool guard_settle(const struct guard_check *c, uint8_t *lowest)
+{
+	bool report = false;
+	struct guard_entry *e = c->e;
+
+	K_SPINLOCK(&guard_lock) {
+		/* the thread may have exited, and its entry been claimed again, meanwhile */
+		if ((atomic_ptr_get(&e->thread) != c->thread) || (e->gen != c->gen)) {
+			K_SPINLOCK_BREAK;
+		}
+
+		if (lowest == NULL) {
+			/* only the stack pointer reached into the guard area */
+			(void)atomic_cas(&e->state, GUARD_HIT, GUARD_OK);
+			K_SPINLOCK_BREAK;
+		}
+
+		/* an overflow is only reported once */
+		report = atomic_set(&e->state, GUARD_REPORTED) != GUARD_REPORTED;
+	}
+
+	return report;
+}
+
+static void guard_work_handler(struct k_work *work)
+{
+	size_t n = 0;
+	size_t next = 0;
+	uint8_t *lowest;
+	size_t num_overflows = 0;
+	struct guard_check checks[GUARD_BATCH];
+	struct guard_overflow overflows[GUARD_BATCH];
+
+	ARG_UNUSED(work);
+
+	/* the guard areas are scanned without guard_lock held, a few entries at a time */
+	while ((next < ARRAY_SIZE(guard_table)) && (num_overflows < ARRAY_SIZE(overflows))) {
+		K_SPINLOCK(&guard_lock) {
+			n = guard_collect_locked(&next, checks,
+						 ARRAY_SIZE(overflows) - num_overflows);
+		}
+
+		for (size_t i = 0; i < n; ++i) {
+			lowest = guard_scan(checks[i].base, checks[i].size);
+			if (!guard_settle(&checks[i], lowest)) {
+				continue;
+			}
+
+			overflows[num_overflows++] = (struct guard_overflow){
+				.thread = checks[i].thread,
+				.lowest = lowest,
+				.depth = &checks[i].base[checks[i].size] - lowest,
+				.size = checks[i].size,
+			};
+		}
+	}
+
+	for (size_t i = 0; i < num_overflows; ++i) {
+		struct guard_overflow *ov = &overflows[i];
+
+		LOG_ERR("pthread %p overflowed its stack by %zu of its %zu guard bytes, down to %p",
+			(void *)ov->thread, ov->depth, ov->size, (void *)ov->lowest);
+
+		(void)posix_sig_queue(ov->thread, K_SIG_SEGV,
+				      (union k_sig_val){.sival_ptr = ov->lowest});
+	}
+
+	if (next < ARRAY_SIZE(guard_table)) {
+		/* more overflows may be left to report */
+		(void)k_work_schedule(&guard_work, K_NO_WAIT);
+	} else if (!IS_ENABLED(CONFIG_POSIX_THREAD_GUARD_SWITCH_OUT) &&
+		   (atomic_get(&guard_count) > 0)) {
+		/* stop checking when no guarded thread is left */
+		(void)k_work_schedule(&guard_work, K_MSEC(CONFIG_POSIX_THREAD_GUARD_CHECK_MS));
+	}
+}
@@ -71,6 +71,9 @@ int clock_settime(clockid_t clock_id, const struct timespec *tp)
 		return -1;
 	}
 
+	/* timed waits until a realtime time end at the new time */
+	posix_clock_realtime_set();
+
 	return 0;
 }
 
@@ -98,6 +101,17 @@ int usleep(useconds_t useconds)
 		return -1;
 	}
 
+#ifdef CONFIG_POSIX_PRECISE_SLEEP
+	struct timespec rqtp = {.tv_nsec = useconds * NSEC_PER_USEC};
+
+	rem = posix_precise_nanosleep(SYS_CLOCK_MONOTONIC, 0, &rqtp, NULL);
+	if (rem < 0) {
+		errno = -rem;
+		return -1;
+	}
+
+	return 0;
+#else
 	rem = k_usleep(useconds);
 	__ASSERT_NO_MSG(rem >= 0);
 	if (rem > 0) {
@@ -107,6 +121,7 @@ int usleep(useconds_t useconds)
 	}
 
 	return 0;
+#endif
 }
 
 int nanosleep(const struct timespec *rqtp, struct timespec *rmtp)
@@ -118,7 +133,11 @@ int nanosleep(const struct timespec *rqtp, struct timespec *rmtp)
 		return -1;
 	}
 
+#ifdef CONFIG_POSIX_PRECISE_SLEEP
+	ret = posix_precise_nanosleep(SYS_CLOCK_REALTIME, 0, rqtp, rmtp);
+#else
 	ret = sys_clock_nanosleep(SYS_CLOCK_REALTIME, 0, rqtp, rmtp);
+#endif
 	if (ret < 0) {
 		errno = -ret;
 		return -1;
@@ -14,7 +14,10 @@
 #include <time.h>
 
 #include <sys/time.h>
+#include <zephyr/kernel.h>
 #include <zephyr/sys/clock.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys_clock.h>
 #include <zephyr/sys/timeutil.h>
 
 #ifdef __cplusplus
@@ -58,7 +61,44 @@ static inline bool tp_diff_in_range_ns(const struct timespec *a, const struct ti
 	return diff >= lo && diff < hi;
 }
 
-uint32_t timespec_to_timeoutms(int clock_id, const struct timespec *abstime);
+/*
+ * Get the kernel timeout of the next part of a wait until @p abstime of the POSIX clock
+ * @p clock_id, with nanosecond precision. Returns 0 if @p timeout lasts until @p abstime (it is
+ * K_NO_WAIT once @p abstime has passed), 1 if the wait is to go on should it end early with
+ * -EAGAIN, or -EINVAL if the clock or @p abstime is invalid.
+ */
+int timespec_to_clock_timeout(int clock_id, const struct timespec *abstime, k_timeout_t *timeout);
+
+/* A timed wait until a CLOCK_REALTIME time, see posix_clock_wait_begin() */
+struct posix_clock_wait {
+	sys_dnode_t node;
+	bool registered;
+#ifdef CONFIG_POLL
+	/* raised by clock_settime() */
+	struct k_poll_signal set;
+#endif
+};
+
+/*
+ * Register the timed wait of the calling thread until a time of the POSIX clock @p clock_id,
+ * which must be ended with posix_clock_wait_end(). Until then, if @p clock_id is CLOCK_REALTIME,
+ * clock_settime() ends the posix_clock_sem_take() or posix_clock_msgq_get() of the wait with
+ * -EAGAIN, so that it computes the time left again with timespec_to_clock_timeout(). Waits on
+ * other clocks are not registered, nor are any without CONFIG_POLL.
+ *
+ * Other kernel objects can not be waited for together with clock_settime(), so waits on them
+ * only compute the time left again every CONFIG_POSIX_TIMEOUTS_REALTIME_RECHECK_MS, if it is set.
+ */
+void posix_clock_wait_begin(struct posix_clock_wait *wait, int clock_id);
+void posix_clock_wait_end(struct posix_clock_wait *wait);
+
+/* k_sem_take() and k_msgq_get() for a wait, which also end with -EAGAIN on clock_settime() */
+int posix_clock_sem_take(struct posix_clock_wait *wait, struct k_sem *sem, k_timeout_t timeout);
+int posix_clock_msgq_get(struct posix_clock_wait *wait, struct k_msgq *msgq, void *data,
+			 k_timeout_t timeout);
+
+/* Wake the registered waits, once the realtime clock has been set */
+void posix_clock_realtime_set(void);
 
 /* Convert a POSIX clock (cast to int) to a sys_clock identifier */
 static inline int sys_clock_from_clockid(int clock_id)
@@ -75,6 +115,15 @@ static inline int sys_clock_from_clockid(int clock_id)
 	}
 }
 
+#ifdef CONFIG_POSIX_PRECISE_SLEEP
+/*
+ * Like sys_clock_nanosleep(), but busy-wait on the cycle counter for the last part of the sleep.
+ * Returns 0 on success or a negative errno value.
+ */
+int posix_precise_nanosleep(int clock_id, int flags, const struct timespec *rqtp,
+			    struct timespec *rmtp);
+#endif
+
 /** INTERNAL_HIDDEN @endcond */
 
 #ifdef __cplusplus
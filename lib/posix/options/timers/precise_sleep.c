@@ -0,0 +1,155 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "posix_clock.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/clock.h>
+#include <zephyr/sys/timeutil.h>
+#include <zephyr/sys/util.h>
+
+LOG_MODULE_REGISTER(posix_precise_sleep, CONFIG_TIMER_LOG_LEVEL);
+
+#ifdef CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER
+typedef uint64_t sleep_cycles_t;
+#define sleep_cycles_get() k_cycle_get_64()
+#else
+typedef uint32_t sleep_cycles_t;
+#define sleep_cycles_get() k_cycle_get_32()
+#endif
+
+/* longest sleep, in cycles, that is measured without the cycle counter wrapping */
+#define SLEEP_CYCLES_MAX ((sleep_cycles_t)-1 >> 1)
+
+/* time from a tick boundary until a thread woken at that boundary runs, in cycles */
+static atomic_t wakeup_latency;
+/* number of wakeups still to be measured */
+static atomic_t samples_left = ATOMIC_INIT(CONFIG_POSIX_PRECISE_SLEEP_CALIBRATION_SAMPLES);
+
+static void precise_sleep_remaining(uint64_t cycles, struct timespec *rmtp)
+{
+	uint64_t ns = k_cyc_to_ns_ceil64(cycles);
+
+	rmtp->tv_sec = ns / NSEC_PER_SEC;
+	rmtp->tv_nsec = ns % NSEC_PER_SEC;
+}
+
+/* spin from a wakeup at a tick boundary until the next one, to find out how late it was */
+static void precise_sleep_sample(void)
+{
+	uint32_t late;
+	uint32_t spun;
+	atomic_val_t old;
+	sleep_cycles_t start = sleep_cycles_get();
+	int64_t tick = k_uptime_ticks();
+	const uint32_t tick_cycles = k_ticks_to_cyc_floor32(1);
+
+	while (k_uptime_ticks() == tick) {
+		arch_nop();
+	}
+	spun = (sleep_cycles_t)(sleep_cycles_get() - start);
+
+	if (spun < tick_cycles) {
+		late = tick_cycles - spun;
+		do {
+			old = atomic_get(&wakeup_latency);
+		} while ((old < (atomic_val_t)late) && !atomic_cas(&wakeup_latency, old, late));
+	}
+
+	if (atomic_dec(&samples_left) == 1) {
+		LOG_DBG("wakeup latency: %ld cycles", (long)atomic_get(&wakeup_latency));
+	}
+}
+
+int posix_precise_nanosleep(int clock_id, int flags, const struct timespec *rqtp,
+			    struct timespec *rmtp)
+{
+	int64_t ns;
+	int64_t ticks;
+	uint64_t left;
+	uint64_t cycles;
+	uint64_t margin;
+	uint64_t elapsed;
+	sleep_cycles_t start;
+	struct timespec now;
+	bool woke = false;
+	const uint64_t tick = k_ticks_to_cyc_floor64(1);
+
+	if (((clock_id != SYS_CLOCK_REALTIME) && (clock_id != SYS_CLOCK_MONOTONIC)) ||
+	    ((flags & ~TIMER_ABSTIME) != 0) || !timespec_is_valid(rqtp)) {
+		return -EINVAL;
+	}
+
+	if ((flags & TIMER_ABSTIME) != 0) {
+		(void)sys_clock_gettime(clock_id, &now);
+		ns = tp_diff(rqtp, &now);
+	} else {
+		ns = ts_to_ns(rqtp);
+	}
+
+	if (ns <= 0) {
+		goto out;
+	}
+
+	cycles = k_ns_to_cyc_ceil64(ns);
+	if ((ns > (int64_t)CONFIG_POSIX_PRECISE_SLEEP_MAX_US * NSEC_PER_USEC) ||
+	    (cycles > SLEEP_CYCLES_MAX)) {
+		/* precision is irrelevant compared to the length of the sleep */
+		return sys_clock_nanosleep(clock_id, flags, rqtp, rmtp);
+	}
+
+	start = sleep_cycles_get();
+
+	/*
+	 * Sleep until the last tick boundary that the thread can wake up at with at least
+	 * CONFIG_POSIX_PRECISE_SLEEP_SPIN_US left, and spin for the rest. How far into its tick the
+	 * sleep starts is not known, so the first sleep can end up to a tick early, in which case
+	 * the thread sleeps once more from the boundary that it woke up at.
+	 */
+	for (;;) {
+		elapsed = (sleep_cycles_t)(sleep_cycles_get() - start);
+		left = cycles - MIN(elapsed, cycles);
+		margin = (uint64_t)atomic_get(&wakeup_latency) +
+			 k_us_to_cyc_ceil64(CONFIG_POSIX_PRECISE_SLEEP_SPIN_US);
+		if (left < tick + margin) {
+			break;
+		}
+
+		if (woke && (atomic_get(&samples_left) > 0)) {
+			precise_sleep_sample();
+			woke = false;
+			continue;
+		}
+
+		ticks = (left - margin) / tick;
+		if (k_sleep(K_TIMEOUT_ABS_TICKS(k_uptime_ticks() + ticks)) > 0) {
+			/* sleep was interrupted by a call to k_wakeup() */
+			elapsed = (sleep_cycles_t)(sleep_cycles_get() - start);
+			if ((rmtp != NULL) && ((flags & TIMER_ABSTIME) == 0)) {
+				precise_sleep_remaining(cycles - MIN(elapsed, cycles), rmtp);
+			}
+			return -EINTR;
+		}
+		woke = true;
+	}
+
+	while ((sleep_cycles_t)(sleep_cycles_get() - start) < cycles) {
+		arch_nop();
+	}
+
+out:
+	if ((rmtp != NULL) && ((flags & TIMER_ABSTIME) == 0)) {
+		*rmtp = (struct timespec){0};
+	}
+
+	return 0;
+}
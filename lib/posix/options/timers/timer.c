@@ -8,17 +8,33 @@
 #undef _POSIX_C_SOURCE
 #define _POSIX_C_SOURCE 200809L
 
+#include "domain_priv.h"
+#include "itimer_priv.h"
+#include "percpu_priv.h"
 #include "posix_clock.h"
+#include "posix_internal.h"
+#include "sig_wake_priv.h"
+#include "trace_priv.h"
 
 #include <errno.h>
 #include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/time.h>
 #include <time.h>
 
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/sys/clock.h>
+#include <zephyr/sys/util.h>
 #include <pthread.h>
 
+#ifdef CONFIG_XSI_TIMERS
+#include <zephyr/kernel/signal.h>
+#endif
+
 #define ACTIVE 1
 #define NOT_ACTIVE 0
 
@@ -136,6 +152,7 @@ int timer_create(clockid_t clockid, struct sigevent *evp, timer_t *timerid)
 
 	if (k_mem_slab_alloc(&posix_timer_slab, (void **)&timer, alloc_timeout) != 0) {
 		LOG_DBG("k_mem_slab_alloc() failed: %d", ret);
+		sys_port_trace_posix_call(TIMER_CREATE, NULL, ENOMEM);
 		errno = ENOMEM;
 		return -1;
 	}
@@ -197,6 +214,8 @@ free_timer:
 	k_mem_slab_free(&posix_timer_slab, (void *)timer);
 
 out:
+	sys_port_trace_posix_call(TIMER_CREATE, (ret == 0) ? &timer->ztimer : NULL,
+				  (ret == 0) ? 0 : errno);
 	return ret;
 }
 
@@ -263,6 +282,7 @@ int timer_settime(timer_t timerid, int flags, const struct itimerspec *value,
 		}
 
 		timer->status = NOT_ACTIVE;
+		sys_port_trace_posix_call(TIMER_SETTIME, &timer->ztimer, 0);
 		return 0;
 	}
 
@@ -289,6 +309,7 @@ int timer_settime(timer_t timerid, int flags, const struct itimerspec *value,
 
 	timer->status = ACTIVE;
 	k_timer_start(&timer->ztimer, K_MSEC(duration), K_MSEC(timer->reload));
+	sys_port_trace_posix_call(TIMER_SETTIME, &timer->ztimer, 0);
 	return 0;
 }
 
@@ -340,7 +361,434 @@ int timer_delete(timer_t timerid)
 		(void)pthread_cancel(timer->thread);
 	}
 
+	sys_port_trace_posix_call(TIMER_DELETE, &timer->ztimer, 0);
 	k_mem_slab_free(&posix_timer_slab, (void *)timer);
 
 	return 0;
 }
+
+#if defined(CONFIG_XSI_TIMERS) && !defined(CONFIG_TC_PROVIDES_XSI_TIMERS)
+
+/*
+ * Interval timers are shared by every thread. ITIMER_REAL counts wall time on a kernel timer.
+ * ITIMER_PROF counts the CPU time of the process of the thread that armed it: the pthreads and the
+ * main thread of its process domain, and the thread itself, as kept by the runtime statistics at
+ * each context switch. Its kernel timer fires when the CPU time would have run out had each of
+ * those threads that can run kept a CPU busy, and is restarted for the remainder until it has.
+ * While none of them can run, the kernel timer is stopped, and is started again once a thread is
+ * switched out. The kernel keeps no split between user and system time, so there is no CPU time
+ * for ITIMER_VIRTUAL to count. As with alarm(), the signal is sent to the thread that armed the
+ * timer.
+ */
+
+struct itimer {
+	struct k_timer ztimer;
+	/* thread that armed the timer */
+	k_tid_t target;
+	struct timeval interval;
+	/* CPU time at which ITIMER_PROF expires, and its reload value, in cycles */
+	uint64_t deadline;
+	uint64_t reload;
+	/* CPU time of the threads of the process that exited since ITIMER_PROF was armed */
+	uint64_t exited;
+	int signo;
+	bool armed;
+};
+
+/* the CPU time of a thread and whether it can run, summed over the threads of a process */
+struct itimer_sample {
+	const struct itimer *it;
+	uint64_t cycles;
+	unsigned int runnable;
+};
+
+extern struct k_thread z_main_thread;
+
+static struct k_spinlock itimer_lock;
+static struct itimer itimers[] = {
+	[ITIMER_REAL] = {.signo = K_SIG_ALRM},
+	[ITIMER_VIRTUAL] = {.signo = K_SIG_VTALRM},
+	[ITIMER_PROF] = {.signo = K_SIG_PROF},
+};
+
+/* CPU timers whose kernel timer is stopped until a thread is switched out */
+static atomic_t itimer_parked;
+
+#ifdef CONFIG_POSIX_THREADS
+/* pthreads that are exiting, whose CPU time already counts towards itimer::exited */
+static struct k_thread *itimer_exiting[CONFIG_POSIX_THREAD_THREADS_MAX];
+/* which of them are still in the list of threads */
+static bool itimer_exiting_live[CONFIG_POSIX_THREAD_THREADS_MAX];
+#endif
+
+static inline bool timeval_is_valid(const struct timeval *tv)
+{
+	return (tv->tv_sec >= 0) && (tv->tv_usec >= 0) && (tv->tv_usec < USEC_PER_SEC);
+}
+
+static inline uint64_t timeval_to_us(const struct timeval *tv)
+{
+	return (uint64_t)tv->tv_sec * USEC_PER_SEC + tv->tv_usec;
+}
+
+static inline struct timeval us_to_timeval(uint64_t us)
+{
+	return (struct timeval){
+		.tv_sec = us / USEC_PER_SEC,
+		.tv_usec = us % USEC_PER_SEC,
+	};
+}
+
+static struct k_thread **itimer_exiting_find(const struct k_thread *thread)
+{
+#ifdef CONFIG_POSIX_THREADS
+	ARRAY_FOR_EACH_PTR(itimer_exiting, e) {
+		if (*e == thread) {
+			return e;
+		}
+	}
+#else
+	ARG_UNUSED(thread);
+#endif
+
+	return NULL;
+}
+
+/* whether the CPU time of @p thread counts towards a CPU timer armed by @p target */
+static bool itimer_counts(const struct k_thread *thread, const struct k_thread *target)
+{
+	if ((thread != target) && (thread != &z_main_thread) &&
+	    !(IS_ENABLED(CONFIG_POSIX_THREADS) && posix_is_pthread(thread))) {
+		return false;
+	}
+
+	return posix_domain_index(thread) == posix_domain_index(target);
+}
+
+static void itimer_sample_thread(const struct k_thread *thread, void *user_data)
+{
+	struct itimer_sample *s = user_data;
+	k_thread_runtime_stats_t stats = {0};
+	const uint32_t blocked = _THREAD_PENDING | _THREAD_SLEEPING | _THREAD_SUSPENDED |
+				 _THREAD_DEAD;
+
+	if (!itimer_counts(thread, s->it->target) || (itimer_exiting_find(thread) != NULL)) {
+		return;
+	}
+
+	(void)k_thread_runtime_stats_get((k_tid_t)thread, &stats);
+	s->cycles += stats.execution_cycles;
+
+	if ((thread->base.thread_state & blocked) == 0U) {
+		++s->runnable;
+	}
+}
+
+#ifdef CONFIG_POSIX_THREADS
+static void itimer_exiting_mark(const struct k_thread *thread, void *user_data)
+{
+	struct k_thread **e = itimer_exiting_find(thread);
+
+	ARG_UNUSED(user_data);
+
+	if (e != NULL) {
+		itimer_exiting_live[e - itimer_exiting] = true;
+	}
+}
+
+/* forget the exiting threads that are gone */
+static void itimer_exiting_sweep(void)
+{
+	memset(itimer_exiting_live, 0, sizeof(itimer_exiting_live));
+	k_thread_foreach(itimer_exiting_mark, NULL);
+
+	ARRAY_FOR_EACH(itimer_exiting, i) {
+		if (!itimer_exiting_live[i]) {
+			itimer_exiting[i] = NULL;
+		}
+	}
+}
+#endif
+
+/* CPU time used by the process that @p it counts, and the number of its threads that can run */
+static uint64_t itimer_cpu_now(const struct itimer *it, unsigned int *runnable)
+{
+	struct itimer_sample s = {
+		.it = it,
+		.cycles = it->exited,
+	};
+
+#ifdef CONFIG_POSIX_THREADS
+	itimer_exiting_sweep();
+#endif
+
+	k_thread_foreach(itimer_sample_thread, &s);
+	if (runnable != NULL) {
+		*runnable = s.runnable;
+	}
+
+	return s.cycles;
+}
+
+static void itimer_cpu_start(struct itimer *it, uint64_t now, unsigned int runnable)
+{
+	uint64_t wait;
+
+	if (runnable == 0U) {
+		if (IS_ENABLED(CONFIG_XSI_TIMERS_SWITCH_OUT)) {
+			/* posix_itimer_switched_out() starts it again */
+			return;
+		}
+
+		/* polled, as a thread that starts to run again is not noticed */
+		runnable = 1U;
+	}
+
+	wait = DIV_ROUND_UP(it->deadline - now, MIN(runnable, arch_num_cpus()));
+	k_timer_start(&it->ztimer, K_TICKS(k_cyc_to_ticks_ceil64(wait)), K_NO_WAIT);
+}
+
+static void itimer_real_expiry(struct k_timer *ztimer)
+{
+	struct itimer *it = CONTAINER_OF(ztimer, struct itimer, ztimer);
+
+	if (posix_sig_queue(it->target, it->signo, (union k_sig_val){0}) == 0) {
+		posix_stat_inc(POSIX_STAT_SIG_SENT);
+	}
+}
+
+static void itimer_cpu_expiry(struct k_timer *ztimer)
+{
+	struct itimer *it = CONTAINER_OF(ztimer, struct itimer, ztimer);
+	const atomic_val_t bit = BIT(it - itimers);
+	bool expired = false;
+	unsigned int runnable;
+	uint64_t now;
+
+	K_SPINLOCK(&itimer_lock) {
+		if (!it->armed) {
+			K_SPINLOCK_BREAK;
+		}
+
+		/* parked before sampling, so that a thread that starts to run is not missed */
+		if (IS_ENABLED(CONFIG_XSI_TIMERS_SWITCH_OUT)) {
+			(void)atomic_or(&itimer_parked, bit);
+		}
+
+		now = itimer_cpu_now(it, &runnable);
+		if (runnable != 0U) {
+			(void)atomic_and(&itimer_parked, ~bit);
+		}
+
+		if (now < it->deadline) {
+			itimer_cpu_start(it, now, runnable);
+			K_SPINLOCK_BREAK;
+		}
+
+		expired = true;
+		if (it->reload == 0) {
+			it->armed = false;
+			K_SPINLOCK_BREAK;
+		}
+
+		/* expirations that were missed are dropped rather than queued as a burst of signals */
+		it->deadline += it->reload;
+		if (it->deadline <= now) {
+			it->deadline = now + it->reload;
+		}
+
+		itimer_cpu_start(it, now, runnable);
+	}
+
+	if (expired && (posix_sig_queue(it->target, it->signo, (union k_sig_val){0}) == 0)) {
+		posix_stat_inc(POSIX_STAT_SIG_SENT);
+	}
+}
+
+static void itimer_get(int which, struct itimerval *value)
+{
+	struct itimer *it = &itimers[which];
+	uint64_t now;
+
+	value->it_interval = it->interval;
+	value->it_value = (struct timeval){0};
+
+	if (which == ITIMER_REAL) {
+		value->it_value =
+			us_to_timeval(k_ticks_to_us_ceil64(k_timer_remaining_ticks(&it->ztimer)));
+	} else if (it->armed) {
+		now = itimer_cpu_now(it, NULL);
+		value->it_value = us_to_timeval(
+			k_cyc_to_us_ceil64((it->deadline > now) ? (it->deadline - now) : 1));
+	}
+}
+
+int getitimer(int which, struct itimerval *value)
+{
+	if ((which < 0) || ((size_t)which >= ARRAY_SIZE(itimers)) || (value == NULL)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (which == ITIMER_VIRTUAL) {
+		errno = ENOTSUP;
+		return -1;
+	}
+
+	K_SPINLOCK(&itimer_lock) {
+		itimer_get(which, value);
+	}
+
+	return 0;
+}
+
+int setitimer(int which, const struct itimerval *value, struct itimerval *ovalue)
+{
+	struct itimer *it;
+	struct itimerval old;
+	k_ticks_t alarm_left = 0;
+
+	if ((which < 0) || ((size_t)which >= ARRAY_SIZE(itimers)) || (value == NULL) ||
+	    !timeval_is_valid(&value->it_value) || !timeval_is_valid(&value->it_interval)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (which == ITIMER_VIRTUAL) {
+		errno = ENOTSUP;
+		return -1;
+	}
+
+	if (which == ITIMER_REAL) {
+		/* alarm() and ITIMER_REAL share SIGALRM, so setting one disarms the other */
+		alarm_left = posix_sig_alarm(K_FOREVER);
+	}
+
+	it = &itimers[which];
+	K_SPINLOCK(&itimer_lock) {
+		itimer_get(which, &old);
+
+		k_timer_stop(&it->ztimer);
+		(void)atomic_and(&itimer_parked, ~BIT(which));
+		it->armed = timeval_to_us(&value->it_value) != 0;
+		it->interval = value->it_interval;
+		it->target = k_current_get();
+
+		if (!it->armed) {
+			K_SPINLOCK_BREAK;
+		}
+
+		if (which == ITIMER_REAL) {
+			k_timer_start(&it->ztimer,
+				      K_TICKS(k_us_to_ticks_ceil64(timeval_to_us(&value->it_value))),
+				      K_TICKS(k_us_to_ticks_ceil64(timeval_to_us(&value->it_interval))));
+		} else {
+			unsigned int runnable;
+			uint64_t now;
+
+			/* only the CPU time from now on counts, so none has exited yet */
+			it->exited = 0;
+			now = itimer_cpu_now(it, &runnable);
+			it->reload = k_us_to_cyc_ceil64(timeval_to_us(&value->it_interval));
+			it->deadline = now + k_us_to_cyc_ceil64(timeval_to_us(&value->it_value));
+
+			/* the calling thread is one of those counted, and it is running */
+			itimer_cpu_start(it, now, MAX(runnable, 1U));
+		}
+	}
+
+	if (ovalue != NULL) {
+		if ((alarm_left > 0) && (timeval_to_us(&old.it_value) == 0)) {
+			old.it_value = us_to_timeval(k_ticks_to_us_ceil64(alarm_left));
+		}
+
+		*ovalue = old;
+	}
+
+	return 0;
+}
+
+k_ticks_t posix_itimer_real_cancel(void)
+{
+	k_ticks_t remaining = 0;
+	struct itimer *it = &itimers[ITIMER_REAL];
+
+	/* the kernel timer is not accessible from user mode */
+	if (k_is_user_context()) {
+		return 0;
+	}
+
+	K_SPINLOCK(&itimer_lock) {
+		remaining = k_timer_remaining_ticks(&it->ztimer);
+		k_timer_stop(&it->ztimer);
+		it->interval = (struct timeval){0};
+	}
+
+	return remaining;
+}
+
+#ifdef CONFIG_POSIX_THREADS
+void posix_itimer_thread_start(void)
+{
+	struct k_thread **e;
+
+	K_SPINLOCK(&itimer_lock) {
+		/* left by a thread that exited from the same struct k_thread */
+		e = itimer_exiting_find(k_current_get());
+		if (e != NULL) {
+			*e = NULL;
+		}
+	}
+}
+
+void posix_itimer_thread_exit(void)
+{
+	struct k_thread **e;
+	k_thread_runtime_stats_t stats = {0};
+	struct itimer *it = &itimers[ITIMER_PROF];
+
+	K_SPINLOCK(&itimer_lock) {
+		if (!it->armed || !itimer_counts(k_current_get(), it->target)) {
+			K_SPINLOCK_BREAK;
+		}
+
+		/* the little CPU time that the thread uses from now on is not counted */
+		e = itimer_exiting_find(NULL);
+		if (e != NULL) {
+			(void)k_thread_runtime_stats_get(k_current_get(), &stats);
+			it->exited += stats.execution_cycles;
+			*e = k_current_get();
+		}
+	}
+}
+#endif /* CONFIG_POSIX_THREADS */
+
+#ifdef CONFIG_XSI_TIMERS_SWITCH_OUT
+void posix_itimer_switched_out(void)
+{
+	atomic_val_t parked;
+
+	if (atomic_get(&itimer_parked) == 0) {
+		return;
+	}
+
+	/* a thread of the process may be about to run, so check soon */
+	parked = atomic_clear(&itimer_parked);
+	ARRAY_FOR_EACH_PTR(itimers, it) {
+		if ((parked & BIT(it - itimers)) != 0) {
+			k_timer_start(&it->ztimer, K_NO_WAIT, K_NO_WAIT);
+		}
+	}
+}
+#endif /* CONFIG_XSI_TIMERS_SWITCH_OUT */
+
+static int itimer_init(void)
+{
+	k_timer_init(&itimers[ITIMER_REAL].ztimer, itimer_real_expiry, NULL);
+	k_timer_init(&itimers[ITIMER_PROF].ztimer, itimer_cpu_expiry, NULL);
+
+	return 0;
+}
+SYS_INIT(itimer_init, PRE_KERNEL_1, 0);
+
+#endif /* defined(CONFIG_XSI_TIMERS) && !defined(CONFIG_TC_PROVIDES_XSI_TIMERS) */
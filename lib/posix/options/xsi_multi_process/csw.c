@@ -0,0 +1,153 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "usage_priv.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+#include <ksched.h>
+
+/*
+ * Context switches are counted when a thread is switched out, in a table that is indexed by the
+ * address of the thread. Threads are mostly allocated from arrays, so dividing the address by the
+ * size of a thread spreads them out without collisions. A thread claims its entry the first time
+ * it is switched out, and gives it up when it is aborted. Entries that are given up are not
+ * marked, so looking up a thread that has no entry scans the whole table.
+ *
+ * Only the thread being switched out updates its counters, so they are not locked. The lock only
+ * keeps the counters of threads that exit consistent with those of the table.
+ */
+
+struct csw_entry {
+	atomic_ptr_t thread;
+	uint32_t nvcsw;
+	uint32_t nivcsw;
+};
+
+static struct k_spinlock csw_lock;
+static struct csw_entry csw_table[CONFIG_XSI_RUSAGE_CSW_THREADS];
+/* context switches of threads that have exited, or that did not fit in the table */
+static struct posix_usage csw_gone;
+
+static inline size_t csw_hash(const struct k_thread *thread)
+{
+	return ((uintptr_t)thread / sizeof(struct k_thread)) % ARRAY_SIZE(csw_table);
+}
+
+static struct csw_entry *csw_find(const struct k_thread *thread)
+{
+	size_t i = csw_hash(thread);
+
+	for (size_t n = 0; n < ARRAY_SIZE(csw_table); ++n) {
+		if (atomic_ptr_get(&csw_table[i].thread) == thread) {
+			return &csw_table[i];
+		}
+
+		i = (i + 1) % ARRAY_SIZE(csw_table);
+	}
+
+	return NULL;
+}
+
+/* only called by @p thread, so that no other entry can be claimed for it meanwhile */
+static struct csw_entry *csw_claim(const struct k_thread *thread)
+{
+	size_t i = csw_hash(thread);
+	struct csw_entry *e;
+
+	for (size_t n = 0; n < ARRAY_SIZE(csw_table); ++n) {
+		e = &csw_table[i];
+		if (atomic_ptr_cas(&e->thread, NULL, (atomic_ptr_val_t)thread)) {
+			e->nvcsw = 0;
+			e->nivcsw = 0;
+			return e;
+		}
+
+		i = (i + 1) % ARRAY_SIZE(csw_table);
+	}
+
+	return NULL;
+}
+
+void sys_trace_thread_create_user(struct k_thread *thread)
+{
+	struct csw_entry *e = csw_find(thread);
+
+	/* a thread that was not aborted may have left its entry behind */
+	if (e != NULL) {
+		e->nvcsw = 0;
+		e->nivcsw = 0;
+	}
+}
+
+void sys_trace_thread_abort_user(struct k_thread *thread)
+{
+	struct csw_entry *e = csw_find(thread);
+
+	if (e == NULL) {
+		return;
+	}
+
+	K_SPINLOCK(&csw_lock) {
+		csw_gone.nvcsw += e->nvcsw;
+		csw_gone.nivcsw += e->nivcsw;
+		e->nvcsw = 0;
+		e->nivcsw = 0;
+		atomic_ptr_clear(&e->thread);
+	}
+}
+
+void posix_csw_switched_out(void)
+{
+	struct k_thread *thread = _current;
+	struct csw_entry *e = csw_find(thread);
+	bool voluntary = !z_is_thread_ready(thread);
+
+	/* a thread that exits is switched out once more after it was aborted */
+	if ((e == NULL) && ((thread->base.thread_state & _THREAD_DEAD) == 0U)) {
+		e = csw_claim(thread);
+	}
+
+	if (e == NULL) {
+		K_SPINLOCK(&csw_lock) {
+			++*(voluntary ? &csw_gone.nvcsw : &csw_gone.nivcsw);
+		}
+		return;
+	}
+
+	++*(voluntary ? &e->nvcsw : &e->nivcsw);
+}
+
+void posix_csw_thread(const struct k_thread *thread, struct posix_usage *usage)
+{
+	struct csw_entry *e = csw_find(thread);
+
+	if (e == NULL) {
+		return;
+	}
+
+	usage->nvcsw += e->nvcsw;
+	usage->nivcsw += e->nivcsw;
+}
+
+void posix_csw_all(struct posix_usage *usage)
+{
+	K_SPINLOCK(&csw_lock) {
+		usage->nvcsw += csw_gone.nvcsw;
+		usage->nivcsw += csw_gone.nivcsw;
+
+		ARRAY_FOR_EACH_PTR(csw_table, e) {
+			if (atomic_ptr_get(&e->thread) != NULL) {
+				usage->nvcsw += e->nvcsw;
+				usage->nivcsw += e->nivcsw;
+			}
+		}
+	}
+}
@@ -0,0 +1,140 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "domain_priv.h"
+#include "usage_priv.h"
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/time_units.h>
+#include <zephyr/sys/util.h>
+
+#ifndef RUSAGE_THREAD
+#define RUSAGE_THREAD 1
+#endif
+
+#ifdef CONFIG_XSI_RUSAGE_HEAP
+extern struct k_heap _system_heap;
+#endif
+
+struct stack_walk {
+	int domain;
+	size_t used;
+};
+
+static struct timeval cycles_to_timeval(uint64_t cycles)
+{
+	uint64_t us = k_cyc_to_us_floor64(cycles);
+
+	return (struct timeval){
+		.tv_sec = us / USEC_PER_SEC,
+		.tv_usec = us % USEC_PER_SEC,
+	};
+}
+
+static size_t thread_stack_used(const struct k_thread *thread)
+{
+#ifdef CONFIG_XSI_RUSAGE_STACK
+	size_t unused;
+
+	if (k_thread_stack_space_get(thread, &unused) == 0) {
+		return thread->stack_info.size - unused;
+	}
+#else
+	ARG_UNUSED(thread);
+#endif
+
+	return 0;
+}
+
+#ifdef CONFIG_XSI_RUSAGE_STACK
+static void stack_walk_cb(const struct k_thread *thread, void *user_data)
+{
+	struct stack_walk *walk = user_data;
+
+	if (posix_domain_index(thread) == walk->domain) {
+		walk->used += thread_stack_used(thread);
+	}
+}
+#endif
+
+/* peak stack use of the live threads of the process domain of the caller */
+static size_t domain_stack_used(void)
+{
+	struct stack_walk walk = {
+		.domain = posix_domain_index(k_current_get()),
+	};
+
+#ifdef CONFIG_XSI_RUSAGE_STACK
+	k_thread_foreach_unlocked(stack_walk_cb, &walk);
+#endif
+
+	return walk.used;
+}
+
+/* the system heap is shared by every process domain */
+static long maxrss(size_t stack)
+{
+	size_t bytes = stack;
+
+#ifdef CONFIG_XSI_RUSAGE_HEAP
+	struct sys_memory_stats stats;
+
+	if (sys_heap_runtime_stats_get(&_system_heap.heap, &stats) == 0) {
+		bytes += stats.max_allocated_bytes;
+	}
+#endif
+
+	return DIV_ROUND_UP(bytes, 1024);
+}
+
+int getrusage(int who, struct rusage *r_usage)
+{
+	int ret = 0;
+	size_t stack = 0;
+	struct posix_usage self = {0};
+	struct posix_usage children = {0};
+	const struct posix_usage *usage = &self;
+
+	switch (who) {
+	case RUSAGE_SELF:
+		ret = posix_domain_usage(&self, &children);
+		stack = domain_stack_used();
+		break;
+	case RUSAGE_CHILDREN:
+		/* the peak memory use of children is not kept once they have gone away */
+		ret = posix_domain_usage(&self, &children);
+		usage = &children;
+		break;
+	case RUSAGE_THREAD:
+		posix_usage_thread(k_current_get(), &self);
+		stack = thread_stack_used(k_current_get());
+		break;
+	default:
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	*r_usage = (struct rusage){
+		.ru_utime = cycles_to_timeval(usage->cycles),
+		.ru_maxrss = (who == RUSAGE_CHILDREN) ? 0 : maxrss(stack),
+		.ru_majflt = (long)usage->majflt,
+		.ru_nvcsw = (long)usage->nvcsw,
+		.ru_nivcsw = (long)usage->nivcsw,
+	};
+
+	return 0;
+}
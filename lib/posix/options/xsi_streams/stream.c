@@ -0,0 +1,855 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sig_wake_priv.h"
+#include "stream.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <stropts.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/sys/zvfs.h>
+
+/*
+ * A stream is a pair of ends that share one lock. Each end reads from its own queue and writes to
+ * the queue of the other end, or, for a pipe, only one of them does either.
+ *
+ * A queue has a list of messages for each priority band, and a list of high-priority messages
+ * after the bands, so the highest non-empty list is the one that is read first. A bitmap of
+ * non-empty lists finds it without walking the bands.
+ */
+
+#define NUM_BANDS CONFIG_XSI_STREAMS_BANDS
+#define HIPRI_Q   NUM_BANDS
+#define NUM_Q     (NUM_BANDS + 1)
+
+#define SETSIG_EVENTS (S_INPUT | S_HIPRI | S_OUTPUT | S_HANGUP | S_RDNORM | S_RDBAND | S_WRBAND)
+
+struct str_msg {
+	sys_snode_t node;
+	char *ctl;
+	char *data;
+	/* bytes left in each part, or -1 if the part is absent or has been read */
+	int ctl_len;
+	int data_len;
+	char buf[];
+};
+
+struct str_queue {
+	sys_slist_t q[NUM_Q];
+	size_t bytes[NUM_Q];
+	uint32_t busy[DIV_ROUND_UP(NUM_Q, 32)];
+	size_t nmsgs;
+};
+
+struct str_pair;
+
+struct str_end {
+	struct str_pair *pair;
+	struct str_end *peer;
+	/* NULL for the write end of a pipe */
+	struct str_queue *rx;
+	/* NULL for the read end of a pipe */
+	struct str_queue *tx;
+	struct k_poll_signal sig;
+	k_tid_t sig_thread;
+	int sig_events;
+	int flags;
+	bool open;
+};
+
+struct str_pair {
+	struct k_mutex lock;
+	struct k_condvar cond;
+	struct str_queue q[2];
+	struct str_end end[2];
+};
+
+static const struct fd_op_vtable stream_vtable;
+
+static int str_part_len(int len)
+{
+	return MAX(len, 0);
+}
+
+static int str_queue_top(const struct str_queue *sq)
+{
+	for (int i = ARRAY_SIZE(sq->busy) - 1; i >= 0; --i) {
+		if (sq->busy[i] != 0) {
+			return i * 32 + find_msb_set(sq->busy[i]) - 1;
+		}
+	}
+
+	return -1;
+}
+
+static bool str_queue_busy(const struct str_queue *sq, int idx)
+{
+	return (sq->busy[idx / 32] & BIT(idx % 32)) != 0;
+}
+
+static bool str_queue_has_room(const struct str_queue *sq, int idx, size_t size)
+{
+	/* a message that is larger than a band can still go into an empty one */
+	return (idx == HIPRI_Q) || (sq->bytes[idx] == 0) ||
+	       (sq->bytes[idx] + size <= CONFIG_XSI_STREAMS_BAND_SIZE);
+}
+
+static void str_queue_put(struct str_queue *sq, struct str_msg *m, int idx)
+{
+	sys_slist_append(&sq->q[idx], &m->node);
+	sq->bytes[idx] += str_part_len(m->ctl_len) + str_part_len(m->data_len);
+	sq->busy[idx / 32] |= BIT(idx % 32);
+	++sq->nmsgs;
+}
+
+static void str_queue_remove(struct str_queue *sq, int idx)
+{
+	struct str_msg *m = CONTAINER_OF(sys_slist_get_not_empty(&sq->q[idx]), struct str_msg, node);
+
+	sq->bytes[idx] -= str_part_len(m->ctl_len) + str_part_len(m->data_len);
+	if (sys_slist_is_empty(&sq->q[idx])) {
+		sq->busy[idx / 32] &= ~BIT(idx % 32);
+	}
+	--sq->nmsgs;
+
+	k_free(m);
+}
+
+static void str_queue_flush(struct str_queue *sq)
+{
+	for (int idx = str_queue_top(sq); idx >= 0; idx = str_queue_top(sq)) {
+		str_queue_remove(sq, idx);
+	}
+}
+
+/* wake up waiters on @p e, and send SIGPOLL for those of @p events that were requested */
+static void str_event(struct str_end *e, int events)
+{
+	k_condvar_broadcast(&e->pair->cond);
+
+	if (!e->open) {
+		return;
+	}
+
+	k_poll_signal_raise(&e->sig, events);
+
+#ifdef CONFIG_SIGNAL
+	if ((e->sig_events & events) != 0) {
+		(void)posix_sig_queue(e->sig_thread, K_SIG_POLL,
+				      (union k_sig_val){.sival_int = e->sig_events & events});
+	}
+#endif
+}
+
+/* tell @p writer that band @p idx of its queue, which had @p before bytes, was read from */
+static void str_event_room(struct str_end *writer, int idx, size_t before)
+{
+	int events = 0;
+
+	if ((idx != HIPRI_Q) && (before >= CONFIG_XSI_STREAMS_BAND_SIZE) &&
+	    (writer->tx->bytes[idx] < CONFIG_XSI_STREAMS_BAND_SIZE)) {
+		events = (idx == 0) ? S_OUTPUT : S_WRBAND;
+	}
+
+	str_event(writer, events);
+}
+
+static int str_wait(struct str_end *e)
+{
+	if ((e->flags & ZVFS_O_NONBLOCK) != 0) {
+		errno = EAGAIN;
+		return -1;
+	}
+
+	(void)k_condvar_wait(&e->pair->cond, &e->pair->lock, K_FOREVER);
+
+	return 0;
+}
+
+static struct str_end *str_get_end(int fd)
+{
+	return zvfs_get_fd_obj(fd, &stream_vtable, ENOSTR);
+}
+
+static bool str_part_is_valid(const struct strbuf *sb)
+{
+	return (sb == NULL) || (sb->len <= 0) || (sb->buf != NULL);
+}
+
+static int str_put(struct str_end *e, const char *ctl, int ctl_len, const char *data, int data_len,
+		   int idx)
+{
+	int ret = 0;
+	struct str_msg *m;
+	size_t size = str_part_len(ctl_len) + str_part_len(data_len);
+
+	if (e->tx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	m = k_malloc(sizeof(*m) + size);
+	if (m == NULL) {
+		errno = ENOSR;
+		return -1;
+	}
+
+	*m = (struct str_msg){
+		.ctl = m->buf,
+		.data = m->buf + str_part_len(ctl_len),
+		.ctl_len = ctl_len,
+		.data_len = data_len,
+	};
+	if (ctl_len > 0) {
+		memcpy(m->ctl, ctl, ctl_len);
+	}
+	if (data_len > 0) {
+		memcpy(m->data, data, data_len);
+	}
+
+	k_mutex_lock(&e->pair->lock, K_FOREVER);
+	while (true) {
+		if (!e->peer->open) {
+			errno = EPIPE;
+			ret = -1;
+			break;
+		}
+
+		if (str_queue_has_room(e->tx, idx, size)) {
+			break;
+		}
+
+		ret = str_wait(e);
+		if (ret < 0) {
+			break;
+		}
+	}
+
+	if (ret == 0) {
+		str_queue_put(e->tx, m, idx);
+		m = NULL;
+		str_event(e->peer, (idx == HIPRI_Q) ? S_HIPRI
+						    : (S_INPUT | ((idx == 0) ? S_RDNORM : S_RDBAND)));
+	}
+	k_mutex_unlock(&e->pair->lock);
+
+	k_free(m);
+
+	return ret;
+}
+
+int posix_stream_put(int fd, const struct strbuf *ctlptr, const struct strbuf *dataptr, int band,
+		     int flags)
+{
+	struct str_end *e = str_get_end(fd);
+	int ctl_len = ((ctlptr == NULL) || (ctlptr->len < 0)) ? -1 : ctlptr->len;
+	int data_len = ((dataptr == NULL) || (dataptr->len < 0)) ? -1 : dataptr->len;
+
+	if (e == NULL) {
+		return -1;
+	}
+
+	if (((flags == MSG_HIPRI) && ((band != 0) || (ctl_len < 0))) ||
+	    ((flags == MSG_BAND) && ((band < 0) || (band >= NUM_BANDS))) ||
+	    ((flags != MSG_HIPRI) && (flags != MSG_BAND)) || !str_part_is_valid(ctlptr) ||
+	    !str_part_is_valid(dataptr)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if ((ctl_len > CONFIG_XSI_STREAMS_MSG_SIZE) || (data_len > CONFIG_XSI_STREAMS_MSG_SIZE)) {
+		errno = ERANGE;
+		return -1;
+	}
+
+	if ((ctl_len < 0) && (data_len < 0)) {
+		/* there is no message to send */
+		return 0;
+	}
+
+	return str_put(e, (ctl_len > 0) ? ctlptr->buf : NULL, ctl_len,
+		       (data_len > 0) ? dataptr->buf : NULL, data_len,
+		       (flags == MSG_HIPRI) ? HIPRI_Q : band);
+}
+
+/* the queue with the message to receive, or -1 */
+static int str_select(const struct str_queue *sq, int band, int flags)
+{
+	int top = str_queue_top(sq);
+
+	switch (flags) {
+	case MSG_HIPRI:
+		return str_queue_busy(sq, HIPRI_Q) ? HIPRI_Q : -1;
+	case MSG_BAND:
+		/* high-priority messages are above every band */
+		return (top >= band) ? top : -1;
+	default:
+		return top;
+	}
+}
+
+/* Read what fits in @p sb of a message part. Returns true if some of the part is left. */
+static bool str_take(struct strbuf *sb, char **part, int *len, size_t *bytes)
+{
+	int n;
+
+	if (*len < 0) {
+		if ((sb != NULL) && (sb->maxlen >= 0)) {
+			sb->len = -1;
+		}
+		return false;
+	}
+
+	if ((sb == NULL) || (sb->maxlen < 0)) {
+		return true;
+	}
+
+	n = MIN(sb->maxlen, *len);
+	if (n > 0) {
+		memcpy(sb->buf, *part, n);
+	}
+	sb->len = n;
+
+	*part += n;
+	*len -= n;
+	*bytes -= n;
+	if (*len > 0) {
+		return true;
+	}
+
+	*len = -1;
+
+	return false;
+}
+
+int posix_stream_get(int fd, struct strbuf *ctlptr, struct strbuf *dataptr, int *bandp,
+		     int *flagsp)
+{
+	int idx;
+	int ret = 0;
+	size_t before;
+	struct str_msg *m;
+	struct str_end *e = str_get_end(fd);
+
+	if (e == NULL) {
+		return -1;
+	}
+
+	if ((bandp == NULL) || (flagsp == NULL) ||
+	    ((*flagsp != MSG_HIPRI) && (*flagsp != MSG_ANY) && (*flagsp != MSG_BAND)) ||
+	    ((*flagsp == MSG_HIPRI) && (*bandp != 0)) || (*bandp < 0)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (e->rx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	k_mutex_lock(&e->pair->lock, K_FOREVER);
+	while (true) {
+		idx = str_select(e->rx, *bandp, *flagsp);
+		if (idx >= 0) {
+			break;
+		}
+
+		if (!e->peer->open) {
+			/* after a hangup, an empty stream reads as zero-length messages */
+			if (ctlptr != NULL) {
+				ctlptr->len = 0;
+			}
+			if (dataptr != NULL) {
+				dataptr->len = 0;
+			}
+			*bandp = 0;
+			*flagsp = 0;
+			idx = -1;
+			break;
+		}
+
+		ret = str_wait(e);
+		if (ret < 0) {
+			break;
+		}
+	}
+
+	if (idx >= 0) {
+		m = CONTAINER_OF(sys_slist_peek_head(&e->rx->q[idx]), struct str_msg, node);
+		before = e->rx->bytes[idx];
+
+		if (str_take(ctlptr, &m->ctl, &m->ctl_len, &e->rx->bytes[idx])) {
+			ret |= MORECTL;
+		}
+		if (str_take(dataptr, &m->data, &m->data_len, &e->rx->bytes[idx])) {
+			ret |= MOREDATA;
+		}
+		if (ret == 0) {
+			str_queue_remove(e->rx, idx);
+		}
+
+		*bandp = (idx == HIPRI_Q) ? 0 : idx;
+		*flagsp = (idx == HIPRI_Q) ? MSG_HIPRI : MSG_BAND;
+
+		str_event_room(e->peer, idx, before);
+	}
+	k_mutex_unlock(&e->pair->lock);
+
+	return ret;
+}
+
+int posix_stream_is(int fd)
+{
+	if (zvfs_get_fd_obj(fd, NULL, EBADF) == NULL) {
+		return -1;
+	}
+
+	return (zvfs_get_fd_obj(fd, &stream_vtable, errno) != NULL) ? 1 : 0;
+}
+
+static ssize_t stream_read(void *obj, void *buf, size_t sz)
+{
+	int idx;
+	size_t before;
+	ssize_t ret = 0;
+	struct str_msg *m;
+	struct str_end *e = obj;
+	struct strbuf sb = {.maxlen = MIN(sz, INT_MAX), .buf = buf};
+
+	if (e->rx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	k_mutex_lock(&e->pair->lock, K_FOREVER);
+	while (true) {
+		idx = str_queue_top(e->rx);
+		if ((idx >= 0) || !e->peer->open) {
+			break;
+		}
+
+		ret = str_wait(e);
+		if (ret < 0) {
+			break;
+		}
+	}
+
+	if (idx >= 0) {
+		m = CONTAINER_OF(sys_slist_peek_head(&e->rx->q[idx]), struct str_msg, node);
+		if ((idx == HIPRI_Q) || (m->ctl_len >= 0)) {
+			/* messages with control information can only be read with getmsg() */
+			errno = EBADMSG;
+			ret = -1;
+		} else {
+			before = e->rx->bytes[idx];
+			if (!str_take(&sb, &m->data, &m->data_len, &e->rx->bytes[idx])) {
+				str_queue_remove(e->rx, idx);
+			}
+			ret = MAX(sb.len, 0);
+
+			str_event_room(e->peer, idx, before);
+		}
+	}
+	k_mutex_unlock(&e->pair->lock);
+
+	return ret;
+}
+
+static ssize_t stream_write(void *obj, const void *buf, size_t sz)
+{
+	/* each write is a band 0 message, split at the maximum message size */
+	int len = MIN(sz, CONFIG_XSI_STREAMS_MSG_SIZE);
+
+	if (sz == 0) {
+		return 0;
+	}
+
+	if (str_put(obj, NULL, -1, buf, len, 0) < 0) {
+		return -1;
+	}
+
+	return len;
+}
+
+static int stream_close(void *obj)
+{
+	bool last;
+	struct str_end *e = obj;
+	struct str_pair *pair = e->pair;
+
+	k_mutex_lock(&pair->lock, K_FOREVER);
+	e->open = false;
+	if (e->rx != NULL) {
+		str_queue_flush(e->rx);
+	}
+	str_event(e->peer, S_HANGUP);
+	last = !e->peer->open;
+	k_mutex_unlock(&pair->lock);
+
+	if (last) {
+		k_free(pair);
+	}
+
+	return 0;
+}
+
+static int str_poll_events(const struct str_end *e)
+{
+	int events = 0;
+
+	if (e->rx != NULL) {
+		for (int idx = 0; idx < NUM_Q; ++idx) {
+			if (!str_queue_busy(e->rx, idx)) {
+				continue;
+			}
+
+			if (idx == HIPRI_Q) {
+				events |= ZVFS_POLLPRI;
+			} else {
+				events |= ZVFS_POLLIN | ((idx == 0) ? ZVFS_POLLRDNORM : ZVFS_POLLRDBAND);
+			}
+		}
+	}
+
+	if (!e->peer->open) {
+		return events | ZVFS_POLLHUP;
+	}
+
+	if (e->tx != NULL) {
+		for (int idx = 0; idx < NUM_BANDS; ++idx) {
+			if (!str_queue_has_room(e->tx, idx, 1)) {
+				continue;
+			}
+
+			events |= (idx == 0) ? (ZVFS_POLLOUT | ZVFS_POLLWRNORM) : ZVFS_POLLWRBAND;
+		}
+	}
+
+	return events;
+}
+
+static int stream_poll_prepare(struct str_end *e, struct zvfs_pollfd *pfd,
+			       struct k_poll_event **pev, struct k_poll_event *pev_end)
+{
+	int events;
+
+	if (*pev == pev_end) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	k_mutex_lock(&e->pair->lock, K_FOREVER);
+	events = str_poll_events(e) & (pfd->events | ZVFS_POLLHUP);
+	if (events == 0) {
+		k_poll_signal_reset(&e->sig);
+	} else {
+		k_poll_signal_raise(&e->sig, events);
+	}
+	k_mutex_unlock(&e->pair->lock);
+
+	k_poll_event_init(*pev, K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &e->sig);
+	++*pev;
+
+	return 0;
+}
+
+static int stream_poll_update(struct str_end *e, struct zvfs_pollfd *pfd,
+			      struct k_poll_event **pev)
+{
+	k_mutex_lock(&e->pair->lock, K_FOREVER);
+	pfd->revents |= str_poll_events(e) & (pfd->events | ZVFS_POLLHUP);
+	k_mutex_unlock(&e->pair->lock);
+
+	++*pev;
+
+	return 0;
+}
+
+/* copy what fits in @p sb of a message part, without reading it */
+static void str_peek_part(struct strbuf *sb, const char *part, int len)
+{
+	if (len < 0) {
+		sb->len = -1;
+		return;
+	}
+
+	sb->len = CLAMP(sb->maxlen, 0, len);
+	if (sb->len > 0) {
+		memcpy(sb->buf, part, sb->len);
+	}
+}
+
+static int stream_peek(struct str_end *e, struct strpeek *peek)
+{
+	int idx = -1;
+	const struct str_msg *m;
+
+	if ((peek == NULL) || !str_part_is_valid(&peek->ctlbuf) ||
+	    !str_part_is_valid(&peek->databuf)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (e->rx == NULL) {
+		return 0;
+	}
+
+	k_mutex_lock(&e->pair->lock, K_FOREVER);
+	idx = str_select(e->rx, 0, ((peek->flags & RS_HIPRI) != 0) ? MSG_HIPRI : MSG_ANY);
+	if (idx >= 0) {
+		m = CONTAINER_OF(sys_slist_peek_head(&e->rx->q[idx]), struct str_msg, node);
+		str_peek_part(&peek->ctlbuf, m->ctl, m->ctl_len);
+		str_peek_part(&peek->databuf, m->data, m->data_len);
+		peek->flags = (idx == HIPRI_Q) ? RS_HIPRI : 0;
+	}
+	k_mutex_unlock(&e->pair->lock);
+
+	return (idx >= 0) ? 1 : 0;
+}
+
+static int stream_nread(struct str_end *e, int *len)
+{
+	int idx;
+	int ret = 0;
+	const struct str_msg *m;
+
+	if (len == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	*len = 0;
+	if (e->rx == NULL) {
+		return 0;
+	}
+
+	k_mutex_lock(&e->pair->lock, K_FOREVER);
+	idx = str_queue_top(e->rx);
+	if (idx >= 0) {
+		m = CONTAINER_OF(sys_slist_peek_head(&e->rx->q[idx]), struct str_msg, node);
+		*len = str_part_len(m->data_len);
+	}
+	ret = (int)MIN(e->rx->nmsgs, INT_MAX);
+	k_mutex_unlock(&e->pair->lock);
+
+	return ret;
+}
+
+static int stream_flush(struct str_end *e, int how)
+{
+	if ((how == 0) || ((how & ~FLUSHRW) != 0)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	k_mutex_lock(&e->pair->lock, K_FOREVER);
+	if (((how & FLUSHR) != 0) && (e->rx != NULL)) {
+		str_queue_flush(e->rx);
+		str_event(e->peer, S_OUTPUT | S_WRBAND);
+	}
+	if (((how & FLUSHW) != 0) && (e->tx != NULL)) {
+		str_queue_flush(e->tx);
+		str_event(e, S_OUTPUT | S_WRBAND);
+	}
+	k_mutex_unlock(&e->pair->lock);
+
+	return 0;
+}
+
+static int stream_setsig(struct str_end *e, int events)
+{
+#ifdef CONFIG_SIGNAL
+	int ret = 0;
+
+	if ((events & ~SETSIG_EVENTS) != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	k_mutex_lock(&e->pair->lock, K_FOREVER);
+	if ((events == 0) && (e->sig_events == 0)) {
+		/* the caller was not registered */
+		errno = EINVAL;
+		ret = -1;
+	} else {
+		e->sig_thread = k_current_get();
+		e->sig_events = events;
+	}
+	k_mutex_unlock(&e->pair->lock);
+
+	return ret;
+#else
+	ARG_UNUSED(e);
+	ARG_UNUSED(events);
+
+	errno = ENOTSUP;
+	return -1;
+#endif
+}
+
+static int stream_getsig(struct str_end *e, int *events)
+{
+	if ((events == NULL) || (e->sig_events == 0)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	*events = e->sig_events;
+
+	return 0;
+}
+
+static int stream_canput(struct str_end *e, int band)
+{
+	bool room;
+
+	if ((band < 0) || (band >= NUM_BANDS)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (e->tx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	k_mutex_lock(&e->pair->lock, K_FOREVER);
+	room = str_queue_has_room(e->tx, band, 1);
+	k_mutex_unlock(&e->pair->lock);
+
+	return room ? 1 : 0;
+}
+
+static int stream_ioctl(void *obj, unsigned int request, va_list args)
+{
+	struct str_end *e = obj;
+
+	switch (request) {
+	case ZFD_IOCTL_POLL_PREPARE: {
+		struct zvfs_pollfd *pfd = va_arg(args, struct zvfs_pollfd *);
+		struct k_poll_event **pev = va_arg(args, struct k_poll_event **);
+		struct k_poll_event *pev_end = va_arg(args, struct k_poll_event *);
+
+		return stream_poll_prepare(e, pfd, pev, pev_end);
+	}
+	case ZFD_IOCTL_POLL_UPDATE: {
+		struct zvfs_pollfd *pfd = va_arg(args, struct zvfs_pollfd *);
+		struct k_poll_event **pev = va_arg(args, struct k_poll_event **);
+
+		return stream_poll_update(e, pfd, pev);
+	}
+	case ZFD_IOCTL_STAT: {
+		struct zvfs_stat *st = va_arg(args, struct zvfs_stat *);
+
+		*st = (struct zvfs_stat){0};
+		st->mode = ZVFS_MODE_IFIFO;
+
+		return 0;
+	}
+	case ZVFS_F_GETFL:
+		return e->flags;
+	case ZVFS_F_SETFL:
+		e->flags = va_arg(args, int) & ZVFS_O_NONBLOCK;
+		return 0;
+	case I_NREAD:
+		return stream_nread(e, va_arg(args, int *));
+	case I_PEEK:
+		return stream_peek(e, va_arg(args, struct strpeek *));
+	case I_FLUSH:
+		return stream_flush(e, va_arg(args, int));
+	case I_SETSIG:
+		return stream_setsig(e, va_arg(args, int));
+	case I_GETSIG:
+		return stream_getsig(e, va_arg(args, int *));
+	case I_CANPUT:
+		return stream_canput(e, va_arg(args, int));
+	default:
+		errno = EINVAL;
+		return -1;
+	}
+}
+
+static const struct fd_op_vtable stream_vtable = {
+	.read = stream_read,
+	.write = stream_write,
+	.close = stream_close,
+	.ioctl = stream_ioctl,
+};
+
+static int str_create(int fildes[2], bool duplex)
+{
+	int fd[2];
+	struct str_pair *pair;
+
+	if (fildes == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	pair = k_calloc(1, sizeof(*pair));
+	if (pair == NULL) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	fd[0] = zvfs_reserve_fd();
+	if (fd[0] < 0) {
+		k_free(pair);
+		errno = EMFILE;
+		return -1;
+	}
+
+	fd[1] = zvfs_reserve_fd();
+	if (fd[1] < 0) {
+		zvfs_free_fd(fd[0]);
+		k_free(pair);
+		errno = EMFILE;
+		return -1;
+	}
+
+	k_mutex_init(&pair->lock);
+	k_condvar_init(&pair->cond);
+
+	ARRAY_FOR_EACH(pair->end, i) {
+		pair->end[i].pair = pair;
+		pair->end[i].peer = &pair->end[1 - i];
+		pair->end[i].open = true;
+		k_poll_signal_init(&pair->end[i].sig);
+	}
+
+	/* a pipe is read from its first end and written to its second end */
+	pair->end[0].rx = &pair->q[0];
+	pair->end[1].tx = &pair->q[0];
+	if (duplex) {
+		pair->end[1].rx = &pair->q[1];
+		pair->end[0].tx = &pair->q[1];
+	}
+
+	ARRAY_FOR_EACH(fd, i) {
+		zvfs_finalize_typed_fd(fd[i], &pair->end[i], &stream_vtable, ZVFS_MODE_IFIFO);
+		fildes[i] = fd[i];
+	}
+
+	return 0;
+}
+
+int stream_pipe_np(int fildes[2])
+{
+	return str_create(fildes, false);
+}
+
+int stream_socketpair_np(int fildes[2])
+{
+	return str_create(fildes, true);
+}
@@ -0,0 +1,28 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_POSIX_OPTIONS_XSI_STREAMS_STREAM_H_
+#define ZEPHYR_LIB_POSIX_OPTIONS_XSI_STREAMS_STREAM_H_
+
+#include <stropts.h>
+
+/*
+ * Queue a message on the stream @p fd. @p flags is MSG_HIPRI or MSG_BAND.
+ * Returns 0, or -1 with errno set.
+ */
+int posix_stream_put(int fd, const struct strbuf *ctlptr, const struct strbuf *dataptr, int band,
+		     int flags);
+
+/*
+ * Receive a message from the stream @p fd. @p flagsp is MSG_HIPRI, MSG_ANY or MSG_BAND.
+ * Returns a combination of MORECTL and MOREDATA, or -1 with errno set.
+ */
+int posix_stream_get(int fd, struct strbuf *ctlptr, struct strbuf *dataptr, int *bandp,
+		     int *flagsp);
+
+/* Returns 1 if @p fd is a stream, 0 if it is not, or -1 with errno set if it is not open */
+int posix_stream_is(int fd);
+
+#endif /* ZEPHYR_LIB_POSIX_OPTIONS_XSI_STREAMS_STREAM_H_ */
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "stream.h"
+
 #include <errno.h>
 #include <stdarg.h>
 
@@ -12,26 +14,19 @@
 
 int putmsg(int fildes, const struct strbuf *ctlptr, const struct strbuf *dataptr, int flags)
 {
-	ARG_UNUSED(fildes);
-	ARG_UNUSED(ctlptr);
-	ARG_UNUSED(dataptr);
-	ARG_UNUSED(flags);
+	if ((flags != 0) && (flags != RS_HIPRI)) {
+		errno = EINVAL;
+		return -1;
+	}
 
-	errno = ENOSYS;
-	return -1;
+	return posix_stream_put(fildes, ctlptr, dataptr, 0,
+				(flags == RS_HIPRI) ? MSG_HIPRI : MSG_BAND);
 }
 
 int putpmsg(int fildes, const struct strbuf *ctlptr, const struct strbuf *dataptr, int band,
 	    int flags)
 {
-	ARG_UNUSED(fildes);
-	ARG_UNUSED(ctlptr);
-	ARG_UNUSED(dataptr);
-	ARG_UNUSED(band);
-	ARG_UNUSED(flags);
-
-	errno = ENOSYS;
-	return -1;
+	return posix_stream_put(fildes, ctlptr, dataptr, band, flags);
 }
 
 int fdetach(const char *path)
@@ -53,33 +48,32 @@ int fattach(int fildes, const char *path)
 
 int getmsg(int fildes, struct strbuf *ctlptr, struct strbuf *dataptr, int *flagsp)
 {
-	ARG_UNUSED(fildes);
-	ARG_UNUSED(ctlptr);
-	ARG_UNUSED(dataptr);
-	ARG_UNUSED(flagsp);
+	int ret;
+	int band = 0;
+	int flags;
 
-	errno = ENOSYS;
-	return -1;
+	if ((flagsp == NULL) || ((*flagsp != 0) && (*flagsp != RS_HIPRI))) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	flags = (*flagsp == RS_HIPRI) ? MSG_HIPRI : MSG_ANY;
+	ret = posix_stream_get(fildes, ctlptr, dataptr, &band, &flags);
+	if (ret >= 0) {
+		*flagsp = (flags == MSG_HIPRI) ? RS_HIPRI : 0;
+	}
+
+	return ret;
 }
 
 int getpmsg(int fildes, struct strbuf *ctlptr, struct strbuf *dataptr, int *bandp, int *flagsp)
 {
-	ARG_UNUSED(fildes);
-	ARG_UNUSED(ctlptr);
-	ARG_UNUSED(dataptr);
-	ARG_UNUSED(bandp);
-	ARG_UNUSED(flagsp);
-
-	errno = ENOSYS;
-	return -1;
+	return posix_stream_get(fildes, ctlptr, dataptr, bandp, flagsp);
 }
 
 int isastream(int fildes)
 {
-	ARG_UNUSED(fildes);
-
-	errno = ENOSYS;
-	return -1;
+	return posix_stream_is(fildes);
 }
 
 #include <zephyr/sys/zvfs.h>
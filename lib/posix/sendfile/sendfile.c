@@ -0,0 +1,282 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/sendfile.h>
+#include <sys/types.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/sys/zvfs.h>
+
+#include "fadvise_priv.h"
+
+#define SPLICE_F_ALL (SPLICE_F_MOVE | SPLICE_F_NONBLOCK | SPLICE_F_MORE | SPLICE_F_GIFT)
+
+/* size of the buffer on the stack that is used when every bounce buffer is in use */
+#define SENDFILE_STACK_BUFFER_SIZE 128
+
+K_MEM_SLAB_DEFINE_STATIC(sendfile_slab, CONFIG_SENDFILE_BUFFER_SIZE, CONFIG_SENDFILE_BUFFERS,
+			 sizeof(void *));
+
+static inline int zvfs_ioctl_wrap(int fd, int cmd, ...)
+{
+	int ret;
+	va_list args;
+
+	va_start(args, cmd);
+	ret = zvfs_ioctl(fd, cmd, args);
+	va_end(args);
+
+	return ret;
+}
+
+/*
+ * Map the @p *count bytes of @p fd that start at @p off, if the object behind @p fd supports
+ * it (e.g. a shared memory object). @p *count is clipped to the size of the object.
+ *
+ * Returns NULL if @p fd cannot be mapped, in which case the caller copies the data instead.
+ */
+static const uint8_t *map_source(int fd, size_t off, size_t *count)
+{
+	int err = errno;
+	void *virt = NULL;
+	struct zvfs_stat st;
+
+	if (!IS_ENABLED(CONFIG_MMU)) {
+		return NULL;
+	}
+
+	if ((zvfs_fstat(fd, &st) < 0) || ((size_t)st.size <= off) ||
+	    (zvfs_ioctl_wrap(fd, ZFD_IOCTL_MMAP, NULL, (size_t)st.size, PROT_READ, MAP_SHARED,
+			     (off_t)0, &virt) < 0)) {
+		/* not an error, the data is copied instead */
+		errno = err;
+		return NULL;
+	}
+
+	*count = MIN(*count, (size_t)st.size - off);
+
+	return (const uint8_t *)virt + off;
+}
+
+static ssize_t read_at(int fd, void *buf, size_t len, const size_t *off)
+{
+	ssize_t ret;
+
+	if (posix_fadv_read(fd, buf, len, off, &ret)) {
+		return ret;
+	}
+
+	return (off == NULL) ? zvfs_read(fd, buf, len) : zvfs_read_offset(fd, buf, len, off);
+}
+
+/*
+ * Write all @p len bytes of @p buf to @p fd, at @p off if it is not NULL.
+ *
+ * Returns the number of bytes written before any error, or -1 if nothing could be written.
+ */
+static ssize_t write_all(int fd, const uint8_t *buf, size_t len, const size_t *off)
+{
+	size_t pos;
+	ssize_t ret = 0;
+	size_t done = 0;
+
+	while (done < len) {
+		if (off == NULL) {
+			ret = zvfs_write(fd, &buf[done], len - done);
+		} else {
+			pos = *off + done;
+			ret = zvfs_write_offset(fd, &buf[done], len - done, &pos);
+		}
+
+		if (ret <= 0) {
+			break;
+		}
+
+		done += ret;
+	}
+
+	if (done > 0) {
+		posix_fadv_invalidate(fd, (off == NULL) ? 0 : (off_t)*off,
+				      (off == NULL) ? 0 : (off_t)done);
+	} else if (ret < 0) {
+		return -1;
+	}
+
+	return done;
+}
+
+/*
+ * Copy up to @p len bytes from @p fd_in to @p fd_out through a bounce buffer. A NULL offset
+ * means to use (and advance) the file position of the corresponding descriptor.
+ *
+ * If @p fd_out accepts only part of a chunk, the rest of the chunk is given back to @p fd_in by
+ * seeking, when @p fd_in is seekable, and dropped otherwise.
+ *
+ * A transfer that finds every bounce buffer in use goes on with a smaller buffer on the stack,
+ * rather than waiting for a transfer that may be stalled, e.g. on a full socket.
+ */
+static ssize_t bounce(int fd_in, const size_t *off_in, int fd_out, const size_t *off_out,
+		      size_t len)
+{
+	size_t to;
+	size_t from;
+	ssize_t rd = 0;
+	ssize_t wr = 0;
+	size_t done = 0;
+	uint8_t *buf;
+	size_t size = CONFIG_SENDFILE_BUFFER_SIZE;
+	uint8_t stack_buf[SENDFILE_STACK_BUFFER_SIZE];
+
+	if (k_mem_slab_alloc(&sendfile_slab, (void **)&buf, K_NO_WAIT) != 0) {
+		buf = stack_buf;
+		size = sizeof(stack_buf);
+	}
+
+	while (done < len) {
+		from = (off_in == NULL) ? 0 : *off_in + done;
+		rd = read_at(fd_in, buf, MIN(len - done, size), (off_in == NULL) ? NULL : &from);
+		if (rd <= 0) {
+			break;
+		}
+
+		to = (off_out == NULL) ? 0 : *off_out + done;
+		wr = write_all(fd_out, buf, rd, (off_out == NULL) ? NULL : &to);
+		if (wr > 0) {
+			done += wr;
+		}
+
+		if (wr < rd) {
+			if (off_in == NULL) {
+				(void)zvfs_lseek(fd_in, -(off_t)(rd - MAX(wr, 0)), SEEK_CUR);
+			}
+			break;
+		}
+	}
+
+	if (buf != stack_buf) {
+		k_mem_slab_free(&sendfile_slab, buf);
+	}
+
+	if ((done == 0) && ((rd < 0) || (wr < 0))) {
+		return -1;
+	}
+
+	return done;
+}
+
+/* Check that @p fd can be used at an explicit offset, returning the offset as a size_t */
+static int offset_check(int fd, const off_t *offset, size_t *pos)
+{
+	if (offset == NULL) {
+		return 0;
+	}
+
+	if (*offset < 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (zvfs_lseek(fd, 0, SEEK_CUR) < 0) {
+		errno = (errno == EBADF) ? EBADF : ESPIPE;
+		return -1;
+	}
+
+	*pos = (size_t)*offset;
+
+	return 0;
+}
+
+ssize_t sendfile(int out_fd, int in_fd, off_t *offset, size_t count)
+{
+	off_t cur;
+	ssize_t ret;
+	size_t pos = 0;
+	size_t len = MIN(count, SSIZE_MAX);
+	const uint8_t *src;
+
+	if (offset_check(in_fd, offset, &pos) < 0) {
+		return -1;
+	}
+
+	if (offset == NULL) {
+		/* the file position is only updated once the outcome of the transfer is known */
+		cur = zvfs_lseek(in_fd, 0, SEEK_CUR);
+		if (cur < 0) {
+			/* in_fd must be seekable */
+			errno = (errno == EBADF) ? EBADF : EINVAL;
+			return -1;
+		}
+		pos = (size_t)cur;
+	}
+
+	if (len == 0) {
+		return 0;
+	}
+
+	src = map_source(in_fd, pos, &len);
+	if (src != NULL) {
+		ret = write_all(out_fd, src, len, NULL);
+	} else {
+		ret = bounce(in_fd, &pos, out_fd, NULL, len);
+	}
+
+	if (ret < 0) {
+		return -1;
+	}
+
+	if (offset != NULL) {
+		*offset = (off_t)(pos + ret);
+	} else if (zvfs_lseek(in_fd, (off_t)(pos + ret), SEEK_SET) < 0) {
+		return -1;
+	}
+
+	return ret;
+}
+
+ssize_t splice(int fd_in, off_t *off_in, int fd_out, off_t *off_out, size_t len,
+	       unsigned int flags)
+{
+	ssize_t ret;
+	size_t pos_in = 0;
+	size_t pos_out = 0;
+
+	if ((flags & ~SPLICE_F_ALL) != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if ((offset_check(fd_in, off_in, &pos_in) < 0) ||
+	    (offset_check(fd_out, off_out, &pos_out) < 0)) {
+		return -1;
+	}
+
+	if (len == 0) {
+		return 0;
+	}
+
+	ret = bounce(fd_in, (off_in == NULL) ? NULL : &pos_in, fd_out,
+		     (off_out == NULL) ? NULL : &pos_out, MIN(len, SSIZE_MAX));
+	if (ret < 0) {
+		return -1;
+	}
+
+	if (off_in != NULL) {
+		*off_in += ret;
+	}
+
+	if (off_out != NULL) {
+		*off_out += ret;
+	}
+
+	return ret;
+}
@@ -0,0 +1,43 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "percpu_priv.h"
+#include "posix_shell.h"
+
+#include <stdlib.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+
+static int cmd_stats(const struct shell *sh, size_t argc, char **argv)
+{
+	long long total;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_fprintf(sh, SHELL_NORMAL, "%-12s %12s", "stat", "total");
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); ++cpu) {
+		shell_fprintf(sh, SHELL_NORMAL, " %9s%u", "cpu", cpu);
+	}
+	shell_fprintf(sh, SHELL_NORMAL, "\n");
+
+	for (int stat = 0; stat < POSIX_STAT_NUM; ++stat) {
+		total = 0;
+		for (unsigned int cpu = 0; cpu < arch_num_cpus(); ++cpu) {
+			total += posix_stat_get(stat, cpu);
+		}
+
+		shell_fprintf(sh, SHELL_NORMAL, "%-12s %12lld", posix_stat_name(stat), total);
+		for (unsigned int cpu = 0; cpu < arch_num_cpus(); ++cpu) {
+			shell_fprintf(sh, SHELL_NORMAL, " %10ld", (long)posix_stat_get(stat, cpu));
+		}
+		shell_fprintf(sh, SHELL_NORMAL, "\n");
+	}
+
+	return EXIT_SUCCESS;
+}
+
+POSIX_CMD_ADD(stats, NULL, "Print POSIX statistics of every CPU", cmd_stats, 1, 0);
@@ -0,0 +1,210 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sched.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+
+/* sample the CPU time every millisecond */
+#define SAMPLE_US 1000
+#define ROUNDS    50
+
+#define BUF_SIZE   65536
+#define SORT_SIZE  1024
+#define PRIME_MAX  20000
+/* work done between preemption points, see README.rst */
+#define BLOCK_SIZE 64
+
+#define ARRAY_LEN(a) (sizeof(a) / sizeof((a)[0]))
+
+enum func {
+	FUNC_OTHER,
+	FUNC_CHECKSUM,
+	FUNC_SORT,
+	FUNC_PRIMES,
+	FUNC_NUM,
+};
+
+static const char *const func_names[] = {
+	[FUNC_OTHER] = "<other>",
+	[FUNC_CHECKSUM] = "checksum",
+	[FUNC_SORT] = "sort",
+	[FUNC_PRIMES] = "primes",
+};
+
+/* the function that is running, as seen by the signal handler */
+static volatile sig_atomic_t current = FUNC_OTHER;
+static volatile unsigned long samples[FUNC_NUM];
+
+static uint8_t buf[BUF_SIZE];
+static int values[SORT_SIZE];
+
+static void on_sigprof(int signo)
+{
+	(void)signo;
+
+	++samples[current];
+}
+
+/* let a pending signal be delivered */
+static void preemption_point(void)
+{
+	(void)sched_yield();
+}
+
+static uint32_t checksum(const uint8_t *data, size_t len)
+{
+	uint32_t a = 1;
+	uint32_t b = 0;
+
+	current = FUNC_CHECKSUM;
+	for (size_t i = 0; i < len; ++i) {
+		a = (a + data[i]) % 65521;
+		b = (b + a) % 65521;
+		if ((i % BLOCK_SIZE) == (BLOCK_SIZE - 1)) {
+			preemption_point();
+		}
+	}
+	current = FUNC_OTHER;
+
+	return (b << 16) | a;
+}
+
+static void sort(int *a, size_t n)
+{
+	int v;
+	size_t j;
+
+	current = FUNC_SORT;
+	for (size_t i = 1; i < n; ++i) {
+		v = a[i];
+		for (j = i; (j > 0) && (a[j - 1] > v); --j) {
+			a[j] = a[j - 1];
+		}
+		a[j] = v;
+
+		if ((i % (BLOCK_SIZE / 4)) == 0) {
+			preemption_point();
+		}
+	}
+	current = FUNC_OTHER;
+}
+
+static unsigned int primes(unsigned int max)
+{
+	bool prime;
+	unsigned int count = 0;
+
+	current = FUNC_PRIMES;
+	for (unsigned int n = 2; n < max; ++n) {
+		prime = true;
+		for (unsigned int d = 2; d * d <= n; ++d) {
+			if ((n % d) == 0) {
+				prime = false;
+				break;
+			}
+		}
+
+		count += prime ? 1 : 0;
+		if ((n % BLOCK_SIZE) == 0) {
+			preemption_point();
+		}
+	}
+	current = FUNC_OTHER;
+
+	return count;
+}
+
+static void workload(void)
+{
+	uint32_t sum = 0;
+	unsigned int count = 0;
+
+	for (int round = 0; round < ROUNDS; ++round) {
+		for (size_t i = 0; i < ARRAY_LEN(buf); ++i) {
+			buf[i] = (uint8_t)(i * 31 + round);
+		}
+
+		for (size_t i = 0; i < ARRAY_LEN(values); ++i) {
+			/* in reverse order, the worst case for an insertion sort */
+			values[i] = (int)(ARRAY_LEN(values) - i) + round;
+		}
+
+		sum ^= checksum(buf, sizeof(buf));
+		sort(values, ARRAY_LEN(values));
+		count += primes(PRIME_MAX);
+	}
+
+	printf("checksum: %08x, primes: %u\n", (unsigned int)sum, count);
+}
+
+static void print_profile(void)
+{
+	unsigned long total = 0;
+	unsigned long most;
+	int top;
+	bool printed[FUNC_NUM] = {0};
+
+	for (int i = 0; i < FUNC_NUM; ++i) {
+		total += samples[i];
+	}
+
+	printf("Flat profile of %lu samples, %d us each\n", total, SAMPLE_US);
+	printf("  %%time  samples  function\n");
+
+	/* most samples first */
+	for (int n = 0; n < FUNC_NUM; ++n) {
+		top = -1;
+		most = 0;
+		for (int i = 0; i < FUNC_NUM; ++i) {
+			if (!printed[i] && ((top < 0) || (samples[i] > most))) {
+				top = i;
+				most = samples[i];
+			}
+		}
+
+		printed[top] = true;
+		printf("  %5.1f  %7lu  %s\n", (total == 0) ? 0.0 : (100.0 * most) / total, most,
+		       func_names[top]);
+	}
+}
+
+int main(void)
+{
+	struct sigaction act = {
+		.sa_handler = on_sigprof,
+	};
+	struct itimerval timer = {
+		.it_value = {.tv_usec = SAMPLE_US},
+		.it_interval = {.tv_usec = SAMPLE_US},
+	};
+
+	(void)sigemptyset(&act.sa_mask);
+	if (sigaction(SIGPROF, &act, NULL) != 0) {
+		perror("sigaction");
+		return 1;
+	}
+
+	if (setitimer(ITIMER_PROF, &timer, NULL) != 0) {
+		perror("setitimer");
+		return 1;
+	}
+
+	workload();
+
+	/* stop sampling before the profile is printed */
+	memset(&timer, 0, sizeof(timer));
+	(void)setitimer(ITIMER_PROF, &timer, NULL);
+
+	print_profile();
+	printf("Done\n");
+
+	return 0;
+}
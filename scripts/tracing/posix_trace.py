@@ -0,0 +1,223 @@
+#!/usr/bin/env python3
+
+# SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Report the wait time and contention of each POSIX object in a CTF trace.
+
+The trace is recorded with CONFIG_POSIX_TRACING and the CTF backend. Its metadata must include
+the POSIX events, e.g.:
+
+    cat $ZEPHYR_BASE/subsys/tracing/ctf/tsdl/metadata scripts/tracing/posix.tsdl > trace/metadata
+    scripts/tracing/posix_trace.py -t trace
+
+For each object, a call is counted as blocked if it found the object unavailable, and waited
+from its posix_enter to its posix_exit event. Reading the trace requires the babeltrace2 Python
+bindings (bt2).
+"""
+
+import argparse
+import sys
+from dataclasses import dataclass, field
+
+# enum sys_trace_posix_call of <zephyr/posix/posix_tracing.h>, by group of 16
+OBJECTS = ("thread", "mutex", "cond", "rwlock", "barrier", "sem", "mq", "timer", "signal")
+CALLS = {
+    0x00: "pthread_create",
+    0x01: "pthread_join",
+    0x02: "pthread_detach",
+    0x03: "pthread_cancel",
+    0x04: "pthread_exit",
+    0x10: "pthread_mutex_init",
+    0x11: "pthread_mutex_destroy",
+    0x12: "pthread_mutex_lock",
+    0x13: "pthread_mutex_unlock",
+    0x20: "pthread_cond_init",
+    0x21: "pthread_cond_destroy",
+    0x22: "pthread_cond_wait",
+    0x23: "pthread_cond_signal",
+    0x24: "pthread_cond_broadcast",
+    0x30: "pthread_rwlock_init",
+    0x31: "pthread_rwlock_destroy",
+    0x32: "pthread_rwlock_rdlock",
+    0x33: "pthread_rwlock_wrlock",
+    0x34: "pthread_rwlock_unlock",
+    0x40: "pthread_barrier_init",
+    0x41: "pthread_barrier_destroy",
+    0x42: "pthread_barrier_wait",
+    0x50: "sem_init",
+    0x51: "sem_destroy",
+    0x52: "sem_open",
+    0x53: "sem_close",
+    0x54: "sem_wait",
+    0x55: "sem_post",
+    0x60: "mq_open",
+    0x61: "mq_close",
+    0x62: "mq_send",
+    0x63: "mq_receive",
+    0x70: "timer_create",
+    0x71: "timer_delete",
+    0x72: "timer_settime",
+    0x80: "kill",
+    0x81: "sigqueue",
+    0x82: "sigwait",
+    0x83: "sigsuspend",
+    0x84: "pause",
+}
+
+
+def object_kind(call):
+    group = call >> 4
+    return OBJECTS[group] if group < len(OBJECTS) else f"0x{call:02x}"
+
+
+def call_name(call):
+    return CALLS.get(call, f"0x{call:02x}")
+
+
+@dataclass
+class Pending:
+    call: int
+    obj: int
+    start: int
+    blocked: bool = False
+
+
+@dataclass
+class Stats:
+    calls: int = 0
+    blocked: int = 0
+    errors: int = 0
+    # calls with a posix_enter event, and their wait in nanoseconds
+    waits: int = 0
+    wait_total: int = 0
+    wait_max: int = 0
+
+    def add(self, wait, blocked, err):
+        self.calls += 1
+        self.blocked += int(blocked)
+        self.errors += int(err != 0)
+        if wait is not None:
+            self.waits += 1
+            self.wait_total += wait
+            self.wait_max = max(self.wait_max, wait)
+
+
+@dataclass
+class PosixTrace:
+    """Pair the POSIX events of each thread and add them up by object, or by object and call."""
+
+    by_call: bool = False
+    stats: dict = field(default_factory=dict)
+    # calls entered and not yet returned, by thread, innermost last
+    pending: dict = field(default_factory=dict)
+
+    def _find(self, thread, call, obj):
+        calls = self.pending.get(thread, [])
+        for i in range(len(calls) - 1, -1, -1):
+            if (calls[i].call == call) and (calls[i].obj == obj):
+                return i
+        return None
+
+    def enter(self, ts, call, thread, obj):
+        self.pending.setdefault(thread, []).append(Pending(call, obj, ts))
+
+    def blocking(self, ts, call, thread, obj):
+        i = self._find(thread, call, obj)
+        if i is not None:
+            self.pending[thread][i].blocked = True
+
+    def exit(self, ts, call, thread, obj, err):
+        wait = None
+        blocked = False
+        i = self._find(thread, call, obj)
+        if i is not None:
+            p = self.pending[thread].pop(i)
+            wait = ts - p.start
+            blocked = p.blocked
+
+        key = (object_kind(call), obj, call_name(call) if self.by_call else "")
+        self.stats.setdefault(key, Stats()).add(wait, blocked, err)
+
+    def event(self, ts, name, call, thread, obj, arg=0):
+        if name == "posix_enter":
+            self.enter(ts, call, thread, obj)
+        elif name == "posix_blocking":
+            self.blocking(ts, call, thread, obj)
+        elif name == "posix_exit":
+            self.exit(ts, call, thread, obj, arg)
+
+    def report(self, top=None):
+        rows = sorted(self.stats.items(), key=lambda kv: kv[1].wait_total, reverse=True)
+        if top is not None:
+            rows = rows[:top]
+
+        lines = [
+            f"{'object':<8} {'id':>10} {'call':<24} {'calls':>8} {'blocked':>8} "
+            f"{'contention':>10} {'wait(us)':>12} {'mean(us)':>10} {'max(us)':>10} "
+            f"{'errors':>6}"
+        ]
+        for (kind, obj, call), s in rows:
+            mean = (s.wait_total / s.waits) if s.waits > 0 else 0
+            lines.append(
+                f"{kind:<8} {obj:>#10x} {call:<24} {s.calls:>8} {s.blocked:>8} "
+                f"{100 * s.blocked / s.calls:>9.1f}% {s.wait_total / 1000:>12.1f} "
+                f"{mean / 1000:>10.1f} {s.wait_max / 1000:>10.1f} {s.errors:>6}"
+            )
+
+        return lines
+
+
+def read_ctf(path, trace):
+    try:
+        import bt2
+    except ImportError:
+        sys.exit("the babeltrace2 Python bindings (bt2) are required to read CTF traces")
+
+    for msg in bt2.TraceCollectionMessageIterator(path):
+        if type(msg) is not bt2._EventMessageConst:
+            continue
+
+        event = msg.event
+        if not event.name.startswith("posix_"):
+            continue
+
+        payload = event.payload_field
+        arg = int(payload["err"]) if event.name == "posix_exit" else 0
+        trace.event(
+            msg.default_clock_snapshot.ns_from_origin,
+            event.name,
+            int(payload["call"]),
+            int(payload["thread_id"]),
+            int(payload["id"]),
+            arg,
+        )
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        allow_abbrev=False,
+    )
+    parser.add_argument("-t", "--trace", required=True, help="CTF trace directory")
+    parser.add_argument(
+        "-c", "--by-call", action="store_true", help="report each call of each object apart"
+    )
+    parser.add_argument("-n", "--top", type=int, help="only report the objects waited on most")
+
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    trace = PosixTrace(by_call=args.by_call)
+
+    read_ctf(args.trace, trace)
+    for line in trace.report(args.top):
+        print(line)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,129 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+#define MAX_WAITERS CONFIG_TEST_MAX_WAITERS
+#define ITERATIONS  CONFIG_TEST_ITERATIONS
+#define WAITER_PRIO K_PRIO_PREEMPT(1)
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_WAITERS, CONFIG_TEST_STACK_SIZE);
+static struct k_thread threads[MAX_WAITERS];
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
+static K_SEM_DEFINE(done, 0, 1);
+
+static atomic_t switches;
+static int waiting;
+static int acquired;
+static int num_waiters;
+static bool go;
+static uint32_t end_cycles;
+static atomic_val_t end_switches;
+
+/* called by the scheduler for every context switch, with CONFIG_TRACING_USER */
+void sys_trace_thread_switched_in_user(void)
+{
+	(void)atomic_inc(&switches);
+}
+
+static void waiter(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	(void)pthread_mutex_lock(&lock);
+
+	++waiting;
+	while (!go) {
+		(void)pthread_cond_wait(&cond, &lock);
+	}
+
+	/* let any other runnable waiter contend for the mutex */
+	k_yield();
+
+	if (++acquired == num_waiters) {
+		end_cycles = k_cycle_get_32();
+		end_switches = atomic_get(&switches);
+		k_sem_give(&done);
+	}
+
+	(void)pthread_mutex_unlock(&lock);
+}
+
+static void broadcast(int n, uint64_t *cycles, uint64_t *nswitch)
+{
+	uint32_t start;
+	atomic_val_t start_switches;
+
+	num_waiters = n;
+	waiting = 0;
+	acquired = 0;
+	go = false;
+
+	for (int i = 0; i < n; ++i) {
+		k_thread_create(&threads[i], stacks[i], K_THREAD_STACK_SIZEOF(stacks[i]), waiter,
+				NULL, NULL, NULL, WAITER_PRIO, 0, K_NO_WAIT);
+	}
+
+	for (;;) {
+		(void)pthread_mutex_lock(&lock);
+		if (waiting == n) {
+			break;
+		}
+		(void)pthread_mutex_unlock(&lock);
+		k_msleep(1);
+	}
+
+	go = true;
+	start_switches = atomic_get(&switches);
+	start = k_cycle_get_32();
+	(void)pthread_cond_broadcast(&cond);
+	(void)pthread_mutex_unlock(&lock);
+
+	(void)k_sem_take(&done, K_FOREVER);
+
+	*cycles += end_cycles - start;
+	*nswitch += end_switches - start_switches;
+
+	for (int i = 0; i < n; ++i) {
+		(void)k_thread_join(&threads[i], K_FOREVER);
+	}
+}
+
+int main(void)
+{
+	uint64_t cycles;
+	uint64_t nswitch;
+
+	printf("BOARD: %s\n", CONFIG_BOARD);
+	printf("COND_WAIT_MORPHING: %c\n", IS_ENABLED(CONFIG_POSIX_COND_WAIT_MORPHING) ? 'y' : 'n');
+	printf("ITERATIONS: %d\n", ITERATIONS);
+	printf("waiters, context switches, time(us)\n");
+
+	for (int n = 1; n <= MAX_WAITERS; n *= 2) {
+		cycles = 0;
+		nswitch = 0;
+
+		for (int i = 0; i < ITERATIONS; ++i) {
+			broadcast(n, &cycles, &nswitch);
+		}
+
+		printf("%d, %llu, %llu\n", n, (unsigned long long)(nswitch / ITERATIONS),
+		       (unsigned long long)k_cyc_to_us_ceil64(cycles / ITERATIONS));
+	}
+
+	printf("PROJECT EXECUTION SUCCESSFUL\n");
+
+	return 0;
+}
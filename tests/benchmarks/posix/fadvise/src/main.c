@@ -0,0 +1,158 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <ff.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+#define MNTP      "/RAM:"
+#define TEST_FILE MNTP "/bench.dat"
+
+/* no posix_fadvise() call is made for this pseudo-advice */
+#define ADVICE_NONE (-1)
+
+static FATFS fat_fs;
+static struct fs_mount_t fatfs_mnt = {
+	.type = FS_FATFS,
+	.mnt_point = MNTP,
+	.fs_data = &fat_fs,
+};
+
+static uint8_t buf[CONFIG_TEST_READ_SIZE];
+
+static const char *advice_str(int advice)
+{
+	switch (advice) {
+	case POSIX_FADV_NORMAL:
+		return "NORMAL";
+	case POSIX_FADV_SEQUENTIAL:
+		return "SEQUENTIAL";
+	case POSIX_FADV_RANDOM:
+		return "RANDOM";
+	case POSIX_FADV_WILLNEED:
+		return "WILLNEED";
+	default:
+		return "none";
+	}
+}
+
+static void create_file(void)
+{
+	int fd;
+
+	fd = open(TEST_FILE, O_CREAT | O_TRUNC | O_WRONLY, 0660);
+	__ASSERT(fd >= 0, "open() failed: %d", errno);
+
+	for (size_t i = 0; i < sizeof(buf); ++i) {
+		buf[i] = (uint8_t)i;
+	}
+
+	for (size_t n = 0; n < CONFIG_TEST_FILE_SIZE; n += sizeof(buf)) {
+		(void)write(fd, buf, MIN(sizeof(buf), CONFIG_TEST_FILE_SIZE - n));
+	}
+
+	(void)close(fd);
+}
+
+static size_t read_sequential(int fd, int advice)
+{
+	ssize_t ret;
+	size_t total = 0;
+
+	(void)lseek(fd, 0, SEEK_SET);
+	if (advice != ADVICE_NONE) {
+		(void)posix_fadvise(fd, 0, 0, advice);
+	}
+
+	do {
+		ret = read(fd, buf, sizeof(buf));
+		total += MAX(ret, 0);
+	} while (ret > 0);
+
+	return total;
+}
+
+static size_t read_strided(int fd, int advice)
+{
+	size_t total = 0;
+
+	if ((advice != ADVICE_NONE) && (advice != POSIX_FADV_WILLNEED)) {
+		(void)posix_fadvise(fd, 0, 0, advice);
+	}
+
+	for (off_t off = 0; off < CONFIG_TEST_FILE_SIZE; off += CONFIG_TEST_STRIDE) {
+		if (advice == POSIX_FADV_WILLNEED) {
+			/* hint the next access while this one is served */
+			(void)posix_fadvise(fd, off + CONFIG_TEST_STRIDE, sizeof(buf), advice);
+		}
+
+		total += MAX(pread(fd, buf, sizeof(buf), off), 0);
+	}
+
+	return total;
+}
+
+static void run(const char *name, size_t (*fn)(int fd, int advice), int advice)
+{
+	int fd;
+	uint64_t us;
+	uint32_t start;
+	uint32_t cycles;
+	size_t total = 0;
+
+	fd = open(TEST_FILE, O_RDONLY);
+	__ASSERT(fd >= 0, "open() failed: %d", errno);
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < CONFIG_TEST_ITERATIONS; ++i) {
+		total += fn(fd, advice);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	(void)close(fd);
+
+	us = MAX(k_cyc_to_us_ceil64(cycles), 1);
+	printf("%s, %s, %zu, %llu, %llu\n", name, advice_str(advice), total,
+	       (unsigned long long)us, (unsigned long long)(total * USEC_PER_SEC / 1024 / us));
+}
+
+int main(void)
+{
+	int rc;
+
+	rc = fs_mount(&fatfs_mnt);
+	__ASSERT(rc == 0, "fs_mount() failed: %d", rc);
+
+	create_file();
+
+	printf("BOARD: %s\n", CONFIG_BOARD);
+	printf("FILE_SIZE: %d\n", CONFIG_TEST_FILE_SIZE);
+	printf("READ_SIZE: %d\n", CONFIG_TEST_READ_SIZE);
+	printf("BLOCK_SIZE: %d\n", CONFIG_POSIX_FADVISE_BLOCK_SIZE);
+	printf("CACHE_BLOCKS: %d\n", CONFIG_POSIX_FADVISE_CACHE_BLOCKS);
+	printf("READAHEAD_MAX: %d\n", CONFIG_POSIX_FADVISE_READAHEAD_MAX);
+	printf("pattern, advice, bytes, time(us), rate (KiB/s)\n");
+
+	run("sequential", read_sequential, ADVICE_NONE);
+	run("sequential", read_sequential, POSIX_FADV_NORMAL);
+	run("sequential", read_sequential, POSIX_FADV_SEQUENTIAL);
+	run("strided", read_strided, ADVICE_NONE);
+	run("strided", read_strided, POSIX_FADV_RANDOM);
+	run("strided", read_strided, POSIX_FADV_WILLNEED);
+
+	(void)unlink(TEST_FILE);
+	(void)fs_unmount(&fatfs_mnt);
+
+	printf("PROJECT EXECUTION SUCCESSFUL\n");
+
+	return 0;
+}
@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <ff.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+#define MNTP      "/RAM:"
+#define TEST_FILE MNTP "/bench.dat"
+
+#define NUM_WRITES DIV_ROUND_UP(CONFIG_TEST_FILE_SIZE, CONFIG_TEST_WRITE_SIZE)
+#define NUM_BUCKETS CONFIG_TEST_HISTOGRAM_BUCKETS
+
+static FATFS fat_fs;
+static struct fs_mount_t fatfs_mnt = {
+	.type = FS_FATFS,
+	.mnt_point = MNTP,
+	.fs_data = &fat_fs,
+};
+
+static uint8_t buf[CONFIG_TEST_WRITE_SIZE];
+static uint32_t histogram[NUM_BUCKETS];
+
+/* bucket 0 holds latencies below 1 us, bucket n holds [2^(n-1), 2^n) us */
+static inline size_t bucket_of(uint64_t us)
+{
+	return MIN((us == 0) ? 0 : (LOG2(us) + 1), NUM_BUCKETS - 1);
+}
+
+static inline uint64_t bucket_upper_us(size_t bucket)
+{
+	return BIT64(bucket);
+}
+
+static uint64_t percentile_us(uint32_t pct)
+{
+	uint32_t count = 0;
+	uint32_t target = DIV_ROUND_UP(NUM_WRITES * pct, 100);
+
+	for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+		count += histogram[i];
+		if (count >= target) {
+			return bucket_upper_us(i);
+		}
+	}
+
+	return bucket_upper_us(NUM_BUCKETS - 1);
+}
+
+static void run(const char *name, bool prealloc)
+{
+	int fd;
+	uint32_t start;
+	uint64_t us;
+	uint64_t max_us = 0;
+
+	memset(histogram, 0, sizeof(histogram));
+
+	fd = open(TEST_FILE, O_CREAT | O_TRUNC | O_WRONLY, 0660);
+	__ASSERT(fd >= 0, "open() failed: %d", errno);
+
+	if (prealloc) {
+		int rc = posix_fallocate(fd, 0, CONFIG_TEST_FILE_SIZE);
+
+		__ASSERT(rc == 0, "posix_fallocate() failed: %d", rc);
+		ARG_UNUSED(rc);
+	}
+
+	for (size_t i = 0; i < NUM_WRITES; ++i) {
+		start = k_cycle_get_32();
+		(void)write(fd, buf, sizeof(buf));
+		us = k_cyc_to_us_floor64(k_cycle_get_32() - start);
+
+		++histogram[bucket_of(us)];
+		max_us = MAX(max_us, us);
+	}
+
+	(void)close(fd);
+	(void)unlink(TEST_FILE);
+
+	for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+		printf("histogram, %s, <%llu, %u\n", name, (unsigned long long)bucket_upper_us(i),
+		       histogram[i]);
+	}
+
+	printf("%s, %u, %llu, %llu, %llu\n", name, (unsigned int)NUM_WRITES,
+	       (unsigned long long)percentile_us(50), (unsigned long long)percentile_us(99),
+	       (unsigned long long)max_us);
+}
+
+int main(void)
+{
+	int rc;
+
+	rc = fs_mount(&fatfs_mnt);
+	__ASSERT(rc == 0, "fs_mount() failed: %d", rc);
+	ARG_UNUSED(rc);
+
+	printf("BOARD: %s\n", CONFIG_BOARD);
+	printf("FILE_SIZE: %d\n", CONFIG_TEST_FILE_SIZE);
+	printf("WRITE_SIZE: %d\n", CONFIG_TEST_WRITE_SIZE);
+	printf("case, writes, p50(us), p99(us), max(us)\n");
+
+	run("grow", false);
+	run("prealloc", true);
+
+	(void)fs_unmount(&fatfs_mnt);
+
+	printf("PROJECT EXECUTION SUCCESSFUL\n");
+
+	return 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <fnmatch.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+static char stars_pattern[2 * CONFIG_TEST_STARS + 2];
+static char stars_string[CONFIG_TEST_STRING_LEN + 1];
+
+static void run(const char *name, const char *pattern, const char *string, int flags, int expect)
+{
+	int rc;
+	uint64_t us;
+	uint32_t start;
+	uint32_t cycles;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < CONFIG_TEST_ITERATIONS; ++i) {
+		rc = fnmatch(pattern, string, flags);
+		__ASSERT(rc == expect, "%s: fnmatch() returned %d", name, rc);
+	}
+	cycles = k_cycle_get_32() - start;
+	ARG_UNUSED(rc);
+	ARG_UNUSED(expect);
+
+	us = MAX(k_cyc_to_us_ceil64(cycles), 1);
+	printf("%s, %d, %llu, %llu\n", name, CONFIG_TEST_ITERATIONS, (unsigned long long)us,
+	       (unsigned long long)((uint64_t)CONFIG_TEST_ITERATIONS * USEC_PER_SEC / us));
+}
+
+int main(void)
+{
+	for (int i = 0; i < CONFIG_TEST_STARS; ++i) {
+		stars_pattern[2 * i] = '*';
+		stars_pattern[2 * i + 1] = 'a';
+	}
+	stars_pattern[2 * CONFIG_TEST_STARS] = 'b';
+	memset(stars_string, 'a', CONFIG_TEST_STRING_LEN);
+
+	printf("BOARD: %s\n", CONFIG_BOARD);
+	printf("STARS: %d\n", CONFIG_TEST_STARS);
+	printf("STRING_LEN: %d\n", CONFIG_TEST_STRING_LEN);
+	printf("case, calls, time(us), calls/s\n");
+
+	run("suffix", "*.c", "posix_fnmatch_benchmark.c", 0, 0);
+	run("bracket", "[a-z]*_[[:digit:]][!.].txt", "log_2a.txt", 0, 0);
+	run("pathname", "src/*/*.c", "src/options/fnmatch.c", FNM_PATHNAME, 0);
+	run("stars", stars_pattern, stars_string, 0, FNM_NOMATCH);
+
+	printf("PROJECT EXECUTION SUCCESSFUL\n");
+
+	return 0;
+}
@@ -0,0 +1,166 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef CONFIG_POSIX_NETWORKING
+#include <netdb.h>
+#endif
+
+#include <ff.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+#define HOSTS_FILE "/etc/hosts"
+
+#define NUM_LINES (CONFIG_TEST_HOSTS_LINES * CONFIG_TEST_ITERATIONS)
+
+static FATFS fat_fs;
+static struct fs_mount_t fatfs_mnt = {
+	.type = FS_FATFS,
+	.mnt_point = "/",
+	.fs_data = &fat_fs,
+};
+
+static void create_hosts(void)
+{
+	int fd;
+	int rc;
+	int len;
+	char line[128];
+
+	rc = mkdir("/etc", 0770);
+	__ASSERT(rc == 0, "mkdir() failed: %d", errno);
+	ARG_UNUSED(rc);
+
+	fd = open(HOSTS_FILE, O_CREAT | O_TRUNC | O_WRONLY, 0660);
+	__ASSERT(fd >= 0, "open() failed: %d", errno);
+
+	for (int i = 0; i < CONFIG_TEST_HOSTS_LINES; ++i) {
+		if ((i % 10) == 0) {
+			len = snprintf(line, sizeof(line), "# hosts %d to %d\n", i, i + 9);
+		} else if ((i % 5) == 0) {
+			len = snprintf(line, sizeof(line),
+				       "10.%d.%d.%d host%d host%d.example.com host%d.lan h%d "
+				       "host%d.local\n",
+				       (i >> 16) & 0xff, (i >> 8) & 0xff, i & 0xff, i, i, i, i, i);
+		} else {
+			len = snprintf(line, sizeof(line), "10.%d.%d.%d host%d\n", (i >> 16) & 0xff,
+				       (i >> 8) & 0xff, i & 0xff, i);
+		}
+
+		(void)write(fd, line, len);
+	}
+
+	(void)close(fd);
+}
+
+static size_t read_fgets(void)
+{
+	FILE *fp;
+	size_t lines = 0;
+	char line[256];
+
+	fp = fopen(HOSTS_FILE, "r");
+	__ASSERT(fp != NULL, "fopen() failed: %d", errno);
+
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		++lines;
+	}
+
+	(void)fclose(fp);
+
+	return lines;
+}
+
+static size_t read_getline(void)
+{
+	FILE *fp;
+	size_t size = 0;
+	size_t lines = 0;
+	char *line = NULL;
+
+	fp = fopen(HOSTS_FILE, "r");
+	__ASSERT(fp != NULL, "fopen() failed: %d", errno);
+
+	while (getline(&line, &size, fp) >= 0) {
+		++lines;
+	}
+
+	free(line);
+	(void)fclose(fp);
+
+	return lines;
+}
+
+#ifdef CONFIG_POSIX_NETWORKING
+static size_t read_gethostent(void)
+{
+	size_t entries = 0;
+
+	sethostent(1);
+	while (gethostent() != NULL) {
+		++entries;
+	}
+	endhostent();
+
+	/* comments are skipped, so count them as lines that were read */
+	return entries + DIV_ROUND_UP(CONFIG_TEST_HOSTS_LINES, 10);
+}
+#endif
+
+static void run(const char *name, size_t (*fn)(void))
+{
+	uint64_t us;
+	uint32_t start;
+	uint32_t cycles;
+	size_t lines = 0;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < CONFIG_TEST_ITERATIONS; ++i) {
+		lines += fn();
+	}
+	cycles = k_cycle_get_32() - start;
+
+	__ASSERT(lines == NUM_LINES, "%s read %zu lines instead of %d", name, lines, NUM_LINES);
+
+	us = MAX(k_cyc_to_us_ceil64(cycles), 1);
+	printf("%s, %zu, %llu, %llu\n", name, lines, (unsigned long long)us,
+	       (unsigned long long)(lines * USEC_PER_SEC / us));
+}
+
+int main(void)
+{
+	int rc;
+
+	rc = fs_mount(&fatfs_mnt);
+	__ASSERT(rc == 0, "fs_mount() failed: %d", rc);
+	ARG_UNUSED(rc);
+
+	create_hosts();
+
+	printf("BOARD: %s\n", CONFIG_BOARD);
+	printf("HOSTS_LINES: %d\n", CONFIG_TEST_HOSTS_LINES);
+	printf("case, lines, time(us), lines/s\n");
+
+	run("fgets", read_fgets);
+	run("getline", read_getline);
+#ifdef CONFIG_POSIX_NETWORKING
+	run("gethostent", read_gethostent);
+#endif
+
+	(void)fs_unmount(&fatfs_mnt);
+
+	printf("PROJECT EXECUTION SUCCESSFUL\n");
+
+	return 0;
+}
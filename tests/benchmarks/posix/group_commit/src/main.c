@@ -0,0 +1,137 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/littlefs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+#define MNTP      "/lfs"
+#define TEST_FILE MNTP "/log.dat"
+
+#define MAX_WRITERS CONFIG_TEST_MAX_WRITERS
+#define COMMITS     CONFIG_TEST_COMMITS
+#define WRITER_PRIO K_PRIO_PREEMPT(1)
+
+FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(lfs_data);
+static struct fs_mount_t lfs_mnt = {
+	.type = FS_LITTLEFS,
+	.fs_data = &lfs_data,
+	.storage_dev = (void *)FIXED_PARTITION_ID(storage_partition),
+	.mnt_point = MNTP,
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_WRITERS, CONFIG_TEST_STACK_SIZE);
+static struct k_thread threads[MAX_WRITERS];
+static K_SEM_DEFINE(start, 0, MAX_WRITERS);
+
+static int fd;
+static atomic_t errors;
+static uint64_t latency[MAX_WRITERS];
+static uint32_t max_latency[MAX_WRITERS];
+
+static void writer(void *p1, void *p2, void *p3)
+{
+	uint32_t begin;
+	uint32_t cycles;
+	int id = POINTER_TO_INT(p1);
+	uint8_t record[CONFIG_TEST_RECORD_SIZE];
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	memset(record, 'a' + id, sizeof(record));
+
+	(void)k_sem_take(&start, K_FOREVER);
+
+	for (int i = 0; i < COMMITS; ++i) {
+		begin = k_cycle_get_32();
+		if ((write(fd, record, sizeof(record)) != sizeof(record)) || (fdatasync(fd) != 0)) {
+			(void)atomic_inc(&errors);
+		}
+		cycles = k_cycle_get_32() - begin;
+
+		latency[id] += cycles;
+		max_latency[id] = MAX(max_latency[id], cycles);
+	}
+}
+
+static void run(int n)
+{
+	uint32_t begin;
+	uint64_t elapsed;
+	uint64_t total = 0;
+	uint32_t max = 0;
+
+	fd = open(TEST_FILE, O_CREAT | O_TRUNC | O_WRONLY | O_APPEND, 0660);
+	__ASSERT(fd >= 0, "open() failed: %d", errno);
+
+	for (int i = 0; i < n; ++i) {
+		latency[i] = 0;
+		max_latency[i] = 0;
+		k_thread_create(&threads[i], stacks[i], K_THREAD_STACK_SIZEOF(stacks[i]), writer,
+				INT_TO_POINTER(i), NULL, NULL, WRITER_PRIO, 0, K_NO_WAIT);
+	}
+
+	begin = k_cycle_get_32();
+	for (int i = 0; i < n; ++i) {
+		k_sem_give(&start);
+	}
+
+	for (int i = 0; i < n; ++i) {
+		(void)k_thread_join(&threads[i], K_FOREVER);
+		total += latency[i];
+		max = MAX(max, max_latency[i]);
+	}
+	elapsed = k_cyc_to_us_ceil64(k_cycle_get_32() - begin);
+
+	(void)close(fd);
+	(void)unlink(TEST_FILE);
+
+	printf("%d, %d, %llu, %llu, %llu\n", n, n * COMMITS,
+	       (unsigned long long)k_cyc_to_us_floor64(total / (n * COMMITS)),
+	       (unsigned long long)k_cyc_to_us_floor64(max),
+	       (unsigned long long)((uint64_t)n * COMMITS * USEC_PER_SEC / MAX(elapsed, 1)));
+}
+
+int main(void)
+{
+	int rc;
+
+	rc = fs_mount(&lfs_mnt);
+	__ASSERT(rc == 0, "fs_mount() failed: %d", rc);
+	ARG_UNUSED(rc);
+
+	printf("BOARD: %s\n", CONFIG_BOARD);
+	printf("GROUP_COMMIT: %c\n",
+	       IS_ENABLED(CONFIG_POSIX_SYNCHRONIZED_IO_GROUP_COMMIT) ? 'y' : 'n');
+	printf("COMMITS: %d\n", COMMITS);
+	printf("RECORD_SIZE: %d\n", CONFIG_TEST_RECORD_SIZE);
+	printf("writers, commits, mean latency(us), max latency(us), commits/s\n");
+
+	for (int n = 1; n <= MAX_WRITERS; n *= 2) {
+		run(n);
+	}
+
+	(void)fs_unmount(&lfs_mnt);
+
+	if (atomic_get(&errors) != 0) {
+		printf("%d commits failed\n", (int)atomic_get(&errors));
+		return 0;
+	}
+
+	printf("PROJECT EXECUTION SUCCESSFUL\n");
+
+	return 0;
+}
@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+static void *thread_fun(void *arg)
+{
+	return arg;
+}
+
+static uint64_t time_create(size_t guardsize)
+{
+	int ret;
+	pthread_t th;
+	uint32_t begin;
+	uint32_t end;
+	pthread_attr_t attr;
+
+	ret = pthread_attr_init(&attr);
+	__ASSERT(ret == 0, "pthread_attr_init() failed: %d", ret);
+	ret = pthread_attr_setstacksize(&attr, CONFIG_TEST_STACK_SIZE);
+	__ASSERT(ret == 0, "pthread_attr_setstacksize() failed: %d", ret);
+	ret = pthread_attr_setguardsize(&attr, guardsize);
+	__ASSERT(ret == 0, "pthread_attr_setguardsize() failed: %d", ret);
+
+	begin = k_cycle_get_32();
+	for (int i = 0; i < CONFIG_TEST_ITERATIONS; ++i) {
+		ret = pthread_create(&th, &attr, thread_fun, NULL);
+		__ASSERT(ret == 0, "pthread_create() failed: %d", ret);
+		ret = pthread_join(th, NULL);
+		__ASSERT(ret == 0, "pthread_join() failed: %d", ret);
+	}
+	end = k_cycle_get_32();
+
+	(void)pthread_attr_destroy(&attr);
+	ARG_UNUSED(ret);
+
+	return end - begin;
+}
+
+static void print(const char *operation, uint32_t count, uint64_t cycles)
+{
+	printf("%s, %u, %llu, %llu\n", operation, count, (unsigned long long)(cycles / count),
+	       (unsigned long long)(k_cyc_to_ns_floor64(cycles) / count));
+}
+
+int main(void)
+{
+	static const size_t guardsizes[] = {0, 256, 4096, 16384};
+	char operation[48];
+
+	printf("BOARD: %s\n", CONFIG_BOARD);
+	printf("GUARD: %s\n", IS_ENABLED(CONFIG_POSIX_THREAD_GUARD) ? "y" : "n");
+	printf("operation, count, cycles/op, ns/op\n");
+
+	ARRAY_FOR_EACH(guardsizes, i) {
+		snprintf(operation, sizeof(operation), "pthread_create+join guard %zu",
+			 guardsizes[i]);
+		print(operation, CONFIG_TEST_ITERATIONS, time_create(guardsizes[i]));
+	}
+
+	printf("PROJECT EXECUTION SUCCESSFUL\n");
+
+	return 0;
+}
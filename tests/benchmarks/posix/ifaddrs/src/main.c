@@ -0,0 +1,180 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <ifaddrs.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+#define TEST_ADDR "192.0.2.1"
+
+#define CHANGER_STACK_SIZE 1024
+#define CHANGER_PRIORITY   K_PRIO_PREEMPT(1)
+
+struct watch {
+	uint32_t changes;
+	uint32_t wakeups;
+	int64_t latency_ms;
+};
+
+static struct net_if *iface;
+static struct net_in_addr addr;
+/* uptime of the last change, in milliseconds */
+static int64_t changed_at;
+static K_SEM_DEFINE(changer_start, 0, 1);
+
+/* add and remove TEST_ADDR on the loopback interface, as a DHCP client or an operator would */
+static void changer(void *p1, void *p2, void *p3)
+{
+	bool present = false;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		(void)k_sem_take(&changer_start, K_FOREVER);
+
+		for (int i = 0; i < CONFIG_TEST_CHANGES; ++i) {
+			k_msleep(CONFIG_TEST_CHANGE_PERIOD_MS);
+
+			changed_at = k_uptime_get();
+			if (present) {
+				(void)net_if_ipv4_addr_rm(iface, &addr);
+			} else {
+				(void)net_if_ipv4_addr_add(iface, &addr, NET_ADDR_MANUAL, 0);
+			}
+			present = !present;
+		}
+	}
+}
+
+K_THREAD_DEFINE(changer_thread, CHANGER_STACK_SIZE, changer, NULL, NULL, NULL, CHANGER_PRIORITY,
+		0, 0);
+
+static bool snapshot_has_addr(void)
+{
+	int rc;
+	bool found = false;
+	struct ifaddrs *ifa;
+
+	rc = getifaddrs(&ifa);
+	__ASSERT(rc == 0, "getifaddrs() failed: %d", errno);
+	ARG_UNUSED(rc);
+
+	for (struct ifaddrs *p = ifa; p != NULL; p = p->ifa_next) {
+		if ((p->ifa_addr != NULL) && (p->ifa_addr->sa_family == AF_INET) &&
+		    (memcmp(&((struct sockaddr_in *)p->ifa_addr)->sin_addr, &addr, sizeof(addr)) ==
+		     0)) {
+			found = true;
+		}
+	}
+
+	freeifaddrs(ifa);
+
+	return found;
+}
+
+/* the baseline: take a snapshot periodically and compare it with the previous one */
+static void watch_poll(struct watch *w)
+{
+	bool now;
+	bool last = false;
+
+	while (w->changes < CONFIG_TEST_CHANGES) {
+		k_msleep(CONFIG_TEST_POLL_PERIOD_MS);
+		++w->wakeups;
+
+		now = snapshot_has_addr();
+		if (now != last) {
+			last = now;
+			++w->changes;
+			w->latency_ms += k_uptime_get() - changed_at;
+		}
+	}
+}
+
+/* block until a change is reported */
+static void watch_notify(struct watch *w)
+{
+	int fd;
+	int rc;
+	ssize_t len;
+	struct if_notification rec[4];
+	struct pollfd pfd = {.events = POLLIN};
+
+	fd = if_notify(IFN_ADDR, 0);
+	__ASSERT(fd >= 0, "if_notify() failed: %d", errno);
+	pfd.fd = fd;
+
+	while (w->changes < CONFIG_TEST_CHANGES) {
+		rc = poll(&pfd, 1, -1);
+		__ASSERT(rc == 1, "poll() failed: %d", errno);
+		ARG_UNUSED(rc);
+		++w->wakeups;
+
+		len = read(fd, rec, sizeof(rec));
+		__ASSERT(len > 0, "read() failed: %d", errno);
+		for (size_t i = 0; i < len / sizeof(rec[0]); ++i) {
+			if (((rec[i].ifn_type == IFN_ADDR_ADD) || (rec[i].ifn_type == IFN_ADDR_DEL)) &&
+			    (memcmp(&rec[i].ifn_addr.sin.sin_addr, &addr, sizeof(addr)) == 0)) {
+				++w->changes;
+				w->latency_ms += k_uptime_get() - changed_at;
+			}
+		}
+	}
+
+	(void)close(fd);
+}
+
+static void run(const char *name, void (*fn)(struct watch *w))
+{
+	uint64_t cycles;
+	struct watch w = {0};
+	k_thread_runtime_stats_t before;
+	k_thread_runtime_stats_t after;
+
+	(void)k_thread_runtime_stats_get(k_current_get(), &before);
+	k_sem_give(&changer_start);
+	fn(&w);
+	(void)k_thread_runtime_stats_get(k_current_get(), &after);
+	cycles = after.execution_cycles - before.execution_cycles;
+
+	printf("%s, %u, %u, %llu, %llu\n", name, w.changes, w.wakeups,
+	       (unsigned long long)k_cyc_to_us_ceil64(cycles),
+	       (unsigned long long)(w.latency_ms / MAX(w.changes, 1)));
+}
+
+int main(void)
+{
+	int rc;
+
+	iface = net_if_get_default();
+	rc = net_addr_pton(NET_AF_INET, TEST_ADDR, &addr);
+	__ASSERT(rc == 0, "net_addr_pton() failed: %d", rc);
+	ARG_UNUSED(rc);
+
+	printf("BOARD: %s\n", CONFIG_BOARD);
+	printf("CHANGE_PERIOD_MS: %d\n", CONFIG_TEST_CHANGE_PERIOD_MS);
+	printf("POLL_PERIOD_MS: %d\n", CONFIG_TEST_POLL_PERIOD_MS);
+	printf("case, changes, wakeups, cpu time(us), mean latency(ms)\n");
+
+	run("poll", watch_poll);
+	run("notify", watch_notify);
+
+	printf("PROJECT EXECUTION SUCCESSFUL\n");
+
+	return 0;
+}
@@ -0,0 +1,90 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#define ITERATIONS CONFIG_TEST_ITERATIONS
+
+static const uint32_t requests_us[] = {
+	10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000,
+};
+
+/* upper bounds of the histogram bins, in ns; the last bin is unbounded */
+static const int64_t bins_ns[] = {
+	0, 1 * NSEC_PER_USEC, 10 * NSEC_PER_USEC, 100 * NSEC_PER_USEC, 1 * NSEC_PER_MSEC,
+};
+
+static uint32_t phase = 1;
+
+/* xorshift32, so that the benchmark does not need an entropy source */
+static uint32_t next_phase(void)
+{
+	phase ^= phase << 13;
+	phase ^= phase >> 17;
+	phase ^= phase << 5;
+
+	return phase;
+}
+
+static void measure(uint32_t request_us)
+{
+	int64_t err;
+	int64_t sum = 0;
+	int64_t min = INT64_MAX;
+	int64_t max = INT64_MIN;
+	uint32_t start;
+	uint32_t hist[ARRAY_SIZE(bins_ns) + 1] = {0};
+	const struct timespec req = {.tv_nsec = request_us * NSEC_PER_USEC};
+
+	for (int i = 0; i < ITERATIONS; ++i) {
+		/* start each sleep at a random phase relative to the system tick */
+		k_busy_wait(next_phase() % k_ticks_to_us_ceil32(1));
+
+		start = k_cycle_get_32();
+		(void)clock_nanosleep(CLOCK_MONOTONIC, 0, &req, NULL);
+		err = (int64_t)k_cyc_to_ns_floor64(k_cycle_get_32() - start) -
+		      request_us * NSEC_PER_USEC;
+
+		sum += err;
+		min = MIN(min, err);
+		max = MAX(max, err);
+
+		size_t bin = 0;
+
+		while ((bin < ARRAY_SIZE(bins_ns)) && (err >= bins_ns[bin])) {
+			++bin;
+		}
+		++hist[bin];
+	}
+
+	printf("%u, %lld, %lld, %lld", request_us, (long long)(min / NSEC_PER_USEC),
+	       (long long)(sum / ITERATIONS / NSEC_PER_USEC), (long long)(max / NSEC_PER_USEC));
+	ARRAY_FOR_EACH(hist, j) {
+		printf(", %u", hist[j]);
+	}
+	printf("\n");
+}
+
+int main(void)
+{
+	printf("BOARD: %s\n", CONFIG_BOARD);
+	printf("PRECISE_SLEEP: %c\n", IS_ENABLED(CONFIG_POSIX_PRECISE_SLEEP) ? 'y' : 'n');
+	printf("TICKS_PER_SEC: %d\n", CONFIG_SYS_CLOCK_TICKS_PER_SEC);
+	printf("ITERATIONS: %d\n", ITERATIONS);
+	printf("request(us), min(us), mean(us), max(us), early, <1us, <10us, <100us, <1ms, >=1ms\n");
+
+	ARRAY_FOR_EACH(requests_us, i) {
+		measure(requests_us[i]);
+	}
+
+	printf("PROJECT EXECUTION SUCCESSFUL\n");
+
+	return 0;
+}
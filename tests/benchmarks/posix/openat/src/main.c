@@ -0,0 +1,154 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <ff.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+#define MNTP "/RAM:"
+
+#define NUM_OPENS (CONFIG_TEST_FILES * CONFIG_TEST_ITERATIONS)
+
+static FATFS fat_fs;
+static struct fs_mount_t fatfs_mnt = {
+	.type = FS_FATFS,
+	.mnt_point = MNTP,
+	.fs_data = &fat_fs,
+};
+
+static char dir_path[PATH_MAX];
+
+static void file_name(char *buf, size_t size, int i)
+{
+	snprintf(buf, size, "f%02d.dat", i);
+}
+
+static void create_tree(void)
+{
+	int rc;
+	int dir_fd;
+	size_t len = sizeof(MNTP) - 1;
+	char name[16];
+
+	strcpy(dir_path, MNTP);
+	for (int i = 0; i < CONFIG_TEST_DEPTH; ++i) {
+		len += snprintf(&dir_path[len], sizeof(dir_path) - len, "/d%d", i);
+		rc = mkdir(dir_path, 0770);
+		__ASSERT(rc == 0, "mkdir() failed: %d", errno);
+	}
+
+	dir_fd = open(dir_path, O_RDONLY | O_DIRECTORY);
+	__ASSERT(dir_fd >= 0, "open() failed: %d", errno);
+
+	for (int i = 0; i < CONFIG_TEST_FILES; ++i) {
+		file_name(name, sizeof(name), i);
+		rc = openat(dir_fd, name, O_CREAT | O_WRONLY, 0660);
+		__ASSERT(rc >= 0, "openat() failed: %d", errno);
+		(void)close(rc);
+	}
+
+	(void)close(dir_fd);
+}
+
+static void open_absolute(void)
+{
+	int fd;
+	char path[PATH_MAX];
+
+	for (int i = 0; i < CONFIG_TEST_FILES; ++i) {
+		snprintf(path, sizeof(path), "%s/f%02d.dat", dir_path, i);
+		fd = open(path, O_RDONLY);
+		__ASSERT(fd >= 0, "open() failed: %d", errno);
+		(void)close(fd);
+	}
+}
+
+static void open_at(void)
+{
+	int fd;
+	int dir_fd;
+	char name[16];
+
+	dir_fd = open(dir_path, O_RDONLY | O_DIRECTORY);
+	__ASSERT(dir_fd >= 0, "open() failed: %d", errno);
+
+	for (int i = 0; i < CONFIG_TEST_FILES; ++i) {
+		file_name(name, sizeof(name), i);
+		fd = openat(dir_fd, name, O_RDONLY);
+		__ASSERT(fd >= 0, "openat() failed: %d", errno);
+		(void)close(fd);
+	}
+
+	(void)close(dir_fd);
+}
+
+static void open_cwd(void)
+{
+	int fd;
+	char name[16];
+
+	for (int i = 0; i < CONFIG_TEST_FILES; ++i) {
+		file_name(name, sizeof(name), i);
+		fd = open(name, O_RDONLY);
+		__ASSERT(fd >= 0, "open() failed: %d", errno);
+		(void)close(fd);
+	}
+}
+
+static void run(const char *name, void (*fn)(void))
+{
+	uint64_t us;
+	uint32_t start;
+	uint32_t cycles;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < CONFIG_TEST_ITERATIONS; ++i) {
+		fn();
+	}
+	cycles = k_cycle_get_32() - start;
+
+	us = k_cyc_to_us_ceil64(cycles);
+	printf("%s, %d, %llu, %llu\n", name, NUM_OPENS, (unsigned long long)us,
+	       (unsigned long long)(k_cyc_to_ns_ceil64(cycles) / NUM_OPENS));
+}
+
+int main(void)
+{
+	int rc;
+
+	rc = fs_mount(&fatfs_mnt);
+	__ASSERT(rc == 0, "fs_mount() failed: %d", rc);
+	ARG_UNUSED(rc);
+
+	create_tree();
+
+	printf("BOARD: %s\n", CONFIG_BOARD);
+	printf("DEPTH: %d\n", CONFIG_TEST_DEPTH);
+	printf("FILES: %d\n", CONFIG_TEST_FILES);
+	printf("PATH: %s\n", dir_path);
+	printf("case, opens, time(us), time per open(ns)\n");
+
+	run("absolute", open_absolute);
+	run("openat", open_at);
+	(void)chdir(dir_path);
+	run("cwd", open_cwd);
+	(void)chdir("/");
+
+	(void)fs_unmount(&fatfs_mnt);
+
+	printf("PROJECT EXECUTION SUCCESSFUL\n");
+
+	return 0;
+}
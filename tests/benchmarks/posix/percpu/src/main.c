@@ -0,0 +1,157 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+#include "percpu_priv.h"
+
+#define PRIO       K_PRIO_PREEMPT(1)
+#define STACK_SIZE 1024
+
+enum mode {
+	MODE_SHARED,
+	MODE_PERCPU,
+	MODE_PINNED,
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static struct k_thread threads[CONFIG_MP_MAX_NUM_CPUS];
+
+static atomic_t go;
+static atomic_t shared_counter;
+static atomic_t *percpu_counter;
+static uint64_t *pinned_counter;
+
+static void adder(void *p1, void *p2, void *p3)
+{
+	enum mode mode = POINTER_TO_UINT(p1);
+	unsigned int key;
+	uint64_t *count;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* start at the same time as the other threads, so that they contend */
+	while (!atomic_get(&go)) {
+		arch_spin_relax();
+	}
+
+	for (int i = 0; i < CONFIG_TEST_ITERATIONS; ++i) {
+		switch (mode) {
+		case MODE_SHARED:
+			(void)atomic_inc(&shared_counter);
+			break;
+		case MODE_PERCPU:
+			posix_percpu_add(percpu_counter, 1);
+			break;
+		case MODE_PINNED:
+			count = posix_percpu_pin(pinned_counter, &key);
+			++*count;
+			posix_percpu_unpin(key);
+			break;
+		}
+	}
+}
+
+static uint64_t run(enum mode mode, unsigned int nthreads)
+{
+	uint32_t begin;
+	uint32_t end;
+
+	atomic_clear(&go);
+	for (unsigned int i = 0; i < nthreads; ++i) {
+		k_thread_create(&threads[i], stacks[i], K_THREAD_STACK_SIZEOF(stacks[i]), adder,
+				UINT_TO_POINTER(mode), NULL, NULL, PRIO, 0, K_NO_WAIT);
+	}
+	/* let them spin on the other CPUs */
+	k_msleep(10);
+
+	begin = k_cycle_get_32();
+	atomic_set(&go, 1);
+	for (unsigned int i = 0; i < nthreads; ++i) {
+		(void)k_thread_join(&threads[i], K_FOREVER);
+	}
+	end = k_cycle_get_32();
+
+	return end - begin;
+}
+
+static uint64_t pinned_sum(void)
+{
+	uint64_t sum = 0;
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); ++cpu) {
+		sum += *(uint64_t *)posix_percpu_get(pinned_counter, cpu);
+	}
+
+	return sum;
+}
+
+static void print(const char *operation, uint32_t count, uint64_t cycles)
+{
+	printf("%s, %u, %llu, %llu\n", operation, count, (unsigned long long)(cycles / count),
+	       (unsigned long long)(k_cyc_to_ns_floor64(cycles) / count));
+}
+
+static void bench(enum mode mode, const char *name, unsigned int nthreads)
+{
+	char operation[32];
+	uint64_t cycles;
+
+	atomic_clear(&shared_counter);
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); ++cpu) {
+		atomic_clear(posix_percpu_get(percpu_counter, cpu));
+		*(uint64_t *)posix_percpu_get(pinned_counter, cpu) = 0;
+	}
+
+	cycles = run(mode, nthreads);
+
+	__ASSERT(atomic_get(&shared_counter) + posix_percpu_sum(percpu_counter) + pinned_sum() ==
+			 (uint64_t)nthreads * CONFIG_TEST_ITERATIONS,
+		 "increments were lost");
+
+	/* the threads run in parallel, so this is the wall time of an increment of each */
+	snprintf(operation, sizeof(operation), "%s x%u", name, nthreads);
+	print(operation, CONFIG_TEST_ITERATIONS, cycles);
+}
+
+int main(void)
+{
+	static const struct {
+		enum mode mode;
+		const char *name;
+	} modes[] = {
+		{MODE_SHARED, "shared atomic"},
+		{MODE_PERCPU, "per-cpu atomic"},
+		{MODE_PINNED, "per-cpu pinned"},
+	};
+
+	percpu_counter = posix_percpu_alloc(sizeof(atomic_t), __alignof__(atomic_t));
+	pinned_counter = posix_percpu_alloc(sizeof(uint64_t), __alignof__(uint64_t));
+	__ASSERT_NO_MSG((percpu_counter != NULL) && (pinned_counter != NULL));
+
+	printf("BOARD: %s\n", CONFIG_BOARD);
+	printf("CPUS: %u\n", arch_num_cpus());
+	printf("operation, count, cycles/op, ns/op\n");
+
+	/* the main thread only waits, so every other thread gets a CPU of its own */
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(0));
+
+	ARRAY_FOR_EACH(modes, m) {
+		/* one thread alone is the cost without contention */
+		bench(modes[m].mode, modes[m].name, 1);
+		bench(modes[m].mode, modes[m].name, arch_num_cpus());
+	}
+
+	printf("PROJECT EXECUTION SUCCESSFUL\n");
+
+	return 0;
+}
@@ -0,0 +1,87 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <regex.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+static const char *const log_lines[] = {
+	"2024-05-01T12:00:01 gw0 kernel: INFO eth0: link up, 100Mbps full duplex",
+	"2024-05-01T12:00:02 gw0 dhcpc: INFO lease of 192.168.1.23 obtained, lease time 86400",
+	"2024-05-01T12:00:07 gw0 sensor: DEBUG temperature 23.5C humidity 41%",
+	"2024-05-01T12:01:13 gw0 mqtt: WARN broker 10.0.0.2:1883 unreachable, retrying in 5s",
+	"2024-05-01T12:01:18 gw0 mqtt: ERROR connect to 10.0.0.2:1883 timed out after 5000 ms",
+	"2024-05-01T12:01:19 gw0 sensor: DEBUG temperature 23.6C humidity 40%",
+	"2024-05-01T12:02:00 gw0 ota: INFO image 1.4.2 verified, rebooting in 10s",
+	"2024-05-01T12:02:11 gw0 kernel: ERROR flash write failed at 0x0801f000: -5",
+};
+
+static char aaa_line[81];
+
+static void run(const char *name, const char *pattern, int cflags, const char *const *lines,
+		size_t nlines, size_t expect)
+{
+	int rc;
+	uint64_t us;
+	regex_t re;
+	regmatch_t m[4];
+	uint32_t start;
+	uint32_t cycles;
+	size_t bytes = 0;
+	size_t matches = 0;
+
+	rc = regcomp(&re, pattern, cflags);
+	__ASSERT(rc == 0, "%s: regcomp() returned %d", name, rc);
+
+	for (size_t j = 0; j < nlines; ++j) {
+		bytes += strlen(lines[j]);
+	}
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < CONFIG_TEST_ITERATIONS; ++i) {
+		for (size_t j = 0; j < nlines; ++j) {
+			if (regexec(&re, lines[j], ARRAY_SIZE(m), m, 0) == 0) {
+				++matches;
+			}
+		}
+	}
+	cycles = k_cycle_get_32() - start;
+	__ASSERT(matches == expect * CONFIG_TEST_ITERATIONS, "%s: %zu matches", name, matches);
+	ARG_UNUSED(rc);
+	ARG_UNUSED(expect);
+
+	regfree(&re);
+
+	bytes *= CONFIG_TEST_ITERATIONS;
+	us = MAX(k_cyc_to_us_ceil64(cycles), 1);
+	printf("%s, %zu, %zu, %llu, %llu\n", name, nlines * CONFIG_TEST_ITERATIONS, bytes,
+	       (unsigned long long)us, (unsigned long long)((uint64_t)bytes * USEC_PER_SEC / us));
+}
+
+int main(void)
+{
+	const char *const aaa[] = {aaa_line};
+
+	memset(aaa_line, 'a', sizeof(aaa_line) - 1);
+
+	printf("BOARD: %s\n", CONFIG_BOARD);
+	printf("DFA_CACHE_SIZE: %d\n", CONFIG_POSIX_REGEXP_DFA_CACHE_SIZE);
+	printf("case, lines, bytes, time(us), bytes/s\n");
+
+	run("literal", "timed out", REG_NOSUB, log_lines, ARRAY_SIZE(log_lines), 1);
+	run("alternation", "^[^ ]+ [^ ]+ [a-z]+: (WARN|ERROR) ", REG_EXTENDED | REG_NOSUB, log_lines,
+	    ARRAY_SIZE(log_lines), 3);
+	run("fields", "^([0-9T:-]+) ([[:alnum:]]+) [a-z]+: (.*)$", REG_EXTENDED, log_lines,
+	    ARRAY_SIZE(log_lines), ARRAY_SIZE(log_lines));
+	run("pathological", "(a|aa)*b", REG_EXTENDED, aaa, ARRAY_SIZE(aaa), 0);
+
+	printf("PROJECT EXECUTION SUCCESSFUL\n");
+
+	return 0;
+}
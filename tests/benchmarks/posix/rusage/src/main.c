@@ -0,0 +1,136 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* for RUSAGE_THREAD */
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/resource.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+#define PRIO       K_PRIO_PREEMPT(1)
+#define STACK_SIZE 1024
+
+static K_THREAD_STACK_DEFINE(partner_stack, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(idle_stacks, CONFIG_TEST_THREADS, STACK_SIZE);
+static struct k_thread partner_thread;
+static struct k_thread idle_threads[CONFIG_TEST_THREADS];
+static K_SEM_DEFINE(idle_sem, 0, CONFIG_TEST_THREADS);
+
+static volatile bool stop;
+
+static void partner(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!stop) {
+		k_yield();
+	}
+}
+
+static void idle(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	(void)k_sem_take(&idle_sem, K_FOREVER);
+}
+
+static void print(const char *operation, uint32_t count, uint64_t cycles)
+{
+	printf("%s, %u, %llu, %llu\n", operation, count, (unsigned long long)(cycles / count),
+	       (unsigned long long)(k_cyc_to_ns_floor64(cycles) / count));
+}
+
+static uint64_t time_switches(void)
+{
+	uint32_t begin;
+	uint32_t end;
+
+	stop = false;
+	k_thread_create(&partner_thread, partner_stack, K_THREAD_STACK_SIZEOF(partner_stack),
+			partner, NULL, NULL, NULL, PRIO, 0, K_NO_WAIT);
+
+	/* each yield switches to the partner and back */
+	begin = k_cycle_get_32();
+	for (int i = 0; i < CONFIG_TEST_SWITCHES / 2; ++i) {
+		k_yield();
+	}
+	end = k_cycle_get_32();
+
+	stop = true;
+	(void)k_thread_join(&partner_thread, K_FOREVER);
+
+	return end - begin;
+}
+
+static uint64_t time_getrusage(int who)
+{
+	int ret;
+	uint32_t begin;
+	uint32_t end;
+	struct rusage ru;
+
+	begin = k_cycle_get_32();
+	for (int i = 0; i < CONFIG_TEST_CALLS; ++i) {
+		ret = getrusage(who, &ru);
+		__ASSERT(ret == 0, "getrusage() failed: %d", errno);
+		ARG_UNUSED(ret);
+	}
+	end = k_cycle_get_32();
+
+	return end - begin;
+}
+
+int main(void)
+{
+	struct rusage ru;
+
+	printf("BOARD: %s\n", CONFIG_BOARD);
+	printf("CSW: %s\n", IS_ENABLED(CONFIG_XSI_RUSAGE_CSW) ? "y" : "n");
+	printf("STACK: %s\n", IS_ENABLED(CONFIG_XSI_RUSAGE_STACK) ? "y" : "n");
+	printf("HEAP: %s\n", IS_ENABLED(CONFIG_XSI_RUSAGE_HEAP) ? "y" : "n");
+	printf("THREADS: %d\n", CONFIG_TEST_THREADS);
+	printf("operation, count, cycles/op, ns/op\n");
+
+	k_thread_priority_set(k_current_get(), PRIO);
+
+	print("context switch", CONFIG_TEST_SWITCHES, time_switches());
+
+	ARRAY_FOR_EACH(idle_threads, i) {
+		k_thread_create(&idle_threads[i], idle_stacks[i], K_THREAD_STACK_SIZEOF(idle_stacks[i]),
+				idle, NULL, NULL, NULL, PRIO, 0, K_NO_WAIT);
+	}
+	/* let them block */
+	k_msleep(1);
+
+	print("getrusage(RUSAGE_SELF)", CONFIG_TEST_CALLS, time_getrusage(RUSAGE_SELF));
+	print("getrusage(RUSAGE_THREAD)", CONFIG_TEST_CALLS, time_getrusage(RUSAGE_THREAD));
+
+	ARRAY_FOR_EACH(idle_threads, i) {
+		k_sem_give(&idle_sem);
+	}
+	ARRAY_FOR_EACH_PTR(idle_threads, th) {
+		(void)k_thread_join(th, K_FOREVER);
+	}
+
+	(void)getrusage(RUSAGE_SELF, &ru);
+	printf("ru_nvcsw: %ld\n", ru.ru_nvcsw);
+	printf("ru_nivcsw: %ld\n", ru.ru_nivcsw);
+	printf("ru_maxrss: %ld\n", ru.ru_maxrss);
+
+	printf("PROJECT EXECUTION SUCCESSFUL\n");
+
+	return 0;
+}
@@ -0,0 +1,90 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+#define NUM_THREADS CONFIG_TEST_NUM_THREADS
+#define NUM_CPUS    CONFIG_MP_MAX_NUM_CPUS
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, CONFIG_TEST_STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+
+static pthread_rwlock_t rwlocks[NUM_THREADS];
+static uint64_t counters[NUM_THREADS];
+static volatile bool stop;
+
+static void locker(void *p1, void *p2, void *p3)
+{
+	int ret;
+	int i = POINTER_TO_INT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!stop) {
+		ret = pthread_rwlock_rdlock(&rwlocks[i]);
+		__ASSERT(ret == 0, "pthread_rwlock_rdlock() failed: %d", ret);
+		ret = pthread_rwlock_unlock(&rwlocks[i]);
+		__ASSERT(ret == 0, "pthread_rwlock_unlock() failed: %d", ret);
+		ret = pthread_rwlock_wrlock(&rwlocks[i]);
+		__ASSERT(ret == 0, "pthread_rwlock_wrlock() failed: %d", ret);
+		ret = pthread_rwlock_unlock(&rwlocks[i]);
+		__ASSERT(ret == 0, "pthread_rwlock_unlock() failed: %d", ret);
+		ARG_UNUSED(ret);
+
+		/* each iteration resolves the handle four times */
+		counters[i] += 4;
+
+		if (!IS_ENABLED(CONFIG_SMP)) {
+			/* let the other threads interleave with this one */
+			k_yield();
+		}
+	}
+}
+
+int main(void)
+{
+	int ret;
+	uint64_t ops = 0;
+
+	printf("BOARD: %s\n", CONFIG_BOARD);
+	printf("NUM_THREADS: %d\n", NUM_THREADS);
+	printf("NUM_CPUS: %d\n", NUM_CPUS);
+	printf("TEST_DURATION_S: %d\n", CONFIG_TEST_DURATION_S);
+	printf("threads, time(s), lock operations, cores, rate (operations/s/core)\n");
+
+	for (int i = 0; i < NUM_THREADS; ++i) {
+		ret = pthread_rwlock_init(&rwlocks[i], NULL);
+		__ASSERT(ret == 0, "pthread_rwlock_init() failed: %d", ret);
+		ARG_UNUSED(ret);
+	}
+
+	for (int i = 0; i < NUM_THREADS; ++i) {
+		k_thread_create(&threads[i], stacks[i], K_THREAD_STACK_SIZEOF(stacks[i]), locker,
+				INT_TO_POINTER(i), NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	k_sleep(K_SECONDS(CONFIG_TEST_DURATION_S));
+	stop = true;
+
+	for (int i = 0; i < NUM_THREADS; ++i) {
+		(void)k_thread_join(&threads[i], K_FOREVER);
+		(void)pthread_rwlock_destroy(&rwlocks[i]);
+		ops += counters[i];
+	}
+
+	printf("%d, %d, %llu, %d, %llu\n", NUM_THREADS, CONFIG_TEST_DURATION_S,
+	       (unsigned long long)ops, NUM_CPUS,
+	       (unsigned long long)(ops / CONFIG_TEST_DURATION_S / NUM_CPUS));
+
+	printf("PROJECT EXECUTION SUCCESSFUL\n");
+
+	return 0;
+}
@@ -0,0 +1,198 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* for sched_rr_set_interval_np() */
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+#define NUM_THREADS CONFIG_TEST_THREADS
+
+struct slice_stats {
+	uint32_t slices;
+	uint32_t min;
+	uint32_t max;
+	uint64_t sum;
+	/* sum of the squares of slice lengths in us, for the standard deviation */
+	uint64_t sum_sq_us;
+	/* total cycles run, including partial slices */
+	uint64_t run;
+};
+
+static const uint32_t intervals_ms[] = {1, 2, 5, 10};
+
+static struct slice_stats stats[NUM_THREADS];
+static uint32_t gap_cycles;
+static volatile bool stop;
+
+static void *spinner(void *arg)
+{
+	bool first = true;
+	uint32_t now;
+	uint32_t slice;
+	uint32_t last = k_cycle_get_32();
+	uint32_t start = last;
+	struct slice_stats *st = arg;
+
+	while (!stop) {
+		now = k_cycle_get_32();
+		if (now - last > gap_cycles) {
+			/* another thread ran since the last sample, so a slice ended at last */
+			slice = last - start;
+			st->run += slice;
+			/* the first slice started when the thread was created */
+			if (!first) {
+				uint64_t us = k_cyc_to_us_floor64(slice);
+
+				++st->slices;
+				st->min = MIN(st->min, slice);
+				st->max = MAX(st->max, slice);
+				st->sum += slice;
+				st->sum_sq_us += us * us;
+			}
+			first = false;
+			start = now;
+		}
+		last = now;
+	}
+	st->run += last - start;
+
+	return NULL;
+}
+
+static uint64_t isqrt(uint64_t x)
+{
+	uint64_t r = 0;
+	uint64_t bit = BIT64(62);
+
+	while (bit > x) {
+		bit >>= 2;
+	}
+
+	while (bit != 0) {
+		if (x >= r + bit) {
+			x -= r + bit;
+			r = (r >> 1) + bit;
+		} else {
+			r >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return r;
+}
+
+static void measure(int prio)
+{
+	pthread_t th[NUM_THREADS];
+	pthread_attr_t attr;
+	struct timespec interval;
+	struct sched_param param = {.sched_priority = prio};
+	uint32_t slices = 0;
+	uint32_t min = UINT32_MAX;
+	uint32_t max = 0;
+	uint64_t sum = 0;
+	uint64_t sum_sq_us = 0;
+	uint64_t total = 0;
+	uint64_t min_run = UINT64_MAX;
+	uint64_t max_run = 0;
+	uint64_t mean_us;
+	uint64_t mean_sq_us;
+	int ret;
+
+	ret = sched_rr_get_interval_np(prio, &interval);
+	__ASSERT(ret == 0, "sched_rr_get_interval_np() failed: %d", errno);
+	ARG_UNUSED(ret);
+
+	/* a gap of half an interval means that another thread ran */
+	gap_cycles = k_ns_to_cyc_floor32(interval.tv_sec * NSEC_PER_SEC + interval.tv_nsec) / 2;
+
+	(void)pthread_attr_init(&attr);
+	(void)pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+	(void)pthread_attr_setschedpolicy(&attr, SCHED_RR);
+	(void)pthread_attr_setschedparam(&attr, &param);
+
+	stop = false;
+	for (int i = 0; i < NUM_THREADS; ++i) {
+		stats[i] = (struct slice_stats){.min = UINT32_MAX};
+		ret = pthread_create(&th[i], &attr, spinner, &stats[i]);
+		__ASSERT(ret == 0, "pthread_create() failed: %d", ret);
+	}
+	(void)pthread_attr_destroy(&attr);
+
+	k_msleep(CONFIG_TEST_DURATION_MS);
+	stop = true;
+
+	for (int i = 0; i < NUM_THREADS; ++i) {
+		(void)pthread_join(th[i], NULL);
+
+		slices += stats[i].slices;
+		min = MIN(min, stats[i].min);
+		max = MAX(max, stats[i].max);
+		sum += stats[i].sum;
+		sum_sq_us += stats[i].sum_sq_us;
+		total += stats[i].run;
+		min_run = MIN(min_run, stats[i].run);
+		max_run = MAX(max_run, stats[i].run);
+	}
+
+	if (slices == 0) {
+		printf("%llu, 0, 0, 0, 0, 0, 0, 0\n",
+		       (unsigned long long)(interval.tv_sec * USEC_PER_SEC +
+					    interval.tv_nsec / NSEC_PER_USEC));
+		return;
+	}
+
+	mean_us = k_cyc_to_us_floor64(sum / slices);
+	mean_sq_us = sum_sq_us / slices;
+	printf("%llu, %u, %llu, %llu, %llu, %llu, %llu, %llu\n",
+	       (unsigned long long)(interval.tv_sec * USEC_PER_SEC +
+				    interval.tv_nsec / NSEC_PER_USEC),
+	       slices, (unsigned long long)k_cyc_to_us_floor64(min), (unsigned long long)mean_us,
+	       (unsigned long long)k_cyc_to_us_floor64(max),
+	       (unsigned long long)isqrt(mean_sq_us - MIN(mean_us * mean_us, mean_sq_us)),
+	       (unsigned long long)(min_run * 100 / MAX(total, 1)),
+	       (unsigned long long)(max_run * 100 / MAX(total, 1)));
+}
+
+int main(void)
+{
+	const int prio = sched_get_priority_min(SCHED_RR);
+
+	printf("BOARD: %s\n", CONFIG_BOARD);
+	printf("TIMESLICE_PER_THREAD: %c\n", IS_ENABLED(CONFIG_TIMESLICE_PER_THREAD) ? 'y' : 'n');
+	printf("TICKS_PER_SEC: %d\n", CONFIG_SYS_CLOCK_TICKS_PER_SEC);
+	printf("THREADS: %d\n", NUM_THREADS);
+	printf("interval(us), slices, min(us), mean(us), max(us), jitter(us), min share(%%), "
+	       "max share(%%)\n");
+
+	if (!IS_ENABLED(CONFIG_TIMESLICE_PER_THREAD)) {
+		measure(prio);
+	} else {
+		ARRAY_FOR_EACH(intervals_ms, i) {
+			const struct timespec ts = {.tv_nsec = intervals_ms[i] * NSEC_PER_MSEC};
+			int ret = sched_rr_set_interval_np(prio, &ts);
+
+			__ASSERT(ret == 0, "sched_rr_set_interval_np() failed: %d", errno);
+			ARG_UNUSED(ret);
+
+			measure(prio);
+		}
+	}
+
+	printf("PROJECT EXECUTION SUCCESSFUL\n");
+
+	return 0;
+}
@@ -0,0 +1,226 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+
+#include <ff.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+#define MNTP      "/RAM:"
+#define TEST_FILE MNTP "/image.bin"
+
+#define CHUNK_SIZE CONFIG_SENDFILE_BUFFER_SIZE
+#define NUM_BYTES  ((uint64_t)CONFIG_TEST_FILE_SIZE * CONFIG_TEST_ITERATIONS)
+
+#define SINK_STACK_SIZE 2048
+#define SINK_PRIORITY   K_PRIO_PREEMPT(1)
+
+static FATFS fat_fs;
+static struct fs_mount_t fatfs_mnt = {
+	.type = FS_FATFS,
+	.mnt_point = MNTP,
+	.fs_data = &fat_fs,
+};
+
+static int listen_sock;
+static uint16_t port;
+static uint64_t received;
+static uint8_t buf[CHUNK_SIZE];
+static K_SEM_DEFINE(sink_done, 0, 1);
+
+static void create_file(void)
+{
+	int fd;
+	ssize_t ret;
+
+	for (size_t i = 0; i < sizeof(buf); ++i) {
+		buf[i] = (uint8_t)i;
+	}
+
+	fd = open(TEST_FILE, O_CREAT | O_TRUNC | O_WRONLY, 0660);
+	__ASSERT(fd >= 0, "open() failed: %d", errno);
+
+	for (size_t off = 0; off < CONFIG_TEST_FILE_SIZE; off += ret) {
+		ret = write(fd, buf, MIN(sizeof(buf), CONFIG_TEST_FILE_SIZE - off));
+		__ASSERT(ret > 0, "write() failed: %d", errno);
+	}
+
+	(void)close(fd);
+}
+
+static void create_listener(void)
+{
+	int rc;
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+	};
+	socklen_t addrlen = sizeof(addr);
+
+	listen_sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	__ASSERT(listen_sock >= 0, "socket() failed: %d", errno);
+
+	rc = bind(listen_sock, (struct sockaddr *)&addr, sizeof(addr));
+	__ASSERT(rc == 0, "bind() failed: %d", errno);
+	rc = listen(listen_sock, 1);
+	__ASSERT(rc == 0, "listen() failed: %d", errno);
+	rc = getsockname(listen_sock, (struct sockaddr *)&addr, &addrlen);
+	__ASSERT(rc == 0, "getsockname() failed: %d", errno);
+	ARG_UNUSED(rc);
+
+	port = ntohs(addr.sin_port);
+}
+
+/* accept one connection at a time and discard everything received on it */
+static void sink(void *p1, void *p2, void *p3)
+{
+	int sock;
+	ssize_t ret;
+	static uint8_t sink_buf[1024];
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		sock = accept(listen_sock, NULL, NULL);
+		__ASSERT(sock >= 0, "accept() failed: %d", errno);
+
+		received = 0;
+		while ((ret = recv(sock, sink_buf, sizeof(sink_buf), 0)) > 0) {
+			received += ret;
+		}
+
+		(void)close(sock);
+		k_sem_give(&sink_done);
+	}
+}
+
+/* started once the listening socket exists */
+K_THREAD_DEFINE(sink_thread, SINK_STACK_SIZE, sink, NULL, NULL, NULL, SINK_PRIORITY, 0,
+		SYS_FOREVER_MS);
+
+static int connect_sink(void)
+{
+	int rc;
+	int sock;
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(port),
+		.sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+	};
+
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	__ASSERT(sock >= 0, "socket() failed: %d", errno);
+
+	rc = connect(sock, (struct sockaddr *)&addr, sizeof(addr));
+	__ASSERT(rc == 0, "connect() failed: %d", errno);
+	ARG_UNUSED(rc);
+
+	return sock;
+}
+
+static void send_read_send(int sock, int fd)
+{
+	ssize_t rd;
+	ssize_t wr;
+
+	while ((rd = read(fd, buf, sizeof(buf))) > 0) {
+		for (ssize_t off = 0; off < rd; off += wr) {
+			wr = send(sock, &buf[off], rd - off, 0);
+			__ASSERT(wr > 0, "send() failed: %d", errno);
+		}
+	}
+}
+
+static void send_sendfile(int sock, int fd)
+{
+	ssize_t ret;
+
+	do {
+		ret = sendfile(sock, fd, NULL, CONFIG_TEST_FILE_SIZE);
+		__ASSERT(ret >= 0, "sendfile() failed: %d", errno);
+	} while (ret > 0);
+}
+
+static void send_splice(int sock, int fd)
+{
+	ssize_t ret;
+
+	do {
+		ret = splice(fd, NULL, sock, NULL, CONFIG_TEST_FILE_SIZE, 0);
+		__ASSERT(ret >= 0, "splice() failed: %d", errno);
+	} while (ret > 0);
+}
+
+static void run(const char *name, void (*fn)(int sock, int fd))
+{
+	int fd;
+	int sock;
+	uint64_t us;
+	uint32_t start;
+	uint32_t cycles;
+
+	sock = connect_sink();
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < CONFIG_TEST_ITERATIONS; ++i) {
+		fd = open(TEST_FILE, O_RDONLY);
+		__ASSERT(fd >= 0, "open() failed: %d", errno);
+		fn(sock, fd);
+		(void)close(fd);
+	}
+	(void)close(sock);
+	(void)k_sem_take(&sink_done, K_FOREVER);
+	cycles = k_cycle_get_32() - start;
+
+	__ASSERT(received == NUM_BYTES, "%s sent %llu bytes instead of %llu", name,
+		 (unsigned long long)received, (unsigned long long)NUM_BYTES);
+
+	us = MAX(k_cyc_to_us_ceil64(cycles), 1);
+	printf("%s, %llu, %llu, %llu\n", name, (unsigned long long)received,
+	       (unsigned long long)us, (unsigned long long)(received * USEC_PER_SEC / 1024 / us));
+}
+
+int main(void)
+{
+	int rc;
+
+	rc = fs_mount(&fatfs_mnt);
+	__ASSERT(rc == 0, "fs_mount() failed: %d", rc);
+	ARG_UNUSED(rc);
+
+	create_file();
+	create_listener();
+	k_thread_start(sink_thread);
+
+	printf("BOARD: %s\n", CONFIG_BOARD);
+	printf("FILE_SIZE: %d\n", CONFIG_TEST_FILE_SIZE);
+	printf("CHUNK_SIZE: %d\n", CHUNK_SIZE);
+	printf("case, bytes, time(us), KiB/s\n");
+
+	run("read_send", send_read_send);
+	run("sendfile", send_sendfile);
+	run("splice", send_splice);
+
+	(void)close(listen_sock);
+	(void)fs_unmount(&fatfs_mnt);
+
+	printf("PROJECT EXECUTION SUCCESSFUL\n");
+
+	return 0;
+}
@@ -0,0 +1,152 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/eventfd.h>
+#include <sys/select.h>
+#include <time.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+#define ITERATIONS   CONFIG_TEST_ITERATIONS
+#define KICKER_PRIO  K_PRIO_PREEMPT(0)
+#define MAX_DELAY_US (20 * USEC_PER_MSEC)
+
+static K_THREAD_STACK_DEFINE(kicker_stack, 1024);
+static struct k_thread kicker_thread;
+static K_SEM_DEFINE(armed, 0, 1);
+
+static pthread_t waiter;
+static volatile uint32_t sent;
+static uint32_t phase = 1;
+static int errors;
+
+/* xorshift32, so that the benchmark does not need an entropy source */
+static uint32_t next_phase(void)
+{
+	phase ^= phase << 13;
+	phase ^= phase >> 17;
+	phase ^= phase << 5;
+
+	return phase;
+}
+
+static void handler(int signo)
+{
+	ARG_UNUSED(signo);
+}
+
+static void kicker(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		(void)k_sem_take(&armed, K_FOREVER);
+
+		/* land at a random point in the wait */
+		k_sleep(K_USEC(1 + next_phase() % MAX_DELAY_US));
+
+		sent = k_cycle_get_32();
+		(void)pthread_kill(waiter, SIGUSR1);
+	}
+}
+
+static int wait_ppoll(int fd, const sigset_t *mask)
+{
+	struct pollfd pfd = {.fd = fd, .events = POLLIN};
+	const struct timespec ts = {.tv_sec = 10};
+
+	return ppoll(&pfd, 1, &ts, mask);
+}
+
+static int wait_pselect(int fd, const sigset_t *mask)
+{
+	fd_set readfds;
+	const struct timespec ts = {.tv_sec = 10};
+
+	FD_ZERO(&readfds);
+	FD_SET(fd, &readfds);
+
+	return pselect(fd + 1, &readfds, NULL, NULL, &ts, mask);
+}
+
+static void measure(const char *name, int (*wait)(int fd, const sigset_t *mask), int fd,
+		    const sigset_t *mask)
+{
+	uint32_t cycles;
+	uint64_t sum = 0;
+	uint32_t min = UINT32_MAX;
+	uint32_t max = 0;
+
+	for (int i = 0; i < ITERATIONS; ++i) {
+		k_sem_give(&armed);
+
+		if ((wait(fd, mask) != -1) || (errno != EINTR)) {
+			++errors;
+		}
+		cycles = k_cycle_get_32() - sent;
+
+		sum += cycles;
+		min = MIN(min, cycles);
+		max = MAX(max, cycles);
+	}
+
+	printf("%s, %llu, %llu, %llu\n", name, (unsigned long long)k_cyc_to_us_floor64(min),
+	       (unsigned long long)k_cyc_to_us_floor64(sum / ITERATIONS),
+	       (unsigned long long)k_cyc_to_us_floor64(max));
+}
+
+int main(void)
+{
+	int fd;
+	sigset_t set;
+	sigset_t mask;
+	struct sigaction act = {
+		.sa_handler = handler,
+	};
+
+	fd = eventfd(0, EFD_NONBLOCK);
+	__ASSERT(fd >= 0, "eventfd() failed: %d", errno);
+
+	/* SIGUSR1 is only unblocked while waiting */
+	(void)sigemptyset(&act.sa_mask);
+	(void)sigaction(SIGUSR1, &act, NULL);
+	(void)sigemptyset(&set);
+	(void)sigaddset(&set, SIGUSR1);
+	(void)pthread_sigmask(SIG_BLOCK, &set, &mask);
+	(void)sigdelset(&mask, SIGUSR1);
+
+	waiter = pthread_self();
+	k_thread_create(&kicker_thread, kicker_stack, K_THREAD_STACK_SIZEOF(kicker_stack), kicker,
+			NULL, NULL, NULL, KICKER_PRIO, 0, K_NO_WAIT);
+
+	printf("BOARD: %s\n", CONFIG_BOARD);
+	printf("TICKS_PER_SEC: %d\n", CONFIG_SYS_CLOCK_TICKS_PER_SEC);
+	printf("ITERATIONS: %d\n", ITERATIONS);
+	printf("function, min(us), mean(us), max(us)\n");
+
+	measure("ppoll", wait_ppoll, fd, &mask);
+	measure("pselect", wait_pselect, fd, &mask);
+
+	k_thread_abort(&kicker_thread);
+
+	if (errors != 0) {
+		printf("%d waits were not interrupted\n", errors);
+		return 0;
+	}
+
+	printf("PROJECT EXECUTION SUCCESSFUL\n");
+
+	return 0;
+}
@@ -0,0 +1,162 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* for stream_pipe_np() */
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stropts.h>
+#include <unistd.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+#define BULK_PRIO   K_PRIO_PREEMPT(2)
+#define URGENT_PRIO K_PRIO_PREEMPT(1)
+#define READER_PRIO K_PRIO_PREEMPT(3)
+#define STACK_SIZE  (1024 + CONFIG_TEST_MSG_SIZE)
+
+/* the first byte of the payload tells the traffic of a message apart */
+#define BULK   0
+#define URGENT 1
+
+struct latency {
+	uint32_t messages;
+	uint32_t min;
+	uint32_t max;
+	uint64_t sum;
+};
+
+static K_THREAD_STACK_DEFINE(bulk_stack, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(urgent_stack, STACK_SIZE);
+static struct k_thread bulk_thread;
+static struct k_thread urgent_thread;
+
+static int fds[2];
+static volatile bool stop;
+static struct latency stats[2];
+
+static void send(int band, int flags, char traffic)
+{
+	char payload[CONFIG_TEST_MSG_SIZE] = {traffic};
+	uint32_t stamp = k_cycle_get_32();
+	struct strbuf ctl = {.len = sizeof(stamp), .buf = (char *)&stamp};
+	struct strbuf data = {.len = sizeof(payload), .buf = payload};
+	int ret = putpmsg(fds[1], &ctl, &data, band, flags);
+
+	__ASSERT(ret == 0, "putpmsg() failed: %d", errno);
+	ARG_UNUSED(ret);
+}
+
+static void bulk(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!stop) {
+		send(0, MSG_BAND, BULK);
+	}
+
+	/* tell the reader to stop, ahead of the backlog */
+	send(0, MSG_HIPRI, BULK);
+}
+
+static void urgent(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < CONFIG_TEST_URGENT_MESSAGES; ++i) {
+		k_msleep(CONFIG_TEST_URGENT_PERIOD_MS);
+		send(CONFIG_TEST_URGENT_BAND, MSG_BAND, URGENT);
+	}
+
+	stop = true;
+}
+
+static void print(const char *traffic, int band, const struct latency *st, uint32_t elapsed_us)
+{
+	printf("%s, %d, %u, %llu, %llu, %llu, %llu\n", traffic, band, st->messages,
+	       (unsigned long long)((uint64_t)st->messages * USEC_PER_SEC / MAX(elapsed_us, 1)),
+	       (unsigned long long)k_cyc_to_us_floor64(st->min),
+	       (unsigned long long)k_cyc_to_us_floor64(st->sum / MAX(st->messages, 1)),
+	       (unsigned long long)k_cyc_to_us_floor64(st->max));
+}
+
+int main(void)
+{
+	int ret;
+	int band;
+	int flags;
+	uint32_t stamp;
+	uint32_t begin;
+	uint32_t cycles;
+	uint32_t elapsed_us;
+	struct latency *st;
+	static char payload[CONFIG_TEST_MSG_SIZE];
+	struct strbuf ctl = {.maxlen = sizeof(stamp), .buf = (char *)&stamp};
+	struct strbuf data = {.maxlen = sizeof(payload), .buf = payload};
+
+	printf("BOARD: %s\n", CONFIG_BOARD);
+	printf("BANDS: %d\n", CONFIG_XSI_STREAMS_BANDS);
+	printf("BAND_SIZE: %d\n", CONFIG_XSI_STREAMS_BAND_SIZE);
+	printf("MSG_SIZE: %d\n", CONFIG_TEST_MSG_SIZE);
+	printf("WORK_US: %d\n", CONFIG_TEST_WORK_US);
+	printf("traffic, band, messages, messages/s, min latency(us), mean latency(us), "
+	       "max latency(us)\n");
+
+	ret = stream_pipe_np(fds);
+	__ASSERT(ret == 0, "stream_pipe_np() failed: %d", errno);
+
+	ARRAY_FOR_EACH_PTR(stats, s) {
+		*s = (struct latency){.min = UINT32_MAX};
+	}
+
+	/* the reader runs below both writers, so that band 0 is always full */
+	k_thread_priority_set(k_current_get(), READER_PRIO);
+	k_thread_create(&bulk_thread, bulk_stack, K_THREAD_STACK_SIZEOF(bulk_stack), bulk, NULL,
+			NULL, NULL, BULK_PRIO, 0, K_NO_WAIT);
+	k_thread_create(&urgent_thread, urgent_stack, K_THREAD_STACK_SIZEOF(urgent_stack), urgent,
+			NULL, NULL, NULL, URGENT_PRIO, 0, K_NO_WAIT);
+
+	begin = k_cycle_get_32();
+	while (true) {
+		band = 0;
+		flags = MSG_ANY;
+		ret = getpmsg(fds[0], &ctl, &data, &band, &flags);
+		__ASSERT(ret == 0, "getpmsg() failed: %d", errno);
+		if (flags == MSG_HIPRI) {
+			break;
+		}
+
+		cycles = k_cycle_get_32() - stamp;
+		st = &stats[(data.buf[0] == URGENT) ? 1 : 0];
+		++st->messages;
+		st->min = MIN(st->min, cycles);
+		st->max = MAX(st->max, cycles);
+		st->sum += cycles;
+
+		k_busy_wait(CONFIG_TEST_WORK_US);
+	}
+	elapsed_us = k_cyc_to_us_ceil32(k_cycle_get_32() - begin);
+
+	(void)k_thread_join(&bulk_thread, K_FOREVER);
+	(void)k_thread_join(&urgent_thread, K_FOREVER);
+	(void)close(fds[0]);
+	(void)close(fds[1]);
+
+	print("bulk", 0, &stats[0], elapsed_us);
+	print("urgent", CONFIG_TEST_URGENT_BAND, &stats[1], elapsed_us);
+
+	printf("PROJECT EXECUTION SUCCESSFUL\n");
+
+	return 0;
+}
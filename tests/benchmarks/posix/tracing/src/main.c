@@ -0,0 +1,105 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+#ifdef CONFIG_TRACING_USER
+#include <zephyr/posix/posix_tracing.h>
+
+/* the cheapest hooks an application could have, so that only the cost of the calls is measured */
+void sys_trace_posix_enter_user(enum sys_trace_posix_call call, uintptr_t obj,
+				k_timeout_t timeout)
+{
+	ARG_UNUSED(call);
+	ARG_UNUSED(obj);
+	ARG_UNUSED(timeout);
+}
+
+void sys_trace_posix_exit_user(enum sys_trace_posix_call call, uintptr_t obj, int err)
+{
+	ARG_UNUSED(call);
+	ARG_UNUSED(obj);
+	ARG_UNUSED(err);
+}
+#endif /* CONFIG_TRACING_USER */
+
+static pthread_mutex_t mutex;
+static sem_t sem;
+
+static void print(const char *operation, uint32_t count, uint64_t cycles)
+{
+	printf("%s, %u, %llu, %llu\n", operation, count, (unsigned long long)(cycles / count),
+	       (unsigned long long)(k_cyc_to_ns_floor64(cycles) / count));
+}
+
+static void bench_mutex(void)
+{
+	int ret;
+	uint32_t begin;
+	uint32_t end;
+
+	begin = k_cycle_get_32();
+	for (int i = 0; i < CONFIG_TEST_ITERATIONS; ++i) {
+		ret = pthread_mutex_lock(&mutex);
+		__ASSERT(ret == 0, "pthread_mutex_lock() failed: %d", ret);
+		ret = pthread_mutex_unlock(&mutex);
+		__ASSERT(ret == 0, "pthread_mutex_unlock() failed: %d", ret);
+		ARG_UNUSED(ret);
+	}
+	end = k_cycle_get_32();
+
+	print("pthread_mutex_lock+unlock", CONFIG_TEST_ITERATIONS, end - begin);
+}
+
+static void bench_sem(void)
+{
+	int ret;
+	uint32_t begin;
+	uint32_t end;
+
+	begin = k_cycle_get_32();
+	for (int i = 0; i < CONFIG_TEST_ITERATIONS; ++i) {
+		ret = sem_post(&sem);
+		__ASSERT(ret == 0, "sem_post() failed: %d", ret);
+		ret = sem_wait(&sem);
+		__ASSERT(ret == 0, "sem_wait() failed: %d", ret);
+		ARG_UNUSED(ret);
+	}
+	end = k_cycle_get_32();
+
+	print("sem_post+wait", CONFIG_TEST_ITERATIONS, end - begin);
+}
+
+int main(void)
+{
+	int ret;
+
+	ret = pthread_mutex_init(&mutex, NULL);
+	__ASSERT(ret == 0, "pthread_mutex_init() failed: %d", ret);
+	ret = sem_init(&sem, 0, 0);
+	__ASSERT(ret == 0, "sem_init() failed: %d", ret);
+	ARG_UNUSED(ret);
+
+	printf("BOARD: %s\n", CONFIG_BOARD);
+	printf("POSIX_TRACING: %s\n",
+	       !IS_ENABLED(CONFIG_POSIX_TRACING) ? "off"
+	       : IS_ENABLED(CONFIG_TRACING_CTF)  ? "ctf"
+						 : "user");
+	printf("operation, count, cycles/op, ns/op\n");
+
+	bench_mutex();
+	bench_sem();
+
+	printf("PROJECT EXECUTION SUCCESSFUL\n");
+
+	return 0;
+}
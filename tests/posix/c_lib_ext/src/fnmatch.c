@@ -6,6 +6,7 @@
 
 #include <ctype.h>
 #include <fnmatch.h>
+#include <string.h>
 
 #include <zephyr/ztest.h>
 
@@ -165,3 +166,37 @@ ZTEST(posix_c_lib_ext, test_fnmatch)
 	/* ensure that an invalid character class generates an error */
 	zexpect_equal(fnmatch("[[:foobarbaz:]]", "Z", 0), FNM_NOMATCH);
 }
+
+ZTEST(posix_c_lib_ext, test_fnmatch_many_stars)
+{
+	char pattern[2 * 100 + 2];
+	char string[256];
+
+	/* "*a*a...*a*b" against "aaa...a" is exponential for a naive backtracking matcher */
+	for (size_t i = 0; i < 100; ++i) {
+		pattern[2 * i] = '*';
+		pattern[2 * i + 1] = 'a';
+	}
+	pattern[200] = 'b';
+	pattern[201] = '\0';
+
+	memset(string, 'a', sizeof(string) - 1);
+	string[sizeof(string) - 1] = '\0';
+
+	zexpect_equal(fnmatch(pattern, string, 0), FNM_NOMATCH);
+
+	/* more stars than the former recursion limit still match */
+	pattern[200] = '\0';
+	zexpect_ok(fnmatch(pattern, string, 0));
+	zexpect_ok(fnmatch(pattern, string, FNM_PATHNAME | FNM_PERIOD));
+
+	zexpect_ok(fnmatch("*a*b*c", "xaxbxbxc", 0));
+	zexpect_equal(fnmatch("*a*b*c", "xaxbxbx", 0), FNM_NOMATCH);
+	zexpect_ok(fnmatch("a*/*b", "axx/xxb", FNM_PATHNAME));
+	zexpect_equal(fnmatch("a*b", "ax/b", FNM_PATHNAME), FNM_NOMATCH);
+	zexpect_equal(fnmatch("*/*b", "a/x/b", FNM_PATHNAME), FNM_NOMATCH);
+	zexpect_ok(fnmatch("*/*b", "a/x/b", 0));
+	zexpect_ok(fnmatch("*?*", "a", 0));
+	zexpect_equal(fnmatch("*?*?", "a", 0), FNM_NOMATCH);
+	zexpect_ok(fnmatch("*[bc]", "abac", 0));
+}
@@ -0,0 +1,188 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "posix_clock.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <time.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/timeutil.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+/* how long a wait may end after its deadline, with some slack for emulators */
+#define LATE_NS_MAX (k_ticks_to_ns_ceil64(2) + 5 * NSEC_PER_MSEC)
+
+#define STEP_DELAY_MS 200
+
+static void timespec_add_ms(struct timespec *ts, int64_t ms)
+{
+	struct timespec addend = {
+		.tv_sec = ms / MSEC_PER_SEC,
+		.tv_nsec = (ms % MSEC_PER_SEC) * NSEC_PER_MSEC,
+	};
+
+	(void)timespec_add(ts, &addend);
+}
+
+static void realtime_step(int64_t ms)
+{
+	struct timespec ts;
+
+	zassert_ok(clock_gettime(CLOCK_REALTIME, &ts));
+	timespec_add_ms(&ts, ms);
+	zassert_ok(clock_settime(CLOCK_REALTIME, &ts));
+}
+
+static void *realtime_step_fn(void *arg)
+{
+	k_msleep(STEP_DELAY_MS);
+	realtime_step(POINTER_TO_INT(arg));
+
+	return NULL;
+}
+
+static int64_t monotonic_ns(void)
+{
+	struct timespec ts;
+
+	zassert_ok(clock_gettime(CLOCK_MONOTONIC, &ts));
+
+	return ts_to_ns(&ts);
+}
+
+/* Wait on sem until 2s of CLOCK_REALTIME from now, while another thread steps the clock */
+static int64_t sem_timedwait_stepped(int64_t step_ms)
+{
+	sem_t sem;
+	pthread_t th;
+	int64_t start;
+	struct timespec abstime;
+
+	zassert_ok(sem_init(&sem, 0, 0));
+
+	start = monotonic_ns();
+	zassert_ok(clock_gettime(CLOCK_REALTIME, &abstime));
+	timespec_add_ms(&abstime, 2 * MSEC_PER_SEC);
+	zassert_ok(pthread_create(&th, NULL, realtime_step_fn, INT_TO_POINTER(step_ms)));
+
+	zassert_equal(sem_timedwait(&sem, &abstime), -1);
+	zassert_equal(errno, ETIMEDOUT);
+
+	zassert_ok(pthread_join(th, NULL));
+	zassert_ok(sem_destroy(&sem));
+	realtime_step(-step_ms);
+
+	return monotonic_ns() - start;
+}
+
+ZTEST(posix_clock_selection, test_realtime_step_forward)
+{
+	int64_t elapsed = sem_timedwait_stepped(10 * MSEC_PER_SEC);
+
+	/* the deadline passed when the clock was stepped, which wakes the waiter at once */
+	zassert_true(elapsed >= STEP_DELAY_MS * NSEC_PER_MSEC, "woke after %lld ns",
+		     (long long)elapsed);
+	zassert_true(elapsed < STEP_DELAY_MS * NSEC_PER_MSEC + LATE_NS_MAX, "woke after %lld ns",
+		     (long long)elapsed);
+}
+
+ZTEST(posix_clock_selection, test_realtime_step_backward)
+{
+	int64_t elapsed = sem_timedwait_stepped(-MSEC_PER_SEC);
+
+	/* the deadline moved 1s further away */
+	zassert_true(elapsed >= 3 * NSEC_PER_SEC, "woke after %lld ns", (long long)elapsed);
+	zassert_true(elapsed < 3 * NSEC_PER_SEC + LATE_NS_MAX, "woke after %lld ns",
+		     (long long)elapsed);
+}
+
+ZTEST(posix_clock_selection, test_clockwait_accuracy)
+{
+	sem_t sem;
+	int64_t late;
+	struct timespec now;
+	struct timespec abstime;
+	static const clockid_t clocks[] = {CLOCK_MONOTONIC, CLOCK_REALTIME};
+	static const uint32_t delays_ns[] = {
+		1, 1000, 999999, 1000001, 10000000, 33333333, 150000000,
+	};
+
+	zassert_ok(sem_init(&sem, 0, 0));
+
+	ARRAY_FOR_EACH(delays_ns, i) {
+		ARRAY_FOR_EACH(clocks, j) {
+			zassert_ok(clock_gettime(clocks[j], &abstime));
+			abstime.tv_nsec += delays_ns[i];
+			if (abstime.tv_nsec >= NSEC_PER_SEC) {
+				abstime.tv_nsec -= NSEC_PER_SEC;
+				abstime.tv_sec++;
+			}
+
+			zassert_equal(sem_clockwait(&sem, clocks[j], &abstime), -1);
+			zassert_equal(errno, ETIMEDOUT);
+			zassert_ok(clock_gettime(clocks[j], &now));
+
+			/* never early, and late by about a tick at most */
+			late = tp_diff(&now, &abstime);
+			zassert_true(late >= 0, "%u ns wait on clock %d woke %lld ns early",
+				     delays_ns[i], (int)clocks[j], -(long long)late);
+			zassert_true(late < LATE_NS_MAX, "%u ns wait on clock %d woke %lld ns late",
+				     delays_ns[i], (int)clocks[j], (long long)late);
+		}
+	}
+
+	zassert_ok(sem_destroy(&sem));
+}
+
+static void *mutex_clocklock_fn(void *arg)
+{
+	struct timespec abstime;
+
+	zassert_ok(clock_gettime(CLOCK_MONOTONIC, &abstime));
+	timespec_add_ms(&abstime, 50);
+
+	return INT_TO_POINTER(pthread_mutex_clocklock(arg, CLOCK_MONOTONIC, &abstime));
+}
+
+ZTEST(posix_clock_selection, test_clocklock)
+{
+	void *ret;
+	pthread_t th;
+	pthread_mutex_t mu;
+	pthread_rwlock_t rw;
+	struct timespec abstime;
+
+	zassert_ok(pthread_mutex_init(&mu, NULL));
+	zassert_ok(pthread_mutex_lock(&mu));
+	zassert_ok(pthread_create(&th, NULL, mutex_clocklock_fn, &mu));
+	zassert_ok(pthread_join(th, &ret));
+	zassert_equal(POINTER_TO_INT(ret), ETIMEDOUT);
+	zassert_ok(pthread_mutex_unlock(&mu));
+
+	zassert_ok(clock_gettime(CLOCK_MONOTONIC, &abstime));
+	timespec_add_ms(&abstime, 50);
+	zassert_ok(pthread_mutex_clocklock(&mu, CLOCK_MONOTONIC, &abstime));
+	zassert_ok(pthread_mutex_unlock(&mu));
+	zassert_equal(pthread_mutex_clocklock(&mu, (clockid_t)42, &abstime), EINVAL);
+	zassert_ok(pthread_mutex_destroy(&mu));
+
+	zassert_ok(pthread_rwlock_init(&rw, NULL));
+	zassert_ok(pthread_rwlock_wrlock(&rw));
+	zassert_ok(clock_gettime(CLOCK_MONOTONIC, &abstime));
+	timespec_add_ms(&abstime, 50);
+	zassert_equal(pthread_rwlock_clockrdlock(&rw, CLOCK_MONOTONIC, &abstime), ETIMEDOUT);
+	zassert_ok(pthread_rwlock_unlock(&rw));
+
+	zassert_ok(pthread_rwlock_clockrdlock(&rw, CLOCK_MONOTONIC, &abstime));
+	zassert_ok(pthread_rwlock_unlock(&rw));
+	zassert_ok(pthread_rwlock_clockwrlock(&rw, CLOCK_REALTIME, &abstime));
+	zassert_ok(pthread_rwlock_unlock(&rw));
+	zassert_equal(pthread_rwlock_clockwrlock(&rw, (clockid_t)42, &abstime), EINVAL);
+	zassert_ok(pthread_rwlock_destroy(&rw));
+}
@@ -0,0 +1,252 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* ppoll() is part of the 2024 POSIX standard (Issue 8) */
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 202405L
+#ifdef CONFIG_NATIVE_LIBC
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/eventfd.h>
+#include <sys/select.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <zephyr/ztest.h>
+
+static volatile int caught;
+static pthread_t waiter;
+
+static void handler(int signo)
+{
+	ARG_UNUSED(signo);
+
+	++caught;
+}
+
+static void kick(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	(void)pthread_kill(waiter, SIGUSR1);
+}
+static K_WORK_DELAYABLE_DEFINE(kick_work, kick);
+
+/* Install the handler and block SIGUSR1, returning the mask to wait with, which unblocks it */
+static void sigusr1_setup(sigset_t *waitmask)
+{
+	sigset_t set;
+	struct sigaction act = {
+		.sa_handler = handler,
+	};
+
+	caught = 0;
+	zassert_ok(sigemptyset(&act.sa_mask));
+	zassert_ok(sigaction(SIGUSR1, &act, NULL));
+
+	zassert_ok(sigemptyset(&set));
+	zassert_ok(sigaddset(&set, SIGUSR1));
+	zassert_ok(pthread_sigmask(SIG_BLOCK, &set, waitmask));
+	zassert_ok(sigdelset(waitmask, SIGUSR1));
+}
+
+static void sigusr1_teardown(void)
+{
+	sigset_t set;
+	struct sigaction act = {
+		.sa_handler = SIG_IGN,
+	};
+
+	/* the caller's mask must have been restored */
+	zassert_ok(pthread_sigmask(SIG_BLOCK, NULL, &set));
+	zassert_equal(sigismember(&set, SIGUSR1), 1);
+
+	zassert_ok(sigemptyset(&act.sa_mask));
+	zassert_ok(sigaction(SIGUSR1, &act, NULL));
+	zassert_ok(sigemptyset(&set));
+	zassert_ok(sigaddset(&set, SIGUSR1));
+	zassert_ok(pthread_sigmask(SIG_UNBLOCK, &set, NULL));
+}
+
+ZTEST(posix_device_io, test_ppoll)
+{
+	int efd;
+	struct pollfd pfd;
+	const struct timespec ts = {.tv_nsec = 1000000};
+	const struct timespec bad = {.tv_nsec = 1000000000};
+
+	efd = eventfd(0, EFD_NONBLOCK);
+	zassert_true(efd >= 0, "eventfd() failed, errno=%d", errno);
+
+	pfd = (struct pollfd){.fd = efd, .events = POLLIN};
+	zassert_equal(ppoll(&pfd, 1, &ts, NULL), 0);
+	zassert_equal(pfd.revents, 0);
+
+	errno = 0;
+	zassert_equal(ppoll(&pfd, 1, &bad, NULL), -1);
+	zassert_equal(errno, EINVAL);
+
+	zassert_ok(eventfd_write(efd, 1));
+
+	zassert_equal(ppoll(&pfd, 1, NULL, NULL), 1);
+	zassert_true((pfd.revents & POLLIN) != 0);
+
+	zassert_ok(close(efd));
+}
+
+/*
+ * A signal that arrives after the caller has decided to wait, but before it starts waiting, is
+ * left pending by the blocked mask. It must interrupt the wait as soon as the mask passed to
+ * ppoll() or pselect() unblocks it, rather than being lost until the wait times out.
+ */
+ZTEST(posix_device_io, test_ppoll_sigmask_race)
+{
+	int efd;
+	int64_t start;
+	sigset_t waitmask;
+	struct pollfd pfd;
+	const struct timespec ts = {.tv_sec = 10};
+
+	efd = eventfd(0, EFD_NONBLOCK);
+	zassert_true(efd >= 0, "eventfd() failed, errno=%d", errno);
+	pfd = (struct pollfd){.fd = efd, .events = POLLIN};
+
+	sigusr1_setup(&waitmask);
+
+	/* the signal arrives in the window */
+	zassert_ok(raise(SIGUSR1));
+	zassert_equal(caught, 0);
+
+	start = k_uptime_get();
+	errno = 0;
+	zassert_equal(ppoll(&pfd, 1, &ts, &waitmask), -1);
+	zassert_equal(errno, EINTR);
+	zassert_equal(caught, 1);
+	zassert_true(k_uptime_get() - start < MSEC_PER_SEC);
+
+	sigusr1_teardown();
+	zassert_ok(close(efd));
+}
+
+ZTEST(posix_device_io, test_pselect_sigmask_race)
+{
+	int efd;
+	int64_t start;
+	fd_set readfds;
+	sigset_t waitmask;
+	const struct timespec ts = {.tv_sec = 10};
+
+	efd = eventfd(0, EFD_NONBLOCK);
+	zassert_true(efd >= 0, "eventfd() failed, errno=%d", errno);
+
+	sigusr1_setup(&waitmask);
+
+	zassert_ok(raise(SIGUSR1));
+	zassert_equal(caught, 0);
+
+	FD_ZERO(&readfds);
+	FD_SET(efd, &readfds);
+
+	start = k_uptime_get();
+	errno = 0;
+	zassert_equal(pselect(efd + 1, &readfds, NULL, NULL, &ts, &waitmask), -1);
+	zassert_equal(errno, EINTR);
+	zassert_equal(caught, 1);
+	zassert_true(k_uptime_get() - start < MSEC_PER_SEC);
+
+	sigusr1_teardown();
+	zassert_ok(close(efd));
+}
+
+ZTEST(posix_device_io, test_ppoll_signal_during_wait)
+{
+	int efd;
+	int64_t start;
+	sigset_t waitmask;
+	struct pollfd pfd;
+	const struct timespec ts = {.tv_sec = 10};
+
+	efd = eventfd(0, EFD_NONBLOCK);
+	zassert_true(efd >= 0, "eventfd() failed, errno=%d", errno);
+	pfd = (struct pollfd){.fd = efd, .events = POLLIN};
+
+	sigusr1_setup(&waitmask);
+
+	waiter = pthread_self();
+	zassert_true(k_work_schedule(&kick_work, K_MSEC(100)) >= 0);
+
+	start = k_uptime_get();
+	errno = 0;
+	zassert_equal(ppoll(&pfd, 1, &ts, &waitmask), -1);
+	zassert_equal(errno, EINTR);
+	zassert_equal(caught, 1);
+	zassert_true(k_uptime_get() - start < MSEC_PER_SEC);
+
+	sigusr1_teardown();
+	zassert_ok(close(efd));
+}
+
+ZTEST(posix_device_io, test_pselect_signal_during_wait)
+{
+	int64_t start;
+	sigset_t waitmask;
+	const struct timespec ts = {.tv_sec = 10};
+
+	sigusr1_setup(&waitmask);
+
+	waiter = pthread_self();
+	zassert_true(k_work_schedule(&kick_work, K_MSEC(100)) >= 0);
+
+	/* a wait for nothing but a signal */
+	start = k_uptime_get();
+	errno = 0;
+	zassert_equal(pselect(0, NULL, NULL, NULL, &ts, &waitmask), -1);
+	zassert_equal(errno, EINTR);
+	zassert_equal(caught, 1);
+	zassert_true(k_uptime_get() - start < MSEC_PER_SEC);
+
+	sigusr1_teardown();
+}
+
+/* A signal that the mask of the wait blocks stays pending, and does not end the wait */
+ZTEST(posix_device_io, test_ppoll_blocked_signal_during_wait)
+{
+	int efd;
+	sigset_t set;
+	sigset_t waitmask;
+	struct pollfd pfd;
+	const struct timespec ts = {.tv_nsec = 300 * NSEC_PER_MSEC};
+
+	efd = eventfd(0, EFD_NONBLOCK);
+	zassert_true(efd >= 0, "eventfd() failed, errno=%d", errno);
+	pfd = (struct pollfd){.fd = efd, .events = POLLIN};
+
+	sigusr1_setup(&waitmask);
+	zassert_ok(sigaddset(&waitmask, SIGUSR1));
+
+	waiter = pthread_self();
+	zassert_true(k_work_schedule(&kick_work, K_MSEC(100)) >= 0);
+
+	zassert_equal(ppoll(&pfd, 1, &ts, &waitmask), 0);
+	zassert_equal(caught, 0);
+
+	zassert_ok(sigpending(&set));
+	zassert_equal(sigismember(&set, SIGUSR1), 1);
+
+	/* delivered once the signal is unblocked */
+	zassert_ok(sigemptyset(&set));
+	zassert_ok(sigaddset(&set, SIGUSR1));
+	zassert_ok(pthread_sigmask(SIG_UNBLOCK, &set, NULL));
+	zassert_equal(caught, 1);
+	zassert_ok(pthread_sigmask(SIG_BLOCK, &set, NULL));
+
+	sigusr1_teardown();
+	zassert_ok(close(efd));
+}
@@ -0,0 +1,214 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <zephyr/ztest.h>
+
+#include "test_fs.h"
+
+#define TEST_AT_DIR    FATFS_MNTP "/atdir"
+#define TEST_AT_SUBDIR TEST_AT_DIR "/sub"
+#define TEST_AT_FILE   TEST_AT_DIR "/file.txt"
+
+static int dir_fd = -1;
+
+static void before_fn(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	zassert_ok(mkdir(TEST_AT_DIR, 0770));
+
+	dir_fd = open(TEST_AT_DIR, O_RDONLY | O_DIRECTORY);
+	zassert_true(dir_fd >= 0, "open() failed: %d", errno);
+}
+
+static void after_fn(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	if (dir_fd >= 0) {
+		zassert_ok(close(dir_fd));
+		dir_fd = -1;
+	}
+
+	zassert_ok(chdir("/"));
+
+	(void)unlink(TEST_AT_FILE);
+	(void)unlink(TEST_AT_DIR "/renamed.txt");
+	(void)rmdir(TEST_AT_SUBDIR);
+	(void)rmdir(TEST_AT_DIR);
+}
+
+ZTEST_SUITE(posix_fs_at_test, NULL, test_mount, before_fn, after_fn, test_unmount);
+
+ZTEST(posix_fs_at_test, test_fs_openat)
+{
+	int fd;
+	char buf[5];
+	struct stat st;
+
+	fd = openat(dir_fd, "file.txt", O_CREAT | O_RDWR, 0660);
+	zassert_true(fd >= 0, "openat() failed: %d", errno);
+	zassert_equal(5, write(fd, "hello", 5));
+	zassert_ok(close(fd));
+
+	/* the file is visible through its absolute path */
+	fd = open(TEST_AT_FILE, O_RDONLY);
+	zassert_true(fd >= 0, "open() failed: %d", errno);
+	zassert_equal(5, read(fd, buf, sizeof(buf)));
+	zassert_mem_equal("hello", buf, sizeof(buf));
+	zassert_ok(close(fd));
+
+	zassert_ok(fstatat(dir_fd, "file.txt", &st, 0));
+	zassert_equal(5, st.st_size);
+	zassert_ok(fstatat(dir_fd, "./sub/../file.txt", &st, 0));
+	zassert_equal(5, st.st_size);
+
+	/* absolute paths ignore the directory file descriptor */
+	zassert_ok(fstatat(dir_fd, TEST_AT_FILE, &st, 0));
+	zassert_ok(fstatat(-1, TEST_AT_FILE, &st, 0));
+
+	zassert_ok(faccessat(dir_fd, "file.txt", R_OK | W_OK, 0));
+	zassert_not_ok(faccessat(dir_fd, "nonexistent", F_OK, 0));
+	zassert_equal(ENOENT, errno);
+}
+
+ZTEST(posix_fs_at_test, test_fs_openat_errors)
+{
+	int fd;
+
+	zassert_equal(-1, openat(-1, "file.txt", O_RDONLY));
+	zassert_equal(EBADF, errno);
+
+	zassert_equal(-1, openat(dir_fd, "", O_RDONLY));
+	zassert_equal(ENOENT, errno);
+
+	/* a regular file descriptor cannot be used as a directory */
+	fd = openat(dir_fd, "file.txt", O_CREAT | O_RDWR, 0660);
+	zassert_true(fd >= 0, "openat() failed: %d", errno);
+	zassert_equal(-1, openat(fd, "file.txt", O_RDONLY));
+	zassert_equal(ENOTDIR, errno);
+	zassert_equal(-1, openat(dir_fd, "file.txt", O_RDONLY | O_DIRECTORY));
+	zassert_equal(ENOTDIR, errno);
+	zassert_ok(close(fd));
+
+	/* a directory file descriptor cannot be written */
+	zassert_equal(-1, open(TEST_AT_DIR, O_RDWR | O_DIRECTORY));
+	zassert_equal(EISDIR, errno);
+	zassert_equal(-1, write(dir_fd, "x", 1));
+	zassert_equal(EISDIR, errno);
+}
+
+ZTEST(posix_fs_at_test, test_fs_mkdirat_unlinkat)
+{
+	int fd;
+	int subfd;
+	struct stat st;
+
+	zassert_ok(mkdirat(dir_fd, "sub", 0770));
+	zassert_ok(stat(TEST_AT_SUBDIR, &st));
+	zassert_true(S_ISDIR(st.st_mode));
+
+	/* directory file descriptors may be opened relative to one another */
+	subfd = openat(dir_fd, "sub", O_SEARCH);
+	zassert_true(subfd >= 0, "openat() failed: %d", errno);
+	fd = openat(subfd, "../file.txt", O_CREAT | O_WRONLY, 0660);
+	zassert_true(fd >= 0, "openat() failed: %d", errno);
+	zassert_ok(close(fd));
+	zassert_ok(close(subfd));
+
+	zassert_equal(-1, unlinkat(dir_fd, "sub", 0));
+	zassert_equal(EPERM, errno);
+	zassert_equal(-1, unlinkat(dir_fd, "file.txt", AT_REMOVEDIR));
+	zassert_equal(ENOTDIR, errno);
+
+	zassert_ok(unlinkat(dir_fd, "sub", AT_REMOVEDIR));
+	zassert_ok(unlinkat(dir_fd, "file.txt", 0));
+	zassert_not_ok(stat(TEST_AT_SUBDIR, &st));
+	zassert_not_ok(stat(TEST_AT_FILE, &st));
+}
+
+ZTEST(posix_fs_at_test, test_fs_renameat)
+{
+	int fd;
+	struct stat st;
+
+	fd = openat(dir_fd, "file.txt", O_CREAT | O_WRONLY, 0660);
+	zassert_true(fd >= 0, "openat() failed: %d", errno);
+	zassert_ok(close(fd));
+
+	zassert_ok(renameat(dir_fd, "file.txt", AT_FDCWD, TEST_AT_DIR "/renamed.txt"));
+	zassert_not_ok(fstatat(dir_fd, "file.txt", &st, 0));
+	zassert_ok(fstatat(dir_fd, "renamed.txt", &st, 0));
+}
+
+ZTEST(posix_fs_at_test, test_fs_links)
+{
+	int fd;
+	char buf[8];
+
+	fd = openat(dir_fd, "file.txt", O_CREAT | O_WRONLY, 0660);
+	zassert_true(fd >= 0, "openat() failed: %d", errno);
+	zassert_ok(close(fd));
+
+	zassert_equal(-1, linkat(dir_fd, "file.txt", dir_fd, "link.txt", 0));
+	zassert_equal(EPERM, errno);
+	zassert_equal(-1, symlinkat("file.txt", dir_fd, "link.txt"));
+	zassert_equal(EPERM, errno);
+	zassert_equal(-1, readlinkat(dir_fd, "file.txt", buf, sizeof(buf)));
+	zassert_equal(EINVAL, errno);
+
+	zassert_ok(fchownat(dir_fd, "file.txt", (uid_t)-1, (gid_t)-1, 0));
+	zassert_equal(-1, fchownat(dir_fd, "file.txt", 0, 0, 0));
+	zassert_equal(EPERM, errno);
+}
+
+ZTEST(posix_fs_at_test, test_fs_chdir_getcwd)
+{
+	int fd;
+	char buf[PATH_MAX];
+	struct stat st;
+
+	zassert_not_null(getcwd(buf, sizeof(buf)));
+	zassert_str_equal("/", buf);
+
+	zassert_ok(chdir(TEST_AT_DIR));
+	zassert_not_null(getcwd(buf, sizeof(buf)));
+	zassert_str_equal(TEST_AT_DIR, buf);
+
+	/* relative paths are resolved against the working directory */
+	fd = open("file.txt", O_CREAT | O_WRONLY, 0660);
+	zassert_true(fd >= 0, "open() failed: %d", errno);
+	zassert_ok(close(fd));
+	zassert_ok(stat(TEST_AT_FILE, &st));
+	zassert_ok(mkdir("sub", 0770));
+	zassert_ok(stat(TEST_AT_SUBDIR, &st));
+
+	zassert_ok(chdir("sub"));
+	zassert_not_null(getcwd(buf, sizeof(buf)));
+	zassert_str_equal(TEST_AT_SUBDIR, buf);
+	zassert_ok(faccessat(AT_FDCWD, "../file.txt", F_OK, 0));
+
+	zassert_ok(fchdir(dir_fd));
+	zassert_not_null(getcwd(buf, sizeof(buf)));
+	zassert_str_equal(TEST_AT_DIR, buf);
+
+	zassert_equal(-1, chdir("file.txt"));
+	zassert_equal(ENOTDIR, errno);
+	zassert_equal(-1, chdir("nonexistent"));
+	zassert_equal(ENOENT, errno);
+
+	zassert_is_null(getcwd(buf, 2));
+	zassert_equal(ERANGE, errno);
+	zassert_is_null(getcwd(buf, 0));
+	zassert_equal(EINVAL, errno);
+}
@@ -0,0 +1,185 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "test_fs.h"
+
+#define TEST_FADV_FILE FATFS_MNTP "/fadvise.dat"
+/* spans several cache blocks and ends part way through one */
+#define TEST_FADV_SIZE (8 * CONFIG_POSIX_FADVISE_BLOCK_SIZE + 123)
+#define TEST_FADV_CHUNK 100
+
+static int fd = -1;
+
+static inline uint8_t pattern(off_t off)
+{
+	return (uint8_t)((off * 7) ^ (off >> 8));
+}
+
+static void check_read(off_t off, size_t len)
+{
+	uint8_t buf[TEST_FADV_CHUNK];
+
+	zassert_true(len <= sizeof(buf));
+	zassert_equal(len, pread(fd, buf, len, off));
+	for (size_t i = 0; i < len; ++i) {
+		zassert_equal(pattern(off + i), buf[i], "mismatch at offset %d", (int)(off + i));
+	}
+}
+
+static void before_fn(void *unused)
+{
+	uint8_t buf[TEST_FADV_CHUNK];
+	off_t off = 0;
+
+	ARG_UNUSED(unused);
+
+	fd = open(TEST_FADV_FILE, O_CREAT | O_RDWR, 0660);
+	zassert_true(fd >= 0, "open() failed: %d", errno);
+
+	while (off < TEST_FADV_SIZE) {
+		size_t len = MIN(sizeof(buf), TEST_FADV_SIZE - off);
+
+		for (size_t i = 0; i < len; ++i) {
+			buf[i] = pattern(off + i);
+		}
+
+		zassert_equal(len, write(fd, buf, len));
+		off += len;
+	}
+
+	zassert_equal(0, lseek(fd, 0, SEEK_SET));
+}
+
+static void after_fn(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	if (fd >= 0) {
+		zassert_ok(close(fd));
+		fd = -1;
+	}
+
+	(void)unlink(TEST_FADV_FILE);
+}
+
+ZTEST_SUITE(posix_fs_fadvise_test, NULL, test_mount, before_fn, after_fn, test_unmount);
+
+ZTEST(posix_fs_fadvise_test, test_fs_fadvise_einval)
+{
+	zassert_equal(EBADF, posix_fadvise(-1, 0, 0, POSIX_FADV_NORMAL));
+	zassert_equal(EINVAL, posix_fadvise(fd, 0, 0, -1));
+	zassert_equal(EINVAL, posix_fadvise(fd, -1, 0, POSIX_FADV_NORMAL));
+	zassert_equal(EINVAL, posix_fadvise(fd, 0, -1, POSIX_FADV_NORMAL));
+}
+
+ZTEST(posix_fs_fadvise_test, test_fs_fadvise_sequential)
+{
+	uint8_t buf[TEST_FADV_CHUNK];
+	off_t off = 0;
+	ssize_t ret;
+
+	zassert_ok(posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL));
+
+	/* unaligned reads that straddle block boundaries, through to EOF */
+	do {
+		ret = read(fd, buf, sizeof(buf));
+		zassert_true(ret >= 0, "read() failed: %d", errno);
+		for (ssize_t i = 0; i < ret; ++i) {
+			zassert_equal(pattern(off + i), buf[i], "mismatch at offset %d",
+				      (int)(off + i));
+		}
+		off += ret;
+	} while (ret > 0);
+
+	zassert_equal(TEST_FADV_SIZE, off);
+	zassert_equal(TEST_FADV_SIZE, lseek(fd, 0, SEEK_CUR));
+}
+
+ZTEST(posix_fs_fadvise_test, test_fs_fadvise_random)
+{
+	static const off_t offs[] = {
+		TEST_FADV_SIZE - 50, 0, 3 * CONFIG_POSIX_FADVISE_BLOCK_SIZE - 10, 700, 1,
+	};
+
+	zassert_ok(posix_fadvise(fd, 0, 0, POSIX_FADV_RANDOM));
+
+	ARRAY_FOR_EACH(offs, i) {
+		check_read(offs[i], MIN(TEST_FADV_CHUNK, TEST_FADV_SIZE - offs[i]));
+	}
+
+	/* the file position is unaffected by pread() */
+	zassert_equal(0, lseek(fd, 0, SEEK_CUR));
+}
+
+ZTEST(posix_fs_fadvise_test, test_fs_fadvise_willneed_dontneed)
+{
+	zassert_ok(posix_fadvise(fd, 0, 4 * CONFIG_POSIX_FADVISE_BLOCK_SIZE, POSIX_FADV_WILLNEED));
+	/* allow prefetch to complete */
+	k_msleep(100);
+
+	check_read(CONFIG_POSIX_FADVISE_BLOCK_SIZE + 17, TEST_FADV_CHUNK);
+
+	zassert_ok(posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED));
+	check_read(CONFIG_POSIX_FADVISE_BLOCK_SIZE + 17, TEST_FADV_CHUNK);
+}
+
+ZTEST(posix_fs_fadvise_test, test_fs_fadvise_coherent)
+{
+	uint8_t buf[4];
+	static const uint8_t update[] = {0xde, 0xad, 0xbe, 0xef};
+
+	zassert_ok(posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED));
+	k_msleep(100);
+	check_read(0, TEST_FADV_CHUNK);
+
+	/* pwrite() over cached data */
+	zassert_equal(sizeof(update), pwrite(fd, update, sizeof(update), 10));
+	zassert_equal(sizeof(buf), pread(fd, buf, sizeof(buf), 10));
+	zassert_mem_equal(update, buf, sizeof(buf));
+
+	/* write() over cached data */
+	zassert_equal(CONFIG_POSIX_FADVISE_BLOCK_SIZE,
+		      lseek(fd, CONFIG_POSIX_FADVISE_BLOCK_SIZE, SEEK_SET));
+	zassert_equal(sizeof(update), write(fd, update, sizeof(update)));
+	zassert_equal(sizeof(buf), pread(fd, buf, sizeof(buf), CONFIG_POSIX_FADVISE_BLOCK_SIZE));
+	zassert_mem_equal(update, buf, sizeof(buf));
+
+	/* ftruncate() discards cached data beyond the new end of file */
+	zassert_ok(ftruncate(fd, CONFIG_POSIX_FADVISE_BLOCK_SIZE + 2));
+	zassert_equal(2, pread(fd, buf, sizeof(buf), CONFIG_POSIX_FADVISE_BLOCK_SIZE));
+	zassert_equal(0, pread(fd, buf, sizeof(buf), 2 * CONFIG_POSIX_FADVISE_BLOCK_SIZE));
+}
+
+ZTEST(posix_fs_fadvise_test, test_fs_fadvise_two_descriptors)
+{
+	int fd2;
+	uint8_t buf[4];
+	static const uint8_t update[] = {0xca, 0xfe, 0xf0, 0x0d};
+
+	zassert_ok(posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED));
+	k_msleep(100);
+	check_read(0, TEST_FADV_CHUNK);
+
+	/* a separate open() of the same file has its own open file description */
+	fd2 = open(TEST_FADV_FILE, O_RDWR);
+	zassert_true(fd2 >= 0, "open() failed: %d", errno);
+
+	zassert_equal(sizeof(update), pwrite(fd2, update, sizeof(update), 10));
+	zassert_ok(ftruncate(fd2, CONFIG_POSIX_FADVISE_BLOCK_SIZE + 2));
+	zassert_ok(close(fd2));
+
+	zassert_equal(sizeof(buf), pread(fd, buf, sizeof(buf), 10));
+	zassert_mem_equal(update, buf, sizeof(buf));
+	zassert_equal(2, pread(fd, buf, sizeof(buf), CONFIG_POSIX_FADVISE_BLOCK_SIZE));
+	zassert_equal(0, pread(fd, buf, sizeof(buf), 2 * CONFIG_POSIX_FADVISE_BLOCK_SIZE));
+}
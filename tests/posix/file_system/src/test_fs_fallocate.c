@@ -0,0 +1,97 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <zephyr/ztest.h>
+
+#include "test_fs.h"
+
+#define TEST_FALLOC_FILE FATFS_MNTP "/falloc.dat"
+
+static int fd = -1;
+
+static off_t file_size(void)
+{
+	struct stat st;
+
+	zassert_ok(fstat(fd, &st));
+
+	return st.st_size;
+}
+
+static void before_fn(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	fd = open(TEST_FALLOC_FILE, O_CREAT | O_RDWR, 0660);
+	zassert_true(fd >= 0, "open() failed: %d", errno);
+	zassert_equal(5, write(fd, "hello", 5));
+}
+
+static void after_fn(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	if (fd >= 0) {
+		zassert_ok(close(fd));
+		fd = -1;
+	}
+
+	(void)unlink(TEST_FALLOC_FILE);
+}
+
+ZTEST_SUITE(posix_fs_fallocate_test, NULL, test_mount, before_fn, after_fn, test_unmount);
+
+ZTEST(posix_fs_fallocate_test, test_fs_fallocate_einval)
+{
+	int saved_errno = errno;
+
+	zassert_equal(EBADF, posix_fallocate(-1, 0, 1));
+	zassert_equal(EINVAL, posix_fallocate(fd, -1, 1));
+	zassert_equal(EINVAL, posix_fallocate(fd, 0, 0));
+	zassert_equal(EINVAL, posix_fallocate(fd, 0, -1));
+
+	/* the error is returned rather than stored in errno */
+	zassert_equal(saved_errno, errno);
+}
+
+ZTEST(posix_fs_fallocate_test, test_fs_fallocate_grow)
+{
+	char buf[8];
+
+	zassert_ok(posix_fallocate(fd, 0, 4096));
+	zassert_equal(4096, file_size());
+
+	/* existing contents are preserved, the new region reads as zeros */
+	zassert_equal(sizeof(buf), pread(fd, buf, sizeof(buf), 0));
+	zassert_mem_equal("hello\0\0\0", buf, sizeof(buf));
+	zassert_equal(sizeof(buf), pread(fd, buf, sizeof(buf), 4000));
+	zassert_mem_equal("\0\0\0\0\0\0\0\0", buf, sizeof(buf));
+
+	/* the file position is unchanged */
+	zassert_equal(5, lseek(fd, 0, SEEK_CUR));
+
+	/* writes within the preallocated region do not change the file size */
+	zassert_equal(5, pwrite(fd, "world", 5, 2048));
+	zassert_equal(4096, file_size());
+}
+
+ZTEST(posix_fs_fallocate_test, test_fs_fallocate_no_shrink)
+{
+	zassert_ok(posix_fallocate(fd, 0, 4096));
+	zassert_ok(posix_fallocate(fd, 100, 10));
+	zassert_equal(4096, file_size());
+
+	/* ftruncate() may both grow and shrink a file */
+	zassert_ok(ftruncate(fd, 8192));
+	zassert_equal(8192, file_size());
+	zassert_ok(ftruncate(fd, 10));
+	zassert_equal(10, file_size());
+}
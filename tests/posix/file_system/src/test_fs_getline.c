@@ -0,0 +1,128 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <zephyr/ztest.h>
+
+#include "test_fs.h"
+
+#define TEST_GETLINE_FILE FATFS_MNTP "/getline.txt"
+#define LONG_LINE_LEN     1000
+
+static FILE *fp;
+static char *line;
+static size_t size;
+
+static void write_file(const char *data, size_t len)
+{
+	int fd;
+
+	fd = open(TEST_GETLINE_FILE, O_CREAT | O_TRUNC | O_WRONLY, 0660);
+	zassert_true(fd >= 0, "open() failed: %d", errno);
+	zassert_equal(len, write(fd, data, len));
+	zassert_ok(close(fd));
+
+	fp = fopen(TEST_GETLINE_FILE, "r");
+	zassert_not_null(fp, "fopen() failed: %d", errno);
+}
+
+static void after_fn(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	if (fp != NULL) {
+		zassert_ok(fclose(fp));
+		fp = NULL;
+	}
+
+	free(line);
+	line = NULL;
+	size = 0;
+
+	(void)unlink(TEST_GETLINE_FILE);
+}
+
+ZTEST_SUITE(posix_fs_getline_test, NULL, test_mount, NULL, after_fn, test_unmount);
+
+ZTEST(posix_fs_getline_test, test_fs_getline)
+{
+	static const char data[] = "first\n\nthird line\nno newline";
+
+	write_file(data, strlen(data));
+
+	zassert_equal(6, getline(&line, &size, fp));
+	zassert_str_equal("first\n", line);
+	zassert_true(size > 6);
+
+	zassert_equal(1, getline(&line, &size, fp));
+	zassert_str_equal("\n", line);
+
+	zassert_equal(11, getline(&line, &size, fp));
+	zassert_str_equal("third line\n", line);
+
+	/* the last record need not be terminated by the delimiter */
+	zassert_equal(10, getline(&line, &size, fp));
+	zassert_str_equal("no newline", line);
+
+	zassert_equal(-1, getline(&line, &size, fp));
+}
+
+ZTEST(posix_fs_getline_test, test_fs_getline_long)
+{
+	static char data[LONG_LINE_LEN + 4];
+
+	memset(data, 'x', LONG_LINE_LEN);
+	memcpy(&data[LONG_LINE_LEN], "\ny\n", 3);
+	write_file(data, LONG_LINE_LEN + 3);
+
+	/* the buffer grows to fit a line of any length */
+	zassert_equal(LONG_LINE_LEN + 1, getline(&line, &size, fp));
+	zassert_true(size >= LONG_LINE_LEN + 2);
+	zassert_equal('x', line[LONG_LINE_LEN - 1]);
+	zassert_equal('\n', line[LONG_LINE_LEN]);
+	zassert_equal('\0', line[LONG_LINE_LEN + 1]);
+
+	zassert_equal(2, getline(&line, &size, fp));
+	zassert_str_equal("y\n", line);
+}
+
+ZTEST(posix_fs_getline_test, test_fs_getdelim)
+{
+	static const char data[] = "a:bc:def\nghi:";
+
+	write_file(data, strlen(data));
+
+	zassert_equal(2, getdelim(&line, &size, ':', fp));
+	zassert_str_equal("a:", line);
+
+	/* input read past the delimiter is not lost */
+	zassert_equal('b', fgetc(fp));
+
+	zassert_equal(2, getdelim(&line, &size, ':', fp));
+	zassert_str_equal("c:", line);
+
+	zassert_equal(8, getdelim(&line, &size, ':', fp));
+	zassert_str_equal("def\nghi:", line);
+
+	zassert_equal(-1, getdelim(&line, &size, ':', fp));
+}
+
+ZTEST(posix_fs_getline_test, test_fs_getline_einval)
+{
+	static const char data[] = "x\n";
+
+	write_file(data, strlen(data));
+
+	zassert_equal(-1, getline(NULL, &size, fp));
+	zassert_equal(EINVAL, errno);
+	zassert_equal(-1, getline(&line, NULL, fp));
+	zassert_equal(EINVAL, errno);
+}
@@ -0,0 +1,151 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <glob.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "test_fs.h"
+
+/* upper case, so that names read back from FAT without long file names compare equal */
+#define GLOB_DIR FATFS_MNTP "/GLOB"
+
+static const char *const glob_files[] = {
+	GLOB_DIR "/A.TXT",
+	GLOB_DIR "/B.TXT",
+	GLOB_DIR "/C.MD",
+	GLOB_DIR "/SUB/D.TXT",
+};
+
+static void before_fn(void *unused)
+{
+	int fd;
+
+	ARG_UNUSED(unused);
+
+	zassert_ok(mkdir(GLOB_DIR, 0777));
+	zassert_ok(mkdir(GLOB_DIR "/SUB", 0777));
+
+	ARRAY_FOR_EACH(glob_files, i) {
+		fd = open(glob_files[i], O_CREAT | O_WRONLY, 0660);
+		zassert_true(fd >= 0, "failed to create %s", glob_files[i]);
+		zassert_ok(close(fd));
+	}
+}
+
+static void after_fn(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	ARRAY_FOR_EACH(glob_files, i) {
+		(void)unlink(glob_files[i]);
+	}
+
+	(void)unlink(GLOB_DIR "/SUB");
+	(void)unlink(GLOB_DIR);
+}
+
+ZTEST_SUITE(posix_fs_glob_test, NULL, test_mount, before_fn, after_fn, test_unmount);
+
+static void check_glob(const char *pattern, int flags, const char *const *expected, size_t n)
+{
+	glob_t g;
+
+	zassert_ok(glob(pattern, flags, NULL, &g), "glob(\"%s\") failed", pattern);
+	zassert_equal(g.gl_pathc, n, "glob(\"%s\") found %zu paths", pattern, g.gl_pathc);
+	for (size_t i = 0; i < n; ++i) {
+		zassert_str_equal(g.gl_pathv[i], expected[i]);
+	}
+	zassert_is_null(g.gl_pathv[n]);
+
+	globfree(&g);
+}
+
+ZTEST(posix_fs_glob_test, test_glob)
+{
+	static const char *const txt[] = {GLOB_DIR "/A.TXT", GLOB_DIR "/B.TXT"};
+	static const char *const all[] = {
+		GLOB_DIR "/A.TXT",
+		GLOB_DIR "/B.TXT",
+		GLOB_DIR "/C.MD",
+		GLOB_DIR "/SUB",
+	};
+	static const char *const nested[] = {GLOB_DIR "/SUB/D.TXT"};
+	static const char *const literal[] = {GLOB_DIR "/C.MD"};
+
+	check_glob(GLOB_DIR "/*.TXT", 0, txt, ARRAY_SIZE(txt));
+	check_glob(GLOB_DIR "/?.TXT", 0, txt, ARRAY_SIZE(txt));
+	check_glob(GLOB_DIR "/[AB].*", 0, txt, ARRAY_SIZE(txt));
+	check_glob(GLOB_DIR "/*", 0, all, ARRAY_SIZE(all));
+	check_glob(GLOB_DIR "/*/*.TXT", 0, nested, ARRAY_SIZE(nested));
+	check_glob(FATFS_MNTP "/G*B/S*/D.TXT", 0, nested, ARRAY_SIZE(nested));
+	check_glob(GLOB_DIR "/C.MD", 0, literal, ARRAY_SIZE(literal));
+}
+
+ZTEST(posix_fs_glob_test, test_glob_flags)
+{
+	glob_t g;
+	static const char *const mark[] = {GLOB_DIR "/SUB/"};
+	static const char *const nocheck[] = {GLOB_DIR "/*.C"};
+	static const char *const brace[] = {GLOB_DIR "/C.MD", GLOB_DIR "/A.TXT"};
+
+	check_glob(GLOB_DIR "/S*", GLOB_MARK, mark, ARRAY_SIZE(mark));
+	check_glob(GLOB_DIR "/SUB", GLOB_MARK, mark, ARRAY_SIZE(mark));
+	check_glob(GLOB_DIR "/*/", 0, mark, ARRAY_SIZE(mark));
+	check_glob(GLOB_DIR "/*.C", GLOB_NOCHECK, nocheck, ARRAY_SIZE(nocheck));
+	check_glob(GLOB_DIR "/{C,A}.*", GLOB_BRACE, brace, ARRAY_SIZE(brace));
+
+	zassert_equal(glob(GLOB_DIR "/*.C", 0, NULL, &g), GLOB_NOMATCH);
+	zassert_equal(glob(GLOB_DIR "/NONE/*", 0, NULL, &g), GLOB_NOMATCH);
+
+	zassert_ok(glob(GLOB_DIR "/*.TXT", GLOB_NOSORT, NULL, &g));
+	zassert_equal(g.gl_pathc, 2);
+	globfree(&g);
+}
+
+ZTEST(posix_fs_glob_test, test_glob_append_dooffs)
+{
+	glob_t g = {
+		.gl_offs = 2,
+	};
+
+	zassert_ok(glob(GLOB_DIR "/*.MD", GLOB_DOOFFS, NULL, &g));
+	zassert_ok(glob(GLOB_DIR "/*.TXT", GLOB_DOOFFS | GLOB_APPEND, NULL, &g));
+
+	zassert_equal(g.gl_pathc, 3);
+	zassert_is_null(g.gl_pathv[0]);
+	zassert_is_null(g.gl_pathv[1]);
+	zassert_str_equal(g.gl_pathv[2], GLOB_DIR "/C.MD");
+	zassert_str_equal(g.gl_pathv[3], GLOB_DIR "/A.TXT");
+	zassert_str_equal(g.gl_pathv[4], GLOB_DIR "/B.TXT");
+	zassert_is_null(g.gl_pathv[5]);
+
+	globfree(&g);
+	zassert_equal(g.gl_pathc, 0);
+	zassert_is_null(g.gl_pathv);
+}
+
+static int glob_errfunc(const char *epath, int eerrno)
+{
+	ARG_UNUSED(epath);
+	ARG_UNUSED(eerrno);
+
+	return 1;
+}
+
+ZTEST(posix_fs_glob_test, test_glob_errors)
+{
+	glob_t g;
+
+	/* a missing directory is only an error for GLOB_ERR or errfunc */
+	zassert_equal(glob(FATFS_MNTP "/NONE/*", 0, NULL, &g), GLOB_NOMATCH);
+	zassert_equal(glob(FATFS_MNTP "/NONE/*", GLOB_ERR, NULL, &g), GLOB_ABORTED);
+	globfree(&g);
+	zassert_equal(glob(FATFS_MNTP "/NONE/*", 0, glob_errfunc, &g), GLOB_ABORTED);
+	globfree(&g);
+}
@@ -0,0 +1,235 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* for pthread_spawn_np() */
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/times.h>
+#include <unistd.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#ifdef CONFIG_POSIX_PROCESS_DOMAINS
+
+#define BUSY_MS 100
+
+struct child {
+	pid_t pid;
+	pid_t ppid;
+	pid_t grandchild_pid;
+	char env[16];
+	struct sigaction act;
+	clock_t utime;
+	volatile bool ready;
+	volatile int calls;
+	volatile bool stop;
+	void (*handler)(int);
+	int busy_ms;
+};
+
+static struct child children[2];
+
+static void handler0(int signo)
+{
+	ARG_UNUSED(signo);
+
+	++children[0].calls;
+}
+
+static void *grandchild(void *arg)
+{
+	struct child *c = arg;
+
+	c->grandchild_pid = getpid();
+
+	return NULL;
+}
+
+static void *child(void *arg)
+{
+	pthread_t th;
+	struct tms tms;
+	struct child *c = arg;
+	struct sigaction act = {.sa_handler = c->handler};
+	const char *env = getenv("DOMAIN");
+
+	c->pid = getpid();
+	c->ppid = getppid();
+	strncpy(c->env, (env == NULL) ? "" : env, sizeof(c->env) - 1);
+
+	/* threads that a domain creates stay in it */
+	zassert_ok(pthread_create(&th, NULL, grandchild, c));
+	zassert_ok(pthread_join(th, NULL));
+
+	zassert_ok(setenv("DOMAIN", (c == &children[0]) ? "zero" : "one", 1));
+	zassert_ok(sigaction(SIGUSR1, &act, NULL));
+	zassert_ok(sigaction(SIGUSR1, NULL, &c->act));
+
+	if (c->busy_ms > 0) {
+		k_busy_wait(c->busy_ms * USEC_PER_MSEC);
+	}
+	(void)times(&tms);
+	c->utime = tms.tms_utime;
+	c->ready = true;
+
+	while (!c->stop) {
+		k_msleep(1);
+	}
+
+	zassert_ok(unsetenv("DOMAIN"));
+
+	return NULL;
+}
+
+static void spawn(pthread_t *th, struct child *c)
+{
+	pid_t pid;
+
+	zassert_ok(pthread_spawn_np(&pid, th, NULL, child, c));
+	zassert_true(pid > 0);
+	zassert_not_equal(pid, getpid());
+
+	while (c->pid == 0) {
+		k_msleep(1);
+	}
+	zassert_equal(c->pid, pid);
+}
+
+static void domain_before(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	memset(children, 0, sizeof(children));
+}
+
+ZTEST(posix_multi_process_domains, test_domain_identity)
+{
+	pthread_t th[2];
+
+	children[0].handler = SIG_IGN;
+	children[1].handler = SIG_IGN;
+	spawn(&th[0], &children[0]);
+	spawn(&th[1], &children[1]);
+
+	zassert_not_equal(children[0].pid, children[1].pid);
+	zassert_equal(children[0].ppid, getpid());
+	zassert_equal(children[1].ppid, getpid());
+	zassert_equal(children[0].grandchild_pid, children[0].pid);
+	zassert_equal(children[1].grandchild_pid, children[1].pid);
+
+	children[0].stop = true;
+	children[1].stop = true;
+	zassert_ok(pthread_join(th[0], NULL));
+	zassert_ok(pthread_join(th[1], NULL));
+}
+
+ZTEST(posix_multi_process_domains, test_domain_environ)
+{
+	pthread_t th[2];
+
+	zassert_ok(setenv("DOMAIN", "init", 1));
+
+	children[0].handler = SIG_IGN;
+	children[1].handler = SIG_IGN;
+	spawn(&th[0], &children[0]);
+	spawn(&th[1], &children[1]);
+
+	/* each domain starts with a copy of the environment of its parent */
+	zassert_str_equal(children[0].env, "init");
+	zassert_str_equal(children[1].env, "init");
+
+	children[0].stop = true;
+	children[1].stop = true;
+	zassert_ok(pthread_join(th[0], NULL));
+	zassert_ok(pthread_join(th[1], NULL));
+
+	/* and changes to it stay in the domain */
+	zassert_str_equal(getenv("DOMAIN"), "init");
+	zassert_ok(unsetenv("DOMAIN"));
+}
+
+ZTEST(posix_multi_process_domains, test_domain_signals)
+{
+	pthread_t th[2];
+	struct sigaction act;
+
+	children[0].handler = handler0;
+	children[1].handler = SIG_IGN;
+	spawn(&th[0], &children[0]);
+	spawn(&th[1], &children[1]);
+
+	while (!children[0].ready || !children[1].ready) {
+		k_msleep(1);
+	}
+
+	/* dispositions are per domain */
+	zassert_equal(children[0].act.sa_handler, handler0);
+	zassert_equal(children[1].act.sa_handler, SIG_IGN);
+	zassert_ok(sigaction(SIGUSR1, NULL, &act));
+	zassert_equal(act.sa_handler, SIG_DFL);
+
+	/* a signal sent to a domain is handled with its disposition */
+	zassert_ok(kill(children[1].pid, SIGUSR1));
+	zassert_ok(kill(children[0].pid, SIGUSR1));
+	for (int i = 0; (i < 100) && (children[0].calls == 0); ++i) {
+		k_msleep(1);
+	}
+	zassert_equal(children[0].calls, 1);
+
+	children[0].stop = true;
+	children[1].stop = true;
+	zassert_ok(pthread_join(th[0], NULL));
+	zassert_ok(pthread_join(th[1], NULL));
+
+	act = (struct sigaction){.sa_handler = SIG_DFL};
+	zassert_ok(sigaction(SIGUSR1, &act, NULL));
+}
+
+ZTEST(posix_multi_process_domains, test_domain_times)
+{
+	pthread_t th[2];
+	struct tms before;
+	struct tms after;
+	const clock_t busy = BUSY_MS * USEC_PER_MSEC;
+
+	children[0].handler = SIG_IGN;
+	children[1].handler = SIG_IGN;
+	children[0].busy_ms = BUSY_MS;
+
+	zassert_not_equal(times(&before), (clock_t)-1);
+	spawn(&th[0], &children[0]);
+	spawn(&th[1], &children[1]);
+
+	while (!children[0].ready || !children[1].ready) {
+		k_msleep(1);
+	}
+
+	/* only the busy domain is charged for its busy wait */
+	zassert_true(children[0].utime >= busy, "utime %ld < %ld", (long)children[0].utime,
+		     (long)busy);
+	zassert_true(children[1].utime < busy / 2, "utime %ld >= %ld", (long)children[1].utime,
+		     (long)(busy / 2));
+
+	children[0].stop = true;
+	children[1].stop = true;
+	zassert_ok(pthread_join(th[0], NULL));
+	zassert_ok(pthread_join(th[1], NULL));
+
+	/* the time of domains that have gone away is the time of the children of their parent */
+	zassert_not_equal(times(&after), (clock_t)-1);
+	zassert_true(after.tms_cutime - before.tms_cutime >= busy);
+	zassert_true(after.tms_utime - before.tms_utime < busy / 2);
+}
+
+ZTEST_SUITE(posix_multi_process_domains, NULL, NULL, domain_before, NULL, NULL);
+
+#endif /* CONFIG_POSIX_PROCESS_DOMAINS */
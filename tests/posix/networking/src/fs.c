@@ -26,7 +26,11 @@ struct _entry {
 };
 
 static const struct _entry _data[] = {
-	{.name = "/etc/hosts", .data = "127.0.0.1 localhost\n"},
+	{.name = "/etc/hosts",
+	 .data = "127.0.0.1 localhost\n"
+		 "# resolver tests\n"
+		 "192.0.2.1 hosts.test alias.test\n"
+		 "2001:db8::1 hosts.test\n"},
 	{.name = "/etc/protocols", .data = "tcp 6 TCP\nudp 17 UDP\n"},
 	{.name = "/etc/services", .data = "http 80/tcp\n"},
 	{.name = "/etc/networks", .data = "link 0\n"},
@@ -0,0 +1,279 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <ifaddrs.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/select.h>
+#include <unistd.h>
+
+#include <net/if.h>
+
+#include "test_net.h"
+#include "../../common/linux_compat_test.h"
+
+ZTEST(posix_networking, test_getifaddrs)
+{
+	bool found = false;
+	struct ifaddrs *ifa;
+	struct sockaddr_in *sin;
+
+	zassert_ok(getifaddrs(&ifa), "getifaddrs() failed: %d", errno);
+
+	for (struct ifaddrs *p = ifa; p != NULL; p = p->ifa_next) {
+		zassert_not_null(p->ifa_name);
+		zassert_not_equal(0, if_nametoindex(p->ifa_name), "unknown interface %s",
+				  p->ifa_name);
+
+		if ((p->ifa_addr == NULL) || (p->ifa_addr->sa_family != AF_INET)) {
+			continue;
+		}
+
+		sin = (struct sockaddr_in *)p->ifa_addr;
+		if (sin->sin_addr.s_addr == htonl(0x7f000001)) {
+			found = true;
+			zassert_not_null(p->ifa_netmask);
+			zassert_equal(AF_INET, p->ifa_netmask->sa_family);
+			IF_NOT_NATIVE_LIBC({
+				zassert_equal(IFF_UP | IFF_RUNNING | IFF_LOOPBACK, p->ifa_flags);
+			});
+		}
+	}
+
+	zassert_true(found, "%s not found", TEST_LOOPBACK);
+
+	freeifaddrs(ifa);
+}
+
+#ifdef CONFIG_POSIX_IF_NOTIFY
+
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_l2.h>
+
+#define VIF_ADDR    "192.0.2.1"
+#define VIF_ADDR_V6 "2001:db8::1"
+
+/* a virtual interface that drops what is sent, so that it can be taken down and readdressed */
+static int vif_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static void vif_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = {0x02, 0x00, 0x5e, 0x00, 0x53, 0x01};
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static const struct dummy_api vif_api = {
+	.iface_api.init = vif_iface_init,
+	.send = vif_send,
+};
+
+NET_DEVICE_INIT(posix_vif, "posix_vif", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &vif_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), NET_IPV6_MTU);
+
+static struct net_if *vif_get(void)
+{
+	struct net_if *iface = net_if_lookup_by_dev(DEVICE_GET(posix_vif));
+
+	zassert_not_null(iface);
+
+	return iface;
+}
+
+static bool addr_equal(const struct sockaddr *sa, const char *addr)
+{
+	uint8_t buf[sizeof(struct in6_addr)];
+
+	switch (sa->sa_family) {
+	case AF_INET:
+		return (inet_pton(AF_INET, addr, buf) == 1) &&
+		       (memcmp(&((const struct sockaddr_in *)sa)->sin_addr, buf,
+			       sizeof(struct in_addr)) == 0);
+	case AF_INET6:
+		return (inet_pton(AF_INET6, addr, buf) == 1) &&
+		       (memcmp(&((const struct sockaddr_in6 *)sa)->sin6_addr, buf,
+			       sizeof(struct in6_addr)) == 0);
+	default:
+		return false;
+	}
+}
+
+/* skip records of other events, e.g. link-local addresses configured by the stack */
+static void expect_record(int fd, int type, struct net_if *iface, const char *addr,
+			  struct if_notification *out)
+{
+	struct if_notification rec;
+	struct pollfd pfd = {.fd = fd, .events = POLLIN};
+
+	while (true) {
+		zassert_equal(1, poll(&pfd, 1, 1000), "no record of type %d", type);
+		zassert_equal(POLLIN, pfd.revents);
+		zassert_equal(sizeof(rec), read(fd, &rec, sizeof(rec)));
+
+		if ((rec.ifn_type == type) && (rec.ifn_index == net_if_get_by_iface(iface)) &&
+		    ((addr == NULL) || addr_equal(&rec.ifn_addr.sa, addr))) {
+			break;
+		}
+	}
+
+	if (out != NULL) {
+		*out = rec;
+	}
+}
+
+static bool vif_has_addr(const char *addr)
+{
+	bool found = false;
+	struct ifaddrs *ifa;
+	char name[IF_NAMESIZE];
+
+	zassert_not_null(if_indextoname(net_if_get_by_iface(vif_get()), name));
+	zassert_ok(getifaddrs(&ifa));
+	for (struct ifaddrs *p = ifa; p != NULL; p = p->ifa_next) {
+		if ((strcmp(p->ifa_name, name) == 0) && (p->ifa_addr != NULL)) {
+			found |= addr_equal(p->ifa_addr, addr);
+		}
+	}
+	freeifaddrs(ifa);
+
+	return found;
+}
+
+ZTEST(posix_networking, test_if_notify_link)
+{
+	int fd;
+	fd_set rfds;
+	struct if_notification rec;
+	struct net_if *iface = vif_get();
+	struct timeval tv = {.tv_sec = 1};
+
+	fd = if_notify(IFN_LINK, IFN_NONBLOCK);
+	zassert_true(fd >= 0, "if_notify() failed: %d", errno);
+
+	zassert_ok(net_if_down(iface));
+	expect_record(fd, IFN_LINK_DOWN, iface, NULL, &rec);
+	zassert_equal(0, rec.ifn_flags & IFF_RUNNING);
+
+	zassert_ok(net_if_up(iface));
+
+	/* select() reports the descriptor as readable as well */
+	FD_ZERO(&rfds);
+	FD_SET(fd, &rfds);
+	zassert_equal(1, select(fd + 1, &rfds, NULL, NULL, &tv));
+	zassert_true(FD_ISSET(fd, &rfds));
+
+	expect_record(fd, IFN_LINK_UP, iface, NULL, &rec);
+	zassert_equal(IFF_UP, rec.ifn_flags & IFF_UP);
+
+	zassert_ok(close(fd));
+}
+
+ZTEST(posix_networking, test_if_notify_addr)
+{
+	int fd;
+	struct net_in_addr a4;
+	struct net_in6_addr a6;
+	struct if_notification rec;
+	struct net_if *iface = vif_get();
+
+	zassert_ok(net_addr_pton(NET_AF_INET, VIF_ADDR, &a4));
+	zassert_ok(net_addr_pton(NET_AF_INET6, VIF_ADDR_V6, &a6));
+
+	fd = if_notify(IFN_ADDR, IFN_NONBLOCK);
+	zassert_true(fd >= 0, "if_notify() failed: %d", errno);
+
+	zassert_not_null(net_if_ipv4_addr_add(iface, &a4, NET_ADDR_MANUAL, 0));
+	expect_record(fd, IFN_ADDR_ADD, iface, VIF_ADDR, &rec);
+	zassert_equal(AF_INET, rec.ifn_addr.sa.sa_family);
+	zassert_true(vif_has_addr(VIF_ADDR));
+
+	zassert_true(net_if_ipv4_addr_rm(iface, &a4));
+	expect_record(fd, IFN_ADDR_DEL, iface, VIF_ADDR, NULL);
+	zassert_false(vif_has_addr(VIF_ADDR));
+
+	zassert_not_null(net_if_ipv6_addr_add(iface, &a6, NET_ADDR_MANUAL, 0));
+	expect_record(fd, IFN_ADDR_ADD, iface, VIF_ADDR_V6, &rec);
+	zassert_equal(AF_INET6, rec.ifn_addr.sa.sa_family);
+
+	zassert_true(net_if_ipv6_addr_rm(iface, &a6));
+	expect_record(fd, IFN_ADDR_DEL, iface, VIF_ADDR_V6, NULL);
+
+	zassert_ok(close(fd));
+}
+
+ZTEST(posix_networking, test_if_notify_overflow)
+{
+	int fd;
+	ssize_t ret;
+	size_t n = 0;
+	struct net_in_addr a4;
+	struct if_notification rec;
+	struct net_if *iface = vif_get();
+
+	zassert_ok(net_addr_pton(NET_AF_INET, VIF_ADDR, &a4));
+
+	fd = if_notify(IFN_ADDR, IFN_NONBLOCK);
+	zassert_true(fd >= 0, "if_notify() failed: %d", errno);
+
+	for (int i = 0; i < CONFIG_POSIX_IF_NOTIFY_QUEUE_SIZE; ++i) {
+		zassert_not_null(net_if_ipv4_addr_add(iface, &a4, NET_ADDR_MANUAL, 0));
+		zassert_true(net_if_ipv4_addr_rm(iface, &a4));
+	}
+	/* let the net_mgmt thread deliver the events */
+	k_msleep(100);
+
+	do {
+		ret = read(fd, &rec, sizeof(rec));
+		zassert_equal(sizeof(rec), ret, "read() failed: %d", errno);
+		++n;
+	} while (rec.ifn_type != IFN_OVERFLOW);
+
+	zassert_equal(CONFIG_POSIX_IF_NOTIFY_QUEUE_SIZE + 1, n);
+	zassert_equal(0, rec.ifn_index);
+
+	/* records are queued again once the overflow has been reported */
+	zassert_equal(-1, read(fd, &rec, sizeof(rec)));
+	zassert_equal(EAGAIN, errno);
+	zassert_not_null(net_if_ipv4_addr_add(iface, &a4, NET_ADDR_MANUAL, 0));
+	expect_record(fd, IFN_ADDR_ADD, iface, VIF_ADDR, NULL);
+	zassert_true(net_if_ipv4_addr_rm(iface, &a4));
+
+	zassert_ok(close(fd));
+}
+
+ZTEST(posix_networking, test_if_notify_einval)
+{
+	int fd;
+	struct if_notification rec;
+
+	zassert_equal(-1, if_notify(0, 0));
+	zassert_equal(EINVAL, errno);
+	zassert_equal(-1, if_notify(~(IFN_LINK | IFN_ADDR), 0));
+	zassert_equal(EINVAL, errno);
+	zassert_equal(-1, if_notify(IFN_LINK, ~IFN_NONBLOCK));
+	zassert_equal(EINVAL, errno);
+
+	fd = if_notify(IFN_LINK | IFN_ADDR, IFN_NONBLOCK);
+	zassert_true(fd >= 0, "if_notify() failed: %d", errno);
+
+	/* records are only read whole */
+	zassert_equal(-1, read(fd, &rec, sizeof(rec) - 1));
+	zassert_equal(EINVAL, errno);
+	zassert_equal(-1, read(fd, &rec, sizeof(rec)));
+	zassert_equal(EAGAIN, errno);
+
+	zassert_ok(close(fd));
+}
+
+#endif /* CONFIG_POSIX_IF_NOTIFY */
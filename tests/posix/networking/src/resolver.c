@@ -0,0 +1,327 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/ztest.h>
+
+#include "test_net.h"
+
+#ifdef CONFIG_POSIX_RESOLVER_CACHE
+
+/* must match CONFIG_DNS_SERVER1 */
+#define DNS_PORT 5353
+
+#define DNS_HDR_LEN        12
+#define DNS_ANSWER_LEN     12
+#define DNS_TYPE_A         1
+#define DNS_RCODE_NXDOMAIN 3
+
+/* time for which the server waits for a second query before answering the first */
+#define PARALLEL_WAIT_MS 500
+
+#define SERVER_STACK_SIZE 2048
+
+static K_THREAD_STACK_DEFINE(server_stack, SERVER_STACK_SIZE);
+static struct k_thread server_thread;
+static int server_sock = -1;
+static atomic_t queries;
+static atomic_t parallel_seen;
+
+static const uint8_t cached_v4[4] = {192, 0, 2, 10};
+static const uint8_t cached_v6[16] = {0x20, 0x01, 0x0d, 0xb8, [15] = 0x10};
+static const uint8_t v4only_v4[4] = {192, 0, 2, 20};
+
+/* decode the question of @p msg into @p name, returning the offset of its type or 0 */
+static size_t dns_question(const uint8_t *msg, size_t len, char *name, size_t size)
+{
+	size_t off = DNS_HDR_LEN;
+	size_t n = 0;
+
+	while ((off < len) && (msg[off] != 0)) {
+		uint8_t label = msg[off++];
+
+		if ((off + label > len) || (n + label + 1 >= size)) {
+			return 0;
+		}
+
+		if (n > 0) {
+			name[n++] = '.';
+		}
+		memcpy(&name[n], &msg[off], label);
+		n += label;
+		off += label;
+	}
+
+	name[n] = '\0';
+
+	return (off + 5 <= len) ? off + 1 : 0;
+}
+
+static void dns_reply(const uint8_t *query, size_t len, const struct sockaddr *from,
+		      socklen_t fromlen)
+{
+	uint16_t type;
+	size_t qend;
+	size_t off;
+	char name[64];
+	uint8_t rsp[256];
+	const uint8_t *rdata = NULL;
+	size_t rdlen = 0;
+	uint8_t rcode = 0;
+
+	qend = dns_question(query, len, name, sizeof(name));
+	if ((qend == 0) || (qend + 4 + DNS_ANSWER_LEN + sizeof(cached_v6) > sizeof(rsp))) {
+		return;
+	}
+
+	type = sys_get_be16(&query[qend]);
+	qend += 4;
+
+	if (strcmp(name, "cached.test") == 0 || strcmp(name, "parallel.test") == 0) {
+		rdata = (type == DNS_TYPE_A) ? cached_v4 : cached_v6;
+		rdlen = (type == DNS_TYPE_A) ? sizeof(cached_v4) : sizeof(cached_v6);
+	} else if (strcmp(name, "v4only.test") == 0) {
+		/* NODATA for AAAA */
+		rdata = (type == DNS_TYPE_A) ? v4only_v4 : NULL;
+		rdlen = (type == DNS_TYPE_A) ? sizeof(v4only_v4) : 0;
+	} else {
+		rcode = DNS_RCODE_NXDOMAIN;
+	}
+
+	memcpy(rsp, query, qend);
+	/* QR, RD and RA, with the response code */
+	rsp[2] = 0x80 | (query[2] & 0x01);
+	rsp[3] = 0x80 | rcode;
+	sys_put_be16(0, &rsp[6]);
+	sys_put_be16(0, &rsp[8]);
+	sys_put_be16(0, &rsp[10]);
+	off = qend;
+
+	if (rdata != NULL) {
+		sys_put_be16(1, &rsp[6]);
+		/* pointer to the name in the question */
+		sys_put_be16(0xc000 | DNS_HDR_LEN, &rsp[off]);
+		sys_put_be16(type, &rsp[off + 2]);
+		sys_put_be16(1, &rsp[off + 4]);
+		sys_put_be32(300, &rsp[off + 6]);
+		sys_put_be16(rdlen, &rsp[off + 10]);
+		memcpy(&rsp[off + DNS_ANSWER_LEN], rdata, rdlen);
+		off += DNS_ANSWER_LEN + rdlen;
+	}
+
+	(void)sendto(server_sock, rsp, off, 0, from, fromlen);
+}
+
+static void dns_server(void *p1, void *p2, void *p3)
+{
+	ssize_t len;
+	char name[64];
+	uint8_t held[256];
+	uint8_t query[256];
+	struct sockaddr_storage from;
+	socklen_t fromlen;
+	struct pollfd pfd = {.fd = server_sock, .events = POLLIN};
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		fromlen = sizeof(from);
+		len = recvfrom(server_sock, query, sizeof(query), 0, (struct sockaddr *)&from,
+			       &fromlen);
+		if (len < DNS_HDR_LEN) {
+			continue;
+		}
+
+		atomic_inc(&queries);
+
+		if ((dns_question(query, len, name, sizeof(name)) != 0) &&
+		    (strcmp(name, "parallel.test") == 0) && !atomic_get(&parallel_seen)) {
+			/* hold the first query back to see whether the second one is already sent */
+			memcpy(held, query, len);
+			if (poll(&pfd, 1, PARALLEL_WAIT_MS) == 1) {
+				atomic_set(&parallel_seen, 1);
+			}
+			dns_reply(held, len, (struct sockaddr *)&from, fromlen);
+			continue;
+		}
+
+		dns_reply(query, len, (struct sockaddr *)&from, fromlen);
+	}
+}
+
+static void dns_server_start(void)
+{
+	struct sockaddr_in addr;
+
+	res_flush();
+	atomic_set(&queries, 0);
+
+	if (server_sock >= 0) {
+		return;
+	}
+
+	prepare_sockaddr_in(&addr, DNS_PORT);
+	server_sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(server_sock >= 0, "socket failed: %d", errno);
+	zassert_ok(bind(server_sock, (struct sockaddr *)&addr, sizeof(addr)));
+
+	k_thread_create(&server_thread, server_stack, K_THREAD_STACK_SIZEOF(server_stack),
+			dns_server, NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+}
+
+static size_t count_results(struct addrinfo *res, int family)
+{
+	size_t n = 0;
+
+	for (; res != NULL; res = res->ai_next) {
+		n += (family == AF_UNSPEC) || (res->ai_family == family);
+	}
+
+	return n;
+}
+
+ZTEST(posix_networking, test_resolver_cache)
+{
+	struct addrinfo *res = NULL;
+	struct sockaddr_in *sin;
+
+	dns_server_start();
+
+	/* A and AAAA are queried for AF_UNSPEC */
+	zassert_ok(getaddrinfo("cached.test", "80", NULL, &res));
+	zassert_equal(2, atomic_get(&queries));
+	zassert_equal(1, count_results(res, AF_INET));
+	zassert_equal(1, count_results(res, AF_INET6));
+	zassert_equal(AF_INET, res->ai_family);
+	sin = (struct sockaddr_in *)res->ai_addr;
+	zassert_equal(htons(80), sin->sin_port);
+	zassert_mem_equal(cached_v4, &sin->sin_addr, sizeof(cached_v4));
+	freeaddrinfo(res);
+
+	/* later lookups, in any case, are served from the cache */
+	zassert_ok(getaddrinfo("CACHED.test", NULL, NULL, &res));
+	zassert_equal(2, count_results(res, AF_UNSPEC));
+	freeaddrinfo(res);
+	zassert_equal(2, atomic_get(&queries));
+
+	res_flush();
+	zassert_ok(getaddrinfo("cached.test", NULL, NULL, &res));
+	freeaddrinfo(res);
+	zassert_equal(4, atomic_get(&queries));
+}
+
+ZTEST(posix_networking, test_resolver_negative_cache)
+{
+	struct addrinfo *res = NULL;
+	struct addrinfo hints = {
+		.ai_family = AF_INET6,
+	};
+
+	dns_server_start();
+
+	zassert_equal(EAI_NONAME, getaddrinfo("missing.test", NULL, NULL, &res));
+	zassert_equal(2, atomic_get(&queries));
+	zassert_equal(EAI_NONAME, getaddrinfo("missing.test", NULL, NULL, &res));
+	zassert_equal(2, atomic_get(&queries));
+
+	/* NODATA for one family does not hide the addresses of the other */
+	zassert_ok(getaddrinfo("v4only.test", NULL, NULL, &res));
+	zassert_equal(1, count_results(res, AF_UNSPEC));
+	zassert_equal(AF_INET, res->ai_family);
+	freeaddrinfo(res);
+	zassert_equal(4, atomic_get(&queries));
+
+	zassert_equal(EAI_NONAME, getaddrinfo("v4only.test", NULL, &hints, &res));
+	zassert_equal(4, atomic_get(&queries));
+}
+
+ZTEST(posix_networking, test_resolver_parallel)
+{
+	struct addrinfo *res = NULL;
+
+	dns_server_start();
+	atomic_set(&parallel_seen, 0);
+
+	zassert_ok(getaddrinfo("parallel.test", NULL, NULL, &res));
+	zassert_equal(2, count_results(res, AF_UNSPEC));
+	freeaddrinfo(res);
+
+	zassert_true(atomic_get(&parallel_seen), "AAAA was not queried before A was answered");
+}
+
+ZTEST(posix_networking, test_resolver_hosts)
+{
+	struct addrinfo *res = NULL;
+	struct sockaddr_in *sin;
+	struct addrinfo hints = {
+		.ai_family = AF_INET,
+		.ai_socktype = SOCK_DGRAM,
+	};
+
+	dns_server_start();
+
+	zassert_ok(getaddrinfo("alias.test", "53", &hints, &res));
+	zassert_equal(1, count_results(res, AF_UNSPEC));
+	zassert_equal(SOCK_DGRAM, res->ai_socktype);
+	sin = (struct sockaddr_in *)res->ai_addr;
+	zassert_equal(htons(53), sin->sin_port);
+	zassert_equal(htonl(0xc0000201), sin->sin_addr.s_addr);
+	freeaddrinfo(res);
+
+	zassert_ok(getaddrinfo("hosts.test", NULL, NULL, &res));
+	zassert_equal(1, count_results(res, AF_INET));
+	zassert_equal(1, count_results(res, AF_INET6));
+	freeaddrinfo(res);
+
+	/* /etc/hosts is consulted before any DNS server */
+	zassert_equal(0, atomic_get(&queries));
+}
+
+ZTEST(posix_networking, test_resolver_getnameinfo)
+{
+	struct addrinfo *res = NULL;
+	struct sockaddr_in addr;
+	char host[NI_MAXHOST];
+
+	dns_server_start();
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+
+	addr.sin_addr.s_addr = htonl(0xc0000201);
+	zassert_ok(getnameinfo((struct sockaddr *)&addr, sizeof(addr), host, sizeof(host), NULL,
+			       0, 0));
+	zassert_str_equal("hosts.test", host);
+	zassert_ok(getnameinfo((struct sockaddr *)&addr, sizeof(addr), host, sizeof(host), NULL,
+			       0, NI_NUMERICHOST));
+	zassert_str_equal("192.0.2.1", host);
+
+	/* names of cached answers are known too */
+	zassert_ok(getaddrinfo("cached.test", NULL, NULL, &res));
+	freeaddrinfo(res);
+	memcpy(&addr.sin_addr, cached_v4, sizeof(cached_v4));
+	zassert_ok(getnameinfo((struct sockaddr *)&addr, sizeof(addr), host, sizeof(host), NULL,
+			       0, 0));
+	zassert_str_equal("cached.test", host);
+
+	addr.sin_addr.s_addr = htonl(0xc0000263);
+	zassert_ok(getnameinfo((struct sockaddr *)&addr, sizeof(addr), host, sizeof(host), NULL,
+			       0, 0));
+	zassert_str_equal("192.0.2.99", host);
+	zassert_equal(EAI_NONAME, getnameinfo((struct sockaddr *)&addr, sizeof(addr), host,
+					      sizeof(host), NULL, 0, NI_NAMEREQD));
+}
+
+#endif /* CONFIG_POSIX_RESOLVER_CACHE */
@@ -0,0 +1,209 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "test_net.h"
+
+#define TEST_SENDFILE_FILE "/sendfile.bin"
+#define TEST_SENDFILE_SIZE 600
+
+static uint8_t pattern[TEST_SENDFILE_SIZE];
+
+static int create_file(void)
+{
+	int fd;
+
+	for (size_t i = 0; i < sizeof(pattern); ++i) {
+		pattern[i] = (uint8_t)(i * 7);
+	}
+
+	fd = open(TEST_SENDFILE_FILE, O_CREAT | O_TRUNC | O_RDWR, 0660);
+	zassert_true(fd >= 0, "open() failed: %d", errno);
+	zassert_equal(sizeof(pattern), write(fd, pattern, sizeof(pattern)));
+	zassert_equal(0, lseek(fd, 0, SEEK_SET));
+
+	return fd;
+}
+
+static void recv_expect(int sock, const uint8_t *expected, size_t len)
+{
+	ssize_t ret;
+	size_t done = 0;
+	static uint8_t buf[TEST_SENDFILE_SIZE];
+
+	zassert_true(len <= sizeof(buf));
+
+	while (done < len) {
+		ret = read(sock, &buf[done], len - done);
+		zassert_true(ret > 0, "read() failed: %d", errno);
+		done += ret;
+	}
+
+	zassert_mem_equal(expected, buf, len);
+}
+
+ZTEST(posix_networking, test_sendfile)
+{
+	int fd;
+	int sv[2];
+	off_t off;
+
+	fd = create_file();
+	zassert_ok(socketpair(AF_UNIX, SOCK_STREAM, 0, sv));
+
+	/* without an offset, the file position is used and advanced */
+	zassert_equal(TEST_SENDFILE_SIZE, sendfile(sv[0], fd, NULL, TEST_SENDFILE_SIZE));
+	zassert_equal(TEST_SENDFILE_SIZE, lseek(fd, 0, SEEK_CUR));
+	recv_expect(sv[1], pattern, TEST_SENDFILE_SIZE);
+
+	/* with an offset, the offset is advanced and the file position is left alone */
+	zassert_equal(0, lseek(fd, 0, SEEK_SET));
+	off = 100;
+	zassert_equal(200, sendfile(sv[0], fd, &off, 200));
+	zassert_equal(300, off);
+	zassert_equal(0, lseek(fd, 0, SEEK_CUR));
+	recv_expect(sv[1], &pattern[100], 200);
+
+	/* transfers stop at end-of-file */
+	off = TEST_SENDFILE_SIZE - 10;
+	zassert_equal(10, sendfile(sv[0], fd, &off, 100));
+	zassert_equal(TEST_SENDFILE_SIZE, off);
+	recv_expect(sv[1], &pattern[TEST_SENDFILE_SIZE - 10], 10);
+	zassert_equal(0, sendfile(sv[0], fd, &off, 100));
+
+	zassert_ok(close(sv[0]));
+	zassert_ok(close(sv[1]));
+	zassert_ok(close(fd));
+	zassert_ok(unlink(TEST_SENDFILE_FILE));
+}
+
+ZTEST(posix_networking, test_sendfile_errors)
+{
+	int fd;
+	int sv[2];
+	off_t off = -1;
+
+	fd = create_file();
+	zassert_ok(socketpair(AF_UNIX, SOCK_STREAM, 0, sv));
+
+	zassert_equal(-1, sendfile(sv[0], -1, NULL, 1));
+	zassert_equal(EBADF, errno);
+
+	zassert_equal(-1, sendfile(sv[0], fd, &off, 1));
+	zassert_equal(EINVAL, errno);
+
+	/* the input must be seekable */
+	zassert_equal(-1, sendfile(sv[0], sv[1], NULL, 1));
+	zassert_equal(EINVAL, errno);
+
+	zassert_ok(close(sv[0]));
+	zassert_ok(close(sv[1]));
+	zassert_ok(close(fd));
+	zassert_ok(unlink(TEST_SENDFILE_FILE));
+}
+
+#ifndef CONFIG_NATIVE_LIBC
+static K_THREAD_STACK_DEFINE(stall_stack, 2048);
+static struct k_thread stall_thread;
+
+static void stall(void *p1, void *p2, void *p3)
+{
+	off_t off = 0;
+
+	ARG_UNUSED(p3);
+
+	(void)sendfile(POINTER_TO_INT(p1), POINTER_TO_INT(p2), &off, TEST_SENDFILE_SIZE);
+}
+
+/* A transfer that is stalled on a full socket, with the only bounce buffer, holds up no other */
+ZTEST(posix_networking, test_sendfile_stalled)
+{
+	int fd;
+	int sv[2];
+	int full[2];
+	ssize_t ret;
+	off_t off = 0;
+	static uint8_t junk[64];
+
+	fd = create_file();
+	zassert_ok(socketpair(AF_UNIX, SOCK_STREAM, 0, full));
+	zassert_ok(socketpair(AF_UNIX, SOCK_STREAM, 0, sv));
+
+	/* fill the socket, so that the next transfer to it blocks */
+	zassert_ok(fcntl(full[0], F_SETFL, O_NONBLOCK));
+	do {
+		ret = write(full[0], junk, sizeof(junk));
+	} while (ret > 0);
+	zassert_equal(EAGAIN, errno);
+	zassert_ok(fcntl(full[0], F_SETFL, 0));
+
+	k_thread_create(&stall_thread, stall_stack, K_THREAD_STACK_SIZEOF(stall_stack), stall,
+			INT_TO_POINTER(full[0]), INT_TO_POINTER(fd), NULL, K_PRIO_PREEMPT(1), 0,
+			K_NO_WAIT);
+	k_msleep(100);
+
+	zassert_equal(TEST_SENDFILE_SIZE, sendfile(sv[0], fd, &off, TEST_SENDFILE_SIZE));
+	zassert_equal(TEST_SENDFILE_SIZE, off);
+	recv_expect(sv[1], pattern, TEST_SENDFILE_SIZE);
+
+	/* drain the full socket until the stalled transfer is over */
+	zassert_ok(fcntl(full[1], F_SETFL, O_NONBLOCK));
+	while (k_thread_join(&stall_thread, K_MSEC(10)) != 0) {
+		(void)read(full[1], junk, sizeof(junk));
+	}
+
+	zassert_ok(close(full[0]));
+	zassert_ok(close(full[1]));
+	zassert_ok(close(sv[0]));
+	zassert_ok(close(sv[1]));
+	zassert_ok(close(fd));
+	zassert_ok(unlink(TEST_SENDFILE_FILE));
+}
+
+ZTEST(posix_networking, test_splice)
+{
+	int fd;
+	int sv[2];
+	off_t off;
+	uint8_t buf[sizeof(TEST_MSG) - 1];
+
+	fd = create_file();
+	zassert_ok(socketpair(AF_UNIX, SOCK_STREAM, 0, sv));
+
+	/* socket to file, at an offset */
+	zassert_equal(strlen(TEST_MSG), write(sv[0], TEST_MSG, strlen(TEST_MSG)));
+	off = 10;
+	zassert_equal(strlen(TEST_MSG), splice(sv[1], NULL, fd, &off, 64, SPLICE_F_MOVE));
+	zassert_equal(10 + strlen(TEST_MSG), off);
+	zassert_equal(0, lseek(fd, 0, SEEK_CUR));
+	zassert_equal(sizeof(buf), pread(fd, buf, sizeof(buf), 10));
+	zassert_mem_equal(TEST_MSG, buf, sizeof(buf));
+
+	/* file to socket, from the file position */
+	zassert_equal(10, lseek(fd, 10, SEEK_SET));
+	zassert_equal(strlen(TEST_MSG), splice(fd, NULL, sv[0], NULL, strlen(TEST_MSG), 0));
+	zassert_equal(10 + strlen(TEST_MSG), lseek(fd, 0, SEEK_CUR));
+	recv_expect(sv[1], (const uint8_t *)TEST_MSG, strlen(TEST_MSG));
+
+	/* sockets cannot be used at an offset */
+	off = 0;
+	zassert_equal(-1, splice(sv[1], &off, fd, NULL, 1, 0));
+	zassert_equal(ESPIPE, errno);
+
+	zassert_equal(-1, splice(fd, NULL, sv[0], NULL, 1, 0x80));
+	zassert_equal(EINVAL, errno);
+
+	zassert_ok(close(sv[0]));
+	zassert_ok(close(sv[1]));
+	zassert_ok(close(fd));
+	zassert_ok(unlink(TEST_SENDFILE_FILE));
+}
+#endif
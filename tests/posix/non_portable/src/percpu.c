@@ -0,0 +1,132 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#include "percpu_priv.h"
+
+#define PERCPU_THREADS    MIN(CONFIG_MP_MAX_NUM_CPUS, 4)
+#define PERCPU_ITERATIONS 1000
+
+ZTEST(posix_non_portable, test_sched_getcpu)
+{
+	unsigned int key;
+	int cpu = sched_getcpu();
+
+	zassert_true((cpu >= 0) && ((unsigned int)cpu < arch_num_cpus()), "cpu %d", cpu);
+
+	/* the CPU does not change while interrupts are locked */
+	key = irq_lock();
+	zassert_equal(sched_getcpu(), sched_getcpu());
+	zassert_equal(sched_getcpu(), (int)arch_curr_cpu()->id);
+	irq_unlock(key);
+}
+
+#ifdef CONFIG_POSIX_PERCPU
+
+static atomic_t *percpu_counter;
+
+static void *percpu_adder(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	for (int i = 0; i < PERCPU_ITERATIONS; ++i) {
+		posix_percpu_add(percpu_counter, 1);
+	}
+
+	return NULL;
+}
+
+static void percpu_check_aligned(unsigned int cpu, void *data, void *user_data)
+{
+	unsigned int *count = user_data;
+
+	zassert_equal(data, posix_percpu_get(percpu_counter, cpu));
+	zassert_equal((uintptr_t)data % __alignof__(atomic_t), 0);
+	++*count;
+}
+
+ZTEST(posix_non_portable, test_percpu_counter)
+{
+	unsigned int count = 0;
+	pthread_t th[PERCPU_THREADS];
+
+	if (CONFIG_SYS_THREAD_STACK_MAX == 0) {
+		ztest_test_skip();
+	}
+
+	if (percpu_counter == NULL) {
+		percpu_counter = posix_percpu_alloc(sizeof(atomic_t), __alignof__(atomic_t));
+	}
+	zassert_not_null(percpu_counter);
+
+	/* the copies of the CPUs are in different cache lines */
+	if (arch_num_cpus() > 1) {
+		zassert_true((uintptr_t)posix_percpu_get(percpu_counter, 1) -
+				     (uintptr_t)posix_percpu_get(percpu_counter, 0) >=
+			     POSIX_PERCPU_ALIGN);
+	}
+
+	posix_percpu_foreach(percpu_counter, percpu_check_aligned, &count);
+	zassert_equal(count, arch_num_cpus());
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); ++cpu) {
+		atomic_clear(posix_percpu_get(percpu_counter, cpu));
+	}
+
+	ARRAY_FOR_EACH(th, i) {
+		zassert_ok(pthread_create(&th[i], NULL, percpu_adder, NULL));
+	}
+
+	ARRAY_FOR_EACH(th, i) {
+		zassert_ok(pthread_join(th[i], NULL));
+	}
+
+	zassert_equal(posix_percpu_sum(percpu_counter), PERCPU_THREADS * PERCPU_ITERATIONS);
+
+	/* the area is never freed, so requests beyond it fail */
+	zassert_is_null(posix_percpu_alloc(POSIX_PERCPU_STRIDE + 1, 1));
+	zassert_is_null(posix_percpu_alloc(1, 3));
+}
+
+#endif /* CONFIG_POSIX_PERCPU */
+
+#ifdef CONFIG_POSIX_STATS
+
+static atomic_val_t stat_total(enum posix_stat stat)
+{
+	atomic_val_t total = 0;
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); ++cpu) {
+		total += posix_stat_get(stat, cpu);
+	}
+
+	return total;
+}
+
+ZTEST(posix_non_portable, test_posix_stats)
+{
+	pthread_spinlock_t lock;
+	atomic_val_t allocs = stat_total(POSIX_STAT_POOL_ALLOC);
+	atomic_val_t frees = stat_total(POSIX_STAT_POOL_FREE);
+
+	/* a spin lock is allocated from, and given back to, a pool */
+	zassert_ok(pthread_spin_init(&lock, PTHREAD_PROCESS_PRIVATE));
+	zassert_ok(pthread_spin_destroy(&lock));
+
+	zassert_true(stat_total(POSIX_STAT_POOL_ALLOC) > allocs);
+	zassert_true(stat_total(POSIX_STAT_POOL_FREE) > frees);
+	zassert_equal(posix_stat_get(POSIX_STAT_POOL_ALLOC, arch_num_cpus()), 0);
+	zassert_str_equal(posix_stat_name(POSIX_STAT_SIG_CAUGHT), "sig_caught");
+}
+
+#endif /* CONFIG_POSIX_STATS */
@@ -0,0 +1,203 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdint.h>
+#include <time.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/posix/posix_tracing.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+/* the CTF variant only checks that the traced calls still work */
+#if defined(CONFIG_POSIX_TRACING) && defined(CONFIG_TRACING_USER)
+
+enum trace_kind {
+	TRACE_ENTER,
+	TRACE_BLOCKING,
+	TRACE_EXIT,
+};
+
+struct trace_event {
+	enum trace_kind kind;
+	enum sys_trace_posix_call call;
+	uintptr_t obj;
+	k_timeout_t timeout;
+	int err;
+};
+
+static struct k_spinlock trace_lock;
+static struct trace_event trace_events[32];
+static size_t trace_count;
+static bool trace_on;
+
+static void trace_record(enum trace_kind kind, enum sys_trace_posix_call call, uintptr_t obj,
+			 k_timeout_t timeout, int err)
+{
+	K_SPINLOCK(&trace_lock) {
+		if (trace_on && (trace_count < ARRAY_SIZE(trace_events))) {
+			trace_events[trace_count++] = (struct trace_event){
+				.kind = kind,
+				.call = call,
+				.obj = obj,
+				.timeout = timeout,
+				.err = err,
+			};
+		}
+	}
+}
+
+void sys_trace_posix_enter_user(enum sys_trace_posix_call call, uintptr_t obj,
+				k_timeout_t timeout)
+{
+	trace_record(TRACE_ENTER, call, obj, timeout, 0);
+}
+
+void sys_trace_posix_blocking_user(enum sys_trace_posix_call call, uintptr_t obj)
+{
+	trace_record(TRACE_BLOCKING, call, obj, K_NO_WAIT, 0);
+}
+
+void sys_trace_posix_exit_user(enum sys_trace_posix_call call, uintptr_t obj, int err)
+{
+	trace_record(TRACE_EXIT, call, obj, K_NO_WAIT, err);
+}
+
+static void trace_start(void)
+{
+	K_SPINLOCK(&trace_lock) {
+		trace_count = 0;
+		trace_on = true;
+	}
+}
+
+static void trace_stop(void)
+{
+	K_SPINLOCK(&trace_lock) {
+		trace_on = false;
+	}
+}
+
+/* Find the first event of @p kind and @p call on @p obj from @p from, or -1 */
+static int trace_find(int from, enum trace_kind kind, enum sys_trace_posix_call call,
+		      uintptr_t obj)
+{
+	for (size_t i = from; i < trace_count; ++i) {
+		if ((trace_events[i].kind == kind) && (trace_events[i].call == call) &&
+		    (trace_events[i].obj == obj)) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+static void *trace_locker(void *arg)
+{
+	pthread_mutex_t *mutex = arg;
+
+	zassert_ok(pthread_mutex_lock(mutex));
+	zassert_ok(pthread_mutex_unlock(mutex));
+
+	return NULL;
+}
+
+ZTEST(posix_non_portable, test_tracing_mutex)
+{
+	int i;
+	pthread_t th;
+	uintptr_t obj;
+	pthread_mutex_t mutex;
+
+	if (CONFIG_SYS_THREAD_STACK_MAX == 0) {
+		ztest_test_skip();
+	}
+
+	trace_start();
+	zassert_ok(pthread_mutex_init(&mutex, NULL));
+	zassert_ok(pthread_mutex_lock(&mutex));
+	zassert_ok(pthread_create(&th, NULL, trace_locker, &mutex));
+	/* let the other thread find the mutex locked */
+	k_msleep(50);
+	zassert_ok(pthread_mutex_unlock(&mutex));
+	zassert_ok(pthread_join(th, NULL));
+	zassert_ok(pthread_mutex_destroy(&mutex));
+	trace_stop();
+
+	/* the mutex is named by its k_mutex, which the init event reports */
+	zassert_true(trace_count > 0);
+	zassert_equal(trace_events[0].kind, TRACE_EXIT);
+	zassert_equal(trace_events[0].call, SYS_TRACE_POSIX_PTHREAD_MUTEX_INIT);
+	zassert_ok(trace_events[0].err);
+	obj = trace_events[0].obj;
+	zassert_not_equal(obj, 0);
+
+	/* uncontended */
+	i = trace_find(0, TRACE_ENTER, SYS_TRACE_POSIX_PTHREAD_MUTEX_LOCK, obj);
+	zassert_true(i >= 0);
+	zassert_true(K_TIMEOUT_EQ(trace_events[i].timeout, K_FOREVER));
+	zassert_equal(trace_events[i + 1].kind, TRACE_EXIT);
+	zassert_equal(trace_events[i + 1].call, SYS_TRACE_POSIX_PTHREAD_MUTEX_LOCK);
+	zassert_ok(trace_events[i + 1].err);
+
+	/* contended, by the other thread, which only got the mutex once unlocked */
+	i = trace_find(i + 2, TRACE_ENTER, SYS_TRACE_POSIX_PTHREAD_MUTEX_LOCK, obj);
+	zassert_true(i >= 0);
+	zassert_equal(trace_events[i + 1].kind, TRACE_BLOCKING);
+	zassert_equal(trace_events[i + 1].obj, obj);
+	i = trace_find(i, TRACE_EXIT, SYS_TRACE_POSIX_PTHREAD_MUTEX_LOCK, obj);
+	zassert_true(i >= 0);
+	zassert_ok(trace_events[i].err);
+
+	zassert_true(trace_find(0, TRACE_EXIT, SYS_TRACE_POSIX_PTHREAD_MUTEX_DESTROY, obj) > i);
+}
+
+ZTEST(posix_non_portable, test_tracing_sem)
+{
+	int i;
+	sem_t sem;
+	struct timespec abstime;
+	const uintptr_t obj = (uintptr_t)&sem;
+
+	zassert_ok(clock_gettime(CLOCK_REALTIME, &abstime));
+	abstime.tv_sec += 1;
+
+	trace_start();
+	zassert_ok(sem_init(&sem, 0, 0));
+	zassert_equal(sem_trywait(&sem), -1);
+	zassert_equal(errno, EAGAIN);
+	zassert_ok(sem_post(&sem));
+	zassert_ok(sem_timedwait(&sem, &abstime));
+	zassert_ok(sem_destroy(&sem));
+	trace_stop();
+
+	i = trace_find(0, TRACE_EXIT, SYS_TRACE_POSIX_SEM_INIT, obj);
+	zassert_equal(i, 0);
+
+	/* sem_trywait() found it taken, but does not block */
+	i = trace_find(i, TRACE_ENTER, SYS_TRACE_POSIX_SEM_WAIT, obj);
+	zassert_true(i >= 0);
+	zassert_true(K_TIMEOUT_EQ(trace_events[i].timeout, K_NO_WAIT));
+	zassert_equal(trace_events[i + 1].kind, TRACE_BLOCKING);
+	zassert_equal(trace_events[i + 2].kind, TRACE_EXIT);
+	zassert_equal(trace_events[i + 2].err, EAGAIN);
+
+	zassert_true(trace_find(i, TRACE_EXIT, SYS_TRACE_POSIX_SEM_POST, obj) > i);
+
+	/* sem_timedwait() reports the time left, and took the posted count at once */
+	i = trace_find(i + 3, TRACE_ENTER, SYS_TRACE_POSIX_SEM_WAIT, obj);
+	zassert_true(i >= 0);
+	zassert_false(K_TIMEOUT_EQ(trace_events[i].timeout, K_FOREVER));
+	zassert_false(K_TIMEOUT_EQ(trace_events[i].timeout, K_NO_WAIT));
+	zassert_equal(trace_events[i + 1].kind, TRACE_EXIT);
+	zassert_ok(trace_events[i + 1].err);
+
+	zassert_true(trace_find(i, TRACE_EXIT, SYS_TRACE_POSIX_SEM_DESTROY, obj) > i);
+}
+
+#endif /* CONFIG_POSIX_TRACING && CONFIG_TRACING_USER */
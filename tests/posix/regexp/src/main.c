@@ -0,0 +1,288 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <regex.h>
+#include <string.h>
+
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+struct regexp_case {
+	const char *pattern;
+	int cflags;
+	const char *string;
+	int eflags;
+	/* bounds of the match, or -1 if the string must not match */
+	regoff_t so;
+	regoff_t eo;
+};
+
+#define BRE 0
+#define ERE REG_EXTENDED
+
+static void check_match(const struct regexp_case *tc)
+{
+	int rc;
+	regex_t re;
+	regmatch_t m = {-2, -2};
+
+	zassert_ok(regcomp(&re, tc->pattern, tc->cflags), "regcomp(\"%s\") failed", tc->pattern);
+
+	rc = regexec(&re, tc->string, 1, &m, tc->eflags);
+	if (tc->so < 0) {
+		zexpect_equal(rc, REG_NOMATCH, "\"%s\" matched \"%s\"", tc->pattern, tc->string);
+	} else {
+		zexpect_ok(rc, "\"%s\" did not match \"%s\"", tc->pattern, tc->string);
+		zexpect_equal(m.rm_so, tc->so, "\"%s\" on \"%s\": start %d", tc->pattern,
+			      tc->string, (int)m.rm_so);
+		zexpect_equal(m.rm_eo, tc->eo, "\"%s\" on \"%s\": end %d", tc->pattern,
+			      tc->string, (int)m.rm_eo);
+	}
+
+	/* without pmatch, only the outcome is reported */
+	rc = regexec(&re, tc->string, 0, NULL, tc->eflags);
+	zexpect_equal(rc, (tc->so < 0) ? REG_NOMATCH : 0, "\"%s\" on \"%s\"", tc->pattern,
+		      tc->string);
+
+	regfree(&re);
+}
+
+ZTEST(posix_regexp, test_regexec_bre)
+{
+	static const struct regexp_case cases[] = {
+		{"abc", BRE, "xabcx", 0, 1, 4},
+		{"abc", BRE, "ab", 0, -1, -1},
+		{"a*", BRE, "baaa", 0, 0, 0},
+		{"ba*", BRE, "baaa", 0, 0, 4},
+		{"a.c", BRE, "xabcx", 0, 1, 4},
+		{"^ab", BRE, "abab", 0, 0, 2},
+		{"^ab", BRE, "xab", 0, -1, -1},
+		{"ab$", BRE, "abab", 0, 2, 4},
+		{"^$", BRE, "", 0, 0, 0},
+		/* '^' and '$' are only anchors at the start and end */
+		{"a^b", BRE, "a^b", 0, 0, 3},
+		{"a$b", BRE, "a$b", 0, 0, 3},
+		{"^^", BRE, "^", 0, 0, 1},
+		/* '*' is an ordinary character at the start, and after a leading '^' */
+		{"*a", BRE, "b*a", 0, 1, 3},
+		{"^*a", BRE, "*a", 0, 0, 2},
+		{"\\(*a\\)", BRE, "*a", 0, 0, 2},
+		/* ERE special characters are ordinary in a BRE */
+		{"a+?|(b)", BRE, "a+?|(b)", 0, 0, 7},
+		{"a\\{2\\}", BRE, "aaaa", 0, 0, 2},
+		{"a\\{2,\\}", BRE, "aaaa", 0, 0, 4},
+		{"a\\{1,3\\}", BRE, "aaaa", 0, 0, 3},
+		{"\\(ab\\)*c", BRE, "ababc", 0, 0, 5},
+		{"\\.", BRE, "a.b", 0, 1, 2},
+	};
+
+	ARRAY_FOR_EACH_PTR(cases, tc) {
+		check_match(tc);
+	}
+}
+
+ZTEST(posix_regexp, test_regexec_ere)
+{
+	static const struct regexp_case cases[] = {
+		{"a|b", ERE, "xb", 0, 1, 2},
+		{"ab|abcd|abc", ERE, "abcde", 0, 0, 4},
+		{"a+", ERE, "baaa", 0, 1, 4},
+		{"ba?c", ERE, "bc", 0, 0, 2},
+		{"a{2,3}", ERE, "aaaa", 0, 0, 3},
+		{"(a|ab)(c|bcd)", ERE, "abcd", 0, 0, 4},
+		{"(a*)*", ERE, "b", 0, 0, 0},
+		{"(a*)+b", ERE, "aab", 0, 0, 3},
+		{"x(a|)y", ERE, "xy", 0, 0, 2},
+		{"()", ERE, "a", 0, 0, 0},
+		{"a)", ERE, "a)", 0, 0, 2},
+		{"^(foo|bar)$", ERE, "bar", 0, 0, 3},
+		{"^(foo|bar)$", ERE, "foobar", 0, -1, -1},
+		{"(^a|b)c", ERE, "ac", 0, 0, 2},
+		{"(^a|b)c", ERE, "xac", 0, -1, -1},
+		/* the leftmost match wins over a longer one further right */
+		{"b+|a+b+", ERE, "xaabbb", 0, 1, 6},
+		{"a?a?a?aaa", ERE, "aaa", 0, 0, 3},
+		{"(x+x+)+y", ERE, "xxxxxxxxxxxxxxxxxxxxxxxx", 0, -1, -1},
+	};
+
+	ARRAY_FOR_EACH_PTR(cases, tc) {
+		check_match(tc);
+	}
+}
+
+ZTEST(posix_regexp, test_regexec_bracket)
+{
+	static const struct regexp_case cases[] = {
+		{"[abc]+", ERE, "xcabx", 0, 1, 4},
+		{"[^abc]+", ERE, "abxyc", 0, 2, 4},
+		{"[a-c]+", ERE, "dabce", 0, 1, 4},
+		{"[]a]+", ERE, "x]a]", 0, 1, 4},
+		{"[^]a]", ERE, "]ab", 0, 2, 3},
+		{"[a-]+", ERE, "x-a-", 0, 1, 4},
+		{"[[:digit:]]+", ERE, "ab123c", 0, 2, 5},
+		{"[[:alpha:]_][[:alnum:]_]*", ERE, "1 foo_42 x", 0, 2, 8},
+		{"[[:space:][:punct:]]+", ERE, "a ,.;b", 0, 1, 5},
+		{"[[.-.]]", ERE, "a-b", 0, 1, 2},
+		{"[[=a=]]", ERE, "ba", 0, 1, 2},
+		{"[.]", ERE, "a.", 0, 1, 2},
+		{"[*]", BRE, "a*", 0, 1, 2},
+	};
+
+	ARRAY_FOR_EACH_PTR(cases, tc) {
+		check_match(tc);
+	}
+}
+
+ZTEST(posix_regexp, test_regexec_flags)
+{
+	static const struct regexp_case cases[] = {
+		{"abc", ERE | REG_ICASE, "xAbC", 0, 1, 4},
+		{"[a-c]+", ERE | REG_ICASE, "xAbCd", 0, 1, 4},
+		{"[^a]", ERE | REG_ICASE, "Ab", 0, 1, 2},
+		{"^b", ERE, "a\nb", 0, -1, -1},
+		{"^b", ERE | REG_NEWLINE, "a\nb", 0, 2, 3},
+		{"a$", ERE | REG_NEWLINE, "a\nb", 0, 0, 1},
+		{"a.b", ERE, "a\nb", 0, 0, 3},
+		{"a.b", ERE | REG_NEWLINE, "a\nb", 0, -1, -1},
+		{"a[^x]b", ERE | REG_NEWLINE, "a\nb", 0, -1, -1},
+		{"^a", ERE, "a", REG_NOTBOL, -1, -1},
+		{"^a", ERE | REG_NEWLINE, "a\na", REG_NOTBOL, 2, 3},
+		{"a$", ERE, "a", REG_NOTEOL, -1, -1},
+		{"a$", ERE | REG_NEWLINE, "a\na", REG_NOTEOL, 0, 1},
+		{"^$", ERE, "", REG_NOTBOL, -1, -1},
+	};
+
+	ARRAY_FOR_EACH_PTR(cases, tc) {
+		check_match(tc);
+	}
+}
+
+ZTEST(posix_regexp, test_regexec_subexpressions)
+{
+	regex_t re;
+	regmatch_t m[5];
+
+	zassert_ok(regcomp(&re, "([0-9]+)-([0-9]+)-([0-9]+)", REG_EXTENDED));
+	zassert_equal(re.re_nsub, 3);
+	zassert_ok(regexec(&re, "on 2024-01-15 at", ARRAY_SIZE(m), m, 0));
+	zexpect_equal(m[0].rm_so, 3);
+	zexpect_equal(m[0].rm_eo, 13);
+	zexpect_equal(m[1].rm_so, 3);
+	zexpect_equal(m[1].rm_eo, 7);
+	zexpect_equal(m[2].rm_so, 8);
+	zexpect_equal(m[2].rm_eo, 10);
+	zexpect_equal(m[3].rm_so, 11);
+	zexpect_equal(m[3].rm_eo, 13);
+	/* elements beyond re_nsub are set to -1 */
+	zexpect_equal(m[4].rm_so, -1);
+	zexpect_equal(m[4].rm_eo, -1);
+	regfree(&re);
+
+	/* a subexpression that does not participate in the match */
+	zassert_ok(regcomp(&re, "(a)|(b)", REG_EXTENDED));
+	zassert_ok(regexec(&re, "b", 3, m, 0));
+	zexpect_equal(m[1].rm_so, -1);
+	zexpect_equal(m[1].rm_eo, -1);
+	zexpect_equal(m[2].rm_so, 0);
+	zexpect_equal(m[2].rm_eo, 1);
+	regfree(&re);
+
+	/* a repeated subexpression reports its last iteration */
+	zassert_ok(regcomp(&re, "\\(a*\\)*b", 0));
+	zassert_equal(re.re_nsub, 1);
+	zassert_ok(regexec(&re, "xaab", 2, m, 0));
+	zexpect_equal(m[0].rm_so, 1);
+	zexpect_equal(m[0].rm_eo, 4);
+	zexpect_equal(m[1].rm_eo, 3);
+	regfree(&re);
+
+	zassert_ok(regcomp(&re, "((a)|b)+", REG_EXTENDED));
+	zassert_equal(re.re_nsub, 2);
+	zassert_ok(regexec(&re, "abab", 3, m, 0));
+	zexpect_equal(m[0].rm_eo, 4);
+	zexpect_equal(m[1].rm_so, 3);
+	zexpect_equal(m[1].rm_eo, 4);
+	regfree(&re);
+
+	/* REG_NOSUB leaves pmatch alone */
+	zassert_ok(regcomp(&re, "(b)", REG_EXTENDED | REG_NOSUB));
+	m[0].rm_so = 42;
+	zassert_ok(regexec(&re, "abc", 1, m, 0));
+	zexpect_equal(m[0].rm_so, 42);
+	regfree(&re);
+}
+
+ZTEST(posix_regexp, test_regcomp_errors)
+{
+	static const struct {
+		const char *pattern;
+		int cflags;
+		int err;
+	} cases[] = {
+		{"a\\", ERE, REG_EESCAPE},
+		{"[abc", ERE, REG_EBRACK},
+		{"[[:foo:]]", ERE, REG_ECTYPE},
+		{"[[.ab.]]", ERE, REG_ECOLLATE},
+		{"[b-a]", ERE, REG_ERANGE},
+		{"(a", ERE, REG_EPAREN},
+		{"\\(a", BRE, REG_EPAREN},
+		{"a\\)", BRE, REG_EPAREN},
+		{"a{1", ERE, REG_EBRACE},
+		{"a{2,1}", ERE, REG_BADBR},
+		{"a{256}", ERE, REG_BADBR},
+		{"a\\{x\\}", BRE, REG_BADBR},
+		{"*a", ERE, REG_BADRPT},
+		{"a|+", ERE, REG_BADRPT},
+		/* back-references cannot be matched in linear time */
+		{"\\(a\\)\\1", BRE, REG_ESUBREG},
+		{"(a){255}(b){255}(c){255}(d){255}(e){255}", ERE, REG_ESPACE},
+	};
+	regex_t re;
+
+	ARRAY_FOR_EACH_PTR(cases, tc) {
+		zexpect_equal(regcomp(&re, tc->pattern, tc->cflags), tc->err,
+			      "regcomp(\"%s\") did not fail with %d", tc->pattern, tc->err);
+	}
+}
+
+ZTEST(posix_regexp, test_regerror)
+{
+	char buf[8];
+	size_t len;
+	regex_t re;
+
+	zassert_ok(regcomp(&re, "a", 0));
+
+	len = regerror(REG_NOMATCH, &re, NULL, 0);
+	zassert_true(len > 1);
+	zassert_equal(regerror(REG_NOMATCH, &re, buf, sizeof(buf)), len);
+	zassert_equal(strlen(buf), MIN(len, sizeof(buf)) - 1);
+	zassert_equal(regerror(REG_EPAREN, &re, buf, 1), regerror(REG_EPAREN, &re, NULL, 0));
+	zassert_equal(buf[0], '\0');
+
+	regfree(&re);
+}
+
+ZTEST(posix_regexp, test_regexec_linear)
+{
+	static char s[2048];
+	regex_t re;
+	regmatch_t m;
+
+	/* these backtrack exponentially in a naive matcher */
+	memset(s, 'a', sizeof(s) - 1);
+
+	zassert_ok(regcomp(&re, "(a|aa)*b", REG_EXTENDED));
+	zassert_equal(regexec(&re, s, 1, &m, 0), REG_NOMATCH);
+	regfree(&re);
+
+	zassert_ok(regcomp(&re, "(a*)*$", REG_EXTENDED));
+	zassert_ok(regexec(&re, s, 1, &m, 0));
+	zassert_equal(m.rm_so, 0);
+	zassert_equal(m.rm_eo, sizeof(s) - 1);
+	regfree(&re);
+}
+
+ZTEST_SUITE(posix_regexp, NULL, NULL, NULL, NULL, NULL);
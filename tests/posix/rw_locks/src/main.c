@@ -119,6 +119,29 @@ ZTEST(posix_rw_locks, test_rw_lock)
 	zassert_ok(pthread_rwlock_destroy(&rwlock), "Failed to destroy rwlock");
 }
 
+ZTEST(posix_rw_locks, test_rw_lock_stale_handle)
+{
+	pthread_rwlock_t stale;
+	pthread_rwlock_t fresh;
+
+	zassert_ok(pthread_rwlock_init(&stale, NULL));
+	zassert_ok(pthread_rwlock_wrlock(&stale));
+	zassert_equal(pthread_rwlock_destroy(&stale), EBUSY);
+	zassert_ok(pthread_rwlock_unlock(&stale));
+	zassert_ok(pthread_rwlock_destroy(&stale));
+
+	/* the slot of the destroyed lock is reused, but not its handle */
+	zassert_ok(pthread_rwlock_init(&fresh, NULL));
+	zassert_not_equal(stale, fresh);
+	zassert_equal(pthread_rwlock_rdlock(&stale), EINVAL);
+	zassert_equal(pthread_rwlock_unlock(&stale), EINVAL);
+	zassert_equal(pthread_rwlock_destroy(&stale), EINVAL);
+
+	zassert_ok(pthread_rwlock_wrlock(&fresh));
+	zassert_ok(pthread_rwlock_unlock(&fresh));
+	zassert_ok(pthread_rwlock_destroy(&fresh));
+}
+
 static void test_pthread_rwlockattr_pshared_common(bool set, int pshared)
 {
 	int tmp_pshared = 4242;
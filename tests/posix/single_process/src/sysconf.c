@@ -103,7 +103,7 @@ static const struct sysconf_case sysconf_cases[] = {
 	{_SC_THREAD_ROBUST_PRIO_INHERIT, SYSCONF_OPTION},
 	{_SC_THREAD_ROBUST_PRIO_PROTECT, SYSCONF_OPTION},
 	{_SC_THREAD_SAFE_FUNCTIONS, SYSCONF_OPTION},
-	{_SC_THREAD_SPORADIC_SERVER, SYSCONF_UNSUPPORTED},
+	{_SC_THREAD_SPORADIC_SERVER, SYSCONF_OPTION},
 	{_SC_THREADS, SYSCONF_OPTION},
 	{_SC_TIMEOUTS, SYSCONF_OPTION},
 	{_SC_TIMERS, SYSCONF_OPTION},
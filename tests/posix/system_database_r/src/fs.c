@@ -26,7 +26,11 @@ struct _entry {
 
 static const struct _entry _data[] = {
 	{.name = "/etc/passwd",
-	 .data = "user:x:1000:1000:user:/home/user:/bin/sh\nroot:x:0:0:root:/root:/bin/sh\n"},
+	 /* the first entry does not fit in CONFIG_POSIX_GETPW_R_SIZE_MAX bytes */
+	 .data = "long:x:2000:2000:long entry whose gecos field is longer than the line buffers of "
+		 "the system database functions, which must not affect lookups of other users:"
+		 "/home/long:/bin/sh\n"
+		 "user:x:1000:1000:user:/home/user:/bin/sh\nroot:x:0:0:root:/root:/bin/sh\n"},
 	{.name = "/etc/group", .data = "user:x:1000:staff,admin\nroot:x:0:\n"},
 };
 
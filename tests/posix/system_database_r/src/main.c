@@ -92,6 +92,30 @@ ZTEST(posix_system_database_r, test_getpwnam_r)
 #endif
 }
 
+ZTEST(posix_system_database_r, test_getpwnam_r_long_entry)
+{
+	struct passwd pwd;
+	struct passwd *result;
+	static char big_buf[256];
+
+#ifdef CONFIG_NATIVE_LIBC
+	ztest_test_skip();
+#endif
+
+	/* an entry longer than the buffer does not prevent finding the others */
+	zexpect_ok(getpwuid_r(0, &pwd, buf, sizeof(buf), &result));
+	zexpect_equal(result, &pwd);
+	zexpect_str_equal(pwd.pw_name, "root");
+
+	zexpect_equal(getpwnam_r("long", &pwd, buf, sizeof(buf), &result), ERANGE);
+	zexpect_equal(result, NULL);
+
+	zexpect_ok(getpwnam_r("long", &pwd, big_buf, sizeof(big_buf), &result));
+	zexpect_equal(result, &pwd);
+	zexpect_equal(pwd.pw_uid, 2000);
+	zexpect_str_equal(pwd.pw_shell, "/bin/sh");
+}
+
 ZTEST(posix_system_database_r, test_getpwuid_r)
 {
 	struct passwd pwd;
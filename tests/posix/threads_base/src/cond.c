@@ -221,3 +221,67 @@ static void test_pthread_cond_timedwait(void)
 }
 
 ZTEST_THREADS_BASE(test_pthread_cond_timedwait);
+
+#define COND_BROADCAST_WAITERS 4
+
+static ZTEST_BMEM int cond_broadcast_waiting;
+static ZTEST_BMEM int cond_broadcast_woken;
+
+static void *cond_broadcast_fn(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	zassert_ok(pthread_mutex_lock(&cond_wait_mtx));
+	++cond_broadcast_waiting;
+	while (!cond_wait_done) {
+		zassert_ok(pthread_cond_wait(&cond_wait_cv, &cond_wait_mtx));
+	}
+	++cond_broadcast_woken;
+	zassert_ok(pthread_mutex_unlock(&cond_wait_mtx));
+
+	return NULL;
+}
+
+static void test_pthread_cond_broadcast(void)
+{
+	pthread_t th[COND_BROADCAST_WAITERS];
+
+	posix_test_skip_if_native_libc();
+
+	cond_wait_done = false;
+	cond_broadcast_waiting = 0;
+	cond_broadcast_woken = 0;
+	zassert_ok(pthread_mutex_init(&cond_wait_mtx, NULL));
+	zassert_ok(pthread_cond_init(&cond_wait_cv, NULL));
+
+	ARRAY_FOR_EACH(th, i) {
+		zassert_ok(pthread_create(&th[i], NULL, cond_broadcast_fn, NULL));
+	}
+
+	for (;;) {
+		zassert_ok(pthread_mutex_lock(&cond_wait_mtx));
+		if (cond_broadcast_waiting == COND_BROADCAST_WAITERS) {
+			break;
+		}
+		zassert_ok(pthread_mutex_unlock(&cond_wait_mtx));
+		k_msleep(10);
+	}
+
+	/* every waiter acquires the mutex in turn, after it has been unlocked below */
+	cond_wait_done = true;
+	zassert_ok(pthread_cond_broadcast(&cond_wait_cv));
+	k_msleep(TIMEDWAIT_TIMEOUT_DELAY_MS);
+	zassert_equal(0, cond_broadcast_woken);
+	zassert_ok(pthread_mutex_unlock(&cond_wait_mtx));
+
+	ARRAY_FOR_EACH(th, i) {
+		zassert_ok(pthread_join(th[i], NULL));
+	}
+
+	zassert_equal(COND_BROADCAST_WAITERS, cond_broadcast_woken);
+
+	zassert_ok(pthread_cond_destroy(&cond_wait_cv));
+	zassert_ok(pthread_mutex_destroy(&cond_wait_mtx));
+}
+
+ZTEST_THREADS_BASE(test_pthread_cond_broadcast);
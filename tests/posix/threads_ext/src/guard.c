@@ -0,0 +1,135 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <pthread.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+/* guard areas are only checked with CONFIG_POSIX_THREAD_GUARD, see threads_ext.guard */
+#ifdef CONFIG_POSIX_THREAD_GUARD
+
+#define GUARD_SIZE     256
+#define OVERFLOW_BYTES 64
+#define STACK_SIZE     MAX(4096, CONFIG_SYS_THREAD_STACK_SIZE)
+#define GUARD_WAIT_MS  1000
+
+static volatile int segv_count;
+static void *volatile segv_addr;
+static uint8_t *volatile guard_base;
+static uint8_t *volatile overflow_addr;
+
+static void on_sigsegv(int signo, siginfo_t *info, void *context)
+{
+	ARG_UNUSED(signo);
+	ARG_UNUSED(context);
+
+	segv_addr = info->si_value.sival_ptr;
+	++segv_count;
+}
+
+/* recurse until the stack reaches @p limit, as a deep call chain would */
+static int overflow_recurse(uint8_t *limit)
+{
+	volatile uint8_t frame[32];
+
+	for (size_t i = 0; i < sizeof(frame); ++i) {
+		frame[i] = i;
+	}
+
+	if ((uint8_t *)frame < overflow_addr) {
+		overflow_addr = (uint8_t *)frame;
+	}
+
+	if ((uint8_t *)frame <= limit) {
+		return frame[0];
+	}
+
+	/* not a tail call, so that each level keeps its frame */
+	return overflow_recurse(limit) + frame[1];
+}
+
+static void *overflow_thread(void *arg)
+{
+	uint8_t *base = (uint8_t *)k_current_get()->stack_info.start;
+	struct sigaction act = {
+		.sa_sigaction = on_sigsegv,
+		.sa_flags = SA_SIGINFO,
+	};
+	int64_t end = k_uptime_get() + GUARD_WAIT_MS;
+
+	zassert_ok(sigemptyset(&act.sa_mask));
+	zassert_ok(sigaction(SIGSEGV, &act, NULL));
+
+	/* at least the requested stack is left above the guard area */
+	zassert_true(k_current_get()->stack_info.size >= STACK_SIZE + GUARD_SIZE);
+
+	guard_base = base;
+	overflow_addr = &base[k_current_get()->stack_info.size];
+	if (arg != NULL) {
+		(void)overflow_recurse(&base[GUARD_SIZE - OVERFLOW_BYTES]);
+	}
+
+	/* signals are delivered on the way out of a system call */
+	while ((segv_count == 0) && (k_uptime_get() < end)) {
+		k_msleep(1);
+	}
+
+	return arg;
+}
+
+static void guard_run(bool overflow)
+{
+	pthread_t th;
+	pthread_attr_t attr;
+
+	segv_count = 0;
+	segv_addr = NULL;
+	guard_base = NULL;
+	overflow_addr = NULL;
+
+	zassert_ok(pthread_attr_init(&attr));
+	zassert_ok(pthread_attr_setstacksize(&attr, STACK_SIZE));
+	zassert_ok(pthread_attr_setguardsize(&attr, GUARD_SIZE));
+	zassert_ok(pthread_create(&th, &attr, overflow_thread, overflow ? &th : NULL));
+	zassert_ok(pthread_join(th, NULL));
+	zassert_ok(pthread_attr_destroy(&attr));
+}
+
+ZTEST(posix_threads_ext, test_pthread_guard_overflow)
+{
+	guard_run(true);
+
+	zassert_equal(segv_count, 1);
+	/* the lowest address written is reported, which may be below the deepest frame */
+	zassert_not_null(segv_addr);
+	zassert_true((uint8_t *)segv_addr >= guard_base);
+	zassert_true((uint8_t *)segv_addr <= overflow_addr);
+	zassert_true(overflow_addr < &guard_base[GUARD_SIZE]);
+}
+
+ZTEST(posix_threads_ext, test_pthread_guard_no_overflow)
+{
+	guard_run(false);
+
+	zassert_equal(segv_count, 0);
+}
+
+ZTEST(posix_threads_ext, test_pthread_guard_too_large)
+{
+	pthread_t th;
+	pthread_attr_t attr;
+
+	zassert_ok(pthread_attr_init(&attr));
+	zassert_ok(pthread_attr_setguardsize(&attr, SIZE_MAX));
+	zassert_not_ok(pthread_create(&th, &attr, overflow_thread, NULL));
+	zassert_ok(pthread_attr_destroy(&attr));
+}
+
+#endif /* CONFIG_POSIX_THREAD_GUARD */
@@ -0,0 +1,281 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+/* interval timers are only built with CONFIG_XSI_TIMERS, see portability.posix.timers.itimers */
+#ifdef CONFIG_XSI_TIMERS
+
+#define REAL_VALUE_MS    50
+#define REAL_INTERVAL_MS 20
+#define REAL_PERIODS     10
+#define CPU_INTERVAL_MS  10
+#define CPU_BUSY_MS      200
+#define OTHER_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_DEFINE(other_stack, OTHER_STACK_SIZE);
+static struct k_thread other_thread;
+
+static volatile int itimer_count;
+static volatile int64_t itimer_first_ms;
+
+static void itimer_handler(int signo)
+{
+	ARG_UNUSED(signo);
+
+	if (itimer_count++ == 0) {
+		itimer_first_ms = k_uptime_get();
+	}
+}
+
+static void itimer_install(int signo)
+{
+	struct sigaction act = {
+		.sa_handler = itimer_handler,
+	};
+
+	zassert_ok(sigemptyset(&act.sa_mask));
+	zassert_ok(sigaction(signo, &act, NULL));
+
+	itimer_count = 0;
+	itimer_first_ms = 0;
+}
+
+static void itimer_uninstall(int which, int signo)
+{
+	struct sigaction act = {
+		.sa_handler = SIG_IGN,
+	};
+
+	/* a late signal must not run the default action, which is to terminate */
+	zassert_ok(setitimer(which, &(struct itimerval){0}, NULL));
+	zassert_ok(sigemptyset(&act.sa_mask));
+	zassert_ok(sigaction(signo, &act, NULL));
+}
+
+static struct timeval ms_to_timeval(long ms)
+{
+	return (struct timeval){
+		.tv_sec = ms / MSEC_PER_SEC,
+		.tv_usec = (ms % MSEC_PER_SEC) * USEC_PER_MSEC,
+	};
+}
+
+static long timeval_to_ms(const struct timeval *tv)
+{
+	return tv->tv_sec * MSEC_PER_SEC + DIV_ROUND_UP(tv->tv_usec, USEC_PER_MSEC);
+}
+
+/* signals are delivered on the way out of a system call, so sleep in small steps */
+static void itimer_sleep_ms(int64_t ms)
+{
+	int64_t end = k_uptime_get() + ms;
+
+	while (k_uptime_get() < end) {
+		k_msleep(1);
+	}
+}
+
+/* use CPU time, returning from a system call every millisecond so that signals are delivered */
+static void itimer_busy_ms(int ms)
+{
+	for (int i = 0; i < ms; ++i) {
+		k_busy_wait(USEC_PER_MSEC);
+	}
+}
+
+ZTEST(posix_timers, test_itimer_invalid)
+{
+	struct itimerval value = {0};
+
+	errno = 0;
+	zassert_equal(getitimer(42, &value), -1);
+	zassert_equal(errno, EINVAL);
+
+	errno = 0;
+	zassert_equal(setitimer(-1, &value, NULL), -1);
+	zassert_equal(errno, EINVAL);
+
+	value.it_value.tv_usec = USEC_PER_SEC;
+	errno = 0;
+	zassert_equal(setitimer(ITIMER_REAL, &value, NULL), -1);
+	zassert_equal(errno, EINVAL);
+
+	value.it_value.tv_usec = 0;
+	value.it_interval.tv_usec = -1;
+	errno = 0;
+	zassert_equal(setitimer(ITIMER_PROF, &value, NULL), -1);
+	zassert_equal(errno, EINVAL);
+}
+
+ZTEST(posix_timers, test_itimer_getitimer)
+{
+	struct itimerval value = {
+		.it_value = ms_to_timeval(MSEC_PER_SEC),
+		.it_interval = ms_to_timeval(REAL_INTERVAL_MS),
+	};
+	struct itimerval ovalue;
+	static const int timers[] = {ITIMER_REAL, ITIMER_PROF};
+
+	ARRAY_FOR_EACH_PTR(timers, which) {
+		zassert_ok(setitimer(*which, &value, NULL));
+		zassert_ok(getitimer(*which, &ovalue));
+
+		zassert_true(timeval_to_ms(&ovalue.it_value) > 0);
+		zassert_true(timeval_to_ms(&ovalue.it_value) <= MSEC_PER_SEC, "%ld ms left",
+			     timeval_to_ms(&ovalue.it_value));
+		zassert_equal(timeval_to_ms(&ovalue.it_interval), REAL_INTERVAL_MS);
+
+		/* disarming reports the previous value, and leaves nothing behind */
+		zassert_ok(setitimer(*which, &(struct itimerval){0}, &ovalue));
+		zassert_true(timeval_to_ms(&ovalue.it_value) > 0);
+		zassert_ok(getitimer(*which, &ovalue));
+		zassert_equal(timeval_to_ms(&ovalue.it_value), 0);
+	}
+}
+
+ZTEST(posix_timers, test_itimer_real)
+{
+	int64_t start;
+	long long first;
+	const int64_t tick_ms = DIV_ROUND_UP(MSEC_PER_SEC, CONFIG_SYS_CLOCK_TICKS_PER_SEC);
+	struct itimerval value = {
+		.it_value = ms_to_timeval(REAL_VALUE_MS),
+		.it_interval = ms_to_timeval(REAL_INTERVAL_MS),
+	};
+
+	itimer_install(SIGALRM);
+
+	start = k_uptime_get();
+	zassert_ok(setitimer(ITIMER_REAL, &value, NULL));
+	itimer_sleep_ms(REAL_VALUE_MS + REAL_PERIODS * REAL_INTERVAL_MS + REAL_INTERVAL_MS / 2);
+
+	itimer_uninstall(ITIMER_REAL, SIGALRM);
+
+	/* the first expiry is never early, and late by no more than a couple of ticks */
+	first = itimer_first_ms - start;
+	zassert_true(first >= REAL_VALUE_MS, "first expiry after %lld ms", first);
+	zassert_true(first <= REAL_VALUE_MS + 2 * tick_ms + 1, "first expiry after %lld ms", first);
+
+	zassert_within(itimer_count, REAL_PERIODS + 1, 1, "%d expiries", itimer_count);
+}
+
+ZTEST(posix_timers, test_itimer_real_alarm)
+{
+	struct itimerval value = {
+		.it_value = ms_to_timeval(10 * MSEC_PER_SEC),
+	};
+	struct itimerval ovalue;
+
+	/* alarm() disarms ITIMER_REAL, and reports what was left of it */
+	zassert_ok(setitimer(ITIMER_REAL, &value, NULL));
+	zassert_equal(alarm(0), 10);
+	zassert_ok(getitimer(ITIMER_REAL, &ovalue));
+	zassert_equal(timeval_to_ms(&ovalue.it_value), 0);
+
+	/* and setitimer() disarms the alarm, reporting what was left of it */
+	zassert_equal(alarm(5), 0);
+	zassert_ok(setitimer(ITIMER_REAL, &(struct itimerval){0}, &ovalue));
+	zassert_within(timeval_to_ms(&ovalue.it_value), 5 * MSEC_PER_SEC, 100);
+	zassert_equal(alarm(0), 0);
+}
+
+ZTEST(posix_timers, test_itimer_prof)
+{
+	const int expected = CPU_BUSY_MS / CPU_INTERVAL_MS;
+	struct itimerval value = {
+		.it_value = ms_to_timeval(CPU_INTERVAL_MS),
+		.it_interval = ms_to_timeval(CPU_INTERVAL_MS),
+	};
+
+	itimer_install(SIGPROF);
+
+	zassert_ok(setitimer(ITIMER_PROF, &value, NULL));
+	itimer_busy_ms(CPU_BUSY_MS);
+	/* let the last expiry be checked */
+	itimer_busy_ms(1);
+
+	itimer_uninstall(ITIMER_PROF, SIGPROF);
+
+	zassert_within(itimer_count, expected, expected / 4, "%d expiries", itimer_count);
+}
+
+ZTEST(posix_timers, test_itimer_prof_sleep)
+{
+	struct itimerval value = {
+		.it_value = ms_to_timeval(CPU_INTERVAL_MS),
+		.it_interval = ms_to_timeval(CPU_INTERVAL_MS),
+	};
+	struct itimerval ovalue;
+
+	itimer_install(SIGPROF);
+
+	/* no CPU time is used while every thread sleeps */
+	zassert_ok(setitimer(ITIMER_PROF, &value, NULL));
+	itimer_sleep_ms(10 * CPU_INTERVAL_MS);
+	zassert_ok(getitimer(ITIMER_PROF, &ovalue));
+
+	itimer_uninstall(ITIMER_PROF, SIGPROF);
+
+	zassert_true(itimer_count <= 1, "%d expiries", itimer_count);
+	if (itimer_count == 0) {
+		zassert_true(timeval_to_ms(&ovalue.it_value) > 0);
+	}
+}
+
+static void other_busy(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	itimer_busy_ms(CPU_BUSY_MS);
+}
+
+ZTEST(posix_timers, test_itimer_prof_other_thread)
+{
+	struct itimerval value = {
+		.it_value = ms_to_timeval(CPU_INTERVAL_MS),
+		.it_interval = ms_to_timeval(CPU_INTERVAL_MS),
+	};
+
+	itimer_install(SIGPROF);
+
+	/* a thread that is neither a pthread nor the main thread is not part of the process */
+	zassert_ok(setitimer(ITIMER_PROF, &value, NULL));
+	k_thread_create(&other_thread, other_stack, K_THREAD_STACK_SIZEOF(other_stack), other_busy,
+			NULL, NULL, NULL, k_thread_priority_get(k_current_get()), 0, K_NO_WAIT);
+	zassert_ok(k_thread_join(&other_thread, K_FOREVER));
+	itimer_busy_ms(1);
+
+	itimer_uninstall(ITIMER_PROF, SIGPROF);
+
+	zassert_true(itimer_count <= 1, "%d expiries", itimer_count);
+}
+
+ZTEST(posix_timers, test_itimer_virtual)
+{
+	struct itimerval value = {
+		.it_value = ms_to_timeval(CPU_INTERVAL_MS),
+	};
+
+	/* user mode time is not counted apart from the rest */
+	errno = 0;
+	zassert_equal(setitimer(ITIMER_VIRTUAL, &value, NULL), -1);
+	zassert_equal(errno, ENOTSUP);
+
+	errno = 0;
+	zassert_equal(getitimer(ITIMER_VIRTUAL, &value), -1);
+	zassert_equal(errno, ENOTSUP);
+}
+
+#endif /* CONFIG_XSI_TIMERS */
@@ -0,0 +1,196 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#define PERIOD_US   5000
+#define WORK_US     500
+#define ACTIVATIONS 40
+
+#define SS_PERIOD_US 10000
+#define SS_BUDGET_US 2000
+
+static volatile bool stop;
+static uint32_t max_interference_us;
+static int completed;
+
+static struct sched_param ss_param(int prio, int low)
+{
+	return (struct sched_param){
+		.sched_priority = prio,
+		.sched_ss_low_priority = low,
+		.sched_ss_repl_period = {.tv_nsec = SS_PERIOD_US * NSEC_PER_USEC},
+		.sched_ss_init_budget = {.tv_nsec = SS_BUDGET_US * NSEC_PER_USEC},
+		.sched_ss_max_repl = 4,
+	};
+}
+
+static void *saturate(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	while (!stop) {
+		k_busy_wait(50);
+	}
+
+	return NULL;
+}
+
+static void *periodic(void *arg)
+{
+	uint32_t begin;
+	uint32_t response_us;
+	int64_t release = k_uptime_ticks();
+	const k_ticks_t period = k_us_to_ticks_ceil64(PERIOD_US);
+
+	ARG_UNUSED(arg);
+
+	for (int i = 0; i < ACTIVATIONS; ++i) {
+		release += period;
+		k_sleep(K_TIMEOUT_ABS_TICKS(release));
+
+		begin = k_cycle_get_32();
+		k_busy_wait(WORK_US);
+		response_us = k_cyc_to_us_ceil32(k_cycle_get_32() - begin);
+
+		max_interference_us = MAX(max_interference_us, response_us - MIN(response_us, WORK_US));
+		if (response_us <= PERIOD_US) {
+			++completed;
+		}
+	}
+
+	stop = true;
+
+	return NULL;
+}
+
+ZTEST(xsi_advanced_realtime_threads, test_sched_sporadic_param)
+{
+#if defined(_POSIX_THREAD_SPORADIC_SERVER)
+	int policy;
+	pthread_t th;
+	pthread_attr_t attr;
+	struct sched_param param;
+	const int hi = sched_get_priority_max(SCHED_SPORADIC);
+	const int lo = sched_get_priority_min(SCHED_SPORADIC);
+
+	zassert_true(sysconf(_SC_THREAD_SPORADIC_SERVER) > 0);
+
+	zassert_ok(pthread_attr_init(&attr));
+	zassert_ok(pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED));
+	zassert_ok(pthread_attr_setschedpolicy(&attr, SCHED_SPORADIC));
+
+	/* pthread_attr_setschedparam() was not called yet */
+	zassert_equal(pthread_create(&th, &attr, saturate, NULL), EINVAL);
+
+	param = ss_param(lo, hi);
+	zassert_equal(pthread_attr_setschedparam(&attr, &param), EINVAL, "low above high priority");
+
+	param = ss_param(hi, lo);
+	param.sched_ss_init_budget.tv_nsec = SS_PERIOD_US * 2 * NSEC_PER_USEC;
+	zassert_equal(pthread_attr_setschedparam(&attr, &param), EINVAL, "budget above period");
+
+	param = ss_param(hi, lo);
+	param.sched_ss_init_budget = (struct timespec){0};
+	zassert_equal(pthread_attr_setschedparam(&attr, &param), EINVAL, "no budget");
+
+	param = ss_param(hi, lo);
+	param.sched_ss_max_repl = 0;
+	zassert_equal(pthread_attr_setschedparam(&attr, &param), EINVAL, "no replenishments");
+
+	param = ss_param(hi, lo);
+	zassert_ok(pthread_attr_setschedparam(&attr, &param));
+	param = (struct sched_param){0};
+	zassert_ok(pthread_attr_getschedparam(&attr, &param));
+	zassert_equal(param.sched_priority, hi);
+	zassert_equal(param.sched_ss_low_priority, lo);
+	zassert_equal(param.sched_ss_max_repl, 4);
+
+	/* the thread runs at the lowest priority, so it can not get far before it is stopped */
+	param = ss_param(lo, lo);
+	zassert_ok(pthread_attr_setschedparam(&attr, &param));
+	stop = false;
+	zassert_ok(pthread_create(&th, &attr, saturate, NULL));
+	zassert_ok(pthread_attr_destroy(&attr));
+
+	zassert_ok(pthread_getschedparam(th, &policy, &param));
+	zassert_equal(policy, SCHED_SPORADIC);
+	zassert_equal(param.sched_ss_repl_period.tv_nsec, SS_PERIOD_US * NSEC_PER_USEC);
+	zassert_equal(param.sched_ss_init_budget.tv_nsec, SS_BUDGET_US * NSEC_PER_USEC);
+
+	param = (struct sched_param){.sched_priority = lo};
+	zassert_ok(pthread_setschedparam(th, SCHED_RR, &param));
+	zassert_ok(pthread_getschedparam(th, &policy, &param));
+	zassert_equal(policy, SCHED_RR);
+
+	param = ss_param(lo, lo);
+	zassert_ok(pthread_setschedparam(th, SCHED_SPORADIC, &param));
+	zassert_ok(pthread_getschedparam(th, &policy, &param));
+	zassert_equal(policy, SCHED_SPORADIC);
+
+	stop = true;
+	zassert_ok(pthread_join(th, NULL));
+#else
+	ztest_test_skip();
+#endif
+}
+
+ZTEST(xsi_advanced_realtime_threads, test_sched_sporadic_interference)
+{
+#if defined(_POSIX_THREAD_SPORADIC_SERVER)
+	pthread_t ss;
+	pthread_t task;
+	pthread_attr_t attr;
+	struct sched_param param;
+	const int hi = sched_get_priority_max(SCHED_SPORADIC);
+	const int lo = sched_get_priority_min(SCHED_SPORADIC);
+	/* budget overruns by up to a tick each time it is charged, and the timer by another */
+	const uint32_t allowed_us = SS_BUDGET_US + 2 * k_ticks_to_us_ceil32(1);
+
+	if (IS_ENABLED(CONFIG_SMP)) {
+		/* the periodic task could run next to the sporadic server */
+		ztest_test_skip();
+	}
+
+	stop = false;
+	completed = 0;
+	max_interference_us = 0;
+
+	/* the server runs above the periodic task, until it has used its budget */
+	zassert_ok(pthread_attr_init(&attr));
+	zassert_ok(pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED));
+	zassert_ok(pthread_attr_setschedpolicy(&attr, SCHED_RR));
+	param = (struct sched_param){.sched_priority = hi - 2};
+	zassert_ok(pthread_attr_setschedparam(&attr, &param));
+	zassert_ok(pthread_create(&task, &attr, periodic, NULL));
+
+	zassert_ok(pthread_attr_setschedpolicy(&attr, SCHED_SPORADIC));
+	param = ss_param(hi - 1, lo);
+	zassert_ok(pthread_attr_setschedparam(&attr, &param));
+	zassert_ok(pthread_create(&ss, &attr, saturate, NULL));
+	zassert_ok(pthread_attr_destroy(&attr));
+
+	zassert_ok(pthread_join(task, NULL));
+	zassert_ok(pthread_join(ss, NULL));
+
+	TC_PRINT("budget %u us every %u us, max interference %u us, %d/%d deadlines met\n",
+		 SS_BUDGET_US, SS_PERIOD_US, max_interference_us, completed, ACTIVATIONS);
+
+	zassert_true(max_interference_us <= allowed_us, "interference %u us above %u us",
+		     max_interference_us, allowed_us);
+	zassert_equal(completed, ACTIVATIONS);
+#else
+	ztest_test_skip();
+#endif
+}
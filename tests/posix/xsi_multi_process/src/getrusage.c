@@ -0,0 +1,221 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* for RUSAGE_THREAD */
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <stdbool.h>
+#include <sys/resource.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#define BUSY_MS     50
+#define SWITCHES    20
+#define TEST_PRIO   K_PRIO_PREEMPT(2)
+#define HELPER_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_DEFINE(helper_stack, HELPER_SIZE);
+static struct k_thread helper_thread;
+static volatile bool stop;
+static volatile bool done;
+
+static long timeval_us(const struct timeval *tv)
+{
+	return tv->tv_sec * USEC_PER_SEC + tv->tv_usec;
+}
+
+static void start_helper(k_thread_entry_t entry, int prio)
+{
+	stop = false;
+	done = false;
+	k_thread_create(&helper_thread, helper_stack, K_THREAD_STACK_SIZEOF(helper_stack), entry,
+			NULL, NULL, NULL, prio, 0, K_NO_WAIT);
+}
+
+static void yielder(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!stop) {
+		k_yield();
+	}
+}
+
+static void sleeper(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < SWITCHES; ++i) {
+		k_msleep(1);
+	}
+
+	done = true;
+}
+
+ZTEST(xsi_multi_process, test_getrusage_invalid)
+{
+	struct rusage ru;
+
+	errno = 0;
+	zassert_equal(getrusage(42, &ru), -1);
+	zassert_equal(errno, EINVAL);
+}
+
+ZTEST(xsi_multi_process, test_getrusage_utime)
+{
+	struct rusage self[2];
+	struct rusage thread[2];
+	struct rusage children;
+	const long busy = BUSY_MS * USEC_PER_MSEC;
+
+	zassert_ok(getrusage(RUSAGE_SELF, &self[0]));
+	zassert_ok(getrusage(RUSAGE_THREAD, &thread[0]));
+	k_busy_wait(busy);
+	zassert_ok(getrusage(RUSAGE_SELF, &self[1]));
+	zassert_ok(getrusage(RUSAGE_THREAD, &thread[1]));
+
+	zassert_true(timeval_us(&self[1].ru_utime) - timeval_us(&self[0].ru_utime) >= busy);
+	zassert_true(timeval_us(&thread[1].ru_utime) - timeval_us(&thread[0].ru_utime) >= busy);
+	zassert_true(timeval_us(&self[1].ru_utime) >= timeval_us(&thread[1].ru_utime));
+	zassert_equal(timeval_us(&self[1].ru_stime), 0);
+
+	/* there are no child processes */
+	zassert_ok(getrusage(RUSAGE_CHILDREN, &children));
+	zassert_equal(timeval_us(&children.ru_utime), 0);
+	zassert_equal(children.ru_nvcsw, 0);
+	zassert_equal(children.ru_nivcsw, 0);
+}
+
+ZTEST(xsi_multi_process, test_getrusage_yield)
+{
+	struct rusage before;
+	struct rusage after;
+	int prio = k_thread_priority_get(k_current_get());
+
+	if (!IS_ENABLED(CONFIG_XSI_RUSAGE_CSW)) {
+		ztest_test_skip();
+	}
+
+	k_thread_priority_set(k_current_get(), TEST_PRIO);
+	start_helper(yielder, TEST_PRIO);
+
+	zassert_ok(getrusage(RUSAGE_THREAD, &before));
+	for (int i = 0; i < SWITCHES; ++i) {
+		k_yield();
+	}
+	zassert_ok(getrusage(RUSAGE_THREAD, &after));
+
+	stop = true;
+	zassert_ok(k_thread_join(&helper_thread, K_FOREVER));
+	k_thread_priority_set(k_current_get(), prio);
+
+	/* a thread that yields is still ready to run */
+	zassert_true(after.ru_nivcsw - before.ru_nivcsw >= SWITCHES, "%ld involuntary switches",
+		     after.ru_nivcsw - before.ru_nivcsw);
+	zassert_equal(after.ru_nvcsw, before.ru_nvcsw, "%ld voluntary switches",
+		      after.ru_nvcsw - before.ru_nvcsw);
+}
+
+ZTEST(xsi_multi_process, test_getrusage_preempt)
+{
+	struct rusage before;
+	struct rusage after;
+	int prio = k_thread_priority_get(k_current_get());
+
+	if (!IS_ENABLED(CONFIG_XSI_RUSAGE_CSW)) {
+		ztest_test_skip();
+	}
+
+	k_thread_priority_set(k_current_get(), TEST_PRIO);
+	zassert_ok(getrusage(RUSAGE_THREAD, &before));
+
+	/* the sleeper preempts this thread each time that it wakes up */
+	start_helper(sleeper, TEST_PRIO - 1);
+	while (!done) {
+		k_busy_wait(100);
+	}
+
+	zassert_ok(getrusage(RUSAGE_THREAD, &after));
+	zassert_ok(k_thread_join(&helper_thread, K_FOREVER));
+	k_thread_priority_set(k_current_get(), prio);
+
+	zassert_true(after.ru_nivcsw - before.ru_nivcsw >= SWITCHES, "%ld involuntary switches",
+		     after.ru_nivcsw - before.ru_nivcsw);
+	zassert_equal(after.ru_nvcsw, before.ru_nvcsw, "%ld voluntary switches",
+		      after.ru_nvcsw - before.ru_nvcsw);
+}
+
+ZTEST(xsi_multi_process, test_getrusage_sleep)
+{
+	struct rusage thread[2];
+	struct rusage self[2];
+
+	if (!IS_ENABLED(CONFIG_XSI_RUSAGE_CSW)) {
+		ztest_test_skip();
+	}
+
+	zassert_ok(getrusage(RUSAGE_THREAD, &thread[0]));
+	for (int i = 0; i < SWITCHES; ++i) {
+		k_msleep(1);
+	}
+	zassert_ok(getrusage(RUSAGE_THREAD, &thread[1]));
+
+	zassert_true(thread[1].ru_nvcsw - thread[0].ru_nvcsw >= SWITCHES, "%ld voluntary switches",
+		     thread[1].ru_nvcsw - thread[0].ru_nvcsw);
+
+	/* the switches of threads that have exited still count towards the process */
+	zassert_ok(getrusage(RUSAGE_SELF, &self[0]));
+	start_helper(sleeper, K_PRIO_PREEMPT(0));
+	zassert_ok(k_thread_join(&helper_thread, K_FOREVER));
+	zassert_ok(getrusage(RUSAGE_SELF, &self[1]));
+
+	zassert_true(self[1].ru_nvcsw - self[0].ru_nvcsw >= SWITCHES, "%ld voluntary switches",
+		     self[1].ru_nvcsw - self[0].ru_nvcsw);
+}
+
+ZTEST(xsi_multi_process, test_getrusage_maxrss_stack)
+{
+	struct rusage ru;
+	volatile char buf[2048];
+
+	if (!IS_ENABLED(CONFIG_XSI_RUSAGE_STACK)) {
+		ztest_test_skip();
+	}
+
+	for (size_t i = 0; i < sizeof(buf); ++i) {
+		buf[i] = (char)i;
+	}
+
+	zassert_ok(getrusage(RUSAGE_THREAD, &ru));
+	zassert_true(ru.ru_maxrss >= (long)(sizeof(buf) / 1024), "ru_maxrss %ld", ru.ru_maxrss);
+	zassert_ok(getrusage(RUSAGE_SELF, &ru));
+	zassert_true(ru.ru_maxrss >= (long)(sizeof(buf) / 1024), "ru_maxrss %ld", ru.ru_maxrss);
+}
+
+ZTEST(xsi_multi_process, test_getrusage_maxrss_heap)
+{
+	void *p;
+	struct rusage ru;
+	const size_t size = 4096;
+
+	if (!IS_ENABLED(CONFIG_XSI_RUSAGE_HEAP)) {
+		ztest_test_skip();
+	}
+
+	p = k_malloc(size);
+	zassert_not_null(p);
+	k_free(p);
+
+	/* the peak stays after the memory is freed */
+	zassert_ok(getrusage(RUSAGE_SELF, &ru));
+	zassert_true(ru.ru_maxrss >= (long)(size / 1024), "ru_maxrss %ld", ru.ru_maxrss);
+}
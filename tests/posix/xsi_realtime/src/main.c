@@ -4,59 +4,194 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+/* for sched_rr_get_interval_np() and sched_rr_set_interval_np() */
+#define _GNU_SOURCE
+
+#include <errno.h>
 #include <pthread.h>
+#include <sched.h>
 
 #include <zephyr/ztest.h>
 
+static K_SEM_DEFINE(sched_sem, 0, 1);
+
+static void *sched_waiter(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	(void)k_sem_take(&sched_sem, K_FOREVER);
+
+	return NULL;
+}
+
+static int posix_prio_of(pthread_t th)
+{
+	int policy;
+	struct sched_param param;
+
+	zassert_ok(pthread_getschedparam(th, &policy, &param));
+
+	return param.sched_priority;
+}
+
 ZTEST(xsi_realtime, test_sched_getparam)
 {
 	struct sched_param param;
-	int rc = sched_getparam(0, &param);
-	int err = errno;
 
-	zassert_true((rc == -1 && err == ENOSYS));
+	zassert_ok(sched_getparam(0, &param));
+	zassert_equal(param.sched_priority, posix_prio_of(pthread_self()));
+
+	errno = 0;
+	zassert_equal(sched_getparam(0, NULL), -1);
+	zassert_equal(errno, EINVAL);
+
+	errno = 0;
+	zassert_equal(sched_getparam(-1, &param), -1);
+	zassert_equal(errno, ESRCH);
 }
 
 ZTEST(xsi_realtime, test_sched_getscheduler)
 {
-	int rc = sched_getscheduler(0);
-	int err = errno;
+	int policy = sched_getscheduler(0);
+
+	zassert_true((policy == SCHED_FIFO) || (policy == SCHED_RR) || (policy == SCHED_OTHER));
 
-	zassert_true((rc == -1 && err == ENOSYS));
+	errno = 0;
+	zassert_equal(sched_getscheduler(-1), -1);
+	zassert_equal(errno, ESRCH);
 }
+
 ZTEST(xsi_realtime, test_sched_setparam)
 {
+	int policy;
+	struct sched_param old;
 	struct sched_param param = {
 		.sched_priority = 2,
 	};
-	int rc = sched_setparam(0, &param);
-	int err = errno;
 
-	zassert_true((rc == -1 && err == ENOSYS));
+	zassert_ok(sched_getparam(0, &old));
+	policy = sched_getscheduler(0);
+	param.sched_priority = MIN(2, sched_get_priority_max(policy));
+
+	zassert_ok(sched_setparam(0, &param));
+	zassert_equal(posix_prio_of(pthread_self()), param.sched_priority);
+	zassert_equal(sched_getscheduler(0), policy);
+
+	errno = 0;
+	zassert_equal(sched_setparam(0, NULL), -1);
+	zassert_equal(errno, EINVAL);
+
+	zassert_ok(sched_setparam(0, &old));
 }
 
 ZTEST(xsi_realtime, test_sched_setscheduler)
 {
+	pthread_t before;
+	pthread_t after;
+	int old_policy;
+	struct sched_param old;
 	struct sched_param param = {
 		.sched_priority = 2,
 	};
-	int policy = 0;
-	int rc = sched_setscheduler(0, policy, &param);
-	int err = errno;
 
-	zassert_true((rc == -1 && err == ENOSYS));
+	if (CONFIG_SYS_THREAD_STACK_MAX == 0) {
+		ztest_test_skip();
+	}
+
+	zassert_ok(sched_getparam(0, &old));
+	old_policy = sched_getscheduler(0);
+
+	zassert_ok(pthread_create(&before, NULL, sched_waiter, NULL));
+
+	/* the former policy is returned */
+	zassert_equal(sched_setscheduler(0, SCHED_RR, &param), old_policy);
+	zassert_equal(sched_getscheduler(0), SCHED_RR);
+
+	/* existing threads, the calling thread, and new threads all use the new priority */
+	zassert_equal(posix_prio_of(before), param.sched_priority);
+	zassert_equal(posix_prio_of(pthread_self()), param.sched_priority);
+	zassert_ok(pthread_create(&after, NULL, sched_waiter, NULL));
+	zassert_equal(posix_prio_of(after), param.sched_priority);
+
+	k_sem_give(&sched_sem);
+	zassert_ok(pthread_join(before, NULL));
+	k_sem_give(&sched_sem);
+	zassert_ok(pthread_join(after, NULL));
+
+	errno = 0;
+	zassert_equal(sched_setscheduler(0, 4242, &param), -1);
+	zassert_equal(errno, EINVAL);
+
+	param.sched_priority = sched_get_priority_max(SCHED_RR) + 1;
+	errno = 0;
+	zassert_equal(sched_setscheduler(0, SCHED_RR, &param), -1);
+	zassert_equal(errno, EINVAL);
+
+	errno = 0;
+	zassert_equal(sched_setscheduler(-1, SCHED_RR, &old), -1);
+	zassert_equal(errno, ESRCH);
+
+	zassert_equal(sched_setscheduler(0, old_policy, &old), SCHED_RR);
 }
 
 ZTEST(xsi_realtime, test_sched_rr_get_interval)
 {
+	int old_policy;
+	struct sched_param old;
 	struct timespec interval = {
 		.tv_sec = 0,
 		.tv_nsec = 0,
 	};
-	int rc = sched_rr_get_interval(0, &interval);
-	int err = errno;
+	const struct sched_param param = {
+		.sched_priority = 0,
+	};
+
+	zassert_ok(sched_getparam(0, &old));
+	old_policy = sched_getscheduler(0);
+
+	/* the lowest SCHED_RR priority is time sliced with the default interval */
+	zassert_not_equal(sched_setscheduler(0, SCHED_RR, &param), -1);
+	zassert_ok(sched_rr_get_interval(0, &interval));
+	zassert_equal(interval.tv_sec, 0);
+	zassert_equal(interval.tv_nsec,
+		      k_ticks_to_ns_floor64(k_ms_to_ticks_ceil32(CONFIG_TIMESLICE_SIZE)));
+
+	errno = 0;
+	zassert_equal(sched_rr_get_interval(0, NULL), -1);
+	zassert_equal(errno, EINVAL);
+
+	errno = 0;
+	zassert_equal(sched_rr_get_interval(-1, &interval), -1);
+	zassert_equal(errno, ESRCH);
+
+	zassert_equal(sched_setscheduler(0, old_policy, &old), SCHED_RR);
+}
+
+ZTEST(xsi_realtime, test_sched_rr_set_interval_np)
+{
+	struct timespec interval;
+	const int prio = sched_get_priority_min(SCHED_RR);
+	const struct timespec quantum = {.tv_nsec = 3 * NSEC_PER_MSEC};
+	const struct timespec zero = {0};
+
+	zassert_ok(sched_rr_set_interval_np(prio, &quantum));
+	zassert_ok(sched_rr_get_interval_np(prio, &interval));
+	zassert_equal(interval.tv_sec, 0);
+	zassert_equal(interval.tv_nsec, k_ticks_to_ns_floor64(k_ms_to_ticks_ceil32(3)));
+
+	/* zero restores the default */
+	zassert_ok(sched_rr_set_interval_np(prio, &zero));
+	zassert_ok(sched_rr_get_interval_np(prio, &interval));
+	zassert_equal(interval.tv_nsec,
+		      k_ticks_to_ns_floor64(k_ms_to_ticks_ceil32(CONFIG_TIMESLICE_SIZE)));
+
+	errno = 0;
+	zassert_equal(sched_rr_set_interval_np(sched_get_priority_max(SCHED_RR) + 1, &quantum), -1);
+	zassert_equal(errno, EINVAL);
 
-	zassert_true((rc == -1 && err == ENOSYS));
+	errno = 0;
+	zassert_equal(sched_rr_get_interval_np(prio, NULL), -1);
+	zassert_equal(errno, EINVAL);
 }
 
 static void teardown(void *arg)
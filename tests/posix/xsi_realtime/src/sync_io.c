@@ -8,9 +8,12 @@
 #include <fcntl.h>
 #include <ff.h>
 #include <zephyr/fs/fs.h>
+#include <zephyr/sys/fdtable.h>
 #include <unistd.h>
 #include <zephyr/ztest.h>
 
+#include "sync_io_priv.h"
+
 static const char test_str[] = "Hello World!";
 
 #define FATFS_MNTP "/RAM:"
@@ -101,3 +104,177 @@ ZTEST(xsi_realtime, test_fs_datasync)
 	zassert_ok(close(file), "Failed to close file");
 	test_unmount();
 }
+
+#define SYNC_WRITERS 3
+#define SYNC_WRITES  4
+
+static K_THREAD_STACK_ARRAY_DEFINE(sync_stacks, SYNC_WRITERS - 1, 2048);
+static struct k_thread sync_threads[SYNC_WRITERS - 1];
+static atomic_t sync_errors;
+
+static void sync_writer(void *p1, void *p2, void *p3)
+{
+	int fd = POINTER_TO_INT(p1);
+	int id = POINTER_TO_INT(p2);
+	char c = 'a' + id;
+
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < SYNC_WRITES; ++i) {
+		if ((pwrite(fd, &c, 1, id * SYNC_WRITES + i) != 1) || (fdatasync(fd) != 0)) {
+			(void)atomic_inc(&sync_errors);
+		}
+	}
+}
+
+/**
+ * @brief Test O_DSYNC writes and concurrent fdatasync() calls on one descriptor
+ *
+ * @details Concurrent requests to synchronize the same descriptor share flushes of the file
+ * system, and each of them must still complete successfully.
+ */
+ZTEST(xsi_realtime, test_fs_dsync_concurrent)
+{
+	int fd;
+	char buf[SYNC_WRITERS * SYNC_WRITES];
+
+	test_mount();
+
+	fd = open(TEST_FILE, O_CREAT | O_TRUNC | O_RDWR | O_DSYNC | O_RSYNC, 0660);
+	zassert_not_equal(fd, -1, "Error opening file, errno [%d]", errno);
+
+	atomic_set(&sync_errors, 0);
+	for (int i = 0; i < SYNC_WRITERS - 1; ++i) {
+		k_thread_create(&sync_threads[i], sync_stacks[i],
+				K_THREAD_STACK_SIZEOF(sync_stacks[i]), sync_writer, INT_TO_POINTER(fd),
+				INT_TO_POINTER(i + 1), NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	sync_writer(INT_TO_POINTER(fd), INT_TO_POINTER(0), NULL);
+
+	for (int i = 0; i < SYNC_WRITERS - 1; ++i) {
+		zassert_ok(k_thread_join(&sync_threads[i], K_FOREVER));
+	}
+
+	zassert_equal(atomic_get(&sync_errors), 0);
+
+	zassert_equal(pread(fd, buf, sizeof(buf), 0), sizeof(buf));
+	for (int i = 0; i < ARRAY_SIZE(buf); ++i) {
+		zassert_equal(buf[i], 'a' + i / SYNC_WRITES);
+	}
+
+	zassert_ok(close(fd), "Failed to close file");
+	test_unmount();
+}
+
+#ifdef CONFIG_POSIX_SYNCHRONIZED_IO_GROUP_COMMIT
+
+#define STUB_WRITERS    4
+#define STUB_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(stub_stacks, STUB_WRITERS, STUB_STACK_SIZE);
+static struct k_thread stub_threads[STUB_WRITERS];
+static atomic_t stub_flushes;
+static atomic_t stub_errors;
+static K_SEM_DEFINE(stub_flushing, 0, 1);
+static K_SEM_DEFINE(stub_release, 0, 1);
+
+static ssize_t stub_write(void *obj, const void *buf, size_t sz)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buf);
+
+	return sz;
+}
+
+static int stub_close(void *obj)
+{
+	ARG_UNUSED(obj);
+
+	return 0;
+}
+
+static int stub_ioctl(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(args);
+
+	if (request != ZFD_IOCTL_FSYNC) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* the first flush lasts until the test releases it */
+	if (atomic_inc(&stub_flushes) == 0) {
+		k_sem_give(&stub_flushing);
+		(void)k_sem_take(&stub_release, K_FOREVER);
+	}
+
+	return 0;
+}
+
+static const struct fd_op_vtable stub_vtable = {
+	.write = stub_write,
+	.close = stub_close,
+	.ioctl = stub_ioctl,
+};
+
+static void stub_writer(void *p1, void *p2, void *p3)
+{
+	int fd = POINTER_TO_INT(p1);
+	char c = 'a';
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	if (write(fd, &c, 1) != 1) {
+		(void)atomic_inc(&stub_errors);
+	}
+}
+
+/**
+ * @brief Test that concurrent O_SYNC writers share flushes
+ *
+ * @details The file system is a stub that counts its flushes. While the flush of the first writer
+ * is in progress, the other writers each write and wait for a flush, and the flush that follows
+ * covers all of them.
+ */
+ZTEST(xsi_realtime, test_fs_sync_concurrent_flushes)
+{
+	int fd;
+	const int prio = k_thread_priority_get(k_current_get());
+
+	fd = zvfs_reserve_fd();
+	zassert_true(fd >= 0, "no free descriptor, errno [%d]", errno);
+	zvfs_finalize_typed_fd(fd, &stub_flushes, &stub_vtable, ZVFS_MODE_IFREG);
+	posix_sync_open(fd, O_WRONLY | O_SYNC);
+
+	atomic_set(&stub_flushes, 0);
+	atomic_set(&stub_errors, 0);
+
+	k_thread_create(&stub_threads[0], stub_stacks[0], K_THREAD_STACK_SIZEOF(stub_stacks[0]),
+			stub_writer, INT_TO_POINTER(fd), NULL, NULL, K_PRIO_PREEMPT(1), 0,
+			K_NO_WAIT);
+	zassert_ok(k_sem_take(&stub_flushing, K_FOREVER));
+
+	/* each runs until it waits for the flush in progress to finish */
+	for (int i = 1; i < STUB_WRITERS; ++i) {
+		k_thread_create(&stub_threads[i], stub_stacks[i],
+				K_THREAD_STACK_SIZEOF(stub_stacks[i]), stub_writer,
+				INT_TO_POINTER(fd), NULL, NULL, prio - 1, 0, K_NO_WAIT);
+	}
+	k_yield();
+
+	k_sem_give(&stub_release);
+	for (int i = 0; i < STUB_WRITERS; ++i) {
+		zassert_ok(k_thread_join(&stub_threads[i], K_FOREVER));
+	}
+
+	zassert_equal(atomic_get(&stub_errors), 0);
+	zassert_true(atomic_get(&stub_flushes) < STUB_WRITERS, "%d flushes for %d writers",
+		     (int)atomic_get(&stub_flushes), STUB_WRITERS);
+
+	zassert_ok(close(fd));
+}
+
+#endif /* CONFIG_POSIX_SYNCHRONIZED_IO_GROUP_COMMIT */
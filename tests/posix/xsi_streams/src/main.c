@@ -15,7 +15,7 @@ ZTEST(xsi_streams, test_putmsg)
 	int ret = putmsg(fd, ctrl, data, 0);
 
 	zassert_equal(ret, -1, "Expected return value -1, got %d", ret);
-	zassert_equal(errno, ENOSYS, "Expected errno ENOSYS, got %d", errno);
+	zassert_equal(errno, EBADF, "Expected errno EBADF, got %d", errno);
 }
 
 ZTEST(xsi_streams, test_fdetach)
@@ -42,10 +42,11 @@ ZTEST(xsi_streams, test_getmsg)
 	struct strbuf *ctrl = NULL;
 	struct strbuf *data = NULL;
 	int fd = -1;
-	int ret = getmsg(fd, ctrl, data, 0);
+	int flags = 0;
+	int ret = getmsg(fd, ctrl, data, &flags);
 
 	zassert_equal(ret, -1, "Expected return value -1, got %d", ret);
-	zassert_equal(errno, ENOSYS, "Expected errno ENOSYS, got %d", errno);
+	zassert_equal(errno, EBADF, "Expected errno EBADF, got %d", errno);
 }
 
 ZTEST(xsi_streams, test_getpmsg)
@@ -53,10 +54,12 @@ ZTEST(xsi_streams, test_getpmsg)
 	struct strbuf *ctrl = NULL;
 	struct strbuf *data = NULL;
 	int fd = -1;
-	int ret = getpmsg(fd, ctrl, data, 0, 0);
+	int band = 0;
+	int flags = MSG_ANY;
+	int ret = getpmsg(fd, ctrl, data, &band, &flags);
 
 	zassert_equal(ret, -1, "Expected return value -1, got %d", ret);
-	zassert_equal(errno, ENOSYS, "Expected errno ENOSYS, got %d", errno);
+	zassert_equal(errno, EBADF, "Expected errno EBADF, got %d", errno);
 }
 
 ZTEST(xsi_streams, test_isastream)
@@ -65,7 +68,7 @@ ZTEST(xsi_streams, test_isastream)
 	int ret = isastream(fd);
 
 	zassert_equal(ret, -1, "Expected return value -1, got %d", ret);
-	zassert_equal(errno, ENOSYS, "Expected errno ENOSYS, got %d", errno);
+	zassert_equal(errno, EBADF, "Expected errno EBADF, got %d", errno);
 }
 
 ZTEST_SUITE(xsi_streams, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,270 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* for stream_pipe_np() and stream_socketpair_np() */
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <string.h>
+#include <stropts.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <zephyr/ztest.h>
+
+static int fds[2] = {-1, -1};
+
+static void put(int fd, const char *ctl, const char *data, int band, int flags)
+{
+	struct strbuf c = {.len = (ctl == NULL) ? -1 : strlen(ctl), .buf = (char *)ctl};
+	struct strbuf d = {.len = (data == NULL) ? -1 : strlen(data), .buf = (char *)data};
+
+	zassert_ok(putpmsg(fd, &c, &d, band, flags), "putpmsg() failed: %d", errno);
+}
+
+static void get(int fd, const char *ctl, const char *data, int band, int flags)
+{
+	char cbuf[16];
+	char dbuf[16];
+	int b = 0;
+	int f = MSG_ANY;
+	struct strbuf c = {.maxlen = sizeof(cbuf), .buf = cbuf};
+	struct strbuf d = {.maxlen = sizeof(dbuf), .buf = dbuf};
+
+	zassert_equal(getpmsg(fd, &c, &d, &b, &f), 0, "getpmsg() failed: %d", errno);
+	zassert_equal(b, band);
+	zassert_equal(f, flags);
+	zassert_equal(c.len, (ctl == NULL) ? -1 : strlen(ctl));
+	zassert_equal(d.len, (data == NULL) ? -1 : strlen(data));
+	zassert_mem_equal(cbuf, ctl, MAX(c.len, 0));
+	zassert_mem_equal(dbuf, data, MAX(d.len, 0));
+}
+
+ZTEST(xsi_streams, test_stream_pipe)
+{
+	char buf[16];
+	int flags = 0;
+	struct strbuf d = {.maxlen = sizeof(buf), .buf = buf};
+
+	zassert_ok(stream_pipe_np(fds));
+	zassert_equal(isastream(fds[0]), 1);
+	zassert_equal(isastream(fds[1]), 1);
+
+	/* message boundaries are kept */
+	zassert_equal(write(fds[1], "abc", 3), 3);
+	zassert_equal(write(fds[1], "defg", 4), 4);
+	zassert_equal(read(fds[0], buf, sizeof(buf)), 3);
+	zassert_mem_equal(buf, "abc", 3);
+	zassert_equal(getmsg(fds[0], NULL, &d, &flags), 0);
+	zassert_equal(d.len, 4);
+	zassert_mem_equal(buf, "defg", 4);
+
+	/* a pipe only goes one way */
+	zassert_equal(write(fds[0], "abc", 3), -1);
+	zassert_equal(errno, EBADF);
+	zassert_equal(read(fds[1], buf, sizeof(buf)), -1);
+	zassert_equal(errno, EBADF);
+
+	/* the control part can only be read with getmsg() */
+	put(fds[1], "ctl", "data", 0, MSG_BAND);
+	zassert_equal(read(fds[0], buf, sizeof(buf)), -1);
+	zassert_equal(errno, EBADMSG);
+	get(fds[0], "ctl", "data", 0, MSG_BAND);
+
+	zassert_ok(close(fds[1]));
+	zassert_equal(read(fds[0], buf, sizeof(buf)), 0);
+	zassert_ok(close(fds[0]));
+}
+
+ZTEST(xsi_streams, test_stream_bands)
+{
+	int band = 2;
+	int flags = MSG_BAND;
+
+	zassert_ok(stream_pipe_np(fds));
+	zassert_ok(fcntl(fds[0], F_SETFL, O_NONBLOCK));
+
+	put(fds[1], NULL, "low", 0, MSG_BAND);
+	put(fds[1], NULL, "one", 1, MSG_BAND);
+	put(fds[1], NULL, "three", 3, MSG_BAND);
+	put(fds[1], "urgent", NULL, 0, MSG_HIPRI);
+	put(fds[1], NULL, "three'", 3, MSG_BAND);
+
+	/* high-priority messages come first, then the highest bands, in order */
+	get(fds[0], "urgent", NULL, 0, MSG_HIPRI);
+
+	/* only bands from 2 up */
+	zassert_equal(getpmsg(fds[0], NULL, NULL, &band, &flags), MOREDATA);
+	zassert_equal(band, 3);
+	get(fds[0], NULL, "three", 3, MSG_BAND);
+	get(fds[0], NULL, "three'", 3, MSG_BAND);
+	band = 2;
+	flags = MSG_BAND;
+	zassert_equal(getpmsg(fds[0], NULL, NULL, &band, &flags), -1);
+	zassert_equal(errno, EAGAIN);
+
+	band = 0;
+	flags = MSG_HIPRI;
+	zassert_equal(getpmsg(fds[0], NULL, NULL, &band, &flags), -1);
+	zassert_equal(errno, EAGAIN);
+
+	get(fds[0], NULL, "one", 1, MSG_BAND);
+	get(fds[0], NULL, "low", 0, MSG_BAND);
+
+	/* invalid bands and flags */
+	zassert_equal(putpmsg(fds[1], NULL, &(struct strbuf){.len = 0}, CONFIG_XSI_STREAMS_BANDS,
+			      MSG_BAND), -1);
+	zassert_equal(errno, EINVAL);
+	zassert_equal(putpmsg(fds[1], NULL, &(struct strbuf){.len = 0}, 0, MSG_HIPRI), -1);
+	zassert_equal(errno, EINVAL, "high-priority messages need a control part");
+	zassert_equal(putmsg(fds[1], NULL, &(struct strbuf){.len = 0}, MSG_ANY), -1);
+	zassert_equal(errno, EINVAL);
+
+	zassert_ok(close(fds[0]));
+	zassert_ok(close(fds[1]));
+}
+
+ZTEST(xsi_streams, test_stream_partial)
+{
+	char cbuf[2];
+	char dbuf[3];
+	int flags = 0;
+	struct strbuf c = {.maxlen = sizeof(cbuf), .buf = cbuf};
+	struct strbuf d = {.maxlen = sizeof(dbuf), .buf = dbuf};
+
+	zassert_ok(stream_pipe_np(fds));
+	put(fds[1], "abcd", "efgh", 0, MSG_BAND);
+
+	zassert_equal(getmsg(fds[0], &c, &d, &flags), MORECTL | MOREDATA);
+	zassert_mem_equal(cbuf, "ab", 2);
+	zassert_mem_equal(dbuf, "efg", 3);
+
+	zassert_equal(getmsg(fds[0], &c, &d, &flags), 0);
+	zassert_equal(c.len, 2);
+	zassert_mem_equal(cbuf, "cd", 2);
+	zassert_equal(d.len, 1);
+	zassert_mem_equal(dbuf, "h", 1);
+
+	zassert_ok(close(fds[0]));
+	zassert_ok(close(fds[1]));
+}
+
+ZTEST(xsi_streams, test_stream_peek)
+{
+	int len = -1;
+	char cbuf[8];
+	char dbuf[8];
+	struct strpeek peek = {
+		.ctlbuf = {.maxlen = sizeof(cbuf), .buf = cbuf},
+		.databuf = {.maxlen = sizeof(dbuf), .buf = dbuf},
+		.flags = RS_HIPRI,
+	};
+
+	zassert_ok(stream_pipe_np(fds));
+	zassert_equal(ioctl(fds[0], I_NREAD, &len), 0);
+	zassert_equal(len, 0);
+
+	put(fds[1], NULL, "data", 1, MSG_BAND);
+	zassert_equal(ioctl(fds[0], I_PEEK, &peek), 0, "no high-priority message");
+
+	peek.flags = 0;
+	zassert_equal(ioctl(fds[0], I_PEEK, &peek), 1);
+	zassert_equal(peek.ctlbuf.len, -1);
+	zassert_equal(peek.databuf.len, 4);
+	zassert_mem_equal(dbuf, "data", 4);
+
+	put(fds[1], NULL, "more", 0, MSG_BAND);
+	zassert_equal(ioctl(fds[0], I_NREAD, &len), 2);
+	zassert_equal(len, 4);
+
+	/* peeking does not read the message */
+	get(fds[0], NULL, "data", 1, MSG_BAND);
+
+	zassert_ok(ioctl(fds[0], I_FLUSH, FLUSHR));
+	zassert_equal(ioctl(fds[0], I_NREAD, &len), 0);
+
+	zassert_ok(close(fds[0]));
+	zassert_ok(close(fds[1]));
+}
+
+ZTEST(xsi_streams, test_stream_socketpair)
+{
+	char cbuf[8];
+	char dbuf[8];
+	int flags = 0;
+	struct pollfd pfd;
+	struct strbuf c = {.maxlen = sizeof(cbuf), .buf = cbuf};
+	struct strbuf d = {.maxlen = sizeof(dbuf), .buf = dbuf};
+
+	zassert_ok(stream_socketpair_np(fds));
+
+	put(fds[0], NULL, "ping", 0, MSG_BAND);
+	get(fds[1], NULL, "ping", 0, MSG_BAND);
+	put(fds[1], NULL, "pong", 2, MSG_BAND);
+
+	pfd = (struct pollfd){.fd = fds[0], .events = POLLIN | POLLRDBAND | POLLPRI | POLLOUT};
+	zassert_equal(poll(&pfd, 1, 0), 1);
+	zassert_equal(pfd.revents, POLLIN | POLLRDBAND | POLLOUT);
+	get(fds[0], NULL, "pong", 2, MSG_BAND);
+
+	pfd = (struct pollfd){.fd = fds[0], .events = POLLIN};
+	zassert_equal(poll(&pfd, 1, 10), 0);
+
+	zassert_ok(close(fds[1]));
+	zassert_equal(poll(&pfd, 1, 0), 1);
+	zassert_equal(pfd.revents, POLLHUP);
+
+	/* after a hangup, reads return zero-length parts, and writes fail */
+	zassert_equal(getmsg(fds[0], &c, &d, &flags), 0);
+	zassert_equal(c.len, 0);
+	zassert_equal(d.len, 0);
+	zassert_equal(write(fds[0], "abc", 3), -1);
+	zassert_equal(errno, EPIPE);
+
+	zassert_ok(close(fds[0]));
+}
+
+ZTEST(xsi_streams, test_stream_setsig)
+{
+	int sig;
+	int events = 0;
+	sigset_t set;
+
+	zassert_ok(stream_pipe_np(fds));
+
+	zassert_equal(ioctl(fds[0], I_GETSIG, &events), -1, "not registered yet");
+	zassert_equal(errno, EINVAL);
+	zassert_equal(ioctl(fds[0], I_SETSIG, 0x8000), -1);
+	zassert_equal(errno, EINVAL);
+
+	sigemptyset(&set);
+	sigaddset(&set, SIGPOLL);
+	zassert_ok(sigprocmask(SIG_BLOCK, &set, NULL));
+
+	zassert_ok(ioctl(fds[0], I_SETSIG, S_RDBAND | S_HIPRI));
+	zassert_ok(ioctl(fds[0], I_GETSIG, &events));
+	zassert_equal(events, S_RDBAND | S_HIPRI);
+
+	/* band 0 messages were not asked for */
+	put(fds[1], NULL, "low", 0, MSG_BAND);
+	zassert_ok(sigpending(&set));
+	zassert_false(sigismember(&set, SIGPOLL));
+
+	put(fds[1], NULL, "high", 1, MSG_BAND);
+	zassert_ok(sigpending(&set));
+	zassert_true(sigismember(&set, SIGPOLL));
+
+	sigemptyset(&set);
+	sigaddset(&set, SIGPOLL);
+	zassert_ok(sigwait(&set, &sig));
+	zassert_equal(sig, SIGPOLL);
+	zassert_ok(sigprocmask(SIG_UNBLOCK, &set, NULL));
+
+	zassert_ok(close(fds[0]));
+	zassert_ok(close(fds[1]));
+}